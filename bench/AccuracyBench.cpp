@@ -0,0 +1,494 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Accuracy benchmark of the power estimation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Feeds load profiles with a known power over time through the S0 pulse
+ * generator into the power estimators of S0Smartmeter and compares the
+ * estimated with the true power, like a poller samples it:
+ * - interval: The power is derived from the interval between the last two
+ *   pulses only, process() is never called.
+ * - intervalDecay: Additionally process() decreases the power, if the next
+ *   pulse is overdue. This is the estimator of the firmware.
+ *
+ * It uses the test backend with the virtual clock, therefore hours of
+ * metering are simulated in milliseconds and every run is reproducible.
+ * The results are written as JSON lines to stdout, one object per estimator
+ * and load profile:
+ * - maeW, maePct: Mean absolute error in W and relative to the mean true power.
+ * - biasW: Mean error in W, positive if the estimate is too high.
+ * - maxErrW: Max. absolute error in W.
+ * - overshootW: Max. error in W above the true power, after the step if any.
+ * - lagS: Time in s after the step, until the error stays within 5% of the step.
+ *
+ * The samples of the warm-up phase, in which the estimator doesn't know the
+ * power yet, are not rated.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Hal.h"
+
+#if defined(HAL_TEST)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+
+#include <S0Smartmeter.hpp>
+#include <LoadProfile.h>
+#include <S0PulseGenerator.h>
+#include <VirtualClock.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * A power estimator in test.
+ */
+struct Estimator
+{
+    const char* name;           /**< Estimator name */
+    uint32_t    processPeriod;  /**< Period in us of the process() calls, 0 if not called */
+};
+
+/**
+ * A load profile in test.
+ */
+struct Scenario
+{
+    const char*         name;       /**< Scenario name */
+    const LoadProfile*  profile;    /**< Load profile */
+    uint32_t            duration;   /**< Duration in s */
+    double              stepTime;   /**< Time in s of the step or a negative value if there is none */
+    double              stepSize;   /**< Absolute power change in W of the step */
+};
+
+/**
+ * Accuracy of a estimator with a load profile.
+ */
+struct Accuracy
+{
+    uint32_t    samples;        /**< Number of rated samples */
+    double      sumAbsErr;      /**< Sum of the absolute errors in W */
+    double      sumErr;         /**< Sum of the errors in W */
+    double      sumPower;       /**< Sum of the true power in W */
+    double      maxAbsErr;      /**< Max. absolute error in W */
+    double      overshoot;      /**< Max. error in W above the true power */
+    double      lastOutside;    /**< Time in s of the last sample after the step, whose error was out of tolerance */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool loadProfile(const char* fileName, RecordedLoad& profile);
+static void runScenario(const Estimator& estimator, const Scenario& scenario, uint32_t pulsesPerKWh, uint32_t sampleInterval, Accuracy& accuracy);
+static void printAccuracy(const Estimator& estimator, const Scenario& scenario, uint32_t sampleInterval, const Accuracy& accuracy);
+static void printUsage(const char* prgName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Default number of pulses per kWh, like most household energy meters. */
+static const uint32_t   DEFAULT_PULSES_PER_KWH  = 1000U;
+
+/** Default sample interval in s, like a poller. */
+static const uint32_t   DEFAULT_SAMPLE_INTERVAL = 1U;
+
+/** Duration in s of the warm-up phase, which is not rated. */
+static const uint32_t   WARM_UP                 = 300U;
+
+/** Tolerance of the lag, relative to the step size. */
+static const double     LAG_TOLERANCE           = 0.05;
+
+/** 1 hour in s */
+static const uint32_t   HOUR                    = 3600U;
+
+/** Power estimators */
+static const Estimator  ESTIMATORS[]            =
+{
+    { "interval",       0U                                          },
+    { "intervalDecay",  S0PulseGenerator::DEFAULT_PROCESS_PERIOD    }
+};
+
+/** Constant power */
+static const ConstantLoad   gConstantLoad(1000.0);
+
+/** A consumer is switched on. */
+static const StepLoad       gStepUpLoad(100.0, 3000.0, 1800.0);
+
+/** A consumer is switched off, the base load remains. */
+static const StepLoad       gStepDownLoad(3000.0, 100.0, 1800.0);
+
+/** All consumers are switched off. */
+static const StepLoad       gSwitchOffLoad(2000.0, 0.0, 1800.0);
+
+/** A heat pump, which ramps up slowly. */
+static const RampLoad       gRampLoad(100.0, 3000.0, 600.0, 1800.0);
+
+/** A inverter with a unsteady input. */
+static const RippleLoad     gRippleLoad(1000.0, 500.0, 600.0);
+
+/** Recorded load profile, given by the command line. */
+static RecordedLoad         gRecordedLoad;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Process entry point.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "pulses-per-kwh", required_argument,  nullptr,    'p' },
+        { "sample",         required_argument,  nullptr,    's' },
+        { "profile",        required_argument,  nullptr,    'l' },
+        { "filter",         required_argument,  nullptr,    'f' },
+        { "help",           no_argument,        nullptr,    'h' },
+        { nullptr,          0,                  nullptr,    0   }
+    };
+    Scenario                    scenarios[] =
+    {
+        { "constant",   &gConstantLoad,     2U * HOUR,  -1.0,       0.0     },
+        { "stepUp",     &gStepUpLoad,       HOUR,       1800.0,     2900.0  },
+        { "stepDown",   &gStepDownLoad,     HOUR,       1800.0,     2900.0  },
+        { "switchOff",  &gSwitchOffLoad,    HOUR,       1800.0,     2000.0  },
+        { "ramp",       &gRampLoad,         HOUR,       -1.0,       0.0     },
+        { "ripple",     &gRippleLoad,       2U * HOUR,  -1.0,       0.0     },
+        { "recorded",   nullptr,            0U,         -1.0,       0.0     }
+    };
+    const char*                 filter          = nullptr;
+    long                        pulsesPerKWh    = DEFAULT_PULSES_PER_KWH;
+    long                        sampleInterval  = DEFAULT_SAMPLE_INTERVAL;
+    int                         opt             = 0;
+    size_t                      estimatorIdx    = 0U;
+    size_t                      scenarioIdx     = 0U;
+
+    while(-1 != (opt = getopt_long(argc, argv, "p:s:l:f:h", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 'p':
+            pulsesPerKWh = strtol(optarg, nullptr, 0);
+
+            if ((static_cast<long>(S0Smartmeter::PULSES_PER_KWH_RANGE_MIN) > pulsesPerKWh) ||
+                (static_cast<long>(S0Smartmeter::PULSES_PER_KWH_RANGE_MAX) < pulsesPerKWh))
+            {
+                fprintf(stderr, "Invalid number of pulses per kWh: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 's':
+            sampleInterval = strtol(optarg, nullptr, 0);
+
+            if ((0 >= sampleInterval) || (static_cast<long>(HOUR) < sampleInterval))
+            {
+                fprintf(stderr, "Invalid sample interval: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'l':
+            if (false == loadProfile(optarg, gRecordedLoad))
+            {
+                return EXIT_FAILURE;
+            }
+
+            scenarios[6].profile    = &gRecordedLoad;
+            scenarios[6].duration   = static_cast<uint32_t>(gRecordedLoad.getDuration());
+            break;
+
+        case 'f':
+            filter = optarg;
+            break;
+
+        case 'h':
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+
+        default:
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for(scenarioIdx = 0U; scenarioIdx < (sizeof(scenarios) / sizeof(scenarios[0])); ++scenarioIdx)
+    {
+        const Scenario& scenario = scenarios[scenarioIdx];
+
+        if (nullptr == scenario.profile)
+        {
+            continue;
+        }
+
+        for(estimatorIdx = 0U; estimatorIdx < (sizeof(ESTIMATORS) / sizeof(ESTIMATORS[0])); ++estimatorIdx)
+        {
+            const Estimator&    estimator = ESTIMATORS[estimatorIdx];
+            Accuracy            accuracy;
+
+            if ((nullptr != filter) &&
+                (nullptr == strstr(scenario.name, filter)) &&
+                (nullptr == strstr(estimator.name, filter)))
+            {
+                continue;
+            }
+
+            runScenario(estimator, scenario, static_cast<uint32_t>(pulsesPerKWh), static_cast<uint32_t>(sampleInterval), accuracy);
+            printAccuracy(estimator, scenario, static_cast<uint32_t>(sampleInterval), accuracy);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Load a recorded load profile from a CSV file. Every line contains the time
+ * in s since the start and the power in W, separated by a comma. Empty lines
+ * and lines starting with # are skipped.
+ *
+ * @param[in]   fileName    CSV file name
+ * @param[out]  profile     Load profile
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool loadProfile(const char* fileName, RecordedLoad& profile)
+{
+    FILE*       fd          = fopen(fileName, "r");
+    char        line[128];
+    uint32_t    lineNo      = 0U;
+    bool        isSuccessful = true;
+
+    if (nullptr == fd)
+    {
+        perror(fileName);
+        return false;
+    }
+
+    while((true == isSuccessful) && (nullptr != fgets(line, sizeof(line), fd)))
+    {
+        double t        = 0.0;
+        double power    = 0.0;
+
+        ++lineNo;
+
+        if (('#' == line[0]) || ('\n' == line[0]) || ('\r' == line[0]) || ('\0' == line[0]))
+        {
+            continue;
+        }
+
+        if ((2 != sscanf(line, "%lf,%lf", &t, &power)) ||
+            (false == profile.addSample(t, power)))
+        {
+            fprintf(stderr, "%s:%u: Invalid sample.\n", fileName, lineNo);
+            isSuccessful = false;
+        }
+    }
+
+    (void)fclose(fd);
+
+    if ((true == isSuccessful) &&
+        (static_cast<double>(WARM_UP) >= profile.getDuration()))
+    {
+        fprintf(stderr, "%s: The profile must be longer than the warm-up of %u s.\n", fileName, WARM_UP);
+        isSuccessful = false;
+    }
+
+    return isSuccessful;
+}
+
+/**
+ * Run a estimator with a load profile and rate the estimated power.
+ *
+ * @param[in]   estimator       Power estimator
+ * @param[in]   scenario        Load profile
+ * @param[in]   pulsesPerKWh    Pulses per kWh of the S0 interface
+ * @param[in]   sampleInterval  Sample interval in s
+ * @param[out]  accuracy        Accuracy
+ */
+static void runScenario(const Estimator& estimator, const Scenario& scenario, uint32_t pulsesPerKWh, uint32_t sampleInterval, Accuracy& accuracy)
+{
+    S0Smartmeter    s0Smartmeter;
+    uint32_t        t               = 0U;
+    double          tolerance       = LAG_TOLERANCE * scenario.stepSize;
+
+    VirtualClock::reset();
+    HalTest::reset();
+
+    memset(&accuracy, 0, sizeof(accuracy));
+    accuracy.lastOutside = -1.0;
+
+    (void)s0Smartmeter.init(0U, "accuracy", S0Pin::mcPinRangeMin, pulsesPerKWh);
+    s0Smartmeter.enable();
+
+    S0PulseGenerator generator(s0Smartmeter, *scenario.profile);
+
+    generator.setProcessPeriod(estimator.processPeriod);
+
+    for(t = sampleInterval; t <= scenario.duration; t += sampleInterval)
+    {
+        unsigned long   power       = 0UL;
+        unsigned long   energy      = 0UL;
+        uint32_t        pulseCnt    = 0U;
+        double          truePower   = 0.0;
+        double          err         = 0.0;
+        bool            isAfterStep = false;
+
+        generator.runSeconds(sampleInterval);
+        s0Smartmeter.getResult(power, energy, pulseCnt);
+
+        if (WARM_UP > t)
+        {
+            continue;
+        }
+
+        truePower   = scenario.profile->getPower(static_cast<double>(t));
+        err         = static_cast<double>(power) - truePower;
+        isAfterStep = (0.0 <= scenario.stepTime) && (scenario.stepTime <= static_cast<double>(t));
+
+        ++accuracy.samples;
+        accuracy.sumAbsErr  += fabs(err);
+        accuracy.sumErr     += err;
+        accuracy.sumPower   += truePower;
+
+        if (accuracy.maxAbsErr < fabs(err))
+        {
+            accuracy.maxAbsErr = fabs(err);
+        }
+
+        if (((0.0 > scenario.stepTime) || (true == isAfterStep)) &&
+            (accuracy.overshoot < err))
+        {
+            accuracy.overshoot = err;
+        }
+
+        if ((true == isAfterStep) &&
+            (tolerance < fabs(err)))
+        {
+            accuracy.lastOutside = static_cast<double>(t);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Print the accuracy as JSON line.
+ *
+ * @param[in] estimator         Power estimator
+ * @param[in] scenario          Load profile
+ * @param[in] sampleInterval    Sample interval in s
+ * @param[in] accuracy          Accuracy
+ */
+static void printAccuracy(const Estimator& estimator, const Scenario& scenario, uint32_t sampleInterval, const Accuracy& accuracy)
+{
+    double samples = (0U == accuracy.samples) ? 1.0 : static_cast<double>(accuracy.samples);
+
+    printf("{\"name\":\"accuracy.%s.%s\",\"samples\":%u,\"maeW\":%.1f,\"maePct\":%.2f,\"biasW\":%.1f,\"maxErrW\":%.1f,\"overshootW\":%.1f",
+        estimator.name,
+        scenario.name,
+        accuracy.samples,
+        accuracy.sumAbsErr / samples,
+        (0.0 < accuracy.sumPower) ? (100.0 * accuracy.sumAbsErr / accuracy.sumPower) : 0.0,
+        accuracy.sumErr / samples,
+        accuracy.maxAbsErr,
+        accuracy.overshoot);
+
+    if (0.0 <= scenario.stepTime)
+    {
+        /* The error never left the tolerance or it is within since the sample after the last one outside. */
+        double  lag         = 0.0;
+        bool    isSettled   = (static_cast<double>(scenario.duration) > accuracy.lastOutside);
+
+        if (scenario.stepTime <= accuracy.lastOutside)
+        {
+            lag = accuracy.lastOutside + static_cast<double>(sampleInterval) - scenario.stepTime;
+        }
+
+        printf(",\"lagS\":%.0f,\"isSettled\":%s", lag, (true == isSettled) ? "true" : "false");
+    }
+
+    printf("}\n");
+
+    return;
+}
+
+/**
+ * Print the command line usage.
+ *
+ * @param[in] prgName   Program name
+ */
+static void printUsage(const char* prgName)
+{
+    printf("Usage: %s [options]\n", prgName);
+    printf("  -p, --pulses-per-kwh N    Pulses per kWh of the S0 interface (default: %u).\n", DEFAULT_PULSES_PER_KWH);
+    printf("  -s, --sample S            Sample interval in s (default: %u).\n", DEFAULT_SAMPLE_INTERVAL);
+    printf("  -l, --profile FILE        Recorded load profile (CSV: time in s, power in W).\n");
+    printf("  -f, --filter TEXT         Run only the load profiles or estimators, whose name contains the text.\n");
+    printf("  -h, --help                Show this help.\n");
+}
+
+#endif  /* defined(HAL_TEST) */
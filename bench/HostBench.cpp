@@ -0,0 +1,673 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Host benchmarks of the firmware hot paths
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Measures the per-call cost and the throughput of the firmware hot paths on
+ * the host, with the Linux backend of the hardware abstraction layer. Every
+ * benchmark runs several rounds, each long enough to hide the clock
+ * resolution. The results are written as JSON lines to stdout, one object
+ * per benchmark, so they can be compared by scripts.
+ *
+ * The absolute numbers are not the ones of the target. Use them to compare
+ * two variants of the same code and /api/diagnostics/bench on the target.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Hal.h"
+
+#if defined(HAL_LINUX)
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <EthernetClient.h>
+#include <getopt.h>
+#include <time.h>
+#include <algorithm>
+
+#include "WebReqRouter.h"
+#include "FormParser.h"
+#include "S0Model.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Read-only stream over a string in memory, used to parse HTTP requests.
+ */
+class MemStream : public Stream
+{
+public:
+
+    /**
+     * Constructs a stream over a zero terminated string.
+     *
+     * @param[in] str   String, which must exist during the lifetime of the stream.
+     */
+    explicit MemStream(const char* str) :
+        Stream(),
+        m_str(str),
+        m_pos(0U),
+        m_len(strlen(str))
+    {
+    }
+
+    /**
+     * Destroys the stream.
+     */
+    ~MemStream()
+    {
+    }
+
+    int available(void) override
+    {
+        return static_cast<int>(m_len - m_pos);
+    }
+
+    int read(void) override
+    {
+        int data = -1;
+
+        if (m_len > m_pos)
+        {
+            data = static_cast<uint8_t>(m_str[m_pos]);
+            ++m_pos;
+        }
+
+        return data;
+    }
+
+    int peek(void) override
+    {
+        return (m_len > m_pos) ? static_cast<uint8_t>(m_str[m_pos]) : -1;
+    }
+
+    size_t write(uint8_t data) override
+    {
+        (void)data;
+
+        return 0U;
+    }
+
+private:
+
+    const char* m_str;  /**< String */
+    size_t      m_pos;  /**< Read position */
+    size_t      m_len;  /**< String length */
+
+    MemStream();
+    MemStream(const MemStream& stream);
+    MemStream& operator=(const MemStream& stream);
+};
+
+/** Number of web request routes, like in the firmware with all diagnostics. */
+static const uint8_t    NUM_ROUTES  = 16U;
+
+/**
+ * Context of the benchmarks.
+ */
+struct BenchCtx
+{
+    S0Smartmeter            s0Smartmeters[CONFIG_S0_SMARTMETER_MAX_NUM];   /**< S0 smartmeters */
+    unsigned long           timestamp;                                      /**< Timestamp of the next pulse in ms */
+    WebReqRouter<NUM_ROUTES> router;                                        /**< Web request router */
+    EthernetClient          client;                                         /**< Not connected client, the handlers never use it */
+    HttpRequest*            request;                                        /**< Request, which to dispatch */
+    const char*             formBody;                                       /**< Body of a S0 interface configuration */
+    size_t                  formBodyLen;                                    /**< Body length in bytes */
+};
+
+/**
+ * A single benchmark.
+ */
+struct BenchEntry
+{
+    const char* name;               /**< Benchmark name */
+    void        (*func)(BenchCtx&); /**< Benchmark function, which is measured */
+    const char* rawRequest;         /**< Raw HTTP request, which is parsed before or nullptr */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void handleNothing(EthernetClient& client, const HttpRequest& httpRequest);
+static bool initCtx(BenchCtx& ctx);
+static uint64_t getNanos(void);
+static void runBenchmark(const BenchEntry& entry, BenchCtx& ctx, uint8_t rounds);
+static void benchInternalISR(BenchCtx& ctx);
+static void benchGetResult(BenchCtx& ctx);
+static void benchProcess(BenchCtx& ctx);
+static void benchRouterHandle(BenchCtx& ctx);
+static void benchJsonOneChannel(BenchCtx& ctx);
+static void benchJsonAllChannels(BenchCtx& ctx);
+static void benchConfigForm(BenchCtx& ctx);
+static void printUsage(const char* prgName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Default number of rounds per benchmark. */
+static const uint8_t    DEFAULT_ROUNDS      = 7U;
+
+/** Min. duration of a single round in ns. */
+static const uint64_t   MIN_ROUND_DURATION  = 20000000ULL;
+
+/** Request, which matches the first route. */
+static const char       REQ_FIRST[]         = "GET / HTTP/1.1\r\nHost: bench\r\n\r\n";
+
+/** Request, which matches a route in the middle of the table. */
+static const char       REQ_S0_INTERFACE[]  = "GET /api/s0-interface/1 HTTP/1.1\r\nHost: bench\r\n\r\n";
+
+/** Request, which matches the last route. */
+static const char       REQ_LAST[]          = "POST /api/diagnostics/trace/clear HTTP/1.1\r\nHost: bench\r\n\r\n";
+
+/** Request, which matches no route. */
+static const char       REQ_MISS[]          = "GET /favicon.ico HTTP/1.1\r\nHost: bench\r\n\r\n";
+
+/** Typical body of a S0 interface configuration, sent by the HTML form. */
+static const char       FORM_BODY[]         = "isEnabled=1&name=Heat+pump%20%28ground%29&pinS0=25&pulsesPerKWH=1000";
+
+/** The result is written to it, so the compiler can't remove the benchmarked code. */
+static volatile uint32_t gSink              = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Process entry point.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "rounds", required_argument,  nullptr,    'r' },
+        { "filter", required_argument,  nullptr,    'f' },
+        { "help",   no_argument,        nullptr,    'h' },
+        { nullptr,  0,                  nullptr,    0   }
+    };
+    static const BenchEntry     entries[]   =
+    {
+        { "s0.internalISR",         benchInternalISR,       nullptr             },
+        { "s0.getResult",           benchGetResult,         nullptr             },
+        { "s0.process",             benchProcess,           nullptr             },
+        { "router.handle.first",    benchRouterHandle,      REQ_FIRST           },
+        { "router.handle.middle",   benchRouterHandle,      REQ_S0_INTERFACE    },
+        { "router.handle.last",     benchRouterHandle,      REQ_LAST            },
+        { "router.handle.miss",     benchRouterHandle,      REQ_MISS            },
+        { "json.oneChannel",        benchJsonOneChannel,    nullptr             },
+        { "json.allChannels",       benchJsonAllChannels,   nullptr             },
+        { "form.configPost",        benchConfigForm,        nullptr             }
+    };
+    BenchCtx                    ctx;
+    const char*                 filter      = nullptr;
+    long                        rounds      = DEFAULT_ROUNDS;
+    int                         opt         = 0;
+    size_t                      idx         = 0U;
+
+    while(-1 != (opt = getopt_long(argc, argv, "r:f:h", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 'r':
+            rounds = strtol(optarg, nullptr, 0);
+
+            if ((0 >= rounds) || (UINT8_MAX < rounds))
+            {
+                fprintf(stderr, "Invalid number of rounds: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'f':
+            filter = optarg;
+            break;
+
+        case 'h':
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+
+        default:
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (false == initCtx(ctx))
+    {
+        fprintf(stderr, "Benchmark initialization failed.\n");
+        return EXIT_FAILURE;
+    }
+
+    for(idx = 0U; idx < (sizeof(entries) / sizeof(entries[0])); ++idx)
+    {
+        const BenchEntry&   entry   = entries[idx];
+        MemStream           stream((nullptr != entry.rawRequest) ? entry.rawRequest : "");
+        HttpRequest         request(stream);
+
+        if ((nullptr != filter) &&
+            (nullptr == strstr(entry.name, filter)))
+        {
+            continue;
+        }
+
+        if (nullptr != entry.rawRequest)
+        {
+            if (false == request.readRequest())
+            {
+                fprintf(stderr, "Invalid request of %s.\n", entry.name);
+                return EXIT_FAILURE;
+            }
+
+            ctx.request = &request;
+        }
+
+        runBenchmark(entry, ctx, static_cast<uint8_t>(rounds));
+
+        ctx.request = nullptr;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * ISR of the S0 port pin changes. No pulses are injected by the benchmarks.
+ */
+HAL_S0_PIN_CHANGE_ISR()
+{
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Web request handler, which does nothing. The router dispatch is measured.
+ *
+ * @param[in] client        Ethernet client
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handleNothing(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    (void)client;
+    (void)httpRequest;
+
+    ++gSink;
+}
+
+/**
+ * Initialize the benchmark context with the S0 interfaces and routes of the firmware.
+ *
+ * @param[out] ctx  Benchmark context
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool initCtx(BenchCtx& ctx)
+{
+    static const struct
+    {
+        ArduinoHttpServer::Method   method;
+        const char*                 uri;
+    } routes[NUM_ROUTES] =
+    {
+        { ArduinoHttpServer::Method::Get,   "/"                         },
+        { ArduinoHttpServer::Method::Get,   "/api/s0-interface/?"       },
+        { ArduinoHttpServer::Method::Get,   "/api/s0-interfaces"        },
+        { ArduinoHttpServer::Method::Get,   "/api/s0-interfaces/delta?" },
+        { ArduinoHttpServer::Method::Get,   "/configure/?"              },
+        { ArduinoHttpServer::Method::Post,  "/configure/?"              },
+        { ArduinoHttpServer::Method::Get,   "/reset"                    },
+        { ArduinoHttpServer::Method::Get,   "/api/diagnostics/net"      },
+        { ArduinoHttpServer::Method::Get,   "/api/config"               },
+        { ArduinoHttpServer::Method::Put,   "/api/config"               },
+        { ArduinoHttpServer::Method::Get,   "/api/log?"                 },
+        { ArduinoHttpServer::Method::Get,   "/api/pulses?"              },
+        { ArduinoHttpServer::Method::Get,   "/api/diagnostics/irq"      },
+        { ArduinoHttpServer::Method::Get,   "/api/diagnostics/bench"    },
+        { ArduinoHttpServer::Method::Get,   "/api/diagnostics/trace"    },
+        { ArduinoHttpServer::Method::Post,  "/api/diagnostics/trace/?"  }
+    };
+    bool    isSuccessful    = true;
+    uint8_t idx             = 0U;
+
+    for(idx = 0U; idx < CONFIG_S0_SMARTMETER_MAX_NUM; ++idx)
+    {
+        char name[sizeof(PersistentMemory::S0Data::name)];
+
+        snprintf(name, sizeof(name), "S0-%u", idx);
+
+        if (false == ctx.s0Smartmeters[idx].init(idx, name, S0Pin::mcPinRangeMin + idx, 1000U))
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            ctx.s0Smartmeters[idx].enable();
+        }
+    }
+
+    for(idx = 0U; idx < NUM_ROUTES; ++idx)
+    {
+        if (false == ctx.router.addRoute(routes[idx].method, routes[idx].uri, handleNothing))
+        {
+            isSuccessful = false;
+        }
+    }
+
+    ctx.timestamp   = 0UL;
+    ctx.request     = nullptr;
+    ctx.formBody    = FORM_BODY;
+    ctx.formBodyLen = strlen(FORM_BODY);
+
+    /* Two pulses are needed, that the power is calculated. */
+    ctx.s0Smartmeters[0].internalISR(ctx.timestamp);
+    ctx.timestamp += 1000U;
+    ctx.s0Smartmeters[0].internalISR(ctx.timestamp);
+
+    return isSuccessful;
+}
+
+/**
+ * Get the time of the monotonic clock.
+ *
+ * @return Time in ns
+ */
+static uint64_t getNanos(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * Run a benchmark and print its result as JSON line.
+ *
+ * The number of iterations per round is doubled, until a round lasts at
+ * least MIN_ROUND_DURATION. The min. of all rounds is the cost without
+ * interference, the median the typical one.
+ *
+ * @param[in] entry     Benchmark
+ * @param[in] ctx       Benchmark context
+ * @param[in] rounds    Number of rounds
+ */
+static void runBenchmark(const BenchEntry& entry, BenchCtx& ctx, uint8_t rounds)
+{
+    uint64_t    iterations  = 1U;
+    uint64_t    duration    = 0U;
+    uint64_t    iteration   = 0U;
+    uint8_t     round       = 0U;
+    double      nsPerCall[UINT8_MAX];
+    double      median      = 0.0;
+
+    /* Calibrate, which warms up the caches too. */
+    while(MIN_ROUND_DURATION > duration)
+    {
+        uint64_t start = 0U;
+
+        iterations *= 2U;
+        start       = getNanos();
+
+        for(iteration = 0U; iteration < iterations; ++iteration)
+        {
+            entry.func(ctx);
+        }
+
+        duration = getNanos() - start;
+    }
+
+    for(round = 0U; round < rounds; ++round)
+    {
+        uint64_t start = getNanos();
+
+        for(iteration = 0U; iteration < iterations; ++iteration)
+        {
+            entry.func(ctx);
+        }
+
+        duration            = getNanos() - start;
+        nsPerCall[round]    = static_cast<double>(duration) / static_cast<double>(iterations);
+    }
+
+    std::sort(&nsPerCall[0], &nsPerCall[rounds]);
+
+    if (0U == (rounds % 2U))
+    {
+        median = (nsPerCall[rounds / 2U - 1U] + nsPerCall[rounds / 2U]) / 2.0;
+    }
+    else
+    {
+        median = nsPerCall[rounds / 2U];
+    }
+
+    printf("{\"name\":\"%s\",\"iterations\":%llu,\"rounds\":%u,\"minNs\":%.2f,\"medianNs\":%.2f,\"maxNs\":%.2f,\"callsPerSec\":%.0f}\n",
+        entry.name,
+        static_cast<unsigned long long>(iterations),
+        rounds,
+        nsPerCall[0],
+        median,
+        nsPerCall[rounds - 1U],
+        1000000000.0 / median);
+
+    return;
+}
+
+/**
+ * Benchmark: Handle a pulse of a S0 smartmeter.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchInternalISR(BenchCtx& ctx)
+{
+    ctx.timestamp += 1000U;
+
+    HAL_ATOMIC_BLOCK()
+    {
+        ctx.s0Smartmeters[0].internalISR(ctx.timestamp);
+    }
+
+    return;
+}
+
+/**
+ * Benchmark: Get the result of a S0 smartmeter.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchGetResult(BenchCtx& ctx)
+{
+    unsigned long   powerConsumption    = 0;
+    unsigned long   energyConsumption   = 0;
+    uint32_t        pulseCnt            = 0;
+
+    ctx.s0Smartmeters[0].getResult(powerConsumption, energyConsumption, pulseCnt);
+
+    gSink = gSink + powerConsumption + pulseCnt;
+
+    return;
+}
+
+/**
+ * Benchmark: Power consumption calculation of a S0 smartmeter, called by the main loop.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchProcess(BenchCtx& ctx)
+{
+    ctx.s0Smartmeters[0].process();
+
+    return;
+}
+
+/**
+ * Benchmark: Dispatch a web request by the router, with the routes of the firmware.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchRouterHandle(BenchCtx& ctx)
+{
+    if (true == ctx.router.handle(ctx.client, *ctx.request))
+    {
+        ++gSink;
+    }
+
+    return;
+}
+
+/**
+ * Benchmark: JSON serialization of one S0 interface, like /api/s0-interface/0.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchJsonOneChannel(BenchCtx& ctx)
+{
+    String              data;
+    S0Snapshot          snapshot;
+    DynamicJsonDocument jsonDoc(256);
+    JsonObject          jsonData    = jsonDoc.createNestedObject("data");
+
+    snapshot.capture(ctx.s0Smartmeters, CONFIG_S0_SMARTMETER_MAX_NUM);
+    S0Model::toJson(ctx.s0Smartmeters[0], snapshot.getChannel(0), jsonData);
+    jsonDoc["seq"]          = snapshot.getSeq();
+    jsonDoc["timestamp"]    = snapshot.getTimestamp();
+    jsonDoc["status"]       = 0;
+
+    gSink = gSink + serializeJson(jsonDoc, data);
+
+    return;
+}
+
+/**
+ * Benchmark: JSON serialization of all S0 interfaces, like /api/s0-interfaces.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchJsonAllChannels(BenchCtx& ctx)
+{
+    String              data;
+    uint8_t             index           = 0;
+    S0Snapshot          snapshot;
+    DynamicJsonDocument jsonDoc(CONFIG_S0_SMARTMETER_MAX_NUM * 256);
+    JsonArray           jsonDataArray   = jsonDoc.createNestedArray("data");
+
+    snapshot.capture(ctx.s0Smartmeters, CONFIG_S0_SMARTMETER_MAX_NUM);
+
+    for(index = 0; index < CONFIG_S0_SMARTMETER_MAX_NUM; ++index)
+    {
+        JsonObject jsonData = jsonDataArray.createNestedObject();
+
+        S0Model::toJson(ctx.s0Smartmeters[index], snapshot.getChannel(index), jsonData);
+    }
+
+    jsonDoc["seq"]          = snapshot.getSeq();
+    jsonDoc["timestamp"]    = snapshot.getTimestamp();
+    jsonDoc["status"]       = 0;
+
+    gSink = gSink + serializeJson(jsonDoc, data);
+
+    return;
+}
+
+/**
+ * Benchmark: Parse the body of a S0 interface configuration, like POST /configure/0.
+ * The body is fed byte by byte, like it arrives from the client.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchConfigForm(BenchCtx& ctx)
+{
+    S0Model::ConfigForm form;
+    char                value[sizeof(form.s0Data.name)];
+    FormParser          formParser(S0Model::CONFIG_FORM_FIELDS,
+                                   S0Model::NUM_CONFIG_FORM_FIELDS,
+                                   value,
+                                   sizeof(value),
+                                   &form);
+    size_t              idx         = 0U;
+
+    form.isDirty = false;
+
+    for(idx = 0U; idx < ctx.formBodyLen; ++idx)
+    {
+        formParser.parse(ctx.formBody[idx]);
+    }
+    formParser.finish();
+
+    if (true == form.isDirty)
+    {
+        ++gSink;
+    }
+
+    return;
+}
+
+/**
+ * Print the command line usage.
+ *
+ * @param[in] prgName   Program name
+ */
+static void printUsage(const char* prgName)
+{
+    printf("Usage: %s [options]\n", prgName);
+    printf("  -r, --rounds N        Number of rounds per benchmark (default: %u).\n", DEFAULT_ROUNDS);
+    printf("  -f, --filter TEXT     Run only the benchmarks, whose name contains the text.\n");
+    printf("  -h, --help            Show this help.\n");
+}
+
+#endif  /* defined(HAL_LINUX) */
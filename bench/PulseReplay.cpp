@@ -0,0 +1,617 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Replay of pulse traces for regression testing
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Feeds the pulses of a recorded pulse trace, see lib/Test/PulseTrace.h, into
+ * S0Smartmeter as fast as possible, with the virtual clock of the test
+ * backend and process() called like by the main loop. Every channel is
+ * sampled like a poller does and the results are written as JSON lines to
+ * stdout, one object per channel:
+ * - pulses, energyWs: Pulses in the trace and the energy reported by S0Smartmeter.
+ * - energyErrPct: Error of the reported energy, relative to the exact energy of the pulses.
+ * - meanPowerW: Mean of the sampled power.
+ * - refPowerW: Mean of the true average power between the pulses, at the same samples.
+ * - maeW, maePct: Mean absolute error in W and relative to refPowerW.
+ * - gaps: Number of gaps in the trace, whose samples are not rated.
+ *
+ * A channel fails, if the energy or the mean power deviates by more than the
+ * tolerance. With a baseline, i.e. the output of a previous run, it fails too,
+ * if the results deviate from the baseline by more than the tolerance.
+ * The exit status is non-zero, if a channel fails.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Hal.h"
+
+#if defined(HAL_TEST)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+#include <vector>
+
+#include <S0Smartmeter.hpp>
+#include <PulseTrace.h>
+#include <S0PulseGenerator.h>
+#include <VirtualClock.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * A pulse of a channel.
+ */
+struct Pulse
+{
+    uint64_t    time;           /**< Time in ms since the start of the trace */
+    bool        isAfterGap;     /**< Were records lost before this pulse? */
+};
+
+/**
+ * Pulses of a channel.
+ */
+struct Channel
+{
+    uint16_t            pulsesPerKWh;   /**< Pulses per kWh */
+    std::vector<Pulse>  pulses;         /**< Pulses in chronological order */
+    uint32_t            gaps;           /**< Number of gaps */
+};
+
+/**
+ * Result of a channel.
+ */
+struct Result
+{
+    uint32_t    pulses;         /**< Number of pulses */
+    uint64_t    energy;         /**< Reported energy in Ws */
+    double      energyErrPct;   /**< Error of the reported energy in % */
+    uint32_t    samples;        /**< Number of rated samples */
+    double      meanPower;      /**< Mean of the sampled power in W */
+    double      refPower;       /**< Mean of the true power in W */
+    double      mae;            /**< Mean absolute error in W */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool loadTrace(const char* fileName, uint64_t& duration);
+static void replayChannel(uint8_t channelId, uint64_t duration, uint32_t sampleInterval, Result& result);
+static bool checkResult(uint8_t channelId, const Result& result, const char* baselineFile, double tolerance);
+static bool getBaselineValue(const char* baselineFile, uint8_t channelId, const char* key, double& value);
+static bool isWithin(double value, double expected, double tolerance);
+static void printUsage(const char* prgName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Default sample interval in s, like a poller. */
+static const uint32_t   DEFAULT_SAMPLE_INTERVAL = 1U;
+
+/** Default tolerance in %. */
+static const double     DEFAULT_TOLERANCE       = 5.0;
+
+/** Energy in Ws of 1 kWh */
+static const double     ENERGY_KWH              = 3600000.0;
+
+/** Number of channels in the trace. */
+static uint8_t          gNumChannels            = 0U;
+
+/** Pulses of every channel in the trace. */
+static Channel          gChannels[PulseTrace::MAX_CHANNELS];
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Process entry point.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "sample",     required_argument,  nullptr,    's' },
+        { "baseline",   required_argument,  nullptr,    'b' },
+        { "tolerance",  required_argument,  nullptr,    't' },
+        { "help",       no_argument,        nullptr,    'h' },
+        { nullptr,      0,                  nullptr,    0   }
+    };
+    const char*                 baselineFile    = nullptr;
+    long                        sampleInterval  = DEFAULT_SAMPLE_INTERVAL;
+    double                      tolerance       = DEFAULT_TOLERANCE;
+    uint64_t                    duration        = 0U;
+    int                         opt             = 0;
+    uint8_t                     channelId       = 0U;
+    bool                        isPassed        = true;
+
+    while(-1 != (opt = getopt_long(argc, argv, "s:b:t:h", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 's':
+            sampleInterval = strtol(optarg, nullptr, 0);
+
+            if ((0 >= sampleInterval) || (3600 < sampleInterval))
+            {
+                fprintf(stderr, "Invalid sample interval: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'b':
+            baselineFile = optarg;
+            break;
+
+        case 't':
+            tolerance = strtod(optarg, nullptr);
+
+            if (0.0 > tolerance)
+            {
+                fprintf(stderr, "Invalid tolerance: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'h':
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+
+        default:
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((optind + 1) != argc)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (false == loadTrace(argv[optind], duration))
+    {
+        return EXIT_FAILURE;
+    }
+
+    for(channelId = 0U; channelId < gNumChannels; ++channelId)
+    {
+        Result  result;
+        bool    isChannelPassed = false;
+
+        replayChannel(channelId, duration, static_cast<uint32_t>(sampleInterval), result);
+        isChannelPassed = checkResult(channelId, result, baselineFile, tolerance);
+
+        printf("{\"name\":\"replay.ch%u\",\"pulses\":%u,\"energyWs\":%llu,\"energyErrPct\":%.3f,\"samples\":%u,"
+               "\"meanPowerW\":%.1f,\"refPowerW\":%.1f,\"maeW\":%.1f,\"maePct\":%.2f,\"gaps\":%u,\"isPassed\":%s}\n",
+            channelId,
+            result.pulses,
+            static_cast<unsigned long long>(result.energy),
+            result.energyErrPct,
+            result.samples,
+            result.meanPower,
+            result.refPower,
+            result.mae,
+            (0.0 < result.refPower) ? (100.0 * result.mae / result.refPower) : 0.0,
+            gChannels[channelId].gaps,
+            (true == isChannelPassed) ? "true" : "false");
+
+        if (false == isChannelPassed)
+        {
+            isPassed = false;
+        }
+    }
+
+    return (true == isPassed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Load a pulse trace and split it into the pulses of every channel.
+ *
+ * @param[in]   fileName    Pulse trace file name
+ * @param[out]  duration    Duration of the trace in ms
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool loadTrace(const char* fileName, uint64_t& duration)
+{
+    FILE*                   fd          = fopen(fileName, "rb");
+    std::vector<uint8_t>    data;
+    uint8_t                 buffer[4096];
+    size_t                  size        = 0U;
+    bool                    isGap[PulseTrace::MAX_CHANNELS];
+    uint8_t                 channelId   = 0U;
+    PulseTrace::Header      header;
+    PulseTrace::Record      record;
+
+    if (nullptr == fd)
+    {
+        perror(fileName);
+        return false;
+    }
+
+    while(0U < (size = fread(buffer, 1U, sizeof(buffer), fd)))
+    {
+        data.insert(data.end(), buffer, buffer + size);
+    }
+
+    (void)fclose(fd);
+
+    PulseTrace::Reader reader(data.data(), data.size());
+
+    if (false == reader.readHeader(header))
+    {
+        fprintf(stderr, "%s: Not a pulse trace.\n", fileName);
+        return false;
+    }
+
+    gNumChannels = header.numChannels;
+
+    for(channelId = 0U; channelId < gNumChannels; ++channelId)
+    {
+        if ((S0Smartmeter::PULSES_PER_KWH_RANGE_MIN > header.pulsesPerKWh[channelId]) ||
+            (S0Smartmeter::PULSES_PER_KWH_RANGE_MAX < header.pulsesPerKWh[channelId]))
+        {
+            fprintf(stderr, "%s: Invalid pulses per kWh of channel %u.\n", fileName, channelId);
+            return false;
+        }
+
+        gChannels[channelId].pulsesPerKWh = header.pulsesPerKWh[channelId];
+        isGap[channelId]                  = false;
+    }
+
+    duration = 0U;
+
+    while(true == reader.next(record))
+    {
+        duration = record.time;
+
+        if (PulseTrace::CODE_GAP == record.code)
+        {
+            /* It is unknown which channel lost pulses. */
+            for(channelId = 0U; channelId < gNumChannels; ++channelId)
+            {
+                ++gChannels[channelId].gaps;
+                isGap[channelId] = true;
+            }
+        }
+        else
+        {
+            Pulse pulse = { record.time, isGap[record.code] };
+
+            gChannels[record.code].pulses.push_back(pulse);
+            isGap[record.code] = false;
+        }
+    }
+
+    if (true == reader.isError())
+    {
+        fprintf(stderr, "%s: The pulse trace is invalid or truncated.\n", fileName);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Replay the pulses of a channel and rate the sampled power.
+ *
+ * A sample is rated against the true average power between the pulses
+ * around it. Samples before the 2nd pulse, after the last pulse, within a
+ * gap and after it, till the power is derived from a complete interval
+ * again, are not rated.
+ *
+ * @param[in]   channelId       Channel id
+ * @param[in]   duration        Duration of the trace in ms
+ * @param[in]   sampleInterval  Sample interval in s
+ * @param[out]  result          Result
+ */
+static void replayChannel(uint8_t channelId, uint64_t duration, uint32_t sampleInterval, Result& result)
+{
+    const Channel&  channel         = gChannels[channelId];
+    const double    energyPerPulse  = ENERGY_KWH / channel.pulsesPerKWh;
+    const uint64_t  end             = duration * 1000U;
+    const uint64_t  processPeriod   = S0PulseGenerator::DEFAULT_PROCESS_PERIOD;
+    const uint64_t  samplePeriod    = static_cast<uint64_t>(sampleInterval) * 1000000U;
+    uint64_t        nextProcess     = processPeriod;
+    uint64_t        nextSample      = samplePeriod;
+    size_t          pulseIdx        = 0U;
+    double          sumPower        = 0.0;
+    double          sumRefPower     = 0.0;
+    double          sumAbsErr       = 0.0;
+    S0Smartmeter    s0Smartmeter;
+    unsigned long   power           = 0UL;
+    unsigned long   energy          = 0UL;
+    uint32_t        pulseCnt        = 0U;
+
+    VirtualClock::reset();
+    HalTest::reset();
+
+    memset(&result, 0, sizeof(result));
+
+    (void)s0Smartmeter.init(channelId, "replay", S0Pin::mcPinRangeMin + channelId, channel.pulsesPerKWh);
+    s0Smartmeter.enable();
+
+    while(true)
+    {
+        uint64_t nextPulse  = (channel.pulses.size() > pulseIdx) ? (channel.pulses[pulseIdx].time * 1000U) : UINT64_MAX;
+        uint64_t next       = nextPulse;
+
+        if (nextProcess < next)
+        {
+            next = nextProcess;
+        }
+
+        if (nextSample < next)
+        {
+            next = nextSample;
+        }
+
+        if (end < next)
+        {
+            break;
+        }
+
+        VirtualClock::set(next);
+
+        if (next == nextPulse)
+        {
+            s0Smartmeter.internalISR();
+            ++pulseIdx;
+        }
+        else if (next == nextProcess)
+        {
+            s0Smartmeter.process();
+            nextProcess += processPeriod;
+        }
+        else
+        {
+            /* The power is known since the 2nd pulse and the sample is within
+             * the interval of the last and the next pulse.
+             */
+            if ((1U < pulseIdx) &&
+                (channel.pulses.size() > pulseIdx) &&
+                (false == channel.pulses[pulseIdx].isAfterGap) &&
+                (false == channel.pulses[pulseIdx - 1U].isAfterGap))
+            {
+                uint64_t interval = channel.pulses[pulseIdx].time - channel.pulses[pulseIdx - 1U].time;
+
+                s0Smartmeter.getResult(power, energy, pulseCnt);
+
+                if (0U < interval)
+                {
+                    double refPower = energyPerPulse * 1000.0 / static_cast<double>(interval);
+
+                    ++result.samples;
+                    sumPower    += static_cast<double>(power);
+                    sumRefPower += refPower;
+                    sumAbsErr   += fabs(static_cast<double>(power) - refPower);
+                }
+            }
+
+            nextSample += samplePeriod;
+        }
+    }
+
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+
+    result.pulses   = pulseCnt;
+    result.energy   = energy;
+
+    if (0U < pulseCnt)
+    {
+        double exactEnergy = energyPerPulse * static_cast<double>(pulseCnt);
+
+        result.energyErrPct = 100.0 * (static_cast<double>(energy) - exactEnergy) / exactEnergy;
+    }
+
+    if (0U < result.samples)
+    {
+        result.meanPower    = sumPower / result.samples;
+        result.refPower     = sumRefPower / result.samples;
+        result.mae          = sumAbsErr / result.samples;
+    }
+
+    return;
+}
+
+/**
+ * Check the result of a channel against the tolerance and the baseline.
+ * The reasons of a failure are written to stderr.
+ *
+ * @param[in] channelId     Channel id
+ * @param[in] result        Result
+ * @param[in] baselineFile  Baseline file name or nullptr
+ * @param[in] tolerance     Tolerance in %
+ *
+ * @return If the result is within the tolerance, it will return true otherwise false.
+ */
+static bool checkResult(uint8_t channelId, const Result& result, const char* baselineFile, double tolerance)
+{
+    bool    isPassed    = true;
+    double  value       = 0.0;
+
+    if (tolerance < fabs(result.energyErrPct))
+    {
+        fprintf(stderr, "Channel %u: The energy deviates by %.3f %%.\n", channelId, result.energyErrPct);
+        isPassed = false;
+    }
+
+    if (false == isWithin(result.meanPower, result.refPower, tolerance))
+    {
+        fprintf(stderr, "Channel %u: The mean power %.1f W deviates from %.1f W.\n", channelId, result.meanPower, result.refPower);
+        isPassed = false;
+    }
+
+    if (nullptr != baselineFile)
+    {
+        if (false == getBaselineValue(baselineFile, channelId, "energyWs", value))
+        {
+            fprintf(stderr, "Channel %u: Not in the baseline.\n", channelId);
+            isPassed = false;
+        }
+        else if (false == isWithin(static_cast<double>(result.energy), value, tolerance))
+        {
+            fprintf(stderr, "Channel %u: The energy %llu Ws deviates from the baseline %.0f Ws.\n",
+                channelId, static_cast<unsigned long long>(result.energy), value);
+            isPassed = false;
+        }
+
+        if ((true == getBaselineValue(baselineFile, channelId, "meanPowerW", value)) &&
+            (false == isWithin(result.meanPower, value, tolerance)))
+        {
+            fprintf(stderr, "Channel %u: The mean power %.1f W deviates from the baseline %.1f W.\n", channelId, result.meanPower, value);
+            isPassed = false;
+        }
+
+        /* A higher error is a regression, a lower one is fine. */
+        if ((true == getBaselineValue(baselineFile, channelId, "maeW", value)) &&
+            (result.mae > value) &&
+            (false == isWithin(result.mae, value, tolerance)))
+        {
+            fprintf(stderr, "Channel %u: The mean absolute error %.1f W exceeds the baseline %.1f W.\n", channelId, result.mae, value);
+            isPassed = false;
+        }
+    }
+
+    return isPassed;
+}
+
+/**
+ * Get a value of a channel from the baseline, i.e. the JSON lines output of
+ * a previous run.
+ *
+ * @param[in]   baselineFile    Baseline file name
+ * @param[in]   channelId       Channel id
+ * @param[in]   key             Key of the value
+ * @param[out]  value           Value
+ *
+ * @return If the value is found, it will return true otherwise false.
+ */
+static bool getBaselineValue(const char* baselineFile, uint8_t channelId, const char* key, double& value)
+{
+    FILE*   fd          = fopen(baselineFile, "r");
+    char    line[512];
+    char    name[32];
+    char    pattern[32];
+    bool    isFound     = false;
+
+    if (nullptr == fd)
+    {
+        perror(baselineFile);
+        return false;
+    }
+
+    (void)snprintf(name, sizeof(name), "\"name\":\"replay.ch%u\"", channelId);
+    (void)snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+
+    while((false == isFound) && (nullptr != fgets(line, sizeof(line), fd)))
+    {
+        const char* pos = strstr(line, pattern);
+
+        if ((nullptr != strstr(line, name)) &&
+            (nullptr != pos))
+        {
+            value   = strtod(pos + strlen(pattern), nullptr);
+            isFound = true;
+        }
+    }
+
+    (void)fclose(fd);
+
+    return isFound;
+}
+
+/**
+ * Is a value within the tolerance of the expected value?
+ *
+ * @param[in] value     Value
+ * @param[in] expected  Expected value
+ * @param[in] tolerance Tolerance in %
+ *
+ * @return If the value is within the tolerance, it will return true otherwise false.
+ */
+static bool isWithin(double value, double expected, double tolerance)
+{
+    double deviation = fabs(value - expected);
+
+    /* Allow a rounding error of 1 for values near 0. */
+    return (1.0 >= deviation) || ((tolerance * fabs(expected) / 100.0) >= deviation);
+}
+
+/**
+ * Print the command line usage.
+ *
+ * @param[in] prgName   Program name
+ */
+static void printUsage(const char* prgName)
+{
+    printf("Usage: %s [options] TRACE\n", prgName);
+    printf("  -s, --sample S            Sample interval in s (default: %u).\n", DEFAULT_SAMPLE_INTERVAL);
+    printf("  -b, --baseline FILE       Output of a previous run, the results must not deviate from.\n");
+    printf("  -t, --tolerance PCT       Tolerance in %% (default: %.1f).\n", DEFAULT_TOLERANCE);
+    printf("  -h, --help                Show this help.\n");
+}
+
+#endif  /* defined(HAL_TEST) */
@@ -0,0 +1,190 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fuzz target of the S0 interface configuration form parsing
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The input is the body of POST /configure/<id>, which is parsed with the
+ * form fields of the firmware. The first input byte selects the chunk size,
+ * because the body arrives in pieces from the network.
+ *
+ * Checked are:
+ * - The result doesn't depend on the chunk size.
+ * - The name is always terminated and the pin and the number of pulses per
+ *   kWh are in their ranges, if they were changed.
+ * - The configuration is only marked as changed, if it was changed.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Hal.h"
+#include "FormParser.h"
+#include "S0Model.h"
+#include "FuzzSupport.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void parseForm(const uint8_t* data, size_t size, size_t chunkSize, S0Model::ConfigForm& form);
+static bool isEqual(const PersistentMemory::S0Data& s0Data1, const PersistentMemory::S0Data& s0Data2);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    PersistentMemory::S0Data    s0DataDefault;
+    S0Model::ConfigForm         formByBytes;
+    S0Model::ConfigForm         formByChunks;
+    size_t                      chunkSize       = 0U;
+
+    if (0U == size)
+    {
+        return 0;
+    }
+
+    chunkSize = 1U + data[0];
+    ++data;
+    --size;
+
+    parseForm(data, size, 1U, formByBytes);
+    parseForm(data, size, chunkSize, formByChunks);
+
+    FUZZ_CHECK(formByBytes.isDirty == formByChunks.isDirty);
+    FUZZ_CHECK(true == isEqual(formByBytes.s0Data, formByChunks.s0Data));
+
+    FUZZ_CHECK(nullptr != memchr(formByBytes.s0Data.name, '\0', sizeof(formByBytes.s0Data.name)));
+
+    if (false == formByBytes.isDirty)
+    {
+        FUZZ_CHECK(true == isEqual(formByBytes.s0Data, s0DataDefault));
+    }
+
+    if (s0DataDefault.pinS0 != formByBytes.s0Data.pinS0)
+    {
+        FUZZ_CHECK(S0Pin::mcPinRangeMin <= formByBytes.s0Data.pinS0);
+        FUZZ_CHECK(S0Pin::mcPinRangeMax >= formByBytes.s0Data.pinS0);
+    }
+
+    if (s0DataDefault.pulsesPerKWH != formByBytes.s0Data.pulsesPerKWH)
+    {
+        FUZZ_CHECK(S0Smartmeter::PULSES_PER_KWH_RANGE_MIN <= formByBytes.s0Data.pulsesPerKWH);
+        FUZZ_CHECK(S0Smartmeter::PULSES_PER_KWH_RANGE_MAX >= formByBytes.s0Data.pulsesPerKWH);
+    }
+
+    return 0;
+}
+
+/**
+ * ISR of the S0 port pin changes. No pulses are injected by the fuzz targets.
+ */
+HAL_S0_PIN_CHANGE_ISR()
+{
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Parse the form like handleConfigurePostReq() of the firmware, starting
+ * with the default configuration.
+ *
+ * @param[in]   data        Form data
+ * @param[in]   size        Form data size in bytes
+ * @param[in]   chunkSize   Number of bytes, which are parsed at once
+ * @param[out]  form        Parsed form
+ */
+static void parseForm(const uint8_t* data, size_t size, size_t chunkSize, S0Model::ConfigForm& form)
+{
+    PersistentMemory::S0Data    s0DataDefault;
+    char                        value[sizeof(form.s0Data.name)];
+    FormParser                  formParser(S0Model::CONFIG_FORM_FIELDS,
+                                           S0Model::NUM_CONFIG_FORM_FIELDS,
+                                           value,
+                                           sizeof(value),
+                                           &form);
+    size_t                      pos             = 0U;
+
+    form.s0Data     = s0DataDefault;
+    form.isDirty    = false;
+
+    while(size > pos)
+    {
+        size_t len = ((size - pos) < chunkSize) ? (size - pos) : chunkSize;
+
+        if (1U == len)
+        {
+            formParser.parse(static_cast<char>(data[pos]));
+        }
+        else
+        {
+            formParser.parse(reinterpret_cast<const char*>(&data[pos]), len);
+        }
+
+        pos += len;
+    }
+
+    formParser.finish();
+
+    return;
+}
+
+/**
+ * Compare two S0 parameter blocks.
+ *
+ * @param[in] s0Data1   First S0 parameter block
+ * @param[in] s0Data2   Second S0 parameter block
+ *
+ * @return If both are equal, it will return true otherwise false.
+ */
+static bool isEqual(const PersistentMemory::S0Data& s0Data1, const PersistentMemory::S0Data& s0Data2)
+{
+    return (s0Data1.isEnabled == s0Data2.isEnabled) &&
+           (0 == strncmp(s0Data1.name, s0Data2.name, sizeof(s0Data1.name))) &&
+           (s0Data1.pinS0 == s0Data2.pinS0) &&
+           (s0Data1.pulsesPerKWH == s0Data2.pulsesPerKWH);
+}
@@ -0,0 +1,160 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fuzz target of the HTTP request parsing and dispatch
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The input is a raw HTTP request, like it is received by the web server.
+ * It is parsed by the HTTP request of the firmware and dispatched by the web
+ * request router with the routes of the firmware. The handlers access the
+ * resource parts and the body like the ones of the firmware, including the
+ * conversion of the S0 interface id.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Hal.h"
+#include "Config.h"
+#include "FuzzSupport.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void handleRequest(EthernetClient& client, const HttpRequest& httpRequest);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Sum of the accessed request data, which keeps the compiler from removing the accesses. */
+static volatile uint32_t    gSink   = 0U;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    static WebReqRouter<NUM_FUZZ_ROUTES>*   router  = nullptr;
+    static EthernetClient                   client;
+    FuzzStream                              stream(data, size);
+    HttpRequest                             httpRequest(stream);
+
+    if (nullptr == router)
+    {
+        uint8_t idx = 0U;
+
+        router = new WebReqRouter<NUM_FUZZ_ROUTES>();
+
+        for(idx = 0U; idx < NUM_FUZZ_ROUTES; ++idx)
+        {
+            FUZZ_CHECK(true == router->addRoute(FUZZ_ROUTES[idx].method, FUZZ_ROUTES[idx].uri, handleRequest));
+        }
+    }
+
+    if (true == httpRequest.readRequest())
+    {
+        (void)router->handle(client, httpRequest);
+    }
+    else
+    {
+        gSink = gSink + strlen(httpRequest.getError().cStr());
+    }
+
+    return 0;
+}
+
+/**
+ * ISR of the S0 port pin changes. No pulses are injected by the fuzz targets.
+ */
+HAL_S0_PIN_CHANGE_ISR()
+{
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Web request handler of all routes. It accesses the request like the
+ * handlers of the firmware.
+ *
+ * @param[in] client        Ethernet client
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handleRequest(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    uint8_t partIdx     = 0U;
+    String  contentType;
+
+    (void)client;
+
+    /* The firmware accesses at most the 4th part, but a deeper one must be safe too. */
+    for(partIdx = 0U; partIdx < 8U; ++partIdx)
+    {
+        String  part    = httpRequest.getResource()[partIdx];
+        uint8_t index   = CONFIG_S0_SMARTMETER_MAX_NUM;
+
+        if (true == resourceToIndex(part, CONFIG_S0_SMARTMETER_MAX_NUM, index))
+        {
+            FUZZ_CHECK(CONFIG_S0_SMARTMETER_MAX_NUM > index);
+        }
+        else
+        {
+            FUZZ_CHECK(CONFIG_S0_SMARTMETER_MAX_NUM == index);
+        }
+
+        gSink = gSink + part.length() + index;
+    }
+
+    if (nullptr != httpRequest.getBody())
+    {
+        gSink = gSink + strlen(httpRequest.getBody());
+    }
+
+    contentType = httpRequest.getContentType();
+
+    gSink = gSink + httpRequest.getResource().toString().length();
+    gSink = gSink + contentType.length();
+    gSink = gSink + httpRequest.getContentLength();
+
+    return;
+}
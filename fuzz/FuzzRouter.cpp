@@ -0,0 +1,262 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fuzz target of the web request routing
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The first input byte selects the method, the remaining bytes are the
+ * resource. The route, which the web request router finds, is compared with
+ * the first matching one of the route table. The conversion of a resource
+ * part to an index is compared with a reference conversion.
+ *
+ * Both references are intentionally simple, therefore they stay valid if
+ * the router or the conversion are optimized.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <errno.h>
+
+#include "Hal.h"
+#include "Config.h"
+#include "FuzzSupport.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Web request router with the routes of the firmware. */
+typedef WebReqRouter<NUM_FUZZ_ROUTES> FuzzRouter;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+template < uint8_t ROUTE_IDX >
+static void handleRoute(EthernetClient& client, const HttpRequest& httpRequest);
+
+static int findRouteRef(ArduinoHttpServer::Method method, const String& resource);
+static bool resourceToIndexRef(const String& part, uint8_t numIndices, uint8_t& index);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Methods, selected by the first input byte. */
+static const ArduinoHttpServer::Method  METHODS[]   =
+{
+    ArduinoHttpServer::Method::Get,
+    ArduinoHttpServer::Method::Post,
+    ArduinoHttpServer::Method::Put,
+    ArduinoHttpServer::Method::Invalid
+};
+
+/** A distinct handler per route, to identify the found route. */
+static const FuzzRouter::WebReqHandler  HANDLERS[]  =
+{
+    handleRoute<0>,     handleRoute<1>,     handleRoute<2>,     handleRoute<3>,
+    handleRoute<4>,     handleRoute<5>,     handleRoute<6>,     handleRoute<7>,
+    handleRoute<8>,     handleRoute<9>,     handleRoute<10>,    handleRoute<11>,
+    handleRoute<12>,    handleRoute<13>
+};
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    static FuzzRouter*          router      = nullptr;
+    ArduinoHttpServer::Method   method      = ArduinoHttpServer::Method::Invalid;
+    String                      resource;
+    String                      part;
+    FuzzRouter::WebReqHandler   handler     = nullptr;
+    int                         routeIdx    = -1;
+    int                         lastSlash   = -1;
+    uint8_t                     index       = 0U;
+    uint8_t                     indexRef    = 0U;
+    size_t                      pos         = 1U;
+
+    if (nullptr == router)
+    {
+        uint8_t idx = 0U;
+
+        FUZZ_CHECK((sizeof(HANDLERS) / sizeof(HANDLERS[0])) == NUM_FUZZ_ROUTES);
+
+        router = new FuzzRouter();
+
+        for(idx = 0U; idx < NUM_FUZZ_ROUTES; ++idx)
+        {
+            FUZZ_CHECK(true == router->addRoute(FUZZ_ROUTES[idx].method, FUZZ_ROUTES[idx].uri, HANDLERS[idx]));
+        }
+    }
+
+    if (0U == size)
+    {
+        return 0;
+    }
+
+    method = METHODS[data[0] % (sizeof(METHODS) / sizeof(METHODS[0]))];
+
+    /* A resource never contains a string termination. */
+    while((size > pos) && (0U != data[pos]))
+    {
+        resource += static_cast<char>(data[pos]);
+        ++pos;
+    }
+
+    handler     = router->findRoute(method, resource);
+    routeIdx    = findRouteRef(method, resource);
+
+    if (0 > routeIdx)
+    {
+        FUZZ_CHECK(nullptr == handler);
+    }
+    else
+    {
+        FUZZ_CHECK(HANDLERS[routeIdx] == handler);
+    }
+
+    /* The S0 interface id is the last part of the resource. */
+    lastSlash   = resource.lastIndexOf('/');
+    part        = resource.substring(lastSlash + 1);
+    index       = CONFIG_S0_SMARTMETER_MAX_NUM;
+    indexRef    = CONFIG_S0_SMARTMETER_MAX_NUM;
+
+    FUZZ_CHECK(resourceToIndexRef(part, CONFIG_S0_SMARTMETER_MAX_NUM, indexRef) ==
+               resourceToIndex(part, CONFIG_S0_SMARTMETER_MAX_NUM, index));
+    FUZZ_CHECK(indexRef == index);
+
+    return 0;
+}
+
+/**
+ * ISR of the S0 port pin changes. No pulses are injected by the fuzz targets.
+ */
+HAL_S0_PIN_CHANGE_ISR()
+{
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Web request handler of a route. It is never called, only its address is
+ * compared.
+ *
+ * @tparam[in] ROUTE_IDX    Route index
+ *
+ * @param[in] client        Ethernet client
+ * @param[in] httpRequest   The http request itself.
+ */
+template < uint8_t ROUTE_IDX >
+static void handleRoute(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    (void)client;
+    (void)httpRequest;
+}
+
+/**
+ * Reference route lookup: The first route with the method matches, whose
+ * URI is equal to the resource. A '?' in the URI matches any rest.
+ *
+ * @param[in] method    Http request method
+ * @param[in] resource  Http request resource
+ *
+ * @return Route index or -1, if no route matches.
+ */
+static int findRouteRef(ArduinoHttpServer::Method method, const String& resource)
+{
+    uint8_t idx         = 0U;
+    int     routeIdx    = -1;
+
+    while((NUM_FUZZ_ROUTES > idx) && (0 > routeIdx))
+    {
+        const char* uri = FUZZ_ROUTES[idx].uri;
+        const char* res = resource.c_str();
+
+        while(('\0' != *uri) && ('?' != *uri) && (*uri == *res))
+        {
+            ++uri;
+            ++res;
+        }
+
+        if ((method == FUZZ_ROUTES[idx].method) &&
+            (('?' == *uri) || (('\0' == *uri) && ('\0' == *res))))
+        {
+            routeIdx = idx;
+        }
+
+        ++idx;
+    }
+
+    return routeIdx;
+}
+
+/**
+ * Reference conversion of a resource part to an index.
+ *
+ * @param[in]   part        Resource part
+ * @param[in]   numIndices  Number of valid indices
+ * @param[out]  index       Index, which is only written if it is valid
+ *
+ * @return If the part is a valid index, it will return true otherwise false.
+ */
+static bool resourceToIndexRef(const String& part, uint8_t numIndices, uint8_t& index)
+{
+    const char*     str     = part.c_str();
+    char*           end     = nullptr;
+    unsigned long   value   = 0UL;
+    bool            isValid = false;
+
+    /* The leading whitespace and sign, which strtoul() accepts, are not allowed. */
+    if (('0' <= str[0]) && ('9' >= str[0]))
+    {
+        errno = 0;
+        value = strtoul(str, &end, 10);
+
+        if ((0 == errno) &&
+            ('\0' == *end) &&
+            (numIndices > value))
+        {
+            index   = static_cast<uint8_t>(value);
+            isValid = true;
+        }
+    }
+
+    return isValid;
+}
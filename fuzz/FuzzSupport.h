@@ -0,0 +1,211 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Common parts of the fuzz targets
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @{
+ */
+
+#ifndef __FUZZ_SUPPORT_H__
+#define __FUZZ_SUPPORT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <Stream.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "WebReqRouter.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/**
+ * Check an invariant of the code under test. A violation aborts, which the
+ * fuzzer reports like a crash, together with the input.
+ */
+#define FUZZ_CHECK(_cond)                                                   \
+    do                                                                      \
+    {                                                                       \
+        if (!(_cond))                                                       \
+        {                                                                   \
+            fprintf(stderr, "%s:%d: Check failed: %s\n", __FILE__, __LINE__, #_cond); \
+            abort();                                                        \
+        }                                                                   \
+    }                                                                       \
+    while(0)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Read-only stream over the fuzz input. All written data is discarded.
+ *
+ * A peer which sends a truncated request and keeps the connection open lets
+ * the request parser wait for its timeout, which would slow down the fuzzer
+ * to about one input per second. Therefore after the input, the stream
+ * delivers a limited number of line feeds, which complete every header and
+ * body. Afterwards it signals the end of the data.
+ */
+class FuzzStream : public Stream
+{
+public:
+
+    /** Number of line feeds after the input. More than the max. body of a request. */
+    static const size_t PADDING_SIZE = 512U;
+
+    /**
+     * Constructs a stream over the fuzz input.
+     *
+     * @param[in] data  Input, which must exist during the lifetime of the stream.
+     * @param[in] size  Input size in bytes
+     */
+    FuzzStream(const uint8_t* data, size_t size) :
+        Stream(),
+        m_data(data),
+        m_size(size),
+        m_pos(0U)
+    {
+    }
+
+    /**
+     * Destroys the stream.
+     */
+    ~FuzzStream()
+    {
+    }
+
+    int available(void) override
+    {
+        return static_cast<int>(m_size + PADDING_SIZE - m_pos);
+    }
+
+    int read(void) override
+    {
+        int data = peek();
+
+        if (0 <= data)
+        {
+            ++m_pos;
+        }
+
+        return data;
+    }
+
+    int peek(void) override
+    {
+        int data = -1;
+
+        if (m_size > m_pos)
+        {
+            data = m_data[m_pos];
+        }
+        else if ((m_size + PADDING_SIZE) > m_pos)
+        {
+            data = '\n';
+        }
+
+        return data;
+    }
+
+    size_t write(uint8_t data) override
+    {
+        (void)data;
+
+        return 1U;
+    }
+
+private:
+
+    const uint8_t*  m_data; /**< Input */
+    size_t          m_size; /**< Input size in bytes */
+    size_t          m_pos;  /**< Read position */
+
+    FuzzStream();
+    FuzzStream(const FuzzStream& stream);
+    FuzzStream& operator=(const FuzzStream& stream);
+};
+
+/**
+ * A web request route of the firmware.
+ */
+struct FuzzRoute
+{
+    ArduinoHttpServer::Method   method; /**< Http request method */
+    const char*                 uri;    /**< Http request URI */
+};
+
+/** Web request routes, like in the firmware with all diagnostics. */
+static const FuzzRoute  FUZZ_ROUTES[]   =
+{
+    { ArduinoHttpServer::Method::Get,   "/"                         },
+    { ArduinoHttpServer::Method::Get,   "/api/s0-interface/?"       },
+    { ArduinoHttpServer::Method::Get,   "/api/s0-interfaces"        },
+    { ArduinoHttpServer::Method::Get,   "/api/s0-interfaces/delta?" },
+    { ArduinoHttpServer::Method::Get,   "/configure/?"              },
+    { ArduinoHttpServer::Method::Post,  "/configure/?"              },
+    { ArduinoHttpServer::Method::Get,   "/reset"                    },
+    { ArduinoHttpServer::Method::Get,   "/api/diagnostics/net"      },
+    { ArduinoHttpServer::Method::Get,   "/api/config"               },
+    { ArduinoHttpServer::Method::Put,   "/api/config"               },
+    { ArduinoHttpServer::Method::Get,   "/api/log?"                 },
+    { ArduinoHttpServer::Method::Get,   "/api/pulses?"              },
+    { ArduinoHttpServer::Method::Get,   "/api/diagnostics/irq"      },
+    { ArduinoHttpServer::Method::Get,   "/api/diagnostics/bench"    },
+    { ArduinoHttpServer::Method::Get,   "/api/diagnostics/trace"    },
+    { ArduinoHttpServer::Method::Post,  "/api/diagnostics/trace/?"  }
+};
+
+/** Number of web request routes. */
+static const uint8_t    NUM_FUZZ_ROUTES = sizeof(FUZZ_ROUTES) / sizeof(FUZZ_ROUTES[0]);
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Fuzz target entry point, called by libFuzzer or the standalone driver.
+ *
+ * @param[in] data  Input
+ * @param[in] size  Input size in bytes
+ *
+ * @return Always 0, other values are reserved by libFuzzer.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+#endif  /* __FUZZ_SUPPORT_H__ */
+
+/** @} */
@@ -0,0 +1,360 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Standalone driver of the fuzz targets
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Used instead of libFuzzer, if the compiler provides none (e.g. gcc). It
+ * runs every input file and every file of an input directory once, which
+ * reproduces a crash or replays a corpus. With -runs=N it additionally runs
+ * N random mutations of the inputs and reports the throughput, like
+ * libFuzzer does. The mutations are not coverage guided, therefore use
+ * libFuzzer to find new inputs.
+ *
+ * Usage: program [-runs=N] [-max_len=N] [-seed=N] [file|directory ...]
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <vector>
+#include <string>
+
+#include "FuzzSupport.h"
+
+#if defined(FUZZ_STANDALONE)
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** A single input. */
+typedef std::vector<uint8_t> Input;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool readInput(const char* fileName, Input& input);
+static bool addInputs(const char* path, std::vector<Input>& corpus);
+static uint32_t nextRandom(uint32_t& state);
+static void mutate(Input& input, size_t maxLen, uint32_t& state);
+static uint64_t getNanos(void);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Bytes, which are inserted by the mutations. They are frequent in requests and forms. */
+static const char   INTERESTING[]   = "/?&=%+ \r\n:0123456789aAfFzZ\xff";
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program entry point.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    std::vector<Input>  corpus;
+    unsigned long       runs        = 0UL;
+    size_t              maxLen      = 4096U;
+    uint32_t            state       = static_cast<uint32_t>(time(nullptr));
+    unsigned long       run         = 0UL;
+    uint64_t            start       = 0U;
+    uint64_t            duration    = 0U;
+    int                 argIdx      = 0;
+    size_t              idx         = 0U;
+
+    for(argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const char* arg = argv[argIdx];
+
+        if (0 == strncmp(arg, "-runs=", 6U))
+        {
+            runs = strtoul(&arg[6], nullptr, 0);
+        }
+        else if (0 == strncmp(arg, "-max_len=", 9U))
+        {
+            maxLen = strtoul(&arg[9], nullptr, 0);
+        }
+        else if (0 == strncmp(arg, "-seed=", 6U))
+        {
+            state = static_cast<uint32_t>(strtoul(&arg[6], nullptr, 0));
+        }
+        else if ('-' == arg[0])
+        {
+            /* Other libFuzzer options are ignored, that the same command lines work. */
+            fprintf(stderr, "Option %s ignored.\n", arg);
+        }
+        else if (false == addInputs(arg, corpus))
+        {
+            fprintf(stderr, "Failed to read %s.\n", arg);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* The xorshift state must not be 0. */
+    if (0U == state)
+    {
+        state = 1U;
+    }
+
+    start = getNanos();
+
+    for(idx = 0U; idx < corpus.size(); ++idx)
+    {
+        (void)LLVMFuzzerTestOneInput(corpus[idx].data(), corpus[idx].size());
+    }
+
+    if (0U == corpus.size())
+    {
+        corpus.push_back(Input());
+    }
+
+    for(run = 0UL; run < runs; ++run)
+    {
+        Input input = corpus[nextRandom(state) % corpus.size()];
+
+        mutate(input, maxLen, state);
+        (void)LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+
+    duration = getNanos() - start;
+
+    printf("Done %lu runs in %llu ms, exec/s: %llu\n",
+        static_cast<unsigned long>(corpus.size() + runs),
+        static_cast<unsigned long long>(duration / 1000000U),
+        static_cast<unsigned long long>((0U < duration) ? (((corpus.size() + runs) * 1000000000ULL) / duration) : 0U));
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Read a whole file.
+ *
+ * @param[in]   fileName    File name
+ * @param[out]  input       File content
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool readInput(const char* fileName, Input& input)
+{
+    FILE*   fd      = fopen(fileName, "rb");
+    uint8_t buffer[1024];
+    size_t  len     = 0U;
+
+    if (nullptr == fd)
+    {
+        return false;
+    }
+
+    input.clear();
+
+    while(0U < (len = fread(buffer, 1U, sizeof(buffer), fd)))
+    {
+        input.insert(input.end(), buffer, buffer + len);
+    }
+
+    (void)fclose(fd);
+
+    return true;
+}
+
+/**
+ * Add a file or all files of a directory to the corpus.
+ *
+ * @param[in]       path    File or directory
+ * @param[in,out]   corpus  Corpus
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool addInputs(const char* path, std::vector<Input>& corpus)
+{
+    struct stat info;
+    bool        isSuccessful    = false;
+
+    if (0 != stat(path, &info))
+    {
+        isSuccessful = false;
+    }
+    else if (0 != S_ISDIR(info.st_mode))
+    {
+        DIR*            dir     = opendir(path);
+        struct dirent*  entry   = nullptr;
+
+        isSuccessful = (nullptr != dir);
+
+        while((true == isSuccessful) && (nullptr != (entry = readdir(dir))))
+        {
+            std::string fileName = std::string(path) + "/" + entry->d_name;
+
+            if ((0 == stat(fileName.c_str(), &info)) &&
+                (0 != S_ISREG(info.st_mode)))
+            {
+                Input input;
+
+                isSuccessful = readInput(fileName.c_str(), input);
+                corpus.push_back(input);
+            }
+        }
+
+        if (nullptr != dir)
+        {
+            (void)closedir(dir);
+        }
+    }
+    else
+    {
+        Input input;
+
+        isSuccessful = readInput(path, input);
+        corpus.push_back(input);
+    }
+
+    return isSuccessful;
+}
+
+/**
+ * Get the next pseudo random number (xorshift32).
+ *
+ * @param[in,out] state Generator state, must not be 0.
+ *
+ * @return Pseudo random number
+ */
+static uint32_t nextRandom(uint32_t& state)
+{
+    state ^= state << 13U;
+    state ^= state >> 17U;
+    state ^= state << 5U;
+
+    return state;
+}
+
+/**
+ * Mutate a input by a few random byte changes, insertions and deletions.
+ *
+ * @param[in,out]   input   Input
+ * @param[in]       maxLen  Max. input length in bytes
+ * @param[in,out]   state   Random generator state
+ */
+static void mutate(Input& input, size_t maxLen, uint32_t& state)
+{
+    uint32_t    count   = 1U + (nextRandom(state) % 8U);
+    uint32_t    idx     = 0U;
+
+    for(idx = 0U; idx < count; ++idx)
+    {
+        uint32_t    random  = nextRandom(state);
+        size_t      pos     = (0U < input.size()) ? ((random >> 8U) % input.size()) : 0U;
+        uint8_t     data    = ((random >> 4U) & 1U) ?
+                              static_cast<uint8_t>(INTERESTING[(random >> 5U) % (sizeof(INTERESTING) - 1U)]) :
+                              static_cast<uint8_t>(random >> 24U);
+
+        switch(random % 4U)
+        {
+        case 0U:
+            if (0U < input.size())
+            {
+                input[pos] = data;
+            }
+            break;
+
+        case 1U:
+            if (0U < input.size())
+            {
+                input.erase(input.begin() + pos);
+            }
+            break;
+
+        case 2U:
+            if (0U < input.size())
+            {
+                /* Duplicate a part, e.g. a key/value pair. */
+                size_t  len     = 1U + ((random >> 16U) % 16U);
+                Input   part;
+
+                len = ((input.size() - pos) < len) ? (input.size() - pos) : len;
+                part.assign(input.begin() + pos, input.begin() + pos + len);
+                input.insert(input.begin() + pos, part.begin(), part.end());
+            }
+            break;
+
+        default:
+            input.insert(input.begin() + pos, data);
+            break;
+        }
+    }
+
+    if (maxLen < input.size())
+    {
+        input.resize(maxLen);
+    }
+
+    return;
+}
+
+/**
+ * Get the monotonic time.
+ *
+ * @return Time in ns
+ */
+static uint64_t getNanos(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL) + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+#endif  /* defined(FUZZ_STANDALONE) */
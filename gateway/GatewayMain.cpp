@@ -0,0 +1,708 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  S0 gateway for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Counts the S0 pulses of many meters on a Linux gateway, with the S0
+ * smartmeters of the firmware. The S0 outputs are connected to GPIO lines,
+ * whose falling edges are read with their kernel timestamps, see
+ * GpioEventSource.h. The channels are sharded across threads, every thread
+ * handles up to N channels. The REST API of the S0 interfaces is served
+ * like by the firmware.
+ *
+ * Every line of the configuration file is a channel:
+ * ID SOURCE LINE PULSES_PER_KWH NAME
+ * e.g. "0 /dev/gpiochip0 17 1000 Heat pump". Lines starting with # are
+ * comments.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Hal.h"
+
+#if defined(HAL_LINUX)
+
+#include <ArduinoHttpServer.h>
+#include <ArduinoJson.h>
+#include <EthernetENC.h>
+#include <EthernetServer.h>
+#include <arpa/inet.h>
+#include <getopt.h>
+#include <signal.h>
+#include <sys/stat.h>
+
+#include <memory>
+#include <vector>
+
+#include "S0Model.h"
+#include "S0Snapshot.hpp"
+#include "Shard.h"
+#include "WebReqRouter.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Status id, like the ones of the firmware */
+typedef enum
+{
+    STATUS_ID_OK = 0,   /**< Successful */
+    STATUS_ID_EPENDING, /**< Already pending */
+    STATUS_ID_EINPUT,   /**< Input data invalid */
+    STATUS_ID_EPAR,     /**< Parameter is missing */
+    STATUS_ID_EINTERNAL,/**< Unknown internal error */
+    STATUS_ID_EUNKNOWN  /**< Unknown error */
+
+} STATUS_ID;
+
+/** Snapshot of several channels at one point in time, like the S0Snapshot of the firmware. */
+struct Snapshot
+{
+    uint32_t                            seq;        /**< Sequence number of the capture */
+    uint32_t                            timestamp;  /**< Capture timestamp in ms */
+    std::vector<S0Snapshot::Channel>    channels;   /**< Captured values in the order of the requested channels */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool readConfig(const char* fileName);
+static bool createShards(size_t channelsPerShard, uint32_t debounceUs);
+static void capture(const std::vector<Channel*>& channels, Snapshot& snapshot);
+static void handleWebRequest(void);
+static void handleS0InterfaceReq(EthernetClient& client, const HttpRequest& httpRequest);
+static void handleS0InterfacesReq(EthernetClient& client, const HttpRequest& httpRequest);
+static void onStopSignal(int signalNo);
+static void printUsage(const char* prgName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. number of channels. The id UINT8_MAX marks a invalid S0 smartmeter. */
+static const uint8_t    MAX_CHANNELS                = UINT8_MAX;
+
+/** Default number of channels per shard. */
+static const size_t     DEFAULT_CHANNELS_PER_SHARD  = 16U;
+
+/** Default offset, added to the server port. Port 80 becomes 8080. */
+static const uint16_t   DEFAULT_PORT_OFFSET         = 8000U;
+
+/** Max. time in ms to wait for a web request per main loop. */
+static const int        IDLE_TIMEOUT                = 100;
+
+/** Web server port */
+static const uint16_t   WEB_SRV_PORT                = 80U;
+
+/** Number of web request routes */
+static const uint8_t    NUM_ROUTES                  = 2U;
+
+/** JSON document size per S0 interface */
+static const size_t     JSON_SIZE_PER_CHANNEL       = 256U;
+
+/** All channels in the order of the configuration. */
+static std::vector<std::unique_ptr<Channel>>    gChannels;
+
+/** Channels by id */
+static Channel*                                 gChannelsById[MAX_CHANNELS];
+
+/** Shards of the channels */
+static std::vector<std::unique_ptr<Shard>>      gShards;
+
+/** Sequence number of the last snapshot */
+static uint32_t                                 gSnapshotSeq    = 0U;
+
+/** Web server */
+static EthernetServer                           gWebServer(WEB_SRV_PORT);
+
+/** Web request router */
+static WebReqRouter<NUM_ROUTES>                 gWebReqRouter;
+
+/** Is the gateway requested to stop? */
+static volatile sig_atomic_t                    gIsStopReq  = 0;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Process entry point.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "config",                 required_argument,  nullptr,    'c' },
+        { "channels-per-thread",    required_argument,  nullptr,    'n' },
+        { "debounce",               required_argument,  nullptr,    'd' },
+        { "port-offset",            required_argument,  nullptr,    'p' },
+        { "listen",                 required_argument,  nullptr,    'l' },
+        { "start-millis",           required_argument,  nullptr,    'm' },
+        { "help",                   no_argument,        nullptr,    'h' },
+        { nullptr,                  0,                  nullptr,    0   }
+    };
+    const char*                 configFile          = nullptr;
+    long                        channelsPerShard    = DEFAULT_CHANNELS_PER_SHARD;
+    long                        debounceUs          = 0;
+    long                        portOffset          = DEFAULT_PORT_OFFSET;
+    struct in_addr              listenAddress;
+    size_t                      idx                 = 0U;
+    int                         opt                 = 0;
+
+    listenAddress.s_addr = htonl(EthernetClass::LISTEN_LOOPBACK);
+
+    while(-1 != (opt = getopt_long(argc, argv, "c:n:d:p:l:m:h", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 'c':
+            configFile = optarg;
+            break;
+
+        case 'n':
+            channelsPerShard = strtol(optarg, nullptr, 0);
+
+            if ((0 >= channelsPerShard) || (MAX_CHANNELS < channelsPerShard))
+            {
+                fprintf(stderr, "Invalid number of channels per thread: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'd':
+            debounceUs = strtol(optarg, nullptr, 0);
+
+            if ((0 > debounceUs) || (INT32_MAX < debounceUs))
+            {
+                fprintf(stderr, "Invalid debounce period: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'p':
+            portOffset = strtol(optarg, nullptr, 0);
+
+            if ((0 > portOffset) || (UINT16_MAX < portOffset))
+            {
+                fprintf(stderr, "Invalid port offset: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'l':
+            if (1 != inet_pton(AF_INET, optarg, &listenAddress))
+            {
+                fprintf(stderr, "Invalid listen address: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'm':
+            {
+                char*               end         = nullptr;
+                unsigned long long  startMillis = strtoull(optarg, &end, 0);
+
+                if (('\0' == *optarg) || ('\0' != *end) || (UINT32_MAX < startMillis))
+                {
+                    fprintf(stderr, "Invalid start of millis(): %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+
+                setMillis(static_cast<uint32_t>(startMillis));
+            }
+            break;
+
+        case 'h':
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+
+        default:
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (nullptr == configFile)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if ((false == readConfig(configFile)) ||
+        (false == createShards(static_cast<size_t>(channelsPerShard), static_cast<uint32_t>(debounceUs))))
+    {
+        return EXIT_FAILURE;
+    }
+
+    /* A peer, which closed the connection, shall not terminate the process. */
+    (void)signal(SIGPIPE, SIG_IGN);
+    (void)signal(SIGINT, onStopSignal);
+    (void)signal(SIGTERM, onStopSignal);
+
+    /* The log output shall be visible immediately, even if piped. */
+    (void)setvbuf(stdout, nullptr, _IOLBF, 0U);
+
+    Ethernet.setPortOffset(static_cast<uint16_t>(portOffset));
+    Ethernet.setListenAddress(ntohl(listenAddress.s_addr));
+
+    (void)gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/api/s0-interface/?", handleS0InterfaceReq);
+    (void)gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/api/s0-interfaces", handleS0InterfacesReq);
+
+    gWebServer.begin();
+
+    for(const std::unique_ptr<Shard>& shard : gShards)
+    {
+        shard->start();
+    }
+
+    printf("{\"channels\":%zu,\"threads\":%zu,\"port\":%ld}\n", gChannels.size(), gShards.size(), WEB_SRV_PORT + portOffset);
+
+    while(0 == gIsStopReq)
+    {
+        handleWebRequest();
+        EthernetServer::waitForClients(IDLE_TIMEOUT);
+    }
+
+    for(idx = 0U; idx < gShards.size(); ++idx)
+    {
+        gShards[idx]->stop();
+
+        printf("{\"thread\":%zu,\"channels\":%zu,\"events\":%llu,\"lost\":%llu}\n",
+            idx,
+            gShards[idx]->getNumChannels(),
+            static_cast<unsigned long long>(gShards[idx]->getNumEvents()),
+            static_cast<unsigned long long>(gShards[idx]->getNumLost()));
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * The gateway has no S0 port. The pins of the S0 smartmeters are not used,
+ * the edges are applied by the shards.
+ */
+HAL_S0_PIN_CHANGE_ISR()
+{
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Read the channels of the configuration file.
+ *
+ * @param[in] fileName  Name of the configuration file
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool readConfig(const char* fileName)
+{
+    FILE*       fd          = fopen(fileName, "r");
+    char        line[512];
+    uint32_t    lineNo      = 0U;
+    bool        isValid     = true;
+
+    if (nullptr == fd)
+    {
+        perror(fileName);
+        return false;
+    }
+
+    while((true == isValid) && (nullptr != fgets(line, sizeof(line), fd)))
+    {
+        std::unique_ptr<Channel>    channel(new Channel());
+        unsigned long               id              = 0U;
+        char                        source[256];
+        unsigned long               lineOffset      = 0U;
+        unsigned long               pulsesPerKWh    = 0U;
+        int                         nameOffset      = 0;
+        char*                       name            = nullptr;
+
+        ++lineNo;
+
+        /* Remove the line end. */
+        line[strcspn(line, "\r\n")] = '\0';
+
+        if (('\0' == line[strspn(line, " \t")]) || ('#' == line[strspn(line, " \t")]))
+        {
+            continue;
+        }
+
+        if ((4 != sscanf(line, "%lu %255s %lu %lu %n", &id, source, &lineOffset, &pulsesPerKWh, &nameOffset)) ||
+            (0 == nameOffset) ||
+            (MAX_CHANNELS <= id) ||
+            (UINT32_MAX < lineOffset))
+        {
+            fprintf(stderr, "%s:%u: Invalid channel, expected: ID SOURCE LINE PULSES_PER_KWH NAME\n", fileName, lineNo);
+            isValid = false;
+        }
+        else if (nullptr != gChannelsById[id])
+        {
+            fprintf(stderr, "%s:%u: Channel %lu is already configured.\n", fileName, lineNo, id);
+            isValid = false;
+        }
+        else
+        {
+            name = &line[nameOffset];
+
+            /* The S0 pin isn't used, any valid one will do. */
+            if (false == channel->s0Smartmeter.init(static_cast<uint8_t>(id), name, S0Pin::mcPinRangeMin, pulsesPerKWh))
+            {
+                fprintf(stderr, "%s:%u: Invalid pulses per kWh: %lu\n", fileName, lineNo, pulsesPerKWh);
+                isValid = false;
+            }
+            else
+            {
+                channel->source = source;
+                channel->line   = static_cast<uint32_t>(lineOffset);
+                channel->s0Smartmeter.enable();
+
+                gChannelsById[id] = channel.get();
+                gChannels.push_back(std::move(channel));
+            }
+        }
+    }
+
+    (void)fclose(fd);
+
+    if ((true == isValid) && (true == gChannels.empty()))
+    {
+        fprintf(stderr, "%s: No channel configured.\n", fileName);
+        isValid = false;
+    }
+
+    return isValid;
+}
+
+/**
+ * Distribute the channels to the shards and open their event sources.
+ * The lines of a GPIO character device are requested in groups of up to
+ * the number of channels per shard. A file or named pipe is a single
+ * stream, therefore all its channels belong to the same shard.
+ *
+ * @param[in] channelsPerShard  Number of channels per shard
+ * @param[in] debounceUs        Debounce period in us, 0 to disable
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool createShards(size_t channelsPerShard, uint32_t debounceUs)
+{
+    std::vector<bool>   isAssigned(gChannels.size(), false);
+    size_t              idx         = 0U;
+
+    for(idx = 0U; idx < gChannels.size(); ++idx)
+    {
+        const std::string&      source      = gChannels[idx]->source;
+        struct stat             st;
+        bool                    isChip      = (0 == stat(source.c_str(), &st)) && S_ISCHR(st.st_mode);
+        size_t                  maxGroup    = (true == isChip) ? std::min(channelsPerShard, GpioEventSource::MAX_LINES) : gChannels.size();
+        std::vector<Channel*>   group;
+        size_t                  otherIdx    = 0U;
+
+        if (true == isAssigned[idx])
+        {
+            continue;
+        }
+
+        /* All channels of the same source, in groups. */
+        for(otherIdx = idx; otherIdx <= gChannels.size(); ++otherIdx)
+        {
+            if ((false == group.empty()) &&
+                ((gChannels.size() == otherIdx) || (maxGroup == group.size())))
+            {
+                if ((true == gShards.empty()) ||
+                    ((0U < gShards.back()->getNumChannels()) &&
+                     (channelsPerShard < (gShards.back()->getNumChannels() + group.size()))))
+                {
+                    gShards.push_back(std::unique_ptr<Shard>(new Shard()));
+                }
+
+                if (false == gShards.back()->addSource(group, debounceUs))
+                {
+                    fprintf(stderr, "%s: Can't open the event source.\n", source.c_str());
+                    return false;
+                }
+
+                group.clear();
+            }
+
+            if ((gChannels.size() > otherIdx) &&
+                (false == isAssigned[otherIdx]) &&
+                (source == gChannels[otherIdx]->source))
+            {
+                group.push_back(gChannels[otherIdx].get());
+                isAssigned[otherIdx] = true;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Capture channels at one point in time. The shards of the channels are
+ * locked all together, always in the same order, and only for copying the
+ * values, which the shard threads change.
+ *
+ * @param[in]   channels    Channels
+ * @param[out]  snapshot    Snapshot of the channels in the same order
+ */
+static void capture(const std::vector<Channel*>& channels, Snapshot& snapshot)
+{
+    std::vector<uint32_t>                       lastPulseTimestamps(channels.size(), 0U);
+    std::vector<std::unique_lock<std::mutex>>   locks;
+    size_t                                      idx                 = 0U;
+
+    snapshot.channels.resize(channels.size());
+
+    for(const std::unique_ptr<Shard>& shard : gShards)
+    {
+        for(idx = 0U; idx < channels.size(); ++idx)
+        {
+            if (shard.get() == channels[idx]->shard)
+            {
+                locks.push_back(std::unique_lock<std::mutex>(shard->getMutex()));
+                break;
+            }
+        }
+    }
+
+    snapshot.timestamp = static_cast<uint32_t>(millis());
+
+    for(idx = 0U; idx < channels.size(); ++idx)
+    {
+        S0Snapshot::Channel& channel = snapshot.channels[idx];
+
+        channel.hasPulse = channels[idx]->s0Smartmeter.getSharedValues(channel.pulseCnt, channel.powerConsumption, lastPulseTimestamps[idx]);
+    }
+
+    locks.clear();
+
+    for(idx = 0U; idx < channels.size(); ++idx)
+    {
+        S0Snapshot::completeChannel(channels[idx]->s0Smartmeter, snapshot.timestamp, lastPulseTimestamps[idx], snapshot.channels[idx]);
+    }
+
+    ++gSnapshotSeq;
+    snapshot.seq = gSnapshotSeq;
+
+    return;
+}
+
+/**
+ * Handle a pending web request, like the firmware.
+ */
+static void handleWebRequest(void)
+{
+    EthernetClient client = gWebServer.available();
+
+    if (true == client)
+    {
+        HttpRequest httpRequest(client);
+
+        if (true == httpRequest.readRequest())
+        {
+            if (false == gWebReqRouter.handle(client, httpRequest))
+            {
+                /* Send a 404 back, which means "Not Found" */
+                ArduinoHttpServer::StreamHttpErrorReply httpReply(client, httpRequest.getContentType(), "404");
+
+                httpReply.send("Not Found");
+            }
+        }
+        else
+        {
+            /* Send a 400 back, which means "Bad Request". */
+            ArduinoHttpServer::StreamHttpErrorReply httpReply(client, httpRequest.getContentType(), "400");
+
+            httpReply.send("Bad Request");
+        }
+    }
+
+    return;
+}
+
+/**
+ * Handle the route for the /api/s0-interface/? folder, which responds with
+ * the data of one channel in JSON format, like the firmware.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handleS0InterfaceReq(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    ArduinoHttpServer::StreamHttpReply  httpReply(client, "application/json");
+    String                              data;
+    uint8_t                             id          = MAX_CHANNELS;
+    DynamicJsonDocument                 jsonDoc(JSON_SIZE_PER_CHANNEL);
+    JsonObject                          jsonData    = jsonDoc.createNestedObject("data");
+
+    /* A invalid id keeps it out of range. */
+    (void)resourceToIndex(httpRequest.getResource()[2], MAX_CHANNELS, id);
+
+    if (MAX_CHANNELS <= id)
+    {
+        jsonDoc["status"] = STATUS_ID_EPAR;
+    }
+    else
+    {
+        Channel*    channel = gChannelsById[id];
+        Snapshot    snapshot;
+
+        if (nullptr == channel)
+        {
+            capture({}, snapshot);
+        }
+        else
+        {
+            capture({ channel }, snapshot);
+            S0Model::toJson(channel->s0Smartmeter, snapshot.channels[0], jsonData);
+        }
+
+        jsonDoc["seq"]          = snapshot.seq;
+        jsonDoc["timestamp"]    = snapshot.timestamp;
+        jsonDoc["status"]       = STATUS_ID_OK;
+    }
+
+    (void)serializeJson(jsonDoc, data);
+
+    httpReply.send(data);
+
+    return;
+}
+
+/**
+ * Handle the route for the /api/s0-interfaces folder, which responds with
+ * the data of all channels in JSON format, like the firmware. All channels
+ * are taken from the same snapshot.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handleS0InterfacesReq(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    ArduinoHttpServer::StreamHttpReply  httpReply(client, "application/json");
+    String                              data;
+    uint8_t                             id              = 0U;
+    size_t                              idx             = 0U;
+    DynamicJsonDocument                 jsonDoc(gChannels.size() * JSON_SIZE_PER_CHANNEL);
+    JsonArray                           jsonDataArray   = jsonDoc.createNestedArray("data");
+    std::vector<Channel*>               channels;
+    Snapshot                            snapshot;
+
+    (void)httpRequest;
+
+    /* In the order of the ids, like the firmware. */
+    for(id = 0U; id < MAX_CHANNELS; ++id)
+    {
+        if (nullptr != gChannelsById[id])
+        {
+            channels.push_back(gChannelsById[id]);
+        }
+    }
+
+    capture(channels, snapshot);
+
+    for(idx = 0U; idx < channels.size(); ++idx)
+    {
+        JsonObject jsonData = jsonDataArray.createNestedObject();
+
+        S0Model::toJson(channels[idx]->s0Smartmeter, snapshot.channels[idx], jsonData);
+    }
+
+    jsonDoc["seq"]          = snapshot.seq;
+    jsonDoc["timestamp"]    = snapshot.timestamp;
+    jsonDoc["status"]       = STATUS_ID_OK;
+
+    (void)serializeJson(jsonDoc, data);
+
+    httpReply.send(data);
+
+    return;
+}
+
+/**
+ * Request the stop of the gateway, e.g. on SIGINT or SIGTERM.
+ *
+ * @param[in] signalNo  Signal number
+ */
+static void onStopSignal(int signalNo)
+{
+    (void)signalNo;
+
+    gIsStopReq = 1;
+
+    return;
+}
+
+/**
+ * Print the command line usage.
+ *
+ * @param[in] prgName   Program name
+ */
+static void printUsage(const char* prgName)
+{
+    printf("Usage: %s --config FILE [options]\n", prgName);
+    printf("  -c, --config FILE             Channels, one per line: ID SOURCE LINE PULSES_PER_KWH NAME\n");
+    printf("  -n, --channels-per-thread N   Number of channels per thread (default: %zu).\n", DEFAULT_CHANNELS_PER_SHARD);
+    printf("  -d, --debounce US             Debounce period of the GPIO lines in us (default: off).\n");
+    printf("  -p, --port-offset N           Offset added to the server port (default: %u).\n", DEFAULT_PORT_OFFSET);
+    printf("  -l, --listen ADDR             IPv4 address, where the server listens (default: 127.0.0.1).\n");
+    printf("  -m, --start-millis MS         Start value of millis(), e.g. to test its wrap around (default: 0).\n");
+    printf("  -h, --help                    Show this help.\n");
+}
+
+#endif  /* defined(HAL_LINUX) */
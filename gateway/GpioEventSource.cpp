@@ -0,0 +1,272 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Source of GPIO edge events
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "GpioEventSource.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Consumer name of the requested lines, shown e.g. by gpioinfo. */
+static const char   CONSUMER[]  = "s0gateway";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+GpioEventSource::GpioEventSource() :
+    m_fd(-1),
+    m_isPollable(false),
+    m_nextSeqNo(0U),
+    m_numLost(0U),
+    m_partial(),
+    m_partialSize(0U)
+{
+}
+
+GpioEventSource::~GpioEventSource()
+{
+    close();
+}
+
+bool GpioEventSource::open(const char* path, const uint32_t* lines, size_t numLines, uint32_t debounceUs)
+{
+    struct stat st;
+
+    close();
+
+    if ((0 != stat(path, &st)) &&
+        (ENOENT == errno) &&
+        (0 != mkfifo(path, 0644)))
+    {
+        perror(path);
+        return false;
+    }
+
+    if (0 != stat(path, &st))
+    {
+        perror(path);
+        return false;
+    }
+
+    if (S_ISCHR(st.st_mode))
+    {
+        return requestLines(path, lines, numLines, debounceUs);
+    }
+
+    /* A named pipe is opened for writing too, so it never signals a hangup
+     * and the writer can be restarted.
+     */
+    m_fd            = ::open(path, (S_ISFIFO(st.st_mode) ? O_RDWR : O_RDONLY) | O_NONBLOCK | O_CLOEXEC);
+    m_isPollable    = S_ISFIFO(st.st_mode);
+
+    if (0 > m_fd)
+    {
+        perror(path);
+        return false;
+    }
+
+    return true;
+}
+
+void GpioEventSource::close(void)
+{
+    if (0 <= m_fd)
+    {
+        (void)::close(m_fd);
+        m_fd = -1;
+    }
+
+    m_isPollable    = false;
+    m_nextSeqNo     = 0U;
+    m_partialSize   = 0U;
+
+    return;
+}
+
+ssize_t GpioEventSource::read(struct gpio_v2_line_event* events, size_t maxEvents)
+{
+    uint8_t*    buffer      = reinterpret_cast<uint8_t*>(events);
+    size_t      size        = maxEvents * sizeof(struct gpio_v2_line_event);
+    ssize_t     len         = 0;
+    size_t      numEvents   = 0U;
+    size_t      idx         = 0U;
+
+    if ((0 > m_fd) || (0U == maxEvents))
+    {
+        return (0 > m_fd) ? -1 : 0;
+    }
+
+    /* The kernel delivers whole events only, a file or pipe may not. */
+    memcpy(buffer, m_partial, m_partialSize);
+
+    len = ::read(m_fd, buffer + m_partialSize, size - m_partialSize);
+
+    if (0 > len)
+    {
+        return ((EAGAIN == errno) || (EINTR == errno)) ? 0 : -1;
+    }
+
+    size            = m_partialSize + static_cast<size_t>(len);
+    numEvents       = size / sizeof(struct gpio_v2_line_event);
+    m_partialSize   = size % sizeof(struct gpio_v2_line_event);
+    memcpy(m_partial, buffer + numEvents * sizeof(struct gpio_v2_line_event), m_partialSize);
+
+    for(idx = 0U; idx < numEvents; ++idx)
+    {
+        if ((0U != m_nextSeqNo) &&
+            (events[idx].seqno > m_nextSeqNo))
+        {
+            m_numLost += events[idx].seqno - m_nextSeqNo;
+        }
+
+        m_nextSeqNo = events[idx].seqno + 1U;
+    }
+
+    return static_cast<ssize_t>(numEvents);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * Request the falling edges of the lines of a GPIO character device.
+ *
+ * @param[in] path          Path of the GPIO character device
+ * @param[in] lines         Line offsets
+ * @param[in] numLines      Number of lines, at most MAX_LINES
+ * @param[in] debounceUs    Debounce period in us, 0 to disable.
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool GpioEventSource::requestLines(const char* path, const uint32_t* lines, size_t numLines, uint32_t debounceUs)
+{
+    struct gpio_v2_line_request request;
+    int                         chipFd          = -1;
+    size_t                      idx             = 0U;
+    bool                        isSuccessful    = false;
+
+    if ((0U == numLines) || (MAX_LINES < numLines))
+    {
+        fprintf(stderr, "%s: Invalid number of lines: %zu\n", path, numLines);
+        return false;
+    }
+
+    memset(&request, 0, sizeof(request));
+
+    for(idx = 0U; idx < numLines; ++idx)
+    {
+        request.offsets[idx] = lines[idx];
+    }
+
+    request.num_lines       = static_cast<uint32_t>(numLines);
+    request.config.flags    = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_FALLING | GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+    strncpy(request.consumer, CONSUMER, sizeof(request.consumer) - 1U);
+
+    if (0U < debounceUs)
+    {
+        request.config.num_attrs                        = 1U;
+        request.config.attrs[0].attr.id                 = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+        request.config.attrs[0].attr.debounce_period_us = debounceUs;
+        request.config.attrs[0].mask                    = (MAX_LINES == numLines) ? UINT64_MAX : ((1ULL << numLines) - 1U);
+    }
+
+    chipFd = ::open(path, O_RDONLY | O_CLOEXEC);
+
+    if (0 > chipFd)
+    {
+        perror(path);
+    }
+    else if (0 > ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &request))
+    {
+        perror(path);
+    }
+    /* The main loop must never wait for a event. */
+    else if (0 > fcntl(request.fd, F_SETFL, O_NONBLOCK))
+    {
+        perror(path);
+        (void)::close(request.fd);
+    }
+    else
+    {
+        m_fd            = request.fd;
+        m_isPollable    = true;
+        isSuccessful    = true;
+    }
+
+    if (0 <= chipFd)
+    {
+        /* The line request stays valid without the chip. */
+        (void)::close(chipFd);
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
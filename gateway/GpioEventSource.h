@@ -0,0 +1,166 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Source of GPIO edge events
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Reads the edge events of GPIO lines with their kernel timestamps. A GPIO
+ * character device (/dev/gpiochipN) is requested for the falling edges of
+ * the lines via the GPIO v2 uAPI. A regular file or a named pipe can stand
+ * in for it, e.g. for tests. It must contain the events in the same binary
+ * layout, which the kernel delivers (struct gpio_v2_line_event), with
+ * timestamps of CLOCK_MONOTONIC.
+ *
+ * @{
+ */
+
+#ifndef __GPIO_EVENT_SOURCE_H__
+#define __GPIO_EVENT_SOURCE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <linux/gpio.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Source of the edge events of several GPIO lines.
+ */
+class GpioEventSource
+{
+public:
+
+    /** Max. number of lines per source, limited by the GPIO uAPI. */
+    static const size_t     MAX_LINES   = GPIO_V2_LINES_MAX;
+
+    /**
+     * Constructs a closed source.
+     */
+    GpioEventSource();
+
+    /**
+     * Destroys the source and closes it.
+     */
+    ~GpioEventSource();
+
+    /**
+     * Open the source. A GPIO character device is requested for the falling
+     * edges of the lines, with pull-up. A not existing file is created as
+     * named pipe.
+     *
+     * @param[in] path          Path of the GPIO character device, file or named pipe
+     * @param[in] lines         Line offsets, only used for a GPIO character device
+     * @param[in] numLines      Number of lines, at most MAX_LINES
+     * @param[in] debounceUs    Debounce period in us, 0 to disable. Only used for a GPIO character device.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool open(const char* path, const uint32_t* lines, size_t numLines, uint32_t debounceUs);
+
+    /**
+     * Close the source.
+     */
+    void close(void);
+
+    /**
+     * Get the file descriptor, e.g. to wait for events.
+     *
+     * @return File descriptor or -1 if closed
+     */
+    int getFd(void) const
+    {
+        return m_fd;
+    }
+
+    /**
+     * Can the file descriptor be polled? A regular file is always readable,
+     * therefore it must be read periodically instead.
+     *
+     * @return If it can be polled, it will return true otherwise false.
+     */
+    bool isPollable(void) const
+    {
+        return m_isPollable;
+    }
+
+    /**
+     * Get the number of events, which the kernel dropped, because they were
+     * not read in time. Derived from the gaps of the sequence numbers.
+     *
+     * @return Number of lost events
+     */
+    uint64_t getNumLost(void) const
+    {
+        return m_numLost;
+    }
+
+    /**
+     * Read the pending events without blocking.
+     *
+     * @param[out]  events      Events
+     * @param[in]   maxEvents   Max. number of events
+     *
+     * @return Number of events. 0 if no event is pending, -1 on error.
+     */
+    ssize_t read(struct gpio_v2_line_event* events, size_t maxEvents);
+
+private:
+
+    int         m_fd;           /**< File descriptor or -1 */
+    bool        m_isPollable;   /**< Can the file descriptor be polled? */
+    uint32_t    m_nextSeqNo;    /**< Expected sequence number of the next event, 0 if unknown */
+    uint64_t    m_numLost;      /**< Number of lost events */
+    uint8_t     m_partial[sizeof(struct gpio_v2_line_event)];  /**< Partially read event of a file or pipe */
+    size_t      m_partialSize;  /**< Size in bytes of the partially read event */
+
+    GpioEventSource(const GpioEventSource& source);
+    GpioEventSource& operator=(const GpioEventSource& source);
+
+    bool requestLines(const char* path, const uint32_t* lines, size_t numLines, uint32_t debounceUs);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __GPIO_EVENT_SOURCE_H__ */
+
+/** @} */
@@ -0,0 +1,297 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Shard of the S0 channels of the gateway
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Shard.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+Shard::Shard() :
+    m_sources(),
+    m_channels(),
+    m_mutex(),
+    m_thread(),
+    m_isRunning(false),
+    m_numEvents(0U),
+    m_numLost(0U)
+{
+}
+
+Shard::~Shard()
+{
+}
+
+bool Shard::addSource(const std::vector<Channel*>& channels, uint32_t debounceUs)
+{
+    std::unique_ptr<Source> source(new Source());
+    std::vector<uint32_t>   lines;
+
+    if (true == channels.empty())
+    {
+        return false;
+    }
+
+    for(Channel* channel : channels)
+    {
+        lines.push_back(channel->line);
+        source->channels[channel->line] = channel;
+    }
+
+    if (false == source->events.open(channels.front()->source.c_str(), lines.data(), lines.size(), debounceUs))
+    {
+        return false;
+    }
+
+    for(Channel* channel : channels)
+    {
+        channel->shard = this;
+        m_channels.push_back(channel);
+    }
+
+    m_sources.push_back(std::move(source));
+
+    return true;
+}
+
+void Shard::start(void)
+{
+    m_isRunning = true;
+    m_thread    = std::thread(&Shard::run, this);
+
+    return;
+}
+
+void Shard::stop(void)
+{
+    m_isRunning = false;
+
+    if (true == m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    return;
+}
+
+uint32_t Shard::toMillis(uint64_t timestampNs)
+{
+    /* Like millis(), the time wraps around after 2^32 ms. */
+    return static_cast<uint32_t>((timestampNs / 1000U - getTimeBaseUs()) / 1000U);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * Thread of the shard. It waits for the events of all sources and processes
+ * the S0 smartmeters periodically, like the main loop of the firmware.
+ * Regular files can't be polled, they are read every period. A source,
+ * which failed, is closed and skipped from then on.
+ */
+void Shard::run(void)
+{
+    struct gpio_v2_line_event   events[MAX_EVENTS];
+    std::vector<struct pollfd>  pollFds;
+    std::vector<Source*>        pollSources;
+    uint32_t                    lastProcess = millis();
+
+    buildPollFds(pollFds, pollSources);
+
+    while(true == m_isRunning)
+    {
+        bool    isClosed    = false;
+        size_t  idx         = 0U;
+
+        (void)poll(pollFds.data(), pollFds.size(), PROCESS_PERIOD);
+
+        for(const std::unique_ptr<Source>& source : m_sources)
+        {
+            if ((0 <= source->events.getFd()) &&
+                (false == source->events.isPollable()) &&
+                (false == readSource(*source, events)))
+            {
+                isClosed = true;
+            }
+        }
+
+        /* A error or hangup is handled by the read too, which closes the source. */
+        for(idx = 0U; idx < pollFds.size(); ++idx)
+        {
+            if ((0 != pollFds[idx].revents) &&
+                (false == readSource(*pollSources[idx], events)))
+            {
+                isClosed = true;
+            }
+        }
+
+        /* The file descriptor of a closed source must not be polled anymore,
+         * because poll() would report it as invalid immediately again.
+         */
+        if (true == isClosed)
+        {
+            buildPollFds(pollFds, pollSources);
+        }
+
+        if (static_cast<uint32_t>(PROCESS_PERIOD) <= (static_cast<uint32_t>(millis()) - lastProcess))
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for(Channel* channel : m_channels)
+            {
+                channel->s0Smartmeter.process();
+            }
+
+            lastProcess = millis();
+        }
+    }
+
+    return;
+}
+
+/**
+ * Build the poll set of all open sources, which can be polled.
+ *
+ * @param[out] pollFds      Poll set
+ * @param[out] pollSources  Source of every entry of the poll set
+ */
+void Shard::buildPollFds(std::vector<struct pollfd>& pollFds, std::vector<Source*>& pollSources)
+{
+    pollFds.clear();
+    pollSources.clear();
+
+    for(const std::unique_ptr<Source>& source : m_sources)
+    {
+        if ((0 <= source->events.getFd()) &&
+            (true == source->events.isPollable()))
+        {
+            struct pollfd pfd;
+
+            pfd.fd      = source->events.getFd();
+            pfd.events  = POLLIN;
+            pfd.revents = 0;
+            pollFds.push_back(pfd);
+            pollSources.push_back(source.get());
+        }
+    }
+
+    return;
+}
+
+/**
+ * Read all pending events of a source and apply the falling edges to the
+ * S0 smartmeters. The lock is only held while the events are applied.
+ * If the read fails, the source is closed.
+ *
+ * @param[in] source    Event source
+ * @param[in] events    Buffer of MAX_EVENTS events
+ *
+ * @return If the source is still open, it will return true otherwise false.
+ */
+bool Shard::readSource(Source& source, struct gpio_v2_line_event* events)
+{
+    ssize_t numEvents = 0;
+
+    do
+    {
+        uint64_t    numLost     = source.events.getNumLost();
+        uint64_t    numApplied  = 0U;
+        ssize_t     idx         = 0;
+
+        numEvents = source.events.read(events, MAX_EVENTS);
+
+        if (0 > numEvents)
+        {
+            perror("Event source");
+            source.events.close();
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for(idx = 0; idx < numEvents; ++idx)
+            {
+                std::map<uint32_t, Channel*>::iterator it = source.channels.find(events[idx].offset);
+
+                /* Like the firmware, only falling edges are counted. */
+                if ((GPIO_V2_LINE_EVENT_FALLING_EDGE == events[idx].id) &&
+                    (source.channels.end() != it) &&
+                    (true == it->second->s0Smartmeter.isEnabled()))
+                {
+                    it->second->s0Smartmeter.internalISR(toMillis(events[idx].timestamp_ns));
+                    ++numApplied;
+                }
+            }
+        }
+
+        m_numEvents += numApplied;
+        m_numLost   += source.events.getNumLost() - numLost;
+    }
+    while(static_cast<ssize_t>(MAX_EVENTS) == numEvents);
+
+    return (0 <= numEvents);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,224 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Shard of the S0 channels of the gateway
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * A shard owns the event sources of its channels and runs a thread, which
+ * applies the falling edges to the S0 smartmeters with their kernel
+ * timestamps and decreases the power of the idle ones periodically. The
+ * S0 smartmeters are the ones of the firmware. Their critical sections don't
+ * mask anything on Linux, therefore every access from another thread must
+ * hold the lock of the shard.
+ *
+ * @{
+ */
+
+#ifndef __SHARD_H__
+#define __SHARD_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <poll.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "S0Smartmeter.hpp"
+#include "GpioEventSource.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+class Shard;
+
+/**
+ * A S0 channel: a meter, whose S0 output is connected to a GPIO line.
+ */
+struct Channel
+{
+    S0Smartmeter    s0Smartmeter;   /**< Counting and power calculation, like in the firmware */
+    std::string     source;         /**< Path of the event source */
+    uint32_t        line;           /**< Line offset at the event source */
+    Shard*          shard;          /**< Shard, which owns the channel */
+
+    /**
+     * Constructs a channel, which isn't assigned to a shard yet.
+     */
+    Channel() :
+        s0Smartmeter(),
+        source(),
+        line(0U),
+        shard(nullptr)
+    {
+    }
+};
+
+/**
+ * Shard of the S0 channels with its own thread.
+ */
+class Shard
+{
+public:
+
+    /** Period in ms, in which the power of the idle channels is decreased. */
+    static const int    PROCESS_PERIOD      = 10;
+
+    /** Max. number of events, which are read at once. */
+    static const size_t MAX_EVENTS          = 64U;
+
+    /**
+     * Constructs a shard without channels.
+     */
+    Shard();
+
+    /**
+     * Destroys the shard. The thread must be stopped before.
+     */
+    ~Shard();
+
+    /**
+     * Add the channels of a event source. All channels must have the same
+     * source. Of a GPIO character device at most GpioEventSource::MAX_LINES
+     * channels can be added at once. The channels must exist during the
+     * lifetime of the shard.
+     *
+     * @param[in] channels      Channels of the same source
+     * @param[in] debounceUs    Debounce period in us, 0 to disable
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool addSource(const std::vector<Channel*>& channels, uint32_t debounceUs);
+
+    /**
+     * Get the number of channels.
+     *
+     * @return Number of channels
+     */
+    size_t getNumChannels(void) const
+    {
+        return m_channels.size();
+    }
+
+    /**
+     * Start the thread.
+     */
+    void start(void);
+
+    /**
+     * Stop the thread and wait for its end.
+     */
+    void stop(void);
+
+    /**
+     * Get the lock, which protects the S0 smartmeters of the shard.
+     *
+     * @return Lock
+     */
+    std::mutex& getMutex(void)
+    {
+        return m_mutex;
+    }
+
+    /**
+     * Get the number of applied events.
+     *
+     * @return Number of events
+     */
+    uint64_t getNumEvents(void) const
+    {
+        return m_numEvents;
+    }
+
+    /**
+     * Get the number of events, which the kernel dropped.
+     *
+     * @return Number of lost events
+     */
+    uint64_t getNumLost(void) const
+    {
+        return m_numLost;
+    }
+
+    /**
+     * Convert a kernel timestamp to the time base of millis().
+     *
+     * @param[in] timestampNs   Timestamp in ns of CLOCK_MONOTONIC
+     *
+     * @return Timestamp in ms, which wraps around like millis()
+     */
+    static uint32_t toMillis(uint64_t timestampNs);
+
+private:
+
+    /**
+     * A event source with its channels.
+     */
+    struct Source
+    {
+        GpioEventSource                 events;     /**< Event source */
+        std::map<uint32_t, Channel*>    channels;   /**< Channels by line offset */
+    };
+
+    std::vector<std::unique_ptr<Source>>    m_sources;      /**< Event sources */
+    std::vector<Channel*>                   m_channels;     /**< All channels */
+    std::mutex                              m_mutex;        /**< Protects the S0 smartmeters */
+    std::thread                             m_thread;       /**< Thread of the shard */
+    std::atomic<bool>                       m_isRunning;    /**< Shall the thread run? */
+    std::atomic<uint64_t>                   m_numEvents;    /**< Number of applied events */
+    std::atomic<uint64_t>                   m_numLost;      /**< Number of lost events */
+
+    Shard(const Shard& shard);
+    Shard& operator=(const Shard& shard);
+
+    void run(void);
+    void buildPollFds(std::vector<struct pollfd>& pollFds, std::vector<Source*>& pollSources);
+    bool readSource(Source& source, struct gpio_v2_line_event* events);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SHARD_H__ */
+
+/** @} */
@@ -0,0 +1,202 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino core for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Arduino.h"
+
+#include <time.h>
+#include <sched.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint64_t getMonotonicTimeUs(void);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Time in us of the process start, which is the time base. */
+static uint64_t         gStartTimeUs    = getMonotonicTimeUs();
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/* Like on the AVR, the time wraps around after 2^32 ms resp. us. */
+
+unsigned long millis(void)
+{
+    return static_cast<uint32_t>((getMonotonicTimeUs() - gStartTimeUs) / 1000U);
+}
+
+unsigned long micros(void)
+{
+    return static_cast<uint32_t>(getMonotonicTimeUs() - gStartTimeUs);
+}
+
+uint64_t getTimeBaseUs(void)
+{
+    return gStartTimeUs;
+}
+
+void setMillis(uint32_t ms)
+{
+    /* The time base may be before the start of the monotonic clock, which is fine modulo 2^64. */
+    gStartTimeUs = getMonotonicTimeUs() - static_cast<uint64_t>(ms) * 1000U;
+
+    return;
+}
+
+void delay(unsigned long ms)
+{
+    struct timespec duration;
+
+    duration.tv_sec     = ms / 1000U;
+    duration.tv_nsec    = static_cast<long>((ms % 1000U) * 1000000UL);
+
+    while(0 != nanosleep(&duration, &duration))
+    {
+        /* Interrupted by a signal, continue with the remaining time. */
+        ;
+    }
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    struct timespec duration;
+
+    duration.tv_sec     = us / 1000000U;
+    duration.tv_nsec    = static_cast<long>((us % 1000000U) * 1000UL);
+
+    while(0 != nanosleep(&duration, &duration))
+    {
+        /* Interrupted by a signal, continue with the remaining time. */
+        ;
+    }
+}
+
+void yield(void)
+{
+    (void)sched_yield();
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    (void)pin;
+    (void)value;
+}
+
+int digitalRead(uint8_t pin)
+{
+    (void)pin;
+
+    return LOW;
+}
+
+long random(long max)
+{
+    if (0 >= max)
+    {
+        return 0;
+    }
+
+    return random() % max;
+}
+
+long random(long min, long max)
+{
+    if (min >= max)
+    {
+        return min;
+    }
+
+    return min + random(max - min);
+}
+
+void randomSeed(unsigned long seed)
+{
+    if (0U != seed)
+    {
+        srandom(static_cast<unsigned int>(seed));
+    }
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the time of the monotonic clock.
+ *
+ * @return Time in us
+ */
+static uint64_t getMonotonicTimeUs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<uint64_t>(now.tv_sec) * 1000000U + static_cast<uint64_t>(now.tv_nsec) / 1000U;
+}
@@ -0,0 +1,252 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino core for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Provides the subset of the Arduino core, which is used by the firmware and
+ * its libraries, to run the firmware as Linux process. The program memory is
+ * ordinary memory and the time is derived from the monotonic clock.
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __ARDUINO_H__
+#define __ARDUINO_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <inttypes.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Program memory is ordinary memory. */
+#define PROGMEM
+
+/** Pointer to a string in program memory */
+#define PGM_P               const char*
+
+/** String literal in program memory */
+#define PSTR(_str)          (_str)
+
+/** String literal in program memory, usable for print functions. */
+#define F(_str)             (reinterpret_cast<const __FlashStringHelper*>(PSTR(_str)))
+
+/** Cast a string in program memory, usable for print functions. */
+#define FPSTR(_str)         (reinterpret_cast<const __FlashStringHelper*>(_str))
+
+#define pgm_read_byte(_addr)    (*reinterpret_cast<const uint8_t*>(_addr))
+#define pgm_read_word(_addr)    (*reinterpret_cast<const uint16_t*>(_addr))
+#define pgm_read_dword(_addr)   (*reinterpret_cast<const uint32_t*>(_addr))
+#define pgm_read_float(_addr)   (*reinterpret_cast<const float*>(_addr))
+#define pgm_read_ptr(_addr)     (*(void* const*)(_addr))
+
+#define strlen_P        strlen
+#define strcmp_P        strcmp
+#define strncmp_P       strncmp
+#define strcasecmp_P    strcasecmp
+#define strcpy_P        strcpy
+#define strncpy_P       strncpy
+#define strcat_P        strcat
+#define strstr_P        strstr
+#define strchr_P        strchr
+#define memcpy_P        memcpy
+#define memcmp_P        memcmp
+#define sprintf_P       sprintf
+#define snprintf_P      snprintf
+#define vsnprintf_P     vsnprintf
+#define printf_P        printf
+
+/** Bit value */
+#define _BV(_bit)       (1U << (_bit))
+
+#define bit(_bit)                   (1UL << (_bit))
+#define bitRead(_value, _bit)       (((_value) >> (_bit)) & 0x01)
+#define bitSet(_value, _bit)        ((_value) |= (1UL << (_bit)))
+#define bitClear(_value, _bit)      ((_value) &= ~(1UL << (_bit)))
+#define lowByte(_w)                 ((uint8_t)((_w) & 0xff))
+#define highByte(_w)                ((uint8_t)((_w) >> 8))
+
+#define LOW             (0x0)
+#define HIGH            (0x1)
+
+#define INPUT           (0x0)
+#define OUTPUT          (0x1)
+#define INPUT_PULLUP    (0x2)
+
+/** Interrupts are never masked, because there are no real interrupts. */
+#define interrupts()
+#define noInterrupts()
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Arduino boolean */
+typedef bool boolean;
+
+/** Arduino byte */
+typedef uint8_t byte;
+
+/** Arduino word */
+typedef uint16_t word;
+
+/** Marks a string in program memory for the print functions. */
+class __FlashStringHelper;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Get the time since the start of the process.
+ *
+ * @return Time in ms
+ */
+unsigned long millis(void);
+
+/**
+ * Get the time since the start of the process.
+ *
+ * @return Time in us
+ */
+unsigned long micros(void);
+
+/**
+ * Get the time base of millis() and micros(). It isn't part of the Arduino
+ * API, but needed to convert timestamps of the monotonic clock, e.g. of
+ * kernel events, to the time of millis().
+ *
+ * @return Time in us of the monotonic clock
+ */
+uint64_t getTimeBaseUs(void);
+
+/**
+ * Move the time base, so millis() continues with the given time. It isn't
+ * part of the Arduino API, but used to reach the wrap around of millis()
+ * after 2^32 ms in tests. Call it before any time is taken.
+ *
+ * @param[in] ms    Time in ms, which millis() provides now
+ */
+void setMillis(uint32_t ms);
+
+/**
+ * Wait for the given time.
+ *
+ * @param[in] ms    Time in ms
+ */
+void delay(unsigned long ms);
+
+/**
+ * Wait for the given time.
+ *
+ * @param[in] us    Time in us
+ */
+void delayMicroseconds(unsigned int us);
+
+/**
+ * Give other tasks the chance to run. There are no other tasks.
+ */
+void yield(void);
+
+/**
+ * Configure a pin. There are no pins.
+ *
+ * @param[in] pin   Pin number
+ * @param[in] mode  Pin mode
+ */
+void pinMode(uint8_t pin, uint8_t mode);
+
+/**
+ * Set the pin output value. There are no pins.
+ *
+ * @param[in] pin   Pin number
+ * @param[in] value Output value
+ */
+void digitalWrite(uint8_t pin, uint8_t value);
+
+/**
+ * Read the pin input value. There are no pins.
+ *
+ * @param[in] pin   Pin number
+ *
+ * @return Input value, which is always LOW.
+ */
+int digitalRead(uint8_t pin);
+
+/**
+ * Get a random number in the range [0; max).
+ *
+ * @param[in] max   Upper bound, exclusive
+ *
+ * @return Random number
+ */
+long random(long max);
+
+/**
+ * Get a random number in the range [min; max).
+ *
+ * @param[in] min   Lower bound, inclusive
+ * @param[in] max   Upper bound, exclusive
+ *
+ * @return Random number
+ */
+long random(long min, long max);
+
+/**
+ * Seed the random number generator.
+ *
+ * @param[in] seed  Seed
+ */
+void randomSeed(unsigned long seed);
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+
+#endif  /* __ARDUINO_H__ */
+
+/** @} */
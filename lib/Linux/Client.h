@@ -0,0 +1,129 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino client interface for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __CLIENT_H__
+#define __CLIENT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Stream.h"
+#include "IPAddress.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Interface of a network client, like the Arduino one.
+ */
+class Client : public Stream
+{
+public:
+
+    /**
+     * Destroys the client.
+     */
+    virtual ~Client()
+    {
+    }
+
+    /**
+     * Connect to a server.
+     *
+     * @param[in] ip    Server address
+     * @param[in] port  Server port
+     *
+     * @return If successful, it will return 1 otherwise 0.
+     */
+    virtual int connect(IPAddress ip, uint16_t port) = 0;
+
+    /**
+     * Connect to a server.
+     *
+     * @param[in] host  Server host name
+     * @param[in] port  Server port
+     *
+     * @return If successful, it will return 1 otherwise 0.
+     */
+    virtual int connect(const char* host, uint16_t port) = 0;
+
+    /**
+     * Read several bytes.
+     *
+     * @param[out]  buffer  Data buffer
+     * @param[in]   size    Data buffer size
+     *
+     * @return Number of read bytes or -1 if none is available.
+     */
+    virtual int read(uint8_t* buffer, size_t size) = 0;
+
+    /**
+     * Close the connection.
+     */
+    virtual void stop(void) = 0;
+
+    /**
+     * Is the client connected or is received data not read yet?
+     *
+     * @return If connected, it will return non-zero otherwise 0.
+     */
+    virtual uint8_t connected(void) = 0;
+
+    /**
+     * Is the client valid?
+     *
+     * @return If valid, it will return true otherwise false.
+     */
+    virtual operator bool() = 0;
+
+    using Stream::read;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __CLIENT_H__ */
+
+/** @} */
@@ -0,0 +1,515 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  EthernetENC client for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EthernetClient.h"
+
+#include <errno.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Connection, which is shared by all copies of a client.
+ */
+struct EthernetSocket
+{
+    int     fd;                                         /**< Socket file descriptor */
+    bool    isPeerClosed;                               /**< Peer closed its side of the connection */
+    size_t  txLen;                                      /**< Number of collected bytes to send */
+    uint8_t txBuffer[EthernetClient::TX_BUFFER_SIZE];   /**< Collected bytes to send */
+
+    /**
+     * Constructs the connection.
+     *
+     * @param[in] socketFd  Socket file descriptor
+     */
+    explicit EthernetSocket(int socketFd) :
+        fd(socketFd),
+        isPeerClosed(false),
+        txLen(0U),
+        txBuffer()
+    {
+    }
+
+    /**
+     * Destroys the connection and closes it.
+     */
+    ~EthernetSocket()
+    {
+        close();
+    }
+
+    /**
+     * Send all collected bytes.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool flush(void)
+    {
+        size_t  sent    = 0U;
+        bool    isOk    = true;
+
+        while((0 <= fd) && (sent < txLen))
+        {
+            ssize_t ret = ::send(fd, &txBuffer[sent], txLen - sent, MSG_NOSIGNAL);
+
+            if (0 < ret)
+            {
+                sent += static_cast<size_t>(ret);
+            }
+            else if ((0 > ret) && (EINTR == errno))
+            {
+                continue;
+            }
+            else
+            {
+                /* The peer is gone or doesn't read anymore. */
+                isOk = false;
+                break;
+            }
+        }
+
+        txLen = 0U;
+
+        return isOk;
+    }
+
+    /**
+     * Fill the receive state and check whether the peer closed the connection.
+     *
+     * @return Number of received bytes, which are not read yet.
+     */
+    int pending(void)
+    {
+        int cnt = 0;
+
+        if (0 > fd)
+        {
+            return 0;
+        }
+
+        if ((0 != ioctl(fd, FIONREAD, &cnt)) || (0 > cnt))
+        {
+            cnt = 0;
+        }
+
+        if ((0 == cnt) && (false == isPeerClosed))
+        {
+            uint8_t data    = 0U;
+            ssize_t ret     = ::recv(fd, &data, sizeof(data), MSG_PEEK | MSG_DONTWAIT);
+
+            if (0 == ret)
+            {
+                isPeerClosed = true;
+            }
+            else if ((0 > ret) && (EAGAIN != errno) && (EWOULDBLOCK != errno) && (EINTR != errno))
+            {
+                isPeerClosed = true;
+            }
+            else if (0 < ret)
+            {
+                cnt = 1;
+            }
+        }
+
+        return cnt;
+    }
+
+    /**
+     * Close the connection. The sending side is shut down first, so the peer
+     * receives all data before the connection is released.
+     */
+    void close(void)
+    {
+        if (0 <= fd)
+        {
+            uint8_t drain[64U];
+
+            (void)flush();
+            (void)::shutdown(fd, SHUT_WR);
+
+            /* Unread data would reset the connection instead of closing it. */
+            while(0 < ::recv(fd, drain, sizeof(drain), MSG_DONTWAIT))
+            {
+                ;
+            }
+
+            (void)::close(fd);
+            fd = -1;
+        }
+    }
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void configureSocket(int fd);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Timeout in ms for sending, to prevent hanging on a peer, which doesn't read. */
+static const unsigned int   SEND_TIMEOUT    = 5000U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+EthernetClient::EthernetClient() :
+    Client(),
+    m_socket()
+{
+}
+
+EthernetClient::EthernetClient(int fd) :
+    Client(),
+    m_socket()
+{
+    if (0 <= fd)
+    {
+        configureSocket(fd);
+        m_socket = std::make_shared<EthernetSocket>(fd);
+    }
+}
+
+EthernetClient::~EthernetClient()
+{
+}
+
+int EthernetClient::connect(IPAddress ip, uint16_t port)
+{
+    struct sockaddr_in  addr;
+    int                 fd  = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    stop();
+
+    if (0 > fd)
+    {
+        return 0;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_port           = htons(port);
+    addr.sin_addr.s_addr    = static_cast<uint32_t>(ip);
+
+    if (0 != ::connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)))
+    {
+        (void)::close(fd);
+        return 0;
+    }
+
+    configureSocket(fd);
+    m_socket = std::make_shared<EthernetSocket>(fd);
+
+    return 1;
+}
+
+int EthernetClient::connect(const char* host, uint16_t port)
+{
+    struct addrinfo     hints;
+    struct addrinfo*    result  = nullptr;
+    int                 ret     = 0;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family     = AF_INET;
+    hints.ai_socktype   = SOCK_STREAM;
+
+    if ((nullptr != host) &&
+        (0 == getaddrinfo(host, nullptr, &hints, &result)) &&
+        (nullptr != result))
+    {
+        const struct sockaddr_in* addr = reinterpret_cast<const struct sockaddr_in*>(result->ai_addr);
+
+        ret = connect(IPAddress(static_cast<uint32_t>(addr->sin_addr.s_addr)), port);
+    }
+
+    if (nullptr != result)
+    {
+        freeaddrinfo(result);
+    }
+
+    return ret;
+}
+
+size_t EthernetClient::write(uint8_t data)
+{
+    return write(&data, 1U);
+}
+
+size_t EthernetClient::write(const uint8_t* buffer, size_t size)
+{
+    size_t written = 0U;
+
+    if ((nullptr == m_socket) || (0 > m_socket->fd) || (nullptr == buffer))
+    {
+        return 0U;
+    }
+
+    while(written < size)
+    {
+        size_t chunk = TX_BUFFER_SIZE - m_socket->txLen;
+
+        if (chunk > (size - written))
+        {
+            chunk = size - written;
+        }
+
+        memcpy(&m_socket->txBuffer[m_socket->txLen], &buffer[written], chunk);
+        m_socket->txLen += chunk;
+        written         += chunk;
+
+        if (TX_BUFFER_SIZE <= m_socket->txLen)
+        {
+            if (false == m_socket->flush())
+            {
+                setWriteError();
+                break;
+            }
+        }
+    }
+
+    return written;
+}
+
+int EthernetClient::availableForWrite(void)
+{
+    if ((nullptr == m_socket) || (0 > m_socket->fd))
+    {
+        return 0;
+    }
+
+    return static_cast<int>(TX_BUFFER_SIZE - m_socket->txLen);
+}
+
+int EthernetClient::available(void)
+{
+    if (nullptr == m_socket)
+    {
+        return 0;
+    }
+
+    /* The response to the received data may depend on the data already written. */
+    if (0U < m_socket->txLen)
+    {
+        (void)m_socket->flush();
+    }
+
+    return m_socket->pending();
+}
+
+int EthernetClient::read(void)
+{
+    uint8_t data = 0U;
+
+    if (1 != read(&data, 1U))
+    {
+        return -1;
+    }
+
+    return data;
+}
+
+int EthernetClient::read(uint8_t* buffer, size_t size)
+{
+    ssize_t ret = -1;
+
+    if ((0 >= available()) || (nullptr == buffer) || (0U == size))
+    {
+        return -1;
+    }
+
+    ret = ::recv(m_socket->fd, buffer, size, MSG_DONTWAIT);
+
+    if (0 == ret)
+    {
+        m_socket->isPeerClosed = true;
+    }
+
+    return (0 < ret) ? static_cast<int>(ret) : -1;
+}
+
+int EthernetClient::peek(void)
+{
+    uint8_t data = 0U;
+
+    if ((0 >= available()) ||
+        (1 != ::recv(m_socket->fd, &data, 1U, MSG_PEEK | MSG_DONTWAIT)))
+    {
+        return -1;
+    }
+
+    return data;
+}
+
+void EthernetClient::flush(void)
+{
+    if (nullptr != m_socket)
+    {
+        if (false == m_socket->flush())
+        {
+            setWriteError();
+        }
+    }
+}
+
+void EthernetClient::stop(void)
+{
+    if (nullptr != m_socket)
+    {
+        /* All copies share the connection, therefore it's closed for them too. */
+        m_socket->close();
+        m_socket.reset();
+    }
+}
+
+uint8_t EthernetClient::connected(void)
+{
+    if ((nullptr == m_socket) || (0 > m_socket->fd))
+    {
+        return 0U;
+    }
+
+    /* Like EthernetENC, a client is connected as long as received data is not read. */
+    if ((0 < available()) || (false == m_socket->isPeerClosed))
+    {
+        return 1U;
+    }
+
+    return 0U;
+}
+
+EthernetClient::operator bool()
+{
+    return (nullptr != m_socket) && (0 <= m_socket->fd);
+}
+
+IPAddress EthernetClient::remoteIP(void)
+{
+    struct sockaddr_in  addr;
+    socklen_t           addrLen = sizeof(addr);
+
+    if ((nullptr == m_socket) ||
+        (0 != getpeername(m_socket->fd, reinterpret_cast<struct sockaddr*>(&addr), &addrLen)))
+    {
+        return IPAddress();
+    }
+
+    return IPAddress(static_cast<uint32_t>(addr.sin_addr.s_addr));
+}
+
+uint16_t EthernetClient::remotePort(void)
+{
+    struct sockaddr_in  addr;
+    socklen_t           addrLen = sizeof(addr);
+
+    if ((nullptr == m_socket) ||
+        (0 != getpeername(m_socket->fd, reinterpret_cast<struct sockaddr*>(&addr), &addrLen)))
+    {
+        return 0U;
+    }
+
+    return ntohs(addr.sin_port);
+}
+
+uint16_t EthernetClient::localPort(void)
+{
+    struct sockaddr_in  addr;
+    socklen_t           addrLen = sizeof(addr);
+
+    if ((nullptr == m_socket) ||
+        (0 != getsockname(m_socket->fd, reinterpret_cast<struct sockaddr*>(&addr), &addrLen)))
+    {
+        return 0U;
+    }
+
+    return ntohs(addr.sin_port);
+}
+
+int EthernetClient::getFd(void) const
+{
+    return (nullptr == m_socket) ? -1 : m_socket->fd;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Configure a connected socket. The collected data is sent at once and
+ * sending times out, if the peer doesn't read anymore.
+ *
+ * @param[in] fd    Socket file descriptor
+ */
+static void configureSocket(int fd)
+{
+    int             noDelay = 1;
+    struct timeval  timeout;
+
+    timeout.tv_sec  = SEND_TIMEOUT / 1000U;
+    timeout.tv_usec = (SEND_TIMEOUT % 1000U) * 1000U;
+
+    (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    (void)setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
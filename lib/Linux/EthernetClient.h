@@ -0,0 +1,179 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  EthernetENC client for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __ETHERNET_CLIENT_H__
+#define __ETHERNET_CLIENT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <memory>
+
+#include "Client.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+struct EthernetSocket;
+
+/**
+ * TCP client, based on a socket of the host.
+ *
+ * Like with EthernetENC, all copies of a client share the same connection.
+ * The written data is collected until a TCP segment is full, the client is
+ * flushed or the connection is closed. The connection is closed by stop()
+ * or if the last copy of the client is destroyed.
+ */
+class EthernetClient : public Client
+{
+public:
+
+    /**
+     * Constructs a client without connection.
+     */
+    EthernetClient();
+
+    /**
+     * Constructs a client for a already established connection.
+     *
+     * @param[in] fd    Socket file descriptor, the client takes the ownership.
+     */
+    explicit EthernetClient(int fd);
+
+    /**
+     * Destroys the client. If it is the last copy, the connection is closed.
+     */
+    virtual ~EthernetClient();
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int availableForWrite(void) override;
+
+    int available(void) override;
+    int read(void) override;
+    int read(uint8_t* buffer, size_t size) override;
+    int peek(void) override;
+
+    /**
+     * Send all written data.
+     */
+    void flush(void) override;
+
+    void stop(void) override;
+    uint8_t connected(void) override;
+    operator bool() override;
+
+    /**
+     * Get the remote address.
+     *
+     * @return Remote address
+     */
+    IPAddress remoteIP(void);
+
+    /**
+     * Get the remote port.
+     *
+     * @return Remote port
+     */
+    uint16_t remotePort(void);
+
+    /**
+     * Get the local port.
+     *
+     * @return Local port
+     */
+    uint16_t localPort(void);
+
+    /**
+     * Get the socket file descriptor.
+     *
+     * @return Socket file descriptor or -1 if there is no connection.
+     */
+    int getFd(void) const;
+
+    /**
+     * Do both clients share the same connection?
+     *
+     * @param[in] client    Other client
+     *
+     * @return If they share the same connection, it will return true otherwise false.
+     */
+    bool operator==(const EthernetClient& client) const
+    {
+        return m_socket == client.m_socket;
+    }
+
+    /**
+     * Do both clients not share the same connection?
+     *
+     * @param[in] client    Other client
+     *
+     * @return If they don't share the same connection, it will return true otherwise false.
+     */
+    bool operator!=(const EthernetClient& client) const
+    {
+        return m_socket != client.m_socket;
+    }
+
+    using Print::write;
+    using Client::read;
+
+    /** Max. TCP segment payload, which the client collects before sending. */
+    static const size_t TX_BUFFER_SIZE  = 1460U;
+
+private:
+
+    std::shared_ptr<EthernetSocket> m_socket;   /**< Connection, shared by all copies */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __ETHERNET_CLIENT_H__ */
+
+/** @} */
@@ -0,0 +1,268 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  EthernetENC for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __ETHERNET_ENC_H__
+#define __ETHERNET_ENC_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IPAddress.h"
+#include "EthernetClient.h"
+#include "EthernetServer.h"
+#include "EthernetUdp.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Link status */
+enum EthernetLinkStatus
+{
+    Unknown = 0,    /**< Unknown link status */
+    LinkON,         /**< Link is up */
+    LinkOFF         /**< Link is down */
+};
+
+/** Ethernet controller */
+enum EthernetHardwareStatus
+{
+    EthernetNoHardware = 0, /**< No ethernet controller */
+    EthernetW5100,          /**< WIZnet W5100 */
+    EthernetW5200,          /**< WIZnet W5200 */
+    EthernetW5500,          /**< WIZnet W5500 */
+    EthernetENC28J60 = 10   /**< Microchip ENC28J60 */
+};
+
+/**
+ * Ethernet interface, which is replaced by the loopback interface of the host.
+ * It is always up and its address is 127.0.0.1.
+ */
+class EthernetClass
+{
+public:
+
+    /**
+     * Constructs the ethernet interface.
+     */
+    EthernetClass() :
+        m_portOffset(0U),
+        m_listenAddress(LISTEN_LOOPBACK)
+    {
+    }
+
+    /**
+     * Destroys the ethernet interface.
+     */
+    ~EthernetClass()
+    {
+    }
+
+    /**
+     * Initialize the interface with DHCP.
+     *
+     * @param[in] mac               MAC address
+     * @param[in] timeout           DHCP timeout in ms
+     * @param[in] responseTimeout   DHCP response timeout in ms
+     *
+     * @return Always 1, because there is no DHCP.
+     */
+    int begin(const uint8_t* mac, unsigned long timeout = 60000UL, unsigned long responseTimeout = 4000UL)
+    {
+        (void)mac;
+        (void)timeout;
+        (void)responseTimeout;
+
+        return 1;
+    }
+
+    /**
+     * Initialize the interface with a static configuration, which is ignored.
+     *
+     * @param[in] mac       MAC address
+     * @param[in] ip        IP address
+     * @param[in] dns       DNS server address
+     * @param[in] gateway   Gateway address
+     * @param[in] subnet    Subnet mask
+     */
+    void begin(const uint8_t* mac, IPAddress ip, IPAddress dns, IPAddress gateway, IPAddress subnet)
+    {
+        (void)mac;
+        (void)ip;
+        (void)dns;
+        (void)gateway;
+        (void)subnet;
+    }
+
+    /**
+     * Maintain the DHCP lease.
+     *
+     * @return Always 0, which means nothing happened.
+     */
+    int maintain(void)
+    {
+        return 0;
+    }
+
+    /**
+     * Get the link status.
+     *
+     * @return Always LinkON
+     */
+    EthernetLinkStatus linkStatus(void)
+    {
+        return LinkON;
+    }
+
+    /**
+     * Get the ethernet controller.
+     *
+     * @return Always EthernetENC28J60
+     */
+    EthernetHardwareStatus hardwareStatus(void)
+    {
+        return EthernetENC28J60;
+    }
+
+    /**
+     * Get the IP address.
+     *
+     * @return Always 127.0.0.1
+     */
+    IPAddress localIP(void)
+    {
+        return IPAddress(127U, 0U, 0U, 1U);
+    }
+
+    /**
+     * Get the subnet mask.
+     *
+     * @return Always 255.0.0.0
+     */
+    IPAddress subnetMask(void)
+    {
+        return IPAddress(255U, 0U, 0U, 0U);
+    }
+
+    /**
+     * Get the gateway address.
+     *
+     * @return Always 127.0.0.1
+     */
+    IPAddress gatewayIP(void)
+    {
+        return IPAddress(127U, 0U, 0U, 1U);
+    }
+
+    /**
+     * Get the DNS server address.
+     *
+     * @return Always 127.0.0.1
+     */
+    IPAddress dnsServerIP(void)
+    {
+        return IPAddress(127U, 0U, 0U, 1U);
+    }
+
+    /**
+     * Set the offset, which is added to the port of every server.
+     *
+     * @param[in] offset    Port offset
+     */
+    void setPortOffset(uint16_t offset)
+    {
+        m_portOffset = offset;
+    }
+
+    /**
+     * Get the offset, which is added to the port of every server.
+     *
+     * @return Port offset
+     */
+    uint16_t getPortOffset(void) const
+    {
+        return m_portOffset;
+    }
+
+    /**
+     * Set the address, where every server listens.
+     *
+     * @param[in] addr  IPv4 address in host byte order, e.g. LISTEN_ANY
+     */
+    void setListenAddress(uint32_t addr)
+    {
+        m_listenAddress = addr;
+    }
+
+    /**
+     * Get the address, where every server listens.
+     *
+     * @return IPv4 address in host byte order
+     */
+    uint32_t getListenAddress(void) const
+    {
+        return m_listenAddress;
+    }
+
+    /** Listen on the loopback interface only, which is the default. */
+    static const uint32_t   LISTEN_LOOPBACK = 0x7F000001U;
+
+    /** Listen on all interfaces. */
+    static const uint32_t   LISTEN_ANY      = 0U;
+
+private:
+
+    uint16_t    m_portOffset;       /**< Offset, which is added to the port of every server */
+    uint32_t    m_listenAddress;    /**< Address in host byte order, where every server listens */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/** Ethernet interface */
+extern EthernetClass Ethernet;
+
+#endif  /* __ETHERNET_ENC_H__ */
+
+/** @} */
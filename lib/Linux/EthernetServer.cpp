@@ -0,0 +1,257 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  EthernetENC server for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EthernetENC.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** All servers, which are listening. */
+static std::vector<EthernetServer*> gServers;
+
+/** Listening and pending client sockets of all servers, used for waiting. */
+static std::vector<struct pollfd>   gPollFds;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+EthernetServer::EthernetServer(uint16_t port) :
+    Server(),
+    m_port(port),
+    m_fd(-1),
+    m_pending()
+{
+}
+
+EthernetServer::~EthernetServer()
+{
+    std::vector<EthernetServer*>::iterator it = gServers.begin();
+
+    while(gServers.end() != it)
+    {
+        if (this == *it)
+        {
+            it = gServers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (0 <= m_fd)
+    {
+        (void)close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void EthernetServer::begin(void)
+{
+    struct sockaddr_in  addr;
+    int                 reuseAddr   = 1;
+    uint16_t            port        = m_port + Ethernet.getPortOffset();
+
+    if (0 <= m_fd)
+    {
+        return;
+    }
+
+    m_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (0 > m_fd)
+    {
+        perror("socket");
+        return;
+    }
+
+    /* Allows a immediate restart, e.g. after a reset. */
+    (void)setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &reuseAddr, sizeof(reuseAddr));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_port           = htons(port);
+    addr.sin_addr.s_addr    = htonl(Ethernet.getListenAddress());
+
+    if ((0 != bind(m_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr))) ||
+        (0 != listen(m_fd, SOMAXCONN)))
+    {
+        fprintf(stderr, "Can't listen on port %u: %s\n", port, strerror(errno));
+        (void)close(m_fd);
+        m_fd = -1;
+        return;
+    }
+
+    gServers.push_back(this);
+}
+
+EthernetClient EthernetServer::available(void)
+{
+    std::vector<EthernetClient>::iterator it;
+
+    acceptAll();
+
+    it = m_pending.begin();
+    while(m_pending.end() != it)
+    {
+        if (0 < it->available())
+        {
+            EthernetClient client = *it;
+
+            (void)m_pending.erase(it);
+
+            return client;
+        }
+        else if (0U == it->connected())
+        {
+            /* Closed without a request. */
+            it = m_pending.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return EthernetClient();
+}
+
+EthernetClient EthernetServer::accept(void)
+{
+    EthernetClient client;
+
+    acceptAll();
+
+    if (false == m_pending.empty())
+    {
+        client = m_pending.front();
+        (void)m_pending.erase(m_pending.begin());
+    }
+
+    return client;
+}
+
+size_t EthernetServer::write(uint8_t data)
+{
+    (void)data;
+
+    return 0U;
+}
+
+void EthernetServer::waitForClients(int timeout)
+{
+    size_t  serverIdx   = 0U;
+    size_t  clientIdx   = 0U;
+
+    gPollFds.clear();
+
+    for(serverIdx = 0U; serverIdx < gServers.size(); ++serverIdx)
+    {
+        EthernetServer* server = gServers[serverIdx];
+        struct pollfd   pfd;
+
+        pfd.fd      = server->m_fd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        gPollFds.push_back(pfd);
+
+        for(clientIdx = 0U; clientIdx < server->m_pending.size(); ++clientIdx)
+        {
+            pfd.fd = server->m_pending[clientIdx].getFd();
+
+            if (0 <= pfd.fd)
+            {
+                gPollFds.push_back(pfd);
+            }
+        }
+    }
+
+    (void)poll(gPollFds.data(), gPollFds.size(), timeout);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void EthernetServer::acceptAll(void)
+{
+    while((0 <= m_fd) && (MAX_PENDING > m_pending.size()))
+    {
+        int fd = accept4(m_fd, nullptr, nullptr, SOCK_CLOEXEC);
+
+        if (0 > fd)
+        {
+            break;
+        }
+
+        m_pending.push_back(EthernetClient(fd));
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,146 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  EthernetENC server for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __ETHERNET_SERVER_H__
+#define __ETHERNET_SERVER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <vector>
+
+#include "Server.h"
+#include "EthernetClient.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * TCP server, based on a listening socket of the host.
+ *
+ * The server listens on the loopback interface, unless another address is
+ * set, see EthernetClass::setListenAddress(). Its port is the given one
+ * plus the port offset, see EthernetClass::setPortOffset(). This way the
+ * firmware can run without root privileges.
+ */
+class EthernetServer : public Server
+{
+public:
+
+    /**
+     * Constructs the server.
+     *
+     * @param[in] port  Port, where to listen for clients.
+     */
+    explicit EthernetServer(uint16_t port);
+
+    /**
+     * Destroys the server.
+     */
+    virtual ~EthernetServer();
+
+    /**
+     * Start listening for clients.
+     */
+    void begin(void) override;
+
+    /**
+     * Get the next client, which sent data. Like EthernetENC, a client is
+     * returned only once.
+     *
+     * @return Client, which is invalid if there is none.
+     */
+    EthernetClient available(void);
+
+    /**
+     * Get the next new client, regardless whether it sent data.
+     *
+     * @return Client, which is invalid if there is none.
+     */
+    EthernetClient accept(void);
+
+    /**
+     * Writing to all clients is not supported.
+     *
+     * @param[in] data  Data byte
+     *
+     * @return Number of written bytes, which is always 0.
+     */
+    size_t write(uint8_t data) override;
+
+    using Print::write;
+
+    /**
+     * Wait until a client of any server connects or sends data.
+     *
+     * @param[in] timeout   Max. time to wait in ms
+     */
+    static void waitForClients(int timeout);
+
+    /** Max. number of accepted clients, which didn't send data yet. */
+    static const size_t MAX_PENDING = 16U;
+
+private:
+
+    uint16_t                    m_port;     /**< Port without offset */
+    int                         m_fd;       /**< Listening socket file descriptor */
+    std::vector<EthernetClient> m_pending;  /**< Accepted clients, which didn't send data yet */
+
+    /**
+     * Accept all new clients, as long as there is space for them.
+     */
+    void acceptAll(void);
+
+    EthernetServer();
+    EthernetServer(const EthernetServer& server);
+    EthernetServer& operator=(const EthernetServer& server);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __ETHERNET_SERVER_H__ */
+
+/** @} */
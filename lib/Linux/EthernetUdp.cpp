@@ -0,0 +1,315 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  EthernetENC UDP for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EthernetUdp.h"
+
+#include <netdb.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+EthernetUDP::EthernetUDP() :
+    UDP(),
+    m_fd(-1),
+    m_txIp(),
+    m_txPort(0U),
+    m_txLen(0U),
+    m_txBuffer(),
+    m_rxIp(),
+    m_rxPort(0U),
+    m_rxLen(0U),
+    m_rxPos(0U),
+    m_rxBuffer()
+{
+}
+
+EthernetUDP::~EthernetUDP()
+{
+    stop();
+}
+
+uint8_t EthernetUDP::begin(uint16_t port)
+{
+    struct sockaddr_in addr;
+
+    stop();
+
+    if (false == open())
+    {
+        return 0U;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_port           = htons(port);
+    addr.sin_addr.s_addr    = htonl(INADDR_ANY);
+
+    if (0 != bind(m_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)))
+    {
+        stop();
+        return 0U;
+    }
+
+    return 1U;
+}
+
+void EthernetUDP::stop(void)
+{
+    if (0 <= m_fd)
+    {
+        (void)close(m_fd);
+        m_fd = -1;
+    }
+
+    m_txLen = 0U;
+    m_rxLen = 0U;
+    m_rxPos = 0U;
+}
+
+int EthernetUDP::beginPacket(IPAddress ip, uint16_t port)
+{
+    if (false == open())
+    {
+        return 0;
+    }
+
+    m_txIp      = ip;
+    m_txPort    = port;
+    m_txLen     = 0U;
+
+    return 1;
+}
+
+int EthernetUDP::beginPacket(const char* host, uint16_t port)
+{
+    struct addrinfo     hints;
+    struct addrinfo*    result  = nullptr;
+    int                 ret     = 0;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family     = AF_INET;
+    hints.ai_socktype   = SOCK_DGRAM;
+
+    if ((nullptr != host) &&
+        (0 == getaddrinfo(host, nullptr, &hints, &result)) &&
+        (nullptr != result))
+    {
+        const struct sockaddr_in* addr = reinterpret_cast<const struct sockaddr_in*>(result->ai_addr);
+
+        ret = beginPacket(IPAddress(static_cast<uint32_t>(addr->sin_addr.s_addr)), port);
+    }
+
+    if (nullptr != result)
+    {
+        freeaddrinfo(result);
+    }
+
+    return ret;
+}
+
+int EthernetUDP::endPacket(void)
+{
+    struct sockaddr_in  addr;
+    ssize_t             ret     = -1;
+
+    if (0 > m_fd)
+    {
+        return 0;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_port           = htons(m_txPort);
+    addr.sin_addr.s_addr    = static_cast<uint32_t>(m_txIp);
+
+    ret = sendto(m_fd, m_txBuffer, m_txLen, MSG_NOSIGNAL, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+
+    m_txLen = 0U;
+
+    return (0 <= ret) ? 1 : 0;
+}
+
+size_t EthernetUDP::write(uint8_t data)
+{
+    return write(&data, 1U);
+}
+
+size_t EthernetUDP::write(const uint8_t* buffer, size_t size)
+{
+    if ((nullptr == buffer) || (0 > m_fd))
+    {
+        return 0U;
+    }
+
+    /* Like the ENC28J60, the rest of a datagram, which is too large, is discarded. */
+    if ((BUFFER_SIZE - m_txLen) < size)
+    {
+        size = BUFFER_SIZE - m_txLen;
+    }
+
+    memcpy(&m_txBuffer[m_txLen], buffer, size);
+    m_txLen += size;
+
+    return size;
+}
+
+int EthernetUDP::parsePacket(void)
+{
+    struct sockaddr_in  addr;
+    socklen_t           addrLen = sizeof(addr);
+    ssize_t             ret     = -1;
+
+    m_rxLen = 0U;
+    m_rxPos = 0U;
+
+    if (0 > m_fd)
+    {
+        return 0;
+    }
+
+    ret = recvfrom(m_fd, m_rxBuffer, sizeof(m_rxBuffer), MSG_DONTWAIT, reinterpret_cast<struct sockaddr*>(&addr), &addrLen);
+
+    if (0 >= ret)
+    {
+        return 0;
+    }
+
+    m_rxLen     = static_cast<size_t>(ret);
+    m_rxIp      = IPAddress(static_cast<uint32_t>(addr.sin_addr.s_addr));
+    m_rxPort    = ntohs(addr.sin_port);
+
+    return static_cast<int>(m_rxLen);
+}
+
+int EthernetUDP::available(void)
+{
+    return static_cast<int>(m_rxLen - m_rxPos);
+}
+
+int EthernetUDP::read(void)
+{
+    if (m_rxPos >= m_rxLen)
+    {
+        return -1;
+    }
+
+    ++m_rxPos;
+
+    return m_rxBuffer[m_rxPos - 1U];
+}
+
+int EthernetUDP::read(unsigned char* buffer, size_t size)
+{
+    size_t available = m_rxLen - m_rxPos;
+
+    if (available < size)
+    {
+        size = available;
+    }
+
+    memcpy(buffer, &m_rxBuffer[m_rxPos], size);
+    m_rxPos += size;
+
+    return static_cast<int>(size);
+}
+
+int EthernetUDP::peek(void)
+{
+    return (m_rxPos < m_rxLen) ? m_rxBuffer[m_rxPos] : -1;
+}
+
+void EthernetUDP::flush(void)
+{
+    m_rxPos = m_rxLen;
+}
+
+IPAddress EthernetUDP::remoteIP(void)
+{
+    return m_rxIp;
+}
+
+uint16_t EthernetUDP::remotePort(void)
+{
+    return m_rxPort;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool EthernetUDP::open(void)
+{
+    if (0 > m_fd)
+    {
+        m_fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    }
+
+    return 0 <= m_fd;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,127 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  EthernetENC UDP for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __ETHERNET_UDP_H__
+#define __ETHERNET_UDP_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Udp.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * UDP socket, based on a datagram socket of the host.
+ */
+class EthernetUDP : public UDP
+{
+public:
+
+    /**
+     * Constructs the UDP socket.
+     */
+    EthernetUDP();
+
+    /**
+     * Destroys the UDP socket.
+     */
+    virtual ~EthernetUDP();
+
+    uint8_t begin(uint16_t port) override;
+    void stop(void) override;
+
+    int beginPacket(IPAddress ip, uint16_t port) override;
+    int beginPacket(const char* host, uint16_t port) override;
+    int endPacket(void) override;
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    int parsePacket(void) override;
+    int available(void) override;
+    int read(void) override;
+    int read(unsigned char* buffer, size_t size) override;
+    int peek(void) override;
+    void flush(void) override;
+    IPAddress remoteIP(void) override;
+    uint16_t remotePort(void) override;
+
+    using Print::write;
+    using UDP::read;
+
+    /** Max. datagram size, like the ethernet MTU. */
+    static const size_t BUFFER_SIZE = 1472U;
+
+private:
+
+    int         m_fd;                   /**< Socket file descriptor */
+    IPAddress   m_txIp;                 /**< Destination address of the datagram, which is written */
+    uint16_t    m_txPort;               /**< Destination port of the datagram, which is written */
+    size_t      m_txLen;                /**< Size of the datagram, which is written */
+    uint8_t     m_txBuffer[BUFFER_SIZE];/**< Datagram, which is written */
+    IPAddress   m_rxIp;                 /**< Source address of the received datagram */
+    uint16_t    m_rxPort;               /**< Source port of the received datagram */
+    size_t      m_rxLen;                /**< Size of the received datagram */
+    size_t      m_rxPos;                /**< Read position in the received datagram */
+    uint8_t     m_rxBuffer[BUFFER_SIZE];/**< Received datagram */
+
+    /**
+     * Create the socket, if not already done.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool open(void);
+
+    EthernetUDP(const EthernetUDP& udp);
+    EthernetUDP& operator=(const EthernetUDP& udp);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __ETHERNET_UDP_H__ */
+
+/** @} */
@@ -0,0 +1,184 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino serial interface for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The serial output is written to stdout. There is no serial input.
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __HARDWARE_SERIAL_H__
+#define __HARDWARE_SERIAL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Stream.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Serial interface, which writes to stdout.
+ */
+class HardwareSerial : public Stream
+{
+public:
+
+    /**
+     * Constructs the serial interface.
+     */
+    HardwareSerial() :
+        Stream()
+    {
+    }
+
+    /**
+     * Destroys the serial interface.
+     */
+    ~HardwareSerial()
+    {
+    }
+
+    /**
+     * Initialize the serial interface. The baudrate is not relevant.
+     *
+     * @param[in] baudrate  Baudrate
+     */
+    void begin(unsigned long baudrate);
+
+    /**
+     * Stop the serial interface.
+     */
+    void end(void)
+    {
+    }
+
+    /**
+     * Get number of bytes, which can be read without waiting.
+     *
+     * @return Number of bytes, which is always 0.
+     */
+    int available(void) override
+    {
+        return 0;
+    }
+
+    /**
+     * Read a single byte.
+     *
+     * @return Always -1, because there is no serial input.
+     */
+    int read(void) override
+    {
+        return -1;
+    }
+
+    /**
+     * Get the next byte, without removing it from the stream.
+     *
+     * @return Always -1, because there is no serial input.
+     */
+    int peek(void) override
+    {
+        return -1;
+    }
+
+    /**
+     * Get the number of bytes, which can be written without blocking.
+     * Writing to stdout never blocks the firmware noticeably.
+     *
+     * @return Number of bytes
+     */
+    int availableForWrite(void) override
+    {
+        return TX_BUFFER_SIZE;
+    }
+
+    /**
+     * Write a single byte to stdout.
+     *
+     * @param[in] data  Data byte
+     *
+     * @return Number of written bytes.
+     */
+    size_t write(uint8_t data) override;
+
+    /**
+     * Write several bytes to stdout.
+     *
+     * @param[in] buffer    Data buffer
+     * @param[in] size      Data buffer size
+     *
+     * @return Number of written bytes.
+     */
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    using Print::write;
+
+    /**
+     * Flush stdout.
+     */
+    void flush(void) override;
+
+    /**
+     * Is the serial interface ready?
+     *
+     * @return Always true
+     */
+    operator bool() const
+    {
+        return true;
+    }
+
+    /** Size of the transmit buffer of the AVR core, which is emulated. */
+    static const int    TX_BUFFER_SIZE  = 64;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/** Serial interface */
+extern HardwareSerial Serial;
+
+#endif  /* __HARDWARE_SERIAL_H__ */
+
+/** @} */
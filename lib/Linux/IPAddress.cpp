@@ -0,0 +1,146 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino IPv4 address for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IPAddress.h"
+#include "Print.h"
+
+#include <stdio.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool IPAddress::fromString(const char* str)
+{
+    uint8_t     addr[4];
+    uint8_t     idx     = 0U;
+    uint16_t    value   = 0U;
+    uint8_t     digits  = 0U;
+
+    if (nullptr == str)
+    {
+        return false;
+    }
+
+    while(true)
+    {
+        if (('0' <= *str) && ('9' >= *str))
+        {
+            value = value * 10U + static_cast<uint16_t>(*str - '0');
+            ++digits;
+
+            if ((3U < digits) || (255U < value))
+            {
+                return false;
+            }
+        }
+        else if ((('.' == *str) || ('\0' == *str)) && (0U < digits) && (4U > idx))
+        {
+            addr[idx] = static_cast<uint8_t>(value);
+            ++idx;
+            value   = 0U;
+            digits  = 0U;
+
+            if ('\0' == *str)
+            {
+                break;
+            }
+        }
+        else
+        {
+            return false;
+        }
+
+        ++str;
+    }
+
+    if (4U != idx)
+    {
+        return false;
+    }
+
+    memcpy(m_addr, addr, sizeof(m_addr));
+
+    return true;
+}
+
+String IPAddress::toString(void) const
+{
+    char buffer[16U];
+
+    (void)snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", m_addr[0], m_addr[1], m_addr[2], m_addr[3]);
+
+    return String(buffer);
+}
+
+size_t IPAddress::printTo(Print& p) const
+{
+    return p.print(toString());
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
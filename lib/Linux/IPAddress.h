@@ -0,0 +1,197 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino IPv4 address for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __IP_ADDRESS_H__
+#define __IP_ADDRESS_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <string.h>
+
+#include "Printable.h"
+#include "WString.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * IPv4 address in network byte order.
+ */
+class IPAddress : public Printable
+{
+public:
+
+    /**
+     * Constructs the address 0.0.0.0.
+     */
+    IPAddress() :
+        Printable()
+    {
+        memset(m_addr, 0, sizeof(m_addr));
+    }
+
+    /**
+     * Constructs a address from its octets.
+     *
+     * @param[in] octet1    First octet
+     * @param[in] octet2    Second octet
+     * @param[in] octet3    Third octet
+     * @param[in] octet4    Fourth octet
+     */
+    IPAddress(uint8_t octet1, uint8_t octet2, uint8_t octet3, uint8_t octet4) :
+        Printable()
+    {
+        m_addr[0] = octet1;
+        m_addr[1] = octet2;
+        m_addr[2] = octet3;
+        m_addr[3] = octet4;
+    }
+
+    /**
+     * Constructs a address from a 32-bit value in network byte order.
+     *
+     * @param[in] addr  Address
+     */
+    IPAddress(uint32_t addr) :
+        Printable()
+    {
+        memcpy(m_addr, &addr, sizeof(m_addr));
+    }
+
+    /**
+     * Constructs a address from its octets.
+     *
+     * @param[in] addr  Four octets
+     */
+    IPAddress(const uint8_t* addr) :
+        Printable()
+    {
+        memcpy(m_addr, addr, sizeof(m_addr));
+    }
+
+    /**
+     * Get the address as 32-bit value in network byte order.
+     *
+     * @return Address
+     */
+    operator uint32_t() const
+    {
+        uint32_t addr = 0U;
+
+        memcpy(&addr, m_addr, sizeof(addr));
+
+        return addr;
+    }
+
+    bool operator==(const IPAddress& addr) const
+    {
+        return 0 == memcmp(m_addr, addr.m_addr, sizeof(m_addr));
+    }
+
+    bool operator!=(const IPAddress& addr) const
+    {
+        return !operator==(addr);
+    }
+
+    uint8_t operator[](int index) const
+    {
+        return m_addr[index];
+    }
+
+    uint8_t& operator[](int index)
+    {
+        return m_addr[index];
+    }
+
+    /**
+     * Parse a address in dotted decimal notation.
+     *
+     * @param[in] str   Address string
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool fromString(const char* str);
+
+    /**
+     * Parse a address in dotted decimal notation.
+     *
+     * @param[in] str   Address string
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool fromString(const String& str)
+    {
+        return fromString(str.c_str());
+    }
+
+    /**
+     * Get the address in dotted decimal notation.
+     *
+     * @return Address string
+     */
+    String toString(void) const;
+
+    /**
+     * Print the address in dotted decimal notation.
+     *
+     * @param[in] p Output
+     *
+     * @return Number of written characters.
+     */
+    size_t printTo(Print& p) const override;
+
+private:
+
+    uint8_t m_addr[4];  /**< Octets */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __IP_ADDRESS_H__ */
+
+/** @} */
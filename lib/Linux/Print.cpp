@@ -0,0 +1,287 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino Print for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Print.h"
+
+#include <stdio.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+    size_t written = 0U;
+
+    while(written < size)
+    {
+        if (0U == write(buffer[written]))
+        {
+            break;
+        }
+
+        ++written;
+    }
+
+    return written;
+}
+
+size_t Print::print(const __FlashStringHelper* str)
+{
+    return write(reinterpret_cast<const char*>(str));
+}
+
+size_t Print::print(const String& str)
+{
+    return write(str.c_str(), str.length());
+}
+
+size_t Print::print(const char str[])
+{
+    return write(str);
+}
+
+size_t Print::print(char c)
+{
+    return write(static_cast<uint8_t>(c));
+}
+
+size_t Print::print(unsigned char value, int base)
+{
+    return print(static_cast<unsigned long>(value), base);
+}
+
+size_t Print::print(int value, int base)
+{
+    return print(static_cast<long>(value), base);
+}
+
+size_t Print::print(unsigned int value, int base)
+{
+    return print(static_cast<unsigned long>(value), base);
+}
+
+size_t Print::print(long value, int base)
+{
+    size_t written = 0U;
+
+    if (0 == base)
+    {
+        written = write(static_cast<uint8_t>(value));
+    }
+    else if ((10 == base) && (0 > value))
+    {
+        written  = print('-');
+        written += printNumber(0UL - static_cast<unsigned long>(value), 10U);
+    }
+    else
+    {
+        written = printNumber(static_cast<unsigned long>(value), static_cast<uint8_t>(base));
+    }
+
+    return written;
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+    size_t written = 0U;
+
+    if (0 == base)
+    {
+        written = write(static_cast<uint8_t>(value));
+    }
+    else
+    {
+        written = printNumber(value, static_cast<uint8_t>(base));
+    }
+
+    return written;
+}
+
+size_t Print::print(double value, int digits)
+{
+    char buffer[64U];
+
+    (void)snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+
+    return write(buffer);
+}
+
+size_t Print::print(const Printable& obj)
+{
+    return obj.printTo(*this);
+}
+
+size_t Print::println(const __FlashStringHelper* str)
+{
+    size_t written = print(str);
+
+    return written + println();
+}
+
+size_t Print::println(const String& str)
+{
+    size_t written = print(str);
+
+    return written + println();
+}
+
+size_t Print::println(const char str[])
+{
+    size_t written = print(str);
+
+    return written + println();
+}
+
+size_t Print::println(char c)
+{
+    size_t written = print(c);
+
+    return written + println();
+}
+
+size_t Print::println(unsigned char value, int base)
+{
+    size_t written = print(value, base);
+
+    return written + println();
+}
+
+size_t Print::println(int value, int base)
+{
+    size_t written = print(value, base);
+
+    return written + println();
+}
+
+size_t Print::println(unsigned int value, int base)
+{
+    size_t written = print(value, base);
+
+    return written + println();
+}
+
+size_t Print::println(long value, int base)
+{
+    size_t written = print(value, base);
+
+    return written + println();
+}
+
+size_t Print::println(unsigned long value, int base)
+{
+    size_t written = print(value, base);
+
+    return written + println();
+}
+
+size_t Print::println(double value, int digits)
+{
+    size_t written = print(value, digits);
+
+    return written + println();
+}
+
+size_t Print::println(const Printable& obj)
+{
+    size_t written = print(obj);
+
+    return written + println();
+}
+
+size_t Print::println(void)
+{
+    return write("\r\n");
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+size_t Print::printNumber(unsigned long value, uint8_t base)
+{
+    char    buffer[8U * sizeof(unsigned long) + 1U];
+    char*   ptr     = &buffer[sizeof(buffer) - 1U];
+
+    if (2U > base)
+    {
+        base = 10U;
+    }
+
+    *ptr = '\0';
+
+    do
+    {
+        unsigned long digit = value % base;
+
+        --ptr;
+        *ptr    = static_cast<char>((10U > digit) ? ('0' + digit) : ('A' + digit - 10U));
+        value  /= base;
+    }
+    while(0U < value);
+
+    return write(ptr);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,232 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino Print for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __PRINT_H__
+#define __PRINT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "WString.h"
+#include "Printable.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Decimal number base */
+#define DEC (10)
+
+/** Hexadecimal number base */
+#define HEX (16)
+
+/** Octal number base */
+#define OCT (8)
+
+/** Binary number base */
+#define BIN (2)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Base class of all character outputs, like the Arduino one.
+ */
+class Print
+{
+public:
+
+    /**
+     * Constructs a print object.
+     */
+    Print() :
+        m_writeError(0)
+    {
+    }
+
+    /**
+     * Destroys a print object.
+     */
+    virtual ~Print()
+    {
+    }
+
+    /**
+     * Get the last write error.
+     *
+     * @return Write error, 0 means no error.
+     */
+    int getWriteError(void) const
+    {
+        return m_writeError;
+    }
+
+    /**
+     * Clear the last write error.
+     */
+    void clearWriteError(void)
+    {
+        m_writeError = 0;
+    }
+
+    /**
+     * Write a single byte to the output.
+     *
+     * @param[in] data  Data byte
+     *
+     * @return Number of written data bytes.
+     */
+    virtual size_t write(uint8_t data) = 0;
+
+    /**
+     * Write several data bytes to the output.
+     *
+     * @param[in] buffer    Data buffer
+     * @param[in] size      Data buffer size
+     *
+     * @return Number of written data bytes.
+     */
+    virtual size_t write(const uint8_t* buffer, size_t size);
+
+    /**
+     * Write a C-string to the output.
+     *
+     * @param[in] str   C-string
+     *
+     * @return Number of written characters.
+     */
+    size_t write(const char* str)
+    {
+        return (nullptr == str) ? 0U : write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+    }
+
+    /**
+     * Write several characters to the output.
+     *
+     * @param[in] buffer    Character buffer
+     * @param[in] size      Character buffer size
+     *
+     * @return Number of written characters.
+     */
+    size_t write(const char* buffer, size_t size)
+    {
+        return write(reinterpret_cast<const uint8_t*>(buffer), size);
+    }
+
+    /**
+     * Get the number of bytes, which can be written without blocking.
+     *
+     * @return Number of bytes
+     */
+    virtual int availableForWrite(void)
+    {
+        return 0;
+    }
+
+    /**
+     * Wait until all written bytes are sent.
+     */
+    virtual void flush(void)
+    {
+    }
+
+    size_t print(const __FlashStringHelper* str);
+    size_t print(const String& str);
+    size_t print(const char str[]);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+    size_t print(const Printable& obj);
+
+    size_t println(const __FlashStringHelper* str);
+    size_t println(const String& str);
+    size_t println(const char str[]);
+    size_t println(char c);
+    size_t println(unsigned char value, int base = DEC);
+    size_t println(int value, int base = DEC);
+    size_t println(unsigned int value, int base = DEC);
+    size_t println(long value, int base = DEC);
+    size_t println(unsigned long value, int base = DEC);
+    size_t println(double value, int digits = 2);
+    size_t println(const Printable& obj);
+    size_t println(void);
+
+protected:
+
+    /**
+     * Set the write error.
+     *
+     * @param[in] err   Write error
+     */
+    void setWriteError(int err = 1)
+    {
+        m_writeError = err;
+    }
+
+private:
+
+    int m_writeError;   /**< Last write error */
+
+    /**
+     * Print a unsigned number.
+     *
+     * @param[in] value Number
+     * @param[in] base  Number base
+     *
+     * @return Number of written characters.
+     */
+    size_t printNumber(unsigned long value, uint8_t base);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PRINT_H__ */
+
+/** @} */
@@ -1,6 +1,6 @@
 /* MIT License
  *
- * Copyright (c) 2020 - 2024 Andreas Merkle <web@blue-andi.de>
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -25,23 +25,25 @@
     DESCRIPTION
 *******************************************************************************/
 /**
- * @brief  Main test entry point
+ * @brief  Arduino SPI for Linux
  * @author Andreas Merkle <web@blue-andi.de>
  */
 
 /******************************************************************************
  * Includes
  *****************************************************************************/
-#include <unity.h>
-#include <stdio.h>
-#include <stdlib.h>
+#include "SPI.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
 
 /******************************************************************************
  * Macros
  *****************************************************************************/
 
 /******************************************************************************
- * Types and Classes
+ * Types and classes
  *****************************************************************************/
 
 /******************************************************************************
@@ -49,47 +51,27 @@
  *****************************************************************************/
 
 /******************************************************************************
- * Variables
+ * Local Variables
  *****************************************************************************/
 
 /******************************************************************************
- * External functions
+ * Public Methods
  *****************************************************************************/
 
-/**
- * Main entry point
- *
- * @param[in] argc  Number of command line arguments
- * @param[in] argv  Command line arguments
- */
-extern int main(int argc, char **argv)
-{
-    (void)argc;
-    (void)argv;
-
-    UNITY_BEGIN();
-
-    //RUN_TEST(...);
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
 
-    return UNITY_END();
-}
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
 
-/**
- * Setup a test. This function will be called before every test by unity.
- */
-extern void setUp(void)
-{
-    /* Not used. */
-}
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
 
-/**
- * Clean up test. This function will be called after every test by unity.
- */
-extern void tearDown(void)
-{
-    /* Not used. */
-}
+SPIClass SPI;
 
 /******************************************************************************
- * Local functions
+ * Local Functions
  *****************************************************************************/
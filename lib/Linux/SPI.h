@@ -0,0 +1,153 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino SPI for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The ethernet controller is replaced by the sockets of the host, see
+ * EthernetENC.h. Therefore there is no SPI device.
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __SPI_H__
+#define __SPI_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Chip select pin of the ethernet controller */
+#define SS          (4)
+
+#define MSBFIRST    (1)
+#define LSBFIRST    (0)
+
+#define SPI_MODE0   (0x00)
+#define SPI_MODE1   (0x04)
+#define SPI_MODE2   (0x08)
+#define SPI_MODE3   (0x0C)
+
+/**
+ * SPI settings
+ */
+class SPISettings
+{
+public:
+
+    /**
+     * Constructs the SPI settings.
+     *
+     * @param[in] clock     Clock frequency in Hz
+     * @param[in] bitOrder  Bit order
+     * @param[in] dataMode  Data mode
+     */
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+    {
+        (void)clock;
+        (void)bitOrder;
+        (void)dataMode;
+    }
+};
+
+/**
+ * SPI bus without any device. Every transfer reads 0.
+ */
+class SPIClass
+{
+public:
+
+    /**
+     * Initialize the SPI bus.
+     */
+    void begin(void)
+    {
+    }
+
+    /**
+     * Release the SPI bus.
+     */
+    void end(void)
+    {
+    }
+
+    /**
+     * Start a transaction.
+     *
+     * @param[in] settings  SPI settings
+     */
+    void beginTransaction(const SPISettings& settings)
+    {
+        (void)settings;
+    }
+
+    /**
+     * Stop a transaction.
+     */
+    void endTransaction(void)
+    {
+    }
+
+    /**
+     * Transfer a single byte.
+     *
+     * @param[in] data  Byte to send
+     *
+     * @return Received byte, which is always 0.
+     */
+    uint8_t transfer(uint8_t data)
+    {
+        (void)data;
+        return 0U;
+    }
+};
+
+/** SPI bus */
+extern SPIClass SPI;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SPI_H__ */
+
+/** @} */
@@ -0,0 +1,320 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino Stream for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Arduino.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool Stream::find(const char* target)
+{
+    return find(target, strlen(target));
+}
+
+bool Stream::find(const char* target, size_t length)
+{
+    size_t  matched = 0U;
+    int     c       = -1;
+
+    if (0U == length)
+    {
+        return true;
+    }
+
+    while(0 <= (c = timedRead()))
+    {
+        if (target[matched] == static_cast<char>(c))
+        {
+            ++matched;
+
+            if (length == matched)
+            {
+                return true;
+            }
+        }
+        else
+        {
+            matched = (target[0] == static_cast<char>(c)) ? 1U : 0U;
+        }
+    }
+
+    return false;
+}
+
+bool Stream::find(char target)
+{
+    return find(&target, 1U);
+}
+
+bool Stream::findUntil(const char* target, const char* terminator)
+{
+    size_t  targetLen   = strlen(target);
+    size_t  termLen     = strlen(terminator);
+    size_t  targetIdx   = 0U;
+    size_t  termIdx     = 0U;
+    int     c           = -1;
+
+    while(0 <= (c = timedRead()))
+    {
+        targetIdx = (target[targetIdx] == static_cast<char>(c)) ? (targetIdx + 1U) : 0U;
+        termIdx   = ((0U < termLen) && (terminator[termIdx] == static_cast<char>(c))) ? (termIdx + 1U) : 0U;
+
+        if (targetLen == targetIdx)
+        {
+            return true;
+        }
+
+        if ((0U < termLen) && (termLen == termIdx))
+        {
+            break;
+        }
+    }
+
+    return false;
+}
+
+long Stream::parseInt(void)
+{
+    bool    isNegative  = false;
+    long    value       = 0;
+    int     c           = peekNextDigit();
+
+    if (0 > c)
+    {
+        return 0;
+    }
+
+    do
+    {
+        if ('-' == c)
+        {
+            isNegative = true;
+        }
+        else
+        {
+            value = value * 10 + (c - '0');
+        }
+
+        (void)read();
+        c = timedPeek();
+    }
+    while(('0' <= c) && ('9' >= c));
+
+    return (true == isNegative) ? -value : value;
+}
+
+float Stream::parseFloat(void)
+{
+    String  str;
+    int     c   = peekNextDigit();
+
+    while((0 <= c) && ((('0' <= c) && ('9' >= c)) || ('-' == c) || ('.' == c)))
+    {
+        str += static_cast<char>(c);
+        (void)read();
+        c = timedPeek();
+    }
+
+    return str.toFloat();
+}
+
+size_t Stream::readBytes(char* buffer, size_t length)
+{
+    size_t  count   = 0U;
+
+    while(count < length)
+    {
+        int c = timedRead();
+
+        if (0 > c)
+        {
+            break;
+        }
+
+        buffer[count] = static_cast<char>(c);
+        ++count;
+    }
+
+    return count;
+}
+
+size_t Stream::readBytes(uint8_t* buffer, size_t length)
+{
+    return readBytes(reinterpret_cast<char*>(buffer), length);
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length)
+{
+    size_t  count   = 0U;
+
+    while(count < length)
+    {
+        int c = timedRead();
+
+        if ((0 > c) || (terminator == static_cast<char>(c)))
+        {
+            break;
+        }
+
+        buffer[count] = static_cast<char>(c);
+        ++count;
+    }
+
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, uint8_t* buffer, size_t length)
+{
+    return readBytesUntil(terminator, reinterpret_cast<char*>(buffer), length);
+}
+
+String Stream::readString(void)
+{
+    String  str;
+    int     c   = timedRead();
+
+    while(0 <= c)
+    {
+        str += static_cast<char>(c);
+        c = timedRead();
+    }
+
+    return str;
+}
+
+String Stream::readStringUntil(char terminator)
+{
+    String  str;
+    int     c   = timedRead();
+
+    while((0 <= c) && (terminator != static_cast<char>(c)))
+    {
+        str += static_cast<char>(c);
+        c = timedRead();
+    }
+
+    return str;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+int Stream::timedRead(void)
+{
+    uint32_t        startTime   = millis();
+    int             c           = -1;
+
+    do
+    {
+        c = read();
+
+        if (0 <= c)
+        {
+            break;
+        }
+
+        yield();
+    }
+    while((static_cast<uint32_t>(millis()) - startTime) < m_timeout);
+
+    return c;
+}
+
+int Stream::timedPeek(void)
+{
+    uint32_t        startTime   = millis();
+    int             c           = -1;
+
+    do
+    {
+        c = peek();
+
+        if (0 <= c)
+        {
+            break;
+        }
+
+        yield();
+    }
+    while((static_cast<uint32_t>(millis()) - startTime) < m_timeout);
+
+    return c;
+}
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+int Stream::peekNextDigit(void)
+{
+    int c = timedPeek();
+
+    while((0 <= c) && ('-' != c) && (('0' > c) || ('9' < c)))
+    {
+        (void)read();
+        c = timedPeek();
+    }
+
+    return c;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
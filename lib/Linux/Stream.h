@@ -0,0 +1,171 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino Stream for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __STREAM_H__
+#define __STREAM_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Print.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Base class of all character inputs, like the Arduino one.
+ * The timed functions wait up to the timeout for the next character.
+ */
+class Stream : public Print
+{
+public:
+
+    /**
+     * Constructs a stream with the default timeout of 1 s.
+     */
+    Stream() :
+        Print(),
+        m_timeout(1000UL)
+    {
+    }
+
+    /**
+     * Destroys the stream.
+     */
+    virtual ~Stream()
+    {
+    }
+
+    /**
+     * Get number of bytes, which can be read without waiting.
+     *
+     * @return Number of bytes
+     */
+    virtual int available(void) = 0;
+
+    /**
+     * Read a single byte.
+     *
+     * @return Data byte or -1 if none is available.
+     */
+    virtual int read(void) = 0;
+
+    /**
+     * Get the next byte, without removing it from the stream.
+     *
+     * @return Data byte or -1 if none is available.
+     */
+    virtual int peek(void) = 0;
+
+    /**
+     * Set the timeout of the timed functions.
+     *
+     * @param[in] timeout   Timeout in ms
+     */
+    void setTimeout(unsigned long timeout)
+    {
+        m_timeout = timeout;
+    }
+
+    /**
+     * Get the timeout of the timed functions.
+     *
+     * @return Timeout in ms
+     */
+    unsigned long getTimeout(void) const
+    {
+        return m_timeout;
+    }
+
+    bool find(const char* target);
+    bool find(const char* target, size_t length);
+    bool find(char target);
+    bool findUntil(const char* target, const char* terminator);
+    long parseInt(void);
+    float parseFloat(void);
+    size_t readBytes(char* buffer, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length);
+    size_t readBytesUntil(char terminator, char* buffer, size_t length);
+    size_t readBytesUntil(char terminator, uint8_t* buffer, size_t length);
+    String readString(void);
+    String readStringUntil(char terminator);
+
+protected:
+
+    /**
+     * Read a single byte and wait up to the timeout for it.
+     *
+     * @return Data byte or -1 in case of a timeout.
+     */
+    int timedRead(void);
+
+    /**
+     * Get the next byte and wait up to the timeout for it.
+     *
+     * @return Data byte or -1 in case of a timeout.
+     */
+    int timedPeek(void);
+
+private:
+
+    unsigned long   m_timeout;  /**< Timeout in ms of the timed functions */
+
+    /**
+     * Skip all characters, which can't be part of a number.
+     *
+     * @return Next character or -1 in case of a timeout.
+     */
+    int peekNextDigit(void);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __STREAM_H__ */
+
+/** @} */
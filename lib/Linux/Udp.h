@@ -0,0 +1,152 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino UDP interface for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __UDP_H__
+#define __UDP_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Stream.h"
+#include "IPAddress.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Interface of a UDP socket, like the Arduino one.
+ */
+class UDP : public Stream
+{
+public:
+
+    /**
+     * Destroys the UDP socket.
+     */
+    virtual ~UDP()
+    {
+    }
+
+    /**
+     * Start listening on a local port.
+     *
+     * @param[in] port  Local port
+     *
+     * @return If successful, it will return 1 otherwise 0.
+     */
+    virtual uint8_t begin(uint16_t port) = 0;
+
+    /**
+     * Stop listening and release all resources.
+     */
+    virtual void stop(void) = 0;
+
+    /**
+     * Start a datagram to a remote address.
+     *
+     * @param[in] ip    Remote address
+     * @param[in] port  Remote port
+     *
+     * @return If successful, it will return 1 otherwise 0.
+     */
+    virtual int beginPacket(IPAddress ip, uint16_t port) = 0;
+
+    /**
+     * Start a datagram to a remote host.
+     *
+     * @param[in] host  Remote host name
+     * @param[in] port  Remote port
+     *
+     * @return If successful, it will return 1 otherwise 0.
+     */
+    virtual int beginPacket(const char* host, uint16_t port) = 0;
+
+    /**
+     * Send the datagram.
+     *
+     * @return If successful, it will return 1 otherwise 0.
+     */
+    virtual int endPacket(void) = 0;
+
+    /**
+     * Start processing the next received datagram.
+     *
+     * @return Size of the datagram in bytes or 0 if none is available.
+     */
+    virtual int parsePacket(void) = 0;
+
+    /**
+     * Read several bytes of the current datagram.
+     *
+     * @param[out]  buffer  Data buffer
+     * @param[in]   size    Data buffer size
+     *
+     * @return Number of read bytes
+     */
+    virtual int read(unsigned char* buffer, size_t size) = 0;
+
+    /**
+     * Get the remote address of the current datagram.
+     *
+     * @return Remote address
+     */
+    virtual IPAddress remoteIP(void) = 0;
+
+    /**
+     * Get the remote port of the current datagram.
+     *
+     * @return Remote port
+     */
+    virtual uint16_t remotePort(void) = 0;
+
+    using Stream::read;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __UDP_H__ */
+
+/** @} */
@@ -0,0 +1,650 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino String for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WString.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static std::string unsignedToStr(unsigned long value, unsigned char base);
+static std::string signedToStr(long value, unsigned char base);
+static std::string floatToStr(double value, unsigned char decimalPlaces);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+String::String(unsigned char value, unsigned char base) :
+    m_str(unsignedToStr(value, base))
+{
+}
+
+String::String(int value, unsigned char base) :
+    m_str(signedToStr(value, base))
+{
+}
+
+String::String(unsigned int value, unsigned char base) :
+    m_str(unsignedToStr(value, base))
+{
+}
+
+String::String(long value, unsigned char base) :
+    m_str(signedToStr(value, base))
+{
+}
+
+String::String(unsigned long value, unsigned char base) :
+    m_str(unsignedToStr(value, base))
+{
+}
+
+String::String(float value, unsigned char decimalPlaces) :
+    m_str(floatToStr(value, decimalPlaces))
+{
+}
+
+String::String(double value, unsigned char decimalPlaces) :
+    m_str(floatToStr(value, decimalPlaces))
+{
+}
+
+bool String::concat(const String& str)
+{
+    m_str += str.m_str;
+    return true;
+}
+
+bool String::concat(const char* str)
+{
+    if (nullptr == str)
+    {
+        return false;
+    }
+
+    m_str += str;
+    return true;
+}
+
+bool String::concat(const char* str, unsigned int length)
+{
+    if (nullptr == str)
+    {
+        return false;
+    }
+
+    m_str.append(str, length);
+    return true;
+}
+
+bool String::concat(const __FlashStringHelper* str)
+{
+    return concat(reinterpret_cast<const char*>(str));
+}
+
+bool String::concat(char c)
+{
+    m_str += c;
+    return true;
+}
+
+bool String::concat(unsigned char value)
+{
+    m_str += unsignedToStr(value, 10U);
+    return true;
+}
+
+bool String::concat(int value)
+{
+    m_str += signedToStr(value, 10U);
+    return true;
+}
+
+bool String::concat(unsigned int value)
+{
+    m_str += unsignedToStr(value, 10U);
+    return true;
+}
+
+bool String::concat(long value)
+{
+    m_str += signedToStr(value, 10U);
+    return true;
+}
+
+bool String::concat(unsigned long value)
+{
+    m_str += unsignedToStr(value, 10U);
+    return true;
+}
+
+bool String::concat(float value)
+{
+    m_str += floatToStr(value, 2U);
+    return true;
+}
+
+bool String::concat(double value)
+{
+    m_str += floatToStr(value, 2U);
+    return true;
+}
+
+int String::compareTo(const String& str) const
+{
+    return m_str.compare(str.m_str);
+}
+
+bool String::equals(const String& str) const
+{
+    return m_str == str.m_str;
+}
+
+bool String::equals(const char* str) const
+{
+    return m_str == ((nullptr == str) ? "" : str);
+}
+
+bool String::equalsIgnoreCase(const String& str) const
+{
+    return (m_str.length() == str.m_str.length()) &&
+           (0 == strcasecmp(m_str.c_str(), str.m_str.c_str()));
+}
+
+bool String::startsWith(const String& prefix) const
+{
+    return startsWith(prefix, 0U);
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const
+{
+    return (m_str.length() >= (offset + prefix.m_str.length())) &&
+           (0 == m_str.compare(offset, prefix.m_str.length(), prefix.m_str));
+}
+
+bool String::endsWith(const String& suffix) const
+{
+    return (m_str.length() >= suffix.m_str.length()) &&
+           (0 == m_str.compare(m_str.length() - suffix.m_str.length(), suffix.m_str.length(), suffix.m_str));
+}
+
+char String::charAt(unsigned int index) const
+{
+    return operator[](index);
+}
+
+void String::setCharAt(unsigned int index, char c)
+{
+    if (m_str.length() > index)
+    {
+        m_str[index] = c;
+    }
+}
+
+char String::operator[](unsigned int index) const
+{
+    return (m_str.length() > index) ? m_str[index] : '\0';
+}
+
+char& String::operator[](unsigned int index)
+{
+    static char dummy = '\0';
+
+    if (m_str.length() <= index)
+    {
+        dummy = '\0';
+        return dummy;
+    }
+
+    return m_str[index];
+}
+
+void String::getBytes(unsigned char* buffer, unsigned int size, unsigned int index) const
+{
+    toCharArray(reinterpret_cast<char*>(buffer), size, index);
+}
+
+void String::toCharArray(char* buffer, unsigned int size, unsigned int index) const
+{
+    size_t len = 0U;
+
+    if ((nullptr == buffer) || (0U == size))
+    {
+        return;
+    }
+
+    if (m_str.length() > index)
+    {
+        len = m_str.copy(buffer, size - 1U, index);
+    }
+
+    buffer[len] = '\0';
+}
+
+int String::indexOf(char c) const
+{
+    return indexOf(c, 0U);
+}
+
+int String::indexOf(char c, unsigned int fromIndex) const
+{
+    size_t pos = m_str.find(c, fromIndex);
+
+    return (std::string::npos == pos) ? -1 : static_cast<int>(pos);
+}
+
+int String::indexOf(const String& str) const
+{
+    return indexOf(str, 0U);
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const
+{
+    size_t pos = m_str.find(str.m_str, fromIndex);
+
+    return (std::string::npos == pos) ? -1 : static_cast<int>(pos);
+}
+
+int String::lastIndexOf(char c) const
+{
+    size_t pos = m_str.rfind(c);
+
+    return (std::string::npos == pos) ? -1 : static_cast<int>(pos);
+}
+
+int String::lastIndexOf(char c, unsigned int fromIndex) const
+{
+    size_t pos = m_str.rfind(c, fromIndex);
+
+    return (std::string::npos == pos) ? -1 : static_cast<int>(pos);
+}
+
+int String::lastIndexOf(const String& str) const
+{
+    size_t pos = m_str.rfind(str.m_str);
+
+    return (std::string::npos == pos) ? -1 : static_cast<int>(pos);
+}
+
+int String::lastIndexOf(const String& str, unsigned int fromIndex) const
+{
+    size_t pos = m_str.rfind(str.m_str, fromIndex);
+
+    return (std::string::npos == pos) ? -1 : static_cast<int>(pos);
+}
+
+String String::substring(unsigned int beginIndex) const
+{
+    return substring(beginIndex, length());
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const
+{
+    String str;
+
+    /* Like the Arduino implementation, the indices may be swapped. */
+    if (beginIndex > endIndex)
+    {
+        unsigned int tmp = beginIndex;
+
+        beginIndex  = endIndex;
+        endIndex    = tmp;
+    }
+
+    if (m_str.length() < endIndex)
+    {
+        endIndex = length();
+    }
+
+    if (beginIndex < endIndex)
+    {
+        str.m_str = m_str.substr(beginIndex, endIndex - beginIndex);
+    }
+
+    return str;
+}
+
+void String::replace(char find, char replace)
+{
+    size_t idx = 0U;
+
+    for(idx = 0U; idx < m_str.length(); ++idx)
+    {
+        if (find == m_str[idx])
+        {
+            m_str[idx] = replace;
+        }
+    }
+}
+
+void String::replace(const String& find, const String& replace)
+{
+    size_t pos = 0U;
+
+    if (true == find.m_str.empty())
+    {
+        return;
+    }
+
+    while(std::string::npos != (pos = m_str.find(find.m_str, pos)))
+    {
+        m_str.replace(pos, find.m_str.length(), replace.m_str);
+        pos += replace.m_str.length();
+    }
+}
+
+void String::remove(unsigned int index)
+{
+    if (m_str.length() > index)
+    {
+        m_str.erase(index);
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+    if (m_str.length() > index)
+    {
+        m_str.erase(index, count);
+    }
+}
+
+void String::toLowerCase(void)
+{
+    size_t idx = 0U;
+
+    for(idx = 0U; idx < m_str.length(); ++idx)
+    {
+        m_str[idx] = static_cast<char>(tolower(static_cast<unsigned char>(m_str[idx])));
+    }
+}
+
+void String::toUpperCase(void)
+{
+    size_t idx = 0U;
+
+    for(idx = 0U; idx < m_str.length(); ++idx)
+    {
+        m_str[idx] = static_cast<char>(toupper(static_cast<unsigned char>(m_str[idx])));
+    }
+}
+
+void String::trim(void)
+{
+    size_t begin    = 0U;
+    size_t end      = m_str.length();
+
+    while((begin < end) && (0 != isspace(static_cast<unsigned char>(m_str[begin]))))
+    {
+        ++begin;
+    }
+
+    while((end > begin) && (0 != isspace(static_cast<unsigned char>(m_str[end - 1U]))))
+    {
+        --end;
+    }
+
+    m_str = m_str.substr(begin, end - begin);
+}
+
+long String::toInt(void) const
+{
+    return strtol(m_str.c_str(), nullptr, 10);
+}
+
+float String::toFloat(void) const
+{
+    return static_cast<float>(toDouble());
+}
+
+double String::toDouble(void) const
+{
+    return strtod(m_str.c_str(), nullptr);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+String operator+(const String& lhs, const String& rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const String& lhs, const char* rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const char* lhs, const String& rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const String& lhs, const __FlashStringHelper* rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const String& lhs, char rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const String& lhs, unsigned char rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const String& lhs, int rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const String& lhs, unsigned int rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const String& lhs, long rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const String& lhs, unsigned long rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const String& lhs, float rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+String operator+(const String& lhs, double rhs)
+{
+    String str(lhs);
+
+    (void)str.concat(rhs);
+
+    return str;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Convert a unsigned number to a string.
+ *
+ * @param[in] value Number
+ * @param[in] base  Number base in the range [2; 36]
+ *
+ * @return String
+ */
+static std::string unsignedToStr(unsigned long value, unsigned char base)
+{
+    char    buffer[8U * sizeof(unsigned long) + 1U];
+    char*   ptr     = &buffer[sizeof(buffer) - 1U];
+
+    if ((2U > base) || (36U < base))
+    {
+        base = 10U;
+    }
+
+    *ptr = '\0';
+
+    do
+    {
+        unsigned long digit = value % base;
+
+        --ptr;
+        *ptr    = static_cast<char>((10U > digit) ? ('0' + digit) : ('a' + digit - 10U));
+        value  /= base;
+    }
+    while(0U < value);
+
+    return std::string(ptr);
+}
+
+/**
+ * Convert a signed number to a string. Only with base 10 the number is
+ * handled as signed, like the Arduino implementation does.
+ *
+ * @param[in] value Number
+ * @param[in] base  Number base in the range [2; 36]
+ *
+ * @return String
+ */
+static std::string signedToStr(long value, unsigned char base)
+{
+    if ((10U == base) && (0 > value))
+    {
+        return std::string("-") + unsignedToStr(0UL - static_cast<unsigned long>(value), base);
+    }
+
+    return unsignedToStr(static_cast<unsigned long>(value), base);
+}
+
+/**
+ * Convert a floating point number to a string.
+ *
+ * @param[in] value         Number
+ * @param[in] decimalPlaces Number of decimal places
+ *
+ * @return String
+ */
+static std::string floatToStr(double value, unsigned char decimalPlaces)
+{
+    char buffer[64U];
+
+    (void)snprintf(buffer, sizeof(buffer), "%.*f", decimalPlaces, value);
+
+    return std::string(buffer);
+}
@@ -0,0 +1,255 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino String for Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup linux
+ *
+ * @{
+ */
+
+#ifndef __WSTRING_H__
+#define __WSTRING_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+class __FlashStringHelper;
+
+/**
+ * Arduino compatible string, based on the standard string.
+ */
+class String
+{
+public:
+
+    /**
+     * Constructs an empty string.
+     */
+    String() :
+        m_str()
+    {
+    }
+
+    /**
+     * Constructs a string from a C-string.
+     *
+     * @param[in] str   C-string, may be nullptr.
+     */
+    String(const char* str) :
+        m_str((nullptr == str) ? "" : str)
+    {
+    }
+
+    /**
+     * Constructs a string from a C-string in program memory.
+     *
+     * @param[in] str   C-string in program memory, may be nullptr.
+     */
+    String(const __FlashStringHelper* str) :
+        String(reinterpret_cast<const char*>(str))
+    {
+    }
+
+    /**
+     * Constructs a string from a single character.
+     *
+     * @param[in] c Character
+     */
+    explicit String(char c) :
+        m_str(1U, c)
+    {
+    }
+
+    explicit String(unsigned char value, unsigned char base = 10U);
+    explicit String(int value, unsigned char base = 10U);
+    explicit String(unsigned int value, unsigned char base = 10U);
+    explicit String(long value, unsigned char base = 10U);
+    explicit String(unsigned long value, unsigned char base = 10U);
+    explicit String(float value, unsigned char decimalPlaces = 2U);
+    explicit String(double value, unsigned char decimalPlaces = 2U);
+
+    /**
+     * Destroys the string.
+     */
+    ~String()
+    {
+    }
+
+    /**
+     * Reserve memory for the given string length.
+     *
+     * @param[in] size  String length
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool reserve(unsigned int size)
+    {
+        m_str.reserve(size);
+        return true;
+    }
+
+    /**
+     * Get the string length.
+     *
+     * @return String length
+     */
+    unsigned int length(void) const
+    {
+        return static_cast<unsigned int>(m_str.length());
+    }
+
+    /**
+     * Is the string empty?
+     *
+     * @return If empty, it will return true otherwise false.
+     */
+    bool isEmpty(void) const
+    {
+        return m_str.empty();
+    }
+
+    /**
+     * Get the string as C-string.
+     *
+     * @return C-string
+     */
+    const char* c_str(void) const
+    {
+        return m_str.c_str();
+    }
+
+    bool concat(const String& str);
+    bool concat(const char* str);
+    bool concat(const char* str, unsigned int length);
+    bool concat(const __FlashStringHelper* str);
+    bool concat(char c);
+    bool concat(unsigned char value);
+    bool concat(int value);
+    bool concat(unsigned int value);
+    bool concat(long value);
+    bool concat(unsigned long value);
+    bool concat(float value);
+    bool concat(double value);
+
+    template < typename T >
+    String& operator+=(const T& value)
+    {
+        (void)concat(value);
+        return *this;
+    }
+
+    int compareTo(const String& str) const;
+    bool equals(const String& str) const;
+    bool equals(const char* str) const;
+    bool equalsIgnoreCase(const String& str) const;
+    bool startsWith(const String& prefix) const;
+    bool startsWith(const String& prefix, unsigned int offset) const;
+    bool endsWith(const String& suffix) const;
+
+    bool operator==(const String& str) const { return equals(str); }
+    bool operator==(const char* str) const { return equals(str); }
+    bool operator!=(const String& str) const { return !equals(str); }
+    bool operator!=(const char* str) const { return !equals(str); }
+    bool operator<(const String& str) const { return 0 > compareTo(str); }
+    bool operator>(const String& str) const { return 0 < compareTo(str); }
+    bool operator<=(const String& str) const { return 0 >= compareTo(str); }
+    bool operator>=(const String& str) const { return 0 <= compareTo(str); }
+
+    char charAt(unsigned int index) const;
+    void setCharAt(unsigned int index, char c);
+    char operator[](unsigned int index) const;
+    char& operator[](unsigned int index);
+    void getBytes(unsigned char* buffer, unsigned int size, unsigned int index = 0U) const;
+    void toCharArray(char* buffer, unsigned int size, unsigned int index = 0U) const;
+
+    int indexOf(char c) const;
+    int indexOf(char c, unsigned int fromIndex) const;
+    int indexOf(const String& str) const;
+    int indexOf(const String& str, unsigned int fromIndex) const;
+    int lastIndexOf(char c) const;
+    int lastIndexOf(char c, unsigned int fromIndex) const;
+    int lastIndexOf(const String& str) const;
+    int lastIndexOf(const String& str, unsigned int fromIndex) const;
+
+    String substring(unsigned int beginIndex) const;
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    void replace(char find, char replace);
+    void replace(const String& find, const String& replace);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase(void);
+    void toUpperCase(void);
+    void trim(void);
+
+    long toInt(void) const;
+    float toFloat(void) const;
+    double toDouble(void) const;
+
+private:
+
+    std::string m_str;  /**< The string */
+};
+
+String operator+(const String& lhs, const String& rhs);
+String operator+(const String& lhs, const char* rhs);
+String operator+(const char* lhs, const String& rhs);
+String operator+(const String& lhs, const __FlashStringHelper* rhs);
+String operator+(const String& lhs, char rhs);
+String operator+(const String& lhs, unsigned char rhs);
+String operator+(const String& lhs, int rhs);
+String operator+(const String& lhs, unsigned int rhs);
+String operator+(const String& lhs, long rhs);
+String operator+(const String& lhs, unsigned long rhs);
+String operator+(const String& lhs, float rhs);
+String operator+(const String& lhs, double rhs);
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __WSTRING_H__ */
+
+/** @} */
@@ -51,15 +51,22 @@
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
-#include <time.h>
 
 #include "WString.h"
 #include "Print.h"
+#include "VirtualClock.h"
 
 /******************************************************************************
  * Macros
  *****************************************************************************/
 
+/** Pin mode: Digital input with pull-up */
+#define INPUT_PULLUP    (0x2)
+
+/* Program memory is ordinary memory. */
+#define pgm_read_byte(_addr)    (*reinterpret_cast<const uint8_t*>(_addr))
+#define pgm_read_ptr(_addr)     (*(void* const*)(_addr))
+
 /******************************************************************************
  * Types and Classes
  *****************************************************************************/
@@ -71,11 +78,22 @@ typedef bool boolean;
  * Functions
  *****************************************************************************/
 
+/* Like on the AVR, the time wraps around after 2^32 ms resp. us. */
+
 static unsigned long millis()
 {
-    clock_t now = clock();
+    return static_cast<uint32_t>(VirtualClock::getMicros() / 1000U);
+}
+
+static inline unsigned long micros()
+{
+    return static_cast<uint32_t>(VirtualClock::getMicros());
+}
 
-    return (now * 1000UL) / CLOCKS_PER_SEC;
+static inline void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
 }
 
 static uint32_t esp_log_timestamp(void)
@@ -0,0 +1,298 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Hardware abstraction layer - Test backend
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Hal.h>
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void handleInterrupt(void);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** S0 port input value. The inputs have pull-ups, therefore all are high by default. */
+static uint8_t  gS0Port             = 0xFFU;
+
+/** S0 port pins, whose pin change interrupt is enabled. */
+static uint8_t  gS0PinChangeMask    = 0U;
+
+/** EEPROM content */
+static uint8_t  gEeprom[HalTest::EEPROM_SIZE];
+
+/** Is the EEPROM initialized with the erased state? */
+static bool     gIsEepromInit       = false;
+
+/** Number of written EEPROM bytes */
+static uint32_t gEepromWriteCnt     = 0U;
+
+/** Number of requested resets */
+static uint32_t gResetCnt           = 0U;
+
+/** Interrupt service routine */
+static HalTest::IsrFunc     gIsr                    = nullptr;
+
+/** User context of the interrupt service routine */
+static void*                gIsrCtx                 = nullptr;
+
+/** Handler of the yield points */
+static HalTest::YieldFunc   gYieldHandler           = nullptr;
+
+/** User context of the yield point handler */
+static void*                gYieldCtx               = nullptr;
+
+/** Are the interrupts enabled? */
+static bool                 gIsInterruptEnabled     = true;
+
+/** Is the interrupt pending? */
+static bool                 gIsInterruptPending     = false;
+
+/** Is the interrupt service routine running? */
+static bool                 gIsInIsr                = false;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+uint8_t Hal::readS0Port(void)
+{
+    return gS0Port;
+}
+
+void Hal::enableS0PinChange(uint8_t bitNo)
+{
+    gS0PinChangeMask |= (1U << bitNo);
+    return;
+}
+
+void Hal::disableS0PinChange(uint8_t bitNo)
+{
+    gS0PinChangeMask &= ~(1U << bitNo);
+    return;
+}
+
+uint8_t Hal::getS0PinChangeMask(void)
+{
+    return gS0PinChangeMask;
+}
+
+void Hal::enableS0Interrupt(void)
+{
+    return;
+}
+
+uint8_t Hal::eepromRead(uint16_t addr)
+{
+    if (false == gIsEepromInit)
+    {
+        HalTest::reset();
+    }
+
+    return (HalTest::EEPROM_SIZE > addr) ? gEeprom[addr] : 0xFFU;
+}
+
+void Hal::eepromUpdate(uint16_t addr, uint8_t value)
+{
+    if (false == gIsEepromInit)
+    {
+        HalTest::reset();
+    }
+
+    if ((HalTest::EEPROM_SIZE > addr) &&
+        (value != gEeprom[addr]))
+    {
+        gEeprom[addr] = value;
+        ++gEepromWriteCnt;
+    }
+
+    return;
+}
+
+void Hal::reset(void)
+{
+    ++gResetCnt;
+    return;
+}
+
+void HalTest::reset(void)
+{
+    gS0Port             = 0xFFU;
+    gS0PinChangeMask    = 0U;
+    gResetCnt           = 0U;
+    gIsr                = nullptr;
+    gIsrCtx             = nullptr;
+    gYieldHandler       = nullptr;
+    gYieldCtx           = nullptr;
+    gIsInterruptEnabled = true;
+    gIsInterruptPending = false;
+    gIsInIsr            = false;
+
+    /* An erased EEPROM reads 0xFF. */
+    memset(gEeprom, 0xFF, sizeof(gEeprom));
+    gIsEepromInit   = true;
+    gEepromWriteCnt = 0U;
+
+    return;
+}
+
+void HalTest::setS0Port(uint8_t value)
+{
+    gS0Port = value;
+    return;
+}
+
+uint32_t HalTest::getResetCnt(void)
+{
+    return gResetCnt;
+}
+
+uint32_t HalTest::getEepromWriteCnt(void)
+{
+    return gEepromWriteCnt;
+}
+
+void HalTest::setIsr(IsrFunc isr, void* ctx)
+{
+    gIsr    = isr;
+    gIsrCtx = ctx;
+
+    return;
+}
+
+void HalTest::raiseInterrupt(void)
+{
+    gIsInterruptPending = true;
+
+    if (true == gIsInterruptEnabled)
+    {
+        handleInterrupt();
+    }
+
+    return;
+}
+
+void HalTest::setYieldHandler(YieldFunc handler, void* ctx)
+{
+    gYieldHandler   = handler;
+    gYieldCtx       = ctx;
+
+    return;
+}
+
+void HalTest::yieldPoint(void)
+{
+    /* The interrupt service routine itself is never interrupted. */
+    if ((false == gIsInIsr) &&
+        (nullptr != gYieldHandler))
+    {
+        gYieldHandler(gYieldCtx);
+    }
+
+    return;
+}
+
+bool HalTest::disableInterrupts(void)
+{
+    bool isEnabled = gIsInterruptEnabled;
+
+    gIsInterruptEnabled = false;
+
+    return isEnabled;
+}
+
+void HalTest::restoreInterrupts(bool isEnabled)
+{
+    gIsInterruptEnabled = isEnabled;
+
+    if ((true == gIsInterruptEnabled) &&
+        (true == gIsInterruptPending))
+    {
+        handleInterrupt();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Handle the pending interrupt. Like on the target, the interrupts are masked
+ * while the interrupt service routine runs.
+ */
+static void handleInterrupt(void)
+{
+    gIsInterruptPending = false;
+    gIsInterruptEnabled = false;
+    gIsInIsr            = true;
+
+    if (nullptr != gIsr)
+    {
+        gIsr(gIsrCtx);
+    }
+
+    gIsInIsr            = false;
+    gIsInterruptEnabled = true;
+
+    return;
+}
@@ -0,0 +1,276 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Hardware abstraction layer - Test backend
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The S0 port and the EEPROM are just variables. The pin change interrupt
+ * is modelled: a test raises it and the registered interrupt service routine
+ * runs immediately or, if the interrupts are masked by a atomic block, at the
+ * end of the block like on the target.
+ *
+ * The variables, which are shared with the interrupt service routine, are
+ * accessed byte by byte like on the 8-bit target. Before every byte there is
+ * a yield point, where a test may raise the interrupt, see Interleaver.h.
+ * Don't include it directly, use Hal.h instead.
+ *
+ * @addtogroup test
+ *
+ * @{
+ */
+
+#ifndef __HAL_TEST_H__
+#define __HAL_TEST_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Defines the handler of the S0 port pin changes. */
+#define HAL_S0_PIN_CHANGE_ISR()     void Hal::onS0PinChange(void)
+
+/** Execute the following block once with masked interrupts. */
+#define HAL_ATOMIC_BLOCK()          for(HalTest::AtomicGuard _halAtomic; true == _halAtomic.enter(); )
+
+/** Read a variable, which is shared with the interrupt service routine. */
+#define HAL_SHARED_LOAD(_var)               HalTest::sharedLoad(_var)
+
+/** Write a variable, which is shared with the interrupt service routine. */
+#define HAL_SHARED_STORE(_var, _value)      HalTest::sharedStore(_var, _value)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Test specific part of the hardware abstraction layer.
+ */
+namespace HalTest
+{
+
+/** EEPROM size in bytes, like the one of the ATmega644P. */
+static const uint16_t   EEPROM_SIZE = 2048U;
+
+/**
+ * Interrupt service routine in test.
+ *
+ * @param[in] ctx   User context
+ */
+typedef void (*IsrFunc)(void* ctx);
+
+/**
+ * Handler, which is called at every yield point.
+ *
+ * @param[in] ctx   User context
+ */
+typedef void (*YieldFunc)(void* ctx);
+
+/**
+ * Set the S0 port and the EEPROM back to their initial state.
+ */
+void reset(void);
+
+/**
+ * Set the input value of the S0 port.
+ *
+ * @param[in] value Port input value
+ */
+void setS0Port(uint8_t value);
+
+/**
+ * Get the number of requested resets.
+ *
+ * @return Number of resets
+ */
+uint32_t getResetCnt(void);
+
+/**
+ * Get the number of EEPROM bytes, which were written, because their value
+ * changed.
+ *
+ * @return Number of written EEPROM bytes
+ */
+uint32_t getEepromWriteCnt(void);
+
+/**
+ * Set the interrupt service routine, which runs if the interrupt is raised.
+ *
+ * @param[in] isr   Interrupt service routine, nullptr to remove it
+ * @param[in] ctx   User context
+ */
+void setIsr(IsrFunc isr, void* ctx);
+
+/**
+ * Raise the interrupt. If the interrupts are masked, the interrupt service
+ * routine runs at the end of the atomic block, otherwise immediately.
+ * A already pending interrupt is not raised twice.
+ */
+void raiseInterrupt(void);
+
+/**
+ * Set the handler, which is called at every yield point.
+ *
+ * @param[in] handler   Handler, nullptr to remove it
+ * @param[in] ctx       User context
+ */
+void setYieldHandler(YieldFunc handler, void* ctx);
+
+/**
+ * A interrupt may happen here. Called before every byte access to a variable,
+ * which is shared with the interrupt service routine.
+ */
+void yieldPoint(void);
+
+/**
+ * Mask the interrupts.
+ *
+ * @return If the interrupts were enabled before, it will return true otherwise false.
+ */
+bool disableInterrupts(void);
+
+/**
+ * Restore the interrupt state. If the interrupts are enabled again, a
+ * pending interrupt is handled.
+ *
+ * @param[in] isEnabled Interrupt state, returned by disableInterrupts()
+ */
+void restoreInterrupts(bool isEnabled);
+
+/**
+ * Read a variable, which is shared with the interrupt service routine,
+ * byte by byte like the 8-bit target.
+ *
+ * @param[in] var   Variable
+ *
+ * @return Value
+ */
+template < typename T >
+T sharedLoad(const volatile T& var)
+{
+    T                       value;
+    uint8_t*                dst     = reinterpret_cast<uint8_t*>(&value);
+    const volatile uint8_t* src     = reinterpret_cast<const volatile uint8_t*>(&var);
+    uint8_t                 idx     = 0U;
+
+    for(idx = 0U; idx < sizeof(T); ++idx)
+    {
+        yieldPoint();
+        dst[idx] = src[idx];
+    }
+
+    return value;
+}
+
+/**
+ * Write a variable, which is shared with the interrupt service routine,
+ * byte by byte like the 8-bit target.
+ *
+ * @param[in] var   Variable
+ * @param[in] value Value
+ */
+template < typename T, typename U >
+void sharedStore(volatile T& var, U value)
+{
+    T                   data    = static_cast<T>(value);
+    const uint8_t*      src     = reinterpret_cast<const uint8_t*>(&data);
+    volatile uint8_t*   dst     = reinterpret_cast<volatile uint8_t*>(&var);
+    uint8_t             idx     = 0U;
+
+    for(idx = 0U; idx < sizeof(T); ++idx)
+    {
+        yieldPoint();
+        dst[idx] = src[idx];
+    }
+
+    return;
+}
+
+/**
+ * Masks the interrupts during its lifetime, like ATOMIC_BLOCK(ATOMIC_RESTORESTATE).
+ */
+class AtomicGuard
+{
+public:
+
+    /**
+     * Mask the interrupts.
+     */
+    AtomicGuard() :
+        m_isEnabled(disableInterrupts()),
+        m_isEntered(false)
+    {
+    }
+
+    /**
+     * Restore the interrupt state.
+     */
+    ~AtomicGuard()
+    {
+        restoreInterrupts(m_isEnabled);
+    }
+
+    /**
+     * Enter the atomic block once.
+     *
+     * @return On the first call it returns true, otherwise false.
+     */
+    bool enter(void)
+    {
+        bool isFirst = (false == m_isEntered);
+
+        m_isEntered = true;
+
+        return isFirst;
+    }
+
+private:
+
+    bool    m_isEnabled;    /**< Interrupt state before */
+    bool    m_isEntered;    /**< Is the block entered? */
+
+    AtomicGuard(const AtomicGuard& guard);
+    AtomicGuard& operator=(const AtomicGuard& guard);
+};
+
+};
+
+#endif  /* __HAL_TEST_H__ */
+
+/** @} */
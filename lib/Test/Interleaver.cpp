@@ -0,0 +1,171 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Interleaving explorer for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Interleaver.h"
+
+#include <Hal.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void onYieldPoint(void* ctx);
+static uint32_t run(const Interleaver::Scenario& scenario, void* ctx, uint32_t interruptPoint);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Yield point, where the interrupt is raised in the current run. */
+static uint32_t gInterruptPoint = Interleaver::NO_INTERRUPT;
+
+/** Number of yield points, passed in the current run. */
+static uint32_t gYieldCnt       = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+Interleaver::Result Interleaver::explore(const Scenario& scenario, void* ctx)
+{
+    Result      result;
+    uint32_t    point   = 0U;
+
+    result.yieldPoints  = run(scenario, ctx, NO_INTERRUPT);
+    result.failures     = 0U;
+    result.firstFailure = NO_INTERRUPT;
+
+    if (false == scenario.check(ctx))
+    {
+        ++result.failures;
+    }
+
+    for(point = 0U; point < result.yieldPoints; ++point)
+    {
+        (void)run(scenario, ctx, point);
+
+        if (false == scenario.check(ctx))
+        {
+            if (0U == result.failures)
+            {
+                result.firstFailure = point;
+            }
+
+            ++result.failures;
+        }
+    }
+
+    gInterruptPoint = NO_INTERRUPT;
+
+    return result;
+}
+
+uint32_t Interleaver::getInterruptPoint(void)
+{
+    return gInterruptPoint;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Raise the interrupt, if the yield point of the current run is reached.
+ *
+ * @param[in] ctx   Not used
+ */
+static void onYieldPoint(void* ctx)
+{
+    (void)ctx;
+
+    if (gInterruptPoint == gYieldCnt)
+    {
+        HalTest::raiseInterrupt();
+    }
+
+    ++gYieldCnt;
+
+    return;
+}
+
+/**
+ * Run a scenario once.
+ *
+ * @param[in] scenario          Scenario
+ * @param[in] ctx               User context
+ * @param[in] interruptPoint    Yield point, where the interrupt is raised
+ *
+ * @return Number of passed yield points
+ */
+static uint32_t run(const Interleaver::Scenario& scenario, void* ctx, uint32_t interruptPoint)
+{
+    gInterruptPoint = interruptPoint;
+    gYieldCnt       = 0U;
+
+    scenario.setup(ctx);
+
+    HalTest::setIsr(scenario.isr, ctx);
+    HalTest::setYieldHandler(onYieldPoint, nullptr);
+
+    scenario.access(ctx);
+
+    HalTest::setYieldHandler(nullptr, nullptr);
+    HalTest::setIsr(nullptr, nullptr);
+
+    return gYieldCnt;
+}
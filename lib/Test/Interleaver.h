@@ -0,0 +1,139 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Interleaving explorer for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Verifies the main loop accessors of data, which is shared with a interrupt
+ * service routine. The accessors read and write the shared variables via
+ * HAL_SHARED_LOAD() and HAL_SHARED_STORE(), which have a yield point before
+ * every byte, like the instructions of the 8-bit target.
+ *
+ * A scenario is run once without interrupt to count the yield points. Then it
+ * is run again for every yield point, with the interrupt raised exactly there.
+ * After every run the invariants are checked, e.g. monotonic counters, no
+ * torn reads and bounded values.
+ *
+ * @addtogroup test
+ *
+ * @{
+ */
+
+#ifndef __INTERLEAVER_H__
+#define __INTERLEAVER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Interleaving explorer
+ */
+namespace Interleaver
+{
+
+/**
+ * Step of a scenario.
+ *
+ * @param[in] ctx   User context
+ */
+typedef void (*StepFunc)(void* ctx);
+
+/**
+ * Check of the invariants after a run.
+ *
+ * @param[in] ctx   User context
+ *
+ * @return If all invariants hold, it will return true otherwise false.
+ */
+typedef bool (*CheckFunc)(void* ctx);
+
+/**
+ * A scenario, which is explored.
+ */
+struct Scenario
+{
+    StepFunc    setup;  /**< Sets up the shared data, called before every run */
+    StepFunc    access; /**< Main loop accessors, which are interrupted */
+    StepFunc    isr;    /**< Interrupt service routine */
+    CheckFunc   check;  /**< Checks the invariants after every run */
+};
+
+/**
+ * Result of a exploration.
+ */
+struct Result
+{
+    uint32_t    yieldPoints;    /**< Number of yield points in the main loop accessors */
+    uint32_t    failures;       /**< Number of runs, whose invariants didn't hold */
+    uint32_t    firstFailure;   /**< Yield point of the first failed run */
+};
+
+/** Yield point of the run without interrupt. */
+static const uint32_t   NO_INTERRUPT    = UINT32_MAX;
+
+/**
+ * Explore a scenario: the interrupt is raised at every yield point once.
+ * The run without interrupt is checked too.
+ *
+ * @param[in] scenario  Scenario
+ * @param[in] ctx       User context, passed to all steps
+ *
+ * @return Result
+ */
+Result explore(const Scenario& scenario, void* ctx);
+
+/**
+ * Get the yield point, where the interrupt is raised in the current run.
+ * It can be used by the check to report the failed interleaving.
+ *
+ * @return Yield point or NO_INTERRUPT
+ */
+uint32_t getInterruptPoint(void);
+
+};
+
+#endif  /* __INTERLEAVER_H__ */
+
+/** @} */
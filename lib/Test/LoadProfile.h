@@ -0,0 +1,474 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Load profiles for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * A load profile defines the power of a consumer over time. Besides the
+ * power, every profile provides the energy consumed since the start in
+ * closed form. This way the pulse generator finds the exact pulse times,
+ * without integrating over days in small steps.
+ *
+ * @addtogroup test
+ *
+ * @{
+ */
+
+#ifndef __LOAD_PROFILE_H__
+#define __LOAD_PROFILE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Load profile interface.
+ */
+class LoadProfile
+{
+public:
+
+    /**
+     * Destroys the load profile.
+     */
+    virtual ~LoadProfile()
+    {
+    }
+
+    /**
+     * Get the power at the given time.
+     *
+     * @param[in] t Time in s since the start
+     *
+     * @return Power in W, which is never negative.
+     */
+    virtual double getPower(double t) const = 0;
+
+    /**
+     * Get the energy, consumed since the start.
+     *
+     * @param[in] t Time in s since the start
+     *
+     * @return Energy in Ws
+     */
+    virtual double getEnergy(double t) const = 0;
+
+protected:
+
+    /**
+     * Constructs the load profile.
+     */
+    LoadProfile()
+    {
+    }
+};
+
+/**
+ * Constant power.
+ */
+class ConstantLoad : public LoadProfile
+{
+public:
+
+    /**
+     * Constructs the load profile.
+     *
+     * @param[in] power Power in W
+     */
+    explicit ConstantLoad(double power) :
+        LoadProfile(),
+        m_power(power)
+    {
+    }
+
+    double getPower(double t) const override
+    {
+        (void)t;
+
+        return m_power;
+    }
+
+    double getEnergy(double t) const override
+    {
+        return m_power * t;
+    }
+
+private:
+
+    double  m_power;    /**< Power in W */
+};
+
+/**
+ * Power, which changes abruptly at a point in time.
+ */
+class StepLoad : public LoadProfile
+{
+public:
+
+    /**
+     * Constructs the load profile.
+     *
+     * @param[in] powerBefore   Power in W before the step
+     * @param[in] powerAfter    Power in W after the step
+     * @param[in] stepTime      Time in s of the step
+     */
+    StepLoad(double powerBefore, double powerAfter, double stepTime) :
+        LoadProfile(),
+        m_powerBefore(powerBefore),
+        m_powerAfter(powerAfter),
+        m_stepTime(stepTime)
+    {
+    }
+
+    double getPower(double t) const override
+    {
+        return (m_stepTime > t) ? m_powerBefore : m_powerAfter;
+    }
+
+    double getEnergy(double t) const override
+    {
+        if (m_stepTime > t)
+        {
+            return m_powerBefore * t;
+        }
+
+        return m_powerBefore * m_stepTime + m_powerAfter * (t - m_stepTime);
+    }
+
+private:
+
+    double  m_powerBefore;  /**< Power in W before the step */
+    double  m_powerAfter;   /**< Power in W after the step */
+    double  m_stepTime;     /**< Time in s of the step */
+};
+
+/**
+ * Power, which changes linear during a period of time.
+ */
+class RampLoad : public LoadProfile
+{
+public:
+
+    /**
+     * Constructs the load profile.
+     *
+     * @param[in] powerBegin    Power in W before the ramp
+     * @param[in] powerEnd      Power in W after the ramp
+     * @param[in] startTime     Time in s, when the ramp starts
+     * @param[in] duration      Duration in s of the ramp
+     */
+    RampLoad(double powerBegin, double powerEnd, double startTime, double duration) :
+        LoadProfile(),
+        m_powerBegin(powerBegin),
+        m_powerEnd(powerEnd),
+        m_startTime(startTime),
+        m_duration(duration)
+    {
+    }
+
+    double getPower(double t) const override
+    {
+        if (m_startTime >= t)
+        {
+            return m_powerBegin;
+        }
+
+        if ((m_startTime + m_duration) <= t)
+        {
+            return m_powerEnd;
+        }
+
+        return m_powerBegin + (m_powerEnd - m_powerBegin) * (t - m_startTime) / m_duration;
+    }
+
+    double getEnergy(double t) const override
+    {
+        double  rampTime    = 0.0;
+        double  energy      = 0.0;
+
+        if (m_startTime >= t)
+        {
+            return m_powerBegin * t;
+        }
+
+        rampTime = t - m_startTime;
+
+        if (m_duration < rampTime)
+        {
+            rampTime = m_duration;
+        }
+
+        energy  = m_powerBegin * m_startTime;
+        energy += m_powerBegin * rampTime + (m_powerEnd - m_powerBegin) * rampTime * rampTime / (2.0 * m_duration);
+
+        if ((m_startTime + m_duration) < t)
+        {
+            energy += m_powerEnd * (t - m_startTime - m_duration);
+        }
+
+        return energy;
+    }
+
+private:
+
+    double  m_powerBegin;   /**< Power in W before the ramp */
+    double  m_powerEnd;     /**< Power in W after the ramp */
+    double  m_startTime;    /**< Time in s, when the ramp starts */
+    double  m_duration;     /**< Duration in s of the ramp */
+};
+
+/**
+ * Power with a sinusoidal ripple, like the output of a inverter with a
+ * unsteady input.
+ */
+class RippleLoad : public LoadProfile
+{
+public:
+
+    /**
+     * Constructs the load profile.
+     *
+     * @param[in] power     Mean power in W
+     * @param[in] amplitude Ripple amplitude in W, limited to the mean power.
+     * @param[in] period    Ripple period in s
+     */
+    RippleLoad(double power, double amplitude, double period) :
+        LoadProfile(),
+        m_power(power),
+        m_amplitude((amplitude > power) ? power : amplitude),
+        m_omega(2.0 * M_PI / period)
+    {
+    }
+
+    double getPower(double t) const override
+    {
+        return m_power + m_amplitude * sin(m_omega * t);
+    }
+
+    double getEnergy(double t) const override
+    {
+        return m_power * t + m_amplitude * (1.0 - cos(m_omega * t)) / m_omega;
+    }
+
+private:
+
+    double  m_power;        /**< Mean power in W */
+    double  m_amplitude;    /**< Ripple amplitude in W */
+    double  m_omega;        /**< Ripple angular frequency in 1/s */
+};
+
+/**
+ * Recorded power samples, which are interpolated linearly. Before the first
+ * sample the power of the first one applies, after the last sample the power
+ * of the last one.
+ */
+class RecordedLoad : public LoadProfile
+{
+public:
+
+    /**
+     * Constructs a empty load profile.
+     */
+    RecordedLoad() :
+        LoadProfile(),
+        m_samples()
+    {
+    }
+
+    /**
+     * Add a sample. The samples must be added in chronological order.
+     *
+     * @param[in] t     Time in s since the start
+     * @param[in] power Power in W, which must not be negative.
+     *
+     * @return If the sample is valid, it will return true otherwise false.
+     */
+    bool addSample(double t, double power)
+    {
+        Sample sample = { t, power, 0.0 };
+
+        if ((0.0 > t) || (0.0 > power))
+        {
+            return false;
+        }
+
+        if (true == m_samples.empty())
+        {
+            sample.energy = power * t;
+        }
+        else
+        {
+            const Sample& last = m_samples.back();
+
+            if (last.t >= t)
+            {
+                return false;
+            }
+
+            sample.energy = last.energy + (last.power + power) * (t - last.t) / 2.0;
+        }
+
+        m_samples.push_back(sample);
+
+        return true;
+    }
+
+    /**
+     * Get the time of the last sample.
+     *
+     * @return Time in s since the start
+     */
+    double getDuration(void) const
+    {
+        return (true == m_samples.empty()) ? 0.0 : m_samples.back().t;
+    }
+
+    double getPower(double t) const override
+    {
+        size_t idx = findSegment(t);
+
+        if (true == m_samples.empty())
+        {
+            return 0.0;
+        }
+
+        if ((0U == idx) || (m_samples.size() == idx))
+        {
+            return m_samples[(0U == idx) ? 0U : (idx - 1U)].power;
+        }
+
+        return interpolate(m_samples[idx - 1U], m_samples[idx], t);
+    }
+
+    double getEnergy(double t) const override
+    {
+        size_t idx = findSegment(t);
+
+        if (true == m_samples.empty())
+        {
+            return 0.0;
+        }
+
+        if (0U == idx)
+        {
+            return m_samples[0U].power * t;
+        }
+
+        if (m_samples.size() == idx)
+        {
+            const Sample& last = m_samples.back();
+
+            return last.energy + last.power * (t - last.t);
+        }
+
+        {
+            const Sample&   prev    = m_samples[idx - 1U];
+            double          power   = interpolate(prev, m_samples[idx], t);
+
+            return prev.energy + (prev.power + power) * (t - prev.t) / 2.0;
+        }
+    }
+
+private:
+
+    /**
+     * A power sample.
+     */
+    struct Sample
+    {
+        double  t;      /**< Time in s since the start */
+        double  power;  /**< Power in W */
+        double  energy; /**< Energy in Ws since the start */
+    };
+
+    std::vector<Sample> m_samples;  /**< Samples in chronological order */
+
+    /**
+     * Find the first sample after the given time.
+     *
+     * @param[in] t Time in s since the start
+     *
+     * @return Sample index or the number of samples, if there is none.
+     */
+    size_t findSegment(double t) const
+    {
+        /* The samples are sorted, therefore it is a binary search. */
+        std::vector<Sample>::const_iterator it = std::upper_bound(m_samples.begin(), m_samples.end(), t, isBefore);
+
+        return static_cast<size_t>(it - m_samples.begin());
+    }
+
+    /**
+     * Is the time before the sample?
+     *
+     * @param[in] t         Time in s since the start
+     * @param[in] sample    Sample
+     *
+     * @return If the time is before the sample, it will return true otherwise false.
+     */
+    static bool isBefore(double t, const Sample& sample)
+    {
+        return t < sample.t;
+    }
+
+    /**
+     * Interpolate the power between two samples.
+     *
+     * @param[in] prev  Sample before
+     * @param[in] next  Sample after
+     * @param[in] t     Time in s since the start
+     *
+     * @return Power in W
+     */
+    static double interpolate(const Sample& prev, const Sample& next, double t)
+    {
+        return prev.power + (next.power - prev.power) * (t - prev.t) / (next.t - prev.t);
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __LOAD_PROFILE_H__ */
+
+/** @} */
@@ -0,0 +1,217 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pulse trace for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PulseTrace.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Magic at the begin of every trace. */
+static const uint8_t    MAGIC[]     = { 'S', '0', 'P', 'T' };
+
+/** Number of bits of the record code. */
+static const uint8_t    CODE_BITS   = 4U;
+
+/** Max. number of bytes of a varint, enough for 64 bit. */
+static const uint8_t    VARINT_MAX  = 10U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool PulseTrace::Writer::begin(const Header& header)
+{
+    uint8_t idx = 0U;
+
+    if ((0U == header.numChannels) || (MAX_CHANNELS < header.numChannels))
+    {
+        return false;
+    }
+
+    m_data.assign(MAGIC, MAGIC + sizeof(MAGIC));
+    m_data.push_back(VERSION);
+    m_data.push_back(header.numChannels);
+
+    for(idx = 0U; idx < header.numChannels; ++idx)
+    {
+        m_data.push_back(static_cast<uint8_t>(header.pulsesPerKWh[idx] & 0xFFU));
+        m_data.push_back(static_cast<uint8_t>(header.pulsesPerKWh[idx] >> 8U));
+    }
+
+    m_numChannels   = header.numChannels;
+    m_time          = 0U;
+
+    return true;
+}
+
+bool PulseTrace::Writer::append(const Record& record)
+{
+    uint64_t value = 0U;
+
+    if ((0U == m_numChannels) ||
+        (m_time > record.time) ||
+        ((m_numChannels <= record.code) && (CODE_GAP != record.code)))
+    {
+        return false;
+    }
+
+    value   = ((record.time - m_time) << CODE_BITS) | record.code;
+    m_time  = record.time;
+
+    while(0x80U <= value)
+    {
+        m_data.push_back(static_cast<uint8_t>(value & 0x7FU) | 0x80U);
+        value >>= 7U;
+    }
+
+    m_data.push_back(static_cast<uint8_t>(value));
+
+    return true;
+}
+
+bool PulseTrace::Reader::readHeader(Header& header)
+{
+    size_t  headerSize  = sizeof(MAGIC) + 2U;
+    uint8_t idx         = 0U;
+
+    memset(&header, 0, sizeof(header));
+
+    if ((headerSize > m_size) ||
+        (0 != memcmp(m_data, MAGIC, sizeof(MAGIC))) ||
+        (VERSION != m_data[sizeof(MAGIC)]))
+    {
+        m_isError = true;
+        return false;
+    }
+
+    header.numChannels = m_data[sizeof(MAGIC) + 1U];
+
+    if ((0U == header.numChannels) ||
+        (MAX_CHANNELS < header.numChannels) ||
+        ((headerSize + 2U * header.numChannels) > m_size))
+    {
+        m_isError = true;
+        return false;
+    }
+
+    for(idx = 0U; idx < header.numChannels; ++idx)
+    {
+        const uint8_t* value = &m_data[headerSize + 2U * idx];
+
+        header.pulsesPerKWh[idx] = static_cast<uint16_t>(value[0] | (value[1] << 8U));
+    }
+
+    m_pos           = headerSize + 2U * header.numChannels;
+    m_numChannels   = header.numChannels;
+    m_time          = 0U;
+
+    return true;
+}
+
+bool PulseTrace::Reader::next(Record& record)
+{
+    uint64_t    value   = 0U;
+    uint8_t     shift   = 0U;
+    uint8_t     cnt     = 0U;
+    bool        isLast  = false;
+
+    if ((0U == m_numChannels) ||
+        (true == m_isError) ||
+        (m_size <= m_pos))
+    {
+        return false;
+    }
+
+    while((false == isLast) && (m_size > m_pos) && (VARINT_MAX > cnt))
+    {
+        uint8_t data = m_data[m_pos];
+
+        value  |= static_cast<uint64_t>(data & 0x7FU) << shift;
+        isLast  = (0U == (data & 0x80U));
+        shift  += 7U;
+
+        ++m_pos;
+        ++cnt;
+    }
+
+    record.code = static_cast<uint8_t>(value & ((1U << CODE_BITS) - 1U));
+
+    /* Truncated varint or unknown channel? */
+    if ((false == isLast) ||
+        ((m_numChannels <= record.code) && (CODE_GAP != record.code)))
+    {
+        m_isError = true;
+        return false;
+    }
+
+    m_time      += value >> CODE_BITS;
+    record.time  = m_time;
+
+    return true;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,252 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pulse trace for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * A pulse trace is a compact binary recording of the S0 pulses of all
+ * channels, e.g. captured from the pulse log of a device with
+ * tools/pulsetrace.py. It is replayed to check the power estimation against
+ * real meters. All values are little endian.
+ *
+ * Header:
+ * - Magic "S0PT"
+ * - Version (1 byte)
+ * - Number of channels N (1 byte), 1 to 8
+ * - Pulses per kWh of every channel (N x 2 bytes)
+ *
+ * Records till the end of the file, each a unsigned LEB128 varint of
+ * (delta << 4) | code:
+ * - delta: Time in ms since the previous record or the start of the trace.
+ * - code: Channel of the pulse (0 - 7) or CODE_GAP if records were lost.
+ *
+ * Pulses of several channels at the same time are consecutive records with
+ * a delta of 0.
+ *
+ * @addtogroup test
+ *
+ * @{
+ */
+
+#ifndef __PULSE_TRACE_H__
+#define __PULSE_TRACE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Pulse trace
+ */
+namespace PulseTrace
+{
+
+/** Format version */
+static const uint8_t    VERSION         = 1U;
+
+/** Max. number of channels */
+static const uint8_t    MAX_CHANNELS    = 8U;
+
+/** Record code of lost records */
+static const uint8_t    CODE_GAP        = 15U;
+
+/**
+ * Trace header
+ */
+struct Header
+{
+    uint8_t     numChannels;                /**< Number of channels */
+    uint16_t    pulsesPerKWh[MAX_CHANNELS]; /**< Pulses per kWh of every channel */
+};
+
+/**
+ * Trace record
+ */
+struct Record
+{
+    uint64_t    time;   /**< Time in ms since the start of the trace */
+    uint8_t     code;   /**< Channel of the pulse or CODE_GAP */
+};
+
+/**
+ * Writes a pulse trace into a buffer.
+ */
+class Writer
+{
+public:
+
+    /**
+     * Constructs a empty trace writer.
+     */
+    Writer() :
+        m_data(),
+        m_numChannels(0U),
+        m_time(0U)
+    {
+    }
+
+    /**
+     * Destroys the trace writer.
+     */
+    ~Writer()
+    {
+    }
+
+    /**
+     * Start the trace with its header. A previous trace is discarded.
+     *
+     * @param[in] header    Trace header
+     *
+     * @return If the header is valid, it will return true otherwise false.
+     */
+    bool begin(const Header& header);
+
+    /**
+     * Append a record. The records must be appended in chronological order.
+     *
+     * @param[in] record    Trace record
+     *
+     * @return If the record is valid, it will return true otherwise false.
+     */
+    bool append(const Record& record);
+
+    /**
+     * Get the trace.
+     *
+     * @return Trace data
+     */
+    const std::vector<uint8_t>& getData(void) const
+    {
+        return m_data;
+    }
+
+private:
+
+    std::vector<uint8_t>    m_data;         /**< Trace data */
+    uint8_t                 m_numChannels;  /**< Number of channels */
+    uint64_t                m_time;         /**< Time in ms of the last record */
+
+    Writer(const Writer& writer);
+    Writer& operator=(const Writer& writer);
+};
+
+/**
+ * Reads a pulse trace from a buffer.
+ */
+class Reader
+{
+public:
+
+    /**
+     * Constructs a trace reader.
+     *
+     * @param[in] data  Trace data, which must exist during the lifetime of the reader.
+     * @param[in] size  Trace data size in bytes
+     */
+    Reader(const uint8_t* data, size_t size) :
+        m_data(data),
+        m_size(size),
+        m_pos(0U),
+        m_numChannels(0U),
+        m_time(0U),
+        m_isError(false)
+    {
+    }
+
+    /**
+     * Destroys the trace reader.
+     */
+    ~Reader()
+    {
+    }
+
+    /**
+     * Read the header. Call it once, before the records are read.
+     *
+     * @param[out] header   Trace header
+     *
+     * @return If the header is valid, it will return true otherwise false.
+     */
+    bool readHeader(Header& header);
+
+    /**
+     * Read the next record.
+     *
+     * @param[out] record   Trace record
+     *
+     * @return If a record is available, it will return true otherwise false.
+     */
+    bool next(Record& record);
+
+    /**
+     * Is the trace invalid? Check it after the last record was read.
+     *
+     * @return If the trace is invalid or truncated, it will return true otherwise false.
+     */
+    bool isError(void) const
+    {
+        return m_isError;
+    }
+
+private:
+
+    const uint8_t*  m_data;         /**< Trace data */
+    size_t          m_size;         /**< Trace data size in bytes */
+    size_t          m_pos;          /**< Read position */
+    uint8_t         m_numChannels;  /**< Number of channels */
+    uint64_t        m_time;         /**< Time in ms of the last record */
+    bool            m_isError;      /**< Is the trace invalid? */
+
+    Reader();
+    Reader(const Reader& reader);
+    Reader& operator=(const Reader& reader);
+};
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PULSE_TRACE_H__ */
+
+/** @} */
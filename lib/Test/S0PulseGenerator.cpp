@@ -0,0 +1,218 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  S0 pulse generator for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "S0PulseGenerator.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Energy of 1 kWh in Ws */
+static const double     ENERGY_KWH          = 3600000.0;
+
+/** Resolution in s of the pulse time search. */
+static const double     PULSE_TIME_RES      = 1e-7;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+S0PulseGenerator::S0PulseGenerator(S0Smartmeter& s0Smartmeter, const LoadProfile& profile) :
+    m_s0Smartmeter(s0Smartmeter),
+    m_profile(profile),
+    m_energyPerPulse(ENERGY_KWH / s0Smartmeter.getPulsesPerKWh()),
+    m_start(VirtualClock::getMicros()),
+    m_lastPulseTime(0.0),
+    m_nextPulse(NO_EVENT),
+    m_nextGlitch(NO_EVENT),
+    m_nextProcess(m_start + DEFAULT_PROCESS_PERIOD),
+    m_processPeriod(DEFAULT_PROCESS_PERIOD),
+    m_jitter(0U),
+    m_glitchProbability(0U),
+    m_glitchMaxDelay(1U),
+    m_random(1U),
+    m_pulseCnt(0U),
+    m_glitchCnt(0U)
+{
+}
+
+void S0PulseGenerator::run(uint64_t duration)
+{
+    uint64_t end = VirtualClock::getMicros() + duration;
+
+    scheduleNextPulse(end);
+
+    while(true)
+    {
+        uint64_t next = m_nextPulse;
+
+        if (m_nextGlitch < next)
+        {
+            next = m_nextGlitch;
+        }
+
+        if ((0U < m_processPeriod) && (m_nextProcess < next))
+        {
+            next = m_nextProcess;
+        }
+
+        if ((NO_EVENT == next) || (end < next))
+        {
+            break;
+        }
+
+        VirtualClock::set(next);
+
+        if (next == m_nextGlitch)
+        {
+            m_s0Smartmeter.internalISR();
+            ++m_glitchCnt;
+
+            m_nextGlitch = NO_EVENT;
+        }
+        else if (next == m_nextPulse)
+        {
+            m_s0Smartmeter.internalISR();
+            ++m_pulseCnt;
+
+            m_nextPulse = NO_EVENT;
+
+            if ((0U < m_glitchProbability) &&
+                (m_glitchProbability > getRandom(1000U)))
+            {
+                m_nextGlitch = next + 1U + getRandom(m_glitchMaxDelay);
+            }
+
+            scheduleNextPulse(end);
+        }
+        else
+        {
+            m_s0Smartmeter.process();
+
+            m_nextProcess += m_processPeriod;
+        }
+    }
+
+    VirtualClock::set(end);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void S0PulseGenerator::scheduleNextPulse(uint64_t limit)
+{
+    double      target  = (m_pulseCnt + 1U) * m_energyPerPulse;
+    double      low     = m_lastPulseTime;
+    double      high    = static_cast<double>(limit - m_start) / 1e6;
+    uint64_t    now     = VirtualClock::getMicros();
+    uint64_t    pulse   = 0U;
+
+    if ((NO_EVENT != m_nextPulse) ||
+        (target > m_profile.getEnergy(high)))
+    {
+        return;
+    }
+
+    /* The energy never decreases, therefore the pulse time is found by bisection. */
+    while(PULSE_TIME_RES < (high - low))
+    {
+        double mid = (low + high) / 2.0;
+
+        if (target > m_profile.getEnergy(mid))
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    m_lastPulseTime = high;
+    pulse           = m_start + static_cast<uint64_t>(llround(high * 1e6));
+
+    if (0U < m_jitter)
+    {
+        uint32_t offset = getRandom(2U * m_jitter + 1U);
+
+        pulse = pulse + offset - m_jitter;
+    }
+
+    /* The jitter must not move the pulse into the past. */
+    if (now > pulse)
+    {
+        pulse = now;
+    }
+
+    m_nextPulse = pulse;
+}
+
+uint32_t S0PulseGenerator::getRandom(uint32_t range)
+{
+    /* Xorshift, which is fast and reproducible on every platform. */
+    m_random ^= m_random << 13U;
+    m_random ^= m_random >> 17U;
+    m_random ^= m_random << 5U;
+
+    return m_random % range;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,234 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  S0 pulse generator for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Drives a S0 smartmeter with the pulses of a load profile, like a real
+ * energy meter does. Every pulse calls S0Smartmeter::internalISR() at its
+ * time and S0Smartmeter::process() is called periodically, like by the
+ * main loop. The time is the virtual clock, which jumps from event to
+ * event. Therefore days of metering are simulated in milliseconds.
+ *
+ * The pulses can be disturbed by jitter and glitches (e.g. a bouncing
+ * signal). The disturbances are pseudo random, but reproducible by the seed.
+ *
+ * @addtogroup test
+ *
+ * @{
+ */
+
+#ifndef __S0_PULSE_GENERATOR_H__
+#define __S0_PULSE_GENERATOR_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+#include <S0Smartmeter.hpp>
+#include "LoadProfile.h"
+#include "VirtualClock.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * S0 pulse generator
+ */
+class S0PulseGenerator
+{
+public:
+
+    /**
+     * Constructs a pulse generator. The load profile starts at the current
+     * time of the virtual clock.
+     *
+     * @param[in] s0Smartmeter  S0 smartmeter, which receives the pulses.
+     * @param[in] profile       Load profile
+     */
+    S0PulseGenerator(S0Smartmeter& s0Smartmeter, const LoadProfile& profile);
+
+    /**
+     * Destroys the pulse generator.
+     */
+    ~S0PulseGenerator()
+    {
+    }
+
+    /**
+     * Set the max. jitter of every pulse.
+     *
+     * @param[in] jitter    Max. deviation in us in both directions
+     */
+    void setJitter(uint32_t jitter)
+    {
+        m_jitter = jitter;
+    }
+
+    /**
+     * Set the glitches, which follow a pulse.
+     *
+     * @param[in] probability   Probability in per mille, that a pulse is followed by a glitch.
+     * @param[in] maxDelay      Max. delay in us of the glitch after the pulse.
+     */
+    void setGlitches(uint16_t probability, uint32_t maxDelay)
+    {
+        m_glitchProbability = probability;
+        m_glitchMaxDelay    = (0U == maxDelay) ? 1U : maxDelay;
+    }
+
+    /**
+     * Set the seed of the pseudo random disturbances.
+     *
+     * @param[in] seed  Seed, which must not be 0.
+     */
+    void setSeed(uint32_t seed)
+    {
+        m_random = (0U == seed) ? 1U : seed;
+    }
+
+    /**
+     * Set the period in which S0Smartmeter::process() is called.
+     *
+     * @param[in] period    Period in us, 0 disables the calls.
+     */
+    void setProcessPeriod(uint32_t period)
+    {
+        m_processPeriod = period;
+        m_nextProcess   = VirtualClock::getMicros() + period;
+    }
+
+    /**
+     * Run the simulation for the given time, starting at the current time
+     * of the virtual clock. Afterwards the virtual clock is at the end.
+     *
+     * @param[in] duration  Duration in us
+     */
+    void run(uint64_t duration);
+
+    /**
+     * Run the simulation for the given time.
+     *
+     * @param[in] duration  Duration in s
+     */
+    void runSeconds(uint32_t duration)
+    {
+        run(static_cast<uint64_t>(duration) * 1000000U);
+    }
+
+    /**
+     * Get the number of generated pulses, without the glitches.
+     *
+     * @return Number of pulses
+     */
+    uint32_t getPulseCnt(void) const
+    {
+        return m_pulseCnt;
+    }
+
+    /**
+     * Get the number of generated glitches.
+     *
+     * @return Number of glitches
+     */
+    uint32_t getGlitchCnt(void) const
+    {
+        return m_glitchCnt;
+    }
+
+    /**
+     * Get the energy per pulse of the S0 smartmeter.
+     *
+     * @return Energy in Ws
+     */
+    double getEnergyPerPulse(void) const
+    {
+        return m_energyPerPulse;
+    }
+
+    /** Value of a event time, if there is no event. */
+    static const uint64_t   NO_EVENT                = UINT64_MAX;
+
+    /** Default period in us, in which S0Smartmeter::process() is called. */
+    static const uint32_t   DEFAULT_PROCESS_PERIOD  = 10000U;
+
+private:
+
+    S0Smartmeter&       m_s0Smartmeter;         /**< S0 smartmeter, which receives the pulses */
+    const LoadProfile&  m_profile;              /**< Load profile */
+    double              m_energyPerPulse;       /**< Energy per pulse in Ws */
+    uint64_t            m_start;                /**< Start time in us of the load profile */
+    double              m_lastPulseTime;        /**< Time in s since the start of the last pulse, without jitter */
+    uint64_t            m_nextPulse;            /**< Time in us of the next pulse */
+    uint64_t            m_nextGlitch;           /**< Time in us of the next glitch */
+    uint64_t            m_nextProcess;          /**< Time in us of the next process call */
+    uint32_t            m_processPeriod;        /**< Period in us of the process calls */
+    uint32_t            m_jitter;               /**< Max. jitter in us */
+    uint16_t            m_glitchProbability;    /**< Glitch probability in per mille */
+    uint32_t            m_glitchMaxDelay;       /**< Max. glitch delay in us */
+    uint32_t            m_random;               /**< State of the pseudo random generator */
+    uint32_t            m_pulseCnt;             /**< Number of generated pulses */
+    uint32_t            m_glitchCnt;            /**< Number of generated glitches */
+
+    /**
+     * Schedule the next pulse, if it occurs until the given time.
+     *
+     * @param[in] limit Time in us, after which the search stops.
+     */
+    void scheduleNextPulse(uint64_t limit);
+
+    /**
+     * Get the next pseudo random number.
+     *
+     * @param[in] range Range of the number, which must not be 0.
+     *
+     * @return Number in [0; range)
+     */
+    uint32_t getRandom(uint32_t range);
+
+    S0PulseGenerator();
+    S0PulseGenerator(const S0PulseGenerator& gen);
+    S0PulseGenerator& operator=(const S0PulseGenerator& gen);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __S0_PULSE_GENERATOR_H__ */
+
+/** @} */
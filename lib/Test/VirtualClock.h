@@ -0,0 +1,107 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Virtual clock for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The time source of millis() and micros() in test. The time only moves,
+ * if the test advances it. This way timing dependent logic is tested
+ * reproducibly and days can be simulated in milliseconds.
+ *
+ * @addtogroup test
+ *
+ * @{
+ */
+
+#ifndef __VIRTUAL_CLOCK_H__
+#define __VIRTUAL_CLOCK_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Virtual clock
+ */
+namespace VirtualClock
+{
+
+/**
+ * Set the time back to 0.
+ */
+void reset(void);
+
+/**
+ * Set the time.
+ *
+ * @param[in] us    Time in us
+ */
+void set(uint64_t us);
+
+/**
+ * Advance the time.
+ *
+ * @param[in] us    Duration in us
+ */
+void advanceMicros(uint64_t us);
+
+/**
+ * Advance the time.
+ *
+ * @param[in] ms    Duration in ms
+ */
+void advanceMillis(uint64_t ms);
+
+/**
+ * Get the time. Unlike micros(), it doesn't wrap around.
+ *
+ * @return Time in us
+ */
+uint64_t getMicros(void);
+
+};
+
+#endif  /* __VIRTUAL_CLOCK_H__ */
+
+/** @} */
@@ -0,0 +1,200 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Microbenchmark
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Bench.h"
+
+#if BENCH_ENABLED
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint16_t getTicks(void);
+static uint16_t measure(Bench::Func func, void* ctx);
+static void emptyFunc(void* ctx);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of runs, to determine the measurement overhead. */
+static const uint8_t    CALIBRATION_RUNS    = 8U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+void Bench::init(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        /* Timer 1 in normal mode with prescaler 8, see TICK_CYCLES. */
+        TCCR1A  = 0U;
+        TCCR1B  = _BV(CS11);
+    }
+
+    return;
+}
+
+void Bench::run(Func func, void* ctx, uint8_t iterations, Result& result)
+{
+    uint16_t    overhead    = UINT16_MAX;
+    uint16_t    minTicks    = UINT16_MAX;
+    uint16_t    maxTicks    = 0U;
+    uint32_t    sumTicks    = 0U;
+    uint8_t     idx         = 0U;
+
+    /* The call of an empty function is the measurement overhead. */
+    for(idx = 0U; idx < CALIBRATION_RUNS; ++idx)
+    {
+        uint16_t ticks = measure(emptyFunc, nullptr);
+
+        if (overhead > ticks)
+        {
+            overhead = ticks;
+        }
+    }
+
+    for(idx = 0U; idx < iterations; ++idx)
+    {
+        uint16_t ticks = measure(func, ctx);
+
+        ticks = (overhead < ticks) ? (ticks - overhead) : 0U;
+
+        if (minTicks > ticks)
+        {
+            minTicks = ticks;
+        }
+
+        if (maxTicks < ticks)
+        {
+            maxTicks = ticks;
+        }
+
+        sumTicks += ticks;
+    }
+
+    if (0U == iterations)
+    {
+        minTicks = 0U;
+    }
+    else
+    {
+        sumTicks /= iterations;
+    }
+
+    result.minCycles = static_cast<uint32_t>(minTicks) * TICK_CYCLES;
+    result.avgCycles = sumTicks * TICK_CYCLES;
+    result.maxCycles = static_cast<uint32_t>(maxTicks) * TICK_CYCLES;
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the current value of the free running timer. The 16-bit timer register
+ * is read with masked interrupts, because an interrupt service routine may
+ * access the timer and change the temporary register in between.
+ *
+ * @return Timer value in ticks
+ */
+static uint16_t getTicks(void)
+{
+    uint16_t ticks = 0U;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        ticks = TCNT1;
+    }
+
+    return ticks;
+}
+
+/**
+ * Measure a single run of a function.
+ *
+ * @param[in] func  Function
+ * @param[in] ctx   Context, passed to the function
+ *
+ * @return Duration in timer ticks
+ */
+static uint16_t measure(Bench::Func func, void* ctx)
+{
+    uint16_t start = getTicks();
+
+    func(ctx);
+
+    return getTicks() - start;
+}
+
+/**
+ * Empty function, used for calibration.
+ *
+ * @param[in] ctx   Not used
+ */
+static void emptyFunc(void* ctx)
+{
+    (void)ctx;
+
+    return;
+}
+
+#endif  /* BENCH_ENABLED */
@@ -0,0 +1,131 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Microbenchmark
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Measures the CPU cycles of a function on the target. The free running
+ * timer 1 is used as cycle counter, therefore the resolution is
+ * Bench::TICK_CYCLES. It runs in the same mode as the one of the critical
+ * section profiler, so both can be enabled together.
+ *
+ * @{
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/**
+ * Enable the microbenchmarks with a 1 or disable them with 0.
+ * They need the AVR timer 1, therefore they are enabled by default in AVR
+ * debug builds only.
+ */
+#if !defined(BENCH_ENABLED)
+
+#if defined(__AVR__) && defined(DEBUG)
+#define BENCH_ENABLED   (1)
+#else   /* not (defined(__AVR__) && defined(DEBUG)) */
+#define BENCH_ENABLED   (0)
+#endif  /* not (defined(__AVR__) && defined(DEBUG)) */
+
+#endif  /* !defined(BENCH_ENABLED) */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "Hal.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+#if BENCH_ENABLED
+
+/**
+ * Microbenchmark
+ */
+namespace Bench
+{
+
+/**
+ * Function, which to benchmark.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+typedef void (*Func)(void* ctx);
+
+/** This type defines the result of a benchmark. */
+struct Result
+{
+    uint32_t    minCycles;  /**< Min. number of CPU cycles of a single run */
+    uint32_t    avgCycles;  /**< Average number of CPU cycles of a single run */
+    uint32_t    maxCycles;  /**< Max. number of CPU cycles of a single run */
+};
+
+/** Number of CPU cycles per timer tick. Timer 1 runs with F_CPU / 8. */
+static const uint8_t    TICK_CYCLES = 8U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Initialize the microbenchmarks. It starts the free running timer 1.
+ */
+void init(void);
+
+/**
+ * Run a benchmark several times and measure the CPU cycles of every run.
+ * The overhead of the measurement itself is subtracted. The interrupts stay
+ * enabled, therefore the min. number of cycles is the one without any
+ * interference.
+ *
+ * A single run must not take longer than 65535 timer ticks (32 ms).
+ *
+ * @param[in]   func        Function, which to benchmark
+ * @param[in]   ctx         Benchmark context, passed to the function
+ * @param[in]   iterations  Number of runs
+ * @param[out]  result      Result
+ */
+void run(Func func, void* ctx, uint8_t iterations, Result& result);
+
+};
+
+#endif  /* BENCH_ENABLED */
+
+#endif  /* __BENCH_H__ */
+
+/** @} */
@@ -52,6 +52,68 @@
  */
 #define CONFIG_S0_SMARTMETER_MAX_NUM    (2)
 
+/**
+ * Size in bytes of the log record ring buffer.
+ * A log record needs 16 bytes RAM plus the length of a message in RAM.
+ * It must hold the largest burst of log records without dropping one: the
+ * network settings, which are 4 records with messages in RAM (about 38 bytes
+ * each). If the log records are produced faster than sent, the oldest ones
+ * are dropped.
+ */
+#define CONFIG_LOG_RING_SIZE            (192)
+
+/**
+ * Max. number of syslog datagrams per second.
+ */
+#define CONFIG_SYSLOG_RATE              (2)
+
+/**
+ * Max. number of syslog datagrams, which may be sent in a burst above the rate.
+ */
+#define CONFIG_SYSLOG_BURST             (4)
+
+/**
+ * Max. number of log records, which are sent together in one datagram.
+ * With 1 every log record is sent in its own datagram (RFC 5426), which every
+ * collector understands. A greater batch lets a burst of log records through
+ * the rate limit, but the collector must support the framing, see
+ * CONFIG_SYSLOG_OCTET_COUNTING.
+ */
+#define CONFIG_SYSLOG_BATCH_SIZE        (1)
+
+/**
+ * Framing of the syslog messages in a datagram with several log records.
+ * With 1 every message is prefixed by its length and a space (octet counting,
+ * RFC 6587). With 0 every message is terminated by a line feed (non-transparent
+ * framing, RFC 6587).
+ */
+#define CONFIG_SYSLOG_OCTET_COUNTING    (1)
+
+/**
+ * Number of records in the ISR trace buffer (debug builds only).
+ * Every record needs 6 bytes RAM.
+ */
+#define CONFIG_ISR_TRACE_SIZE           (64)
+
+/**
+ * Min. period in ms between two pulses of a S0 interface. A shorter one is
+ * handled as anomaly (e.g. a bouncing signal) and freezes the ISR trace.
+ */
+#define CONFIG_ISR_TRACE_MIN_PULSE_PERIOD   (20)
+
+/**
+ * Number of records in the pulse log ring buffer, max. 255.
+ * Every record needs 5 bytes RAM. Poll the pulse log faster than it fills up.
+ */
+#define CONFIG_PULSE_LOG_SIZE           (32)
+
+/**
+ * Number of delta read cursors, one per consumer of GET /api/s0-interfaces/delta.
+ * The cursor ids are fixed, every consumer must be configured with its own id.
+ * Every cursor needs 4 bytes RAM per S0 interface plus 4 bytes.
+ */
+#define CONFIG_DELTA_CURSOR_NUM         (2)
+
 /*******************************************************************************
     MACROS
 *******************************************************************************/
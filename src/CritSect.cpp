@@ -0,0 +1,210 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Critical section profiler
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "CritSect.h"
+
+#if CRIT_SECT_PROFILING_ENABLED
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Latency probe period in ticks (5 ms). */
+static const uint16_t           PROBE_PERIOD    = static_cast<uint16_t>(5000000UL / CritSect::TICK_NS);
+
+/** Statistics per call site. */
+static CritSect::Stats          gStats[CritSect::SITE_MAX];
+
+/** Latency probe statistics. */
+static CritSect::LatencyStats   gLatencyStats;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+void CritSect::init(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        /* Timer 1 in normal mode with prescaler 8, see TICK_CYCLES. */
+        TCCR1A  = 0U;
+        TCCR1B  = _BV(CS11);
+
+        /* The latency probe is the compare match A interrupt. */
+        OCR1A   = TCNT1 + PROBE_PERIOD;
+        TIFR1   = _BV(OCF1A);
+        TIMSK1 |= _BV(OCIE1A);
+    }
+
+    clear();
+
+    return;
+}
+
+void CritSect::record(Site site, uint16_t ticks)
+{
+    if (SITE_MAX > site)
+    {
+        Stats& stats = gStats[site];
+
+        ++stats.count;
+        stats.totalTicks += ticks;
+
+        if (stats.maxTicks < ticks)
+        {
+            stats.maxTicks = ticks;
+        }
+    }
+
+    return;
+}
+
+void CritSect::getStats(Site site, Stats& stats)
+{
+    if (SITE_MAX > site)
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            stats = gStats[site];
+        }
+    }
+
+    return;
+}
+
+void CritSect::getLatencyStats(LatencyStats& stats)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        stats = gLatencyStats;
+    }
+
+    return;
+}
+
+void CritSect::clear(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        memset(gStats, 0, sizeof(gStats));
+        memset(&gLatencyStats, 0, sizeof(gLatencyStats));
+    }
+
+    return;
+}
+
+const __FlashStringHelper* CritSect::siteToStr(Site site)
+{
+    const __FlashStringHelper* str = nullptr;
+
+    switch(site)
+    {
+    case SITE_S0_GET_PULSE_CNT:
+        str = F("S0Smartmeter::getPulseCnt");
+        break;
+
+    case SITE_S0_GET_RESULT:
+        str = F("S0Smartmeter::getResult");
+        break;
+
+    case SITE_S0_PROCESS:
+        str = F("S0Smartmeter::process");
+        break;
+
+    case SITE_S0_SNAPSHOT:
+        str = F("S0Snapshot::capture");
+        break;
+
+    default:
+        str = F("?");
+        break;
+    }
+
+    return str;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Latency probe. The compare match happens at a known timer value, therefore
+ * the difference to the current timer value is the interrupt latency. It is
+ * caused by masked interrupts and by other interrupt service routines.
+ */
+ISR(TIMER1_COMPA_vect)
+{
+    uint16_t latency = TCNT1 - OCR1A;
+
+    ++gLatencyStats.count;
+
+    if (gLatencyStats.maxTicks < latency)
+    {
+        gLatencyStats.maxTicks = latency;
+    }
+
+    OCR1A += PROBE_PERIOD;
+
+    return;
+}
+
+#endif  /* CRIT_SECT_PROFILING_ENABLED */
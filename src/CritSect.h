@@ -0,0 +1,277 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Critical section profiler
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The pulse timing depends on short interrupt-masked windows. Every critical
+ * section, which is entered via CRITICAL_SECTION(), records how long the
+ * interrupts were masked per call site. Because the windows inside libraries
+ * (e.g. EthernetENC) can't be instrumented, a latency probe additionally
+ * measures the max. interrupt latency, independent of its cause.
+ *
+ * All times are in ticks of the free running timer 1.
+ *
+ * @{
+ */
+
+#ifndef __CRIT_SECT_H__
+#define __CRIT_SECT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/**
+ * Enable the critical section profiling with a 1 or disable it with 0.
+ * If disabled, CRITICAL_SECTION() is a plain HAL_ATOMIC_BLOCK().
+ * It needs the AVR timer 1 and a latency probe interrupt, therefore it is
+ * enabled by default in AVR debug builds only.
+ */
+#if !defined(CRIT_SECT_PROFILING_ENABLED)
+
+#if defined(__AVR__) && defined(DEBUG)
+#define CRIT_SECT_PROFILING_ENABLED (1)
+#else   /* not (defined(__AVR__) && defined(DEBUG)) */
+#define CRIT_SECT_PROFILING_ENABLED (0)
+#endif  /* not (defined(__AVR__) && defined(DEBUG)) */
+
+#endif  /* !defined(CRIT_SECT_PROFILING_ENABLED) */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "Hal.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#if CRIT_SECT_PROFILING_ENABLED
+
+/**
+ * Execute the following block with masked interrupts, like
+ * ATOMIC_BLOCK(ATOMIC_RESTORESTATE), and record the duration.
+ *
+ * Example:
+ * CRITICAL_SECTION(CritSect::SITE_S0_GET_PULSE_CNT)
+ * {
+ *     pulseCnt = m_pulseCnt;
+ * }
+ */
+#define CRITICAL_SECTION(_site) \
+    for(CritSect::Guard _critSectGuard(_site); true == _critSectGuard.enter(); )
+
+#else   /* not CRIT_SECT_PROFILING_ENABLED */
+
+#define CRITICAL_SECTION(_site) HAL_ATOMIC_BLOCK()
+
+#endif  /* not CRIT_SECT_PROFILING_ENABLED */
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+#if CRIT_SECT_PROFILING_ENABLED
+
+/**
+ * Critical section profiler
+ */
+namespace CritSect
+{
+
+/** This type defines the profiled critical section call sites. */
+enum Site
+{
+    SITE_S0_GET_PULSE_CNT = 0,  /**< S0Smartmeter::getPulseCnt() */
+    SITE_S0_GET_RESULT,         /**< S0Smartmeter::getResult() */
+    SITE_S0_PROCESS,            /**< S0Smartmeter::process() */
+    SITE_S0_SNAPSHOT,           /**< S0Snapshot::capture() */
+    SITE_MAX                    /**< Number of call sites */
+};
+
+/** This type defines the statistics of a single call site. */
+struct Stats
+{
+    uint32_t    count;      /**< Number of times, the critical section was entered */
+    uint32_t    totalTicks; /**< Total time with masked interrupts in ticks */
+    uint16_t    maxTicks;   /**< Max. time with masked interrupts in ticks */
+};
+
+/** This type defines the statistics of the latency probe. */
+struct LatencyStats
+{
+    uint32_t    count;      /**< Number of probes */
+    uint16_t    maxTicks;   /**< Max. interrupt latency in ticks */
+};
+
+/** Number of CPU cycles per timer tick. Timer 1 runs with F_CPU / 8. */
+static const uint8_t    TICK_CYCLES = 8U;
+
+/** Duration of a timer tick in ns. */
+static const uint16_t   TICK_NS     = static_cast<uint16_t>((TICK_CYCLES * 1000000000ULL) / F_CPU);
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Initialize the profiler. It starts the free running timer 1 and the
+ * latency probe.
+ */
+void init(void);
+
+/**
+ * Record the duration of a critical section.
+ * Call it only with masked interrupts!
+ *
+ * @param[in] site  Call site
+ * @param[in] ticks Duration in ticks
+ */
+void record(Site site, uint16_t ticks);
+
+/**
+ * Get a consistent copy of the statistics of a call site.
+ *
+ * @param[in]   site    Call site
+ * @param[out]  stats   Statistics
+ */
+void getStats(Site site, Stats& stats);
+
+/**
+ * Get a consistent copy of the latency probe statistics.
+ *
+ * @param[out] stats    Statistics
+ */
+void getLatencyStats(LatencyStats& stats);
+
+/**
+ * Clear all statistics.
+ */
+void clear(void);
+
+/**
+ * Get the user friendly name of a call site.
+ *
+ * @param[in] site  Call site
+ *
+ * @return Name in program memory
+ */
+const __FlashStringHelper* siteToStr(Site site);
+
+/**
+ * Get the current value of the free running timer. The 16-bit timer register
+ * is read with masked interrupts, because an interrupt service routine may
+ * access the timer and change the temporary register in between.
+ *
+ * @return Timer value in ticks
+ */
+inline uint16_t getTicks(void)
+{
+    uint16_t ticks = 0U;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        ticks = TCNT1;
+    }
+
+    return ticks;
+}
+
+/**
+ * Masks the interrupts during its lifetime and records the duration.
+ * Only the outermost critical section is recorded, because a nested one
+ * doesn't extend the interrupt-masked window.
+ */
+class Guard
+{
+public:
+
+    /**
+     * Mask the interrupts and start the measurement.
+     *
+     * @param[in] site  Call site
+     */
+    Guard(Site site) :
+        m_site(site),
+        m_sreg(SREG),
+        m_start(0U),
+        m_isEntered(false)
+    {
+        cli();
+        m_start = TCNT1;
+    }
+
+    /**
+     * Record the duration and restore the interrupt state.
+     */
+    ~Guard()
+    {
+        uint16_t ticks = TCNT1 - m_start;
+
+        if (0U != (m_sreg & _BV(SREG_I)))
+        {
+            record(m_site, ticks);
+        }
+
+        SREG = m_sreg;
+    }
+
+    /**
+     * Enter the critical section block once.
+     *
+     * @return On the first call it returns true, otherwise false.
+     */
+    bool enter(void)
+    {
+        bool isFirst = (false == m_isEntered);
+
+        m_isEntered = true;
+
+        return isFirst;
+    }
+
+private:
+
+    Site        m_site;         /**< Call site */
+    uint8_t     m_sreg;         /**< Status register before the interrupts were masked */
+    uint16_t    m_start;        /**< Timer value at the start */
+    bool        m_isEntered;    /**< Is the block entered? */
+
+    Guard();
+    Guard(const Guard& guard);
+    Guard& operator=(const Guard& guard);
+};
+
+};
+
+#endif  /* CRIT_SECT_PROFILING_ENABLED */
+
+#endif  /* __CRIT_SECT_H__ */
+
+/** @} */
@@ -0,0 +1,151 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Delta read cursors
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Every consumer of the pulse counters, e.g. a home automation and a data
+ * logger, gets its own cursor. A read provides the pulses since the last
+ * read with the same cursor and moves the cursor to the current counters.
+ * Therefore no pulse is counted twice or lost, regardless how often the
+ * other consumers read. All cursors start at zero, which is the counter
+ * value after a reset.
+ *
+ * @{
+ */
+
+#ifndef __DELTA_CURSORS_HPP__
+#define __DELTA_CURSORS_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Fixed table of delta read cursors.
+ *
+ * @tparam NUM_CURSORS  Number of cursors
+ * @tparam NUM_COUNTERS Number of pulse counters per cursor
+ */
+template < uint8_t NUM_CURSORS, uint8_t NUM_COUNTERS >
+class DeltaCursors
+{
+public:
+
+    /**
+     * Constructs the cursor table. All cursors start at zero.
+     */
+    DeltaCursors() :
+        m_pulseCnts(),
+        m_timestamps()
+    {
+        (void)memset(m_pulseCnts, 0, sizeof(m_pulseCnts));
+        (void)memset(m_timestamps, 0, sizeof(m_timestamps));
+    }
+
+    /**
+     * Destroys the cursor table.
+     */
+    ~DeltaCursors()
+    {
+    }
+
+    /**
+     * Get the number of cursors.
+     *
+     * @return Number of cursors
+     */
+    uint8_t getNumCursors(void) const
+    {
+        return NUM_CURSORS;
+    }
+
+    /**
+     * Read the deltas of a cursor and move it to the given counter values.
+     * The counters may wrap around, the deltas are calculated modulo 2^32.
+     *
+     * @param[in]   cursorId    Cursor id
+     * @param[in]   pulseCnts   Current pulse counters
+     * @param[in]   timestamp   Current timestamp in ms
+     * @param[out]  deltas      Pulses since the last read with this cursor
+     * @param[out]  duration    Duration in ms since the last read with this cursor
+     *
+     * @return If the cursor id is valid, it will return true otherwise false.
+     */
+    bool read(uint8_t cursorId, const uint32_t (&pulseCnts)[NUM_COUNTERS], uint32_t timestamp, uint32_t (&deltas)[NUM_COUNTERS], uint32_t& duration)
+    {
+        bool isValid = false;
+
+        if (NUM_CURSORS > cursorId)
+        {
+            uint8_t idx = 0U;
+
+            for(idx = 0U; idx < NUM_COUNTERS; ++idx)
+            {
+                deltas[idx]                 = pulseCnts[idx] - m_pulseCnts[cursorId][idx];
+                m_pulseCnts[cursorId][idx]  = pulseCnts[idx];
+            }
+
+            duration                = timestamp - m_timestamps[cursorId];
+            m_timestamps[cursorId]  = timestamp;
+
+            isValid = true;
+        }
+
+        return isValid;
+    }
+
+private:
+
+    uint32_t    m_pulseCnts[NUM_CURSORS][NUM_COUNTERS]; /**< Pulse counters at the last read per cursor */
+    uint32_t    m_timestamps[NUM_CURSORS];              /**< Timestamp in ms of the last read per cursor */
+
+    DeltaCursors(const DeltaCursors& cursors);
+    DeltaCursors& operator=(const DeltaCursors& cursors);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DELTA_CURSORS_HPP__ */
+
+/** @} */
@@ -0,0 +1,363 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Form parser
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FormParser.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+FormParser::FormParser(const Field* fieldsP, uint8_t numFields, char* valueBuffer, size_t valueBufferSize, void* ctx) :
+    m_fieldsP(fieldsP),
+    m_numFields((MAX_FIELDS < numFields) ? MAX_FIELDS : numFields),
+    m_value(valueBuffer),
+    m_valueSize(valueBufferSize),
+    m_ctx(ctx),
+    m_state(STATE_KEY),
+    m_decode(DECODE_NONE),
+    m_hexHigh('\0'),
+    m_candidates(0U),
+    m_keyLen(0U),
+    m_fieldIdx(NO_FIELD),
+    m_valueLen(0U)
+{
+    beginPair();
+}
+
+void FormParser::parse(char data)
+{
+    if (DECODE_NONE == m_decode)
+    {
+        parseRaw(data);
+    }
+    else
+    {
+        uint8_t nibble = 0U;
+
+        /* Not a valid percent encoded character? Take it literally. */
+        if (false == hexToValue(data, nibble))
+        {
+            flushDecode();
+            parseRaw(data);
+        }
+        else if (DECODE_HEX_HIGH == m_decode)
+        {
+            m_hexHigh   = data;
+            m_decode    = DECODE_HEX_LOW;
+        }
+        else
+        {
+            uint8_t high = 0U;
+
+            (void)hexToValue(m_hexHigh, high);
+
+            m_decode = DECODE_NONE;
+            parseDecoded(static_cast<char>((high << 4U) | nibble));
+        }
+    }
+
+    return;
+}
+
+void FormParser::parse(const char* data, size_t size)
+{
+    if (nullptr != data)
+    {
+        while(0U < size)
+        {
+            parse(*data);
+
+            ++data;
+            --size;
+        }
+    }
+
+    return;
+}
+
+void FormParser::finish(void)
+{
+    flushDecode();
+
+    /* Ignore empty data, e.g. a trailing '&'. */
+    if ((STATE_VALUE == m_state) ||
+        (0U < m_keyLen))
+    {
+        endPair();
+    }
+
+    beginPair();
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void FormParser::beginPair(void)
+{
+    m_state         = STATE_KEY;
+    m_decode        = DECODE_NONE;
+    m_candidates    = (MAX_FIELDS <= m_numFields) ? UINT16_MAX : ((1U << m_numFields) - 1U);
+    m_keyLen        = 0U;
+    m_fieldIdx      = NO_FIELD;
+    m_valueLen      = 0U;
+
+    return;
+}
+
+void FormParser::endPair(void)
+{
+    /* A key without value is handled like a key with an empty value. */
+    if (STATE_KEY == m_state)
+    {
+        endKey();
+    }
+
+    if ((NO_FIELD != m_fieldIdx) &&
+        (nullptr != m_value) &&
+        (0U < m_valueSize))
+    {
+        FieldHandler handler = reinterpret_cast<FieldHandler>(pgm_read_ptr(&m_fieldsP[m_fieldIdx].handler));
+
+        m_value[m_valueLen] = '\0';
+
+        if (nullptr != handler)
+        {
+            handler(m_ctx, m_value);
+        }
+    }
+
+    beginPair();
+
+    return;
+}
+
+void FormParser::endKey(void)
+{
+    uint8_t idx = 0U;
+
+    m_fieldIdx = NO_FIELD;
+
+    /* Only a key, which matches completely and has the same length is the right one. */
+    while((m_numFields > idx) && (NO_FIELD == m_fieldIdx))
+    {
+        if ((0U != (m_candidates & (1U << idx))) &&
+            ('\0' == pgm_read_byte(getKeyP(idx) + m_keyLen)))
+        {
+            m_fieldIdx = idx;
+        }
+        else
+        {
+            ++idx;
+        }
+    }
+
+    m_state     = STATE_VALUE;
+    m_valueLen  = 0U;
+
+    return;
+}
+
+void FormParser::parseRaw(char data)
+{
+    switch(data)
+    {
+    case '&':
+        endPair();
+        break;
+
+    case '=':
+        if (STATE_KEY == m_state)
+        {
+            endKey();
+        }
+        else
+        {
+            parseDecoded(data);
+        }
+        break;
+
+    case '+':
+        parseDecoded(' ');
+        break;
+
+    case '%':
+        m_decode = DECODE_HEX_HIGH;
+        break;
+
+    default:
+        parseDecoded(data);
+        break;
+    }
+
+    return;
+}
+
+void FormParser::parseDecoded(char data)
+{
+    if (STATE_KEY == m_state)
+    {
+        if (0U != m_candidates)
+        {
+            uint8_t idx = 0U;
+
+            /* Sort out all fields, whose key doesn't match anymore. */
+            for(idx = 0U; idx < m_numFields; ++idx)
+            {
+                if (0U != (m_candidates & (1U << idx)))
+                {
+                    char keyChar = static_cast<char>(pgm_read_byte(getKeyP(idx) + m_keyLen));
+
+                    /* The end of the key must never be passed, even if a
+                     * decoded zero is received.
+                     */
+                    if (('\0' == keyChar) ||
+                        (keyChar != data))
+                    {
+                        m_candidates &= ~(1U << idx);
+                    }
+                }
+            }
+
+            /* A key, which is longer than any known key, can't match. */
+            if (UINT8_MAX > m_keyLen)
+            {
+                ++m_keyLen;
+            }
+            else
+            {
+                m_candidates = 0U;
+            }
+        }
+        else
+        {
+            /* Still remember that there is a key at all. */
+            m_keyLen = 1U;
+        }
+    }
+    /* Only the value of a known field is stored, if there is space left.
+     * Otherwise the value is skipped or truncated.
+     */
+    else if ((NO_FIELD != m_fieldIdx) &&
+             (nullptr != m_value) &&
+             ((m_valueLen + 1U) < m_valueSize))
+    {
+        m_value[m_valueLen] = data;
+        ++m_valueLen;
+    }
+
+    return;
+}
+
+void FormParser::flushDecode(void)
+{
+    Decode decode = m_decode;
+
+    m_decode = DECODE_NONE;
+
+    if (DECODE_NONE != decode)
+    {
+        parseDecoded('%');
+
+        if (DECODE_HEX_LOW == decode)
+        {
+            parseDecoded(m_hexHigh);
+        }
+    }
+
+    return;
+}
+
+const char* FormParser::getKeyP(uint8_t idx) const
+{
+    return reinterpret_cast<const char*>(pgm_read_ptr(&m_fieldsP[idx].keyP));
+}
+
+bool FormParser::hexToValue(char data, uint8_t& value)
+{
+    bool isValid = true;
+
+    if (('0' <= data) && ('9' >= data))
+    {
+        value = static_cast<uint8_t>(data - '0');
+    }
+    else if (('a' <= data) && ('f' >= data))
+    {
+        value = static_cast<uint8_t>(data - 'a' + 10);
+    }
+    else if (('A' <= data) && ('F' >= data))
+    {
+        value = static_cast<uint8_t>(data - 'A' + 10);
+    }
+    else
+    {
+        isValid = false;
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
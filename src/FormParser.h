@@ -0,0 +1,228 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Form parser
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Streaming parser for application/x-www-form-urlencoded data.
+ *
+ * @{
+ */
+
+#ifndef __FORM_PARSER_H__
+#define __FORM_PARSER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Streaming parser for application/x-www-form-urlencoded data.
+ *
+ * The data is fed byte by byte, therefore the whole form must never be
+ * available in memory. Keys and values are percent and '+' decoded. The keys
+ * are matched against a field table in program memory, while they arrive.
+ * For every known key, the corresponding field handler is called with its
+ * decoded value. Unknown keys are skipped.
+ *
+ * No memory is allocated. The value is decoded into a buffer, provided by
+ * the user. Values which don't fit into the buffer are truncated.
+ */
+class FormParser
+{
+public:
+
+    /**
+     * Form field handler, called with the decoded value of a field.
+     *
+     * @param[in] ctx   User context
+     * @param[in] value Decoded and zero terminated value
+     */
+    typedef void (*FieldHandler)(void* ctx, const char* value);
+
+    /**
+     * A single form field. The field table must be stored in program memory.
+     */
+    struct Field
+    {
+        const char*     keyP;       /**< Field key, stored in program memory */
+        FieldHandler    handler;    /**< Field handler */
+    };
+
+    /**
+     * Constructs a form parser.
+     *
+     * @param[in] fieldsP           Field table in program memory
+     * @param[in] numFields         Number of fields in the table (max. MAX_FIELDS)
+     * @param[in] valueBuffer       Buffer, used to decode a value
+     * @param[in] valueBufferSize   Value buffer size in bytes, incl. string termination
+     * @param[in] ctx               User context, which is passed to the field handlers
+     */
+    FormParser(const Field* fieldsP, uint8_t numFields, char* valueBuffer, size_t valueBufferSize, void* ctx);
+
+    /**
+     * Destroys the form parser.
+     */
+    ~FormParser()
+    {
+    }
+
+    /**
+     * Parse a single byte of the form data.
+     *
+     * @param[in] data  Raw data byte
+     */
+    void parse(char data);
+
+    /**
+     * Parse several bytes of the form data.
+     *
+     * @param[in] data  Raw data
+     * @param[in] size  Raw data size in bytes
+     */
+    void parse(const char* data, size_t size);
+
+    /**
+     * Signal the end of the form data. A pending key/value pair is completed.
+     * Afterwards the parser is ready for the next form.
+     */
+    void finish(void);
+
+    /** Max. number of fields in the field table. */
+    static const uint8_t    MAX_FIELDS  = 16U;
+
+private:
+
+    /** Parser states */
+    enum State
+    {
+        STATE_KEY = 0,  /**< Parsing a key */
+        STATE_VALUE     /**< Parsing a value */
+    };
+
+    /** Percent decoding states */
+    enum Decode
+    {
+        DECODE_NONE = 0,    /**< No percent encoded character pending */
+        DECODE_HEX_HIGH,    /**< Waiting for the high nibble */
+        DECODE_HEX_LOW      /**< Waiting for the low nibble */
+    };
+
+    /** Field index, used in case no field matches. */
+    static const uint8_t    NO_FIELD    = UINT8_MAX;
+
+    const Field*    m_fieldsP;          /**< Field table in program memory */
+    uint8_t         m_numFields;        /**< Number of fields in the table */
+    char*           m_value;            /**< Value buffer */
+    size_t          m_valueSize;        /**< Value buffer size in bytes */
+    void*           m_ctx;              /**< User context */
+    State           m_state;            /**< Parser state */
+    Decode          m_decode;           /**< Percent decoding state */
+    char            m_hexHigh;          /**< Raw high nibble character of a percent encoded character */
+    uint16_t        m_candidates;       /**< Bitfield of fields, whose key matches so far */
+    uint8_t         m_keyLen;           /**< Number of key characters so far */
+    uint8_t         m_fieldIdx;         /**< Index of the field, whose value is parsed */
+    size_t          m_valueLen;         /**< Number of value characters so far */
+
+    /**
+     * Reset the parser to start with a new key/value pair.
+     */
+    void beginPair(void);
+
+    /**
+     * Complete the current key/value pair.
+     */
+    void endPair(void);
+
+    /**
+     * Complete the key and start with the value.
+     */
+    void endKey(void);
+
+    /**
+     * Handle a raw data byte, which is not part of a percent encoded character.
+     *
+     * @param[in] data  Raw data byte
+     */
+    void parseRaw(char data);
+
+    /**
+     * Handle a decoded character.
+     *
+     * @param[in] data  Decoded character
+     */
+    void parseDecoded(char data);
+
+    /**
+     * Flush a pending incomplete percent encoded character literally.
+     */
+    void flushDecode(void);
+
+    /**
+     * Get the key of a field from the table.
+     *
+     * @param[in] idx   Field index
+     *
+     * @return Key, stored in program memory
+     */
+    const char* getKeyP(uint8_t idx) const;
+
+    /**
+     * Convert a hex character to its value.
+     *
+     * @param[in]   data    Hex character
+     * @param[out]  value   Value
+     *
+     * @return If the character is a valid hex character, it will return true otherwise false.
+     */
+    static bool hexToValue(char data, uint8_t& value);
+
+    FormParser();
+    FormParser(const FormParser& parser);
+    FormParser& operator=(const FormParser& parser);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FORM_PARSER_H__ */
+
+/** @} */
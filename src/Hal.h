@@ -0,0 +1,205 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Hardware abstraction layer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Hides the hardware, which the firmware accesses directly: the S0 input port
+ * with its pin change interrupt, the EEPROM and the reset. The backend is
+ * selected at compile time:
+ * - AVR: The ATmega644P of the AVR-NET-IO board.
+ * - Linux (HAL_LINUX): The firmware runs as a process, see HalLinux.h.
+ * - Test (HAL_TEST): Host tests, see lib/Test/HalTest.h.
+ *
+ * The time source is the Arduino millis()/micros() and the TCP/IP stack is
+ * used via the EthernetENC API. Both are provided on Linux by lib/Linux.
+ *
+ * @{
+ */
+
+#ifndef __HAL_H__
+#define __HAL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Hardware abstraction layer
+ */
+namespace Hal
+{
+
+/**
+ * Read the input value of the port, where the S0 interfaces are connected.
+ *
+ * @return Port input value
+ */
+uint8_t readS0Port(void);
+
+/**
+ * Enable the pin change interrupt of a S0 port pin.
+ *
+ * @param[in] bitNo Port bit number
+ */
+void enableS0PinChange(uint8_t bitNo);
+
+/**
+ * Disable the pin change interrupt of a S0 port pin.
+ *
+ * @param[in] bitNo Port bit number
+ */
+void disableS0PinChange(uint8_t bitNo);
+
+/**
+ * Get the S0 port pins, whose pin change interrupt is enabled.
+ *
+ * @return Pin change mask
+ */
+uint8_t getS0PinChangeMask(void);
+
+/**
+ * Enable the pin change interrupt of the S0 port in general.
+ */
+void enableS0Interrupt(void);
+
+/**
+ * Read a byte from the EEPROM.
+ *
+ * @param[in] addr  EEPROM address
+ *
+ * @return Data byte
+ */
+uint8_t eepromRead(uint16_t addr);
+
+/**
+ * Write a byte to the EEPROM, but only if it differs from the stored one.
+ *
+ * @param[in] addr  EEPROM address
+ * @param[in] value Data byte
+ */
+void eepromUpdate(uint16_t addr, uint8_t value);
+
+/**
+ * Read a object from the EEPROM.
+ *
+ * @param[in]   addr    EEPROM address
+ * @param[out]  obj     Object
+ */
+template < typename T >
+void eepromGet(uint16_t addr, T& obj)
+{
+    uint8_t*    data    = reinterpret_cast<uint8_t*>(&obj);
+    uint16_t    idx     = 0U;
+
+    for(idx = 0U; idx < sizeof(T); ++idx)
+    {
+        data[idx] = eepromRead(addr + idx);
+    }
+
+    return;
+}
+
+/**
+ * Compare a object with the one in the EEPROM.
+ *
+ * @param[in] addr  EEPROM address
+ * @param[in] obj   Object
+ *
+ * @return If the object is equal to the stored one, it will return true otherwise false.
+ */
+template < typename T >
+bool eepromIsEqual(uint16_t addr, const T& obj)
+{
+    const uint8_t*  data    = reinterpret_cast<const uint8_t*>(&obj);
+    uint16_t        idx     = 0U;
+
+    while((sizeof(T) > idx) && (data[idx] == eepromRead(addr + idx)))
+    {
+        ++idx;
+    }
+
+    return (sizeof(T) == idx);
+}
+
+/**
+ * Write a object to the EEPROM. Only the bytes which changed are written.
+ *
+ * @param[in] addr  EEPROM address
+ * @param[in] obj   Object
+ */
+template < typename T >
+void eepromPut(uint16_t addr, const T& obj)
+{
+    const uint8_t*  data    = reinterpret_cast<const uint8_t*>(&obj);
+    uint16_t        idx     = 0U;
+
+    for(idx = 0U; idx < sizeof(T); ++idx)
+    {
+        eepromUpdate(addr + idx, data[idx]);
+    }
+
+    return;
+}
+
+/**
+ * Reset the device. It doesn't return.
+ */
+void reset(void);
+
+};
+
+#if defined(__AVR__)
+#include "HalAvr.h"
+#elif defined(HAL_LINUX)
+#include "HalLinux.h"
+#elif defined(HAL_TEST)
+#include "HalTest.h"
+#else
+#error "No HAL backend for this platform."
+#endif
+
+#endif  /* __HAL_H__ */
+
+/** @} */
@@ -0,0 +1,143 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Hardware abstraction layer - AVR backend
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Hal.h"
+
+#if defined(__AVR__)
+
+#include <avr/eeprom.h>
+#include <avr/wdt.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/*
+ * CAUTION! Older AVRs will have the watchdog timer disabled on a reset.
+ * For these older AVRs, doing a soft reset by enabling the watchdog is easy,
+ * as the watchdog will then be disabled after the reset. On newer AVRs, once
+ * the watchdog is enabled, then it stays enabled, even after a reset!
+ * For these newer AVRs a function needs to be added to the .init3 section
+ * (i.e. during the startup code, before main()) to disable the watchdog early
+ * enough so it does not continually reset the AVR.
+*/
+
+/* Disable the watchdog in the .init3 phase before main() is called. */
+void Watchdog_disableWatchdog(void) \
+__attribute__((naked)) \
+__attribute__((section(".init3")));
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+void Hal::enableS0Interrupt(void)
+{
+    /* The S0 interfaces are all on port A, which is served by the
+     * pin change interrupt 0.
+     */
+    PCICR |= _BV(PCIE0);
+
+    return;
+}
+
+uint8_t Hal::eepromRead(uint16_t addr)
+{
+    return eeprom_read_byte(reinterpret_cast<const uint8_t*>(addr));
+}
+
+void Hal::eepromUpdate(uint16_t addr, uint8_t value)
+{
+    eeprom_update_byte(reinterpret_cast<uint8_t*>(addr), value);
+    return;
+}
+
+void Hal::reset(void)
+{
+    /* Perform reset triggered by watchdog. */
+    wdt_enable(WDTO_30MS);
+    while(1)
+    {
+        asm("nop");
+    };
+}
+
+/**
+ * Disable watchdog before any watchdog interrupt can happen.
+ * @see http://www.nongnu.org/avr-libc/user-manual/group__avr__watchdog.html
+ *
+ * Important note: Don't declare this function static, otherwise it will be
+ * removed by the linker.
+ */
+void Watchdog_disableWatchdog(void)
+{
+    MCUSR = 0;
+    wdt_disable();
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#endif  /* defined(__AVR__) */
@@ -0,0 +1,105 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Hardware abstraction layer - AVR backend
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The S0 interfaces are all on port A of the ATmega644P, which is served by
+ * the pin change interrupt 0. Don't include it directly, use Hal.h instead.
+ *
+ * @{
+ */
+
+#ifndef __HAL_AVR_H__
+#define __HAL_AVR_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Defines the interrupt service routine of the S0 port pin changes. */
+#define HAL_S0_PIN_CHANGE_ISR()     ISR(PCINT0_vect)
+
+/** Execute the following block with masked interrupts. */
+#define HAL_ATOMIC_BLOCK()          ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+
+/**
+ * Read a variable, which is shared with the interrupt service routine.
+ * Only the test backend instruments the access.
+ */
+#define HAL_SHARED_LOAD(_var)               (_var)
+
+/**
+ * Write a variable, which is shared with the interrupt service routine.
+ * Only the test backend instruments the access.
+ */
+#define HAL_SHARED_STORE(_var, _value)      ((_var) = (_value))
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+inline uint8_t Hal::readS0Port(void)
+{
+    return PINA;
+}
+
+inline void Hal::enableS0PinChange(uint8_t bitNo)
+{
+    PCMSK0 |= _BV(bitNo);
+    return;
+}
+
+inline void Hal::disableS0PinChange(uint8_t bitNo)
+{
+    PCMSK0 &= ~_BV(bitNo);
+    return;
+}
+
+inline uint8_t Hal::getS0PinChangeMask(void)
+{
+    return PCMSK0;
+}
+
+#endif  /* __HAL_AVR_H__ */
+
+/** @} */
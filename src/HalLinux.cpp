@@ -0,0 +1,274 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Hardware abstraction layer - Linux backend
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Hal.h"
+
+#if defined(HAL_LINUX)
+
+#include <EthernetENC.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. time in ms to wait for network activity per main loop. */
+static const int        IDLE_TIMEOUT        = 1;
+
+/** S0 port input value. The inputs have pull-ups, therefore all are high by default. */
+static uint8_t          gS0Port             = 0xFFU;
+
+/** S0 port pins, whose pin change interrupt is enabled. */
+static uint8_t          gS0PinChangeMask    = 0U;
+
+/** Is the pin change interrupt of the S0 port enabled in general? */
+static bool             gIsS0IntEnabled     = false;
+
+/** EEPROM content */
+static uint8_t          gEeprom[HalLinux::EEPROM_SIZE];
+
+/** File descriptor of the file, which backs the EEPROM. */
+static int              gEepromFd           = -1;
+
+/** Command line arguments, used to restart the process. */
+static char* const*     gArgv               = nullptr;
+
+/** File descriptor of the S0 port input. */
+static int              gS0InputFd          = -1;
+
+/** Max. number of S0 port values, which are applied per main loop. */
+static const size_t     S0_INPUT_MAX_VALUES = 64U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+uint8_t Hal::readS0Port(void)
+{
+    return gS0Port;
+}
+
+void Hal::enableS0PinChange(uint8_t bitNo)
+{
+    gS0PinChangeMask |= _BV(bitNo);
+    return;
+}
+
+void Hal::disableS0PinChange(uint8_t bitNo)
+{
+    gS0PinChangeMask &= ~_BV(bitNo);
+    return;
+}
+
+uint8_t Hal::getS0PinChangeMask(void)
+{
+    return gS0PinChangeMask;
+}
+
+void Hal::enableS0Interrupt(void)
+{
+    gIsS0IntEnabled = true;
+    return;
+}
+
+uint8_t Hal::eepromRead(uint16_t addr)
+{
+    /* Like the AVR, which reads the erased state outside the EEPROM. */
+    return (HalLinux::EEPROM_SIZE > addr) ? gEeprom[addr] : 0xFFU;
+}
+
+void Hal::eepromUpdate(uint16_t addr, uint8_t value)
+{
+    if ((HalLinux::EEPROM_SIZE > addr) &&
+        (value != gEeprom[addr]))
+    {
+        gEeprom[addr] = value;
+
+        /* Write through, so the content survives a crash too. */
+        if ((0 <= gEepromFd) &&
+            (1 != pwrite(gEepromFd, &value, 1U, addr)))
+        {
+            perror("EEPROM write");
+        }
+    }
+
+    return;
+}
+
+void Hal::reset(void)
+{
+    (void)fflush(stdout);
+
+    /* All sockets and the EEPROM file are closed on exec. */
+    if (nullptr != gArgv)
+    {
+        (void)execv("/proc/self/exe", gArgv);
+        perror("Reset");
+    }
+
+    exit(EXIT_FAILURE);
+}
+
+bool HalLinux::init(const char* eepromFile, char* const argv[])
+{
+    ssize_t len = 0;
+
+    gArgv = argv;
+
+    /* An erased EEPROM reads 0xFF. */
+    memset(gEeprom, 0xFF, sizeof(gEeprom));
+
+    gEepromFd = open(eepromFile, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+    if (0 > gEepromFd)
+    {
+        perror(eepromFile);
+        return false;
+    }
+
+    len = pread(gEepromFd, gEeprom, sizeof(gEeprom), 0);
+
+    if (0 > len)
+    {
+        perror(eepromFile);
+        return false;
+    }
+
+    /* A new or too short file gets the erased state. */
+    if (static_cast<size_t>(len) < sizeof(gEeprom))
+    {
+        size_t  rest    = sizeof(gEeprom) - static_cast<size_t>(len);
+
+        if (static_cast<ssize_t>(rest) != pwrite(gEepromFd, &gEeprom[len], rest, len))
+        {
+            perror(eepromFile);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void HalLinux::setS0Port(uint8_t value)
+{
+    uint8_t changed = gS0Port ^ value;
+
+    gS0Port = value;
+
+    if ((true == gIsS0IntEnabled) &&
+        (0U != (changed & gS0PinChangeMask)))
+    {
+        Hal::onS0PinChange();
+    }
+
+    return;
+}
+
+bool HalLinux::openS0Input(const char* fileName)
+{
+    if ((0 != mkfifo(fileName, 0644)) &&
+        (EEXIST != errno))
+    {
+        perror(fileName);
+        return false;
+    }
+
+    /* Non-blocking, because the main loop must never wait for a writer. */
+    gS0InputFd = open(fileName, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+
+    if (0 > gS0InputFd)
+    {
+        perror(fileName);
+        return false;
+    }
+
+    return true;
+}
+
+void HalLinux::idle(void)
+{
+    EthernetServer::waitForClients(IDLE_TIMEOUT);
+
+    if (0 <= gS0InputFd)
+    {
+        uint8_t values[S0_INPUT_MAX_VALUES];
+        ssize_t len     = read(gS0InputFd, values, sizeof(values));
+        ssize_t idx     = 0;
+
+        /* Every value is applied on its own, so no edge is lost. */
+        for(idx = 0; idx < len; ++idx)
+        {
+            setS0Port(values[idx]);
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#endif  /* defined(HAL_LINUX) */
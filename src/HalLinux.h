@@ -0,0 +1,141 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Hardware abstraction layer - Linux backend
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Runs the firmware as Linux process. The S0 port is a variable, which is
+ * changed via HalLinux::setS0Port(). A change of a enabled pin calls the
+ * pin change handler directly, because there are no interrupts. This is
+ * also the reason why the atomic blocks don't need to mask anything.
+ * The EEPROM is backed by a file and a reset restarts the process.
+ * Don't include it directly, use Hal.h instead.
+ *
+ * @{
+ */
+
+#ifndef __HAL_LINUX_H__
+#define __HAL_LINUX_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Defines the handler of the S0 port pin changes. */
+#define HAL_S0_PIN_CHANGE_ISR()     void Hal::onS0PinChange(void)
+
+/** Execute the following block once. Nothing needs to be masked. */
+#define HAL_ATOMIC_BLOCK()          for(uint8_t _halAtomic = 1U; 0U != _halAtomic; _halAtomic = 0U)
+
+/**
+ * Read a variable, which is shared with the interrupt service routine.
+ * Only the test backend instruments the access.
+ */
+#define HAL_SHARED_LOAD(_var)               (_var)
+
+/**
+ * Write a variable, which is shared with the interrupt service routine.
+ * Only the test backend instruments the access.
+ */
+#define HAL_SHARED_STORE(_var, _value)      ((_var) = (_value))
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+namespace Hal
+{
+
+/**
+ * Handler of the S0 port pin changes, defined by HAL_S0_PIN_CHANGE_ISR().
+ */
+void onS0PinChange(void);
+
+};
+
+/**
+ * Linux specific part of the hardware abstraction layer.
+ */
+namespace HalLinux
+{
+
+/** EEPROM size in bytes, like the one of the ATmega644P. */
+static const uint16_t   EEPROM_SIZE = 2048U;
+
+/**
+ * Initialize the Linux backend.
+ *
+ * @param[in] eepromFile    Name of the file, which backs the EEPROM. It is
+ *                          created if it doesn't exist.
+ * @param[in] argv          Command line arguments, used to restart the process.
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool init(const char* eepromFile, char* const argv[]);
+
+/**
+ * Set the input value of the S0 port. If a pin changes, whose pin change
+ * interrupt is enabled, the pin change handler is called.
+ *
+ * @param[in] value Port input value
+ */
+void setS0Port(uint8_t value);
+
+/**
+ * Open a input of the S0 port values, e.g. fed by a load generator. Every
+ * byte, which is read from it, is set as S0 port value. A not existing file
+ * is created as named pipe.
+ *
+ * @param[in] fileName  Name of the file or named pipe
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool openS0Input(const char* fileName);
+
+/**
+ * Wait shortly for network activity and apply the pending S0 port values of
+ * the S0 input. Call it once per main loop, to prevent a busy loop.
+ */
+void idle(void);
+
+};
+
+#endif  /* __HAL_LINUX_H__ */
+
+/** @} */
@@ -0,0 +1,242 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP request body stream
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @{
+ */
+
+#ifndef __HTTP_BODY_STREAM_H__
+#define __HTTP_BODY_STREAM_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+#include "WebReqRouter.h"
+#include "SimpleTimer.hpp"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Provides the body of a HTTP request as stream.
+ *
+ * The HTTP request buffers only the first part of the body. If the body is
+ * larger than the buffer, the rest is read directly from the client as the
+ * bytes arrive. The stream ends after the number of bytes, given by the
+ * Content-Length of the request.
+ */
+class HttpBodyStream : public Stream
+{
+public:
+
+    /**
+     * Constructs a HTTP request body stream.
+     *
+     * @param[in] client        The client, where the request came from.
+     * @param[in] httpRequest   The HTTP request, which is already read.
+     */
+    HttpBodyStream(EthernetClient& client, const HttpRequest& httpRequest) :
+        Stream(),
+        m_client(client),
+        m_buffered(httpRequest.getBody()),
+        m_bufferedLen(0U),
+        m_remaining(0U),
+        m_timer()
+    {
+        int contentLength = httpRequest.getContentLength();
+
+        if (nullptr != m_buffered)
+        {
+            m_bufferedLen = strlen(m_buffered);
+        }
+
+        /* Only the part of the body, which was not buffered by the request,
+         * must be read from the client.
+         */
+        if ((0 < contentLength) &&
+            (m_bufferedLen < static_cast<size_t>(contentLength)))
+        {
+            m_remaining = static_cast<size_t>(contentLength) - m_bufferedLen;
+        }
+
+        /* The stream waits itself for the next byte. Waiting again via the
+         * timed read functions of the stream would only delay the end of
+         * the body.
+         */
+        setTimeout(0U);
+    }
+
+    /**
+     * Destroys the HTTP request body stream.
+     */
+    ~HttpBodyStream()
+    {
+    }
+
+    /**
+     * Get number of bytes, which can be read without waiting.
+     *
+     * @return Number of bytes
+     */
+    int available() override
+    {
+        int available = static_cast<int>(m_bufferedLen);
+
+        if (0U < m_remaining)
+        {
+            int clientAvailable = m_client.available();
+
+            if (0 < clientAvailable)
+            {
+                if (m_remaining < static_cast<size_t>(clientAvailable))
+                {
+                    clientAvailable = static_cast<int>(m_remaining);
+                }
+
+                available += clientAvailable;
+            }
+        }
+
+        return available;
+    }
+
+    /**
+     * Read a single byte of the body. If no byte is available yet, it will
+     * wait until one arrives or the timeout occurs.
+     *
+     * @return Data byte or -1 at the end of the body or in case of a timeout.
+     */
+    int read() override
+    {
+        int data = peek();
+
+        if (0 <= data)
+        {
+            if (0U < m_bufferedLen)
+            {
+                ++m_buffered;
+                --m_bufferedLen;
+            }
+            else
+            {
+                (void)m_client.read();
+                --m_remaining;
+            }
+        }
+
+        return data;
+    }
+
+    /**
+     * Get the next byte of the body, without removing it from the stream.
+     * If no byte is available yet, it will wait until one arrives or the
+     * timeout occurs.
+     *
+     * @return Data byte or -1 at the end of the body or in case of a timeout.
+     */
+    int peek() override
+    {
+        int data = -1;
+
+        if (0U < m_bufferedLen)
+        {
+            data = static_cast<uint8_t>(*m_buffered);
+        }
+        else if (0U < m_remaining)
+        {
+            m_timer.start(TIMEOUT);
+
+            while((0 >= m_client.available()) &&
+                  (false == m_timer.isTimeout()) &&
+                  (0 != m_client.connected()))
+            {
+                /* Wait for the next byte. Note, the client polls the network meanwhile. */
+                ;
+            }
+
+            data = m_client.peek();
+
+            /* Don't wait again, if the client doesn't deliver anymore. */
+            if (0 > data)
+            {
+                m_remaining = 0U;
+            }
+        }
+
+        return data;
+    }
+
+    /**
+     * Writing to the body is not supported.
+     *
+     * @param[in] data  Data byte
+     *
+     * @return Number of written bytes, which is always 0.
+     */
+    size_t write(uint8_t data) override
+    {
+        (void)data;
+
+        return 0U;
+    }
+
+    /** Timeout in ms, to wait for the next body byte. */
+    static const uint32_t   TIMEOUT = 1000U;
+
+private:
+
+    EthernetClient& m_client;       /**< Client, where the rest of the body is read from */
+    const char*     m_buffered;     /**< Body part, buffered by the request */
+    size_t          m_bufferedLen;  /**< Length of the buffered body part, which is not read yet */
+    size_t          m_remaining;    /**< Number of body bytes, which are not received yet */
+    SimpleTimer     m_timer;        /**< Timer used for the timeout handling */
+
+    HttpBodyStream();
+    HttpBodyStream(const HttpBodyStream& stream);
+    HttpBodyStream& operator=(const HttpBodyStream& stream);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __HTTP_BODY_STREAM_H__ */
+
+/** @} */
@@ -0,0 +1,328 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  ISR trace
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IsrTrace.h"
+#include "Config.h"
+#include "Hal.h"
+
+#if ISR_TRACE_ENABLED
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** A single trace record. */
+struct Record
+{
+    uint32_t    timestamp;  /**< Timestamp in us */
+    uint8_t     pins;       /**< Port A input value */
+    uint8_t     counted;    /**< Port A bits, which counted a pulse */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void writeUInt16(Print& out, uint16_t value);
+static void writeUInt32(Print& out, uint32_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of records, which are recorded after an anomaly, before the trace freezes. */
+static const uint8_t            POST_TRIGGER_RECORDS    = CONFIG_ISR_TRACE_SIZE / 2U;
+
+/** Min. period in us between two pulses of a S0 interface. A shorter one is an anomaly. */
+static const uint32_t           MIN_PULSE_PERIOD        = CONFIG_ISR_TRACE_MIN_PULSE_PERIOD * 1000UL;
+
+/** Circular trace buffer. */
+static Record                   gRecords[CONFIG_ISR_TRACE_SIZE];
+
+/** Index of the next record, which to write. */
+static uint8_t                  gWriteIdx               = 0U;
+
+/** Number of valid records. */
+static uint8_t                  gNumRecords             = 0U;
+
+/** Trace state. */
+static volatile IsrTrace::State gState                  = IsrTrace::STATE_ARMED;
+
+/** Number of records, which are still recorded after an anomaly. */
+static uint8_t                  gPostTriggerCnt         = 0U;
+
+/** Buffer index of the anomaly record. */
+static uint8_t                  gTriggerIdx             = 0U;
+
+/** Port A bits, where the anomaly was detected. */
+static uint8_t                  gTriggerMask            = 0U;
+
+/** Timestamp in us of the last counted pulse, per port A bit. */
+static uint32_t                 gLastPulse[8U];
+
+/** Port A bits, which counted at least one pulse since the trace was armed. */
+static uint8_t                  gHasLastPulse           = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+void IsrTrace::record(uint8_t pins, uint8_t counted)
+{
+    IsrTrace::State state = gState;
+
+    if ((STATE_ARMED == state) ||
+        (STATE_TRIGGERED == state))
+    {
+        uint32_t    timestamp   = micros();
+        Record&     record      = gRecords[gWriteIdx];
+        uint8_t     bitNo       = 0U;
+        uint8_t     anomaly     = 0U;
+
+        record.timestamp    = timestamp;
+        record.pins         = pins;
+        record.counted      = counted;
+
+        /* A pulse, which follows the previous one too fast, is an anomaly. */
+        for(bitNo = 0U; bitNo < 8U; ++bitNo)
+        {
+            if (0U != (counted & _BV(bitNo)))
+            {
+                if ((0U != (gHasLastPulse & _BV(bitNo))) &&
+                    (MIN_PULSE_PERIOD > (timestamp - gLastPulse[bitNo])))
+                {
+                    anomaly |= _BV(bitNo);
+                }
+
+                gLastPulse[bitNo]   = timestamp;
+                gHasLastPulse      |= _BV(bitNo);
+            }
+        }
+
+        if (STATE_TRIGGERED == state)
+        {
+            --gPostTriggerCnt;
+
+            if (0U == gPostTriggerCnt)
+            {
+                gState = STATE_FROZEN_ANOMALY;
+            }
+        }
+        else if (0U != anomaly)
+        {
+            gTriggerIdx     = gWriteIdx;
+            gTriggerMask    = anomaly;
+            gPostTriggerCnt = POST_TRIGGER_RECORDS;
+            gState          = STATE_TRIGGERED;
+        }
+        else
+        {
+            ;
+        }
+
+        ++gWriteIdx;
+        if (CONFIG_ISR_TRACE_SIZE <= gWriteIdx)
+        {
+            gWriteIdx = 0U;
+        }
+
+        if (CONFIG_ISR_TRACE_SIZE > gNumRecords)
+        {
+            ++gNumRecords;
+        }
+    }
+
+    return;
+}
+
+void IsrTrace::freeze(void)
+{
+    HAL_ATOMIC_BLOCK()
+    {
+        if ((STATE_ARMED == gState) ||
+            (STATE_TRIGGERED == gState))
+        {
+            /* A pending anomaly is kept, even if the trace is frozen too early. */
+            gState = (STATE_TRIGGERED == gState) ? STATE_FROZEN_ANOMALY : STATE_FROZEN;
+        }
+    }
+
+    return;
+}
+
+void IsrTrace::arm(void)
+{
+    HAL_ATOMIC_BLOCK()
+    {
+        gWriteIdx       = 0U;
+        gNumRecords     = 0U;
+        gPostTriggerCnt = 0U;
+        gTriggerIdx     = 0U;
+        gTriggerMask    = 0U;
+        gHasLastPulse   = 0U;
+        gState          = STATE_ARMED;
+    }
+
+    return;
+}
+
+IsrTrace::State IsrTrace::getState(void)
+{
+    return gState;
+}
+
+const __FlashStringHelper* IsrTrace::stateToStr(State state)
+{
+    const __FlashStringHelper* str = F("?");
+
+    switch(state)
+    {
+    case STATE_ARMED:
+        str = F("armed");
+        break;
+
+    case STATE_TRIGGERED:
+        str = F("triggered");
+        break;
+
+    case STATE_FROZEN:
+        str = F("frozen");
+        break;
+
+    case STATE_FROZEN_ANOMALY:
+        str = F("frozen by anomaly");
+        break;
+
+    default:
+        break;
+    }
+
+    return str;
+}
+
+void IsrTrace::dump(Print& out)
+{
+    uint8_t     idx         = 0U;
+    uint8_t     readIdx     = 0U;
+    uint16_t    triggerIdx  = Dump::NO_TRIGGER;
+
+    /* The ISR doesn't touch the trace anymore, after it is frozen. */
+    freeze();
+
+    readIdx = (CONFIG_ISR_TRACE_SIZE > gNumRecords) ? 0U : gWriteIdx;
+
+    if (STATE_FROZEN_ANOMALY == gState)
+    {
+        triggerIdx = (gTriggerIdx + CONFIG_ISR_TRACE_SIZE - readIdx) % CONFIG_ISR_TRACE_SIZE;
+    }
+
+    (void)out.write(reinterpret_cast<const uint8_t*>("S0TR"), 4U);
+    (void)out.write(Dump::VERSION);
+    (void)out.write(static_cast<uint8_t>(gState));
+    writeUInt16(out, gNumRecords);
+    writeUInt16(out, triggerIdx);
+    (void)out.write(Hal::getS0PinChangeMask());
+    (void)out.write(gTriggerMask);
+
+    for(idx = 0U; idx < gNumRecords; ++idx)
+    {
+        const Record& record = gRecords[readIdx];
+
+        writeUInt32(out, record.timestamp);
+        (void)out.write(record.pins);
+        (void)out.write(record.counted);
+
+        ++readIdx;
+        if (CONFIG_ISR_TRACE_SIZE <= readIdx)
+        {
+            readIdx = 0U;
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write a 16-bit value in little endian.
+ *
+ * @param[in] out   Output
+ * @param[in] value Value
+ */
+static void writeUInt16(Print& out, uint16_t value)
+{
+    (void)out.write(static_cast<uint8_t>(value));
+    (void)out.write(static_cast<uint8_t>(value >> 8U));
+
+    return;
+}
+
+/**
+ * Write a 32-bit value in little endian.
+ *
+ * @param[in] out   Output
+ * @param[in] value Value
+ */
+static void writeUInt32(Print& out, uint32_t value)
+{
+    writeUInt16(out, static_cast<uint16_t>(value));
+    writeUInt16(out, static_cast<uint16_t>(value >> 16U));
+
+    return;
+}
+
+#endif  /* ISR_TRACE_ENABLED */
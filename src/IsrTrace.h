@@ -0,0 +1,185 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  ISR trace
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Records every pin change interrupt of the S0 interfaces with a timestamp,
+ * the port A input value and the S0 interfaces, which counted a pulse. The
+ * trace is kept in a circular RAM buffer, which is frozen on demand or after
+ * an anomaly was detected. It can be dumped in binary form and rendered on
+ * the host by tools/isrtrace.py.
+ *
+ * @{
+ */
+
+#ifndef __ISR_TRACE_H__
+#define __ISR_TRACE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/**
+ * Enable the ISR trace with a 1 or disable it with 0.
+ * It is enabled in debug builds by default.
+ */
+#if !defined(ISR_TRACE_ENABLED)
+
+#if defined(DEBUG)
+#define ISR_TRACE_ENABLED   (1)
+#else   /* not defined(DEBUG) */
+#define ISR_TRACE_ENABLED   (0)
+#endif  /* not defined(DEBUG) */
+
+#endif  /* !defined(ISR_TRACE_ENABLED) */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#if ISR_TRACE_ENABLED
+
+/** Record a pin change interrupt. Call it only in the ISR! */
+#define ISR_TRACE_RECORD(_pins, _counted)   IsrTrace::record(_pins, _counted)
+
+#else   /* not ISR_TRACE_ENABLED */
+
+#define ISR_TRACE_RECORD(_pins, _counted)   do { (void)(_pins); (void)(_counted); } while(0)
+
+#endif  /* not ISR_TRACE_ENABLED */
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * ISR trace
+ */
+namespace IsrTrace
+{
+
+/** This type defines the trace states. */
+enum State
+{
+    STATE_ARMED = 0,        /**< Trace is recording */
+    STATE_TRIGGERED,        /**< Anomaly detected, the trace records the rest until it freezes */
+    STATE_FROZEN,           /**< Trace is frozen on demand */
+    STATE_FROZEN_ANOMALY    /**< Trace is frozen after an anomaly */
+};
+
+/**
+ * Binary dump format, all values in little endian.
+ *
+ * Header:
+ * - Magic "S0TR" (4 bytes)
+ * - Version (1 byte)
+ * - State (1 byte)
+ * - Number of records (2 bytes)
+ * - Index of the anomaly record or 0xFFFF (2 bytes)
+ * - Port A bits, which are enabled for the pin change interrupt (1 byte)
+ * - Port A bits, where the anomaly was detected (1 byte)
+ *
+ * Records, the oldest first:
+ * - Timestamp in us (4 bytes)
+ * - Port A input value (1 byte)
+ * - Port A bits, which counted a pulse (1 byte)
+ */
+namespace Dump
+{
+
+/** Dump format version. */
+static const uint8_t    VERSION         = 1U;
+
+/** Size of the header in bytes. */
+static const uint8_t    HEADER_SIZE     = 12U;
+
+/** Size of a single record in bytes. */
+static const uint8_t    RECORD_SIZE     = 6U;
+
+/** Record index, if no anomaly was detected. */
+static const uint16_t   NO_TRIGGER      = 0xFFFFU;
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Record a pin change interrupt. If the trace is frozen, nothing happens.
+ * Never call it outside the ISR!
+ *
+ * @param[in] pins      Port A input value
+ * @param[in] counted   Port A bits, where a pulse was counted
+ */
+void record(uint8_t pins, uint8_t counted);
+
+/**
+ * Freeze the trace on demand. If it is already frozen, nothing happens.
+ */
+void freeze(void);
+
+/**
+ * Clear the trace and start recording again.
+ */
+void arm(void);
+
+/**
+ * Get the trace state.
+ *
+ * @return Trace state
+ */
+State getState(void);
+
+/**
+ * Get the user friendly name of a trace state.
+ *
+ * @param[in] state Trace state
+ *
+ * @return Name in program memory
+ */
+const __FlashStringHelper* stateToStr(State state);
+
+/**
+ * Freeze the trace and dump it in binary form. The trace stays frozen
+ * until it is armed again.
+ *
+ * @param[in] out   Output, e.g. the client.
+ */
+void dump(Print& out);
+
+};
+
+#endif  /* __ISR_TRACE_H__ */
+
+/** @} */
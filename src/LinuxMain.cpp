@@ -0,0 +1,196 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Process entry point on Linux
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Replaces the main() of the Arduino core, which calls setup() once and
+ * loop() forever.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Hal.h"
+
+#if defined(HAL_LINUX)
+
+#include <EthernetENC.h>
+#include <getopt.h>
+#include <signal.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+extern void setup(void);
+extern void loop(void);
+
+static void printUsage(const char* prgName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Default offset, added to every server port. Port 80 becomes 8080. */
+static const uint16_t   DEFAULT_PORT_OFFSET = 8000U;
+
+/** Default name of the file, which backs the EEPROM. */
+static const char*      DEFAULT_EEPROM_FILE = "eeprom.bin";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Process entry point.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "port-offset",    required_argument,  nullptr,    'p' },
+        { "eeprom",         required_argument,  nullptr,    'e' },
+        { "s0-input",       required_argument,  nullptr,    's' },
+        { "help",           no_argument,        nullptr,    'h' },
+        { nullptr,          0,                  nullptr,    0   }
+    };
+    const char*                 eepromFile  = DEFAULT_EEPROM_FILE;
+    const char*                 s0InputFile = nullptr;
+    long                        portOffset  = DEFAULT_PORT_OFFSET;
+    int                         opt         = 0;
+
+    while(-1 != (opt = getopt_long(argc, argv, "p:e:s:h", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 'p':
+            portOffset = strtol(optarg, nullptr, 0);
+
+            if ((0 > portOffset) || (UINT16_MAX < portOffset))
+            {
+                fprintf(stderr, "Invalid port offset: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'e':
+            eepromFile = optarg;
+            break;
+
+        case 's':
+            s0InputFile = optarg;
+            break;
+
+        case 'h':
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+
+        default:
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* A peer, which closed the connection, shall not terminate the process. */
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    /* The log output shall be visible immediately, even if piped. */
+    (void)setvbuf(stdout, nullptr, _IOLBF, 0U);
+
+    Ethernet.setPortOffset(static_cast<uint16_t>(portOffset));
+
+    if (false == HalLinux::init(eepromFile, argv))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if ((nullptr != s0InputFile) &&
+        (false == HalLinux::openS0Input(s0InputFile)))
+    {
+        return EXIT_FAILURE;
+    }
+
+    setup();
+
+    while(true)
+    {
+        loop();
+        HalLinux::idle();
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Print the command line usage.
+ *
+ * @param[in] prgName   Program name
+ */
+static void printUsage(const char* prgName)
+{
+    printf("Usage: %s [options]\n", prgName);
+    printf("  -p, --port-offset N   Offset added to every server port (default: %u).\n", DEFAULT_PORT_OFFSET);
+    printf("  -e, --eeprom FILE     File, which backs the EEPROM (default: %s).\n", DEFAULT_EEPROM_FILE);
+    printf("  -s, --s0-input FILE   Named pipe, whose bytes are applied as S0 port values.\n");
+    printf("  -h, --help            Show this help.\n");
+}
+
+#endif  /* defined(HAL_LINUX) */
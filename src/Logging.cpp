@@ -1,6 +1,6 @@
 /* MIT License
  *
- * Copyright (c) 2020 - 2024 Andreas Merkle <web@blue-andi.de>
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "Logging.h"
+#include "Config.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -46,18 +47,100 @@
  * Types and classes
  *****************************************************************************/
 
+/**
+ * Log record header, which is stored in the ring buffer. A log message in
+ * program memory is referenced only. A log message in RAM is copied and
+ * follows the header directly.
+ */
+typedef struct
+{
+    uint32_t                    timestamp;  /**< Timestamp in ms */
+#if LOGGING_TOKENIZED
+    uint16_t                    token;      /**< Token of the log call site */
+#else   /* not LOGGING_TOKENIZED */
+    const __FlashStringHelper*  fileNameP;  /**< File name in program memory */
+    uint16_t                    line;       /**< Line number */
+    const __FlashStringHelper*  msgP;       /**< Log message in program memory or nullptr if the message follows */
+#endif  /* not LOGGING_TOKENIZED */
+    uint8_t                     flags;      /**< Log type and Logging::Frame::FLAG_VALUE */
+    int32_t                     value;      /**< Integer value, only valid with Logging::Frame::FLAG_VALUE */
+    uint8_t                     msgLen;     /**< Length of the message, which follows the header */
+
+} RecordHead;
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
 
-static bool logHead(const __FlashStringHelper* fileNameP, int line, Logging::LogType logType);
+static bool isLogTypeEnabled(Logging::LogType logType);
+static void initRecord(RecordHead& head, Logging::LogType logType, const char* str, bool hasValue, int32_t value);
+static void pushRecord(const RecordHead& head, const char* msg);
+static void dropOldestRecord(void);
+static void ringWrite(const void* data, uint16_t size);
+static void ringRead(uint16_t idx, void* data, uint16_t size);
+static uint16_t readRecord(uint16_t idx, RecordHead& head, char* msg);
+static bool formatNextLine(void);
+static void formatDropped(uint32_t dropped);
+static void formatRecord(const RecordHead& head, const char* msg);
+#if LOGGING_TOKENIZED
+static void lineAppendBytes(const void* data, uint8_t size);
+#else   /* not LOGGING_TOKENIZED */
+static void lineAppend(const char* str, bool isProgmem, uint8_t maxLen);
+static void lineAppendUInt(uint32_t value);
+static void lineAppendInt(int32_t value);
+#endif  /* not LOGGING_TOKENIZED */
 
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** Mask of the log type in the record flags. */
+static const uint8_t    LOG_TYPE_MASK   = 0x0FU;
+
 /** Define the log level here, by adding the log types via OR together. */
-static const uint8_t    LOG_LEVEL   = (Logging::LOGTYPE_INFO | Logging::LOGTYPE_ERROR | Logging::LOGTYPE_FATAL);
+static const uint8_t    LOG_LEVEL       = (Logging::LOGTYPE_INFO | Logging::LOGTYPE_ERROR | Logging::LOGTYPE_FATAL);
+
+/** Size of the line buffer, used to send a single log record. */
+static const uint8_t    LINE_SIZE       = 112U;
+
+/** Ring buffer with log records (header + optional message). */
+static uint8_t          gRing[CONFIG_LOG_RING_SIZE];
+
+/** Write index in the ring buffer. */
+static uint16_t         gRingHead       = 0U;
+
+/** Index of the oldest log record in the ring buffer. */
+static uint16_t         gRingTail       = 0U;
+
+/** Number of used bytes in the ring buffer. */
+static uint16_t         gRingUsed       = 0U;
+
+/** Sequence number of the oldest log record in the ring buffer. */
+static uint32_t         gTailSeq        = 0U;
+
+/** Sequence number of the next log record. */
+static uint32_t         gNextSeq        = 0U;
+
+/** Sequence number of the next log record, which to send on the serial interface. */
+static uint32_t         gSerialSeq      = 0U;
+
+/** Index in the ring buffer of the next log record, which to send on the serial interface. */
+static uint16_t         gSerialIdx      = 0U;
+
+/** Number of log records, dropped before they were sent on the serial interface. */
+static uint32_t         gDropped        = 0U;
+
+/** Number of dropped log records, which are already reported on the console. */
+static uint32_t         gDroppedShown   = 0U;
+
+/** Line buffer with the log record, which is currently sent. */
+static char             gLine[LINE_SIZE];
+
+/** Length of the line in the line buffer. */
+static uint8_t          gLineLen        = 0U;
+
+/** Number of already sent characters of the line buffer. */
+static uint8_t          gLinePos        = 0U;
 
 /******************************************************************************
  * Public Methods
@@ -75,12 +158,20 @@ static const uint8_t    LOG_LEVEL   = (Logging::LOGTYPE_INFO | Logging::LOGTYPE_
  * External Functions
  *****************************************************************************/
 
+#if !LOGGING_TOKENIZED
+
 void Logging::logOutput(const __FlashStringHelper* fileNameP, int line, Logging::LogType logType, const char* str)
 {
-    if (true == logHead(fileNameP, line, logType))
+    if (true == isLogTypeEnabled(logType))
     {
-        // Show message
-        Serial.println(str);
+        RecordHead head;
+
+        initRecord(head, logType, str, false, 0);
+        head.fileNameP  = fileNameP;
+        head.line       = static_cast<uint16_t>(line);
+        head.msgP       = nullptr;
+
+        pushRecord(head, str);
     }
     
     return;
@@ -88,74 +179,650 @@ void Logging::logOutput(const __FlashStringHelper* fileNameP, int line, Logging:
 
 void Logging::logOutput(const __FlashStringHelper* fileNameP, int line, Logging::LogType logType, const __FlashStringHelper* strP)
 {
-    if (true == logHead(fileNameP, line, logType))
+    if (true == isLogTypeEnabled(logType))
+    {
+        RecordHead head;
+
+        initRecord(head, logType, nullptr, false, 0);
+        head.fileNameP  = fileNameP;
+        head.line       = static_cast<uint16_t>(line);
+        head.msgP       = strP;
+
+        pushRecord(head, nullptr);
+    }
+    
+    return;
+}
+
+void Logging::logOutput(const __FlashStringHelper* fileNameP, int line, Logging::LogType logType, const char* str, int32_t value)
+{
+    if (true == isLogTypeEnabled(logType))
+    {
+        RecordHead head;
+
+        initRecord(head, logType, str, true, value);
+        head.fileNameP  = fileNameP;
+        head.line       = static_cast<uint16_t>(line);
+        head.msgP       = nullptr;
+
+        pushRecord(head, str);
+    }
+    
+    return;
+}
+
+void Logging::logOutput(const __FlashStringHelper* fileNameP, int line, Logging::LogType logType, const __FlashStringHelper* strP, int32_t value)
+{
+    if (true == isLogTypeEnabled(logType))
     {
-        // Show message
-        Serial.println(strP);
+        RecordHead head;
+
+        initRecord(head, logType, nullptr, true, value);
+        head.fileNameP  = fileNameP;
+        head.line       = static_cast<uint16_t>(line);
+        head.msgP       = strP;
+
+        pushRecord(head, nullptr);
     }
     
     return;
 }
 
+#else   /* LOGGING_TOKENIZED */
+
+void Logging::logTokenOutput(uint16_t token, Logging::LogType logType, const char* str, bool hasValue, int32_t value)
+{
+    if (true == isLogTypeEnabled(logType))
+    {
+        RecordHead head;
+
+        initRecord(head, logType, str, hasValue, value);
+        head.token = token;
+
+        pushRecord(head, str);
+    }
+
+    return;
+}
+
+#endif  /* LOGGING_TOKENIZED */
+
+void Logging::process(void)
+{
+    int space = Serial.availableForWrite();
+
+    /* Write only as many bytes, as fit into the serial transmit buffer.
+     * Otherwise the write would block.
+     */
+    while(0 < space)
+    {
+        if (gLinePos >= gLineLen)
+        {
+            if (false == formatNextLine())
+            {
+                break;
+            }
+        }
+
+        (void)Serial.write(static_cast<uint8_t>(gLine[gLinePos]));
+        ++gLinePos;
+        --space;
+    }
+
+    return;
+}
+
+void Logging::flush(void)
+{
+    while((gLinePos < gLineLen) || (gSerialSeq != gNextSeq) || (gDroppedShown != gDropped))
+    {
+        process();
+    }
+
+    Serial.flush();
+
+    return;
+}
+
+bool Logging::getRecord(uint32_t seq, Logging::Record& record)
+{
+    bool isAvailable = false;
+
+    if (gTailSeq > seq)
+    {
+        seq = gTailSeq;
+    }
+
+    if (gNextSeq > seq)
+    {
+        uint16_t    idx     = gRingTail;
+        uint32_t    idxSeq  = gTailSeq;
+        RecordHead  head;
+
+        /* Skip all older records. */
+        while(idxSeq < seq)
+        {
+            idx = readRecord(idx, head, nullptr);
+            ++idxSeq;
+        }
+
+        (void)readRecord(idx, head, record.text);
+
+        record.seq          = seq;
+        record.timestamp    = head.timestamp;
+        record.logType      = static_cast<LogType>(head.flags & LOG_TYPE_MASK);
+        record.hasValue     = (0U != (head.flags & Logging::Frame::FLAG_VALUE));
+        record.value        = head.value;
+#if LOGGING_TOKENIZED
+        record.token        = head.token;
+#else   /* not LOGGING_TOKENIZED */
+        record.fileNameP    = head.fileNameP;
+        record.line         = head.line;
+        record.msgP         = head.msgP;
+#endif  /* not LOGGING_TOKENIZED */
+
+        isAvailable = true;
+    }
+
+    return isAvailable;
+}
+
+uint32_t Logging::getFirstSeq(void)
+{
+    return gTailSeq;
+}
+
+uint32_t Logging::getNextSeq(void)
+{
+    return gNextSeq;
+}
+
+const __FlashStringHelper* Logging::logTypeToStr(Logging::LogType logType)
+{
+    const __FlashStringHelper* str = nullptr;
+
+    switch(logType)
+    {
+    case Logging::LOGTYPE_DEBUG:
+        str = F("DEBUG");
+        break;
+
+    case Logging::LOGTYPE_INFO:
+        str = F("INFO");
+        break;
+
+    case Logging::LOGTYPE_ERROR:
+        str = F("ERROR");
+        break;
+    
+    case Logging::LOGTYPE_FATAL:
+        str = F("FATAL");
+        break;
+
+    default:
+        str = F("?");
+        break;
+    }
+
+    return str;
+}
+
+uint32_t Logging::getDroppedRecords(void)
+{
+    return gDropped;
+}
+
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
 
 /**
- * Print log message header, depended on log level.
- * 
- * @param[in] fileNameP Name of the file where the log output happens (string muste be in program memory)
- * @param[in] line      Line number where the log output happens
+ * Check whether the log type is enabled by the log level.
+ *
  * @param[in] logType   Log type
  *
  * @return If the log type is masked out, it will return false, otherwise true.
  */
-static bool logHead(const __FlashStringHelper* fileNameP, int line, Logging::LogType logType)
+static bool isLogTypeEnabled(Logging::LogType logType)
 {
-    bool ret  = false;
-    
-    if (0 != (LOG_LEVEL & logType))
+    return (0 != (LOG_LEVEL & logType));
+}
+
+/**
+ * Initialize the common part of a log record header.
+ *
+ * @param[out]  head        Log record header
+ * @param[in]   logType     Log type
+ * @param[in]   str         Log message in RAM, which will follow the header. May be nullptr.
+ * @param[in]   hasValue    Whether the record contains a integer value.
+ * @param[in]   value       Integer value
+ */
+static void initRecord(RecordHead& head, Logging::LogType logType, const char* str, bool hasValue, int32_t value)
+{
+    size_t msgLen = (nullptr == str) ? 0U : strlen(str);
+
+    head.timestamp  = millis();
+    head.flags      = logType;
+    head.value      = value;
+    head.msgLen     = (Logging::MSG_MAX_LEN < msgLen) ? Logging::MSG_MAX_LEN : static_cast<uint8_t>(msgLen);
+
+    if (true == hasValue)
     {
-        /* Show time */
-        Serial.print(millis() / 1000);
-        Serial.print(F(" "));
-    
-        /* Show name of file without path */
-        Serial.print(fileNameP);
-    
-        /* Show line number in braces */
-        Serial.print(F(" ("));
-        Serial.print(line);
-        Serial.print(F(") - "));
-    
-        /* Show log type */
-        switch(logType)
+        head.flags |= Logging::Frame::FLAG_VALUE;
+    }
+
+    return;
+}
+
+/**
+ * Store a log record in the ring buffer. If there is not enough space,
+ * the oldest log records will be dropped.
+ *
+ * @param[in] head  Log record header
+ * @param[in] msg   Log message in RAM, which follows the header. May be nullptr.
+ */
+static void pushRecord(const RecordHead& head, const char* msg)
+{
+    uint16_t recordSize = sizeof(RecordHead) + head.msgLen;
+
+    while((CONFIG_LOG_RING_SIZE - gRingUsed) < recordSize)
+    {
+        dropOldestRecord();
+    }
+
+    ringWrite(&head, sizeof(head));
+
+    if (0U < head.msgLen)
+    {
+        ringWrite(msg, head.msgLen);
+    }
+
+    ++gNextSeq;
+
+    return;
+}
+
+/**
+ * Drop the oldest log record in the ring buffer. If it was not sent on the
+ * serial interface yet, it will be counted as dropped.
+ */
+static void dropOldestRecord(void)
+{
+    if (0U < gRingUsed)
+    {
+        RecordHead  head;
+        uint16_t    nextIdx = readRecord(gRingTail, head, nullptr);
+
+        if (gSerialSeq == gTailSeq)
+        {
+            gSerialIdx = nextIdx;
+            ++gSerialSeq;
+
+#if LOGGING_ENABLED
+            ++gDropped;
+#endif  /* LOGGING_ENABLED */
+        }
+
+        gRingUsed -= sizeof(RecordHead) + head.msgLen;
+        gRingTail = nextIdx;
+        ++gTailSeq;
+    }
+
+    return;
+}
+
+/**
+ * Write data to the ring buffer at the write index. The caller must ensure
+ * that there is enough space.
+ *
+ * @param[in] data  Data
+ * @param[in] size  Data size in bytes
+ */
+static void ringWrite(const void* data, uint16_t size)
+{
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+
+    while(0U < size)
+    {
+        gRing[gRingHead] = *src;
+
+        ++gRingHead;
+        gRingHead %= CONFIG_LOG_RING_SIZE;
+        ++gRingUsed;
+
+        ++src;
+        --size;
+    }
+
+    return;
+}
+
+/**
+ * Read data from the ring buffer, without removing it.
+ *
+ * @param[in]   idx     Index in the ring buffer, where to start.
+ * @param[out]  data    Data
+ * @param[in]   size    Data size in bytes
+ */
+static void ringRead(uint16_t idx, void* data, uint16_t size)
+{
+    uint8_t* dst = static_cast<uint8_t*>(data);
+
+    while(0U < size)
+    {
+        *dst = gRing[idx];
+
+        ++idx;
+        idx %= CONFIG_LOG_RING_SIZE;
+
+        ++dst;
+        --size;
+    }
+
+    return;
+}
+
+/**
+ * Read a log record from the ring buffer, without removing it.
+ *
+ * @param[in]   idx     Index of the log record in the ring buffer
+ * @param[out]  head    Log record header
+ * @param[out]  msg     Log message in RAM, zero terminated. May be nullptr, if not needed.
+ *
+ * @return Index of the next log record in the ring buffer
+ */
+static uint16_t readRecord(uint16_t idx, RecordHead& head, char* msg)
+{
+    ringRead(idx, &head, sizeof(head));
+    idx = (idx + sizeof(head)) % CONFIG_LOG_RING_SIZE;
+
+    if (nullptr != msg)
+    {
+        ringRead(idx, msg, head.msgLen);
+        msg[head.msgLen] = '\0';
+    }
+
+    return (idx + head.msgLen) % CONFIG_LOG_RING_SIZE;
+}
+
+/**
+ * Format the next line, which to send to the console. Dropped log records
+ * are reported first, then the next log record, which was not sent yet, is
+ * taken from the ring buffer.
+ *
+ * @return If a line is available, it will return true otherwise false.
+ */
+static bool formatNextLine(void)
+{
+    bool isAvailable = true;
+
+    gLineLen = 0U;
+    gLinePos = 0U;
+
+    if (gDroppedShown != gDropped)
+    {
+        formatDropped(gDropped - gDroppedShown);
+
+        gDroppedShown = gDropped;
+    }
+    else if (gSerialSeq != gNextSeq)
+    {
+        RecordHead  head;
+        char        msg[Logging::MSG_MAX_LEN + 1U];
+
+        gSerialIdx = readRecord(gSerialIdx, head, msg);
+        ++gSerialSeq;
+
+        formatRecord(head, msg);
+    }
+    else
+    {
+        isAvailable = false;
+    }
+
+    return isAvailable;
+}
+
+#if LOGGING_TOKENIZED
+
+/**
+ * Format a binary frame, which reports dropped log records.
+ *
+ * @param[in] dropped   Number of dropped log records
+ */
+static void formatDropped(uint32_t dropped)
+{
+    RecordHead head;
+
+    head.timestamp  = millis();
+    head.token      = 0U;
+    head.flags      = Logging::Frame::FLAG_DROPPED | Logging::Frame::FLAG_VALUE;
+    head.value      = static_cast<int32_t>(dropped);
+    head.msgLen     = 0U;
+
+    formatRecord(head, nullptr);
+
+    return;
+}
+
+/**
+ * Format the binary frame of a log record.
+ *
+ * @param[in] head  Log record header
+ * @param[in] msg   Log message in RAM
+ */
+static void formatRecord(const RecordHead& head, const char* msg)
+{
+    uint8_t flags       = head.flags;
+    uint8_t checksum    = 0U;
+    uint8_t idx         = 0U;
+
+    if (0U < head.msgLen)
+    {
+        flags |= Logging::Frame::FLAG_TEXT;
+    }
+
+    gLine[gLineLen] = static_cast<char>(Logging::Frame::SYNC);
+    ++gLineLen;
+
+    lineAppendBytes(&flags, sizeof(flags));
+    lineAppendBytes(&head.token, sizeof(head.token));
+    lineAppendBytes(&head.timestamp, sizeof(head.timestamp));
+
+    if (0U != (flags & Logging::Frame::FLAG_VALUE))
+    {
+        lineAppendBytes(&head.value, sizeof(head.value));
+    }
+
+    if (0U != (flags & Logging::Frame::FLAG_TEXT))
+    {
+        lineAppendBytes(&head.msgLen, sizeof(head.msgLen));
+        lineAppendBytes(msg, head.msgLen);
+    }
+
+    for(idx = 1U; idx < gLineLen; ++idx)
+    {
+        checksum ^= static_cast<uint8_t>(gLine[idx]);
+    }
+
+    lineAppendBytes(&checksum, sizeof(checksum));
+
+    return;
+}
+
+#else   /* not LOGGING_TOKENIZED */
+
+/**
+ * Format a line, which reports dropped log records.
+ *
+ * @param[in] dropped   Number of dropped log records
+ */
+static void formatDropped(uint32_t dropped)
+{
+    lineAppend(reinterpret_cast<const char*>(F("Logging: ")), true, UINT8_MAX);
+    lineAppendUInt(dropped);
+    lineAppend(reinterpret_cast<const char*>(F(" records dropped.")), true, UINT8_MAX);
+    lineAppend("\r\n", false, UINT8_MAX);
+
+    return;
+}
+
+/**
+ * Format the text line of a log record.
+ *
+ * @param[in] head  Log record header
+ * @param[in] msg   Log message in RAM, used if there is no message in program memory.
+ */
+static void formatRecord(const RecordHead& head, const char* msg)
+{
+    /* Show time */
+    lineAppendUInt(head.timestamp / 1000U);
+    lineAppend(" ", false, UINT8_MAX);
+
+    /* Show name of file without path */
+    lineAppend(reinterpret_cast<const char*>(head.fileNameP), true, UINT8_MAX);
+
+    /* Show line number in braces */
+    lineAppend(" (", false, UINT8_MAX);
+    lineAppendUInt(head.line);
+    lineAppend(") - ", false, UINT8_MAX);
+
+    /* Show log type */
+    lineAppend(reinterpret_cast<const char*>(Logging::logTypeToStr(static_cast<Logging::LogType>(head.flags & LOG_TYPE_MASK))), true, UINT8_MAX);
+
+    lineAppend(": ", false, UINT8_MAX);
+
+    /* Show message */
+    if (nullptr != head.msgP)
+    {
+        lineAppend(reinterpret_cast<const char*>(head.msgP), true, UINT8_MAX);
+    }
+    else
+    {
+        lineAppend(msg, false, head.msgLen);
+    }
+
+    /* Show value */
+    if (0U != (head.flags & Logging::Frame::FLAG_VALUE))
+    {
+        lineAppend(" ", false, UINT8_MAX);
+        lineAppendInt(head.value);
+    }
+
+    /* A too long line is truncated, but always terminated. */
+    if ((LINE_SIZE - 2U) < gLineLen)
+    {
+        gLineLen = LINE_SIZE - 2U;
+    }
+
+    lineAppend("\r\n", false, UINT8_MAX);
+
+    return;
+}
+
+#endif  /* not LOGGING_TOKENIZED */
+
+#if LOGGING_TOKENIZED
+
+/**
+ * Append raw bytes to the line buffer, used for binary frames.
+ * The multi-byte values are little endian on the target.
+ *
+ * @param[in] data  Data
+ * @param[in] size  Data size in bytes
+ */
+static void lineAppendBytes(const void* data, uint8_t size)
+{
+    const char* src = static_cast<const char*>(data);
+
+    while((0U < size) && (LINE_SIZE > gLineLen))
+    {
+        gLine[gLineLen] = *src;
+        ++gLineLen;
+
+        ++src;
+        --size;
+    }
+
+    return;
+}
+
+#else   /* not LOGGING_TOKENIZED */
+
+/**
+ * Append a string to the line buffer. If the line buffer is full, the
+ * string will be truncated.
+ *
+ * @param[in] str       String
+ * @param[in] isProgmem Whether the string is in program memory (true) or in RAM (false).
+ * @param[in] maxLen    Max. number of characters to append.
+ */
+static void lineAppend(const char* str, bool isProgmem, uint8_t maxLen)
+{
+    if (nullptr != str)
+    {
+        char data = (true == isProgmem) ? static_cast<char>(pgm_read_byte(str)) : *str;
+
+        while(('\0' != data) && (0U < maxLen) && (LINE_SIZE > gLineLen))
         {
-        case Logging::LOGTYPE_DEBUG:
-            Serial.print(F("DEBUG"));
-            break;
-
-        case Logging::LOGTYPE_INFO:
-            Serial.print(F("INFO"));
-            break;
-
-        case Logging::LOGTYPE_ERROR:
-            Serial.print(F("ERROR"));
-            break;
-        
-        case Logging::LOGTYPE_FATAL:
-            Serial.print(F("FATAL"));
-            break;
- 
-        default:
-            Serial.print(F("?"));
-            break;
+            gLine[gLineLen] = data;
+            ++gLineLen;
+            --maxLen;
+
+            ++str;
+            data = (true == isProgmem) ? static_cast<char>(pgm_read_byte(str)) : *str;
         }
+    }
 
-        Serial.print(F(": "));
+    return;
+}
 
-        ret = true;
+/**
+ * Append a unsigned integer in decimal form to the line buffer.
+ *
+ * @param[in] value Value
+ */
+static void lineAppendUInt(uint32_t value)
+{
+    char    digits[10];
+    uint8_t cnt         = 0U;
+
+    do
+    {
+        digits[cnt] = static_cast<char>('0' + (value % 10U));
+        ++cnt;
+        value /= 10U;
+    }
+    while(0U < value);
+
+    while((0U < cnt) && (LINE_SIZE > gLineLen))
+    {
+        --cnt;
+        gLine[gLineLen] = digits[cnt];
+        ++gLineLen;
+    }
+
+    return;
+}
+
+/**
+ * Append a signed integer in decimal form to the line buffer.
+ *
+ * @param[in] value Value
+ */
+static void lineAppendInt(int32_t value)
+{
+    uint32_t absValue = static_cast<uint32_t>(value);
+
+    if (0 > value)
+    {
+        lineAppend("-", false, UINT8_MAX);
+        absValue = 0U - absValue;
     }
-        
-    return ret;
+
+    lineAppendUInt(absValue);
+
+    return;
 }
+
+#endif  /* not LOGGING_TOKENIZED */
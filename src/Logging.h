@@ -1,6 +1,6 @@
 /* MIT License
  *
- * Copyright (c) 2020 - 2024 Andreas Merkle <web@blue-andi.de>
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -38,23 +38,39 @@
  * Compile Switches
  *****************************************************************************/
 
-#if defined(DEBUG)
+/**
+ * Tokenized logging with a 1 or text logging with 0.
+ *
+ * In tokenized mode every log call site is identified by a token, which is
+ * calculated at compile time from the file name and the line number. The
+ * file names and the log messages are not part of the firmware. On the
+ * serial interface the log records are sent as compact binary frames, which
+ * are decoded on the host by tools/logtoken.py with the token table of the
+ * build.
+ */
+#if !defined(LOGGING_TOKENIZED)
+#define LOGGING_TOKENIZED   (0)
+#endif  /* !defined(LOGGING_TOKENIZED) */
 
 /**
- * Enable logging with a 1 or disable logging with 0 at all.
+ * Enable log output on the serial interface with a 1 or disable it with 0.
+ * It is enabled by default in debug builds only, independent of the tokenized
+ * logging. The log records are kept in RAM in any case, see Logging::getRecord().
  * 
  * Attention: If logging is enabled, don't connect the device to the heatpump,
  *            because logging and heatpump control uses the same serial
  *            interface!
  */
-#define LOGGING_ENABLED (1)
+#if !defined(LOGGING_ENABLED)
 
+#if defined(DEBUG)
+#define LOGGING_ENABLED (1)
 #else   /* not defined(DEBUG) */
-
 #define LOGGING_ENABLED (0)
-
 #endif  /* not defined(DEBUG) */
 
+#endif  /* !defined(LOGGING_ENABLED) */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
@@ -64,28 +80,91 @@
  * Macros
  *****************************************************************************/
 
-#if LOGGING_ENABLED
+#if LOGGING_TOKENIZED
+
+/**
+ * Token of the log call site. The template parameter forces the calculation
+ * at compile time.
+ */
+#define LOGGING_TOKEN()     (Logging::Token<Logging::makeToken(__FILE__, __LINE__)>::value)
+
+/** Log debug information to the console */
+#define LOG_DEBUG(__txt)    Logging::logToken(LOGGING_TOKEN(), Logging::LOGTYPE_DEBUG, __txt)
+
+/** Log information to the console */
+#define LOG_INFO(__txt)     Logging::logToken(LOGGING_TOKEN(), Logging::LOGTYPE_INFO, __txt)
+
+/** Log error information to the console */
+#define LOG_ERROR(__txt)    Logging::logToken(LOGGING_TOKEN(), Logging::LOGTYPE_ERROR, __txt)
+
+/** Log fatal error information to the console */
+#define LOG_FATAL(__txt)    Logging::logToken(LOGGING_TOKEN(), Logging::LOGTYPE_FATAL, __txt)
+
+/** Log debug information with a integer value to the console */
+#define LOG_DEBUG_VAL(__txt, __val) Logging::logToken(LOGGING_TOKEN(), Logging::LOGTYPE_DEBUG, __txt, __val)
+
+/** Log information with a integer value to the console */
+#define LOG_INFO_VAL(__txt, __val)  Logging::logToken(LOGGING_TOKEN(), Logging::LOGTYPE_INFO, __txt, __val)
+
+/** Log error information with a integer value to the console */
+#define LOG_ERROR_VAL(__txt, __val) Logging::logToken(LOGGING_TOKEN(), Logging::LOGTYPE_ERROR, __txt, __val)
+
+/** Log fatal error information with a integer value to the console */
+#define LOG_FATAL_VAL(__txt, __val) Logging::logToken(LOGGING_TOKEN(), Logging::LOGTYPE_FATAL, __txt, __val)
+
+#else   /* not LOGGING_TOKENIZED */
+
+/**
+ * File name of the log call site in program memory. The file name without
+ * path is stored once per translation unit, instead of the whole path, which
+ * the build system provides, per log call site. Therefore only source files
+ * shall log, not headers.
+ */
+#define LOGGING_FILE_NAME() (reinterpret_cast<const __FlashStringHelper*>(gLoggingFileName))
+
+/** Character of the file name without path of the translation unit at compile time. */
+#define LOGGING_FILE_NAME_CHAR(__idx)   Logging::charAt(Logging::baseName(__BASE_FILE__, __BASE_FILE__), (__idx))
 
 /** Log debug information to the console */
-#define LOG_DEBUG(__txt)  Logging::logOutput(F(__FILE__), __LINE__, Logging::LOGTYPE_DEBUG, __txt)
+#define LOG_DEBUG(__txt)  Logging::logOutput(LOGGING_FILE_NAME(), __LINE__, Logging::LOGTYPE_DEBUG, __txt)
 
 /** Log information to the console */
-#define LOG_INFO(__txt)   Logging::logOutput(F(__FILE__), __LINE__, Logging::LOGTYPE_INFO, __txt)
+#define LOG_INFO(__txt)   Logging::logOutput(LOGGING_FILE_NAME(), __LINE__, Logging::LOGTYPE_INFO, __txt)
 
 /** Log error information to the console */
-#define LOG_ERROR(__txt)  Logging::logOutput(F(__FILE__), __LINE__, Logging::LOGTYPE_ERROR, __txt)
+#define LOG_ERROR(__txt)  Logging::logOutput(LOGGING_FILE_NAME(), __LINE__, Logging::LOGTYPE_ERROR, __txt)
 
 /** Log fatal error information to the console */
-#define LOG_FATAL(__txt)  Logging::logOutput(F(__FILE__), __LINE__, Logging::LOGTYPE_FATAL, __txt)
+#define LOG_FATAL(__txt)  Logging::logOutput(LOGGING_FILE_NAME(), __LINE__, Logging::LOGTYPE_FATAL, __txt)
+
+/** Log debug information with a integer value to the console */
+#define LOG_DEBUG_VAL(__txt, __val) Logging::logOutput(LOGGING_FILE_NAME(), __LINE__, Logging::LOGTYPE_DEBUG, __txt, __val)
+
+/** Log information with a integer value to the console */
+#define LOG_INFO_VAL(__txt, __val)  Logging::logOutput(LOGGING_FILE_NAME(), __LINE__, Logging::LOGTYPE_INFO, __txt, __val)
 
-#else
+/** Log error information with a integer value to the console */
+#define LOG_ERROR_VAL(__txt, __val) Logging::logOutput(LOGGING_FILE_NAME(), __LINE__, Logging::LOGTYPE_ERROR, __txt, __val)
 
-#define LOG_DEBUG(__txt)
-#define LOG_INFO(__txt)
-#define LOG_ERROR(__txt)
-#define LOG_FATAL(__txt)
+/** Log fatal error information with a integer value to the console */
+#define LOG_FATAL_VAL(__txt, __val) Logging::logOutput(LOGGING_FILE_NAME(), __LINE__, Logging::LOGTYPE_FATAL, __txt, __val)
 
-#endif
+#endif  /* not LOGGING_TOKENIZED */
+
+#if LOGGING_ENABLED
+
+/** Send pending log records without blocking. Call it periodically in the main loop. */
+#define LOG_PROCESS()     Logging::process()
+
+/** Send all pending log records and wait until they are sent. */
+#define LOG_FLUSH()       Logging::flush()
+
+#else   /* not LOGGING_ENABLED */
+
+#define LOG_PROCESS()
+#define LOG_FLUSH()
+
+#endif  /* not LOGGING_ENABLED */
 
 /******************************************************************************
  * Types and Classes
@@ -107,12 +186,146 @@ typedef enum
     
 } LogType;
 
+/**
+ * Binary frame of a tokenized log record:
+ *
+ * | Offset | Size | Description                                          |
+ * | ------ | ---- | ---------------------------------------------------- |
+ * | 0      | 1    | Sync byte (FRAME_SYNC)                               |
+ * | 1      | 1    | Flags: Log type (bit 0-3), FRAME_FLAG_* (bit 4-7)    |
+ * | 2      | 2    | Token (little endian)                                |
+ * | 4      | 4    | Timestamp in ms (little endian)                      |
+ * | 8      | 4    | Integer value (little endian), only with value flag  |
+ * | n      | 1    | Text length, only with text flag                     |
+ * | n + 1  | m    | Text, only with text flag                            |
+ * | last   | 1    | Checksum: XOR of all bytes after the sync byte       |
+ */
+namespace Frame
+{
+
+/** Sync byte, which starts every frame. */
+static const uint8_t    SYNC            = 0xA5U;
+
+/** Flag: The frame contains a integer value. */
+static const uint8_t    FLAG_VALUE      = 0x10U;
+
+/** Flag: The frame contains a text. */
+static const uint8_t    FLAG_TEXT       = 0x20U;
+
+/** Flag: The frame reports dropped records. The number is the integer value. */
+static const uint8_t    FLAG_DROPPED    = 0x40U;
+
+};
+
+/** Max. length of a log message in RAM, which is kept in a log record. */
+static const uint8_t    MSG_MAX_LEN = 48U;
+
+/** A log record, as provided by getRecord(). */
+struct Record
+{
+    uint32_t                    seq;        /**< Sequence number */
+    uint32_t                    timestamp;  /**< Timestamp in ms */
+    LogType                     logType;    /**< Log type */
+    bool                        hasValue;   /**< Whether the record contains a integer value */
+    int32_t                     value;      /**< Integer value */
+#if LOGGING_TOKENIZED
+    uint16_t                    token;      /**< Token of the log call site */
+#else   /* not LOGGING_TOKENIZED */
+    const __FlashStringHelper*  fileNameP;  /**< File name in program memory */
+    uint16_t                    line;       /**< Line number */
+    const __FlashStringHelper*  msgP;       /**< Log message in program memory or nullptr if the message is in text */
+#endif  /* not LOGGING_TOKENIZED */
+    char                        text[MSG_MAX_LEN + 1U]; /**< Log message in RAM, may be empty */
+};
+
+/**
+ * Calculate the FNV-1a hash of a string at compile time.
+ *
+ * @param[in] str   String
+ * @param[in] hash  Hash of the preceding characters
+ *
+ * @return Hash
+ */
+constexpr uint32_t fnv1a(const char* str, uint32_t hash)
+{
+    return ('\0' == *str) ? hash : fnv1a(str + 1, static_cast<uint32_t>((hash ^ static_cast<uint8_t>(*str)) * UINT32_C(16777619)));
+}
+
+/**
+ * Get the file name without path at compile time.
+ *
+ * @param[in] path  File name with path
+ * @param[in] last  File name start, found so far
+ *
+ * @return File name without path
+ */
+constexpr const char* baseName(const char* path, const char* last)
+{
+    return ('\0' == *path) ? last : baseName(path + 1, (('/' == *path) || ('\\' == *path)) ? (path + 1) : last);
+}
+
+/**
+ * Get a character of a string at compile time. Behind the end of the string,
+ * the string termination is returned.
+ *
+ * @param[in] str   String
+ * @param[in] idx   Index of the character
+ *
+ * @return Character
+ */
+constexpr char charAt(const char* str, uint8_t idx)
+{
+    return (('\0' == *str) || (0U == idx)) ? *str : charAt(str + 1, idx - 1U);
+}
+
+/**
+ * Fold the hash of the file name and the line number to the token.
+ * The token 0 is reserved for records without call site.
+ *
+ * @param[in] hash  Hash of the file name and the line number
+ *
+ * @return Token
+ */
+constexpr uint16_t foldToken(uint32_t hash)
+{
+    return (0U == ((hash >> 16U) ^ (hash & 0xFFFFU))) ? 1U : static_cast<uint16_t>((hash >> 16U) ^ (hash & 0xFFFFU));
+}
+
+/**
+ * Calculate the token of a log call site at compile time.
+ * Must be equal to the calculation in tools/logtoken.py.
+ *
+ * @param[in] path  File name with path
+ * @param[in] line  Line number
+ *
+ * @return Token
+ */
+constexpr uint16_t makeToken(const char* path, uint16_t line)
+{
+    return foldToken(static_cast<uint32_t>((static_cast<uint32_t>((fnv1a(baseName(path, path), UINT32_C(2166136261)) ^ (line & 0xFFU)) * UINT32_C(16777619)) ^ (line >> 8U)) * UINT32_C(16777619)));
+}
+
+/**
+ * Provides a token as compile time constant.
+ *
+ * @tparam token    Token
+ */
+template < uint16_t token >
+struct Token
+{
+    static const uint16_t value = token; /**< Token */
+};
+
 /******************************************************************************
  * Functions
  *****************************************************************************/
 
 /**
- * Log a message to the console
+ * Log a message to the console.
+ *
+ * The log message is only stored as log record in the ring buffer, because
+ * writing to the console would block. The message is copied, but limited
+ * to a max. length.
  * 
  * @param[in] fileNameP Name of the file where the log output happens (string muste be in program memory)
  * @param[in] line      Line number where the log output happens
@@ -122,17 +335,185 @@ typedef enum
 void logOutput(const __FlashStringHelper* fileNameP, int line, LogType logType, const char* str);
 
 /**
- * Log a message to the console
+ * Log a message to the console.
+ *
+ * The log message is only stored as log record in the ring buffer, because
+ * writing to the console would block. The message stays in program memory,
+ * only its address is stored.
  * 
  * @param[in] fileNameP Name of the file where the log output happens (string muste be in program memory)
  * @param[in] line      Line number where the log output happens
  * @param[in] logType   Log type
- * @param[in] str       Log message
+ * @param[in] strP      Log message (string must be in program memory)
  */
 void logOutput(const __FlashStringHelper* fileNameP, int line, LogType logType, const __FlashStringHelper* strP);
 
+/**
+ * Log a message with a integer value to the console.
+ * 
+ * @param[in] fileNameP Name of the file where the log output happens (string muste be in program memory)
+ * @param[in] line      Line number where the log output happens
+ * @param[in] logType   Log type
+ * @param[in] str       Log message
+ * @param[in] value     Integer value, shown after the message.
+ */
+void logOutput(const __FlashStringHelper* fileNameP, int line, LogType logType, const char* str, int32_t value);
+
+/**
+ * Log a message with a integer value to the console.
+ * 
+ * @param[in] fileNameP Name of the file where the log output happens (string muste be in program memory)
+ * @param[in] line      Line number where the log output happens
+ * @param[in] logType   Log type
+ * @param[in] strP      Log message (string must be in program memory)
+ * @param[in] value     Integer value, shown after the message.
+ */
+void logOutput(const __FlashStringHelper* fileNameP, int line, LogType logType, const __FlashStringHelper* strP, int32_t value);
+
+/**
+ * Log a tokenized record to the console.
+ *
+ * @param[in] token     Token of the log call site
+ * @param[in] logType   Log type
+ * @param[in] str       Text in RAM, which is part of the record. May be nullptr.
+ * @param[in] hasValue  Whether the record contains a integer value.
+ * @param[in] value     Integer value
+ */
+void logTokenOutput(uint16_t token, LogType logType, const char* str, bool hasValue, int32_t value);
+
+/**
+ * Log a tokenized record to the console. The log message in program memory
+ * is known by the token table, therefore it is discarded. As the function
+ * is inlined, the message is not part of the firmware.
+ *
+ * @param[in] token     Token of the log call site
+ * @param[in] logType   Log type
+ * @param[in] strP      Log message (string must be in program memory)
+ */
+inline void logToken(uint16_t token, LogType logType, const __FlashStringHelper* strP)
+{
+    (void)strP;
+    logTokenOutput(token, logType, nullptr, false, 0);
+}
+
+/**
+ * Log a tokenized record to the console. A log message in RAM is dynamic,
+ * therefore it is part of the record.
+ *
+ * @param[in] token     Token of the log call site
+ * @param[in] logType   Log type
+ * @param[in] str       Log message
+ */
+inline void logToken(uint16_t token, LogType logType, const char* str)
+{
+    logTokenOutput(token, logType, str, false, 0);
+}
+
+/**
+ * Log a tokenized record with a integer value to the console.
+ *
+ * @param[in] token     Token of the log call site
+ * @param[in] logType   Log type
+ * @param[in] strP      Log message (string must be in program memory)
+ * @param[in] value     Integer value
+ */
+inline void logToken(uint16_t token, LogType logType, const __FlashStringHelper* strP, int32_t value)
+{
+    (void)strP;
+    logTokenOutput(token, logType, nullptr, true, value);
+}
+
+/**
+ * Log a tokenized record with a integer value to the console.
+ *
+ * @param[in] token     Token of the log call site
+ * @param[in] logType   Log type
+ * @param[in] str       Log message
+ * @param[in] value     Integer value
+ */
+inline void logToken(uint16_t token, LogType logType, const char* str, int32_t value)
+{
+    logTokenOutput(token, logType, str, true, value);
+}
+
+/**
+ * Send pending log records to the console, as far as possible without
+ * blocking. Only so many bytes are written, as fit into the serial transmit
+ * buffer. The serial data register empty interrupt sends them afterwards.
+ */
+void process(void);
+
+/**
+ * Send all pending log records to the console and wait until they are
+ * completely sent. Use it only where blocking doesn't matter, e.g. during
+ * startup or before a reset.
+ */
+void flush(void);
+
+/**
+ * Get a log record from the ring buffer. If the requested record was
+ * already dropped, the oldest available record is provided.
+ *
+ * @param[in]   seq     Sequence number of the requested record
+ * @param[out]  record  Log record
+ *
+ * @return If a record with the same or a higher sequence number is available, it will return true otherwise false.
+ */
+bool getRecord(uint32_t seq, Record& record);
+
+/**
+ * Get the sequence number of the oldest log record in the ring buffer.
+ *
+ * @return Sequence number
+ */
+uint32_t getFirstSeq(void);
+
+/**
+ * Get the sequence number, which the next log record will get.
+ *
+ * @return Sequence number
+ */
+uint32_t getNextSeq(void);
+
+/**
+ * Get the user friendly name of a log type.
+ *
+ * @param[in] logType   Log type
+ *
+ * @return Name in program memory
+ */
+const __FlashStringHelper* logTypeToStr(LogType logType);
+
+/**
+ * Get the number of log records, which were dropped before they were sent
+ * on the serial interface, because the ring buffer was full.
+ *
+ * @return Number of dropped log records
+ */
+uint32_t getDroppedRecords(void);
+
 };
 
+#if (0 == LOGGING_TOKENIZED)
+
+/** Max. size of a file name without path incl. string termination, which logs. */
+#define LOGGING_FILE_NAME_SIZE  (24U)
+
+static_assert('\0' == LOGGING_FILE_NAME_CHAR(LOGGING_FILE_NAME_SIZE - 1U), "File name is too long for logging.");
+
+/** File name without path of the translation unit in program memory, see LOGGING_FILE_NAME(). */
+static const char gLoggingFileName[LOGGING_FILE_NAME_SIZE] PROGMEM =
+{
+    LOGGING_FILE_NAME_CHAR(0U),   LOGGING_FILE_NAME_CHAR(1U),   LOGGING_FILE_NAME_CHAR(2U),   LOGGING_FILE_NAME_CHAR(3U),
+    LOGGING_FILE_NAME_CHAR(4U),   LOGGING_FILE_NAME_CHAR(5U),   LOGGING_FILE_NAME_CHAR(6U),   LOGGING_FILE_NAME_CHAR(7U),
+    LOGGING_FILE_NAME_CHAR(8U),   LOGGING_FILE_NAME_CHAR(9U),   LOGGING_FILE_NAME_CHAR(10U),  LOGGING_FILE_NAME_CHAR(11U),
+    LOGGING_FILE_NAME_CHAR(12U),  LOGGING_FILE_NAME_CHAR(13U),  LOGGING_FILE_NAME_CHAR(14U),  LOGGING_FILE_NAME_CHAR(15U),
+    LOGGING_FILE_NAME_CHAR(16U),  LOGGING_FILE_NAME_CHAR(17U),  LOGGING_FILE_NAME_CHAR(18U),  LOGGING_FILE_NAME_CHAR(19U),
+    LOGGING_FILE_NAME_CHAR(20U),  LOGGING_FILE_NAME_CHAR(21U),  LOGGING_FILE_NAME_CHAR(22U),  LOGGING_FILE_NAME_CHAR(23U)
+};
+
+#endif  /* (0 == LOGGING_TOKENIZED) */
+
 #endif  /* __LOGGING_H__ */
 
 /** @} */
\ No newline at end of file
@@ -0,0 +1,356 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Network diagnostics
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "NetDiag.h"
+#include "SimpleTimer.hpp"
+
+#include <SPI.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Chip select pin of the ENC28J60, same as used by the EthernetENC library. */
+#define ENC28J60_CS_PIN         (SS)
+
+/** ENC28J60 SPI opcode: Read control register */
+#define ENC28J60_OP_RCR         (0x00)
+
+/** ENC28J60 SPI opcode: Bit field set */
+#define ENC28J60_OP_BFS         (0x80)
+
+/** ENC28J60 SPI opcode: Bit field clear */
+#define ENC28J60_OP_BFC         (0xA0)
+
+/** ENC28J60 register address mask */
+#define ENC28J60_ADDR_MASK      (0x1F)
+
+/** ENC28J60 ethernet interrupt flag register (available in all banks) */
+#define ENC28J60_EIR            (0x1C)
+
+/** ENC28J60 ethernet control register 1 (available in all banks) */
+#define ENC28J60_ECON1          (0x1F)
+
+/** ENC28J60 ethernet packet count register (bank 1) */
+#define ENC28J60_EPKTCNT        (0x19)
+
+/** EIR: Receive error interrupt flag, set on RX buffer overflow. */
+#define ENC28J60_EIR_RXERIF     (0x01)
+
+/** EIR: Transmit error interrupt flag */
+#define ENC28J60_EIR_TXERIF     (0x02)
+
+/** ECON1: Bank select bits */
+#define ENC28J60_ECON1_BSEL     (0x03)
+
+/** ECON1: Bank select value of bank 1 */
+#define ENC28J60_ECON1_BANK1    (0x01)
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint8_t encReadReg(uint8_t addr);
+static void encBitFieldOp(uint8_t op, uint8_t addr, uint8_t mask);
+static uint8_t encReadPktCnt(void);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Period in ms for polling the network interface controller status. */
+static const uint32_t           POLL_PERIOD     = 100U;
+
+/** SPI settings for the ENC28J60, which supports up to 20 MHz. */
+static const SPISettings        ENC28J60_SPI_SETTINGS(20000000, MSBFIRST, SPI_MODE0);
+
+/** All network diagnostic counters. */
+static NetDiag::Counters        gCounters;
+
+/** Timer used for polling the network interface controller status. */
+static SimpleTimer              gPollTimer;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+size_t NetDiag::CountingClient::write(uint8_t data)
+{
+    size_t written = EthernetClient::write(data);
+
+    gCounters.bytesOut += written;
+
+    return written;
+}
+
+size_t NetDiag::CountingClient::write(const uint8_t* buffer, size_t size)
+{
+    size_t written = EthernetClient::write(buffer, size);
+
+    gCounters.bytesOut += written;
+
+    return written;
+}
+
+int NetDiag::CountingClient::read()
+{
+    int data = EthernetClient::read();
+
+    if (0 <= data)
+    {
+        ++gCounters.bytesIn;
+    }
+
+    return data;
+}
+
+int NetDiag::CountingClient::read(uint8_t* buffer, size_t size)
+{
+    int cnt = EthernetClient::read(buffer, size);
+
+    if (0 < cnt)
+    {
+        gCounters.bytesIn += static_cast<uint32_t>(cnt);
+    }
+
+    return cnt;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+void NetDiag::process(void)
+{
+    if (false == gPollTimer.isTimerRunning())
+    {
+        gPollTimer.start(POLL_PERIOD);
+    }
+    else if (true == gPollTimer.isTimeout())
+    {
+        uint8_t eir     = encReadReg(ENC28J60_EIR);
+        uint8_t pktCnt  = encReadPktCnt();
+
+        /* The error flags are latched by the ENC28J60. Count and clear them,
+         * so the next occurrence can be detected.
+         */
+        if (0 != (eir & ENC28J60_EIR_RXERIF))
+        {
+            ++gCounters.rxOverflows;
+        }
+
+        if (0 != (eir & ENC28J60_EIR_TXERIF))
+        {
+            ++gCounters.txErrors;
+        }
+
+        if (0 != (eir & (ENC28J60_EIR_RXERIF | ENC28J60_EIR_TXERIF)))
+        {
+            encBitFieldOp(ENC28J60_OP_BFC, ENC28J60_EIR, eir & (ENC28J60_EIR_RXERIF | ENC28J60_EIR_TXERIF));
+        }
+
+        if (gCounters.rxPendingMax < pktCnt)
+        {
+            gCounters.rxPendingMax = pktCnt;
+        }
+
+        gPollTimer.restart();
+    }
+
+    return;
+}
+
+void NetDiag::countDhcpMaintain(int result)
+{
+    /* Results of Ethernet.maintain():
+     * 0: Nothing happened
+     * 1: Renew failed
+     * 2: Renew success
+     * 3: Rebind fail
+     * 4: Rebind success
+     */
+    switch(result)
+    {
+    case 1:
+    case 3:
+        ++gCounters.dhcpFailures;
+        break;
+
+    case 2:
+    case 4:
+        ++gCounters.dhcpRenewals;
+        break;
+
+    default:
+        break;
+    }
+
+    return;
+}
+
+void NetDiag::countLinkLoss(void)
+{
+    ++gCounters.linkLosses;
+    return;
+}
+
+void NetDiag::countAccepted(void)
+{
+    ++gCounters.tcpAccepted;
+    return;
+}
+
+void NetDiag::countFailedRequest(bool isConnected, bool isTimedOut)
+{
+    if (false == isConnected)
+    {
+        ++gCounters.tcpReset;
+    }
+    else if (true == isTimedOut)
+    {
+        ++gCounters.tcpTimedOut;
+    }
+    else
+    {
+        ++gCounters.httpBadRequests;
+    }
+
+    return;
+}
+
+void NetDiag::countRequest(void)
+{
+    ++gCounters.httpRequests;
+    gCounters.lastRequest = millis();
+
+    return;
+}
+
+const NetDiag::Counters& NetDiag::getCounters(void)
+{
+    return gCounters;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Read a ENC28J60 ethernet control register in the current selected bank
+ * or a common register, which is available in all banks.
+ *
+ * @param[in] addr  Register address
+ *
+ * @return Register value
+ */
+static uint8_t encReadReg(uint8_t addr)
+{
+    uint8_t value = 0;
+
+    SPI.beginTransaction(ENC28J60_SPI_SETTINGS);
+    digitalWrite(ENC28J60_CS_PIN, LOW);
+
+    (void)SPI.transfer(ENC28J60_OP_RCR | (addr & ENC28J60_ADDR_MASK));
+    value = SPI.transfer(0x00);
+
+    digitalWrite(ENC28J60_CS_PIN, HIGH);
+    SPI.endTransaction();
+
+    return value;
+}
+
+/**
+ * Set or clear bits in a ENC28J60 ethernet control register.
+ *
+ * @param[in] op    Opcode, either bit field set or bit field clear.
+ * @param[in] addr  Register address
+ * @param[in] mask  Bits to set or clear
+ */
+static void encBitFieldOp(uint8_t op, uint8_t addr, uint8_t mask)
+{
+    SPI.beginTransaction(ENC28J60_SPI_SETTINGS);
+    digitalWrite(ENC28J60_CS_PIN, LOW);
+
+    (void)SPI.transfer(op | (addr & ENC28J60_ADDR_MASK));
+    (void)SPI.transfer(mask);
+
+    digitalWrite(ENC28J60_CS_PIN, HIGH);
+    SPI.endTransaction();
+
+    return;
+}
+
+/**
+ * Read the number of received packets, which are waiting in the ENC28J60
+ * receive buffer. The register is located in bank 1, therefore the bank is
+ * switched temporary and restored afterwards. This keeps the bank cached by
+ * the EthernetENC library consistent.
+ *
+ * @return Number of pending packets
+ */
+static uint8_t encReadPktCnt(void)
+{
+    uint8_t bank    = encReadReg(ENC28J60_ECON1) & ENC28J60_ECON1_BSEL;
+    uint8_t pktCnt  = 0;
+
+    encBitFieldOp(ENC28J60_OP_BFC, ENC28J60_ECON1, ENC28J60_ECON1_BSEL);
+    encBitFieldOp(ENC28J60_OP_BFS, ENC28J60_ECON1, ENC28J60_ECON1_BANK1);
+
+    pktCnt = encReadReg(ENC28J60_EPKTCNT);
+
+    encBitFieldOp(ENC28J60_OP_BFC, ENC28J60_ECON1, ENC28J60_ECON1_BSEL);
+
+    if (0 != bank)
+    {
+        encBitFieldOp(ENC28J60_OP_BFS, ENC28J60_ECON1, bank);
+    }
+
+    return pktCnt;
+}
@@ -0,0 +1,205 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Network diagnostics
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Collects counters of the ENC28J60 network interface controller and of the
+ * TCP/IP stack usage, to find out why the device is temporary not reachable.
+ *
+ * @{
+ */
+
+#ifndef __NET_DIAG_H__
+#define __NET_DIAG_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <EthernetClient.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Network diagnostics
+ */
+namespace NetDiag
+{
+
+/** This type defines all network diagnostic counters. */
+struct Counters
+{
+    uint32_t    rxOverflows;      /**< Number of RX buffer overflows (ENC28J60 EIR.RXERIF) */
+    uint32_t    txErrors;         /**< Number of transmit errors (ENC28J60 EIR.TXERIF) */
+    uint8_t     rxPendingMax;     /**< Max. number of received packets, waiting in the ENC28J60 buffer (EPKTCNT) */
+    uint32_t    linkLosses;       /**< Number of link up to link down transitions */
+    uint32_t    dhcpRenewals;     /**< Number of successful DHCP lease renewals and rebinds */
+    uint32_t    dhcpFailures;     /**< Number of failed DHCP lease renewals and rebinds */
+    uint32_t    tcpAccepted;      /**< Number of accepted TCP connections */
+    uint32_t    tcpReset;         /**< Number of TCP connections closed by the peer before the request was complete */
+    uint32_t    tcpTimedOut;      /**< Number of TCP connections, which timed out before the request was complete */
+    uint32_t    httpRequests;     /**< Number of handled HTTP requests */
+    uint32_t    httpBadRequests;  /**< Number of requests, which failed to parse */
+    uint32_t    lastRequest;      /**< Timestamp in ms of the last handled HTTP request */
+    uint32_t    bytesIn;          /**< Number of received TCP payload bytes */
+    uint32_t    bytesOut;         /**< Number of sent TCP payload bytes */
+};
+
+/**
+ * Ethernet client, which counts the transferred payload bytes.
+ * It wraps the client, which is returned by the webserver.
+ */
+class CountingClient : public EthernetClient
+{
+public:
+
+    /**
+     * Constructs a counting client.
+     *
+     * @param[in] client    Ethernet client, which to wrap.
+     */
+    explicit CountingClient(const EthernetClient& client) :
+        EthernetClient(client)
+    {
+    }
+
+    /**
+     * Destroys the counting client.
+     */
+    ~CountingClient()
+    {
+    }
+
+    using EthernetClient::write;
+    using EthernetClient::read;
+
+    /**
+     * Write a single byte.
+     *
+     * @param[in] data  Data byte
+     *
+     * @return Number of written bytes.
+     */
+    size_t write(uint8_t data) override;
+
+    /**
+     * Write several bytes.
+     *
+     * @param[in] buffer    Data buffer
+     * @param[in] size      Data buffer size in bytes
+     *
+     * @return Number of written bytes.
+     */
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    /**
+     * Read a single byte.
+     *
+     * @return Data byte or -1 if no data is available.
+     */
+    int read() override;
+
+    /**
+     * Read several bytes.
+     *
+     * @param[out]  buffer  Data buffer
+     * @param[in]   size    Data buffer size in bytes
+     *
+     * @return Number of read bytes or a negative value if no data is available.
+     */
+    int read(uint8_t* buffer, size_t size) override;
+
+private:
+
+    CountingClient();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Process the network diagnostics. It polls the network interface controller
+ * status periodically. Call it in the main loop.
+ */
+void process(void);
+
+/**
+ * Count the result of a DHCP lease maintenance.
+ *
+ * @param[in] result    Return value of Ethernet.maintain()
+ */
+void countDhcpMaintain(int result);
+
+/**
+ * Count a link up to link down transition.
+ */
+void countLinkLoss(void);
+
+/**
+ * Count an accepted TCP connection.
+ */
+void countAccepted(void);
+
+/**
+ * Count a request, which failed to read. It is distinguished between a peer
+ * which closed/reset the connection, a peer which didn't deliver the complete
+ * request in time and a malformed request.
+ *
+ * @param[in] isConnected   Whether the peer is still connected or not.
+ * @param[in] isTimedOut    Whether reading the request took the stream timeout or longer.
+ */
+void countFailedRequest(bool isConnected, bool isTimedOut);
+
+/**
+ * Count a handled HTTP request.
+ */
+void countRequest(void);
+
+/**
+ * Get all network diagnostic counters.
+ *
+ * @return Network diagnostic counters
+ */
+const Counters& getCounters(void);
+
+};
+
+#endif  /* __NET_DIAG_H__ */
+
+/** @} */
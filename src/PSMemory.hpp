@@ -43,7 +43,7 @@
     INCLUDES
 *******************************************************************************/
 #include "Config.h"
-#include <EEPROM.h>
+#include "Hal.h"
 
 /* Namespace begin */
 namespace PersistentMemory
@@ -74,6 +74,25 @@ namespace PersistentMemory
 /** Address in the persistent memory for the debug data. */
 #define PSMEMORY_S0DATA_DEBUG (PSMEMORY_S0DATA_ADDR + PSMEMORY_S0DATA_SIZE)
 
+/** Size in bytes of the debug data in the persistent memory. */
+#define PSMEMORY_S0DATA_DEBUG_SIZE  (1)
+
+/**
+ * Address in the persistent memory for the status of the network data.
+ * The network data has its own status, because it was added later. This way
+ * the S0 data survives a firmware update.
+ */
+#define PSMEMORY_NET_STATUS_ADDR    (PSMEMORY_S0DATA_DEBUG + PSMEMORY_S0DATA_DEBUG_SIZE)
+
+/** Size in bytes of the status of the network data in the persistent memory. */
+#define PSMEMORY_NET_STATUS_SIZE    (1)
+
+/** Address in the persistent memory for the network data. */
+#define PSMEMORY_NETDATA_ADDR       (PSMEMORY_NET_STATUS_ADDR + PSMEMORY_NET_STATUS_SIZE)
+
+/** Size in bytes of the network data in the persistent memory. */
+#define PSMEMORY_NETDATA_SIZE       (sizeof(NetData))
+
 /*******************************************************************************
     MACROS
 *******************************************************************************/
@@ -148,6 +167,38 @@ struct S0Data
 
 };
 
+/** This type defines the network parameter block. */
+struct NetData
+{
+    bool        isDhcpEnabled;  /**< Get the IP configuration via DHCP (true) or use the static one (false) */
+    uint8_t     ipAddress[4];   /**< Static IP address */
+    uint8_t     subnetMask[4];  /**< Static subnet mask */
+    uint8_t     gateway[4];     /**< Static gateway address */
+    uint8_t     dnsServer[4];   /**< Static DNS server address */
+    uint8_t     syslogServer[4];/**< Syslog collector address, 0.0.0.0 disables the syslog */
+    uint16_t    syslogPort;     /**< Syslog collector UDP port */
+
+    /**
+     * Set default values.
+     */
+    NetData() :
+        isDhcpEnabled(true),
+        ipAddress(),
+        subnetMask(),
+        gateway(),
+        dnsServer(),
+        syslogServer(),
+        syslogPort(514U)
+    {
+        memset(ipAddress, 0, sizeof(ipAddress));
+        memset(subnetMask, 0, sizeof(subnetMask));
+        memset(gateway, 0, sizeof(gateway));
+        memset(dnsServer, 0, sizeof(dnsServer));
+        memset(syslogServer, 0, sizeof(syslogServer));
+    }
+
+};
+
 /**
  * This type defines the status pattern, used to check the status of the data in the
  * persistent memory.
@@ -165,17 +216,19 @@ typedef enum
 /**
  * Initialize the persistent memory module.
  *
- * If the data in the persistent memory is not valid, it will be replaced by
- * default values.
+ * The S0 parameter blocks and the network parameter block have their own
+ * status. If the data of one of them is not valid, only this one will be
+ * replaced by default values. If the number of S0 parameter blocks changed,
+ * the network parameter block moved and both are replaced.
  *
  * @return If the persistent memory data is replaced with defaults, it will return RET_RESTORED.
  *         Otherwise it will return RET_OK, if successfuly loaded.
  */
-Ret init(void)
+inline Ret init(void)
 {
     Ret     ret     = RET_OK;
-    uint8_t status  = EEPROM.read(PSMEMORY_STATUS_ADDR);
-    uint8_t s0Num   = EEPROM.read(PSMEMORY_S0NUM_ADDR);
+    uint8_t status  = Hal::eepromRead(PSMEMORY_STATUS_ADDR);
+    uint8_t s0Num   = Hal::eepromRead(PSMEMORY_S0NUM_ADDR);
 
     if ((STATUS_VALID != status) ||
         (CONFIG_S0_SMARTMETER_MAX_NUM != s0Num))
@@ -183,16 +236,32 @@ Ret init(void)
         uint8_t index         = 0;
         S0Data  s0DataDefault;
 
-        EEPROM.write(PSMEMORY_S0NUM_ADDR, CONFIG_S0_SMARTMETER_MAX_NUM);
+        Hal::eepromUpdate(PSMEMORY_S0NUM_ADDR, CONFIG_S0_SMARTMETER_MAX_NUM);
         
         for(index = 0; index < CONFIG_S0_SMARTMETER_MAX_NUM; ++index)
         {
             snprintf(s0DataDefault.name, sizeof(s0DataDefault.name), "S0-%u", index);
-            EEPROM.put(PSMEMORY_S0DATA_ADDR + index * sizeof(S0Data), s0DataDefault);
+            Hal::eepromPut(PSMEMORY_S0DATA_ADDR + index * sizeof(S0Data), s0DataDefault);
         }
 
-        EEPROM.write(PSMEMORY_S0DATA_DEBUG, 0);
-        EEPROM.write(PSMEMORY_STATUS_ADDR, STATUS_VALID);
+        Hal::eepromUpdate(PSMEMORY_S0DATA_DEBUG, 0);
+        Hal::eepromUpdate(PSMEMORY_STATUS_ADDR, STATUS_VALID);
+
+        /* The network data is located after the S0 data. */
+        if (CONFIG_S0_SMARTMETER_MAX_NUM != s0Num)
+        {
+            Hal::eepromUpdate(PSMEMORY_NET_STATUS_ADDR, 0);
+        }
+
+        ret = RET_RESTORED;
+    }
+
+    if (STATUS_VALID != Hal::eepromRead(PSMEMORY_NET_STATUS_ADDR))
+    {
+        NetData netDataDefault;
+
+        Hal::eepromPut(PSMEMORY_NETDATA_ADDR, netDataDefault);
+        Hal::eepromUpdate(PSMEMORY_NET_STATUS_ADDR, STATUS_VALID);
 
         ret = RET_RESTORED;
     }
@@ -205,7 +274,7 @@ Ret init(void)
  *
  * @return Number of S0 parameter blocks.
  */
-uint8_t getNumS0Data(void)
+inline uint8_t getNumS0Data(void)
 {
     return CONFIG_S0_SMARTMETER_MAX_NUM;
 }
@@ -216,7 +285,7 @@ uint8_t getNumS0Data(void)
  * @param[in]   index   Index of S0 parameter block
  * @param[out]  s0Data  Parameter block
  */
-void readS0Data(uint8_t index, S0Data& s0Data)
+inline void readS0Data(uint8_t index, S0Data& s0Data)
 {
     S0Data s0DataDefault;
 
@@ -224,7 +293,7 @@ void readS0Data(uint8_t index, S0Data& s0Data)
 
     if (CONFIG_S0_SMARTMETER_MAX_NUM > index)
     {
-        EEPROM.get(PSMEMORY_S0DATA_ADDR + index * sizeof(S0Data), s0Data);
+        Hal::eepromGet(PSMEMORY_S0DATA_ADDR + index * sizeof(S0Data), s0Data);
     }
     
     return;
@@ -236,16 +305,90 @@ void readS0Data(uint8_t index, S0Data& s0Data)
  * @param[in]   index   Index of S0 parameter block
  * @param[out]  s0Data  Parameter block
  */
-void writeS0Data(uint8_t index, const S0Data& s0Data)
+inline void writeS0Data(uint8_t index, const S0Data& s0Data)
 {
     if (CONFIG_S0_SMARTMETER_MAX_NUM > index)
     {
-        EEPROM.put(PSMEMORY_S0DATA_ADDR + index * sizeof(S0Data), s0Data);
+        Hal::eepromPut(PSMEMORY_S0DATA_ADDR + index * sizeof(S0Data), s0Data);
     }
     
     return;
 }
  
+/**
+ * Read network parameter block from persistent memory.
+ *
+ * @param[out]  netData Parameter block
+ */
+inline void readNetData(NetData& netData)
+{
+    Hal::eepromGet(PSMEMORY_NETDATA_ADDR, netData);
+
+    return;
+}
+
+/**
+ * Write the whole configuration at once to persistent memory: all S0
+ * parameter blocks and the network parameter block.
+ *
+ * The S0 parameter blocks and the network parameter block are committed one
+ * after the other, each with its own status. The status is invalidated
+ * during the write of its block, so an interrupted write is detected by
+ * init() and leads to defaults of this block only, instead of a mixed
+ * configuration. The other block keeps its data, e.g. a static IP
+ * configuration. A block, which didn't change, is not committed, so its
+ * status isn't written either. Only bytes which changed are written, which
+ * keeps the EEPROM wear low.
+ *
+ * @param[in]   s0DataList  All S0 parameter blocks
+ * @param[in]   numS0Data   Number of S0 parameter blocks, must be getNumS0Data().
+ * @param[in]   netData     Network parameter block
+ *
+ * @return If successful written, it will return RET_OK otherwise RET_ERROR.
+ */
+inline Ret writeConfig(const S0Data* s0DataList, uint8_t numS0Data, const NetData& netData)
+{
+    Ret ret = RET_ERROR;
+
+    if ((nullptr != s0DataList) &&
+        (CONFIG_S0_SMARTMETER_MAX_NUM == numS0Data))
+    {
+        uint8_t index       = 0;
+        bool    isS0Changed = false;
+
+        for(index = 0; index < numS0Data; ++index)
+        {
+            if (false == Hal::eepromIsEqual(PSMEMORY_S0DATA_ADDR + index * sizeof(S0Data), s0DataList[index]))
+            {
+                isS0Changed = true;
+            }
+        }
+
+        if (true == isS0Changed)
+        {
+            Hal::eepromUpdate(PSMEMORY_STATUS_ADDR, 0);
+
+            for(index = 0; index < numS0Data; ++index)
+            {
+                Hal::eepromPut(PSMEMORY_S0DATA_ADDR + index * sizeof(S0Data), s0DataList[index]);
+            }
+
+            Hal::eepromUpdate(PSMEMORY_STATUS_ADDR, STATUS_VALID);
+        }
+
+        if (false == Hal::eepromIsEqual(PSMEMORY_NETDATA_ADDR, netData))
+        {
+            Hal::eepromUpdate(PSMEMORY_NET_STATUS_ADDR, 0);
+            Hal::eepromPut(PSMEMORY_NETDATA_ADDR, netData);
+            Hal::eepromUpdate(PSMEMORY_NET_STATUS_ADDR, STATUS_VALID);
+        }
+
+        ret = RET_OK;
+    }
+
+    return ret;
+}
+ 
 /* Namespace end */ 
 };
 
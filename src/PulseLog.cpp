@@ -0,0 +1,173 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pulse log
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PulseLog.h"
+#include "Config.h"
+#include "Hal.h"
+
+#if PULSE_LOG_ENABLED
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** A pulse record in the ring buffer, the sequence number is derived from its position. */
+struct Entry
+{
+    uint32_t    timestamp;  /**< Timestamp in ms */
+    uint8_t     ids;        /**< S0 interfaces, which counted a pulse */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Ring buffer of the pulse records. */
+static Entry            gEntries[CONFIG_PULSE_LOG_SIZE];
+
+/** Index of the next entry, which to write. */
+static uint8_t          gWriteIdx   = 0U;
+
+/** Sequence number of the next record. */
+static uint32_t         gNextSeq    = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+void PulseLog::record(uint8_t ids)
+{
+    if (0U != ids)
+    {
+        Entry& entry = gEntries[gWriteIdx];
+
+        entry.timestamp = millis();
+        entry.ids       = ids;
+
+        ++gWriteIdx;
+        if (CONFIG_PULSE_LOG_SIZE <= gWriteIdx)
+        {
+            gWriteIdx = 0U;
+        }
+
+        ++gNextSeq;
+    }
+
+    return;
+}
+
+bool PulseLog::getRecord(uint32_t seq, Record& record)
+{
+    bool isAvailable = false;
+
+    HAL_ATOMIC_BLOCK()
+    {
+        uint32_t firstSeq = (CONFIG_PULSE_LOG_SIZE < gNextSeq) ? (gNextSeq - CONFIG_PULSE_LOG_SIZE) : 0U;
+
+        if (firstSeq > seq)
+        {
+            seq = firstSeq;
+        }
+
+        if (gNextSeq > seq)
+        {
+            /* The distance to the next record is at most the ring buffer size. */
+            uint8_t         distance    = static_cast<uint8_t>(gNextSeq - seq);
+            uint8_t         idx         = (gWriteIdx >= distance) ? (gWriteIdx - distance) : (gWriteIdx + CONFIG_PULSE_LOG_SIZE - distance);
+            const Entry&    entry       = gEntries[idx];
+
+            record.seq          = seq;
+            record.timestamp    = entry.timestamp;
+            record.ids          = entry.ids;
+
+            isAvailable = true;
+        }
+    }
+
+    return isAvailable;
+}
+
+uint32_t PulseLog::getFirstSeq(void)
+{
+    uint32_t firstSeq = 0U;
+
+    HAL_ATOMIC_BLOCK()
+    {
+        firstSeq = (CONFIG_PULSE_LOG_SIZE < gNextSeq) ? (gNextSeq - CONFIG_PULSE_LOG_SIZE) : 0U;
+    }
+
+    return firstSeq;
+}
+
+uint32_t PulseLog::getNextSeq(void)
+{
+    uint32_t nextSeq = 0U;
+
+    HAL_ATOMIC_BLOCK()
+    {
+        nextSeq = gNextSeq;
+    }
+
+    return nextSeq;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#endif  /* PULSE_LOG_ENABLED */
@@ -0,0 +1,146 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pulse log
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Records every counted S0 pulse with its timestamp and the S0 interfaces,
+ * which counted it. The records are kept in a small ring buffer and get a
+ * continuous sequence number, like the log records. A host polls them via
+ * GET /api/pulses?since=<seq> and writes them into a pulse trace, which can
+ * be replayed later, see tools/pulsetrace.py.
+ *
+ * @{
+ */
+
+#ifndef __PULSE_LOG_H__
+#define __PULSE_LOG_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/**
+ * Enable the pulse log with a 1 or disable it with 0.
+ * Its ring buffer needs CONFIG_PULSE_LOG_SIZE * 5 bytes RAM, therefore it is
+ * enabled by default in debug builds only.
+ */
+#if !defined(PULSE_LOG_ENABLED)
+
+#if defined(DEBUG)
+#define PULSE_LOG_ENABLED   (1)
+#else   /* not defined(DEBUG) */
+#define PULSE_LOG_ENABLED   (0)
+#endif  /* not defined(DEBUG) */
+
+#endif  /* !defined(PULSE_LOG_ENABLED) */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#if PULSE_LOG_ENABLED
+
+/** Record the S0 interfaces, which counted a pulse. Call it only in the ISR! */
+#define PULSE_LOG_RECORD(_ids)  PulseLog::record(_ids)
+
+#else   /* not PULSE_LOG_ENABLED */
+
+#define PULSE_LOG_RECORD(_ids)  do { (void)(_ids); } while(0)
+
+#endif  /* not PULSE_LOG_ENABLED */
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+#if PULSE_LOG_ENABLED
+
+/**
+ * Pulse log
+ */
+namespace PulseLog
+{
+
+/** A single pulse record. */
+struct Record
+{
+    uint32_t    seq;        /**< Sequence number */
+    uint32_t    timestamp;  /**< Timestamp in ms */
+    uint8_t     ids;        /**< S0 interfaces, which counted a pulse. Bit n is the S0 interface with id n. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Record the S0 interfaces, which counted a pulse. If nothing was counted,
+ * nothing is recorded. The oldest record is overwritten, if the ring buffer
+ * is full. Never call it outside the ISR!
+ *
+ * @param[in] ids   S0 interfaces, which counted a pulse. Bit n is the S0 interface with id n.
+ */
+void record(uint8_t ids);
+
+/**
+ * Get a pulse record. If the requested record was already overwritten,
+ * the oldest available record is provided.
+ *
+ * @param[in]   seq     Sequence number of the requested record
+ * @param[out]  record  Pulse record
+ *
+ * @return If a record with the same or a higher sequence number is available, it will return true otherwise false.
+ */
+bool getRecord(uint32_t seq, Record& record);
+
+/**
+ * Get the sequence number of the oldest pulse record in the ring buffer.
+ *
+ * @return Sequence number
+ */
+uint32_t getFirstSeq(void);
+
+/**
+ * Get the sequence number, which the next pulse record will get.
+ *
+ * @return Sequence number
+ */
+uint32_t getNextSeq(void);
+
+};
+
+#endif  /* PULSE_LOG_ENABLED */
+
+#endif  /* __PULSE_LOG_H__ */
+
+/** @} */
@@ -0,0 +1,251 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  S0 interface model
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "S0Model.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool strToUInt32(const char* str, uint32_t& value);
+static void configFormIsEnabled(void* ctx, const char* value);
+static void configFormName(void* ctx, const char* value);
+static void configFormPinS0(void* ctx, const char* value);
+static void configFormPulsesPerKWH(void* ctx, const char* value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** S0 interface configuration form key: Interface enabled or disabled */
+static const char               FORM_KEY_IS_ENABLED[] PROGMEM       = "isEnabled";
+
+/** S0 interface configuration form key: Interface name */
+static const char               FORM_KEY_NAME[] PROGMEM             = "name";
+
+/** S0 interface configuration form key: Arduino pin number */
+static const char               FORM_KEY_PIN_S0[] PROGMEM           = "pinS0";
+
+/** S0 interface configuration form key: Pulses per kWh */
+static const char               FORM_KEY_PULSES_PER_KWH[] PROGMEM   = "pulsesPerKWH";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+const FormParser::Field S0Model::CONFIG_FORM_FIELDS[S0Model::NUM_CONFIG_FORM_FIELDS] PROGMEM =
+{
+    { FORM_KEY_IS_ENABLED,      configFormIsEnabled     },
+    { FORM_KEY_NAME,            configFormName          },
+    { FORM_KEY_PIN_S0,          configFormPinS0         },
+    { FORM_KEY_PULSES_PER_KWH,  configFormPulsesPerKWH  }
+};
+
+void S0Model::toJson(const S0Smartmeter& s0Smartmeter, const S0Snapshot::Channel& channel, JsonObject& jsonData)
+{
+    jsonData["id"]                  = s0Smartmeter.getId();
+    jsonData["name"]                = s0Smartmeter.getName();
+    jsonData["pulsesPer1KWh"]       = s0Smartmeter.getPulsesPerKWh();
+    jsonData["powerConsumption"]    = channel.powerConsumption;
+    jsonData["pulses"]              = channel.pulseCnt;
+    jsonData["energyConsumption"]   = channel.energyConsumption;
+
+    if (true == channel.hasPulse)
+    {
+        jsonData["lastPulseAge"]    = channel.lastPulseAge;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Convert a string with a decimal number to a unsigned 32-bit integer.
+ * The string must contain only digits.
+ *
+ * @param[in]   str     String
+ * @param[out]  value   Value
+ *
+ * @return If the conversion was successful, it will return true otherwise false.
+ */
+static bool strToUInt32(const char* str, uint32_t& value)
+{
+    bool        isValid = ('\0' != *str);
+    uint32_t    result  = 0U;
+
+    while(('\0' != *str) && (true == isValid))
+    {
+        uint8_t digit = static_cast<uint8_t>(*str - '0');
+
+        if ((9U < digit) ||
+            (((UINT32_MAX - digit) / 10U) < result))
+        {
+            isValid = false;
+        }
+        else
+        {
+            result = result * 10U + digit;
+        }
+
+        ++str;
+    }
+
+    if (true == isValid)
+    {
+        value = result;
+    }
+
+    return isValid;
+}
+
+/**
+ * Handle the S0 interface configuration form field, which enables or disables
+ * the interface.
+ *
+ * @param[in] ctx   S0 interface configuration form context
+ * @param[in] value Decoded field value
+ */
+static void configFormIsEnabled(void* ctx, const char* value)
+{
+    S0Model::ConfigForm*    form    = static_cast<S0Model::ConfigForm*>(ctx);
+    uint32_t                number  = 0U;
+
+    if (true == strToUInt32(value, number))
+    {
+        bool isEnabled = (0U != number);
+
+        if (isEnabled != form->s0Data.isEnabled)
+        {
+            form->s0Data.isEnabled  = isEnabled;
+            form->isDirty           = true;
+        }
+    }
+
+    return;
+}
+
+/**
+ * Handle the S0 interface configuration form field with the interface name.
+ * A empty value clears the name.
+ *
+ * @param[in] ctx   S0 interface configuration form context
+ * @param[in] value Decoded field value
+ */
+static void configFormName(void* ctx, const char* value)
+{
+    S0Model::ConfigForm* form = static_cast<S0Model::ConfigForm*>(ctx);
+
+    if (0 != strncmp(form->s0Data.name, value, sizeof(form->s0Data.name) - 1))
+    {
+        strncpy(form->s0Data.name, value, sizeof(form->s0Data.name) - 1);
+        form->s0Data.name[sizeof(form->s0Data.name) - 1] = '\0';
+
+        form->isDirty = true;
+    }
+
+    return;
+}
+
+/**
+ * Handle the S0 interface configuration form field with the arduino pin number.
+ *
+ * @param[in] ctx   S0 interface configuration form context
+ * @param[in] value Decoded field value
+ */
+static void configFormPinS0(void* ctx, const char* value)
+{
+    S0Model::ConfigForm*    form    = static_cast<S0Model::ConfigForm*>(ctx);
+    uint32_t                pinNo   = 0U;
+
+    if ((true == strToUInt32(value, pinNo)) &&
+        (pinNo != form->s0Data.pinS0) &&
+        (S0Pin::mcPinRangeMin <= pinNo) &&
+        (S0Pin::mcPinRangeMax >= pinNo))
+    {
+        form->s0Data.pinS0  = static_cast<uint8_t>(pinNo);
+        form->isDirty       = true;
+    }
+
+    return;
+}
+
+/**
+ * Handle the S0 interface configuration form field with the number of pulses per kWh.
+ *
+ * @param[in] ctx   S0 interface configuration form context
+ * @param[in] value Decoded field value
+ */
+static void configFormPulsesPerKWH(void* ctx, const char* value)
+{
+    S0Model::ConfigForm*    form    = static_cast<S0Model::ConfigForm*>(ctx);
+    uint32_t                pulses  = 0U;
+
+    if ((true == strToUInt32(value, pulses)) &&
+        (pulses != form->s0Data.pulsesPerKWH) &&
+        (S0Smartmeter::PULSES_PER_KWH_RANGE_MIN <= pulses) &&
+        (S0Smartmeter::PULSES_PER_KWH_RANGE_MAX >= pulses))
+    {
+        form->s0Data.pulsesPerKWH   = pulses;
+        form->isDirty               = true;
+    }
+
+    return;
+}
@@ -0,0 +1,106 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  S0 interface model
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Converts the S0 interfaces to and from their web representation. It is
+ * independent of the web server, therefore it can be used by the host
+ * benchmarks too.
+ *
+ * @{
+ */
+
+#ifndef __S0_MODEL_H__
+#define __S0_MODEL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#include "FormParser.h"
+#include "PSMemory.hpp"
+#include "S0Smartmeter.hpp"
+#include "S0Snapshot.hpp"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * S0 interface model
+ */
+namespace S0Model
+{
+
+/**
+ * Context of a S0 interface configuration update, used by the form field handlers.
+ */
+struct ConfigForm
+{
+    PersistentMemory::S0Data    s0Data;     /**< S0 interface configuration */
+    bool                        isDirty;    /**< Whether the configuration was changed */
+};
+
+/** Number of S0 interface configuration form fields. */
+static const uint8_t            NUM_CONFIG_FORM_FIELDS  = 4U;
+
+/**
+ * S0 interface configuration form fields in program memory. The user
+ * context of the form parser must be a ConfigForm.
+ */
+extern const FormParser::Field  CONFIG_FORM_FIELDS[NUM_CONFIG_FORM_FIELDS];
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Convert the captured values of a S0 smartmeter to JSON. The age of the
+ * last pulse is only added, if a pulse was counted.
+ *
+ * @param[in]   s0Smartmeter    S0 smartmeter
+ * @param[in]   channel         Captured values of the S0 smartmeter
+ * @param[out]  jsonData        JSON object, which is filled
+ */
+void toJson(const S0Smartmeter& s0Smartmeter, const S0Snapshot::Channel& channel, JsonObject& jsonData);
+
+};
+
+#endif  /* __S0_MODEL_H__ */
+
+/** @} */
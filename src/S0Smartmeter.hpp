@@ -41,7 +41,8 @@
 /*******************************************************************************
     INCLUDES
 *******************************************************************************/
-#include <util/atomic.h>
+#include "Hal.h"
+#include "CritSect.h"
 
 /*******************************************************************************
     CONSTANTS
@@ -107,7 +108,7 @@ public:
          * arduino pinout doesn't support pin change interrupts on the whole port A.
          * Otherwise it would be easy: attachInterrupt(digitalPinToInterrupt(mPinS0), mISR, FALLING);
          */
-        PCMSK0 |= _BV(m_pinNo - mcPinRangeMin);
+        Hal::enableS0PinChange(m_pinNo - mcPinRangeMin);
         
         return;
     }
@@ -121,7 +122,7 @@ public:
          * arduino pinout doesn't support pin change interrupts on the whole port A.
          * Otherwise it would be easy: detachInterrupt(digitalPinToInterrupt(mPinS0));
          */
-        PCMSK0 &= ~_BV(m_pinNo - mcPinRangeMin);
+        Hal::disableS0PinChange(m_pinNo - mcPinRangeMin);
         
         return;
     }
@@ -180,10 +181,11 @@ public:
         m_energyPerPulse(0),
         m_s0Pin(),
         m_pulseCnt(0),
-        m_timestamp(0L),
+        m_timestamp(0U),
         m_isFirstPulse(true),
         m_powerConsumption(0L),
-        m_lastTimeDiff(0L)
+        m_lastTimeDiff(0U),
+        m_decPowerDuration(0U)
     {
         
     }
@@ -297,6 +299,16 @@ public:
         return m_pulsesPerKWH;
     }
 
+    /**
+     * Get the energy of a single pulse.
+     * 
+     * @return Energy per pulse in Ws
+     */
+    uint32_t getEnergyPerPulse(void) const
+    {
+        return m_energyPerPulse;
+    }
+
     /**
      * Get current number of counted pulses.
      *
@@ -306,9 +318,9 @@ public:
     {
         uint32_t pulseCnt = 0;
         
-        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        CRITICAL_SECTION(CritSect::SITE_S0_GET_PULSE_CNT)
         {
-            pulseCnt = m_pulseCnt;
+            pulseCnt = HAL_SHARED_LOAD(m_pulseCnt);
         }
         
         return pulseCnt;
@@ -320,8 +332,19 @@ public:
      */
     void internalISR(void)
     {
-        unsigned long timestamp = millis();
-    
+        internalISR(millis());
+
+        return;
+    }
+
+    /**
+     * Handle a S0 smartmeter update with a given timestamp of the pulse.
+     * Never call it outside an ISR, except for benchmark and test purposes!
+     *
+     * @param[in] timestamp Timestamp of the pulse in ms, which wraps around like on the target
+     */
+    void internalISR(uint32_t timestamp)
+    {
         /* Count the pulse continuously */
         ++m_pulseCnt;
     
@@ -332,7 +355,10 @@ public:
         {
             m_isFirstPulse = false;
         }
-        else
+        /* A bouncing signal may cause two pulses within the same ms, which can't be used
+         * for the power calculation.
+         */
+        else if (timestamp != m_timestamp)
         {
             /* Calculate time till the last pulse. */
             m_lastTimeDiff      = timestamp - m_timestamp;
@@ -355,14 +381,15 @@ public:
      * 
      * @param[out] powerConsumption   Power consumption in W
      * @param[out] energyConsumption  Energy consumption in Ws
-     * @param[out] pulseCnt           Number of pulses counted since last call
+     * @param[out] pulseCnt           Number of pulses counted since start, which wraps around.
+     *                                Use a delta read cursor to get the pulses since the last read.
      */
     void getResult(unsigned long& powerConsumption, unsigned long& energyConsumption, uint32_t& pulseCnt)
     {    
-        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        CRITICAL_SECTION(CritSect::SITE_S0_GET_RESULT)
         {
-            powerConsumption  = m_powerConsumption;
-            pulseCnt          = m_pulseCnt;
+            powerConsumption  = HAL_SHARED_LOAD(m_powerConsumption);
+            pulseCnt          = HAL_SHARED_LOAD(m_pulseCnt);
         }
 
         energyConsumption = pulseCnt * m_energyPerPulse;
@@ -370,6 +397,26 @@ public:
         return;
     }
 
+    /**
+     * Get the values, which are shared with the ISR, without an own critical
+     * section. It is used to take all S0 smartmeters at the same point in time.
+     * Call it only with masked interrupts!
+     * 
+     * @param[out] pulseCnt             Number of pulses counted since start
+     * @param[out] powerConsumption     Power consumption in W
+     * @param[out] lastPulseTimestamp   Timestamp in ms of the last pulse
+     * 
+     * @return If at least one pulse was counted, it will return true otherwise false.
+     */
+    bool getSharedValues(uint32_t& pulseCnt, unsigned long& powerConsumption, uint32_t& lastPulseTimestamp) const
+    {
+        pulseCnt            = HAL_SHARED_LOAD(m_pulseCnt);
+        powerConsumption    = HAL_SHARED_LOAD(m_powerConsumption);
+        lastPulseTimestamp  = HAL_SHARED_LOAD(m_timestamp);
+
+        return (false == HAL_SHARED_LOAD(m_isFirstPulse));
+    }
+
     /**
      * Handle S0 smartmeter power consumption calculation.
      * This mechanism is used in case that a high power consumption changes to a low power consumption.
@@ -382,35 +429,39 @@ public:
         /* S0 smartmeter must be enabled and the mechanism can only be used
          * in case at least 2 pulses were received at all.
          */
-        if ((true == m_isEnabled) && (false == m_isFirstPulse))
+        if ((true == m_isEnabled) && (false == HAL_SHARED_LOAD(m_isFirstPulse)))
         {
-            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            CRITICAL_SECTION(CritSect::SITE_S0_PROCESS)
             {
+                unsigned long powerConsumption = HAL_SHARED_LOAD(m_powerConsumption);
+
                 /* If power is greater than 0, it will be checked whether it is time to decrease the power consumption. */
-                if (0 < m_powerConsumption)
+                if (0 < powerConsumption)
                 {
-                    unsigned long timeTillLastPulse = millis() - m_timestamp;
+                    /* The time is calculated with 32 bit like on the target, where unsigned long is 32 bit. */
+                    uint32_t    timeTillLastPulse   = static_cast<uint32_t>(millis()) - HAL_SHARED_LOAD(m_timestamp);
+                    uint32_t    decPowerDuration    = HAL_SHARED_LOAD(m_decPowerDuration);
 
                     /* Time to decrease the power consumption? */
-                    if (m_decPowerDuration <= timeTillLastPulse)
+                    if (decPowerDuration <= timeTillLastPulse)
                     {
-                        unsigned long delta = ( m_energyPerPulse * 1000 ) / m_decPowerDuration; /* W */
+                        unsigned long delta = ( m_energyPerPulse * 1000 ) / decPowerDuration; /* W */
 
                         if (1 >= delta)
                         {
-                            m_powerConsumption = 0;
+                            HAL_SHARED_STORE(m_powerConsumption, 0);
                         }
-                        else if (delta >= m_powerConsumption)
+                        else if (delta >= powerConsumption)
                         {
-                            m_powerConsumption = 0;
+                            HAL_SHARED_STORE(m_powerConsumption, 0);
                         }
                         else
                         {
-                            m_powerConsumption -= delta;
+                            HAL_SHARED_STORE(m_powerConsumption, powerConsumption - delta);
                         }
 
                         /* Calculate next time for decreasing the power consumption again. */
-                        m_decPowerDuration *= 2;
+                        HAL_SHARED_STORE(m_decPowerDuration, decPowerDuration * 2);
                     }
                 }
             }
@@ -433,11 +484,11 @@ private:
     S0Pin       m_s0Pin;            /**< S0 pin configuration */
 
     volatile uint32_t       m_pulseCnt;         /**< Counted pulses */
-    volatile unsigned long  m_timestamp;        /**< Timestamp in ms of last pulse */
+    volatile uint32_t       m_timestamp;        /**< Timestamp in ms of last pulse */
     volatile bool           m_isFirstPulse;     /**< Used to initialize the m_timestamp with the first pulse. */
     volatile unsigned long  m_powerConsumption; /**< Power consumption in W */
-    volatile unsigned long  m_lastTimeDiff;     /**< Last duration in ms between the last 2 pulses. */
-    volatile unsigned long  m_decPowerDuration; /**< Duration until the power will be decreased automatically because no pulse received yet. */
+    volatile uint32_t       m_lastTimeDiff;     /**< Last duration in ms between the last 2 pulses. */
+    volatile uint32_t       m_decPowerDuration; /**< Duration until the power will be decreased automatically because no pulse received yet. */
 
     /* Never copy an S0 smartmeter instance! */
     S0Smartmeter(const S0Smartmeter& interf);
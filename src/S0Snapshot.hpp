@@ -0,0 +1,220 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Snapshot of all S0 interfaces
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The S0 interfaces are taken in one critical section with one capture
+ * timestamp, so derived values of a response (e.g. the house minus the
+ * heat pump) are from the same point in time. Every capture gets a
+ * continuous sequence number, which a consumer can use to detect that it
+ * got the same snapshot again or to correlate several responses.
+ *
+ * @{
+ */
+
+#ifndef __S0_SNAPSHOT_HPP__
+#define __S0_SNAPSHOT_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include "Config.h"
+#include "CritSect.h"
+#include "S0Smartmeter.hpp"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Snapshot of all S0 interfaces at one point in time.
+ */
+class S0Snapshot
+{
+public:
+
+    /** The values of a single S0 interface. */
+    struct Channel
+    {
+        bool            isEnabled;          /**< S0 interface is enabled or disabled */
+        bool            hasPulse;           /**< At least one pulse was counted */
+        uint32_t        pulseCnt;           /**< Number of pulses counted since start */
+        unsigned long   powerConsumption;   /**< Power consumption in W */
+        unsigned long   energyConsumption;  /**< Energy consumption in Ws */
+        uint32_t        lastPulseAge;       /**< Time in ms since the last pulse, only valid if a pulse was counted */
+    };
+
+    /**
+     * Constructs a empty snapshot.
+     */
+    S0Snapshot() :
+        m_seq(0U),
+        m_timestamp(0U),
+        m_numChannels(0U),
+        m_channels()
+    {
+    }
+
+    /**
+     * Destroys the snapshot.
+     */
+    ~S0Snapshot()
+    {
+    }
+
+    /**
+     * Capture all S0 interfaces with masked interrupts. The sequence number
+     * is incremented with every capture.
+     *
+     * @param[in] s0Smartmeters     S0 smartmeters
+     * @param[in] numS0Smartmeters  Number of S0 smartmeters, more than CONFIG_S0_SMARTMETER_MAX_NUM are ignored.
+     */
+    void capture(const S0Smartmeter* s0Smartmeters, uint8_t numS0Smartmeters)
+    {
+        uint32_t        lastPulseTimestamps[CONFIG_S0_SMARTMETER_MAX_NUM];
+        uint8_t         idx                 = 0U;
+
+        if (CONFIG_S0_SMARTMETER_MAX_NUM < numS0Smartmeters)
+        {
+            numS0Smartmeters = CONFIG_S0_SMARTMETER_MAX_NUM;
+        }
+
+        /* Only the values shared with the ISR are copied with masked interrupts. */
+        CRITICAL_SECTION(CritSect::SITE_S0_SNAPSHOT)
+        {
+            m_timestamp = static_cast<uint32_t>(millis());
+
+            for(idx = 0U; idx < numS0Smartmeters; ++idx)
+            {
+                Channel& channel = m_channels[idx];
+
+                channel.hasPulse = s0Smartmeters[idx].getSharedValues(channel.pulseCnt, channel.powerConsumption, lastPulseTimestamps[idx]);
+            }
+        }
+
+        for(idx = 0U; idx < numS0Smartmeters; ++idx)
+        {
+            completeChannel(s0Smartmeters[idx], m_timestamp, lastPulseTimestamps[idx], m_channels[idx]);
+        }
+
+        m_numChannels = numS0Smartmeters;
+        ++m_seq;
+
+        return;
+    }
+
+    /**
+     * Complete the captured values of a S0 interface with the ones, which
+     * are not shared with the ISR. The shared ones (hasPulse, pulseCnt and
+     * powerConsumption) must be taken via S0Smartmeter::getSharedValues()
+     * before.
+     *
+     * @param[in]       s0Smartmeter        S0 smartmeter
+     * @param[in]       timestamp           Capture timestamp in ms
+     * @param[in]       lastPulseTimestamp  Timestamp in ms of the last pulse
+     * @param[in,out]   channel             Captured values of the S0 interface
+     */
+    static void completeChannel(const S0Smartmeter& s0Smartmeter, uint32_t timestamp, uint32_t lastPulseTimestamp, Channel& channel)
+    {
+        channel.isEnabled           = s0Smartmeter.isEnabled();
+        channel.energyConsumption   = channel.pulseCnt * s0Smartmeter.getEnergyPerPulse();
+        channel.lastPulseAge        = (true == channel.hasPulse) ? (timestamp - lastPulseTimestamp) : 0U;
+
+        return;
+    }
+
+    /**
+     * Get the sequence number of the last capture. It is 0 before the first one.
+     *
+     * @return Sequence number
+     */
+    uint32_t getSeq(void) const
+    {
+        return m_seq;
+    }
+
+    /**
+     * Get the capture timestamp.
+     *
+     * @return Timestamp in ms
+     */
+    uint32_t getTimestamp(void) const
+    {
+        return m_timestamp;
+    }
+
+    /**
+     * Get the number of captured S0 interfaces.
+     *
+     * @return Number of S0 interfaces
+     */
+    uint8_t getNumChannels(void) const
+    {
+        return m_numChannels;
+    }
+
+    /**
+     * Get the captured values of a S0 interface.
+     *
+     * @param[in] idx   Index of the S0 interface, must be lower than getNumChannels().
+     *
+     * @return Values of the S0 interface
+     */
+    const Channel& getChannel(uint8_t idx) const
+    {
+        return m_channels[idx];
+    }
+
+private:
+
+    uint32_t    m_seq;                                      /**< Sequence number of the last capture */
+    uint32_t    m_timestamp;                                /**< Capture timestamp in ms */
+    uint8_t     m_numChannels;                              /**< Number of captured S0 interfaces */
+    Channel     m_channels[CONFIG_S0_SMARTMETER_MAX_NUM];   /**< Captured values per S0 interface */
+
+    S0Snapshot(const S0Snapshot& snapshot);
+    S0Snapshot& operator=(const S0Snapshot& snapshot);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __S0_SNAPSHOT_HPP__ */
+
+/** @} */
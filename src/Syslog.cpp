@@ -0,0 +1,465 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Syslog
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Syslog.h"
+#include "Config.h"
+#include "Logging.h"
+#include "SimpleTimer.hpp"
+
+#include <EthernetENC.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool isEnabled(void);
+static void sendBatch(void);
+static void writeMsg(void);
+static void formatLost(uint32_t seq, uint32_t lost);
+static void formatRecord(const Logging::Record& record);
+static void formatHead(uint8_t severity, uint32_t seq, uint32_t timestamp);
+static void msgAppend(const char* str, bool isProgmem);
+static void msgAppendUInt(uint32_t value);
+static void msgAppendInt(int32_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Syslog facility: local use 0 */
+static const uint8_t        FACILITY            = 16U;
+
+/** Syslog severity: Critical */
+static const uint8_t        SEVERITY_CRITICAL   = 2U;
+
+/** Syslog severity: Error */
+static const uint8_t        SEVERITY_ERROR      = 3U;
+
+/** Syslog severity: Warning */
+static const uint8_t        SEVERITY_WARNING    = 4U;
+
+/** Syslog severity: Informational */
+static const uint8_t        SEVERITY_INFO       = 6U;
+
+/** Syslog severity: Debug */
+static const uint8_t        SEVERITY_DEBUG      = 7U;
+
+/** Max. size of a single syslog message in bytes. */
+static const uint8_t        MSG_SIZE            = 160U;
+
+/** Period in ms, after which the rate limiter allows one more datagram. */
+static const uint32_t       REFILL_PERIOD       = 1000U / CONFIG_SYSLOG_RATE;
+
+/** UDP socket, used to send the datagrams. */
+static EthernetUDP          gUdp;
+
+/** Syslog collector IP address. */
+static IPAddress            gCollector;
+
+/** Syslog collector UDP port. */
+static uint16_t             gPort               = 0U;
+
+/** Sequence number of the next log record, which to send. */
+static uint32_t             gSeq                = 0U;
+
+/** Number of lost log records. */
+static uint32_t             gLost               = 0U;
+
+/** Number of datagrams, which may be sent immediately (token bucket). */
+static uint8_t              gTokens             = CONFIG_SYSLOG_BURST;
+
+/** Timer, used to refill the token bucket. */
+static SimpleTimer          gRefillTimer;
+
+/** Buffer with the syslog message, which is currently formatted. */
+static char                 gMsg[MSG_SIZE];
+
+/** Length of the syslog message in the buffer. */
+static uint8_t              gMsgLen             = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+void Syslog::init(const IPAddress& collector, uint16_t port)
+{
+    gCollector  = collector;
+    gPort       = port;
+    gSeq        = Logging::getFirstSeq();
+    gTokens     = CONFIG_SYSLOG_BURST;
+
+    gRefillTimer.start(REFILL_PERIOD);
+
+    return;
+}
+
+void Syslog::process(void)
+{
+    if (true == isEnabled())
+    {
+        if (true == gRefillTimer.isTimeout())
+        {
+            if (CONFIG_SYSLOG_BURST > gTokens)
+            {
+                ++gTokens;
+            }
+
+            gRefillTimer.restart();
+        }
+
+        /* Log records are only sent, as long as the rate limit allows it.
+         * Otherwise they are collected and sent later together.
+         */
+        if ((0U < gTokens) &&
+            (gSeq != Logging::getNextSeq()))
+        {
+            sendBatch();
+            --gTokens;
+        }
+    }
+
+    return;
+}
+
+uint32_t Syslog::getLostRecords(void)
+{
+    return gLost;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Is the syslog enabled?
+ *
+ * @return If a collector is configured, it will return true otherwise false.
+ */
+static bool isEnabled(void)
+{
+    return ((0U != gPort) && (0U != static_cast<uint32_t>(gCollector)));
+}
+
+/**
+ * Send the pending log records in one datagram, but not more than the max.
+ * number of records per batch. If the datagram can't be sent, the records
+ * stay pending and are sent again later.
+ */
+static void sendBatch(void)
+{
+    Logging::Record record;
+    uint32_t        seq         = gSeq;
+    uint32_t        lost        = 0U;
+    uint8_t         cnt         = 0U;
+
+    /* If no memory for the datagram is available, it is tried again later. */
+    if (0 != gUdp.beginPacket(gCollector, gPort))
+    {
+        while((CONFIG_SYSLOG_BATCH_SIZE > cnt) &&
+              (true == Logging::getRecord(seq, record)))
+        {
+            uint32_t recordLost = record.seq - seq;
+
+            /* Report lost records, instead of the record itself. The record is
+             * sent with the next message.
+             */
+            if (0U < recordLost)
+            {
+                formatLost(seq, recordLost);
+
+                lost += recordLost;
+                seq = record.seq;
+            }
+            else
+            {
+                formatRecord(record);
+
+                seq = record.seq + 1U;
+            }
+
+            writeMsg();
+            ++cnt;
+        }
+
+        if (0 != gUdp.endPacket())
+        {
+            gSeq    = seq;
+            gLost  += lost;
+        }
+    }
+
+    return;
+}
+
+/**
+ * Write the formatted syslog message to the datagram. If several messages
+ * can be sent in one datagram, they are framed according to RFC 6587.
+ */
+static void writeMsg(void)
+{
+#if (1 < CONFIG_SYSLOG_BATCH_SIZE) && (0 != CONFIG_SYSLOG_OCTET_COUNTING)
+    (void)gUdp.print(static_cast<unsigned int>(gMsgLen));
+    (void)gUdp.write(static_cast<uint8_t>(' '));
+#endif  /* (1 < CONFIG_SYSLOG_BATCH_SIZE) && (0 != CONFIG_SYSLOG_OCTET_COUNTING) */
+
+    (void)gUdp.write(reinterpret_cast<const uint8_t*>(gMsg), gMsgLen);
+
+#if (1 < CONFIG_SYSLOG_BATCH_SIZE) && (0 == CONFIG_SYSLOG_OCTET_COUNTING)
+    (void)gUdp.write(static_cast<uint8_t>('\n'));
+#endif  /* (1 < CONFIG_SYSLOG_BATCH_SIZE) && (0 == CONFIG_SYSLOG_OCTET_COUNTING) */
+
+    return;
+}
+
+/**
+ * Format the syslog message, which reports lost log records.
+ *
+ * @param[in] seq   Sequence number of the first lost log record
+ * @param[in] lost  Number of lost log records
+ */
+static void formatLost(uint32_t seq, uint32_t lost)
+{
+    formatHead(SEVERITY_WARNING, seq, millis());
+
+    msgAppend(reinterpret_cast<const char*>(F("Syslog: ")), true);
+    msgAppendUInt(lost);
+    msgAppend(reinterpret_cast<const char*>(F(" records lost.")), true);
+
+    return;
+}
+
+/**
+ * Format the syslog message of a log record.
+ *
+ * @param[in] record    Log record
+ */
+static void formatRecord(const Logging::Record& record)
+{
+    uint8_t severity = SEVERITY_DEBUG;
+
+    switch(record.logType)
+    {
+    case Logging::LOGTYPE_INFO:
+        severity = SEVERITY_INFO;
+        break;
+
+    case Logging::LOGTYPE_ERROR:
+        severity = SEVERITY_ERROR;
+        break;
+
+    case Logging::LOGTYPE_FATAL:
+        severity = SEVERITY_CRITICAL;
+        break;
+
+    case Logging::LOGTYPE_DEBUG:
+    default:
+        severity = SEVERITY_DEBUG;
+        break;
+    }
+
+    formatHead(severity, record.seq, record.timestamp);
+
+#if LOGGING_TOKENIZED
+    msgAppend(reinterpret_cast<const char*>(F("token ")), true);
+    msgAppendUInt(record.token);
+    msgAppend(": ", false);
+    msgAppend(record.text, false);
+#else   /* not LOGGING_TOKENIZED */
+    msgAppend(reinterpret_cast<const char*>(record.fileNameP), true);
+    msgAppend(" (", false);
+    msgAppendUInt(record.line);
+    msgAppend("): ", false);
+
+    if (nullptr != record.msgP)
+    {
+        msgAppend(reinterpret_cast<const char*>(record.msgP), true);
+    }
+    else
+    {
+        msgAppend(record.text, false);
+    }
+#endif  /* not LOGGING_TOKENIZED */
+
+    if (true == record.hasValue)
+    {
+        msgAppend(" ", false);
+        msgAppendInt(record.value);
+    }
+
+    return;
+}
+
+/**
+ * Format the syslog message header (RFC 5424). The device has no real time
+ * clock, therefore the timestamp is left out. Instead the uptime is provided
+ * as structured data, together with the sequence number.
+ *
+ * Example: <134>1 - 192.168.0.2 smartmeter - - [meta sequenceId="1" sysUpTime="150"] 
+ *
+ * @param[in] severity  Syslog severity
+ * @param[in] seq       Sequence number of the log record
+ * @param[in] timestamp Timestamp of the log record in ms
+ */
+static void formatHead(uint8_t severity, uint32_t seq, uint32_t timestamp)
+{
+    IPAddress   localIP = Ethernet.localIP();
+    uint8_t     idx     = 0U;
+
+    gMsgLen = 0U;
+
+    msgAppend("<", false);
+    msgAppendUInt(FACILITY * 8U + severity);
+    msgAppend(">1 - ", false);
+
+    for(idx = 0U; idx < 4U; ++idx)
+    {
+        if (0U < idx)
+        {
+            msgAppend(".", false);
+        }
+
+        msgAppendUInt(localIP[idx]);
+    }
+
+    msgAppend(reinterpret_cast<const char*>(F(" smartmeter - - [meta sequenceId=\"")), true);
+
+    /* The sequence id starts with 1. */
+    msgAppendUInt((seq % INT32_MAX) + 1U);
+    msgAppend(reinterpret_cast<const char*>(F("\" sysUpTime=\"")), true);
+
+    /* The uptime is in hundredths of a second. */
+    msgAppendUInt(timestamp / 10U);
+    msgAppend("\"] ", false);
+
+    return;
+}
+
+/**
+ * Append a string to the syslog message. If the message buffer is full,
+ * the string will be truncated.
+ *
+ * @param[in] str       String
+ * @param[in] isProgmem Whether the string is in program memory (true) or in RAM (false).
+ */
+static void msgAppend(const char* str, bool isProgmem)
+{
+    if (nullptr != str)
+    {
+        char data = (true == isProgmem) ? static_cast<char>(pgm_read_byte(str)) : *str;
+
+        while(('\0' != data) && (MSG_SIZE > gMsgLen))
+        {
+            /* A line feed would split the message at some collectors. */
+            gMsg[gMsgLen] = ('\n' == data) ? ' ' : data;
+            ++gMsgLen;
+
+            ++str;
+            data = (true == isProgmem) ? static_cast<char>(pgm_read_byte(str)) : *str;
+        }
+    }
+
+    return;
+}
+
+/**
+ * Append a unsigned integer in decimal form to the syslog message.
+ *
+ * @param[in] value Value
+ */
+static void msgAppendUInt(uint32_t value)
+{
+    char    digits[10];
+    uint8_t cnt         = 0U;
+
+    do
+    {
+        digits[cnt] = static_cast<char>('0' + (value % 10U));
+        ++cnt;
+        value /= 10U;
+    }
+    while(0U < value);
+
+    while((0U < cnt) && (MSG_SIZE > gMsgLen))
+    {
+        --cnt;
+        gMsg[gMsgLen] = digits[cnt];
+        ++gMsgLen;
+    }
+
+    return;
+}
+
+/**
+ * Append a signed integer in decimal form to the syslog message.
+ *
+ * @param[in] value Value
+ */
+static void msgAppendInt(int32_t value)
+{
+    uint32_t absValue = static_cast<uint32_t>(value);
+
+    if (0 > value)
+    {
+        msgAppend("-", false);
+        absValue = 0U - absValue;
+    }
+
+    msgAppendUInt(absValue);
+
+    return;
+}
@@ -0,0 +1,97 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Syslog
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Sends the log records to a remote syslog collector via UDP (RFC 5424,
+ * RFC 5426).
+ *
+ * @{
+ */
+
+#ifndef __SYSLOG_H__
+#define __SYSLOG_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <IPAddress.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Remote syslog
+ */
+namespace Syslog
+{
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Initialize the syslog. All log records, which are still available in the
+ * log ring buffer, will be sent.
+ *
+ * @param[in] collector Syslog collector IP address. 0.0.0.0 disables the syslog.
+ * @param[in] port      Syslog collector UDP port. 0 disables the syslog.
+ */
+void init(const IPAddress& collector, uint16_t port);
+
+/**
+ * Process the syslog. It sends new log records without blocking and limits
+ * the number of sent datagrams. Log records, which occur in a burst, are
+ * sent together in one datagram, see CONFIG_SYSLOG_BATCH_SIZE. Call it in
+ * the main loop, while the network link is up.
+ */
+void process(void);
+
+/**
+ * Get the number of log records, which were dropped from the log ring
+ * buffer before they were sent.
+ *
+ * @return Number of lost log records
+ */
+uint32_t getLostRecords(void);
+
+};
+
+#endif  /* __SYSLOG_H__ */
+
+/** @} */
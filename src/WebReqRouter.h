@@ -162,12 +162,34 @@ public:
      */
     bool handle(EthernetClient& client, const HttpRequest& httpRequest)
     {
-        uint8_t idx             = 0;
-        bool    isRouteFound    = false;
+        bool            isRouteFound    = false;
+        WebReqHandler   handler         = findRoute(httpRequest.getMethod(), httpRequest.getResource().toString());
 
-        while((NUM_OF_ROUTES > idx) && (false == isRouteFound))
+        if (nullptr != handler)
         {
-            if ((httpRequest.getMethod() == m_routes[idx].method) &&
+            handler(client, httpRequest);
+            isRouteFound = true;
+        }
+
+        return isRouteFound;
+    }
+
+    /**
+     * Find the handler of a web request.
+     *
+     * @param[in] method    Http request method
+     * @param[in] resource  Http request resource
+     *
+     * @return If a route is found, it will return its handler otherwise nullptr.
+     */
+    WebReqHandler findRoute(ArduinoHttpServer::Method method, const String& resource) const
+    {
+        uint8_t         idx     = 0;
+        WebReqHandler   handler = nullptr;
+
+        while((NUM_OF_ROUTES > idx) && (nullptr == handler))
+        {
+            if ((method == m_routes[idx].method) &&
                 (0 < m_routes[idx].uri.length()))
             {
                 int lastIndex = m_routes[idx].uri.lastIndexOf('?');
@@ -175,35 +197,26 @@ public:
                 /* Contains URI a dynamic part? */
                 if (0 <= lastIndex)
                 {
-                    String staticUriPart = m_routes[idx].uri.substring(0, lastIndex);
-
-                    if (0 != httpRequest.getResource().toString().startsWith(staticUriPart))
+                    /* Compare only the static part of the URI. */
+                    if (0 == strncmp(resource.c_str(), m_routes[idx].uri.c_str(), lastIndex))
                     {
-                        isRouteFound = true;
+                        handler = m_routes[idx].handler;
                     }
                 }
                 else
                 /* No dynamic part in URI */
                 {
-                    if (0 != m_routes[idx].uri.equals(httpRequest.getResource().toString()))
+                    if (0 != m_routes[idx].uri.equals(resource))
                     {
-                        isRouteFound = true;
+                        handler = m_routes[idx].handler;
                     }
                 }
             }
 
-            if (false == isRouteFound)
-            {
-                ++idx;
-            }
+            ++idx;
         }
 
-        if (true == isRouteFound)
-        {
-            m_routes[idx].handler(client, httpRequest);
-        }
-
-        return isRouteFound;
+        return handler;
     }
 
 private:
@@ -216,6 +229,54 @@ private:
  * Functions
  *****************************************************************************/
 
+/**
+ * Convert a part of the web request resource to an index, e.g. the S0
+ * interface id of /api/s0-interface/<id>. Only decimal digits are accepted
+ * and the number is range checked, before it is narrowed. Otherwise e.g.
+ * "257" would be converted to the valid index 1.
+ *
+ * @param[in]   part        Resource part
+ * @param[in]   numIndices  Number of valid indices
+ * @param[out]  index       Index, which is only written if it is valid
+ *
+ * @return If the part is a valid index, it will return true otherwise false.
+ */
+inline bool resourceToIndex(const String& part, uint8_t numIndices, uint8_t& index)
+{
+    const char* str     = part.c_str();
+    bool        isValid = ('\0' != *str);
+    uint16_t    value   = 0U;
+
+    while(('\0' != *str) && (true == isValid))
+    {
+        uint8_t digit = static_cast<uint8_t>(*str - '0');
+
+        if (9U < digit)
+        {
+            isValid = false;
+        }
+        else
+        {
+            value = value * 10U + digit;
+
+            /* The value is checked per digit, therefore it can't overflow. */
+            if (numIndices <= value)
+            {
+                isValid = false;
+            }
+        }
+
+        ++str;
+    }
+
+    if (true == isValid)
+    {
+        index = static_cast<uint8_t>(value);
+    }
+
+    return isValid;
+}
+
 #endif  /* __WEB_REQ_ROUTER_H__ */
 
 /** @} */
\ No newline at end of file
@@ -39,15 +39,25 @@
 #include <EthernetServer.h>
 #include <ArduinoHttpServer.h>
 #include <ArduinoJson.h>
-#include <avr/wdt.h>
-#include <avr/io.h>
 
+#include "Hal.h"
 #include "Logging.h"
+#include "NetDiag.h"
+#include "Syslog.h"
+#include "IsrTrace.h"
+#include "PulseLog.h"
+#include "CritSect.h"
+#include "Bench.h"
 #include "WebReqRouter.h"
+#include "HttpBodyStream.h"
+#include "FormParser.h"
 #include "SimpleTimer.hpp"
+#include "DeltaCursors.hpp"
+#include "S0Snapshot.hpp"
 
 #include "PSMemory.hpp"
 #include "S0Smartmeter.hpp"
+#include "S0Model.h"
 
 /******************************************************************************
  * Macros
@@ -88,12 +98,41 @@ static String ipToStr(IPAddress ip);
 static void printNetworkSettings(void);
 static void handleNetwork(void);
 static void handleRoot(EthernetClient& client, const HttpRequest& httpRequest);
-static void s0Smartmeter2JSON(S0Smartmeter& s0Smartmeter, JsonObject& jsonData);
 static void handleS0InterfaceReq(EthernetClient& client, const HttpRequest& httpRequest);
 static void handleS0InterfacesReq(EthernetClient& client, const HttpRequest& httpRequest);
+static void handleS0DeltaReq(EthernetClient& client, const HttpRequest& httpRequest);
 static void handleConfigureGetReq(EthernetClient& client, const HttpRequest& httpRequest);
 static void handleConfigurePostReq(EthernetClient& client, const HttpRequest& httpRequest);
 static void handleResetGetReq(EthernetClient& client, const HttpRequest& httpRequest);
+static void handleDiagNetReq(EthernetClient& client, const HttpRequest& httpRequest);
+static void handleConfigGetReq(EthernetClient& client, const HttpRequest& httpRequest);
+static void handleConfigPutReq(EthernetClient& client, const HttpRequest& httpRequest);
+static void handleLogReq(EthernetClient& client, const HttpRequest& httpRequest);
+#if PULSE_LOG_ENABLED
+static void handlePulsesReq(EthernetClient& client, const HttpRequest& httpRequest);
+#endif  /* PULSE_LOG_ENABLED */
+#if CRIT_SECT_PROFILING_ENABLED
+static void handleDiagIrqReq(EthernetClient& client, const HttpRequest& httpRequest);
+#endif  /* CRIT_SECT_PROFILING_ENABLED */
+#if BENCH_ENABLED
+static void handleDiagBenchReq(EthernetClient& client, const HttpRequest& httpRequest);
+static void benchInternalISR(void* ctx);
+static void benchGetResult(void* ctx);
+static void benchJsonOneChannel(void* ctx);
+static void benchJsonAllChannels(void* ctx);
+static void benchRouterDispatch(void* ctx);
+static void benchEepromReadS0Data(void* ctx);
+#endif  /* BENCH_ENABLED */
+#if ISR_TRACE_ENABLED
+static void handleDiagTraceReq(EthernetClient& client, const HttpRequest& httpRequest);
+static void handleDiagTraceCtrlReq(EthernetClient& client, const HttpRequest& httpRequest);
+#endif  /* ISR_TRACE_ENABLED */
+static void sendJsonString(Print& out, const char* str, bool isProgmem);
+static bool isS0PinConflict(const PersistentMemory::S0Data* s0DataList, uint8_t numS0Data);
+static bool json2S0Data(JsonObjectConst jsonS0Data, PersistentMemory::S0Data& s0Data);
+static bool json2NetData(JsonObjectConst jsonNetData, PersistentMemory::NetData& netData);
+static bool json2Ip(JsonVariantConst jsonIp, uint8_t* ip);
+static void appendHtmlEscaped(String& data, const char* str);
 static void reset(void);
 
 /******************************************************************************
@@ -113,6 +152,7 @@ static LinkStatus               gLinkStatus                 = LINK_STATUS_UNKNOW
 static const char               HTML_PAGE_HEAD[] PROGMEM    = "<!DOCTYPE html>\r\n"
                                                             "<html>\r\n"
                                                             "<head>\r\n"
+                                                            "<meta charset=\"utf-8\">\r\n"
                                                             "<title>AVR-NET-IO-Smartmeter</title>\r\n"
                                                             "</head>\r\n"
                                                             "<body>\r\n";
@@ -121,8 +161,27 @@ static const char               HTML_PAGE_HEAD[] PROGMEM    = "<!DOCTYPE html>\r
 static const char               HTML_PAGE_TAIL[] PROGMEM    = "</body>\r\n"
                                                             "</html>";
 
+/**
+ * Size in bytes of the JSON document, which contains the whole configuration.
+ * A deserialized document with the longest names and IP addresses needs
+ * about 490 bytes on the target.
+ */
+static const size_t             CONFIG_JSON_DOC_SIZE        = 640U;
+
+/** Number of web request routes of the pulse log. */
+static const uint8_t            NUM_PULSE_LOG_ROUTES        = (0 != PULSE_LOG_ENABLED) ? 1 : 0;
+
+/** Number of web request routes of the ISR trace. */
+static const uint8_t            NUM_ISR_TRACE_ROUTES        = (0 != ISR_TRACE_ENABLED) ? 2 : 0;
+
+/** Number of web request routes of the critical section profiler. */
+static const uint8_t            NUM_CRIT_SECT_ROUTES        = (0 != CRIT_SECT_PROFILING_ENABLED) ? 1 : 0;
+
+/** Number of web request routes of the microbenchmarks. */
+static const uint8_t            NUM_BENCH_ROUTES            = (0 != BENCH_ENABLED) ? 1 : 0;
+
 /** Number of supported web request routes. */
-static const uint8_t            NUM_ROUTES                  = 6;
+static const uint8_t            NUM_ROUTES                  = 11 + NUM_PULSE_LOG_ROUTES + NUM_ISR_TRACE_ROUTES + NUM_CRIT_SECT_ROUTES + NUM_BENCH_ROUTES;
 
 /** Web request router */
 static WebReqRouter<NUM_ROUTES> gWebReqRouter;
@@ -136,6 +195,12 @@ static EthernetServer           gWebServer(WEB_SRV_PORT);
 /** All S0 interface instances */
 static S0Smartmeter             gS0Smartmeters[CONFIG_S0_SMARTMETER_MAX_NUM];
 
+/** Snapshot of all S0 interfaces, which every response is served from. */
+static S0Snapshot               gS0Snapshot;
+
+/** Delta read cursors of the S0 interfaces, one per consumer. */
+static DeltaCursors<CONFIG_DELTA_CURSOR_NUM, CONFIG_S0_SMARTMETER_MAX_NUM> gDeltaCursors;
+
 /** Flag is used to signal that a reset was requested via web interface. */
 static bool                     gIsResetReq                 = false;
 
@@ -151,39 +216,98 @@ static uint16_t                 gResetCnt                   = 4000;
  */
 void setup()
 {
-    bool isError = false;
+    bool                        isError = false;
+    PersistentMemory::Ret       psRet   = PersistentMemory::RET_ERROR;
+    PersistentMemory::NetData   netData;
 
     /* Setup serial interface */
     Serial.begin(SERIAL_BAUDRATE);
 
     LOG_INFO(F("Device starts up."));
 
-    if (0 == Ethernet.begin(DEVICE_MAC_ADDR))
+#if CRIT_SECT_PROFILING_ENABLED
+    CritSect::init();
+#endif  /* CRIT_SECT_PROFILING_ENABLED */
+
+#if BENCH_ENABLED
+    Bench::init();
+#endif  /* BENCH_ENABLED */
+
+    /* The persistent memory is required first, because it contains the
+     * network configuration.
+     */
+    LOG_INFO(F("Setup persistent memory."));
+    psRet = PersistentMemory::init();
+
+    if (PersistentMemory::RET_RESTORED == psRet)
+    {
+        LOG_INFO(F("Persistent memory restored."));
+    }
+    else if (PersistentMemory::RET_OK != psRet)
+    {
+        LOG_FATAL(F("Failed to initialize persistent memory."));
+    }
+    else
+    {
+        LOG_INFO(F("Persistent memory is valid."));
+    }
+
+    /* The startup is not timing critical, therefore wait after every phase
+     * until all log records are sent. Otherwise the small ring buffer would
+     * drop them.
+     */
+    LOG_FLUSH();
+
+    PersistentMemory::readNetData(netData);
+
+    if (true == netData.isDhcpEnabled)
     {
-        if (LinkOFF == Ethernet.linkStatus())
+        if (0 == Ethernet.begin(DEVICE_MAC_ADDR))
         {
-            LOG_INFO(F("Ethernet cable not connected."));
+            if (LinkOFF == Ethernet.linkStatus())
+            {
+                LOG_INFO(F("Ethernet cable not connected."));
+            }
+            else if (EthernetNoHardware == Ethernet.hardwareStatus())
+            {
+                LOG_ERROR(F("Ethernet controller not found."));
+                isError = true;
+            }
+            else
+            {
+                LOG_ERROR(F("Couldn't initialize ethernet controller."));
+                isError = true;
+            }
         }
-        else if (EthernetNoHardware == Ethernet.hardwareStatus())
+    }
+    else
+    {
+        LOG_INFO(F("Use static IP configuration."));
+
+        Ethernet.begin(DEVICE_MAC_ADDR,
+                       IPAddress(netData.ipAddress),
+                       IPAddress(netData.dnsServer),
+                       IPAddress(netData.gateway),
+                       IPAddress(netData.subnetMask));
+
+        if (EthernetNoHardware == Ethernet.hardwareStatus())
         {
             LOG_ERROR(F("Ethernet controller not found."));
             isError = true;
         }
-        else
-        {
-            LOG_ERROR(F("Couldn't initialize ethernet controller."));
-            isError = true;
-        }
     }
 
+    LOG_FLUSH();
+
     if (false == isError)
     {
-        uint8_t                 index = 0;
-        String                  tmp;
-        PersistentMemory::Ret   psRet = PersistentMemory::RET_ERROR;
+        uint8_t index = 0;
+        String  tmp;
 
         LOG_INFO(F("Ethernet controller initialized."));
 
+        Syslog::init(IPAddress(netData.syslogServer), netData.syslogPort);
+
         if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/", handleRoot))
         {
             LOG_ERROR(F("Failed to add route."));
@@ -199,6 +323,11 @@ void setup()
             LOG_ERROR(F("Failed to add route."));
         }
 
+        if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/api/s0-interfaces/delta?", handleS0DeltaReq))
+        {
+            LOG_ERROR(F("Failed to add route."));
+        }
+
         if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/configure/?", handleConfigureGetReq))
         {
             LOG_ERROR(F("Failed to add route."));
@@ -214,21 +343,60 @@ void setup()
             LOG_ERROR(F("Failed to add route."));
         }
 
-        LOG_INFO(F("Setup persistent memory."));
-        psRet = PersistentMemory::init();
+        if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/api/diagnostics/net", handleDiagNetReq))
+        {
+            LOG_ERROR(F("Failed to add route."));
+        }
+
+        if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/api/config", handleConfigGetReq))
+        {
+            LOG_ERROR(F("Failed to add route."));
+        }
+
+        if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Put, "/api/config", handleConfigPutReq))
+        {
+            LOG_ERROR(F("Failed to add route."));
+        }
 
-        if (PersistentMemory::RET_RESTORED == psRet)
+        if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/api/log?", handleLogReq))
         {
-            LOG_INFO(F("Persistent memory restored."));
+            LOG_ERROR(F("Failed to add route."));
         }
-        else if (PersistentMemory::RET_OK != psRet)
+
+#if PULSE_LOG_ENABLED
+        if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/api/pulses?", handlePulsesReq))
         {
-            LOG_FATAL(F("Failed to initialize persistent memory."));
+            LOG_ERROR(F("Failed to add route."));
         }
-        else
+#endif  /* PULSE_LOG_ENABLED */
+
+#if CRIT_SECT_PROFILING_ENABLED
+        if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/api/diagnostics/irq", handleDiagIrqReq))
+        {
+            LOG_ERROR(F("Failed to add route."));
+        }
+#endif  /* CRIT_SECT_PROFILING_ENABLED */
+
+#if BENCH_ENABLED
+        if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/api/diagnostics/bench", handleDiagBenchReq))
+        {
+            LOG_ERROR(F("Failed to add route."));
+        }
+#endif  /* BENCH_ENABLED */
+
+#if ISR_TRACE_ENABLED
+        if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Get, "/api/diagnostics/trace", handleDiagTraceReq))
+        {
+            LOG_ERROR(F("Failed to add route."));
+        }
+
+        if (false == gWebReqRouter.addRoute(ArduinoHttpServer::Method::Post, "/api/diagnostics/trace/?", handleDiagTraceCtrlReq))
         {
-            LOG_INFO(F("Persistent memory is valid."));
+            LOG_ERROR(F("Failed to add route."));
         }
+#endif  /* ISR_TRACE_ENABLED */
+
+        LOG_FLUSH();
 
         LOG_INFO(F("Setup S0 interfaces."));
         for(index = 0; index < CONFIG_S0_SMARTMETER_MAX_NUM; ++index)
@@ -260,18 +428,20 @@ void setup()
                 {
                     gS0Smartmeters[index].enable();
                 }
+
+                LOG_FLUSH();
             }
         }
 
         /* Start listening for clients. */
         gWebServer.begin();
 
-        /* Enable pin change interrupt 0 in general, because the S0 interfaces
-         * are all on port A of the ATmega644.
-         */
-        PCICR |= _BV(PCIE0);
+        /* Enable the pin change interrupt of the S0 port in general. */
+        Hal::enableS0Interrupt();
     }
 
+    LOG_FLUSH();
+
     if (true == isError)
     {
         /* Wait infinite. */
@@ -292,6 +462,13 @@ void loop()
     uint8_t s0SmartmeterIndex = 0;
 
     handleNetwork();
+    NetDiag::process();
+    LOG_PROCESS();
+
+    if (LINK_STATUS_UP == gLinkStatus)
+    {
+        Syslog::process();
+    }
 
     /* Is a reset requested? */
     if (true == gIsResetReq)
@@ -386,7 +563,7 @@ static void handleNetwork(void)
 {
     EthernetLinkStatus  linkStatus = Ethernet.linkStatus();
 
-    Ethernet.maintain();
+    NetDiag::countDhcpMaintain(Ethernet.maintain());
 
     /* Link status unknown? */
     if (Unknown == linkStatus)
@@ -404,6 +581,11 @@ static void handleNetwork(void)
         if (LINK_STATUS_DOWN != gLinkStatus)
         {
             LOG_INFO(F("Link is down."));
+
+            if (LINK_STATUS_UP == gLinkStatus)
+            {
+                NetDiag::countLinkLoss();
+            }
         }
 
         gLinkStatus = LINK_STATUS_DOWN;
@@ -424,15 +606,24 @@ static void handleNetwork(void)
 
         if (true == client)
         {
-            HttpRequest httpRequest(client);
+            /* All requests and responses are routed through the counting client,
+             * to get the number of transferred bytes for the network diagnostics.
+             */
+            NetDiag::CountingClient countingClient(client);
+            HttpRequest             httpRequest(countingClient);
+            uint32_t                requestStart    = millis();
+
+            NetDiag::countAccepted();
 
             /* Parse the request */
             if (true == httpRequest.readRequest())
             {
-                if (false == gWebReqRouter.handle(client, httpRequest))
+                NetDiag::countRequest();
+
+                if (false == gWebReqRouter.handle(countingClient, httpRequest))
                 {
                     /* Send a 404 back, which means "Not Found" */
-                    ArduinoHttpServer::StreamHttpErrorReply httpReply(client, httpRequest.getContentType(), "404");
+                    ArduinoHttpServer::StreamHttpErrorReply httpReply(countingClient, httpRequest.getContentType(), "404");
 
                     LOG_ERROR(F("Requested page not found."));
                     LOG_ERROR(httpRequest.getResource().toString().c_str());
@@ -447,7 +638,15 @@ static void handleNetwork(void)
                  *
                  * Send a 400 back, which means "Bad Request".
                  */
-                ArduinoHttpServer::StreamHttpErrorReply httpReply(client, httpRequest.getContentType(), "400");
+                ArduinoHttpServer::StreamHttpErrorReply httpReply(countingClient, httpRequest.getContentType(), "400");
+
+                /* The request parser doesn't report a timeout itself. A read,
+                 * which timed out, waited at least the timeout of the stream,
+                 * which the parser uses.
+                 */
+                bool isTimedOut = (countingClient.getTimeout() <= (millis() - requestStart));
+
+                NetDiag::countFailedRequest(0 != countingClient.connected(), isTimedOut);
 
                 LOG_ERROR(F("HTTP parsing failed."));
                 LOG_ERROR(httpRequest.getError().cStr());
@@ -471,6 +670,8 @@ static void handleRoot(EthernetClient& client, const HttpRequest& httpRequest)
     uint8_t                             s0SmartmeterIndex = 0;
     String                              tmp;
 
+    gS0Snapshot.capture(gS0Smartmeters, CONFIG_S0_SMARTMETER_MAX_NUM);
+
     data += reinterpret_cast<const __FlashStringHelper*>(HTML_PAGE_HEAD);
     data += F("<h1>AVR-NET-IO-Smartmeter</h1>\r\n");
 
@@ -487,11 +688,7 @@ static void handleRoot(EthernetClient& client, const HttpRequest& httpRequest)
         }
         else
         {
-            unsigned long powerConsumption  = 0;
-            uint32_t      pulseCnt          = 0;
-            unsigned long energyConsumption = 0;
-
-            s0Smartmeter.getResult(powerConsumption, energyConsumption, pulseCnt);
+            const S0Snapshot::Channel& channel = gS0Snapshot.getChannel(s0SmartmeterIndex);
 
             data += F("<h2>Interface ");
             data += s0SmartmeterIndex;
@@ -501,15 +698,15 @@ static void handleRoot(EthernetClient& client, const HttpRequest& httpRequest)
             data += F("<ul>\r\n");
 
             data += F("    <li>Power Consumption: ");
-            data += powerConsumption;
+            data += channel.powerConsumption;
             data += F(" W</li>\r\n");
 
             data += F("    <li>Pulses counted: ");
-            data += pulseCnt;
+            data += channel.pulseCnt;
             data += F("</li>\r\n");
 
             data += F("    <li>Energy Consumption: ");
-            data += energyConsumption;
+            data += channel.energyConsumption;
             data += F(" Ws</li>\r\n");
 
             data += F("</ul>\r\n");
@@ -523,30 +720,6 @@ static void handleRoot(EthernetClient& client, const HttpRequest& httpRequest)
     return;
 }
 
-/**
- * Add S0 smartmeter parameters to JSON object.
- *
- * @param[in]       s0SmartmeterIndex   Index of the S0 smartmeter
- * @param[inout]    jsonData            JSON data object
- */
-static void s0Smartmeter2JSON(S0Smartmeter& s0Smartmeter, JsonObject& jsonData)
-{
-    unsigned long powerConsumption  = 0;
-    uint32_t      pulseCnt          = 0;
-    unsigned long energyConsumption = 0;
-
-    s0Smartmeter.getResult(powerConsumption, energyConsumption, pulseCnt);
-
-    jsonData["id"]                  = s0Smartmeter.getId();
-    jsonData["name"]                = s0Smartmeter.getName();
-    jsonData["pulsesPer1KWh"]       = s0Smartmeter.getPulsesPerKWh();
-    jsonData["powerConsumption"]    = powerConsumption;
-    jsonData["pulses"]              = pulseCnt;
-    jsonData["energyConsumption"]   = energyConsumption;
-
-    return;
-}
-
 /**
  * Handle the route for the /api/s0-interface/? folder, which responds with the data
  * in JSON format.
@@ -558,10 +731,13 @@ static void handleS0InterfaceReq(EthernetClient& client, const HttpRequest& http
 {
     ArduinoHttpServer::StreamHttpReply  httpReply(client, "application/json");
     String                              data;
-    uint8_t                             s0SmartmeterIndex   = httpRequest.getResource()[2].toInt();
+    uint8_t                             s0SmartmeterIndex   = CONFIG_S0_SMARTMETER_MAX_NUM;
     DynamicJsonDocument                 jsonDoc(256);
     JsonObject                          jsonData            = jsonDoc.createNestedObject("data");
 
+    /* A invalid id keeps the index out of range. */
+    (void)resourceToIndex(httpRequest.getResource()[2], CONFIG_S0_SMARTMETER_MAX_NUM, s0SmartmeterIndex);
+
     if (CONFIG_S0_SMARTMETER_MAX_NUM <= s0SmartmeterIndex)
     {
         jsonDoc["status"] = STATUS_ID_EPAR;
@@ -570,12 +746,16 @@ static void handleS0InterfaceReq(EthernetClient& client, const HttpRequest& http
     {
         S0Smartmeter& s0Smartmeter = gS0Smartmeters[s0SmartmeterIndex];
 
+        gS0Snapshot.capture(gS0Smartmeters, CONFIG_S0_SMARTMETER_MAX_NUM);
+
         if (true == s0Smartmeter.isEnabled())
         {
-            s0Smartmeter2JSON(s0Smartmeter, jsonData);
+            S0Model::toJson(s0Smartmeter, gS0Snapshot.getChannel(s0SmartmeterIndex), jsonData);
         }
 
-        jsonDoc["status"] = STATUS_ID_OK;
+        jsonDoc["seq"]          = gS0Snapshot.getSeq();
+        jsonDoc["timestamp"]    = gS0Snapshot.getTimestamp();
+        jsonDoc["status"]       = STATUS_ID_OK;
     }
 
     (void)serializeJson(jsonDoc, data);
@@ -600,6 +780,8 @@ static void handleS0InterfacesReq(EthernetClient& client, const HttpRequest& htt
     DynamicJsonDocument                 jsonDoc(CONFIG_S0_SMARTMETER_MAX_NUM * 256);
     JsonArray                           jsonDataArray     = jsonDoc.createNestedArray("data");
 
+    gS0Snapshot.capture(gS0Smartmeters, CONFIG_S0_SMARTMETER_MAX_NUM);
+
     for(s0SmartmeterIndex = 0; s0SmartmeterIndex < CONFIG_S0_SMARTMETER_MAX_NUM; ++s0SmartmeterIndex)
     {
         S0Smartmeter& s0Smartmeter = gS0Smartmeters[s0SmartmeterIndex];
@@ -608,11 +790,92 @@ static void handleS0InterfacesReq(EthernetClient& client, const HttpRequest& htt
         {
             JsonObject jsonData = jsonDataArray.createNestedObject();
 
-            s0Smartmeter2JSON(s0Smartmeter, jsonData);
+            S0Model::toJson(s0Smartmeter, gS0Snapshot.getChannel(s0SmartmeterIndex), jsonData);
         }
     }
 
-    jsonDoc["status"] = STATUS_ID_OK;
+    jsonDoc["seq"]          = gS0Snapshot.getSeq();
+    jsonDoc["timestamp"]    = gS0Snapshot.getTimestamp();
+    jsonDoc["status"]       = STATUS_ID_OK;
+
+    (void)serializeJson(jsonDoc, data);
+
+    httpReply.send(data);
+
+    return;
+}
+
+/**
+ * Handle the route for the /api/s0-interfaces/delta?cursor=<id>, which responds
+ * with the pulses and the energy consumption since the last read with the same
+ * cursor in JSON format. The cursor is moved to the current pulse counters.
+ * A request with a invalid or missing cursor id doesn't move any cursor.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handleS0DeltaReq(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    ArduinoHttpServer::StreamHttpReply  httpReply(client, "application/json");
+    String                              data;
+    String                              resource            = httpRequest.getResource().toString();
+    const char*                         cursorParam         = strstr(resource.c_str(), "cursor=");
+    uint8_t                             cursorId            = CONFIG_DELTA_CURSOR_NUM;
+    uint8_t                             s0SmartmeterIndex   = 0;
+    uint32_t                            pulseCnts[CONFIG_S0_SMARTMETER_MAX_NUM];
+    uint32_t                            deltas[CONFIG_S0_SMARTMETER_MAX_NUM];
+    uint32_t                            duration            = 0U;
+    DynamicJsonDocument                 jsonDoc(CONFIG_S0_SMARTMETER_MAX_NUM * 64 + 64);
+    JsonArray                           jsonDataArray       = jsonDoc.createNestedArray("data");
+
+    if (nullptr != cursorParam)
+    {
+        String  cursorValue = cursorParam + strlen("cursor=");
+        int     end         = cursorValue.indexOf('&');
+
+        if (0 <= end)
+        {
+            cursorValue = cursorValue.substring(0, end);
+        }
+
+        /* A invalid id keeps the cursor id out of range. */
+        (void)resourceToIndex(cursorValue, CONFIG_DELTA_CURSOR_NUM, cursorId);
+    }
+
+    /* The cursor moves to one snapshot of all counters. */
+    gS0Snapshot.capture(gS0Smartmeters, CONFIG_S0_SMARTMETER_MAX_NUM);
+
+    for(s0SmartmeterIndex = 0; s0SmartmeterIndex < CONFIG_S0_SMARTMETER_MAX_NUM; ++s0SmartmeterIndex)
+    {
+        pulseCnts[s0SmartmeterIndex] = gS0Snapshot.getChannel(s0SmartmeterIndex).pulseCnt;
+    }
+
+    if (false == gDeltaCursors.read(cursorId, pulseCnts, gS0Snapshot.getTimestamp(), deltas, duration))
+    {
+        jsonDoc["status"] = STATUS_ID_EPAR;
+    }
+    else
+    {
+        for(s0SmartmeterIndex = 0; s0SmartmeterIndex < CONFIG_S0_SMARTMETER_MAX_NUM; ++s0SmartmeterIndex)
+        {
+            S0Smartmeter& s0Smartmeter = gS0Smartmeters[s0SmartmeterIndex];
+
+            if (true == s0Smartmeter.isEnabled())
+            {
+                JsonObject jsonData = jsonDataArray.createNestedObject();
+
+                jsonData["id"]                  = s0Smartmeter.getId();
+                jsonData["pulses"]              = deltas[s0SmartmeterIndex];
+                jsonData["energyConsumption"]   = deltas[s0SmartmeterIndex] * s0Smartmeter.getEnergyPerPulse();
+            }
+        }
+
+        jsonDoc["cursor"]       = cursorId;
+        jsonDoc["duration"]     = duration;
+        jsonDoc["seq"]          = gS0Snapshot.getSeq();
+        jsonDoc["timestamp"]    = gS0Snapshot.getTimestamp();
+        jsonDoc["status"]       = STATUS_ID_OK;
+    }
 
     (void)serializeJson(jsonDoc, data);
 
@@ -631,7 +894,10 @@ static void handleConfigureGetReq(EthernetClient& client, const HttpRequest& htt
 {
     ArduinoHttpServer::StreamHttpReply  httpReply(client, "text/html");
     String                              data;
-    uint8_t                             s0SmartmeterIndex = httpRequest.getResource()[1].toInt();
+    uint8_t                             s0SmartmeterIndex = CONFIG_S0_SMARTMETER_MAX_NUM;
+
+    /* A invalid id keeps the index out of range. */
+    (void)resourceToIndex(httpRequest.getResource()[1], CONFIG_S0_SMARTMETER_MAX_NUM, s0SmartmeterIndex);
 
     data += reinterpret_cast<const __FlashStringHelper*>(HTML_PAGE_HEAD);
     data += F("<h1>AVR-NET-IO-Smartmeter</h1>\r\n");
@@ -674,7 +940,7 @@ static void handleConfigureGetReq(EthernetClient& client, const HttpRequest& htt
         /* Interface user friendly name */
         data += F("Name: ");
         data += F("<input name=\"name\" type=\"text\" value=\"");
-        data += s0Data.name;
+        appendHtmlEscaped(data, s0Data.name);
         data += F("\"><br />\r\n");
 
         /* Arduino pin number, where the S0 is connected to */
@@ -719,152 +985,43 @@ static void handleConfigurePostReq(EthernetClient& client, const HttpRequest& ht
 {
     ArduinoHttpServer::StreamHttpReply  httpReply(client, "text/html");
     String                              data;
-    uint8_t                             s0SmartmeterIndex = httpRequest.getResource()[1].toInt();
-    const char*                         body              = httpRequest.getBody();
-    char*                               tokStr            = strtok(const_cast<char*>(body), "=");
-    const char*                         isEnabledStr      = PSTR("isEnabled");
-    const char*                         nameStr           = PSTR("name");
-    const char*                         pinS0Str          = PSTR("pinS0");
-    const char*                         pulsesPer_kWhStr  = PSTR("pulsesPerKWH");
-    PersistentMemory::S0Data            s0Data;
+    uint8_t                             s0SmartmeterIndex = CONFIG_S0_SMARTMETER_MAX_NUM;
+    HttpBodyStream                      body(client, httpRequest);
+    S0Model::ConfigForm                 form;
+    char                                value[sizeof(form.s0Data.name)];
+    FormParser                          formParser(S0Model::CONFIG_FORM_FIELDS,
+                                                   S0Model::NUM_CONFIG_FORM_FIELDS,
+                                                   value,
+                                                   sizeof(value),
+                                                   &form);
+    PersistentMemory::S0Data&           s0Data            = form.s0Data;
     bool                                isDirty           = false;
-    long                                value             = 0;
+    int                                 bodyData          = 0;
+
+    /* A invalid id keeps the index out of range. */
+    (void)resourceToIndex(httpRequest.getResource()[1], CONFIG_S0_SMARTMETER_MAX_NUM, s0SmartmeterIndex);
 
     PersistentMemory::readS0Data(s0SmartmeterIndex, s0Data);
+    form.isDirty = false;
 
-    /* Parameter are key:value pairs:
-     * <key>=[<value>][&]
+    /* Parameter are key:value pairs: <key>=[<value>][&]
+     * The body is parsed as the bytes arrive, therefore it may be larger
+     * than the buffer of the request.
      */
-    while(NULL != tokStr)
+    bodyData = body.read();
+    while(0 <= bodyData)
     {
-        /* Count number of characters till the value of the current key.
-         * This is necessary to check whether a value is available or not.
-         */
-        size_t cnt = strcspn(body, tokStr) + strlen(tokStr) + 1;
-
-        LOG_DEBUG(tokStr);
-
-        /* Interface enabled or not? */
-        if (0 == strcmp_P(tokStr, isEnabledStr))
-        {
-            /* Value available? */
-            if ('&' != body[cnt])
-            {
-                tokStr = strtok(NULL, "&");
-
-                if (NULL != tokStr)
-                {
-                    bool  isEnabled = false;
-
-                    value = atol(tokStr);
-
-                    if (0 == value)
-                    {
-                        isEnabled = false;
-                    }
-                    else
-                    {
-                        isEnabled = true;
-                    }
-
-                    if (isEnabled != s0Data.isEnabled)
-                    {
-                        s0Data.isEnabled = value;
-
-                        isDirty = true;
-                    }
-                }
-            }
-        }
-        /* Interface name? */
-        else if (0 == strcmp_P(tokStr, nameStr))
-        {
-            // Value not available?
-            if ('&' == body[cnt])
-            {
-                if (0 != strlen(s0Data.name))
-                {
-                    s0Data.name[0] = '\0';
-
-                    isDirty = true;
-                }
-            }
-            else
-            {
-                tokStr = strtok(NULL, "&");
-
-                if (NULL != tokStr)
-                {
-                    if (0 != strncmp(s0Data.name, tokStr, sizeof(s0Data.name) - 1))
-                    {
-                        strncpy(s0Data.name, tokStr, sizeof(s0Data.name) - 1);
-                        s0Data.name[sizeof(s0Data.name) - 1] = '\0';
-
-                        isDirty = true;
-                    }
-                }
-            }
-        }
-        /* S0 pin? */
-        else if (0 == strcmp_P(tokStr, pinS0Str))
-        {
-            // Value available?
-            if ('&' != body[cnt])
-            {
-                tokStr = strtok(NULL, "&");
-
-                if (NULL != tokStr)
-                {
-                    value = atol(tokStr);
-
-                    if ((0 <= value) &&
-                        (UINT8_MAX >= value))
-                    {
-                        uint8_t pinNo = static_cast<uint8_t>(value);
-
-                        if ((pinNo != s0Data.pinS0) &&
-                            (S0Pin::mcPinRangeMin <= pinNo) &&
-                            (S0Pin::mcPinRangeMax >= pinNo))
-                        {
-                            s0Data.pinS0 = pinNo;
-
-                            isDirty = true;
-                        }
-                    }
-                }
-            }
-        }
-        /* Pulses per kWh? */
-        else if (0 == strcmp_P(tokStr, pulsesPer_kWhStr))
-        {
-            // Value available?
-            if ('&' != body[cnt])
-            {
-                tokStr = strtok(NULL, "&");
-
-                if (NULL != tokStr)
-                {
-                    value = atol(tokStr);
-
-                    if (0 <= value)
-                    {
-                        uint32_t pulses = static_cast<uint32_t>(value);
-
-                        if ((pulses != s0Data.pulsesPerKWH) &&
-                            (S0Smartmeter::PULSES_PER_KWH_RANGE_MIN <= pulses) &&
-                            (S0Smartmeter::PULSES_PER_KWH_RANGE_MAX >= pulses))
-                        {
-                            s0Data.pulsesPerKWH = pulses;
+        formParser.parse(static_cast<char>(bodyData));
+        bodyData = body.read();
+    }
+    formParser.finish();
 
-                            isDirty = true;
-                        }
-                    }
-                }
-            }
-        }
+    isDirty = form.isDirty;
 
-        /* Next key:value pair */
-        tokStr = strtok(NULL, "=");
+    /* Never store the configuration of a not existing interface. */
+    if (CONFIG_S0_SMARTMETER_MAX_NUM <= s0SmartmeterIndex)
+    {
+        isDirty = false;
     }
 
     data += reinterpret_cast<const __FlashStringHelper*>(HTML_PAGE_HEAD);
@@ -873,33 +1030,23 @@ static void handleConfigurePostReq(EthernetClient& client, const HttpRequest& ht
     if (true == isDirty)
     {
         uint8_t                   index       = 0;
-        PersistentMemory::S0Data  s0DataOther;
+        PersistentMemory::S0Data  s0DataList[CONFIG_S0_SMARTMETER_MAX_NUM];
         bool                      isInvalid   = false;
 
         /* Verify that the new parameters are valid to all other
          * activated interfaces.
          */
-        for(index = 0; (index < CONFIG_S0_SMARTMETER_MAX_NUM) && (false == isInvalid); ++index)
+        for(index = 0; index < CONFIG_S0_SMARTMETER_MAX_NUM; ++index)
         {
-            if (index != s0SmartmeterIndex)
-            {
-                PersistentMemory::readS0Data(s0SmartmeterIndex, s0DataOther);
-
-                /* Enabled? */
-                if (0 != s0DataOther.isEnabled)
-                {
-                    /* Pin already configured? */
-                    if (s0DataOther.pinS0 == s0Data.pinS0)
-                    {
-                        isInvalid = true;
-                    }
-                }
-            }
+            PersistentMemory::readS0Data(index, s0DataList[index]);
         }
 
+        s0DataList[s0SmartmeterIndex] = s0Data;
+        isInvalid = isS0PinConflict(s0DataList, CONFIG_S0_SMARTMETER_MAX_NUM);
+
         if (true == isInvalid)
         {
-            LOG_INFO("Parameter not updated, because they are invalid.");
+            LOG_INFO(F("Parameter not updated, because they are invalid."));
 
             data += F("Parameter not updated, because they are invalid.");
         }
@@ -907,14 +1054,14 @@ static void handleConfigurePostReq(EthernetClient& client, const HttpRequest& ht
         {
             PersistentMemory::writeS0Data(s0SmartmeterIndex, s0Data);
 
-            LOG_INFO("Parameter updated. Please reboot.");
+            LOG_INFO(F("Parameter updated. Please reboot."));
 
             data += F("Parameter updated. Please reboot.");
         }
     }
     else
     {
-        LOG_INFO("Parameter not updated.");
+        LOG_INFO(F("Parameter not updated."));
 
         data += F("Parameter not updated.");
     }
@@ -949,75 +1096,1090 @@ static void handleResetGetReq(EthernetClient& client, const HttpRequest& httpReq
 }
 
 /**
- * ISR of pin change interrupt 0.
+ * Handle the route for the /api/diagnostics/net, which responds with the
+ * network diagnostic counters in JSON format.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
  */
-ISR(PCINT0_vect)
+static void handleDiagNetReq(EthernetClient& client, const HttpRequest& httpRequest)
 {
-    static uint8_t  lastValue = 0xff;
-    uint8_t         value     = PINA;
-    uint8_t         index     = 0;
-    uint8_t         bitNo     = 0;
+    ArduinoHttpServer::StreamHttpReply  httpReply(client, "application/json");
+    String                              data;
+    const NetDiag::Counters&            counters    = NetDiag::getCounters();
+    DynamicJsonDocument                 jsonDoc(384);
+    JsonObject                          jsonData    = jsonDoc.createNestedObject("data");
+
+    jsonData["uptime"]          = millis();
+    jsonData["rxOverflows"]     = counters.rxOverflows;
+    jsonData["rxPendingMax"]    = counters.rxPendingMax;
+    jsonData["txErrors"]        = counters.txErrors;
+    jsonData["linkLosses"]      = counters.linkLosses;
+    jsonData["dhcpRenewals"]    = counters.dhcpRenewals;
+    jsonData["dhcpFailures"]    = counters.dhcpFailures;
+    jsonData["tcpAccepted"]     = counters.tcpAccepted;
+    jsonData["tcpReset"]        = counters.tcpReset;
+    jsonData["tcpTimedOut"]     = counters.tcpTimedOut;
+    jsonData["httpRequests"]    = counters.httpRequests;
+    jsonData["httpBadRequests"] = counters.httpBadRequests;
+    jsonData["lastRequest"]     = counters.lastRequest;
+    jsonData["bytesIn"]         = counters.bytesIn;
+    jsonData["bytesOut"]        = counters.bytesOut;
 
-    /* Which pin triggered? */
-    for(index = 0; index < CONFIG_S0_SMARTMETER_MAX_NUM; ++index)
-    {
-        if (true == gS0Smartmeters[index].isEnabled())
-        {
-            bitNo = gS0Smartmeters[index].getS0Pin().getPortBitNo();
+    jsonDoc["status"] = STATUS_ID_OK;
 
-            /* Falling edge? */
-            if ((0 != (lastValue & _BV(bitNo))) &&
-                (0 == (value & _BV(bitNo))))
-            {
-                gS0Smartmeters[index].internalISR();
-            }
-        }
-    }
+    (void)serializeJson(jsonDoc, data);
 
-    lastValue = value;
+    httpReply.send(data);
 
     return;
 }
 
 /**
- * Perform a reset.
+ * Handle the route for the /api/config, which responds with the whole
+ * configuration in JSON format. The response can be used as it is, to
+ * configure another device via PUT.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
  */
-static void reset(void)
+static void handleConfigGetReq(EthernetClient& client, const HttpRequest& httpRequest)
 {
-    /* Perform reset triggered by watchdog. */
-    wdt_enable(WDTO_30MS);
-    while(1)
+    ArduinoHttpServer::StreamHttpReply  httpReply(client, "application/json");
+    String                              data;
+    uint8_t                             index           = 0;
+    PersistentMemory::NetData           netData;
+    DynamicJsonDocument                 jsonDoc(CONFIG_JSON_DOC_SIZE);
+    JsonObject                          jsonData        = jsonDoc.createNestedObject("data");
+    JsonObject                          jsonNetData     = jsonData.createNestedObject("network");
+    JsonArray                           jsonS0DataArray = jsonData.createNestedArray("s0Interfaces");
+
+    PersistentMemory::readNetData(netData);
+
+    jsonNetData["isDhcpEnabled"]    = netData.isDhcpEnabled;
+    jsonNetData["ipAddress"]        = ipToStr(IPAddress(netData.ipAddress));
+    jsonNetData["subnetMask"]       = ipToStr(IPAddress(netData.subnetMask));
+    jsonNetData["gateway"]          = ipToStr(IPAddress(netData.gateway));
+    jsonNetData["dnsServer"]        = ipToStr(IPAddress(netData.dnsServer));
+    jsonNetData["syslogServer"]     = ipToStr(IPAddress(netData.syslogServer));
+    jsonNetData["syslogPort"]       = netData.syslogPort;
+
+    for(index = 0; index < CONFIG_S0_SMARTMETER_MAX_NUM; ++index)
     {
-        asm("nop");
-    };
-}
+        PersistentMemory::S0Data    s0Data;
+        JsonObject                  jsonS0Data  = jsonS0DataArray.createNestedObject();
+
+        PersistentMemory::readS0Data(index, s0Data);
+
+        /* Note, the name is copied into the document, because it is not a constant string. */
+        jsonS0Data["isEnabled"]     = s0Data.isEnabled;
+        jsonS0Data["name"]          = s0Data.name;
+        jsonS0Data["pinS0"]         = s0Data.pinS0;
+        jsonS0Data["pulsesPerKWH"]  = s0Data.pulsesPerKWH;
+    }
 
-/*
- * CAUTION! Older AVRs will have the watchdog timer disabled on a reset.
- * For these older AVRs, doing a soft reset by enabling the watchdog is easy,
- * as the watchdog will then be disabled after the reset. On newer AVRs, once
- * the watchdog is enabled, then it stays enabled, even after a reset!
- * For these newer AVRs a function needs to be added to the .init3 section
- * (i.e. during the startup code, before main()) to disable the watchdog early
- * enough so it does not continually reset the AVR.
-*/
+    jsonDoc["status"] = STATUS_ID_OK;
+
+    (void)serializeJson(jsonDoc, data);
+
+    httpReply.send(data);
 
-/* Disable the watchdog in the .init3 phase before main() is called. */
-void Watchdog_disableWatchdog(void) \
-__attribute__((naked)) \
-__attribute__((section(".init3")));
+    return;
+}
 
 /**
- * Disable watchdog before any watchdog interrupt can happen.
- * @see http://www.nongnu.org/avr-libc/user-manual/group__avr__watchdog.html
+ * Handle the route for the /api/config, which updates the whole configuration.
+ *
+ * The request body is the same JSON document, which is responded by GET.
+ * The network settings, the S0 interface array and every parameter are
+ * optional. Missing ones keep their current value. The S0 interfaces are
+ * assigned by their position in the array.
  *
- * Important note: Don't declare this function static, otherwise it will be
- * removed by the linker.
+ * The update is transactional: Only if all parameters are valid, the
+ * configuration is written at once to the persistent memory. It is used
+ * after the next reboot.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
  */
-void Watchdog_disableWatchdog(void)
+static void handleConfigPutReq(EthernetClient& client, const HttpRequest& httpRequest)
 {
-    MCUSR = 0;
-    wdt_disable();
+    ArduinoHttpServer::StreamHttpReply  httpReply(client, "application/json");
+    String                              data;
+    HttpBodyStream                      body(client, httpRequest);
+    DynamicJsonDocument                 jsonDoc(CONFIG_JSON_DOC_SIZE);
+    DeserializationError                error       = deserializeJson(jsonDoc, body);
+    StatusId                            statusId    = STATUS_ID_OK;
 
-    return;
+    if (DeserializationError::Ok != error)
+    {
+        LOG_ERROR(F("Invalid configuration document."));
+        LOG_ERROR(error.c_str());
+
+        statusId = STATUS_ID_EINPUT;
+    }
+    else
+    {
+        uint8_t                     index           = 0;
+        PersistentMemory::S0Data    s0DataList[CONFIG_S0_SMARTMETER_MAX_NUM];
+        PersistentMemory::NetData   netData;
+        JsonObjectConst             jsonData        = jsonDoc["data"];
+        JsonObjectConst             jsonNetData;
+        JsonArrayConst              jsonS0DataArray;
+
+        /* The configuration may be enveloped like in the GET response. */
+        if (true == jsonData.isNull())
+        {
+            jsonData = jsonDoc.as<JsonObjectConst>();
+        }
+
+        jsonNetData     = jsonData["network"];
+        jsonS0DataArray = jsonData["s0Interfaces"];
+
+        PersistentMemory::readNetData(netData);
+
+        for(index = 0; index < CONFIG_S0_SMARTMETER_MAX_NUM; ++index)
+        {
+            PersistentMemory::readS0Data(index, s0DataList[index]);
+        }
+
+        if (true == jsonData.isNull())
+        {
+            statusId = STATUS_ID_EINPUT;
+        }
+
+        if ((STATUS_ID_OK == statusId) &&
+            (false == jsonData["network"].isNull()))
+        {
+            if (false == json2NetData(jsonNetData, netData))
+            {
+                statusId = STATUS_ID_EINPUT;
+            }
+        }
+
+        if ((STATUS_ID_OK == statusId) &&
+            (false == jsonData["s0Interfaces"].isNull()))
+        {
+            if ((true == jsonS0DataArray.isNull()) ||
+                (CONFIG_S0_SMARTMETER_MAX_NUM < jsonS0DataArray.size()))
+            {
+                statusId = STATUS_ID_EINPUT;
+            }
+
+            for(index = 0; (index < jsonS0DataArray.size()) && (STATUS_ID_OK == statusId); ++index)
+            {
+                if (false == json2S0Data(jsonS0DataArray[index], s0DataList[index]))
+                {
+                    statusId = STATUS_ID_EINPUT;
+                }
+            }
+        }
+
+        if ((STATUS_ID_OK == statusId) &&
+            (true == isS0PinConflict(s0DataList, CONFIG_S0_SMARTMETER_MAX_NUM)))
+        {
+            statusId = STATUS_ID_EINPUT;
+        }
+
+        if (STATUS_ID_OK != statusId)
+        {
+            LOG_INFO(F("Configuration not updated, because it is invalid."));
+        }
+        else if (PersistentMemory::RET_OK != PersistentMemory::writeConfig(s0DataList, CONFIG_S0_SMARTMETER_MAX_NUM, netData))
+        {
+            LOG_ERROR(F("Failed to write configuration."));
+            statusId = STATUS_ID_EINTERNAL;
+        }
+        else
+        {
+            LOG_INFO(F("Configuration updated. Please reboot."));
+        }
+    }
+
+    jsonDoc.clear();
+    jsonDoc["status"] = statusId;
+
+    (void)serializeJson(jsonDoc, data);
+
+    httpReply.send(data);
+
+    return;
+}
+
+/**
+ * Handle the route for the /api/log?since=<seq>, which responds with the log
+ * records in JSON format, starting with the given sequence number. Use the
+ * "next" sequence number of the response in the next request, to get only
+ * the new records. If "first" is greater than the requested sequence
+ * number, records were lost in between.
+ *
+ * The response is written directly to the client, record by record,
+ * therefore no memory is allocated for it. Only the resource is copied
+ * by the HTTP request.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handleLogReq(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    String              resource    = httpRequest.getResource().toString();
+    const char*         sinceParam  = strstr(resource.c_str(), "since=");
+    uint32_t            seq         = Logging::getFirstSeq();
+    bool                isFirst     = true;
+    Logging::Record     record;
+
+    if (nullptr != sinceParam)
+    {
+        seq = strtoul(sinceParam + strlen("since="), nullptr, 10);
+    }
+
+    client.print(F("HTTP/1.1 200 OK\r\n"
+                   "Content-Type: application/json\r\n"
+                   "Connection: close\r\n"
+                   "\r\n"));
+
+    client.print(F("{\"data\":{\"first\":"));
+    client.print(Logging::getFirstSeq());
+    client.print(F(",\"next\":"));
+    client.print(Logging::getNextSeq());
+    client.print(F(",\"records\":["));
+
+    while(true == Logging::getRecord(seq, record))
+    {
+        if (false == isFirst)
+        {
+            client.print(F(","));
+        }
+
+        isFirst = false;
+
+        client.print(F("{\"seq\":"));
+        client.print(record.seq);
+        client.print(F(",\"timestamp\":"));
+        client.print(record.timestamp);
+        client.print(F(",\"type\":\""));
+        client.print(Logging::logTypeToStr(record.logType));
+        client.print(F("\""));
+
+#if LOGGING_TOKENIZED
+        client.print(F(",\"token\":"));
+        client.print(record.token);
+
+        if ('\0' != record.text[0])
+        {
+            client.print(F(",\"msg\":"));
+            sendJsonString(client, record.text, false);
+        }
+#else   /* not LOGGING_TOKENIZED */
+        client.print(F(",\"file\":"));
+        sendJsonString(client, reinterpret_cast<const char*>(record.fileNameP), true);
+        client.print(F(",\"line\":"));
+        client.print(record.line);
+        client.print(F(",\"msg\":"));
+
+        if (nullptr != record.msgP)
+        {
+            sendJsonString(client, reinterpret_cast<const char*>(record.msgP), true);
+        }
+        else
+        {
+            sendJsonString(client, record.text, false);
+        }
+#endif  /* not LOGGING_TOKENIZED */
+
+        if (true == record.hasValue)
+        {
+            client.print(F(",\"value\":"));
+            client.print(record.value);
+        }
+
+        client.print(F("}"));
+
+        seq = record.seq + 1U;
+    }
+
+    client.print(F("]},\"status\":"));
+    client.print(STATUS_ID_OK);
+    client.print(F("}"));
+
+    return;
+}
+
+#if PULSE_LOG_ENABLED
+
+/**
+ * Handle the route for the /api/pulses?since=<seq>, which responds with the
+ * pulse records in JSON format, starting with the given sequence number.
+ * It works like /api/log: use "next" as "since" in the next request. If
+ * "first" is greater than the requested sequence number, pulse records were
+ * lost in between.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handlePulsesReq(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    String              resource    = httpRequest.getResource().toString();
+    const char*         sinceParam  = strstr(resource.c_str(), "since=");
+    uint32_t            seq         = PulseLog::getFirstSeq();
+    bool                isFirst     = true;
+    PulseLog::Record    record;
+
+    if (nullptr != sinceParam)
+    {
+        seq = strtoul(sinceParam + strlen("since="), nullptr, 10);
+    }
+
+    client.print(F("HTTP/1.1 200 OK\r\n"
+                   "Content-Type: application/json\r\n"
+                   "Connection: close\r\n"
+                   "\r\n"));
+
+    client.print(F("{\"data\":{\"first\":"));
+    client.print(PulseLog::getFirstSeq());
+    client.print(F(",\"next\":"));
+    client.print(PulseLog::getNextSeq());
+    client.print(F(",\"now\":"));
+    client.print(millis());
+    client.print(F(",\"records\":["));
+
+    while(true == PulseLog::getRecord(seq, record))
+    {
+        if (false == isFirst)
+        {
+            client.print(F(","));
+        }
+
+        isFirst = false;
+
+        client.print(F("{\"seq\":"));
+        client.print(record.seq);
+        client.print(F(",\"timestamp\":"));
+        client.print(record.timestamp);
+        client.print(F(",\"ids\":"));
+        client.print(record.ids);
+        client.print(F("}"));
+
+        seq = record.seq + 1U;
+    }
+
+    client.print(F("]},\"status\":"));
+    client.print(STATUS_ID_OK);
+    client.print(F("}"));
+
+    return;
+}
+
+#endif  /* PULSE_LOG_ENABLED */
+
+#if CRIT_SECT_PROFILING_ENABLED
+
+/**
+ * Handle the route for the /api/diagnostics/irq, which responds with the
+ * interrupt-masked time per critical section and the max. interrupt latency
+ * in JSON format.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handleDiagIrqReq(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    ArduinoHttpServer::StreamHttpReply  httpReply(client, "application/json");
+    String                              data;
+    uint8_t                             site            = 0;
+    CritSect::LatencyStats              latencyStats;
+    DynamicJsonDocument                 jsonDoc(512);
+    JsonObject                          jsonData        = jsonDoc.createNestedObject("data");
+    JsonObject                          jsonLatency     = jsonData.createNestedObject("latency");
+    JsonArray                           jsonSections    = jsonData.createNestedArray("criticalSections");
+
+    CritSect::getLatencyStats(latencyStats);
+
+    jsonData["tickNs"]      = CritSect::TICK_NS;
+    jsonLatency["probes"]   = latencyStats.count;
+    jsonLatency["maxTicks"] = latencyStats.maxTicks;
+
+    for(site = 0; site < CritSect::SITE_MAX; ++site)
+    {
+        CritSect::Stats stats;
+        JsonObject      jsonSection = jsonSections.createNestedObject();
+
+        CritSect::getStats(static_cast<CritSect::Site>(site), stats);
+
+        jsonSection["site"]         = CritSect::siteToStr(static_cast<CritSect::Site>(site));
+        jsonSection["count"]        = stats.count;
+        jsonSection["maxTicks"]     = stats.maxTicks;
+        jsonSection["totalTicks"]   = stats.totalTicks;
+    }
+
+    jsonDoc["status"] = STATUS_ID_OK;
+
+    (void)serializeJson(jsonDoc, data);
+
+    httpReply.send(data);
+
+    return;
+}
+
+#endif  /* CRIT_SECT_PROFILING_ENABLED */
+
+#if BENCH_ENABLED
+
+/**
+ * Context of the benchmarks.
+ */
+struct BenchCtx
+{
+    S0Smartmeter        s0Smartmeter;   /**< S0 smartmeter, which is not connected to a pin */
+    unsigned long       timestamp;      /**< Synthetic pulse timestamp in ms */
+    String              resource;       /**< Resource of the router dispatch */
+    DynamicJsonDocument jsonDoc;        /**< JSON document of the serialization, allocated once */
+    String              data;           /**< Serialized JSON document */
+
+    /**
+     * Constructs the benchmark context.
+     */
+    BenchCtx() :
+        s0Smartmeter(),
+        timestamp(0U),
+        resource("/api/s0-interfaces"),
+        jsonDoc(CONFIG_S0_SMARTMETER_MAX_NUM * 256),
+        data()
+    {
+        /* The first pulse only initializes the timestamp. Handle it already
+         * here, that the benchmark measures the power calculation.
+         */
+        s0Smartmeter.internalISR(timestamp);
+    }
+};
+
+/**
+ * A single benchmark.
+ */
+struct BenchEntry
+{
+    const char* nameP;  /**< Benchmark name in program memory */
+    Bench::Func func;   /**< Benchmark function */
+};
+
+/** Benchmark name: S0Smartmeter::internalISR() */
+static const char       BENCH_NAME_INTERNAL_ISR[] PROGMEM       = "internalISR";
+
+/** Benchmark name: S0Smartmeter::getResult() */
+static const char       BENCH_NAME_GET_RESULT[] PROGMEM         = "getResult";
+
+/** Benchmark name: JSON serialization of one S0 interface */
+static const char       BENCH_NAME_JSON_ONE[] PROGMEM           = "jsonOneChannel";
+
+/** Benchmark name: JSON serialization of all S0 interfaces */
+static const char       BENCH_NAME_JSON_ALL[] PROGMEM           = "jsonAllChannels";
+
+/** Benchmark name: Web request router dispatch */
+static const char       BENCH_NAME_ROUTER_DISPATCH[] PROGMEM    = "routerDispatch";
+
+/** Benchmark name: Read S0 data from EEPROM */
+static const char       BENCH_NAME_EEPROM_READ[] PROGMEM        = "eepromReadS0Data";
+
+/** All benchmarks. */
+static const BenchEntry BENCH_ENTRIES[] PROGMEM                 =
+{
+    { BENCH_NAME_INTERNAL_ISR,      benchInternalISR        },
+    { BENCH_NAME_GET_RESULT,        benchGetResult          },
+    { BENCH_NAME_JSON_ONE,          benchJsonOneChannel     },
+    { BENCH_NAME_JSON_ALL,          benchJsonAllChannels    },
+    { BENCH_NAME_ROUTER_DISPATCH,   benchRouterDispatch     },
+    { BENCH_NAME_EEPROM_READ,       benchEepromReadS0Data   }
+};
+
+/** Number of runs per benchmark. */
+static const uint8_t    BENCH_ITERATIONS                        = 16U;
+
+/**
+ * Handle the route for the /api/diagnostics/bench, which runs the
+ * microbenchmarks on the target and responds with the CPU cycles in JSON
+ * format. The request blocks the main loop while the benchmarks run.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handleDiagBenchReq(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    ArduinoHttpServer::StreamHttpReply  httpReply(client, "application/json");
+    String                              data;
+    uint8_t                             idx             = 0;
+    BenchCtx                            ctx;
+    DynamicJsonDocument                 jsonDoc(512);
+    JsonObject                          jsonData        = jsonDoc.createNestedObject("data");
+    JsonArray                           jsonBenchmarks  = jsonData.createNestedArray("benchmarks");
+
+    jsonData["cpuHz"]       = F_CPU;
+    jsonData["resolution"]  = Bench::TICK_CYCLES;
+    jsonData["iterations"]  = BENCH_ITERATIONS;
+
+    for(idx = 0; idx < (sizeof(BENCH_ENTRIES) / sizeof(BENCH_ENTRIES[0])); ++idx)
+    {
+        const __FlashStringHelper*  nameP           = reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&BENCH_ENTRIES[idx].nameP));
+        Bench::Func                 func            = reinterpret_cast<Bench::Func>(pgm_read_ptr(&BENCH_ENTRIES[idx].func));
+        JsonObject                  jsonBenchmark   = jsonBenchmarks.createNestedObject();
+        Bench::Result               result;
+
+        Bench::run(func, &ctx, BENCH_ITERATIONS, result);
+
+        jsonBenchmark["name"]   = nameP;
+        jsonBenchmark["min"]    = result.minCycles;
+        jsonBenchmark["avg"]    = result.avgCycles;
+        jsonBenchmark["max"]    = result.maxCycles;
+    }
+
+    jsonDoc["status"] = STATUS_ID_OK;
+
+    (void)serializeJson(jsonDoc, data);
+
+    httpReply.send(data);
+
+    return;
+}
+
+/**
+ * Benchmark: Handle a S0 pulse with a synthetic timestamp.
+ * The interrupts are masked, like in the ISR.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchInternalISR(void* ctx)
+{
+    BenchCtx* benchCtx = static_cast<BenchCtx*>(ctx);
+
+    benchCtx->timestamp += 1000U;
+
+    HAL_ATOMIC_BLOCK()
+    {
+        benchCtx->s0Smartmeter.internalISR(benchCtx->timestamp);
+    }
+
+    return;
+}
+
+/**
+ * Benchmark: Get the result of a S0 smartmeter.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchGetResult(void* ctx)
+{
+    BenchCtx*       benchCtx            = static_cast<BenchCtx*>(ctx);
+    unsigned long   powerConsumption    = 0;
+    unsigned long   energyConsumption   = 0;
+    uint32_t        pulseCnt            = 0;
+
+    benchCtx->s0Smartmeter.getResult(powerConsumption, energyConsumption, pulseCnt);
+
+    return;
+}
+
+/**
+ * Benchmark: JSON serialization of one S0 interface, like /api/s0-interface/0.
+ * The JSON document and the string are allocated once by the context, so
+ * the heap allocation is not measured.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchJsonOneChannel(void* ctx)
+{
+    BenchCtx*               benchCtx    = static_cast<BenchCtx*>(ctx);
+    DynamicJsonDocument&    jsonDoc     = benchCtx->jsonDoc;
+    S0Snapshot              snapshot;
+    JsonObject              jsonData;
+
+    jsonDoc.clear();
+    benchCtx->data = "";
+    jsonData = jsonDoc.createNestedObject("data");
+
+    snapshot.capture(gS0Smartmeters, CONFIG_S0_SMARTMETER_MAX_NUM);
+    S0Model::toJson(gS0Smartmeters[0], snapshot.getChannel(0), jsonData);
+    jsonDoc["seq"]          = snapshot.getSeq();
+    jsonDoc["timestamp"]    = snapshot.getTimestamp();
+    jsonDoc["status"]       = STATUS_ID_OK;
+
+    (void)serializeJson(jsonDoc, benchCtx->data);
+
+    return;
+}
+
+/**
+ * Benchmark: JSON serialization of all S0 interfaces, like /api/s0-interfaces.
+ * The S0 interfaces are serialized, independent of whether they are enabled.
+ * The JSON document and the string are allocated once by the context, so
+ * the heap allocation is not measured.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchJsonAllChannels(void* ctx)
+{
+    BenchCtx*               benchCtx        = static_cast<BenchCtx*>(ctx);
+    DynamicJsonDocument&    jsonDoc         = benchCtx->jsonDoc;
+    uint8_t                 index           = 0;
+    S0Snapshot              snapshot;
+    JsonArray               jsonDataArray;
+
+    jsonDoc.clear();
+    benchCtx->data = "";
+    jsonDataArray = jsonDoc.createNestedArray("data");
+
+    snapshot.capture(gS0Smartmeters, CONFIG_S0_SMARTMETER_MAX_NUM);
+
+    for(index = 0; index < CONFIG_S0_SMARTMETER_MAX_NUM; ++index)
+    {
+        JsonObject jsonData = jsonDataArray.createNestedObject();
+
+        S0Model::toJson(gS0Smartmeters[index], snapshot.getChannel(index), jsonData);
+    }
+
+    jsonDoc["seq"]          = snapshot.getSeq();
+    jsonDoc["timestamp"]    = snapshot.getTimestamp();
+    jsonDoc["status"]       = STATUS_ID_OK;
+
+    (void)serializeJson(jsonDoc, benchCtx->data);
+
+    return;
+}
+
+/**
+ * Benchmark: Find the handler of a web request.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchRouterDispatch(void* ctx)
+{
+    BenchCtx* benchCtx = static_cast<BenchCtx*>(ctx);
+
+    (void)gWebReqRouter.findRoute(ArduinoHttpServer::Method::Get, benchCtx->resource);
+
+    return;
+}
+
+/**
+ * Benchmark: Read the S0 data of one S0 interface from the EEPROM.
+ *
+ * @param[in] ctx   Benchmark context
+ */
+static void benchEepromReadS0Data(void* ctx)
+{
+    PersistentMemory::S0Data s0Data;
+
+    (void)ctx;
+
+    PersistentMemory::readS0Data(0, s0Data);
+
+    return;
+}
+
+#endif  /* BENCH_ENABLED */
+
+#if ISR_TRACE_ENABLED
+
+/**
+ * Handle the route for the /api/diagnostics/trace, which freezes the ISR
+ * trace and responds with it in binary form. Use tools/isrtrace.py to
+ * render it.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handleDiagTraceReq(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    client.print(F("HTTP/1.1 200 OK\r\n"
+                   "Content-Type: application/octet-stream\r\n"
+                   "Connection: close\r\n"
+                   "\r\n"));
+
+    IsrTrace::dump(client);
+
+    return;
+}
+
+/**
+ * Handle the route for the /api/diagnostics/trace/<action>, which controls
+ * the ISR trace. The action "freeze" freezes the trace and "arm" clears it
+ * and starts recording again.
+ *
+ * @param[in] client        Ethernet client, used to send the response.
+ * @param[in] httpRequest   The http request itself.
+ */
+static void handleDiagTraceCtrlReq(EthernetClient& client, const HttpRequest& httpRequest)
+{
+    ArduinoHttpServer::StreamHttpReply  httpReply(client, "application/json");
+    String                              data;
+    String                              action      = httpRequest.getResource()[3];
+    DynamicJsonDocument                 jsonDoc(128);
+
+    if (0 != action.equals("freeze"))
+    {
+        IsrTrace::freeze();
+        jsonDoc["status"] = STATUS_ID_OK;
+    }
+    else if (0 != action.equals("arm"))
+    {
+        IsrTrace::arm();
+        jsonDoc["status"] = STATUS_ID_OK;
+    }
+    else
+    {
+        jsonDoc["status"] = STATUS_ID_EINPUT;
+    }
+
+    jsonDoc["data"]["state"] = IsrTrace::stateToStr(IsrTrace::getState());
+
+    (void)serializeJson(jsonDoc, data);
+
+    httpReply.send(data);
+
+    return;
+}
+
+#endif  /* ISR_TRACE_ENABLED */
+
+/**
+ * Send a string as JSON string, including the quotes. All characters, which
+ * have a special meaning in JSON, are escaped.
+ *
+ * @param[in] out       Output stream
+ * @param[in] str       String
+ * @param[in] isProgmem Whether the string is in program memory (true) or in RAM (false).
+ */
+static void sendJsonString(Print& out, const char* str, bool isProgmem)
+{
+    char data = (true == isProgmem) ? static_cast<char>(pgm_read_byte(str)) : *str;
+
+    out.print('"');
+
+    while('\0' != data)
+    {
+        if (('"' == data) || ('\\' == data))
+        {
+            out.print('\\');
+            out.print(data);
+        }
+        else if (0x20 > static_cast<uint8_t>(data))
+        {
+            /* Control characters are not shown. */
+            out.print(' ');
+        }
+        else
+        {
+            out.print(data);
+        }
+
+        ++str;
+        data = (true == isProgmem) ? static_cast<char>(pgm_read_byte(str)) : *str;
+    }
+
+    out.print('"');
+
+    return;
+}
+
+/**
+ * Check whether two enabled S0 interfaces use the same pin.
+ *
+ * @param[in] s0DataList    All S0 parameter blocks
+ * @param[in] numS0Data     Number of S0 parameter blocks
+ *
+ * @return If a pin is used more than once, it will return true otherwise false.
+ */
+static bool isS0PinConflict(const PersistentMemory::S0Data* s0DataList, uint8_t numS0Data)
+{
+    bool    isConflict  = false;
+    uint8_t index       = 0;
+    uint8_t other       = 0;
+
+    for(index = 0; (index < numS0Data) && (false == isConflict); ++index)
+    {
+        /* A disabled interface doesn't use its pin. */
+        if (true == s0DataList[index].isEnabled)
+        {
+            for(other = index + 1; (other < numS0Data) && (false == isConflict); ++other)
+            {
+                if ((true == s0DataList[other].isEnabled) &&
+                    (s0DataList[other].pinS0 == s0DataList[index].pinS0))
+                {
+                    isConflict = true;
+                }
+            }
+        }
+    }
+
+    return isConflict;
+}
+
+/**
+ * Take over the S0 interface parameters from a JSON object.
+ * Missing parameters are not changed.
+ *
+ * @param[in]       jsonS0Data  JSON object with the S0 interface parameters
+ * @param[inout]    s0Data      S0 parameter block
+ *
+ * @return If all given parameters are valid, it will return true otherwise false.
+ */
+static bool json2S0Data(JsonObjectConst jsonS0Data, PersistentMemory::S0Data& s0Data)
+{
+    bool                isValid         = (false == jsonS0Data.isNull());
+    JsonVariantConst    jsonIsEnabled   = jsonS0Data["isEnabled"];
+    JsonVariantConst    jsonName        = jsonS0Data["name"];
+    JsonVariantConst    jsonPinS0       = jsonS0Data["pinS0"];
+    JsonVariantConst    jsonPulses      = jsonS0Data["pulsesPerKWH"];
+
+    if ((true == isValid) &&
+        (false == jsonIsEnabled.isNull()))
+    {
+        if (false == jsonIsEnabled.is<bool>())
+        {
+            isValid = false;
+        }
+        else
+        {
+            s0Data.isEnabled = jsonIsEnabled.as<bool>();
+        }
+    }
+
+    if ((true == isValid) &&
+        (false == jsonName.isNull()))
+    {
+        const char* name = jsonName.as<const char*>();
+
+        /* A name which doesn't fit is rejected instead of truncated. */
+        if ((nullptr == name) ||
+            (sizeof(s0Data.name) <= strlen(name)))
+        {
+            isValid = false;
+        }
+        else
+        {
+            strcpy(s0Data.name, name);
+        }
+    }
+
+    if ((true == isValid) &&
+        (false == jsonPinS0.isNull()))
+    {
+        if ((false == jsonPinS0.is<uint8_t>()) ||
+            (S0Pin::mcPinRangeMin > jsonPinS0.as<uint8_t>()) ||
+            (S0Pin::mcPinRangeMax < jsonPinS0.as<uint8_t>()))
+        {
+            isValid = false;
+        }
+        else
+        {
+            s0Data.pinS0 = jsonPinS0.as<uint8_t>();
+        }
+    }
+
+    if ((true == isValid) &&
+        (false == jsonPulses.isNull()))
+    {
+        if ((false == jsonPulses.is<uint32_t>()) ||
+            (S0Smartmeter::PULSES_PER_KWH_RANGE_MIN > jsonPulses.as<uint32_t>()) ||
+            (S0Smartmeter::PULSES_PER_KWH_RANGE_MAX < jsonPulses.as<uint32_t>()))
+        {
+            isValid = false;
+        }
+        else
+        {
+            s0Data.pulsesPerKWH = jsonPulses.as<uint32_t>();
+        }
+    }
+
+    return isValid;
+}
+
+/**
+ * Take over the network parameters from a JSON object.
+ * Missing parameters are not changed.
+ *
+ * @param[in]       jsonNetData JSON object with the network parameters
+ * @param[inout]    netData     Network parameter block
+ *
+ * @return If all given parameters are valid, it will return true otherwise false.
+ */
+static bool json2NetData(JsonObjectConst jsonNetData, PersistentMemory::NetData& netData)
+{
+    bool                isValid         = (false == jsonNetData.isNull());
+    JsonVariantConst    jsonIsDhcp      = jsonNetData["isDhcpEnabled"];
+    JsonVariantConst    jsonSyslogPort  = jsonNetData["syslogPort"];
+
+    if ((true == isValid) &&
+        (false == jsonIsDhcp.isNull()))
+    {
+        if (false == jsonIsDhcp.is<bool>())
+        {
+            isValid = false;
+        }
+        else
+        {
+            netData.isDhcpEnabled = jsonIsDhcp.as<bool>();
+        }
+    }
+
+    if ((true == isValid) &&
+        ((false == json2Ip(jsonNetData["ipAddress"], netData.ipAddress)) ||
+         (false == json2Ip(jsonNetData["subnetMask"], netData.subnetMask)) ||
+         (false == json2Ip(jsonNetData["gateway"], netData.gateway)) ||
+         (false == json2Ip(jsonNetData["dnsServer"], netData.dnsServer)) ||
+         (false == json2Ip(jsonNetData["syslogServer"], netData.syslogServer))))
+    {
+        isValid = false;
+    }
+
+    if ((true == isValid) &&
+        (false == jsonSyslogPort.isNull()))
+    {
+        if ((false == jsonSyslogPort.is<uint16_t>()) ||
+            (0U == jsonSyslogPort.as<uint16_t>()))
+        {
+            isValid = false;
+        }
+        else
+        {
+            netData.syslogPort = jsonSyslogPort.as<uint16_t>();
+        }
+    }
+
+    /* A static configuration without IP address would make the device unreachable. */
+    if ((true == isValid) &&
+        (false == netData.isDhcpEnabled) &&
+        (0U == netData.ipAddress[0]) &&
+        (0U == netData.ipAddress[1]) &&
+        (0U == netData.ipAddress[2]) &&
+        (0U == netData.ipAddress[3]))
+    {
+        isValid = false;
+    }
+
+    return isValid;
+}
+
+/**
+ * Take over a IP address in user friendly form from JSON.
+ * A missing IP address is not changed.
+ *
+ * @param[in]   jsonIp  JSON value with the IP address, e.g. "192.168.0.2"
+ * @param[out]  ip      IP address in byte form (4 bytes)
+ *
+ * @return If the IP address is missing or valid, it will return true otherwise false.
+ */
+static bool json2Ip(JsonVariantConst jsonIp, uint8_t* ip)
+{
+    bool isValid = true;
+
+    if (false == jsonIp.isNull())
+    {
+        IPAddress   ipAddr;
+        const char* str     = jsonIp.as<const char*>();
+
+        if ((nullptr == str) ||
+            (false == ipAddr.fromString(str)))
+        {
+            isValid = false;
+        }
+        else
+        {
+            uint8_t idx = 0;
+
+            for(idx = 0; idx < 4; ++idx)
+            {
+                ip[idx] = ipAddr[idx];
+            }
+        }
+    }
+
+    return isValid;
+}
+
+/**
+ * Append a string to the HTML data. All characters, which have a special
+ * meaning in HTML, are escaped.
+ *
+ * @param[inout]    data    HTML data
+ * @param[in]       str     String, which to append
+ */
+static void appendHtmlEscaped(String& data, const char* str)
+{
+    while('\0' != *str)
+    {
+        switch(*str)
+        {
+        case '&':
+            data += F("&amp;");
+            break;
+
+        case '<':
+            data += F("&lt;");
+            break;
+
+        case '>':
+            data += F("&gt;");
+            break;
+
+        case '"':
+            data += F("&quot;");
+            break;
+
+        default:
+            data += *str;
+            break;
+        }
+
+        ++str;
+    }
+
+    return;
+}
+
+/**
+ * ISR of the S0 port pin changes.
+ */
+HAL_S0_PIN_CHANGE_ISR()
+{
+    static uint8_t  lastValue   = 0xff;
+    uint8_t         value       = Hal::readS0Port();
+    uint8_t         index       = 0;
+    uint8_t         bitNo       = 0;
+    uint8_t         counted     = 0;
+    uint8_t         countedIds  = 0;
+
+    /* Which pin triggered? */
+    for(index = 0; index < CONFIG_S0_SMARTMETER_MAX_NUM; ++index)
+    {
+        if (true == gS0Smartmeters[index].isEnabled())
+        {
+            bitNo = gS0Smartmeters[index].getS0Pin().getPortBitNo();
+
+            /* Falling edge? */
+            if ((0 != (lastValue & _BV(bitNo))) &&
+                (0 == (value & _BV(bitNo))))
+            {
+                gS0Smartmeters[index].internalISR();
+                counted     |= _BV(bitNo);
+                countedIds  |= _BV(index);
+            }
+        }
+    }
+
+    ISR_TRACE_RECORD(value, counted);
+    PULSE_LOG_RECORD(countedIds);
+
+    lastValue = value;
+
+    return;
+}
+
+/**
+ * Perform a reset.
+ */
+static void reset(void)
+{
+    /* Don't lose the last log records. */
+    LOG_FLUSH();
+
+    Hal::reset();
 }
@@ -0,0 +1,353 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Gateway test entry point
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The event sources are named pipes, which stand in for the GPIO character
+ * devices.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <Shard.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testPipeEvents(void);
+static void testFailedSource(void);
+
+/******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/** Arduino pin number of the S0 interfaces in test. */
+static const uint8_t    S0_PIN          = S0Pin::mcPinRangeMin;
+
+/** Pulses per kWh of the S0 interfaces in test. */
+static const uint32_t   PULSES_PER_KWH  = 1000U;
+
+/** Max. time in ms to wait for the shard thread. */
+static const uint32_t   WAIT_TIMEOUT    = 2000U;
+
+/** Directory of the named pipes of a test. */
+static char             gDir[]          = "/tmp/s0gatewayXXXXXX";
+
+/******************************************************************************
+ * External functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    if (nullptr == mkdtemp(gDir))
+    {
+        perror(gDir);
+        return EXIT_FAILURE;
+    }
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testPipeEvents);
+    RUN_TEST(testFailedSource);
+
+    (void)rmdir(gDir);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/**
+ * ISR of the S0 port pin changes. The gateway counts the events of the
+ * sources instead.
+ */
+HAL_S0_PIN_CHANGE_ISR()
+{
+}
+
+/******************************************************************************
+ * Local functions
+ *****************************************************************************/
+
+/**
+ * Initialize and enable the channel of a event source for test.
+ *
+ * @param[in] channel   Channel
+ * @param[in] id        S0 interface id
+ * @param[in] source    Path of the event source
+ * @param[in] line      Line offset at the event source
+ */
+static void initChannel(Channel& channel, uint8_t id, const std::string& source, uint32_t line)
+{
+    TEST_ASSERT_TRUE(channel.s0Smartmeter.init(id, "test", S0_PIN, PULSES_PER_KWH));
+    channel.s0Smartmeter.enable();
+    channel.source  = source;
+    channel.line    = line;
+}
+
+/**
+ * Get the path of a named pipe in the test directory.
+ *
+ * @param[in] name  File name
+ *
+ * @return Path
+ */
+static std::string getPath(const char* name)
+{
+    return std::string(gDir) + "/" + name;
+}
+
+/**
+ * Write a edge event to a named pipe, like the kernel does.
+ *
+ * @param[in] path  Path of the named pipe
+ * @param[in] line  Line offset
+ * @param[in] id    GPIO_V2_LINE_EVENT_FALLING_EDGE or GPIO_V2_LINE_EVENT_RISING_EDGE
+ * @param[in] seqNo Sequence number, starting with 1
+ */
+static void writeEvent(const std::string& path, uint32_t line, uint32_t id, uint32_t seqNo)
+{
+    struct gpio_v2_line_event   event;
+    struct timespec             now;
+    int                         fd      = ::open(path.c_str(), O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+
+    TEST_ASSERT_TRUE(0 <= fd);
+    TEST_ASSERT_EQUAL_INT(0, clock_gettime(CLOCK_MONOTONIC, &now));
+
+    memset(&event, 0, sizeof(event));
+    event.timestamp_ns  = static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+    event.id            = id;
+    event.offset        = line;
+    event.seqno         = seqNo;
+    event.line_seqno    = seqNo;
+
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(sizeof(event)), static_cast<int>(::write(fd, &event, sizeof(event))));
+    (void)::close(fd);
+}
+
+/**
+ * Wait until the shard applied a number of events.
+ *
+ * @param[in] shard     Shard
+ * @param[in] numEvents Number of events
+ *
+ * @return If the events were applied in time, it will return true otherwise false.
+ */
+static bool waitForEvents(Shard& shard, uint64_t numEvents)
+{
+    uint32_t elapsed = 0U;
+
+    while((numEvents > shard.getNumEvents()) && (WAIT_TIMEOUT > elapsed))
+    {
+        (void)usleep(1000U);
+        ++elapsed;
+    }
+
+    return (numEvents == shard.getNumEvents());
+}
+
+/**
+ * Wait until a file descriptor is closed.
+ *
+ * @param[in] fd    File descriptor
+ *
+ * @return If it was closed in time, it will return true otherwise false.
+ */
+static bool waitForClose(int fd)
+{
+    uint32_t elapsed = 0U;
+
+    while((0 <= fcntl(fd, F_GETFD)) && (WAIT_TIMEOUT > elapsed))
+    {
+        (void)usleep(1000U);
+        ++elapsed;
+    }
+
+    return (0 > fcntl(fd, F_GETFD));
+}
+
+/**
+ * Find the file descriptor of an open file of this process.
+ *
+ * @param[in] path  Path of the file
+ *
+ * @return File descriptor or -1 if not found
+ */
+static int findFd(const std::string& path)
+{
+    int             fd      = -1;
+    DIR*            dir     = opendir("/proc/self/fd");
+    struct dirent*  entry   = nullptr;
+
+    TEST_ASSERT_NOT_NULL(dir);
+
+    while((0 > fd) && (nullptr != (entry = readdir(dir))))
+    {
+        char    link[PATH_MAX];
+        ssize_t len = readlinkat(dirfd(dir), entry->d_name, link, sizeof(link) - 1U);
+
+        if (0 < len)
+        {
+            link[len] = '\0';
+
+            if (path == link)
+            {
+                fd = atoi(entry->d_name);
+            }
+        }
+    }
+
+    (void)closedir(dir);
+
+    return fd;
+}
+
+/**
+ * Test that the falling edges of a named pipe are applied to the channels
+ * of their lines and the rising edges are ignored.
+ */
+static void testPipeEvents(void)
+{
+    std::string path = getPath("events");
+    Channel     channels[2U];
+    {
+        Shard shard;
+
+        initChannel(channels[0], 0U, path, 0U);
+        initChannel(channels[1], 1U, path, 1U);
+        TEST_ASSERT_TRUE(shard.addSource({ &channels[0], &channels[1] }, 0U));
+
+        shard.start();
+
+        writeEvent(path, 0U, GPIO_V2_LINE_EVENT_FALLING_EDGE, 1U);
+        writeEvent(path, 0U, GPIO_V2_LINE_EVENT_RISING_EDGE, 2U);
+        writeEvent(path, 0U, GPIO_V2_LINE_EVENT_FALLING_EDGE, 3U);
+        writeEvent(path, 1U, GPIO_V2_LINE_EVENT_FALLING_EDGE, 4U);
+
+        TEST_ASSERT_TRUE(waitForEvents(shard, 3U));
+
+        shard.stop();
+
+        TEST_ASSERT_EQUAL_UINT32(2U, channels[0].s0Smartmeter.getPulseCnt());
+        TEST_ASSERT_EQUAL_UINT32(1U, channels[1].s0Smartmeter.getPulseCnt());
+        TEST_ASSERT_EQUAL_UINT64(0U, shard.getNumLost());
+    }
+
+    (void)unlink(path.c_str());
+}
+
+/**
+ * Test that a source, which fails, is closed and removed from the poll set,
+ * while the other sources of the shard are still read.
+ */
+static void testFailedSource(void)
+{
+    std::string pathFailed  = getPath("failed");
+    std::string pathOk      = getPath("ok");
+    Channel     channels[2U];
+    {
+        Shard   shard;
+        int     fd      = -1;
+        int     dirFd   = -1;
+
+        initChannel(channels[0], 0U, pathFailed, 0U);
+        initChannel(channels[1], 1U, pathOk, 0U);
+        TEST_ASSERT_TRUE(shard.addSource({ &channels[0] }, 0U));
+        TEST_ASSERT_TRUE(shard.addSource({ &channels[1] }, 0U));
+
+        shard.start();
+
+        /* Replace the named pipe by a directory, which is always readable,
+         * but every read fails.
+         */
+        fd = findFd(pathFailed);
+        TEST_ASSERT_TRUE(0 <= fd);
+        dirFd = ::open(gDir, O_RDONLY | O_CLOEXEC);
+        TEST_ASSERT_TRUE(0 <= dirFd);
+        TEST_ASSERT_EQUAL_INT(fd, dup2(dirFd, fd));
+        (void)::close(dirFd);
+
+        /* The shard closes the failed source. */
+        TEST_ASSERT_TRUE(waitForClose(fd));
+
+        writeEvent(pathOk, 0U, GPIO_V2_LINE_EVENT_FALLING_EDGE, 1U);
+        writeEvent(pathOk, 0U, GPIO_V2_LINE_EVENT_FALLING_EDGE, 2U);
+
+        TEST_ASSERT_TRUE(waitForEvents(shard, 2U));
+
+        shard.stop();
+
+        TEST_ASSERT_EQUAL_UINT32(0U, channels[0].s0Smartmeter.getPulseCnt());
+        TEST_ASSERT_EQUAL_UINT32(2U, channels[1].s0Smartmeter.getPulseCnt());
+    }
+
+    (void)unlink(pathFailed.c_str());
+    (void)unlink(pathOk.c_str());
+}
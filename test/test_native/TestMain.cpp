@@ -0,0 +1,1234 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Main test entry point
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <HalTest.h>
+#include <VirtualClock.h>
+#include <LoadProfile.h>
+#include <S0PulseGenerator.h>
+#include <Interleaver.h>
+#include <PulseTrace.h>
+#include <DeltaCursors.hpp>
+#include <S0Snapshot.hpp>
+#include <FormParser.h>
+#include <PSMemory.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Context of the interleaving tests of a S0 smartmeter.
+ */
+struct S0RaceCtx
+{
+    S0Smartmeter*   s0Smartmeter;   /**< S0 smartmeter in test */
+    unsigned long   lastPulse;      /**< Timestamp in ms of the last pulse before the run */
+    unsigned long   power[2];       /**< Power consumption results in W */
+    unsigned long   energy[2];      /**< Energy consumption results in Ws */
+    uint32_t        pulseCnt[3];    /**< Pulse counter results */
+};
+
+/**
+ * Context of the form parser tests. It keeps the last value and the number
+ * of calls per field.
+ */
+struct FormCtx
+{
+    char        name[16];       /**< Last value of the field "name" */
+    char        name2[16];      /**< Last value of the field "name2" */
+    uint8_t     nameCnt;        /**< Number of calls of the field "name" */
+    uint8_t     name2Cnt;       /**< Number of calls of the field "name2" */
+};
+
+/**
+ * Context of the interleaver self test.
+ */
+struct TornReadCtx
+{
+    volatile uint32_t   counter;    /**< Counter, which is incremented by the ISR */
+    uint32_t            value;      /**< Read counter value */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testVirtualClock(void);
+static void testConstantLoad(void);
+static void testStepLoad(void);
+static void testPowerDecrease(void);
+static void testRampLoad(void);
+static void testRippleLoad(void);
+static void testJitter(void);
+static void testGlitches(void);
+static void testSameMillisecond(void);
+static void testLongTerm(void);
+static void testMillisWrapAround(void);
+static void testInterleaverTornRead(void);
+static void testIsrVersusGetResult(void);
+static void testIsrVersusProcess(void);
+static void testPulseTrace(void);
+static void testDeltaCursors(void);
+static void testS0Snapshot(void);
+static void testFormDecoding(void);
+static void testFormInvalidPercent(void);
+static void testFormKeyPrefix(void);
+static void testFormTruncation(void);
+static void testFormEmpty(void);
+static void testWriteConfig(void);
+static void handleFormName(void* ctx, const char* value);
+static void handleFormName2(void* ctx, const char* value);
+
+/******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/** Arduino pin number of the S0 interface in test. */
+static const uint8_t    S0_PIN          = S0Pin::mcPinRangeMin;
+
+/** Pulses per kWh of the S0 interface in test. */
+static const uint32_t   PULSES_PER_KWH  = 1000U;
+
+/** 1 hour in s */
+static const uint32_t   HOUR            = 3600U;
+
+/**
+ * Number of pulses before a interleaving test run. The next pulse carries
+ * into the next byte of the pulse counter.
+ */
+static const uint32_t   RACE_PULSES     = 0xFFU;
+
+/** Pulse period in ms before a interleaving test run, which means 1000 W. */
+static const uint32_t   RACE_PERIOD     = 3600U;
+
+/** Form key "name" */
+static const char       FORM_KEY_NAME[] PROGMEM     = "name";
+
+/** Form key "name2", which starts with another key */
+static const char       FORM_KEY_NAME2[] PROGMEM    = "name2";
+
+/** Form fields of the form parser tests */
+static const FormParser::Field  FORM_FIELDS[] PROGMEM =
+{
+    { FORM_KEY_NAME,    handleFormName  },
+    { FORM_KEY_NAME2,   handleFormName2 }
+};
+
+/******************************************************************************
+ * External functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testVirtualClock);
+    RUN_TEST(testConstantLoad);
+    RUN_TEST(testStepLoad);
+    RUN_TEST(testPowerDecrease);
+    RUN_TEST(testRampLoad);
+    RUN_TEST(testRippleLoad);
+    RUN_TEST(testJitter);
+    RUN_TEST(testGlitches);
+    RUN_TEST(testSameMillisecond);
+    RUN_TEST(testLongTerm);
+    RUN_TEST(testMillisWrapAround);
+    RUN_TEST(testInterleaverTornRead);
+    RUN_TEST(testIsrVersusGetResult);
+    RUN_TEST(testIsrVersusProcess);
+    RUN_TEST(testPulseTrace);
+    RUN_TEST(testDeltaCursors);
+    RUN_TEST(testS0Snapshot);
+    RUN_TEST(testFormDecoding);
+    RUN_TEST(testFormInvalidPercent);
+    RUN_TEST(testFormKeyPrefix);
+    RUN_TEST(testFormTruncation);
+    RUN_TEST(testFormEmpty);
+    RUN_TEST(testWriteConfig);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    VirtualClock::reset();
+    HalTest::reset();
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local functions
+ *****************************************************************************/
+
+/**
+ * Initialize and enable a S0 smartmeter for test.
+ *
+ * @param[in] s0Smartmeter  S0 smartmeter
+ */
+static void initS0Smartmeter(S0Smartmeter& s0Smartmeter)
+{
+    TEST_ASSERT_TRUE(s0Smartmeter.init(0U, "test", S0_PIN, PULSES_PER_KWH));
+    s0Smartmeter.enable();
+}
+
+/**
+ * Test the virtual clock, which drives millis() and micros().
+ */
+static void testVirtualClock(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(0U, millis());
+    TEST_ASSERT_EQUAL_UINT32(0U, micros());
+
+    VirtualClock::advanceMillis(1500U);
+    TEST_ASSERT_EQUAL_UINT32(1500U, millis());
+    TEST_ASSERT_EQUAL_UINT32(1500000U, micros());
+
+    VirtualClock::advanceMicros(999U);
+    TEST_ASSERT_EQUAL_UINT32(1500U, millis());
+    TEST_ASSERT_EQUAL_UINT32(1500999U, micros());
+
+    /* Like on the target, millis() wraps around after 2^32 ms. */
+    VirtualClock::set(0x100000000ULL * 1000ULL + 5000ULL);
+    TEST_ASSERT_EQUAL_UINT32(5U, millis());
+}
+
+/**
+ * Test the power and energy of a constant load.
+ */
+static void testConstantLoad(void)
+{
+    S0Smartmeter        s0Smartmeter;
+    ConstantLoad        load(1000.0);
+    unsigned long       power   = 0UL;
+    unsigned long       energy  = 0UL;
+    uint32_t            pulseCnt = 0U;
+
+    initS0Smartmeter(s0Smartmeter);
+
+    S0PulseGenerator    generator(s0Smartmeter, load);
+
+    generator.runSeconds(HOUR + 1U);
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+
+    TEST_ASSERT_EQUAL_UINT32(1000U, generator.getPulseCnt());
+    TEST_ASSERT_EQUAL_UINT32(1000U, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(1000U, power);
+    TEST_ASSERT_EQUAL_UINT32(3600000U, energy);
+}
+
+/**
+ * Test that the power follows a step of the load.
+ */
+static void testStepLoad(void)
+{
+    S0Smartmeter        s0Smartmeter;
+    StepLoad            load(2000.0, 500.0, 600.0);
+    unsigned long       power   = 0UL;
+    unsigned long       energy  = 0UL;
+    uint32_t            pulseCnt = 0U;
+
+    initS0Smartmeter(s0Smartmeter);
+
+    S0PulseGenerator    generator(s0Smartmeter, load);
+
+    generator.runSeconds(599U);
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(2000U, power);
+
+    generator.runSeconds(601U);
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(500U, power);
+    TEST_ASSERT_UINT32_WITHIN(1U, 416U, pulseCnt);
+}
+
+/**
+ * Test that the power decreases without pulses, after the load is switched off.
+ */
+static void testPowerDecrease(void)
+{
+    S0Smartmeter        s0Smartmeter;
+    StepLoad            load(2000.0, 0.0, 60.0);
+    unsigned long       power   = 0UL;
+    unsigned long       energy  = 0UL;
+    uint32_t            pulseCnt = 0U;
+
+    initS0Smartmeter(s0Smartmeter);
+
+    S0PulseGenerator    generator(s0Smartmeter, load);
+
+    generator.runSeconds(60U);
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(2000U, power);
+
+    /* The power is halved every time, the doubled pulse period elapsed. */
+    generator.runSeconds(600U);
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_LESS_THAN_UINT32(2000U / 64U, power);
+
+    generator.runSeconds(24U * HOUR);
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(0U, power);
+    TEST_ASSERT_EQUAL_UINT32(generator.getPulseCnt(), pulseCnt);
+}
+
+/**
+ * Test that the power follows a ramp of the load.
+ */
+static void testRampLoad(void)
+{
+    S0Smartmeter        s0Smartmeter;
+    RampLoad            load(100.0, 3000.0, 60.0, 600.0);
+    unsigned long       power   = 0UL;
+    unsigned long       energy  = 0UL;
+    uint32_t            pulseCnt = 0U;
+
+    initS0Smartmeter(s0Smartmeter);
+
+    S0PulseGenerator    generator(s0Smartmeter, load);
+
+    generator.runSeconds(900U);
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+
+    TEST_ASSERT_UINT32_WITHIN(30U, 3000U, power);
+    TEST_ASSERT_UINT32_WITHIN(3600U, static_cast<uint32_t>(load.getEnergy(900.0)), energy);
+}
+
+/**
+ * Test that the energy of a rippled load is counted completely.
+ */
+static void testRippleLoad(void)
+{
+    S0Smartmeter        s0Smartmeter;
+    RippleLoad          load(1000.0, 500.0, 60.0);
+    unsigned long       power   = 0UL;
+    unsigned long       energy  = 0UL;
+    uint32_t            pulseCnt = 0U;
+
+    initS0Smartmeter(s0Smartmeter);
+
+    S0PulseGenerator    generator(s0Smartmeter, load);
+
+    generator.runSeconds(HOUR + 1U);
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+
+    TEST_ASSERT_UINT32_WITHIN(1U, 1000U, pulseCnt);
+    TEST_ASSERT_UINT32_WITHIN(500U, 1000U, power);
+}
+
+/**
+ * Test that the jitter is reproducible with the same seed and doesn't lose pulses.
+ */
+static void testJitter(void)
+{
+    ConstantLoad        load(1000.0);
+    unsigned long       power[2]    = { 0UL, 0UL };
+    unsigned long       energy      = 0UL;
+    uint32_t            pulseCnt[2] = { 0U, 0U };
+    uint8_t             idx         = 0U;
+
+    for(idx = 0U; idx < 2U; ++idx)
+    {
+        S0Smartmeter    s0Smartmeter;
+
+        VirtualClock::reset();
+        initS0Smartmeter(s0Smartmeter);
+
+        S0PulseGenerator generator(s0Smartmeter, load);
+
+        generator.setSeed(42U);
+        generator.setJitter(50000U);
+        generator.runSeconds(HOUR + 1U);
+        s0Smartmeter.getResult(power[idx], energy, pulseCnt[idx]);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1000U, pulseCnt[0]);
+    TEST_ASSERT_EQUAL_UINT32(pulseCnt[0], pulseCnt[1]);
+    TEST_ASSERT_EQUAL_UINT32(power[0], power[1]);
+    TEST_ASSERT_UINT32_WITHIN(50U, 1000U, power[0]);
+}
+
+/**
+ * Test that glitches are counted as additional pulses.
+ */
+static void testGlitches(void)
+{
+    S0Smartmeter        s0Smartmeter;
+    ConstantLoad        load(1000.0);
+    unsigned long       power   = 0UL;
+    unsigned long       energy  = 0UL;
+    uint32_t            pulseCnt = 0U;
+
+    initS0Smartmeter(s0Smartmeter);
+
+    S0PulseGenerator    generator(s0Smartmeter, load);
+
+    generator.setGlitches(100U, 5000U);
+    generator.runSeconds(HOUR + 1U);
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+
+    TEST_ASSERT_EQUAL_UINT32(1000U, generator.getPulseCnt());
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, generator.getGlitchCnt());
+    TEST_ASSERT_EQUAL_UINT32(generator.getPulseCnt() + generator.getGlitchCnt(), pulseCnt);
+}
+
+/**
+ * Test that a second pulse within the same ms is counted, but doesn't change
+ * the power consumption, because its interval is zero.
+ */
+static void testSameMillisecond(void)
+{
+    S0Smartmeter    s0Smartmeter;
+    unsigned long   power       = 0UL;
+    unsigned long   energy      = 0UL;
+    uint32_t        pulseCnt    = 0U;
+
+    initS0Smartmeter(s0Smartmeter);
+
+    /* 1 kW is one pulse every 3.6 s. */
+    VirtualClock::set(1000ULL * 1000ULL);
+    s0Smartmeter.internalISR();
+    VirtualClock::advanceMillis(3600U);
+    s0Smartmeter.internalISR();
+
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(2U, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(1000U, power);
+
+    /* A bouncing signal causes a second pulse in the same ms. */
+    s0Smartmeter.internalISR();
+
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(3U, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(1000U, power);
+
+    /* The next pulse is measured from the same ms. */
+    VirtualClock::advanceMillis(1800U);
+    s0Smartmeter.internalISR();
+
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(4U, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(2000U, power);
+}
+
+/**
+ * Test the metering over several days.
+ */
+static void testLongTerm(void)
+{
+    S0Smartmeter        s0Smartmeter;
+    ConstantLoad        load(500.0);
+    unsigned long       power   = 0UL;
+    unsigned long       energy  = 0UL;
+    uint32_t            pulseCnt = 0U;
+
+    initS0Smartmeter(s0Smartmeter);
+
+    S0PulseGenerator    generator(s0Smartmeter, load);
+
+    generator.setProcessPeriod(100000U);
+    generator.runSeconds(7U * 24U * HOUR + 1U);
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+
+    TEST_ASSERT_EQUAL_UINT32(84000U, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(500U, power);
+    TEST_ASSERT_EQUAL_UINT32(84000U * 3600U, energy);
+}
+
+/**
+ * Set up a S0 smartmeter for a interleaving test run. It counted RACE_PULSES
+ * pulses with a power of 1000 W.
+ *
+ * @param[in] ctx   S0RaceCtx
+ */
+static void setupS0Race(void* ctx)
+{
+    S0RaceCtx*  raceCtx = static_cast<S0RaceCtx*>(ctx);
+    uint32_t    idx     = 0U;
+
+    delete raceCtx->s0Smartmeter;
+    raceCtx->s0Smartmeter = new S0Smartmeter();
+
+    (void)raceCtx->s0Smartmeter->init(0U, "race", S0_PIN, PULSES_PER_KWH);
+    raceCtx->s0Smartmeter->enable();
+
+    for(idx = 1U; idx <= RACE_PULSES; ++idx)
+    {
+        raceCtx->s0Smartmeter->internalISR(idx * RACE_PERIOD);
+    }
+
+    raceCtx->lastPulse = RACE_PULSES * RACE_PERIOD;
+
+    return;
+}
+
+/**
+ * Interrupt service routine of the interleaving tests: a pulse at the current time.
+ *
+ * @param[in] ctx   S0RaceCtx
+ */
+static void isrS0Race(void* ctx)
+{
+    static_cast<S0RaceCtx*>(ctx)->s0Smartmeter->internalISR(millis());
+}
+
+/**
+ * Read the result twice, like two web requests.
+ *
+ * @param[in] ctx   S0RaceCtx
+ */
+static void accessGetResult(void* ctx)
+{
+    S0RaceCtx* raceCtx = static_cast<S0RaceCtx*>(ctx);
+
+    raceCtx->pulseCnt[2] = raceCtx->s0Smartmeter->getPulseCnt();
+    raceCtx->s0Smartmeter->getResult(raceCtx->power[0], raceCtx->energy[0], raceCtx->pulseCnt[0]);
+    raceCtx->s0Smartmeter->getResult(raceCtx->power[1], raceCtx->energy[1], raceCtx->pulseCnt[1]);
+}
+
+/**
+ * Check the results: every result is consistent, either before or after the
+ * pulse, and the pulse counter is monotonic.
+ *
+ * @param[in] ctx   S0RaceCtx
+ *
+ * @return If all invariants hold, it will return true otherwise false.
+ */
+static bool checkGetResult(void* ctx)
+{
+    S0RaceCtx*  raceCtx     = static_cast<S0RaceCtx*>(ctx);
+    bool        isValid     = true;
+    uint8_t     idx         = 0U;
+    uint32_t    expectedCnt = RACE_PULSES;
+
+    if (Interleaver::NO_INTERRUPT != Interleaver::getInterruptPoint())
+    {
+        ++expectedCnt;
+    }
+
+    for(idx = 0U; idx < 2U; ++idx)
+    {
+        uint32_t pulseCnt = raceCtx->pulseCnt[idx];
+
+        if ((RACE_PULSES == pulseCnt) &&
+            (1000U == raceCtx->power[idx]))
+        {
+            /* Before the pulse */
+        }
+        else if (((RACE_PULSES + 1U) == pulseCnt) &&
+                 (2000U == raceCtx->power[idx]))
+        {
+            /* After the pulse */
+        }
+        else
+        {
+            isValid = false;
+        }
+
+        if ((pulseCnt * 3600U) != raceCtx->energy[idx])
+        {
+            isValid = false;
+        }
+    }
+
+    if ((RACE_PULSES != raceCtx->pulseCnt[2]) &&
+        ((RACE_PULSES + 1U) != raceCtx->pulseCnt[2]))
+    {
+        isValid = false;
+    }
+
+    /* The pulse counter never decreases and every pulse is counted once. */
+    if ((raceCtx->pulseCnt[2] > raceCtx->pulseCnt[0]) ||
+        (raceCtx->pulseCnt[0] > raceCtx->pulseCnt[1]) ||
+        (expectedCnt != raceCtx->s0Smartmeter->getPulseCnt()))
+    {
+        isValid = false;
+    }
+
+    return isValid;
+}
+
+/**
+ * Decrease the power consumption, like the main loop does.
+ *
+ * @param[in] ctx   S0RaceCtx
+ */
+static void accessProcess(void* ctx)
+{
+    S0RaceCtx* raceCtx = static_cast<S0RaceCtx*>(ctx);
+
+    /* The power is decreased after the doubled pulse period, the pulse after
+     * 2.5 pulse periods leads to 400 W. In both orders the power is 400 W
+     * afterwards, but a lost update would leave 500 W.
+     */
+    VirtualClock::set((raceCtx->lastPulse + (5U * RACE_PERIOD) / 2U) * 1000ULL);
+
+    raceCtx->s0Smartmeter->process();
+    raceCtx->s0Smartmeter->getResult(raceCtx->power[0], raceCtx->energy[0], raceCtx->pulseCnt[0]);
+}
+
+/**
+ * Check the power after process(): the result is consistent, no update is
+ * lost and the next decrease happens not before the doubled pulse period.
+ *
+ * @param[in] ctx   S0RaceCtx
+ *
+ * @return If all invariants hold, it will return true otherwise false.
+ */
+static bool checkProcess(void* ctx)
+{
+    S0RaceCtx*      raceCtx     = static_cast<S0RaceCtx*>(ctx);
+    S0Smartmeter*   s0Smartmeter = raceCtx->s0Smartmeter;
+    unsigned long   pulse       = raceCtx->lastPulse + (5U * RACE_PERIOD) / 2U;
+    unsigned long   power       = 0UL;
+    unsigned long   energy      = 0UL;
+    uint32_t        pulseCnt    = 0U;
+    bool            isValid     = true;
+
+    /* The result is consistent, either before or after the pulse. */
+    if (((500U != raceCtx->power[0]) || (RACE_PULSES != raceCtx->pulseCnt[0])) &&
+        ((400U != raceCtx->power[0]) || ((RACE_PULSES + 1U) != raceCtx->pulseCnt[0])))
+    {
+        isValid = false;
+    }
+
+    if (Interleaver::NO_INTERRUPT == Interleaver::getInterruptPoint())
+    {
+        if (500U != raceCtx->power[0])
+        {
+            isValid = false;
+        }
+    }
+    else
+    {
+        /* No update is lost and the pulse is counted once. */
+        s0Smartmeter->getResult(power, energy, pulseCnt);
+
+        if ((400U != power) ||
+            ((RACE_PULSES + 1U) != pulseCnt))
+        {
+            isValid = false;
+        }
+
+        VirtualClock::set((pulse + 5U * RACE_PERIOD - 1U) * 1000ULL);
+        s0Smartmeter->process();
+        s0Smartmeter->getResult(power, energy, pulseCnt);
+
+        if (400U != power)
+        {
+            isValid = false;
+        }
+
+        VirtualClock::advanceMillis(1U);
+        s0Smartmeter->process();
+        s0Smartmeter->getResult(power, energy, pulseCnt);
+
+        if (200U != power)
+        {
+            isValid = false;
+        }
+    }
+
+    return isValid;
+}
+
+/**
+ * Set up the interleaver self test.
+ *
+ * @param[in] ctx   TornReadCtx
+ */
+static void setupTornRead(void* ctx)
+{
+    TornReadCtx* tornCtx = static_cast<TornReadCtx*>(ctx);
+
+    tornCtx->counter    = 0xFFU;
+    tornCtx->value      = 0U;
+}
+
+/**
+ * Read the counter without masking the interrupts.
+ *
+ * @param[in] ctx   TornReadCtx
+ */
+static void accessTornRead(void* ctx)
+{
+    TornReadCtx* tornCtx = static_cast<TornReadCtx*>(ctx);
+
+    tornCtx->value = HAL_SHARED_LOAD(tornCtx->counter);
+}
+
+/**
+ * Increment the counter.
+ *
+ * @param[in] ctx   TornReadCtx
+ */
+static void isrTornRead(void* ctx)
+{
+    ++static_cast<TornReadCtx*>(ctx)->counter;
+}
+
+/**
+ * Check that the read counter value is either the one before or after the increment.
+ *
+ * @param[in] ctx   TornReadCtx
+ *
+ * @return If the value is valid, it will return true otherwise false.
+ */
+static bool checkTornRead(void* ctx)
+{
+    TornReadCtx* tornCtx = static_cast<TornReadCtx*>(ctx);
+
+    return (0xFFU == tornCtx->value) || (0x100U == tornCtx->value);
+}
+
+/**
+ * Test the power calculation and its decrease, while millis() wraps around
+ * after 2^32 ms, like on the target.
+ */
+static void testMillisWrapAround(void)
+{
+    S0Smartmeter    s0Smartmeter;
+    unsigned long   power       = 0UL;
+    unsigned long   energy      = 0UL;
+    uint32_t        pulseCnt    = 0U;
+
+    initS0Smartmeter(s0Smartmeter);
+
+    /* 1 kW is one pulse every 3.6 s, the wrap around is between two pulses. */
+    VirtualClock::set((0x100000000ULL - 1800ULL) * 1000ULL);
+    s0Smartmeter.internalISR();
+
+    VirtualClock::advanceMillis(3600U);
+    TEST_ASSERT_EQUAL_UINT32(1800U, millis());
+    s0Smartmeter.internalISR();
+
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(2U, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(1000U, power);
+
+    /* The power is kept until twice the last pulse period is over. */
+    VirtualClock::set((0x100000000ULL - 1800ULL + 3600ULL + 7000ULL) * 1000ULL);
+    s0Smartmeter.process();
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(1000U, power);
+
+    VirtualClock::advanceMillis(200U);
+    s0Smartmeter.process();
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(500U, power);
+
+    /* The next wrap around is 100 ms after a pulse. */
+    VirtualClock::set((0x200000000ULL - 100ULL) * 1000ULL);
+    s0Smartmeter.internalISR();
+    VirtualClock::advanceMillis(3600U);
+    s0Smartmeter.internalISR();
+
+    s0Smartmeter.getResult(power, energy, pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(1000U, power);
+}
+
+/**
+ * Test that the interleaving explorer finds a torn read of a unprotected
+ * multi-byte variable.
+ */
+static void testInterleaverTornRead(void)
+{
+    const Interleaver::Scenario scenario    = { setupTornRead, accessTornRead, isrTornRead, checkTornRead };
+    TornReadCtx                 ctx;
+    Interleaver::Result         result      = Interleaver::explore(scenario, &ctx);
+
+    TEST_ASSERT_EQUAL_UINT32(sizeof(uint32_t), result.yieldPoints);
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, result.failures);
+
+    /* The interrupt after the low byte leads to 0x1FF. */
+    TEST_ASSERT_EQUAL_UINT32(1U, result.firstFailure);
+}
+
+/**
+ * Test getPulseCnt() and getResult() with a pulse at every yield point.
+ */
+static void testIsrVersusGetResult(void)
+{
+    const Interleaver::Scenario scenario    = { setupS0Race, accessGetResult, isrS0Race, checkGetResult };
+    S0RaceCtx                   ctx;
+    Interleaver::Result         result;
+
+    ctx.s0Smartmeter = nullptr;
+    VirtualClock::set((RACE_PULSES * RACE_PERIOD + RACE_PERIOD / 2U) * 1000ULL);
+
+    result = Interleaver::explore(scenario, &ctx);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, result.yieldPoints);
+    TEST_ASSERT_EQUAL_UINT32(Interleaver::NO_INTERRUPT, result.firstFailure);
+    TEST_ASSERT_EQUAL_UINT32(0U, result.failures);
+
+    delete ctx.s0Smartmeter;
+}
+
+/**
+ * Test process() with a pulse at every yield point.
+ */
+static void testIsrVersusProcess(void)
+{
+    const Interleaver::Scenario scenario    = { setupS0Race, accessProcess, isrS0Race, checkProcess };
+    S0RaceCtx                   ctx;
+    Interleaver::Result         result;
+
+    ctx.s0Smartmeter = nullptr;
+
+    result = Interleaver::explore(scenario, &ctx);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, result.yieldPoints);
+    TEST_ASSERT_EQUAL_UINT32(Interleaver::NO_INTERRUPT, result.firstFailure);
+    TEST_ASSERT_EQUAL_UINT32(0U, result.failures);
+
+    delete ctx.s0Smartmeter;
+}
+
+/**
+ * Test that a pulse trace is read back like it was written and that a
+ * truncated or invalid trace is detected.
+ */
+static void testPulseTrace(void)
+{
+    const PulseTrace::Record    records[]   =
+    {
+        { 0U,           0U                      },
+        { 0U,           1U                      },
+        { 3600U,        0U                      },
+        { 3600U,        1U                      },
+        { 90000U,       PulseTrace::CODE_GAP    },
+        { 4294967396U,  1U                      }
+    };
+    const uint8_t               numRecords  = sizeof(records) / sizeof(records[0]);
+    PulseTrace::Header          header;
+    PulseTrace::Writer          writer;
+    PulseTrace::Record          record;
+    uint8_t                     idx         = 0U;
+
+    header.numChannels      = 2U;
+    header.pulsesPerKWh[0]  = 1000U;
+    header.pulsesPerKWh[1]  = 6000U;
+
+    TEST_ASSERT_TRUE(writer.begin(header));
+
+    for(idx = 0U; idx < numRecords; ++idx)
+    {
+        TEST_ASSERT_TRUE(writer.append(records[idx]));
+    }
+
+    /* Not in chronological order and unknown channel */
+    record.time = 0U;
+    record.code = 0U;
+    TEST_ASSERT_FALSE(writer.append(record));
+    record.time = records[numRecords - 1U].time;
+    record.code = 2U;
+    TEST_ASSERT_FALSE(writer.append(record));
+
+    {
+        const std::vector<uint8_t>& data    = writer.getData();
+        PulseTrace::Reader          reader(data.data(), data.size());
+        PulseTrace::Header          readHeader;
+
+        TEST_ASSERT_TRUE(reader.readHeader(readHeader));
+        TEST_ASSERT_EQUAL_UINT8(2U, readHeader.numChannels);
+        TEST_ASSERT_EQUAL_UINT16(1000U, readHeader.pulsesPerKWh[0]);
+        TEST_ASSERT_EQUAL_UINT16(6000U, readHeader.pulsesPerKWh[1]);
+
+        for(idx = 0U; idx < numRecords; ++idx)
+        {
+            TEST_ASSERT_TRUE(reader.next(record));
+            TEST_ASSERT_TRUE(records[idx].time == record.time);
+            TEST_ASSERT_EQUAL_UINT8(records[idx].code, record.code);
+        }
+
+        TEST_ASSERT_FALSE(reader.next(record));
+        TEST_ASSERT_FALSE(reader.isError());
+    }
+
+    {
+        const std::vector<uint8_t>& data    = writer.getData();
+        PulseTrace::Reader          reader(data.data(), data.size() - 1U);
+        PulseTrace::Header          readHeader;
+
+        /* The last varint is truncated. */
+        TEST_ASSERT_TRUE(reader.readHeader(readHeader));
+
+        for(idx = 0U; idx < (numRecords - 1U); ++idx)
+        {
+            TEST_ASSERT_TRUE(reader.next(record));
+        }
+
+        TEST_ASSERT_FALSE(reader.next(record));
+        TEST_ASSERT_TRUE(reader.isError());
+    }
+
+    {
+        const uint8_t       data[]      = { 'S', '0', 'T', 'R', 1U, 1U, 0xE8U, 0x03U };
+        PulseTrace::Reader  reader(data, sizeof(data));
+        PulseTrace::Header  readHeader;
+
+        TEST_ASSERT_FALSE(reader.readHeader(readHeader));
+        TEST_ASSERT_TRUE(reader.isError());
+    }
+}
+
+/**
+ * Test that every cursor provides the pulses since its own last read, also
+ * if the counters wrap around, and that a invalid cursor is rejected.
+ */
+static void testDeltaCursors(void)
+{
+    DeltaCursors<2U, 2U>    cursors;
+    uint32_t                pulseCnts[2U]   = { 10U, 3U };
+    uint32_t                deltas[2U]      = { 0U, 0U };
+    uint32_t                duration        = 0U;
+
+    TEST_ASSERT_EQUAL_UINT8(2U, cursors.getNumCursors());
+
+    /* The first read provides the pulses since the start. */
+    TEST_ASSERT_TRUE(cursors.read(0U, pulseCnts, 1000U, deltas, duration));
+    TEST_ASSERT_EQUAL_UINT32(10U, deltas[0]);
+    TEST_ASSERT_EQUAL_UINT32(3U, deltas[1]);
+    TEST_ASSERT_EQUAL_UINT32(1000U, duration);
+
+    pulseCnts[0] = 15U;
+    pulseCnts[1] = 4U;
+
+    /* The other cursor isn't affected by the read before. */
+    TEST_ASSERT_TRUE(cursors.read(1U, pulseCnts, 1500U, deltas, duration));
+    TEST_ASSERT_EQUAL_UINT32(15U, deltas[0]);
+    TEST_ASSERT_EQUAL_UINT32(4U, deltas[1]);
+    TEST_ASSERT_EQUAL_UINT32(1500U, duration);
+
+    TEST_ASSERT_TRUE(cursors.read(0U, pulseCnts, 2000U, deltas, duration));
+    TEST_ASSERT_EQUAL_UINT32(5U, deltas[0]);
+    TEST_ASSERT_EQUAL_UINT32(1U, deltas[1]);
+    TEST_ASSERT_EQUAL_UINT32(1000U, duration);
+
+    /* A second read without new pulses provides nothing. */
+    TEST_ASSERT_TRUE(cursors.read(0U, pulseCnts, 2100U, deltas, duration));
+    TEST_ASSERT_EQUAL_UINT32(0U, deltas[0]);
+    TEST_ASSERT_EQUAL_UINT32(0U, deltas[1]);
+
+    /* The counter and the timestamp wrap around. */
+    pulseCnts[0] = 2U;
+
+    TEST_ASSERT_TRUE(cursors.read(1U, pulseCnts, 0U, deltas, duration));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFU - 15U + 3U, deltas[0]);
+
+    TEST_ASSERT_TRUE(cursors.read(1U, pulseCnts, 100U, deltas, duration));
+    TEST_ASSERT_EQUAL_UINT32(100U, duration);
+
+    /* A invalid cursor doesn't provide anything. */
+    deltas[0] = 42U;
+    TEST_ASSERT_FALSE(cursors.read(2U, pulseCnts, 200U, deltas, duration));
+    TEST_ASSERT_EQUAL_UINT32(42U, deltas[0]);
+}
+
+/**
+ * Test that a snapshot takes all S0 interfaces at the capture timestamp and
+ * that every capture gets the next sequence number.
+ */
+static void testS0Snapshot(void)
+{
+    S0Smartmeter    s0Smartmeters[2U];
+    S0Snapshot      snapshot;
+
+    TEST_ASSERT_TRUE(s0Smartmeters[0].init(0U, "house", S0_PIN, PULSES_PER_KWH));
+    TEST_ASSERT_TRUE(s0Smartmeters[1].init(1U, "heatpump", S0_PIN + 1U, PULSES_PER_KWH));
+    s0Smartmeters[0].enable();
+    s0Smartmeters[1].enable();
+
+    TEST_ASSERT_EQUAL_UINT32(0U, snapshot.getSeq());
+
+    /* 1 kW on the first S0 interface, the second one has no pulse yet. */
+    s0Smartmeters[0].internalISR(1000UL);
+    s0Smartmeters[0].internalISR(4600UL);
+
+    VirtualClock::set(5000ULL * 1000ULL);
+    snapshot.capture(s0Smartmeters, 2U);
+
+    TEST_ASSERT_EQUAL_UINT32(1U, snapshot.getSeq());
+    TEST_ASSERT_EQUAL_UINT32(5000U, snapshot.getTimestamp());
+    TEST_ASSERT_EQUAL_UINT8(2U, snapshot.getNumChannels());
+
+    TEST_ASSERT_TRUE(snapshot.getChannel(0U).isEnabled);
+    TEST_ASSERT_TRUE(snapshot.getChannel(0U).hasPulse);
+    TEST_ASSERT_EQUAL_UINT32(2U, snapshot.getChannel(0U).pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(1000U, snapshot.getChannel(0U).powerConsumption);
+    TEST_ASSERT_EQUAL_UINT32(7200U, snapshot.getChannel(0U).energyConsumption);
+    TEST_ASSERT_EQUAL_UINT32(400U, snapshot.getChannel(0U).lastPulseAge);
+
+    TEST_ASSERT_FALSE(snapshot.getChannel(1U).hasPulse);
+    TEST_ASSERT_EQUAL_UINT32(0U, snapshot.getChannel(1U).pulseCnt);
+
+    /* A later pulse doesn't change the captured values. */
+    s0Smartmeters[1].internalISR(5500UL);
+    TEST_ASSERT_EQUAL_UINT32(0U, snapshot.getChannel(1U).pulseCnt);
+
+    VirtualClock::set(6000ULL * 1000ULL);
+    snapshot.capture(s0Smartmeters, 2U);
+
+    TEST_ASSERT_EQUAL_UINT32(2U, snapshot.getSeq());
+    TEST_ASSERT_TRUE(snapshot.getChannel(1U).hasPulse);
+    TEST_ASSERT_EQUAL_UINT32(1U, snapshot.getChannel(1U).pulseCnt);
+    TEST_ASSERT_EQUAL_UINT32(500U, snapshot.getChannel(1U).lastPulseAge);
+    TEST_ASSERT_EQUAL_UINT32(1400U, snapshot.getChannel(0U).lastPulseAge);
+
+    /* More S0 interfaces than supported are ignored. */
+    snapshot.capture(s0Smartmeters, CONFIG_S0_SMARTMETER_MAX_NUM + 1U);
+    TEST_ASSERT_EQUAL_UINT8(CONFIG_S0_SMARTMETER_MAX_NUM, snapshot.getNumChannels());
+}
+
+/**
+ * Form field handler of the field "name".
+ *
+ * @param[in] ctx   Form parser test context
+ * @param[in] value Decoded value
+ */
+static void handleFormName(void* ctx, const char* value)
+{
+    FormCtx* formCtx = static_cast<FormCtx*>(ctx);
+
+    strncpy(formCtx->name, value, sizeof(formCtx->name) - 1U);
+    formCtx->name[sizeof(formCtx->name) - 1U] = '\0';
+    ++formCtx->nameCnt;
+}
+
+/**
+ * Form field handler of the field "name2".
+ *
+ * @param[in] ctx   Form parser test context
+ * @param[in] value Decoded value
+ */
+static void handleFormName2(void* ctx, const char* value)
+{
+    FormCtx* formCtx = static_cast<FormCtx*>(ctx);
+
+    strncpy(formCtx->name2, value, sizeof(formCtx->name2) - 1U);
+    formCtx->name2[sizeof(formCtx->name2) - 1U] = '\0';
+    ++formCtx->name2Cnt;
+}
+
+/**
+ * Parse a whole form byte by byte, like it is received.
+ *
+ * @param[in] form          Form data
+ * @param[in] ctx           Form parser test context
+ * @param[in] valueSize     Size of the value buffer in bytes, at most 16
+ */
+static void parseForm(const char* form, FormCtx& ctx, size_t valueSize)
+{
+    char        value[16U];
+    FormParser  parser(FORM_FIELDS, sizeof(FORM_FIELDS) / sizeof(FORM_FIELDS[0]), value, valueSize, &ctx);
+
+    memset(&ctx, 0, sizeof(ctx));
+
+    while('\0' != *form)
+    {
+        parser.parse(*form);
+        ++form;
+    }
+
+    parser.finish();
+}
+
+/**
+ * Test that the keys and values are percent and '+' decoded.
+ */
+static void testFormDecoding(void)
+{
+    FormCtx ctx;
+
+    parseForm("name=Heat+pump%201%2b%26&na%6De2=%41%62", ctx, 16U);
+
+    TEST_ASSERT_EQUAL_UINT8(1U, ctx.nameCnt);
+    TEST_ASSERT_EQUAL_STRING("Heat pump 1+&", ctx.name);
+    TEST_ASSERT_EQUAL_UINT8(1U, ctx.name2Cnt);
+    TEST_ASSERT_EQUAL_STRING("Ab", ctx.name2);
+}
+
+/**
+ * Test that an invalid or truncated percent encoded character is taken
+ * literally.
+ */
+static void testFormInvalidPercent(void)
+{
+    FormCtx ctx;
+
+    parseForm("name=100%", ctx, 16U);
+    TEST_ASSERT_EQUAL_STRING("100%", ctx.name);
+
+    parseForm("name=a%4", ctx, 16U);
+    TEST_ASSERT_EQUAL_STRING("a%4", ctx.name);
+
+    parseForm("name=%zz&name2=%4g", ctx, 16U);
+    TEST_ASSERT_EQUAL_STRING("%zz", ctx.name);
+    TEST_ASSERT_EQUAL_STRING("%4g", ctx.name2);
+
+    /* The pair ends, even if the percent encoded character is incomplete. */
+    parseForm("name=%4&name2=x", ctx, 16U);
+    TEST_ASSERT_EQUAL_STRING("%4", ctx.name);
+    TEST_ASSERT_EQUAL_STRING("x", ctx.name2);
+}
+
+/**
+ * Test that only a key with the same length matches a field, not its prefix
+ * or a longer key.
+ */
+static void testFormKeyPrefix(void)
+{
+    FormCtx ctx;
+
+    parseForm("nam=a&names=b&name22=c", ctx, 16U);
+    TEST_ASSERT_EQUAL_UINT8(0U, ctx.nameCnt);
+    TEST_ASSERT_EQUAL_UINT8(0U, ctx.name2Cnt);
+
+    parseForm("name2=b&name=a", ctx, 16U);
+    TEST_ASSERT_EQUAL_UINT8(1U, ctx.nameCnt);
+    TEST_ASSERT_EQUAL_STRING("a", ctx.name);
+    TEST_ASSERT_EQUAL_UINT8(1U, ctx.name2Cnt);
+    TEST_ASSERT_EQUAL_STRING("b", ctx.name2);
+}
+
+/**
+ * Test that a value, which doesn't fit into the value buffer, is truncated
+ * and the next pair is still parsed.
+ */
+static void testFormTruncation(void)
+{
+    FormCtx ctx;
+
+    parseForm("name=0123456789&name2=ok", ctx, 8U);
+    TEST_ASSERT_EQUAL_STRING("0123456", ctx.name);
+    TEST_ASSERT_EQUAL_STRING("ok", ctx.name2);
+
+    /* The value is truncated after decoding. */
+    parseForm("name=%41%42%43%44%45%46%47%48", ctx, 4U);
+    TEST_ASSERT_EQUAL_STRING("ABC", ctx.name);
+}
+
+/**
+ * Test the empty keys and values.
+ */
+static void testFormEmpty(void)
+{
+    FormCtx ctx;
+
+    /* A empty key is skipped, the value of a known key may be empty. */
+    parseForm("=x&&name=&", ctx, 16U);
+    TEST_ASSERT_EQUAL_UINT8(1U, ctx.nameCnt);
+    TEST_ASSERT_EQUAL_STRING("", ctx.name);
+    TEST_ASSERT_EQUAL_UINT8(0U, ctx.name2Cnt);
+
+    /* A key without '=' has a empty value. */
+    parseForm("name2", ctx, 16U);
+    TEST_ASSERT_EQUAL_UINT8(1U, ctx.name2Cnt);
+    TEST_ASSERT_EQUAL_STRING("", ctx.name2);
+
+    parseForm("", ctx, 16U);
+    TEST_ASSERT_EQUAL_UINT8(0U, ctx.nameCnt);
+    TEST_ASSERT_EQUAL_UINT8(0U, ctx.name2Cnt);
+}
+
+/**
+ * Test that writing the configuration commits only the blocks, which
+ * changed, and that an unchanged configuration doesn't write the EEPROM.
+ */
+static void testWriteConfig(void)
+{
+    PersistentMemory::S0Data    s0DataList[CONFIG_S0_SMARTMETER_MAX_NUM];
+    PersistentMemory::NetData   netData;
+    uint8_t                     index       = 0U;
+    uint32_t                    writeCnt    = 0U;
+
+    TEST_ASSERT_EQUAL_UINT8(PersistentMemory::RET_RESTORED, PersistentMemory::init());
+
+    for(index = 0U; index < CONFIG_S0_SMARTMETER_MAX_NUM; ++index)
+    {
+        PersistentMemory::readS0Data(index, s0DataList[index]);
+    }
+
+    PersistentMemory::readNetData(netData);
+
+    /* Nothing changed, nothing is written, not even a status. */
+    writeCnt = HalTest::getEepromWriteCnt();
+    TEST_ASSERT_EQUAL_UINT8(PersistentMemory::RET_OK, PersistentMemory::writeConfig(s0DataList, CONFIG_S0_SMARTMETER_MAX_NUM, netData));
+    TEST_ASSERT_EQUAL_UINT32(writeCnt, HalTest::getEepromWriteCnt());
+
+    /* Only the network block changes: 1 byte and its status twice. */
+    ++netData.syslogPort;
+    writeCnt = HalTest::getEepromWriteCnt();
+    TEST_ASSERT_EQUAL_UINT8(PersistentMemory::RET_OK, PersistentMemory::writeConfig(s0DataList, CONFIG_S0_SMARTMETER_MAX_NUM, netData));
+    TEST_ASSERT_EQUAL_UINT32(writeCnt + 3U, HalTest::getEepromWriteCnt());
+
+    /* Only the S0 block changes: 1 byte and its status twice. */
+    s0DataList[CONFIG_S0_SMARTMETER_MAX_NUM - 1U].pinS0 += 1U;
+    writeCnt = HalTest::getEepromWriteCnt();
+    TEST_ASSERT_EQUAL_UINT8(PersistentMemory::RET_OK, PersistentMemory::writeConfig(s0DataList, CONFIG_S0_SMARTMETER_MAX_NUM, netData));
+    TEST_ASSERT_EQUAL_UINT32(writeCnt + 3U, HalTest::getEepromWriteCnt());
+
+    /* Both blocks are valid and the written configuration is read back. */
+    TEST_ASSERT_EQUAL_UINT8(PersistentMemory::RET_OK, PersistentMemory::init());
+    PersistentMemory::readS0Data(CONFIG_S0_SMARTMETER_MAX_NUM - 1U, s0DataList[0]);
+    PersistentMemory::readNetData(netData);
+    TEST_ASSERT_EQUAL_UINT8(s0DataList[CONFIG_S0_SMARTMETER_MAX_NUM - 1U].pinS0, s0DataList[0].pinS0);
+    TEST_ASSERT_EQUAL_UINT16(515U, netData.syslogPort);
+}
@@ -0,0 +1,1498 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Collector of the S0 interface data of many devices
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Polls GET /api/s0-interfaces of a fleet of devices concurrently and writes
+ * the samples as InfluxDB line protocol, one line per S0 interface:
+ *
+ *     s0,device=<device>,id=<id>,name=<name> power=<W>i,pulses=<n>i,energy=<Wh>,pulses_per_kwh=<n>i <ns>
+ *
+ * The energy is normalized: it is derived from the counted pulses, not from
+ * the energy of the firmware, which is rounded per pulse.
+ *
+ * Every worker thread runs a event loop (epoll) with non-blocking sockets
+ * for its share of the devices, therefore hundreds of devices are polled by
+ * a single thread. The polls are spread over the poll interval. If a device
+ * keeps the connection alive, it is reused for the next poll. If it responds
+ * with a ETag, the next poll is a conditional request and a "304 Not
+ * Modified" response results in no sample. The firmware closes every
+ * connection and has no ETag, so both are used with other servers only,
+ * e.g. a proxy in front of the devices.
+ *
+ * A failed poll (connect error, timeout, invalid response) is retried with
+ * exponential backoff, up to a max. delay and with some jitter, so a fleet
+ * doesn't retry in sync after a network outage.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Connection state of a device.
+ */
+enum ConnState
+{
+    CONN_STATE_IDLE = 0,    /**< Waiting for the next poll */
+    CONN_STATE_CONNECTING,  /**< Connecting */
+    CONN_STATE_SENDING,     /**< Sending the request */
+    CONN_STATE_RECEIVING    /**< Receiving the response */
+};
+
+/**
+ * A polled device.
+ */
+struct Device
+{
+    std::string             name;           /**< Device name, used as tag */
+    std::string             host;           /**< Host name or address */
+    uint16_t                port;           /**< Server port */
+    struct sockaddr_storage addr;           /**< Resolved address */
+    socklen_t               addrLen;        /**< Resolved address length */
+    ConnState               state;          /**< Connection state */
+    int                     fd;             /**< Socket or -1 */
+    bool                    isReused;       /**< Is the connection reused from the previous poll? */
+    std::string             etag;           /**< ETag of the last response */
+    std::string             request;        /**< Raw HTTP request */
+    size_t                  sent;           /**< Sent bytes of the request */
+    std::string             response;       /**< Received response */
+    uint64_t                nextPoll;       /**< Time in us of the next poll */
+    uint64_t                deadline;       /**< Time in us, when the current poll times out */
+    uint32_t                failures;       /**< Number of consecutive failed polls */
+};
+
+/**
+ * Sample of a S0 interface, like the firmware serializes it.
+ */
+struct Sample
+{
+    uint64_t    id;             /**< S0 interface id */
+    std::string name;           /**< S0 interface name */
+    uint64_t    pulsesPerKWh;   /**< Pulses per kWh */
+    uint64_t    power;          /**< Power consumption in W */
+    uint64_t    pulses;         /**< Counted pulses */
+    uint64_t    energy;         /**< Energy consumption of the firmware */
+};
+
+/**
+ * Configuration of the collector.
+ */
+struct Config
+{
+    std::string     path;           /**< Polled resource */
+    uint32_t        interval;       /**< Poll interval in s */
+    uint32_t        timeout;        /**< Poll timeout in ms */
+    uint32_t        maxBackoff;     /**< Max. retry delay in s */
+    uint32_t        threads;        /**< Number of worker threads */
+    uint32_t        duration;       /**< Duration in s, 0 for infinite */
+};
+
+/**
+ * Statistics of a worker.
+ */
+struct Stats
+{
+    uint64_t    polls;          /**< Number of polls */
+    uint64_t    samples;        /**< Number of written samples */
+    uint64_t    failures;       /**< Number of failed polls */
+    uint64_t    notModified;    /**< Number of "304 Not Modified" responses */
+    uint64_t    connects;       /**< Number of new connections */
+    uint64_t    reused;         /**< Number of reused connections */
+};
+
+/**
+ * Output of the samples, shared by all workers.
+ */
+struct Output
+{
+    FILE*       fd;     /**< Output file */
+    std::mutex  mutex;  /**< Serializes the writes of the workers */
+};
+
+/**
+ * A worker with its event loop and its share of the devices.
+ */
+struct Worker
+{
+    int                     epollFd;    /**< Event loop */
+    std::vector<Device*>    devices;    /**< Polled devices */
+    Stats                   stats;      /**< Statistics */
+    uint32_t                random;     /**< State of the pseudo random generator */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void onSignal(int signalNo);
+static uint64_t getMicros(void);
+static uint64_t getRealTimeNanos(void);
+static uint32_t nextRandom(uint32_t& state);
+static bool addDevice(const std::string& spec, std::vector<Device>& devices);
+static bool loadDevices(const char* fileName, std::vector<Device>& devices);
+static bool resolveDevice(Device& device);
+static void runWorker(const Config& config, Worker& worker, Output& output, uint64_t end);
+static void startPoll(const Config& config, Worker& worker, Device& device, uint64_t now);
+static void handleEvent(const Config& config, Worker& worker, Output& output, Device& device, uint32_t events, uint64_t now);
+static bool sendRequest(Worker& worker, Device& device);
+static int receiveResponse(Device& device);
+static bool isResponseComplete(const std::string& response, bool isClosed);
+static void completePoll(const Config& config, Worker& worker, Output& output, Device& device, bool isClosed, uint64_t now);
+static void failPoll(const Config& config, Worker& worker, Device& device, const char* reason, uint64_t now);
+static void closeConnection(Worker& worker, Device& device);
+static bool getHeader(const std::string& response, const char* name, std::string& value);
+static bool parseSamples(const std::string& body, std::vector<Sample>& samples);
+static bool parseString(const std::string& str, size_t& pos, std::string& value);
+static void skipSpaces(const std::string& str, size_t& pos);
+static std::string escapeTag(const std::string& str);
+static void printUsage(const char* prgName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Default HTTP server port of the devices. */
+static const uint16_t   DEFAULT_PORT        = 80U;
+
+/** Max. number of events per epoll_wait(). */
+static const int        MAX_EVENTS          = 64;
+
+/** Max. time in ms, the event loop waits, to check the stop request. */
+static const int        MAX_WAIT            = 200;
+
+/** Max. size of a response in bytes. */
+static const size_t     MAX_RESPONSE_SIZE   = 64U * 1024U;
+
+/** Jitter of the retry delay in per mille. */
+static const uint32_t   BACKOFF_JITTER      = 100U;
+
+/** Is a stop requested, e.g. by SIGINT? */
+static volatile sig_atomic_t    gIsStopRequested    = 0;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Process entry point.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "device",         required_argument,  nullptr,    'd' },
+        { "devices",        required_argument,  nullptr,    'f' },
+        { "path",           required_argument,  nullptr,    'u' },
+        { "interval",       required_argument,  nullptr,    'i' },
+        { "timeout",        required_argument,  nullptr,    't' },
+        { "max-backoff",    required_argument,  nullptr,    'b' },
+        { "threads",        required_argument,  nullptr,    'j' },
+        { "duration",       required_argument,  nullptr,    'D' },
+        { "out",            required_argument,  nullptr,    'o' },
+        { "help",           no_argument,        nullptr,    'h' },
+        { nullptr,          0,                  nullptr,    0   }
+    };
+    Config                      config;
+    Output                      output;
+    std::vector<Device>         devices;
+    std::vector<Worker>         workers;
+    std::vector<std::thread>    threads;
+    const char*                 outFile     = nullptr;
+    uint64_t                    start       = 0U;
+    uint64_t                    end         = 0U;
+    Stats                       total;
+    size_t                      idx         = 0U;
+    int                         opt         = 0;
+
+    config.path         = "/api/s0-interfaces";
+    config.interval     = 10U;
+    config.timeout      = 2000U;
+    config.maxBackoff   = 300U;
+    config.threads      = 1U;
+    config.duration     = 0U;
+
+    while(-1 != (opt = getopt_long(argc, argv, "d:f:u:i:t:b:j:D:o:h", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 'd':
+            if (false == addDevice(optarg, devices))
+            {
+                fprintf(stderr, "Invalid device: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'f':
+            if (false == loadDevices(optarg, devices))
+            {
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'u':
+            config.path = optarg;
+            break;
+
+        case 'i':
+            config.interval = strtoul(optarg, nullptr, 0);
+            break;
+
+        case 't':
+            config.timeout = strtoul(optarg, nullptr, 0);
+            break;
+
+        case 'b':
+            config.maxBackoff = strtoul(optarg, nullptr, 0);
+            break;
+
+        case 'j':
+            config.threads = strtoul(optarg, nullptr, 0);
+            break;
+
+        case 'D':
+            config.duration = strtoul(optarg, nullptr, 0);
+            break;
+
+        case 'o':
+            outFile = optarg;
+            break;
+
+        case 'h':
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+
+        default:
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((true == devices.empty()) ||
+        (0U == config.interval) ||
+        (0U == config.timeout) ||
+        (0U == config.threads))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (config.maxBackoff < config.interval)
+    {
+        config.maxBackoff = config.interval;
+    }
+
+    for(idx = 0U; idx < devices.size(); ++idx)
+    {
+        if (false == resolveDevice(devices[idx]))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    output.fd = stdout;
+
+    if (nullptr != outFile)
+    {
+        output.fd = fopen(outFile, "a");
+
+        if (nullptr == output.fd)
+        {
+            perror(outFile);
+            return EXIT_FAILURE;
+        }
+    }
+
+    (void)signal(SIGINT, onSignal);
+    (void)signal(SIGTERM, onSignal);
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    start = getMicros();
+
+    if (0U < config.duration)
+    {
+        end = start + config.duration * 1000000ULL;
+    }
+
+    /* Spread the devices over the workers and their polls over the interval. */
+    workers.resize(std::min<size_t>(config.threads, devices.size()));
+
+    for(idx = 0U; idx < workers.size(); ++idx)
+    {
+        workers[idx].epollFd    = epoll_create1(EPOLL_CLOEXEC);
+        workers[idx].random     = 0x9E3779B9U + static_cast<uint32_t>(idx);
+        memset(&workers[idx].stats, 0, sizeof(workers[idx].stats));
+
+        if (0 > workers[idx].epollFd)
+        {
+            perror("epoll_create1");
+            return EXIT_FAILURE;
+        }
+    }
+
+    for(idx = 0U; idx < devices.size(); ++idx)
+    {
+        Device& device = devices[idx];
+
+        device.nextPoll = start + (config.interval * 1000000ULL * idx) / devices.size();
+        workers[idx % workers.size()].devices.push_back(&device);
+    }
+
+    for(idx = 0U; idx < workers.size(); ++idx)
+    {
+        threads.push_back(std::thread(runWorker, std::cref(config), std::ref(workers[idx]), std::ref(output), end));
+    }
+
+    memset(&total, 0, sizeof(total));
+
+    for(idx = 0U; idx < workers.size(); ++idx)
+    {
+        const Stats& stats = workers[idx].stats;
+
+        threads[idx].join();
+
+        total.polls         += stats.polls;
+        total.samples       += stats.samples;
+        total.failures      += stats.failures;
+        total.notModified   += stats.notModified;
+        total.connects      += stats.connects;
+        total.reused        += stats.reused;
+
+        (void)close(workers[idx].epollFd);
+    }
+
+    if (stdout != output.fd)
+    {
+        (void)fclose(output.fd);
+    }
+
+    fprintf(stderr, "{\"name\":\"collector.summary\",\"devices\":%zu,\"threads\":%zu,\"seconds\":%.1f,\"polls\":%llu,\"samples\":%llu,"
+                    "\"failures\":%llu,\"notModified\":%llu,\"connects\":%llu,\"reused\":%llu}\n",
+        devices.size(),
+        workers.size(),
+        static_cast<double>(getMicros() - start) / 1000000.0,
+        static_cast<unsigned long long>(total.polls),
+        static_cast<unsigned long long>(total.samples),
+        static_cast<unsigned long long>(total.failures),
+        static_cast<unsigned long long>(total.notModified),
+        static_cast<unsigned long long>(total.connects),
+        static_cast<unsigned long long>(total.reused));
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Request the workers to stop.
+ *
+ * @param[in] signalNo  Signal number
+ */
+static void onSignal(int signalNo)
+{
+    (void)signalNo;
+
+    gIsStopRequested = 1;
+}
+
+/**
+ * Get the monotonic time.
+ *
+ * @return Time in us
+ */
+static uint64_t getMicros(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (static_cast<uint64_t>(ts.tv_sec) * 1000000ULL) + static_cast<uint64_t>(ts.tv_nsec / 1000);
+}
+
+/**
+ * Get the wall clock time, used as timestamp of the samples.
+ *
+ * @return Time in ns since the epoch
+ */
+static uint64_t getRealTimeNanos(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_REALTIME, &ts);
+
+    return (static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL) + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * Get the next pseudo random number (xorshift32).
+ *
+ * @param[in,out] state Generator state, must not be 0.
+ *
+ * @return Pseudo random number
+ */
+static uint32_t nextRandom(uint32_t& state)
+{
+    state ^= state << 13U;
+    state ^= state >> 17U;
+    state ^= state << 5U;
+
+    return state;
+}
+
+/**
+ * Add a device, given as NAME=HOST[:PORT].
+ *
+ * @param[in]       spec    Device specification
+ * @param[in,out]   devices Devices
+ *
+ * @return If the specification is valid, it will return true otherwise false.
+ */
+static bool addDevice(const std::string& spec, std::vector<Device>& devices)
+{
+    size_t  namePos = spec.find('=');
+    size_t  portPos = spec.rfind(':');
+    Device  device;
+
+    if ((std::string::npos == namePos) || (0U == namePos))
+    {
+        return false;
+    }
+
+    device.name = spec.substr(0U, namePos);
+    device.port = DEFAULT_PORT;
+
+    if ((std::string::npos != portPos) && (namePos < portPos))
+    {
+        char*           endPtr  = nullptr;
+        unsigned long   port    = strtoul(spec.c_str() + portPos + 1U, &endPtr, 10);
+
+        if (('\0' != *endPtr) || (0U == port) || (UINT16_MAX < port))
+        {
+            return false;
+        }
+
+        device.host = spec.substr(namePos + 1U, portPos - namePos - 1U);
+        device.port = static_cast<uint16_t>(port);
+    }
+    else
+    {
+        device.host = spec.substr(namePos + 1U);
+    }
+
+    if (true == device.host.empty())
+    {
+        return false;
+    }
+
+    memset(&device.addr, 0, sizeof(device.addr));
+    device.addrLen  = 0U;
+    device.state    = CONN_STATE_IDLE;
+    device.fd       = -1;
+    device.isReused = false;
+    device.sent     = 0U;
+    device.nextPoll = 0U;
+    device.deadline = 0U;
+    device.failures = 0U;
+
+    devices.push_back(device);
+
+    return true;
+}
+
+/**
+ * Load the devices from a file with one NAME=HOST[:PORT] per line. Empty
+ * lines and lines starting with # are skipped.
+ *
+ * @param[in]       fileName    File name
+ * @param[in,out]   devices     Devices
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool loadDevices(const char* fileName, std::vector<Device>& devices)
+{
+    FILE*       fd              = fopen(fileName, "r");
+    char        line[256];
+    uint32_t    lineNo          = 0U;
+    bool        isSuccessful    = true;
+
+    if (nullptr == fd)
+    {
+        perror(fileName);
+        return false;
+    }
+
+    while((true == isSuccessful) && (nullptr != fgets(line, sizeof(line), fd)))
+    {
+        std::string spec(line);
+
+        ++lineNo;
+
+        while((false == spec.empty()) && (nullptr != strchr(" \t\r\n", spec.back())))
+        {
+            spec.pop_back();
+        }
+
+        if ((true == spec.empty()) || ('#' == spec[0]))
+        {
+            continue;
+        }
+
+        if (false == addDevice(spec, devices))
+        {
+            fprintf(stderr, "%s:%u: Invalid device.\n", fileName, lineNo);
+            isSuccessful = false;
+        }
+    }
+
+    (void)fclose(fd);
+
+    return isSuccessful;
+}
+
+/**
+ * Resolve the address of a device once at startup.
+ *
+ * @param[in,out] device    Device
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool resolveDevice(Device& device)
+{
+    struct addrinfo     hints;
+    struct addrinfo*    result  = nullptr;
+    char                port[8];
+    int                 ret     = 0;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family     = AF_UNSPEC;
+    hints.ai_socktype   = SOCK_STREAM;
+
+    (void)snprintf(port, sizeof(port), "%u", device.port);
+
+    ret = getaddrinfo(device.host.c_str(), port, &hints, &result);
+
+    if ((0 != ret) || (nullptr == result))
+    {
+        fprintf(stderr, "%s: Can't resolve %s: %s\n", device.name.c_str(), device.host.c_str(), gai_strerror(ret));
+        return false;
+    }
+
+    memcpy(&device.addr, result->ai_addr, result->ai_addrlen);
+    device.addrLen = result->ai_addrlen;
+
+    freeaddrinfo(result);
+
+    return true;
+}
+
+/**
+ * Run the event loop of a worker, until the duration expired or a stop is
+ * requested.
+ *
+ * @param[in]       config  Configuration
+ * @param[in,out]   worker  Worker
+ * @param[in]       output  Output of the samples
+ * @param[in]       end     Time in us of the end or 0 for infinite
+ */
+static void runWorker(const Config& config, Worker& worker, Output& output, uint64_t end)
+{
+    struct epoll_event  events[MAX_EVENTS];
+    uint64_t            now     = getMicros();
+
+    while((0 == gIsStopRequested) &&
+          ((0U == end) || (end > now)))
+    {
+        uint64_t    next    = (0U == end) ? UINT64_MAX : end;
+        uint64_t    wait    = 0U;
+        int         num     = 0;
+        int         idx     = 0;
+
+        for(Device* device : worker.devices)
+        {
+            if (CONN_STATE_IDLE == device->state)
+            {
+                if (device->nextPoll <= now)
+                {
+                    startPoll(config, worker, *device, now);
+                }
+            }
+            else if (device->deadline <= now)
+            {
+                failPoll(config, worker, *device, "timeout", now);
+            }
+
+            next = std::min(next, (CONN_STATE_IDLE == device->state) ? device->nextPoll : device->deadline);
+        }
+
+        wait = (next > now) ? ((next - now + 999U) / 1000U) : 0U;
+        num  = epoll_wait(worker.epollFd, events, MAX_EVENTS, static_cast<int>(std::min<uint64_t>(wait, MAX_WAIT)));
+        now  = getMicros();
+
+        for(idx = 0; idx < num; ++idx)
+        {
+            handleEvent(config, worker, output, *static_cast<Device*>(events[idx].data.ptr), events[idx].events, now);
+        }
+    }
+
+    for(Device* device : worker.devices)
+    {
+        closeConnection(worker, *device);
+    }
+
+    return;
+}
+
+/**
+ * Start a poll of a device. A kept alive connection is reused, otherwise a
+ * new one is established.
+ *
+ * @param[in]       config  Configuration
+ * @param[in,out]   worker  Worker
+ * @param[in,out]   device  Device
+ * @param[in]       now     Time in us
+ */
+static void startPoll(const Config& config, Worker& worker, Device& device, uint64_t now)
+{
+    struct epoll_event  event;
+    int                 flag    = 1;
+
+    ++worker.stats.polls;
+
+    device.request  = "GET " + config.path + " HTTP/1.1\r\n"
+                      "Host: " + device.host + "\r\n"
+                      "Connection: keep-alive\r\n";
+
+    if (false == device.etag.empty())
+    {
+        device.request += "If-None-Match: " + device.etag + "\r\n";
+    }
+
+    device.request  += "\r\n";
+    device.sent      = 0U;
+    device.deadline  = now + config.timeout * 1000ULL;
+    device.response.clear();
+
+    event.data.ptr  = &device;
+    event.events    = EPOLLOUT;
+
+    if (0 <= device.fd)
+    {
+        ++worker.stats.reused;
+
+        device.isReused = true;
+        device.state    = CONN_STATE_SENDING;
+
+        (void)epoll_ctl(worker.epollFd, EPOLL_CTL_MOD, device.fd, &event);
+
+        return;
+    }
+
+    device.isReused = false;
+    device.fd       = socket(device.addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (0 > device.fd)
+    {
+        failPoll(config, worker, device, strerror(errno), now);
+        return;
+    }
+
+    ++worker.stats.connects;
+
+    (void)setsockopt(device.fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+    if ((0 != connect(device.fd, reinterpret_cast<const struct sockaddr*>(&device.addr), device.addrLen)) &&
+        (EINPROGRESS != errno))
+    {
+        failPoll(config, worker, device, strerror(errno), now);
+        return;
+    }
+
+    device.state = CONN_STATE_CONNECTING;
+
+    if (0 != epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, device.fd, &event))
+    {
+        failPoll(config, worker, device, strerror(errno), now);
+    }
+
+    return;
+}
+
+/**
+ * Handle a event of the connection of a device.
+ *
+ * @param[in]       config  Configuration
+ * @param[in,out]   worker  Worker
+ * @param[in]       output  Output of the samples
+ * @param[in,out]   device  Device
+ * @param[in]       events  Epoll events
+ * @param[in]       now     Time in us
+ */
+static void handleEvent(const Config& config, Worker& worker, Output& output, Device& device, uint32_t events, uint64_t now)
+{
+    switch(device.state)
+    {
+    case CONN_STATE_IDLE:
+        /* The server closed the kept alive connection. */
+        closeConnection(worker, device);
+        break;
+
+    case CONN_STATE_CONNECTING:
+        {
+            int         error   = 0;
+            socklen_t   len     = sizeof(error);
+
+            if ((0 != getsockopt(device.fd, SOL_SOCKET, SO_ERROR, &error, &len)) ||
+                (0 != error))
+            {
+                failPoll(config, worker, device, strerror((0 != error) ? error : errno), now);
+                break;
+            }
+
+            device.state = CONN_STATE_SENDING;
+        }
+        /* fallthrough */
+
+    case CONN_STATE_SENDING:
+        if (false == sendRequest(worker, device))
+        {
+            if (true == device.isReused)
+            {
+                /* The server closed the kept alive connection meanwhile, retry with a new one. */
+                closeConnection(worker, device);
+                --worker.stats.polls;
+                startPoll(config, worker, device, now);
+            }
+            else
+            {
+                failPoll(config, worker, device, "send failed", now);
+            }
+        }
+        break;
+
+    case CONN_STATE_RECEIVING:
+        {
+            int ret = receiveResponse(device);
+
+            if (0 > ret)
+            {
+                if ((true == device.isReused) && (true == device.response.empty()))
+                {
+                    closeConnection(worker, device);
+                    --worker.stats.polls;
+                    startPoll(config, worker, device, now);
+                }
+                else
+                {
+                    failPoll(config, worker, device, "connection lost", now);
+                }
+            }
+            else if (true == isResponseComplete(device.response, (0 == ret)))
+            {
+                completePoll(config, worker, output, device, (0 == ret), now);
+            }
+            else if (0 == ret)
+            {
+                failPoll(config, worker, device, "incomplete response", now);
+            }
+            else if (MAX_RESPONSE_SIZE < device.response.size())
+            {
+                failPoll(config, worker, device, "response too large", now);
+            }
+            else
+            {
+                ;
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    (void)events;
+
+    return;
+}
+
+/**
+ * Send the rest of the request. After it is sent completely, the connection
+ * waits for the response.
+ *
+ * @param[in]       worker  Worker
+ * @param[in,out]   device  Device
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool sendRequest(Worker& worker, Device& device)
+{
+    while(device.request.size() > device.sent)
+    {
+        ssize_t len = send(device.fd, device.request.data() + device.sent, device.request.size() - device.sent, MSG_NOSIGNAL);
+
+        if (0 > len)
+        {
+            return (EAGAIN == errno) || (EWOULDBLOCK == errno);
+        }
+
+        device.sent += static_cast<size_t>(len);
+    }
+
+    {
+        struct epoll_event event;
+
+        event.data.ptr  = &device;
+        event.events    = EPOLLIN | EPOLLRDHUP;
+
+        device.state = CONN_STATE_RECEIVING;
+
+        (void)epoll_ctl(worker.epollFd, EPOLL_CTL_MOD, device.fd, &event);
+    }
+
+    return true;
+}
+
+/**
+ * Receive all available data of the response.
+ *
+ * @param[in,out] device    Device
+ *
+ * @return 1 if the connection is open, 0 if the server closed it and -1 on error.
+ */
+static int receiveResponse(Device& device)
+{
+    char buffer[4096];
+
+    while(true)
+    {
+        ssize_t len = recv(device.fd, buffer, sizeof(buffer), 0);
+
+        if (0 < len)
+        {
+            device.response.append(buffer, static_cast<size_t>(len));
+        }
+        else if (0 == len)
+        {
+            return 0;
+        }
+        else if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+        {
+            return 1;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+}
+
+/**
+ * Is the response complete? It is complete, if the body has the announced
+ * length or without length, if the server closed the connection.
+ *
+ * @param[in] response  Received response
+ * @param[in] isClosed  Did the server close the connection?
+ *
+ * @return If the response is complete, it will return true otherwise false.
+ */
+static bool isResponseComplete(const std::string& response, bool isClosed)
+{
+    size_t      headerEnd       = response.find("\r\n\r\n");
+    std::string contentLength;
+
+    if (std::string::npos == headerEnd)
+    {
+        return false;
+    }
+
+    if (true == getHeader(response, "Content-Length", contentLength))
+    {
+        return (headerEnd + 4U + strtoul(contentLength.c_str(), nullptr, 10)) <= response.size();
+    }
+
+    /* A "304 Not Modified" has no body. */
+    if (0 == response.compare(9U, 3U, "304"))
+    {
+        return true;
+    }
+
+    return isClosed;
+}
+
+/**
+ * Complete a poll: write the samples and schedule the next poll.
+ *
+ * @param[in]       config      Configuration
+ * @param[in,out]   worker      Worker
+ * @param[in]       output      Output of the samples
+ * @param[in,out]   device      Device
+ * @param[in]       isClosed    Did the server close the connection?
+ * @param[in]       now         Time in us
+ */
+static void completePoll(const Config& config, Worker& worker, Output& output, Device& device, bool isClosed, uint64_t now)
+{
+    size_t              headerEnd   = device.response.find("\r\n\r\n");
+    bool                isHttp11    = (0 == device.response.compare(0U, 9U, "HTTP/1.1 "));
+    int                 status      = atoi(device.response.c_str() + 9U);
+    std::string         value;
+    std::vector<Sample> samples;
+
+    if (304 == status)
+    {
+        ++worker.stats.notModified;
+    }
+    else if ((200 != status) ||
+             (false == parseSamples(device.response.substr(headerEnd + 4U), samples)))
+    {
+        failPoll(config, worker, device, "invalid response", now);
+        return;
+    }
+    else
+    {
+        uint64_t    timestamp   = getRealTimeNanos();
+        std::string deviceTag   = escapeTag(device.name);
+        std::string lines;
+
+        for(const Sample& sample : samples)
+        {
+            char        fields[192];
+            double      energy  = (0U < sample.pulsesPerKWh) ?
+                                  (static_cast<double>(sample.pulses) * 1000.0 / static_cast<double>(sample.pulsesPerKWh)) :
+                                  (static_cast<double>(sample.energy) / 3600.0);
+
+            (void)snprintf(fields, sizeof(fields), " power=%llui,pulses=%llui,energy=%.3f,pulses_per_kwh=%llui %llu\n",
+                static_cast<unsigned long long>(sample.power),
+                static_cast<unsigned long long>(sample.pulses),
+                energy,
+                static_cast<unsigned long long>(sample.pulsesPerKWh),
+                static_cast<unsigned long long>(timestamp));
+
+            lines += "s0,device=" + deviceTag + ",id=" + std::to_string(sample.id);
+
+            if (false == sample.name.empty())
+            {
+                lines += ",name=" + escapeTag(sample.name);
+            }
+
+            lines += fields;
+        }
+
+        if (false == lines.empty())
+        {
+            std::lock_guard<std::mutex> lock(output.mutex);
+
+            (void)fwrite(lines.data(), 1U, lines.size(), output.fd);
+            (void)fflush(output.fd);
+        }
+
+        worker.stats.samples += samples.size();
+
+        if (true == getHeader(device.response, "ETag", value))
+        {
+            device.etag = value;
+        }
+    }
+
+    if (0U < device.failures)
+    {
+        fprintf(stderr, "%s: Recovered after %u failed polls.\n", device.name.c_str(), device.failures);
+    }
+
+    device.failures = 0U;
+
+    /* Keep the connection only, if the server keeps it too. */
+    if ((true == isClosed) ||
+        (false == isHttp11) ||
+        ((true == getHeader(device.response, "Connection", value)) && (0 == strcasecmp(value.c_str(), "close"))) ||
+        (false == getHeader(device.response, "Content-Length", value)))
+    {
+        closeConnection(worker, device);
+    }
+    else
+    {
+        struct epoll_event event;
+
+        event.data.ptr  = &device;
+        event.events    = EPOLLIN | EPOLLRDHUP;
+
+        (void)epoll_ctl(worker.epollFd, EPOLL_CTL_MOD, device.fd, &event);
+    }
+
+    device.state = CONN_STATE_IDLE;
+
+    /* Keep the cadence, skip the polls, which are missed already. */
+    do
+    {
+        device.nextPoll += config.interval * 1000000ULL;
+    }
+    while(device.nextPoll <= now);
+
+    return;
+}
+
+/**
+ * Fail a poll: close the connection and retry with exponential backoff.
+ *
+ * @param[in]       config  Configuration
+ * @param[in,out]   worker  Worker
+ * @param[in,out]   device  Device
+ * @param[in]       reason  Reason of the failure
+ * @param[in]       now     Time in us
+ */
+static void failPoll(const Config& config, Worker& worker, Device& device, const char* reason, uint64_t now)
+{
+    uint64_t delay = config.interval * 1000000ULL;
+
+    ++worker.stats.failures;
+
+    /* Report only the first failure, a failing device would flood the log. */
+    if (0U == device.failures)
+    {
+        fprintf(stderr, "%s: Poll failed: %s\n", device.name.c_str(), reason);
+    }
+
+    closeConnection(worker, device);
+
+    if (31U > device.failures)
+    {
+        ++device.failures;
+    }
+
+    delay <<= std::min<uint32_t>(device.failures, 16U);
+    delay   = std::min<uint64_t>(delay, config.maxBackoff * 1000000ULL);
+    delay  += (delay / 1000U) * (nextRandom(worker.random) % BACKOFF_JITTER);
+
+    device.state    = CONN_STATE_IDLE;
+    device.nextPoll = now + delay;
+
+    return;
+}
+
+/**
+ * Close the connection of a device, if there is one.
+ *
+ * @param[in,out]   worker  Worker
+ * @param[in,out]   device  Device
+ */
+static void closeConnection(Worker& worker, Device& device)
+{
+    if (0 <= device.fd)
+    {
+        (void)epoll_ctl(worker.epollFd, EPOLL_CTL_DEL, device.fd, nullptr);
+        (void)close(device.fd);
+
+        device.fd = -1;
+    }
+
+    return;
+}
+
+/**
+ * Get the value of a response header.
+ *
+ * @param[in]   response    Response
+ * @param[in]   name        Header name, case insensitive
+ * @param[out]  value       Header value without surrounding spaces
+ *
+ * @return If the header is found, it will return true otherwise false.
+ */
+static bool getHeader(const std::string& response, const char* name, std::string& value)
+{
+    size_t headerEnd    = response.find("\r\n\r\n");
+    size_t lineStart    = response.find("\r\n");
+    size_t nameLen      = strlen(name);
+
+    while((std::string::npos != lineStart) && (headerEnd > lineStart))
+    {
+        size_t lineEnd = response.find("\r\n", lineStart + 2U);
+
+        lineStart += 2U;
+
+        if ((lineEnd > (lineStart + nameLen)) &&
+            (':' == response[lineStart + nameLen]) &&
+            (0 == strncasecmp(response.c_str() + lineStart, name, nameLen)))
+        {
+            size_t valueStart = lineStart + nameLen + 1U;
+
+            while((lineEnd > valueStart) && (' ' == response[valueStart]))
+            {
+                ++valueStart;
+            }
+
+            value = response.substr(valueStart, lineEnd - valueStart);
+
+            while((false == value.empty()) && (' ' == value.back()))
+            {
+                value.pop_back();
+            }
+
+            return true;
+        }
+
+        lineStart = lineEnd;
+    }
+
+    return false;
+}
+
+/**
+ * Parse the samples of the response body, which has the layout of
+ * S0Model::toJson(): {"data":[{"id":0,"name":"...",...},...],"status":0}.
+ * Unknown members are skipped.
+ *
+ * @param[in]   body    Response body
+ * @param[out]  samples Samples
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool parseSamples(const std::string& body, std::vector<Sample>& samples)
+{
+    size_t pos = body.find("\"data\"");
+
+    if (std::string::npos == pos)
+    {
+        return false;
+    }
+
+    pos += 6U;
+    skipSpaces(body, pos);
+
+    if ((body.size() <= pos) || (':' != body[pos]))
+    {
+        return false;
+    }
+
+    ++pos;
+    skipSpaces(body, pos);
+
+    if ((body.size() <= pos) || ('[' != body[pos]))
+    {
+        return false;
+    }
+
+    ++pos;
+    skipSpaces(body, pos);
+
+    while((body.size() > pos) && (']' != body[pos]))
+    {
+        Sample sample;
+
+        sample.id           = 0U;
+        sample.pulsesPerKWh = 0U;
+        sample.power        = 0U;
+        sample.pulses       = 0U;
+        sample.energy       = 0U;
+
+        if ('{' != body[pos])
+        {
+            return false;
+        }
+
+        ++pos;
+        skipSpaces(body, pos);
+
+        while((body.size() > pos) && ('}' != body[pos]))
+        {
+            std::string key;
+            std::string text;
+            uint64_t    number = 0U;
+
+            if (false == parseString(body, pos, key))
+            {
+                return false;
+            }
+
+            skipSpaces(body, pos);
+
+            if ((body.size() <= pos) || (':' != body[pos]))
+            {
+                return false;
+            }
+
+            ++pos;
+            skipSpaces(body, pos);
+
+            if ((body.size() > pos) && ('"' == body[pos]))
+            {
+                if (false == parseString(body, pos, text))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                size_t valueStart = pos;
+
+                while((body.size() > pos) && (nullptr == strchr(",} \t\r\n", body[pos])))
+                {
+                    ++pos;
+                }
+
+                number = strtoull(body.substr(valueStart, pos - valueStart).c_str(), nullptr, 10);
+            }
+
+            if ("id" == key)
+            {
+                sample.id = number;
+            }
+            else if ("name" == key)
+            {
+                sample.name = text;
+            }
+            else if ("pulsesPer1KWh" == key)
+            {
+                sample.pulsesPerKWh = number;
+            }
+            else if ("powerConsumption" == key)
+            {
+                sample.power = number;
+            }
+            else if ("pulses" == key)
+            {
+                sample.pulses = number;
+            }
+            else if ("energyConsumption" == key)
+            {
+                sample.energy = number;
+            }
+            else
+            {
+                ;
+            }
+
+            skipSpaces(body, pos);
+
+            if ((body.size() > pos) && (',' == body[pos]))
+            {
+                ++pos;
+                skipSpaces(body, pos);
+            }
+        }
+
+        if (body.size() <= pos)
+        {
+            return false;
+        }
+
+        ++pos;
+        skipSpaces(body, pos);
+
+        if ((body.size() > pos) && (',' == body[pos]))
+        {
+            ++pos;
+            skipSpaces(body, pos);
+        }
+
+        samples.push_back(sample);
+    }
+
+    return (body.size() > pos);
+}
+
+/**
+ * Parse a JSON string. Escaped characters are unescaped, except \u sequences,
+ * which are kept as they are.
+ *
+ * @param[in]       str     JSON text
+ * @param[in,out]   pos     Position of the opening quote, afterwards behind the closing one.
+ * @param[out]      value   String value
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool parseString(const std::string& str, size_t& pos, std::string& value)
+{
+    if ((str.size() <= pos) || ('"' != str[pos]))
+    {
+        return false;
+    }
+
+    ++pos;
+    value.clear();
+
+    while(str.size() > pos)
+    {
+        char c = str[pos];
+
+        ++pos;
+
+        if ('"' == c)
+        {
+            return true;
+        }
+
+        if (('\\' == c) && (str.size() > pos))
+        {
+            c = str[pos];
+            ++pos;
+
+            switch(c)
+            {
+            case 'n':
+                c = '\n';
+                break;
+
+            case 't':
+                c = '\t';
+                break;
+
+            case 'r':
+                c = '\r';
+                break;
+
+            case 'u':
+                value += '\\';
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        value += c;
+    }
+
+    return false;
+}
+
+/**
+ * Skip white spaces.
+ *
+ * @param[in]       str JSON text
+ * @param[in,out]   pos Position
+ */
+static void skipSpaces(const std::string& str, size_t& pos)
+{
+    while((str.size() > pos) && (nullptr != strchr(" \t\r\n", str[pos])))
+    {
+        ++pos;
+    }
+
+    return;
+}
+
+/**
+ * Escape a tag value of the line protocol. Commas, equal signs and spaces
+ * are escaped with a backslash, line breaks are replaced by spaces.
+ *
+ * @param[in] str   Tag value
+ *
+ * @return Escaped tag value
+ */
+static std::string escapeTag(const std::string& str)
+{
+    std::string escaped;
+
+    for(char c : str)
+    {
+        if (('\r' == c) || ('\n' == c))
+        {
+            c = ' ';
+        }
+
+        if ((',' == c) || ('=' == c) || (' ' == c) || ('\\' == c))
+        {
+            escaped += '\\';
+        }
+
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+/**
+ * Print the command line usage.
+ *
+ * @param[in] prgName   Program name
+ */
+static void printUsage(const char* prgName)
+{
+    printf("Usage: %s [options]\n", prgName);
+    printf("  -d, --device NAME=HOST[:PORT] Polled device, can be given several times.\n");
+    printf("  -f, --devices FILE            File with one NAME=HOST[:PORT] per line.\n");
+    printf("  -u, --path PATH               Polled resource (default: /api/s0-interfaces).\n");
+    printf("  -i, --interval S              Poll interval in s (default: 10).\n");
+    printf("  -t, --timeout MS              Poll timeout in ms (default: 2000).\n");
+    printf("  -b, --max-backoff S           Max. retry delay in s of a failing device (default: 300).\n");
+    printf("  -j, --threads N               Number of worker threads (default: 1).\n");
+    printf("  -D, --duration S              Duration in s (default: till SIGINT or SIGTERM).\n");
+    printf("  -o, --out FILE                Append the samples to a file instead of stdout.\n");
+    printf("  -h, --help                    Show this help.\n");
+}
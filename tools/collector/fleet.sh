@@ -0,0 +1,63 @@
+#!/bin/sh
+# MIT License
+#
+# Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Runs the collector against a fleet of Linux builds of the firmware.
+# Every instance has its own EEPROM file and listens on port 8080 + index.
+#
+# Usage: fleet.sh NUM_DEVICES DURATION [COLLECTOR OPTIONS]
+#   e.g. tools/collector/fleet.sh 50 60 --interval 5 > samples.txt
+
+set -e
+
+NUM_DEVICES=${1:?Number of devices missing}
+DURATION=${2:?Duration in s missing}
+shift 2
+
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+PROGRAM=${PROGRAM:-$SCRIPT_DIR/../../.pio/build/linux/program}
+COLLECTOR=${COLLECTOR:-$SCRIPT_DIR/collector}
+WORK_DIR=$(mktemp -d)
+PIDS=""
+
+cleanup() {
+    for PID in $PIDS; do
+        kill "$PID" 2>/dev/null || true
+    done
+    wait 2>/dev/null || true
+    rm -rf "$WORK_DIR"
+}
+
+trap cleanup EXIT INT TERM
+
+IDX=0
+while [ "$IDX" -lt "$NUM_DEVICES" ]; do
+    "$PROGRAM" --port-offset $((8000 + IDX)) --eeprom "$WORK_DIR/eeprom$IDX.bin" > "$WORK_DIR/device$IDX.log" 2>&1 &
+    PIDS="$PIDS $!"
+    echo "device$IDX=127.0.0.1:$((8080 + IDX))" >> "$WORK_DIR/devices.txt"
+    IDX=$((IDX + 1))
+done
+
+# Give the instances time to start their web servers.
+sleep 1
+
+"$COLLECTOR" --devices "$WORK_DIR/devices.txt" --duration "$DURATION" "$@"
@@ -0,0 +1,48 @@
+# MIT License
+#
+# Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""PlatformIO pre-build script of the fuzz targets. It builds with clang and
+libFuzzer, together with the address and undefined behaviour sanitizers.
+Without clang, it falls back to gcc with the sanitizers and the standalone
+driver in fuzz/StandaloneMain.cpp, which replays and mutates a corpus.
+"""
+
+# pylint: disable=undefined-variable
+
+import shutil
+
+Import("env")
+
+SANITIZERS = "address,undefined"
+
+if shutil.which("clang++") is not None:
+    env.Replace(CC="clang", CXX="clang++")
+    FLAGS = ["-fsanitize=fuzzer," + SANITIZERS]
+else:
+    print("clang not found, the fuzz target is built with the standalone driver.")
+    env.Append(CPPDEFINES=["FUZZ_STANDALONE"])
+    FLAGS = ["-fsanitize=" + SANITIZERS]
+
+# A undefined behaviour shall stop the fuzzer like a crash.
+FLAGS += ["-fno-sanitize-recover=undefined", "-fno-omit-frame-pointer", "-g", "-O1"]
+
+env.Append(CCFLAGS=FLAGS, LINKFLAGS=FLAGS)
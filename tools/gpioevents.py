@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# MIT License
+#
+# Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""GPIO edge event generator.
+
+Stands in for a GPIO character device of the S0 gateway (gateway/). It writes
+the edge events of S0 pulses in the binary layout of the kernel
+(struct gpio_v2_line_event) with CLOCK_MONOTONIC timestamps to a named pipe
+or file, which is configured as event source of the gateway channels.
+
+Every line gets pulses of a constant power, a falling edge at the pulse start
+and a rising edge after the pulse width:
+    gpioevents.py events.fifo --lines 0-47 --power 2000 --duration 60
+
+At the end the number of pulses per line is printed as JSON line, to compare
+it with the pulses of GET /api/s0-interfaces.
+"""
+
+import argparse
+import heapq
+import json
+import os
+import struct
+import sys
+import time
+
+# struct gpio_v2_line_event: timestamp_ns, id, offset, seqno, line_seqno, padding[6]
+EVENT_FORMAT = "<QIIII24x"
+
+# Event ids of the GPIO v2 uAPI
+EVENT_RISING_EDGE = 1
+EVENT_FALLING_EDGE = 2
+
+
+def parse_lines(spec):
+    """Parse a list of line offsets, e.g. "0-3,8"."""
+    lines = []
+
+    for part in spec.split(","):
+        if "-" in part:
+            first, last = part.split("-", 1)
+            lines.extend(range(int(first), int(last) + 1))
+        else:
+            lines.append(int(part))
+
+    return lines
+
+
+def main():
+    """Generate the events."""
+    parser = argparse.ArgumentParser(description="GPIO edge event generator")
+    parser.add_argument("out", help="Named pipe or file, the event source of the gateway")
+    parser.add_argument("--lines", default="0", help="Line offsets, e.g. 0-47 (default: 0)")
+    parser.add_argument("--power", type=float, default=1000.0, help="Power in W per line (default: 1000)")
+    parser.add_argument("--pulses-per-kwh", type=int, default=1000, help="Pulses per kWh (default: 1000)")
+    parser.add_argument("--pulse-width", type=float, default=30.0, help="Pulse width in ms (default: 30)")
+    parser.add_argument("--duration", type=float, default=10.0, help="Duration in s (default: 10)")
+    args = parser.parse_args()
+
+    lines = parse_lines(args.lines)
+    period_ns = int(3600e9 / (args.power * args.pulses_per_kwh / 1000.0))
+    width_ns = int(args.pulse_width * 1e6)
+    start_ns = time.monotonic_ns()
+    end_ns = start_ns + int(args.duration * 1e9)
+    pulses = {line: 0 for line in lines}
+    line_seqnos = {line: 0 for line in lines}
+    seqno = 0
+
+    if not os.path.exists(args.out):
+        os.mkfifo(args.out)
+
+    # The pulses of the lines are spread over the period.
+    queue = [(start_ns + (period_ns * idx) // len(lines), EVENT_FALLING_EDGE, line) for idx, line in enumerate(lines)]
+    heapq.heapify(queue)
+
+    with open(args.out, "wb", buffering=0) as out:
+        while queue and queue[0][0] < end_ns:
+            timestamp_ns, event_id, line = heapq.heappop(queue)
+            delay = (timestamp_ns - time.monotonic_ns()) / 1e9
+
+            if delay > 0:
+                time.sleep(delay)
+
+            seqno += 1
+            line_seqnos[line] += 1
+            out.write(struct.pack(EVENT_FORMAT, timestamp_ns, event_id, line, seqno, line_seqnos[line]))
+
+            if event_id == EVENT_FALLING_EDGE:
+                pulses[line] += 1
+                heapq.heappush(queue, (timestamp_ns + width_ns, EVENT_RISING_EDGE, line))
+                heapq.heappush(queue, (timestamp_ns + period_ns, EVENT_FALLING_EDGE, line))
+
+    print(json.dumps({"lines": len(lines), "pulses": sum(pulses.values()), "perLine": pulses}))
+
+    return 0
+
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main())
+    except KeyboardInterrupt:
+        sys.exit(0)
@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+# MIT License
+#
+# Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""ISR trace host tool.
+
+The firmware, built with ISR_TRACE_ENABLED (default in debug builds), records
+every pin change interrupt of the S0 interfaces. This tool renders the binary
+dump of GET /api/diagnostics/trace as timeline, one line per interrupt.
+
+Render the trace directly from the device or from a saved dump:
+    isrtrace.py --url http://<device-ip-address>/api/diagnostics/trace
+    isrtrace.py --file trace.bin
+
+Export it additionally as value change dump, e.g. for GTKWave:
+    isrtrace.py --file trace.bin --vcd trace.vcd
+"""
+
+import argparse
+import struct
+import sys
+import urllib.request
+
+MAGIC = b"S0TR"
+VERSION = 1
+HEADER = struct.Struct("<4sBBHHBB")
+RECORD = struct.Struct("<IBB")
+NO_TRIGGER = 0xFFFF
+
+STATES = {0: "armed", 1: "triggered", 2: "frozen", 3: "frozen by anomaly"}
+
+# Arduino pin number of port A bit 0
+PIN_PORT_A_BIT0 = 24
+
+
+class TraceError(Exception):
+    """The trace dump is invalid."""
+
+
+def parse_trace(data):
+    """Parse a binary trace dump."""
+    if len(data) < HEADER.size:
+        raise TraceError("Trace dump is too short.")
+
+    magic, version, state, num_records, trigger_idx, pin_mask, trigger_mask = HEADER.unpack_from(data)
+
+    if magic != MAGIC:
+        raise TraceError("Not a trace dump.")
+
+    if version != VERSION:
+        raise TraceError(f"Unsupported trace dump version {version}.")
+
+    if len(data) < HEADER.size + num_records * RECORD.size:
+        raise TraceError("Trace dump is incomplete.")
+
+    records = []
+    for idx in range(num_records):
+        timestamp, pins, counted = RECORD.unpack_from(data, HEADER.size + idx * RECORD.size)
+        records.append({"timestamp": timestamp, "pins": pins, "counted": counted})
+
+    return {
+        "state": state,
+        "triggerIdx": trigger_idx,
+        "pinMask": pin_mask,
+        "triggerMask": trigger_mask,
+        "records": records,
+    }
+
+
+def bits(mask):
+    """Get the bit numbers of a mask."""
+    return [bit_no for bit_no in range(8) if mask & (1 << bit_no)]
+
+
+def render(trace, out):
+    """Render the trace as timeline."""
+    records = trace["records"]
+    channels = bits(trace["pinMask"])
+
+    print(f"State: {STATES.get(trace['state'], '?')}, {len(records)} records", file=out)
+
+    if trace["triggerIdx"] != NO_TRIGGER:
+        names = ", ".join(f"PA{bit_no}" for bit_no in bits(trace["triggerMask"]))
+        print(f"Anomaly: pulse period too short on {names}", file=out)
+
+    print("Legend: H high, L low, v counted falling edge, ! anomaly", file=out)
+    print("", file=out)
+
+    head = f"{'#':>4} {'time [ms]':>12} {'delta [ms]':>11}  PINA"
+    for bit_no in channels:
+        head += f"  PA{bit_no}(pin {PIN_PORT_A_BIT0 + bit_no})"
+    print(head, file=out)
+
+    # Timestamps are 32-bit microseconds, which wrap around after ~71 minutes.
+    first = records[0]["timestamp"] if records else 0
+    previous = first
+
+    for idx, record in enumerate(records):
+        time_us = (record["timestamp"] - first) & 0xFFFFFFFF
+        delta_us = (record["timestamp"] - previous) & 0xFFFFFFFF
+        previous = record["timestamp"]
+
+        line = f"{idx:>4} {time_us / 1000:>12.3f} {delta_us / 1000:>+11.3f}  0x{record['pins']:02x}"
+
+        for bit_no in channels:
+            level = "H" if record["pins"] & (1 << bit_no) else "L"
+            mark = "v" if record["counted"] & (1 << bit_no) else " "
+            line += f"  {level}{mark:<11}"
+
+        if idx == trace["triggerIdx"]:
+            line += " ! anomaly"
+
+        print(line.rstrip(), file=out)
+
+
+def write_vcd(trace, path):
+    """Write the trace as value change dump."""
+    records = trace["records"]
+    channels = bits(trace["pinMask"])
+    first = records[0]["timestamp"] if records else 0
+
+    with open(path, "w", encoding="utf-8") as file:
+        file.write("$timescale 1us $end\n")
+        file.write("$scope module porta $end\n")
+        for bit_no in channels:
+            file.write(f"$var wire 1 p{bit_no} PA{bit_no} $end\n")
+            file.write(f"$var wire 1 c{bit_no} PA{bit_no}_counted $end\n")
+        file.write("$upscope $end\n")
+        file.write("$enddefinitions $end\n")
+
+        for idx, record in enumerate(records):
+            file.write(f"#{(record['timestamp'] - first) & 0xFFFFFFFF}\n")
+            for bit_no in channels:
+                file.write(f"{1 if record['pins'] & (1 << bit_no) else 0}p{bit_no}\n")
+                file.write(f"{1 if record['counted'] & (1 << bit_no) else 0}c{bit_no}\n")
+
+            # The counted marker is a short pulse.
+            if idx + 1 < len(records):
+                file.write(f"#{((record['timestamp'] - first) & 0xFFFFFFFF) + 1}\n")
+                for bit_no in channels:
+                    file.write(f"0c{bit_no}\n")
+
+
+def main():
+    """Main entry point."""
+    parser = argparse.ArgumentParser(description="ISR trace host tool")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--url", help="Trace URL, e.g. http://<device>/api/diagnostics/trace")
+    source.add_argument("--file", help="Binary trace dump file")
+    parser.add_argument("--save", help="Save the binary trace dump to a file.")
+    parser.add_argument("--vcd", help="Export the trace as value change dump.")
+
+    args = parser.parse_args()
+
+    if args.url is not None:
+        with urllib.request.urlopen(args.url, timeout=10) as response:
+            data = response.read()
+    else:
+        with open(args.file, "rb") as file:
+            data = file.read()
+
+    if args.save is not None:
+        with open(args.save, "wb") as file:
+            file.write(data)
+
+    try:
+        trace = parse_trace(data)
+    except TraceError as error:
+        print(error, file=sys.stderr)
+        return 1
+
+    render(trace, sys.stdout)
+
+    if args.vcd is not None:
+        write_vcd(trace, args.vcd)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
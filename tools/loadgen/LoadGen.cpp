@@ -0,0 +1,1245 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP load generator and soak test of the firmware
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Drives the web server of the firmware with a configurable number of
+ * concurrent clients, request mix and rate. Every request uses its own
+ * connection, like the pollers in the field. Meanwhile S0 pulses are injected
+ * via the S0 input of the Linux build (--s0-input), which is a named pipe.
+ * At the end, the pulses counted by the firmware are compared with the
+ * injected ones, which must be exact.
+ *
+ * The results are written as JSON lines to stdout: one per report interval,
+ * one per request type and a summary. The latencies are kept in a histogram
+ * with about 1.5% resolution, therefore hours of soak need constant memory.
+ *
+ * If a rate is given, the latency is measured from the time the request was
+ * scheduled, not from the time it was sent. This way a stalled server isn't
+ * hidden by the clients, which wait for it (coordinated omission).
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Latency histogram with logarithmic buckets: every power of two is divided
+ * into linear sub-buckets.
+ */
+class Histogram
+{
+public:
+
+    /**
+     * Constructs a empty histogram.
+     */
+    Histogram() :
+        m_buckets(NUM_BUCKETS, 0U),
+        m_count(0U),
+        m_max(0U)
+    {
+    }
+
+    /**
+     * Destroys the histogram.
+     */
+    ~Histogram()
+    {
+    }
+
+    /**
+     * Add a value.
+     *
+     * @param[in] value Value in us
+     */
+    void add(uint64_t value)
+    {
+        ++m_buckets[toBucket(value)];
+        ++m_count;
+
+        if (m_max < value)
+        {
+            m_max = value;
+        }
+    }
+
+    /**
+     * Add all values of another histogram.
+     *
+     * @param[in] other Other histogram
+     */
+    void merge(const Histogram& other)
+    {
+        size_t idx = 0U;
+
+        for(idx = 0U; idx < NUM_BUCKETS; ++idx)
+        {
+            m_buckets[idx] += other.m_buckets[idx];
+        }
+
+        m_count += other.m_count;
+
+        if (m_max < other.m_max)
+        {
+            m_max = other.m_max;
+        }
+    }
+
+    /**
+     * Remove all values.
+     */
+    void clear(void)
+    {
+        std::fill(m_buckets.begin(), m_buckets.end(), 0U);
+        m_count = 0U;
+        m_max   = 0U;
+    }
+
+    /**
+     * Get a percentile. It is the upper bound of its bucket.
+     *
+     * @param[in] percent   Percentile in %
+     *
+     * @return Value in us
+     */
+    uint64_t getPercentile(double percent) const
+    {
+        uint64_t    rank    = static_cast<uint64_t>((percent / 100.0) * static_cast<double>(m_count) + 0.5);
+        uint64_t    sum     = 0U;
+        size_t      idx     = 0U;
+
+        if (0U == rank)
+        {
+            rank = 1U;
+        }
+
+        while((NUM_BUCKETS > idx) && (sum < rank))
+        {
+            sum += m_buckets[idx];
+            ++idx;
+        }
+
+        return (0U == m_count) ? 0U : std::min(fromBucket(idx), m_max);
+    }
+
+    /**
+     * Get the number of values.
+     *
+     * @return Number of values
+     */
+    uint64_t getCount(void) const
+    {
+        return m_count;
+    }
+
+    /**
+     * Get the max. value.
+     *
+     * @return Max. value in us
+     */
+    uint64_t getMax(void) const
+    {
+        return m_max;
+    }
+
+private:
+
+    /** Number of sub-buckets per power of two, as power of two. */
+    static const uint32_t   SUB_BITS    = 6U;
+
+    /** Number of buckets, which covers all 64-bit values. */
+    static const size_t     NUM_BUCKETS = (64U - SUB_BITS + 1U) << SUB_BITS;
+
+    std::vector<uint64_t>   m_buckets;  /**< Number of values per bucket */
+    uint64_t                m_count;    /**< Number of values */
+    uint64_t                m_max;      /**< Max. value */
+
+    /**
+     * Get the bucket of a value.
+     *
+     * @param[in] value Value
+     *
+     * @return Bucket index
+     */
+    static size_t toBucket(uint64_t value)
+    {
+        size_t bucket = 0U;
+
+        if ((1ULL << SUB_BITS) > value)
+        {
+            bucket = static_cast<size_t>(value);
+        }
+        else
+        {
+            uint32_t exponent = 63U - static_cast<uint32_t>(__builtin_clzll(value));
+            uint32_t shift    = exponent - SUB_BITS;
+
+            bucket = ((shift + 1U) << SUB_BITS) + static_cast<size_t>((value >> shift) & ((1ULL << SUB_BITS) - 1U));
+        }
+
+        return bucket;
+    }
+
+    /**
+     * Get the upper bound of the bucket before a bucket.
+     *
+     * @param[in] bucket    Bucket index, which follows the one of interest
+     *
+     * @return Value
+     */
+    static uint64_t fromBucket(size_t bucket)
+    {
+        uint64_t value = 0U;
+
+        if ((1U << SUB_BITS) >= bucket)
+        {
+            value = (0U < bucket) ? (bucket - 1U) : 0U;
+        }
+        else
+        {
+            uint32_t shift  = static_cast<uint32_t>(bucket >> SUB_BITS) - 1U;
+            uint64_t sub    = bucket & ((1U << SUB_BITS) - 1U);
+
+            /* Start of the next bucket minus 1 */
+            value = (((1ULL << SUB_BITS) + sub) << shift) - 1U;
+        }
+
+        return value;
+    }
+};
+
+/** Request types */
+enum RequestType
+{
+    REQ_ROOT = 0,           /**< GET / */
+    REQ_S0_INTERFACES,      /**< GET /api/s0-interfaces */
+    REQ_S0_INTERFACE,       /**< GET /api/s0-interface/0 */
+    REQ_CONFIG_GET,         /**< GET /api/config */
+    REQ_CONFIGURE_GET,      /**< GET /configure/0 */
+    REQ_CONFIGURE_POST,     /**< POST /configure/0, which doesn't change the configuration */
+    REQ_MAX                 /**< Number of request types */
+};
+
+/** Statistics of a request type. */
+struct RequestStats
+{
+    Histogram   latency;    /**< Latency of the successful requests */
+    uint64_t    errors;     /**< Number of failed requests */
+};
+
+/** Shared state of all clients. */
+struct Shared
+{
+    std::mutex                  mutex;                  /**< Protects the statistics */
+    RequestStats                total[REQ_MAX];         /**< Statistics of the whole run */
+    RequestStats                interval[REQ_MAX];      /**< Statistics of the current report interval */
+    std::atomic<bool>           isRunning;              /**< Clients and pulse generator are running */
+    std::atomic<uint64_t>       injected[8];            /**< Injected pulses per S0 port bit */
+};
+
+/** Configuration of the load generator. */
+struct Config
+{
+    std::string         host;                   /**< Server address */
+    uint16_t            port;                   /**< Server port */
+    uint32_t            concurrency;            /**< Number of concurrent clients */
+    double              rate;                   /**< Requests per second of all clients, 0 for max. */
+    uint32_t            weights[REQ_MAX];       /**< Request mix */
+    uint32_t            duration;               /**< Duration in s */
+    uint32_t            reportInterval;         /**< Report interval in s */
+    uint32_t            timeout;                /**< Request timeout in ms */
+    std::string         s0Input;                /**< S0 input of the firmware */
+    uint8_t             pinMask;                /**< S0 port bits with pulses */
+    double              pulseRate;              /**< Pulses per second and pin */
+    std::string         postBody;               /**< Body of POST /configure/0 */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint64_t getMicros(void);
+static void sleepUntil(uint64_t timestamp);
+static uint32_t nextRandom(uint32_t& state);
+static bool parseMix(const char* str, uint32_t* weights);
+static bool httpRequest(const Config& config, const std::string& request, std::string& body);
+static std::string buildRequest(const Config& config, RequestType type);
+static bool readPulses(const Config& config, std::vector<int>& pinOfId, std::vector<uint64_t>& pulses);
+static bool findUInt(const std::string& str, const char* key, size_t& pos, uint64_t& value);
+static std::string urlEncode(const std::string& str);
+static void runClient(const Config& config, Shared& shared, uint32_t clientId);
+static void runPulses(const Config& config, Shared& shared);
+static void printStats(const char* name, const RequestStats& stats, double seconds);
+static void printUsage(const char* prgName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Names of the request types, used in the request mix and the results. */
+static const char*  REQUEST_NAMES[REQ_MAX]  =
+{
+    "root",
+    "s0-interfaces",
+    "s0-interface",
+    "config-get",
+    "configure-get",
+    "configure-post"
+};
+
+/** Default request mix, like a few pollers and a user. */
+static const char*  DEFAULT_MIX             = "root=1,s0-interfaces=6,config-get=1,configure-get=1,configure-post=1";
+
+/** Time in ms, until the firmware applied all injected pulses. */
+static const uint32_t   SETTLE_TIME         = 500U;
+
+/** Arduino pin number of the S0 port bit 0, see S0Pin. */
+static const int        PIN_PORT_BIT0       = 24;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program entry point.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "host",           required_argument,  nullptr,    'a' },
+        { "port",           required_argument,  nullptr,    'p' },
+        { "concurrency",    required_argument,  nullptr,    'c' },
+        { "rate",           required_argument,  nullptr,    'r' },
+        { "mix",            required_argument,  nullptr,    'm' },
+        { "duration",       required_argument,  nullptr,    'd' },
+        { "report",         required_argument,  nullptr,    'i' },
+        { "timeout",        required_argument,  nullptr,    't' },
+        { "s0-input",       required_argument,  nullptr,    's' },
+        { "pins",           required_argument,  nullptr,    'P' },
+        { "pulse-rate",     required_argument,  nullptr,    'R' },
+        { "help",           no_argument,        nullptr,    'h' },
+        { nullptr,          0,                  nullptr,    0   }
+    };
+    Config                      config;
+    Shared                      shared;
+    std::vector<std::thread>    threads;
+    std::vector<int>            pinOfId;
+    std::vector<uint64_t>       pulsesBefore;
+    std::vector<uint64_t>       pulsesAfter;
+    std::string                 body;
+    bool                        isPulseCheck    = false;
+    bool                        isExact         = true;
+    uint64_t                    start           = 0U;
+    uint64_t                    nextReport      = 0U;
+    uint64_t                    intervalStart   = 0U;
+    uint64_t                    end             = 0U;
+    uint64_t                    totalRequests   = 0U;
+    uint64_t                    totalErrors     = 0U;
+    Histogram                   totalLatency;
+    uint32_t                    idx             = 0U;
+    int                         opt             = 0;
+
+    config.host             = "127.0.0.1";
+    config.port             = 8080U;
+    config.concurrency      = 4U;
+    config.rate             = 0.0;
+    config.duration         = 60U;
+    config.reportInterval   = 10U;
+    config.timeout          = 5000U;
+    config.pinMask          = 0x03U;
+    config.pulseRate        = 10.0;
+    (void)parseMix(DEFAULT_MIX, config.weights);
+
+    while(-1 != (opt = getopt_long(argc, argv, "a:p:c:r:m:d:i:t:s:P:R:h", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 'a':
+            config.host = optarg;
+            break;
+
+        case 'p':
+            config.port = static_cast<uint16_t>(strtoul(optarg, nullptr, 0));
+            break;
+
+        case 'c':
+            config.concurrency = strtoul(optarg, nullptr, 0);
+            break;
+
+        case 'r':
+            config.rate = strtod(optarg, nullptr);
+            break;
+
+        case 'm':
+            if (false == parseMix(optarg, config.weights))
+            {
+                fprintf(stderr, "Invalid request mix: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'd':
+            config.duration = strtoul(optarg, nullptr, 0);
+            break;
+
+        case 'i':
+            config.reportInterval = strtoul(optarg, nullptr, 0);
+            break;
+
+        case 't':
+            config.timeout = strtoul(optarg, nullptr, 0);
+            break;
+
+        case 's':
+            config.s0Input = optarg;
+            break;
+
+        case 'P':
+            config.pinMask = static_cast<uint8_t>(strtoul(optarg, nullptr, 0));
+            break;
+
+        case 'R':
+            config.pulseRate = strtod(optarg, nullptr);
+            break;
+
+        case 'h':
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+
+        default:
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((0U == config.concurrency) ||
+        (0U == config.reportInterval) ||
+        (0.0 > config.rate) ||
+        (0.0 >= config.pulseRate))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* A server, which closed the connection, shall not terminate the process. */
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    /* The form body contains the current name, so the configuration isn't changed. */
+    config.postBody = "name=";
+
+    if (true == httpRequest(config, buildRequest(config, REQ_CONFIG_GET), body))
+    {
+        size_t nameStart = body.find("\"name\":\"");
+
+        if (std::string::npos != nameStart)
+        {
+            size_t nameEnd = body.find('"', nameStart + 8U);
+
+            if (std::string::npos != nameEnd)
+            {
+                config.postBody += urlEncode(body.substr(nameStart + 8U, nameEnd - nameStart - 8U));
+            }
+        }
+    }
+    else
+    {
+        fprintf(stderr, "Server %s:%u doesn't respond.\n", config.host.c_str(), config.port);
+        return EXIT_FAILURE;
+    }
+
+    if (false == config.s0Input.empty())
+    {
+        isPulseCheck = readPulses(config, pinOfId, pulsesBefore);
+
+        if (false == isPulseCheck)
+        {
+            fprintf(stderr, "Failed to read the pulses of the S0 interfaces.\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    shared.isRunning = true;
+
+    for(idx = 0U; idx < 8U; ++idx)
+    {
+        shared.injected[idx] = 0U;
+    }
+
+    for(idx = 0U; idx < REQ_MAX; ++idx)
+    {
+        shared.total[idx].errors    = 0U;
+        shared.interval[idx].errors = 0U;
+    }
+
+    start           = getMicros();
+    intervalStart   = start;
+    nextReport      = start + config.reportInterval * 1000000ULL;
+    end             = start + config.duration * 1000000ULL;
+
+    for(idx = 0U; idx < config.concurrency; ++idx)
+    {
+        threads.push_back(std::thread(runClient, std::cref(config), std::ref(shared), idx));
+    }
+
+    if (true == isPulseCheck)
+    {
+        threads.push_back(std::thread(runPulses, std::cref(config), std::ref(shared)));
+    }
+
+    while(getMicros() < end)
+    {
+        uint64_t now = 0U;
+
+        sleepUntil(std::min(nextReport, end));
+        now = getMicros();
+
+        if (now >= nextReport)
+        {
+            Histogram   latency;
+            uint64_t    errors      = 0U;
+            double      seconds     = static_cast<double>(now - intervalStart) / 1000000.0;
+
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+
+                for(idx = 0U; idx < REQ_MAX; ++idx)
+                {
+                    latency.merge(shared.interval[idx].latency);
+                    errors += shared.interval[idx].errors;
+
+                    shared.interval[idx].latency.clear();
+                    shared.interval[idx].errors = 0U;
+                }
+            }
+
+            printf("{\"name\":\"interval\",\"elapsedS\":%.0f,\"requests\":%llu,\"rps\":%.1f,\"p50Us\":%llu,\"p99Us\":%llu,\"maxUs\":%llu,\"errors\":%llu}\n",
+                static_cast<double>(now - start) / 1000000.0,
+                static_cast<unsigned long long>(latency.getCount()),
+                static_cast<double>(latency.getCount()) / seconds,
+                static_cast<unsigned long long>(latency.getPercentile(50.0)),
+                static_cast<unsigned long long>(latency.getPercentile(99.0)),
+                static_cast<unsigned long long>(latency.getMax()),
+                static_cast<unsigned long long>(errors));
+            (void)fflush(stdout);
+
+            intervalStart   = now;
+            nextReport     += config.reportInterval * 1000000ULL;
+        }
+    }
+
+    shared.isRunning = false;
+
+    for(idx = 0U; idx < threads.size(); ++idx)
+    {
+        threads[idx].join();
+    }
+
+    for(idx = 0U; idx < REQ_MAX; ++idx)
+    {
+        if (0U < config.weights[idx])
+        {
+            std::string name = std::string("request.") + REQUEST_NAMES[idx];
+
+            printStats(name.c_str(), shared.total[idx], static_cast<double>(config.duration));
+        }
+
+        totalLatency.merge(shared.total[idx].latency);
+        totalErrors += shared.total[idx].errors;
+    }
+
+    totalRequests = totalLatency.getCount();
+
+    printf("{\"name\":\"summary\",\"durationS\":%u,\"concurrency\":%u,\"requests\":%llu,\"rps\":%.1f,\"p50Us\":%llu,\"p99Us\":%llu,\"maxUs\":%llu,\"errors\":%llu}\n",
+        config.duration,
+        config.concurrency,
+        static_cast<unsigned long long>(totalRequests),
+        static_cast<double>(totalRequests) / static_cast<double>(config.duration),
+        static_cast<unsigned long long>(totalLatency.getPercentile(50.0)),
+        static_cast<unsigned long long>(totalLatency.getPercentile(99.0)),
+        static_cast<unsigned long long>(totalLatency.getMax()),
+        static_cast<unsigned long long>(totalErrors));
+
+    if (true == isPulseCheck)
+    {
+        /* The firmware applies the injected pulses in its main loop. */
+        usleep(SETTLE_TIME * 1000U);
+
+        if (false == readPulses(config, pinOfId, pulsesAfter))
+        {
+            fprintf(stderr, "Failed to read the pulses of the S0 interfaces.\n");
+            return EXIT_FAILURE;
+        }
+
+        for(idx = 0U; idx < pinOfId.size(); ++idx)
+        {
+            int         bitNo       = pinOfId[idx] - PIN_PORT_BIT0;
+            uint64_t    injected    = 0U;
+            uint64_t    counted     = pulsesAfter[idx] - pulsesBefore[idx];
+
+            if ((0 > bitNo) || (8 <= bitNo))
+            {
+                continue;
+            }
+
+            injected = shared.injected[bitNo];
+
+            if (injected != counted)
+            {
+                isExact = false;
+            }
+
+            printf("{\"name\":\"pulses\",\"id\":%u,\"pin\":%d,\"injected\":%llu,\"counted\":%llu,\"isExact\":%s}\n",
+                idx,
+                pinOfId[idx],
+                static_cast<unsigned long long>(injected),
+                static_cast<unsigned long long>(counted),
+                (injected == counted) ? "true" : "false");
+        }
+    }
+
+    return (true == isExact) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the monotonic time.
+ *
+ * @return Time in us
+ */
+static uint64_t getMicros(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (static_cast<uint64_t>(ts.tv_sec) * 1000000ULL) + static_cast<uint64_t>(ts.tv_nsec / 1000);
+}
+
+/**
+ * Sleep until a point in time.
+ *
+ * @param[in] timestamp Monotonic time in us
+ */
+static void sleepUntil(uint64_t timestamp)
+{
+    uint64_t now = getMicros();
+
+    if (timestamp > now)
+    {
+        struct timespec ts;
+        uint64_t        delta = timestamp - now;
+
+        ts.tv_sec   = static_cast<time_t>(delta / 1000000ULL);
+        ts.tv_nsec  = static_cast<long>((delta % 1000000ULL) * 1000ULL);
+
+        (void)nanosleep(&ts, nullptr);
+    }
+
+    return;
+}
+
+/**
+ * Get the next pseudo random number (xorshift32).
+ *
+ * @param[in,out] state Generator state, must not be 0.
+ *
+ * @return Pseudo random number
+ */
+static uint32_t nextRandom(uint32_t& state)
+{
+    state ^= state << 13U;
+    state ^= state >> 17U;
+    state ^= state << 5U;
+
+    return state;
+}
+
+/**
+ * Parse the request mix, e.g. "root=1,s0-interfaces=8". Request types,
+ * which are not part of it, get the weight 0.
+ *
+ * @param[in]   str     Request mix
+ * @param[out]  weights Weight per request type
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool parseMix(const char* str, uint32_t* weights)
+{
+    std::string mix         = str;
+    size_t      pos         = 0U;
+    uint32_t    sum         = 0U;
+    uint32_t    idx         = 0U;
+    bool        isValid     = true;
+
+    for(idx = 0U; idx < REQ_MAX; ++idx)
+    {
+        weights[idx] = 0U;
+    }
+
+    while((true == isValid) && (mix.size() > pos))
+    {
+        size_t      end     = mix.find(',', pos);
+        std::string item    = mix.substr(pos, (std::string::npos == end) ? std::string::npos : (end - pos));
+        size_t      equal   = item.find('=');
+
+        isValid = false;
+
+        if (std::string::npos != equal)
+        {
+            for(idx = 0U; idx < REQ_MAX; ++idx)
+            {
+                if (item.substr(0U, equal) == REQUEST_NAMES[idx])
+                {
+                    weights[idx]    = strtoul(item.c_str() + equal + 1U, nullptr, 10);
+                    sum            += weights[idx];
+                    isValid         = true;
+                }
+            }
+        }
+
+        pos = (std::string::npos == end) ? mix.size() : (end + 1U);
+    }
+
+    return (true == isValid) && (0U < sum);
+}
+
+/**
+ * Send a HTTP request over a new connection and receive the response.
+ *
+ * @param[in]   config  Configuration
+ * @param[in]   request Raw HTTP request
+ * @param[out]  body    Response body
+ *
+ * @return If the response is complete and has the status 200, it will return true otherwise false.
+ */
+static bool httpRequest(const Config& config, const std::string& request, std::string& body)
+{
+    struct sockaddr_in  addr;
+    int                 fd              = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    int                 flag            = 1;
+    std::string         response;
+    size_t              sent            = 0U;
+    bool                isSuccessful    = false;
+    bool                isDone          = false;
+    uint64_t            deadline        = getMicros() + config.timeout * 1000ULL;
+
+    if (0 > fd)
+    {
+        return false;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons(config.port);
+
+    (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+    if ((1 != inet_pton(AF_INET, config.host.c_str(), &addr.sin_addr)) ||
+        (0 != connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr))))
+    {
+        (void)close(fd);
+        return false;
+    }
+
+    while(request.size() > sent)
+    {
+        ssize_t len = send(fd, request.data() + sent, request.size() - sent, 0);
+
+        if (0 >= len)
+        {
+            (void)close(fd);
+            return false;
+        }
+
+        sent += static_cast<size_t>(len);
+    }
+
+    /* The response is complete, if the server closes the connection or the
+     * body has the announced length.
+     */
+    while(false == isDone)
+    {
+        struct pollfd   pfd;
+        char            buffer[1024];
+        uint64_t        now         = getMicros();
+        ssize_t         len         = 0;
+        size_t          headerEnd   = 0U;
+        size_t          lengthPos   = 0U;
+
+        pfd.fd      = fd;
+        pfd.events  = POLLIN;
+
+        if ((now >= deadline) ||
+            (0 >= poll(&pfd, 1U, static_cast<int>((deadline - now + 999U) / 1000U))))
+        {
+            break;
+        }
+
+        len = recv(fd, buffer, sizeof(buffer), 0);
+
+        if (0 > len)
+        {
+            break;
+        }
+        else if (0 == len)
+        {
+            isDone = true;
+        }
+        else
+        {
+            response.append(buffer, static_cast<size_t>(len));
+        }
+
+        headerEnd = response.find("\r\n\r\n");
+        lengthPos = response.find("Content-Length:");
+
+        if ((std::string::npos != headerEnd) &&
+            (std::string::npos != lengthPos) &&
+            (headerEnd > lengthPos))
+        {
+            size_t contentLength = strtoul(response.c_str() + lengthPos + 15U, nullptr, 10);
+
+            if ((headerEnd + 4U + contentLength) <= response.size())
+            {
+                isDone = true;
+            }
+        }
+
+        if ((true == isDone) &&
+            (std::string::npos != headerEnd))
+        {
+            isSuccessful    = (0 == response.compare(0U, 12U, "HTTP/1.1 200")) ||
+                              (0 == response.compare(0U, 12U, "HTTP/1.0 200"));
+            body            = response.substr(headerEnd + 4U);
+        }
+    }
+
+    (void)close(fd);
+
+    return isSuccessful;
+}
+
+/**
+ * Build a raw HTTP request.
+ *
+ * @param[in] config    Configuration
+ * @param[in] type      Request type
+ *
+ * @return Raw HTTP request
+ */
+static std::string buildRequest(const Config& config, RequestType type)
+{
+    static const char*  URIS[REQ_MAX]   =
+    {
+        "/",
+        "/api/s0-interfaces",
+        "/api/s0-interface/0",
+        "/api/config",
+        "/configure/0",
+        "/configure/0"
+    };
+    std::string         request;
+
+    request  = (REQ_CONFIGURE_POST == type) ? "POST " : "GET ";
+    request += URIS[type];
+    request += " HTTP/1.1\r\nHost: ";
+    request += config.host;
+    request += "\r\nConnection: close\r\n";
+
+    if (REQ_CONFIGURE_POST == type)
+    {
+        request += "Content-Type: application/x-www-form-urlencoded\r\nContent-Length: ";
+        request += std::to_string(config.postBody.size());
+        request += "\r\n\r\n";
+        request += config.postBody;
+    }
+    else
+    {
+        request += "\r\n";
+    }
+
+    return request;
+}
+
+/**
+ * Read the pin of every S0 interface from the configuration and the counted
+ * pulses of the enabled ones. A disabled interface gets the pin -1.
+ *
+ * @param[in]   config  Configuration
+ * @param[out]  pinOfId Arduino pin per S0 interface id
+ * @param[out]  pulses  Counted pulses per S0 interface id
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool readPulses(const Config& config, std::vector<int>& pinOfId, std::vector<uint64_t>& pulses)
+{
+    std::string body;
+    size_t      pos     = 0U;
+    uint64_t    value   = 0U;
+
+    if (false == httpRequest(config, buildRequest(config, REQ_CONFIG_GET), body))
+    {
+        return false;
+    }
+
+    pinOfId.clear();
+
+    pos = body.find("\"s0Interfaces\"");
+
+    while((std::string::npos != pos) &&
+          (true == findUInt(body, "\"pinS0\":", pos, value)))
+    {
+        size_t enabledPos = body.rfind("\"isEnabled\":", pos);
+
+        if ((std::string::npos != enabledPos) &&
+            (0 == body.compare(enabledPos + 12U, 4U, "true")))
+        {
+            pinOfId.push_back(static_cast<int>(value));
+        }
+        else
+        {
+            pinOfId.push_back(-1);
+        }
+    }
+
+    if (false == httpRequest(config, buildRequest(config, REQ_S0_INTERFACES), body))
+    {
+        return false;
+    }
+
+    pulses.assign(pinOfId.size(), 0U);
+    pos = 0U;
+
+    /* Only the enabled S0 interfaces are part of the response. */
+    while(true == findUInt(body, "\"id\":", pos, value))
+    {
+        size_t      id      = static_cast<size_t>(value);
+        uint64_t    count   = 0U;
+
+        if (false == findUInt(body, "\"pulses\":", pos, count))
+        {
+            return false;
+        }
+
+        if (pulses.size() > id)
+        {
+            pulses[id] = count;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Find the next unsigned integer value of a JSON key.
+ *
+ * @param[in]       str     JSON document
+ * @param[in]       key     Key incl. quotes and colon
+ * @param[in,out]   pos     Search start, behind the value afterwards
+ * @param[out]      value   Value
+ *
+ * @return If found, it will return true otherwise false.
+ */
+static bool findUInt(const std::string& str, const char* key, size_t& pos, uint64_t& value)
+{
+    size_t  keyPos  = str.find(key, pos);
+    char*   end     = nullptr;
+
+    if (std::string::npos == keyPos)
+    {
+        return false;
+    }
+
+    value   = strtoull(str.c_str() + keyPos + strlen(key), &end, 10);
+    pos     = static_cast<size_t>(end - str.c_str());
+
+    return true;
+}
+
+/**
+ * Encode a string for a application/x-www-form-urlencoded body.
+ *
+ * @param[in] str   String
+ *
+ * @return Encoded string
+ */
+static std::string urlEncode(const std::string& str)
+{
+    static const char   HEX[]   = "0123456789ABCDEF";
+    std::string         result;
+    size_t              idx     = 0U;
+
+    for(idx = 0U; idx < str.size(); ++idx)
+    {
+        uint8_t data = static_cast<uint8_t>(str[idx]);
+
+        if ((0 != isalnum(data)) || ('-' == data) || ('_' == data) || ('.' == data))
+        {
+            result += static_cast<char>(data);
+        }
+        else
+        {
+            result += '%';
+            result += HEX[data >> 4U];
+            result += HEX[data & 0x0FU];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Client, which sends requests until the load generator stops.
+ *
+ * @param[in]       config      Configuration
+ * @param[in,out]   shared      Shared state
+ * @param[in]       clientId    Client id
+ */
+static void runClient(const Config& config, Shared& shared, uint32_t clientId)
+{
+    std::string requests[REQ_MAX];
+    std::string body;
+    uint32_t    state       = 0x9E3779B9U ^ (clientId * 0x85EBCA6BU);
+    uint32_t    sum         = 0U;
+    uint64_t    period      = 0U;
+    uint64_t    next        = getMicros();
+    uint32_t    idx         = 0U;
+
+    if (0U == state)
+    {
+        state = 1U;
+    }
+
+    for(idx = 0U; idx < REQ_MAX; ++idx)
+    {
+        requests[idx]   = buildRequest(config, static_cast<RequestType>(idx));
+        sum            += config.weights[idx];
+    }
+
+    if (0.0 < config.rate)
+    {
+        period  = static_cast<uint64_t>((1000000.0 * config.concurrency) / config.rate);
+
+        /* Spread the clients over the period. */
+        next   += (period * clientId) / config.concurrency;
+    }
+
+    while(true == shared.isRunning)
+    {
+        uint32_t    random  = nextRandom(state) % sum;
+        uint32_t    type    = 0U;
+        uint64_t    start   = 0U;
+        bool        isOk    = false;
+
+        while(random >= config.weights[type])
+        {
+            random -= config.weights[type];
+            ++type;
+        }
+
+        if (0U < period)
+        {
+            sleepUntil(next);
+            start   = next;
+            next   += period;
+        }
+        else
+        {
+            start = getMicros();
+        }
+
+        isOk = httpRequest(config, requests[type], body);
+
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            if (true == isOk)
+            {
+                uint64_t latency = getMicros() - start;
+
+                shared.total[type].latency.add(latency);
+                shared.interval[type].latency.add(latency);
+            }
+            else
+            {
+                ++shared.total[type].errors;
+                ++shared.interval[type].errors;
+            }
+        }
+    }
+
+    return;
+}
+
+/**
+ * Pulse generator, which writes the S0 port values into the S0 input of the
+ * firmware. A pulse is low for half the period on all pins of the mask.
+ *
+ * @param[in]       config  Configuration
+ * @param[in,out]   shared  Shared state
+ */
+static void runPulses(const Config& config, Shared& shared)
+{
+    int         fd      = open(config.s0Input.c_str(), O_WRONLY | O_CLOEXEC);
+    uint64_t    period  = static_cast<uint64_t>(1000000.0 / config.pulseRate);
+    uint64_t    next    = getMicros();
+    uint8_t     low     = static_cast<uint8_t>(~config.pinMask);
+    uint8_t     high    = 0xFFU;
+    uint8_t     bitNo   = 0U;
+
+    if (0 > fd)
+    {
+        perror(config.s0Input.c_str());
+        return;
+    }
+
+    while(true == shared.isRunning)
+    {
+        sleepUntil(next);
+
+        /* Only a written falling edge is counted as injected. */
+        if (1 == write(fd, &low, 1U))
+        {
+            for(bitNo = 0U; bitNo < 8U; ++bitNo)
+            {
+                if (0U != (config.pinMask & (1U << bitNo)))
+                {
+                    ++shared.injected[bitNo];
+                }
+            }
+        }
+
+        sleepUntil(next + period / 2U);
+
+        /* The rising edge must never be lost, otherwise the next falling one is. */
+        while(1 != write(fd, &high, 1U))
+        {
+            if (EINTR != errno)
+            {
+                perror(config.s0Input.c_str());
+                shared.isRunning = false;
+                break;
+            }
+        }
+
+        next += period;
+    }
+
+    (void)close(fd);
+
+    return;
+}
+
+/**
+ * Print the statistics of a request type as JSON line.
+ *
+ * @param[in] name      Name
+ * @param[in] stats     Statistics
+ * @param[in] seconds   Duration in s
+ */
+static void printStats(const char* name, const RequestStats& stats, double seconds)
+{
+    printf("{\"name\":\"%s\",\"requests\":%llu,\"rps\":%.1f,\"p50Us\":%llu,\"p99Us\":%llu,\"maxUs\":%llu,\"errors\":%llu}\n",
+        name,
+        static_cast<unsigned long long>(stats.latency.getCount()),
+        static_cast<double>(stats.latency.getCount()) / seconds,
+        static_cast<unsigned long long>(stats.latency.getPercentile(50.0)),
+        static_cast<unsigned long long>(stats.latency.getPercentile(99.0)),
+        static_cast<unsigned long long>(stats.latency.getMax()),
+        static_cast<unsigned long long>(stats.errors));
+
+    return;
+}
+
+/**
+ * Print the command line usage.
+ *
+ * @param[in] prgName   Program name
+ */
+static void printUsage(const char* prgName)
+{
+    printf("Usage: %s [options]\n", prgName);
+    printf("  -a, --host ADDR       Server IPv4 address (default: 127.0.0.1).\n");
+    printf("  -p, --port N          Server port (default: 8080).\n");
+    printf("  -c, --concurrency N   Number of concurrent clients (default: 4).\n");
+    printf("  -r, --rate N          Requests per second of all clients, 0 for max. (default: 0).\n");
+    printf("  -m, --mix MIX         Request mix with weights (default: %s).\n", DEFAULT_MIX);
+    printf("                        Request types: root, s0-interfaces, s0-interface, config-get,\n");
+    printf("                        configure-get, configure-post.\n");
+    printf("  -d, --duration S      Duration in s (default: 60).\n");
+    printf("  -i, --report S        Report interval in s (default: 10).\n");
+    printf("  -t, --timeout MS      Request timeout in ms (default: 5000).\n");
+    printf("  -s, --s0-input FILE   S0 input of the firmware, enables the pulse injection.\n");
+    printf("  -P, --pins MASK       S0 port bits with pulses (default: 0x03).\n");
+    printf("  -R, --pulse-rate N    Pulses per second and pin (default: 10).\n");
+    printf("  -h, --help            Show this help.\n");
+}
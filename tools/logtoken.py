@@ -0,0 +1,358 @@
+#!/usr/bin/env python3
+# MIT License
+#
+# Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""Tokenized logging host tool.
+
+The firmware, built with LOGGING_TOKENIZED=1, identifies every log call site
+only by its token. On the serial interface it sends binary log frames and via
+REST API (/api/log) the log records contain the token instead of the message.
+This tool creates the token table from the sources and decodes the log records
+with it.
+
+Create the token table:
+    logtoken.py table --src src --out logtokens.json
+
+Decode a capture or a serial port (requires pyserial):
+    logtoken.py decode --table logtokens.json --file capture.bin
+    logtoken.py decode --table logtokens.json --port /dev/ttyUSB0
+
+Decode the log records, which are kept in RAM of the device:
+    logtoken.py decode --table logtokens.json --url http://192.168.0.2/api/log
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+import urllib.request
+
+FNV_OFFSET = 2166136261
+FNV_PRIME = 16777619
+
+FRAME_SYNC = 0xA5
+FRAME_FLAG_VALUE = 0x10
+FRAME_FLAG_TEXT = 0x20
+FRAME_FLAG_DROPPED = 0x40
+
+LOG_TYPES = {0x01: "DEBUG", 0x02: "INFO", 0x04: "ERROR", 0x08: "FATAL"}
+
+SOURCE_EXTENSIONS = (".c", ".cpp", ".h", ".hpp")
+
+LOG_CALL = re.compile(r"\bLOG_(DEBUG|INFO|ERROR|FATAL)(_VAL)?\s*\(")
+LITERAL = re.compile(r'^(?:F\s*\(\s*)?"((?:[^"\\]|\\.)*)"\s*\)?$')
+
+
+def fnv1a(data, hash_value=FNV_OFFSET):
+    """Calculate the 32-bit FNV-1a hash, like Logging::fnv1a()."""
+    for byte in data:
+        hash_value = ((hash_value ^ byte) * FNV_PRIME) & 0xFFFFFFFF
+    return hash_value
+
+
+def make_token(file_name, line):
+    """Calculate the token of a log call site, like Logging::makeToken()."""
+    hash_value = fnv1a(os.path.basename(file_name).encode("utf-8"))
+    hash_value = ((hash_value ^ (line & 0xFF)) * FNV_PRIME) & 0xFFFFFFFF
+    hash_value = ((hash_value ^ ((line >> 8) & 0xFF)) * FNV_PRIME) & 0xFFFFFFFF
+    token = (hash_value >> 16) ^ (hash_value & 0xFFFF)
+    return 1 if token == 0 else token
+
+
+def first_argument(text, pos):
+    """Get the first macro argument, starting after the opening brace."""
+    depth = 0
+    in_string = False
+    escaped = False
+    start = pos
+
+    while pos < len(text):
+        char = text[pos]
+        if in_string:
+            if escaped:
+                escaped = False
+            elif char == "\\":
+                escaped = True
+            elif char == '"':
+                in_string = False
+        elif char == '"':
+            in_string = True
+        elif char == "(":
+            depth += 1
+        elif char == ")":
+            if depth == 0:
+                break
+            depth -= 1
+        elif char == "," and depth == 0:
+            break
+        pos += 1
+
+    return text[start:pos].strip()
+
+
+def scan_file(path):
+    """Find all log call sites in a source file."""
+    sites = []
+
+    with open(path, "r", encoding="utf-8", errors="replace") as file:
+        text = file.read()
+
+    for match in LOG_CALL.finditer(text):
+        line_start = text.rfind("\n", 0, match.start()) + 1
+        prefix = text[line_start:match.start()].strip()
+
+        # Skip the macro definitions and comments.
+        if prefix.startswith("#") or prefix.startswith("*") or prefix.startswith("//"):
+            continue
+
+        line = text.count("\n", 0, match.start()) + 1
+        argument = first_argument(text, match.end())
+        literal = LITERAL.match(argument)
+
+        sites.append({
+            "file": os.path.basename(path),
+            "line": line,
+            "type": match.group(1),
+            "msg": bytes(literal.group(1), "utf-8").decode("unicode_escape") if literal else argument,
+            "dynamic": literal is None
+        })
+
+    return sites
+
+
+def create_table(src_dirs):
+    """Create the token table of all sources. Token collisions are errors."""
+    table = {}
+    errors = []
+
+    for src_dir in src_dirs:
+        for root, _, files in os.walk(src_dir):
+            for name in sorted(files):
+                if not name.endswith(SOURCE_EXTENSIONS):
+                    continue
+
+                for site in scan_file(os.path.join(root, name)):
+                    token = make_token(site["file"], site["line"])
+                    other = table.get(str(token))
+
+                    if other is not None and (other["file"], other["line"]) != (site["file"], site["line"]):
+                        errors.append("Token collision 0x%04x: %s:%d and %s:%d" %
+                                      (token, other["file"], other["line"], site["file"], site["line"]))
+                    table[str(token)] = site
+
+    return table, errors
+
+
+def read_frames(stream):
+    """Read log frames from a binary stream. Resynchronizes on corrupt data."""
+    buffer = bytearray()
+
+    while True:
+        data = stream.read(1)
+        if not data:
+            break
+        buffer += data
+
+        while buffer:
+            if buffer[0] != FRAME_SYNC:
+                del buffer[0]
+                continue
+
+            frame = parse_frame(buffer)
+            if frame is None:
+                # Incomplete, wait for more data.
+                break
+            if frame is False:
+                # Corrupt, skip the sync byte.
+                del buffer[0]
+                continue
+
+            size, record = frame
+            del buffer[:size]
+            yield record
+
+
+def parse_frame(buffer):
+    """Parse a single frame, which starts with the sync byte.
+
+    Returns None if incomplete, False if corrupt, otherwise (size, record).
+    """
+    if len(buffer) < 9:
+        return None
+
+    flags = buffer[1]
+    token, timestamp = struct.unpack_from("<HI", buffer, 2)
+    pos = 8
+    value = None
+    text = None
+
+    if (flags & 0x0F) not in LOG_TYPES and 0 == (flags & FRAME_FLAG_DROPPED):
+        return False
+
+    if flags & FRAME_FLAG_VALUE:
+        if len(buffer) < pos + 4:
+            return None
+        value = struct.unpack_from("<i", buffer, pos)[0]
+        pos += 4
+
+    if flags & FRAME_FLAG_TEXT:
+        if len(buffer) < pos + 1:
+            return None
+        text_len = buffer[pos]
+        pos += 1
+        if len(buffer) < pos + text_len:
+            return None
+        text = bytes(buffer[pos:pos + text_len]).decode("utf-8", errors="replace")
+        pos += text_len
+
+    if len(buffer) < pos + 1:
+        return None
+
+    checksum = 0
+    for byte in buffer[1:pos]:
+        checksum ^= byte
+
+    if checksum != buffer[pos]:
+        return False
+
+    return pos + 1, {
+        "flags": flags,
+        "token": token,
+        "timestamp": timestamp,
+        "value": value,
+        "text": text
+    }
+
+
+def format_record(record, table):
+    """Format a decoded record like the text logging does."""
+    seconds = record["timestamp"] // 1000
+
+    if record["flags"] & FRAME_FLAG_DROPPED:
+        return "%u Logging: %d records dropped." % (seconds, record["value"])
+
+    site = table.get(str(record["token"]))
+    log_type = LOG_TYPES.get(record["flags"] & 0x0F, "?")
+
+    if site is None:
+        location = "? (token 0x%04x)" % record["token"]
+        msg = ""
+    else:
+        location = "%s (%d)" % (site["file"], site["line"])
+        msg = "" if site["dynamic"] else site["msg"]
+
+    if record["text"] is not None:
+        msg = record["text"]
+
+    if record["value"] is not None:
+        msg += " %d" % record["value"]
+
+    return "%u %s - %s: %s" % (seconds, location, log_type, msg)
+
+
+def read_records(url):
+    """Get the log records via REST API and convert them to decoded frames."""
+    log_types = {name: flags for flags, name in LOG_TYPES.items()}
+
+    with urllib.request.urlopen(url, timeout=10) as response:
+        data = json.load(response)["data"]
+
+    for record in data["records"]:
+        yield {
+            "flags": log_types.get(record["type"], 0),
+            "token": record["token"],
+            "timestamp": record["timestamp"],
+            "value": record.get("value"),
+            "text": record.get("msg")
+        }
+
+
+def cmd_table(args):
+    """Create the token table."""
+    table, errors = create_table(args.src)
+
+    for error in errors:
+        print(error, file=sys.stderr)
+
+    with open(args.out, "w", encoding="utf-8") as file:
+        json.dump({"version": 1, "tokens": table}, file, indent=2, sort_keys=True)
+
+    return 1 if errors else 0
+
+
+def cmd_decode(args):
+    """Decode log frames."""
+    with open(args.table, "r", encoding="utf-8") as file:
+        table = json.load(file)["tokens"]
+
+    if args.url is not None:
+        for record in read_records(args.url):
+            print(format_record(record, table), flush=True)
+
+        return 0
+
+    if args.port is not None:
+        import serial  # pylint: disable=import-outside-toplevel
+        stream = serial.Serial(args.port, args.baudrate)
+    elif args.file is not None:
+        stream = open(args.file, "rb")  # pylint: disable=consider-using-with
+    else:
+        stream = sys.stdin.buffer
+
+    try:
+        for record in read_frames(stream):
+            print(format_record(record, table), flush=True)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        stream.close()
+
+    return 0
+
+
+def main():
+    """Main entry point."""
+    parser = argparse.ArgumentParser(description="Tokenized logging host tool")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    parser_table = subparsers.add_parser("table", help="Create the token table from the sources.")
+    parser_table.add_argument("--src", nargs="+", default=["src"], help="Source directories")
+    parser_table.add_argument("--out", default="logtokens.json", help="Token table file")
+    parser_table.set_defaults(func=cmd_table)
+
+    parser_decode = subparsers.add_parser("decode", help="Decode log frames.")
+    parser_decode.add_argument("--table", required=True, help="Token table file")
+    parser_decode.add_argument("--file", help="Binary capture file, default is stdin.")
+    parser_decode.add_argument("--port", help="Serial port")
+    parser_decode.add_argument("--baudrate", type=int, default=115200, help="Serial baudrate")
+    parser_decode.add_argument("--url", help="REST API URL of the log records, e.g. http://<ip>/api/log")
+    parser_decode.set_defaults(func=cmd_decode)
+
+    args = parser.parse_args()
+
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
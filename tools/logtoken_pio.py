@@ -0,0 +1,74 @@
+# MIT License
+#
+# Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""PlatformIO pre-build script, which creates the token table of the
+tokenized logging in the build directory. A token collision fails the build.
+Builds without LOGGING_TOKENIZED=1 in the build flags are not affected.
+"""
+
+# pylint: disable=undefined-variable
+
+import json
+import os
+import sys
+
+Import("env")
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "tools"))
+
+from logtoken import create_table  # pylint: disable=wrong-import-position
+
+
+
+def is_tokenized(defines):
+    """Is the tokenized logging enabled by the preprocessor definitions?"""
+    for define in defines:
+        if isinstance(define, (list, tuple)):
+            name, value = define[0], define[1] if 1 < len(define) else None
+        else:
+            name, _, value = str(define).partition("=")
+
+        if "LOGGING_TOKENIZED" == name and str(value).strip("()") not in ("", "0", "None"):
+            return True
+
+    return False
+
+
+DEFINES = list(env.get("CPPDEFINES", [])) + \
+    list(env.ParseFlags(env.get("BUILD_FLAGS", [])).get("CPPDEFINES", []))
+
+if is_tokenized(DEFINES):
+    TABLE, ERRORS = create_table([env.subst("$PROJECT_SRC_DIR")])
+
+    for error in ERRORS:
+        print(error)
+
+    if ERRORS:
+        env.Exit(1)
+
+    BUILD_DIR = env.subst("$BUILD_DIR")
+
+    if not os.path.isdir(BUILD_DIR):
+        os.makedirs(BUILD_DIR)
+
+    with open(os.path.join(BUILD_DIR, "logtokens.json"), "w", encoding="utf-8") as file:
+        json.dump({"version": 1, "tokens": TABLE}, file, indent=2, sort_keys=True)
@@ -0,0 +1,381 @@
+#!/usr/bin/env python3
+# MIT License
+#
+# Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""Pulse trace host tool.
+
+A pulse trace is a compact binary recording of the S0 pulses of all S0
+interfaces, see lib/Test/PulseTrace.h for the format. It is used for
+regression tests of the power estimation with real meters.
+
+Capture a trace from the pulse log of a device (GET /api/pulses), e.g. for
+one day. The firmware must be built with PULSE_LOG_ENABLED=1. Records, which
+were lost between two polls, are marked as gap:
+    pulsetrace.py capture --url http://<device-ip-address> --out day.s0pt --duration 86400
+
+Show a summary of a trace:
+    pulsetrace.py info day.s0pt
+
+Replay a trace in real time (or faster) into the S0 input of the Linux build.
+With the URL of the Linux build, the pulses counted by the firmware are
+compared with the ones of the trace:
+    pulsetrace.py replay day.s0pt --s0-input s0.fifo --url http://127.0.0.1:8080 --speed 10
+
+The replay as fast as possible, which rates the power estimation, is done by
+the replay environment, see README.md.
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+import time
+import urllib.request
+
+MAGIC = b"S0PT"
+VERSION = 1
+MAX_CHANNELS = 8
+CODE_BITS = 4
+CODE_GAP = 15
+
+# Arduino pin number of port A bit 0
+PIN_PORT_A_BIT0 = 24
+
+# Value of the S0 port without pulse, the inputs have pull-ups.
+PORT_IDLE = 0xFF
+
+# Number of ms of the device clock, till it wraps around.
+MILLIS_RANGE = 1 << 32
+
+
+class TraceError(Exception):
+    """The trace is invalid."""
+
+
+class TraceWriter:
+    """Writes a pulse trace."""
+
+    def __init__(self, file, pulses_per_kwh):
+        if not 1 <= len(pulses_per_kwh) <= MAX_CHANNELS:
+            raise TraceError("Invalid number of channels.")
+
+        self._file = file
+        self._num_channels = len(pulses_per_kwh)
+        self._time = 0
+
+        header = MAGIC + struct.pack("<BB", VERSION, self._num_channels)
+        header += b"".join(struct.pack("<H", value) for value in pulses_per_kwh)
+        self._file.write(header)
+
+    def append(self, record_time, code):
+        """Append a record with the time in ms since the start of the trace."""
+        if record_time < self._time:
+            raise TraceError("Records must be in chronological order.")
+
+        if code >= self._num_channels and code != CODE_GAP:
+            raise TraceError(f"Invalid channel {code}.")
+
+        value = ((record_time - self._time) << CODE_BITS) | code
+        self._time = record_time
+
+        data = bytearray()
+        while value >= 0x80:
+            data.append((value & 0x7F) | 0x80)
+            value >>= 7
+        data.append(value)
+
+        self._file.write(data)
+
+
+def read_trace(data):
+    """Read a pulse trace. Returns the pulses per kWh of every channel and the records (time, code)."""
+    if len(data) < len(MAGIC) + 2 or data[:len(MAGIC)] != MAGIC:
+        raise TraceError("Not a pulse trace.")
+
+    version, num_channels = struct.unpack_from("<BB", data, len(MAGIC))
+
+    if version != VERSION:
+        raise TraceError(f"Unsupported pulse trace version {version}.")
+
+    pos = len(MAGIC) + 2
+
+    if not 1 <= num_channels <= MAX_CHANNELS or len(data) < pos + 2 * num_channels:
+        raise TraceError("Invalid pulse trace header.")
+
+    pulses_per_kwh = list(struct.unpack_from(f"<{num_channels}H", data, pos))
+    pos += 2 * num_channels
+
+    records = []
+    record_time = 0
+    while pos < len(data):
+        value = 0
+        shift = 0
+        while True:
+            if pos >= len(data):
+                raise TraceError("The pulse trace is truncated.")
+            byte = data[pos]
+            pos += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if byte < 0x80:
+                break
+
+        code = value & ((1 << CODE_BITS) - 1)
+        if code >= num_channels and code != CODE_GAP:
+            raise TraceError(f"Invalid channel {code}.")
+
+        record_time += value >> CODE_BITS
+        records.append((record_time, code))
+
+    return pulses_per_kwh, records
+
+
+def get_json(url):
+    """Get a JSON response."""
+    with urllib.request.urlopen(url, timeout=10) as response:
+        return json.loads(response.read().decode("utf-8"))
+
+
+def millis_diff(later, earlier):
+    """Signed difference in ms of two timestamps of the device clock, which wraps around."""
+    return (later - earlier + MILLIS_RANGE // 2) % MILLIS_RANGE - MILLIS_RANGE // 2
+
+
+def capture(args):
+    """Capture a pulse trace from the pulse log of a device."""
+    base_url = args.url.rstrip("/")
+    interfaces = get_json(base_url + "/api/config")["data"]["s0Interfaces"]
+    pulses_per_kwh = [min(max(interface["pulsesPerKWH"], 1), 0xFFFF) for interface in interfaces]
+
+    since = None
+    # Device timestamp and trace time in ms, which correspond to each other.
+    base = None
+    # Trace time minus host time in ms, to continue the trace after a restart of the device.
+    host_offset = None
+    trace_time = 0
+    is_gap = False
+    start = time.monotonic()
+    num_pulses = 0
+    num_gaps = 0
+
+    with open(args.out, "wb") as file:
+        writer = TraceWriter(file, pulses_per_kwh)
+
+        while args.duration is None or time.monotonic() - start < args.duration:
+            poll_start = time.monotonic()
+            url = base_url + "/api/pulses" + ("" if since is None else f"?since={since}")
+
+            try:
+                data = get_json(url)["data"]
+                host_ms = int((time.monotonic() - start) * 1000)
+
+                if since is not None and data["next"] < since:
+                    # The device restarted, its clock and sequence numbers start again.
+                    base = None
+                    since = 0
+                    data = get_json(base_url + "/api/pulses?since=0")["data"]
+            except (OSError, ValueError, KeyError) as error:
+                print(f"Poll failed: {error}", file=sys.stderr)
+                time.sleep(args.interval)
+                continue
+
+            records = data["records"]
+            # Lost records are marked before the next record.
+            is_gap = is_gap or (since is not None and (base is None or data["first"] > since))
+
+            if base is None:
+                if host_offset is None:
+                    # The trace starts with the first record.
+                    base = (records[0]["timestamp"] if records else data["now"], 0)
+                else:
+                    base = (data["now"], host_ms + host_offset)
+
+            for record in records:
+                trace_time = max(trace_time, base[1] + millis_diff(record["timestamp"], base[0]))
+
+                if is_gap:
+                    writer.append(trace_time, CODE_GAP)
+                    num_gaps += 1
+                    is_gap = False
+
+                for channel in range(len(pulses_per_kwh)):
+                    if record["ids"] & (1 << channel):
+                        writer.append(trace_time, channel)
+                        num_pulses += 1
+
+            # Rebase regularly, because the signed difference covers only 24 days.
+            base = (data["now"], base[1] + millis_diff(data["now"], base[0]))
+            host_offset = base[1] - host_ms
+            since = data["next"]
+            file.flush()
+
+            time.sleep(max(0.0, args.interval - (time.monotonic() - poll_start)))
+
+    print(f"{num_pulses} pulses and {num_gaps} gaps captured.")
+    return 0
+
+
+def info(args):
+    """Show a summary of a pulse trace."""
+    with open(args.file, "rb") as file:
+        pulses_per_kwh, records = read_trace(file.read())
+
+    duration = records[-1][0] if records else 0
+    num_gaps = sum(1 for _, code in records if code == CODE_GAP)
+
+    print(f"Duration: {duration / 1000.0:.1f} s, records: {len(records)}, gaps: {num_gaps}")
+
+    for channel, value in enumerate(pulses_per_kwh):
+        times = [record_time for record_time, code in records if code == channel]
+        energy = len(times) * 1000.0 / value
+        line = f"Channel {channel}: {value} pulses/kWh, {len(times)} pulses, {energy:.1f} Wh"
+
+        if len(times) >= 2 and times[-1] > times[0]:
+            power = (len(times) - 1) * 3600000.0 / value / ((times[-1] - times[0]) / 1000.0)
+            line += f", mean power {power:.1f} W"
+
+        print(line)
+
+    return 0
+
+
+def get_counted_pulses(base_url):
+    """Get the counted pulses of every S0 interface."""
+    return {interface["id"]: interface["pulses"] for interface in get_json(base_url + "/api/s0-interfaces")["data"]}
+
+
+def replay(args):
+    """Replay a pulse trace into the S0 input of the Linux build."""
+    with open(args.file, "rb") as file:
+        pulses_per_kwh, records = read_trace(file.read())
+
+    num_channels = len(pulses_per_kwh)
+    bits = list(range(num_channels))
+    before = None
+
+    if args.url is not None:
+        base_url = args.url.rstrip("/")
+        interfaces = get_json(base_url + "/api/config")["data"]["s0Interfaces"]
+
+        for channel in range(num_channels):
+            pin = interfaces[channel]["pinS0"] if channel < len(interfaces) else None
+
+            if pin is None or not interfaces[channel]["isEnabled"] or not PIN_PORT_A_BIT0 <= pin < PIN_PORT_A_BIT0 + 8:
+                print(f"S0 interface {channel} is disabled or not on the S0 port.", file=sys.stderr)
+                return 1
+
+            bits[channel] = pin - PIN_PORT_A_BIT0
+
+        before = get_counted_pulses(base_url)
+
+    # Pulses at the same time are injected together.
+    events = []
+    for record_time, code in records:
+        if code == CODE_GAP:
+            continue
+        if events and events[-1][0] == record_time:
+            events[-1][1] |= 1 << bits[code]
+        else:
+            events.append([record_time, 1 << bits[code]])
+
+    fd = os.open(args.s0_input, os.O_WRONLY)
+    start = time.monotonic()
+
+    try:
+        for idx, (record_time, mask) in enumerate(events):
+            delay = start + record_time / 1000.0 / args.speed - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+
+            os.write(fd, bytes([PORT_IDLE & ~mask]))
+
+            # Release the pulse before the next one.
+            width = args.pulse_width / 1000.0
+            if idx + 1 < len(events):
+                width = min(width, (events[idx + 1][0] - record_time) / 1000.0 / args.speed / 2)
+            time.sleep(width)
+
+            os.write(fd, bytes([PORT_IDLE]))
+    finally:
+        os.close(fd)
+
+    print(f"{len(events)} pulse events replayed in {time.monotonic() - start:.1f} s.")
+
+    if before is None:
+        return 0
+
+    # Give the firmware time to apply the pending port values.
+    time.sleep(1.0)
+    after = get_counted_pulses(base_url)
+    is_exact = True
+
+    for channel in range(num_channels):
+        expected = sum(1 for _, code in records if code == channel)
+        counted = after.get(channel, 0) - before.get(channel, 0)
+
+        print(json.dumps({"channel": channel, "expected": expected, "counted": counted}))
+
+        if counted != expected:
+            is_exact = False
+
+    return 0 if is_exact else 1
+
+
+def main():
+    """Main entry point."""
+    parser = argparse.ArgumentParser(description="Pulse trace host tool")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    parser_capture = commands.add_parser("capture", help="Capture a pulse trace from a device.")
+    parser_capture.add_argument("--url", required=True, help="Device URL, e.g. http://<device>")
+    parser_capture.add_argument("--out", required=True, help="Pulse trace file")
+    parser_capture.add_argument("--interval", type=float, default=1.0, help="Poll interval in s (default: 1)")
+    parser_capture.add_argument("--duration", type=float, help="Capture duration in s (default: till interrupted)")
+
+    parser_info = commands.add_parser("info", help="Show a summary of a pulse trace.")
+    parser_info.add_argument("file", help="Pulse trace file")
+
+    parser_replay = commands.add_parser("replay", help="Replay a pulse trace into the S0 input of the Linux build.")
+    parser_replay.add_argument("file", help="Pulse trace file")
+    parser_replay.add_argument("--s0-input", required=True, help="S0 input of the Linux build, e.g. s0.fifo")
+    parser_replay.add_argument("--url", help="URL of the Linux build, to map the pins and verify the counted pulses")
+    parser_replay.add_argument("--speed", type=float, default=1.0, help="Replay speed factor (default: 1)")
+    parser_replay.add_argument("--pulse-width", type=float, default=30.0, help="Max. pulse width in ms (default: 30)")
+
+    args = parser.parse_args()
+
+    try:
+        if args.command == "capture":
+            return capture(args)
+        if args.command == "info":
+            return info(args)
+        return replay(args)
+    except TraceError as error:
+        print(error, file=sys.stderr)
+        return 1
+    except KeyboardInterrupt:
+        return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,442 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmark of the aggregation kernels
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The synthetic columns are much larger than the caches, like a long history
+ * of many S0 interfaces. Every benchmark runs several rounds over the whole
+ * columns. The min. of all rounds is the cost without disturbances by the
+ * system. The results of every instruction set must be equal to the scalar
+ * ones.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "KernelBench.h"
+#include "Kernels.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+
+#include <algorithm>
+#include <vector>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Synthetic columns of the benchmarks.
+ */
+struct BenchData
+{
+    std::vector<uint32_t>   powers;     /**< Power column */
+    std::vector<uint32_t>   counters;   /**< Counter column with restarts */
+    std::vector<uint32_t>   deltas;     /**< Power column, zigzag delta encoded */
+    std::vector<uint32_t>   work;       /**< Column for the in place decoding */
+};
+
+/**
+ * A benchmark.
+ */
+struct BenchEntry
+{
+    /** Benchmark name */
+    const char* name;
+
+    /** Number of column bytes, which a round reads */
+    size_t      columnsPerRound;
+
+    /**
+     * Run a round.
+     *
+     * @param[in]       kernels Kernels
+     * @param[in,out]   data    Columns
+     *
+     * @return Result, which must be equal for all kernels
+     */
+    uint64_t (*run)(const Kernels::Table& kernels, BenchData& data);
+
+    /**
+     * Prepare a round, not measured.
+     *
+     * @param[in,out] data  Columns
+     */
+    void (*prepare)(BenchData& data);
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void generateData(BenchData& data, size_t count);
+static uint64_t getNanos(void);
+static void prepareDecode(BenchData& data);
+static uint64_t runDecode(const Kernels::Table& kernels, BenchData& data);
+static uint64_t runSummarize(const Kernels::Table& kernels, BenchData& data);
+static uint64_t runCountPulses(const Kernels::Table& kernels, BenchData& data);
+static uint64_t runWindows(const Kernels::Table& kernels, BenchData& data);
+static void printBenchUsage(void);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Default size of a column in MiB. */
+static const size_t     DEFAULT_COLUMN_SIZE     = 512U;
+
+/** Default number of rounds per benchmark. */
+static const uint32_t   DEFAULT_ROUNDS          = 5U;
+
+/** Number of samples per window: 1 h of 1 s samples. */
+static const size_t     WINDOW_SIZE             = 3600U;
+
+/** Number of samples between two restarts of the device. */
+static const size_t     RESTART_PERIOD          = 10000000U;
+
+/** Benchmarks */
+static const BenchEntry gBenchmarks[]           =
+{
+    { "decodeDeltas",   1U, runDecode,      prepareDecode   },
+    { "summarize",      1U, runSummarize,   nullptr         },
+    { "countPulses",    1U, runCountPulses, nullptr         },
+    { "windows",        2U, runWindows,     nullptr         }
+};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+int runKernelBench(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "size",   required_argument,  nullptr,    's' },
+        { "rounds", required_argument,  nullptr,    'r' },
+        { "filter", required_argument,  nullptr,    'f' },
+        { nullptr,  0,                  nullptr,    0   }
+    };
+    const Kernels::Table*       tables[3];
+    size_t                      numTables   = Kernels::getAll(tables);
+    size_t                      columnSize  = DEFAULT_COLUMN_SIZE;
+    uint32_t                    rounds      = DEFAULT_ROUNDS;
+    const char*                 filter      = nullptr;
+    bool                        isEqual     = true;
+    BenchData                   data;
+    int                         opt         = 0;
+
+    while(-1 != (opt = getopt_long(argc, argv, "s:r:f:", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 's':
+            columnSize = static_cast<size_t>(strtoul(optarg, nullptr, 0));
+            break;
+
+        case 'r':
+            rounds = static_cast<uint32_t>(strtoul(optarg, nullptr, 0));
+            break;
+
+        case 'f':
+            filter = optarg;
+            break;
+
+        default:
+            printBenchUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((0U == columnSize) || (0U == rounds))
+    {
+        printBenchUsage();
+        return EXIT_FAILURE;
+    }
+
+    generateData(data, columnSize * 1024U * 1024U / sizeof(uint32_t));
+
+    for(const BenchEntry& entry : gBenchmarks)
+    {
+        uint64_t    scalarResult    = 0U;
+        double      scalarNs        = 0.0;
+        size_t      tableIdx        = 0U;
+
+        if ((nullptr != filter) &&
+            (nullptr == strstr(entry.name, filter)))
+        {
+            continue;
+        }
+
+        for(tableIdx = 0U; tableIdx < numTables; ++tableIdx)
+        {
+            std::vector<uint64_t>   durations;
+            uint64_t                result      = 0U;
+            double                  bytes       = static_cast<double>(entry.columnsPerRound * data.powers.size() * sizeof(uint32_t));
+            uint32_t                round       = 0U;
+
+            for(round = 0U; round < rounds; ++round)
+            {
+                uint64_t start = 0U;
+
+                if (nullptr != entry.prepare)
+                {
+                    entry.prepare(data);
+                }
+
+                start   = getNanos();
+                result  = entry.run(*tables[tableIdx], data);
+                durations.push_back(getNanos() - start);
+            }
+
+            std::sort(durations.begin(), durations.end());
+
+            /* The scalar kernels are the first and the reference. */
+            if (0U == tableIdx)
+            {
+                scalarResult    = result;
+                scalarNs        = static_cast<double>(durations.front());
+            }
+            else if (scalarResult != result)
+            {
+                isEqual = false;
+            }
+            else
+            {
+                ;
+            }
+
+            printf("{\"name\":\"%s\",\"kernels\":\"%s\",\"megabytes\":%.0f,\"rounds\":%u,\"minMs\":%.2f,\"medianMs\":%.2f,\"maxMs\":%.2f,\"gbPerSec\":%.2f,\"speedup\":%.2f,\"isEqual\":%s}\n",
+                entry.name,
+                tables[tableIdx]->name,
+                bytes / (1024.0 * 1024.0),
+                rounds,
+                durations.front() / 1e6,
+                durations[durations.size() / 2U] / 1e6,
+                durations.back() / 1e6,
+                bytes / static_cast<double>(durations.front()),
+                scalarNs / static_cast<double>(durations.front()),
+                (scalarResult == result) ? "true" : "false");
+            fflush(stdout);
+        }
+    }
+
+    return (true == isEqual) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Generate the synthetic columns: a noisy power between 0 and about 5 kW and
+ * its counter, which restarts periodically.
+ *
+ * @param[out]  data    Columns
+ * @param[in]   count   Number of samples
+ */
+static void generateData(BenchData& data, size_t count)
+{
+    uint32_t    random      = 0x12345678U;
+    uint32_t    counter     = 0U;
+    uint32_t    previous    = 0U;
+    size_t      idx         = 0U;
+
+    data.powers.resize(count);
+    data.counters.resize(count);
+    data.deltas.resize(count);
+    data.work.resize(count);
+
+    for(idx = 0U; idx < count; ++idx)
+    {
+        random ^= random << 13U;
+        random ^= random >> 17U;
+        random ^= random << 5U;
+
+        if ((0U < idx) && (0U == (idx % RESTART_PERIOD)))
+        {
+            counter = 0U;
+        }
+
+        counter += random % 3U;
+
+        data.powers[idx]    = 300U + (random % 4700U);
+        data.counters[idx]  = counter;
+        data.deltas[idx]    = Kernels::toZigzagDelta(previous, data.powers[idx]);
+        previous            = data.powers[idx];
+    }
+
+    return;
+}
+
+/**
+ * Get the monotonic time.
+ *
+ * @return Time in ns
+ */
+static uint64_t getNanos(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL) + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * Restore the delta encoded column, which is decoded in place.
+ *
+ * @param[in,out] data  Columns
+ */
+static void prepareDecode(BenchData& data)
+{
+    memcpy(data.work.data(), data.deltas.data(), data.deltas.size() * sizeof(uint32_t));
+
+    return;
+}
+
+/**
+ * Decode the delta encoded power column.
+ *
+ * @param[in]       kernels Kernels
+ * @param[in,out]   data    Columns
+ *
+ * @return Number of values, which differ from the original column
+ */
+static uint64_t runDecode(const Kernels::Table& kernels, BenchData& data)
+{
+    uint64_t    numDiffs    = 0U;
+    size_t      idx         = 0U;
+
+    kernels.decodeDeltas(data.work.data(), data.work.size(), 0U);
+
+    /* Checking the result isn't part of the kernel, but would be optimized
+     * away without using the result. Its cost is the same for all kernels.
+     */
+    for(idx = 0U; idx < data.work.size(); idx += 4093U)
+    {
+        numDiffs += (data.work[idx] != data.powers[idx]) ? 1U : 0U;
+    }
+
+    return numDiffs + data.work.back();
+}
+
+/**
+ * Summarize the power column.
+ *
+ * @param[in]       kernels Kernels
+ * @param[in,out]   data    Columns
+ *
+ * @return Combination of min., max. and sum
+ */
+static uint64_t runSummarize(const Kernels::Table& kernels, BenchData& data)
+{
+    Kernels::Summary summary;
+
+    kernels.summarize(data.powers.data(), data.powers.size(), summary);
+
+    return (static_cast<uint64_t>(summary.min) << 48U) ^ (static_cast<uint64_t>(summary.max) << 32U) ^ summary.sum;
+}
+
+/**
+ * Count the pulses of the counter column.
+ *
+ * @param[in]       kernels Kernels
+ * @param[in,out]   data    Columns
+ *
+ * @return Number of pulses
+ */
+static uint64_t runCountPulses(const Kernels::Table& kernels, BenchData& data)
+{
+    return kernels.countPulses(data.counters.data(), data.counters.size(), 0U);
+}
+
+/**
+ * Aggregate the power and the pulses in windows of 1 h, like a query in
+ * steps.
+ *
+ * @param[in]       kernels Kernels
+ * @param[in,out]   data    Columns
+ *
+ * @return Combination of the results of all windows
+ */
+static uint64_t runWindows(const Kernels::Table& kernels, BenchData& data)
+{
+    uint64_t    result      = 0U;
+    uint32_t    previous    = 0U;
+    size_t      idx         = 0U;
+
+    for(idx = 0U; idx < data.powers.size(); idx += WINDOW_SIZE)
+    {
+        size_t              count   = std::min(WINDOW_SIZE, data.powers.size() - idx);
+        Kernels::Summary    summary;
+
+        kernels.summarize(&data.powers[idx], count, summary);
+
+        result   = (result * 31U) + summary.min + summary.max + summary.sum;
+        result   = (result * 31U) + kernels.countPulses(&data.counters[idx], count, previous);
+        previous = data.counters[idx + count - 1U];
+    }
+
+    return result;
+}
+
+/**
+ * Print the command line usage of the benchmark.
+ */
+static void printBenchUsage(void)
+{
+    printf("bench [--size MiB] [--rounds N] [--filter TEXT]\n");
+    printf("  --size MiB      Size of a column (default: %zu), 4 columns are allocated.\n", DEFAULT_COLUMN_SIZE);
+    printf("  --rounds N      Number of rounds per benchmark (default: %u).\n", DEFAULT_ROUNDS);
+    printf("  --filter TEXT   Run only the benchmarks, whose name contains the text.\n");
+}
@@ -0,0 +1,590 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Aggregation kernels over the sample columns
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Kernels.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+/** The SIMD kernels are compiled with function specific targets. */
+#define KERNELS_X86     1
+#else
+#define KERNELS_X86     0
+#endif
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Target of the SSE2 kernels, which is the baseline of x86-64. */
+#define TARGET_SSE2     __attribute__((target("sse2")))
+
+/** Target of the AVX2 kernels. */
+#define TARGET_AVX2     __attribute__((target("avx2")))
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void decodeDeltasScalar(uint32_t* values, size_t count, uint32_t start);
+static void summarizeScalar(const uint32_t* values, size_t count, Kernels::Summary& summary);
+static uint64_t countPulsesScalar(const uint32_t* counters, size_t count, uint32_t previous);
+
+#if (0 != KERNELS_X86)
+
+TARGET_SSE2 static void decodeDeltasSse2(uint32_t* values, size_t count, uint32_t start);
+TARGET_SSE2 static void summarizeSse2(const uint32_t* values, size_t count, Kernels::Summary& summary);
+TARGET_SSE2 static uint64_t countPulsesSse2(const uint32_t* counters, size_t count, uint32_t previous);
+TARGET_SSE2 static __m128i fromZigzagSse2(__m128i values);
+TARGET_SSE2 static __m128i selectSse2(__m128i mask, __m128i ifSet, __m128i ifClear);
+TARGET_SSE2 static __m128i addWidenedSse2(__m128i sum, __m128i values);
+TARGET_SSE2 static uint64_t horizontalSumSse2(__m128i sum);
+
+TARGET_AVX2 static void decodeDeltasAvx2(uint32_t* values, size_t count, uint32_t start);
+TARGET_AVX2 static void summarizeAvx2(const uint32_t* values, size_t count, Kernels::Summary& summary);
+TARGET_AVX2 static uint64_t countPulsesAvx2(const uint32_t* counters, size_t count, uint32_t previous);
+TARGET_AVX2 static __m256i fromZigzagAvx2(__m256i values);
+TARGET_AVX2 static __m256i addWidenedAvx2(__m256i sum, __m256i values);
+TARGET_AVX2 static uint64_t horizontalSumAvx2(__m256i sum);
+
+#endif  /* (0 != KERNELS_X86) */
+
+static const Kernels::Table* selectBest(void);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Scalar kernels */
+static const Kernels::Table gScalarKernels  =
+{
+    "scalar",
+    decodeDeltasScalar,
+    summarizeScalar,
+    countPulsesScalar
+};
+
+#if (0 != KERNELS_X86)
+
+/** SSE2 kernels */
+static const Kernels::Table gSse2Kernels    =
+{
+    "sse2",
+    decodeDeltasSse2,
+    summarizeSse2,
+    countPulsesSse2
+};
+
+/** AVX2 kernels */
+static const Kernels::Table gAvx2Kernels    =
+{
+    "avx2",
+    decodeDeltasAvx2,
+    summarizeAvx2,
+    countPulsesAvx2
+};
+
+#endif  /* (0 != KERNELS_X86) */
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+const Kernels::Table& Kernels::get(void)
+{
+    /* Thread-safe initialization, the CPU features are detected only once. */
+    static const Table* best = selectBest();
+
+    return *best;
+}
+
+const Kernels::Table* Kernels::find(const char* name)
+{
+    const Table*    tables[3];
+    size_t          numTables   = getAll(tables);
+    size_t          idx         = 0U;
+
+    for(idx = 0U; idx < numTables; ++idx)
+    {
+        if (0 == strcmp(tables[idx]->name, name))
+        {
+            return tables[idx];
+        }
+    }
+
+    return nullptr;
+}
+
+size_t Kernels::getAll(const Table* tables[])
+{
+    size_t numTables = 0U;
+
+    tables[numTables] = &gScalarKernels;
+    ++numTables;
+
+#if (0 != KERNELS_X86)
+
+    __builtin_cpu_init();
+
+    if (0 != __builtin_cpu_supports("sse2"))
+    {
+        tables[numTables] = &gSse2Kernels;
+        ++numTables;
+    }
+
+    if (0 != __builtin_cpu_supports("avx2"))
+    {
+        tables[numTables] = &gAvx2Kernels;
+        ++numTables;
+    }
+
+#endif  /* (0 != KERNELS_X86) */
+
+    return numTables;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Select the kernels of the best instruction set, which the CPU supports.
+ *
+ * @return Kernels
+ */
+static const Kernels::Table* selectBest(void)
+{
+    const Kernels::Table* tables[3];
+
+    return tables[Kernels::getAll(tables) - 1U];
+}
+
+/**
+ * Scalar delta decoding, see Kernels::Table::decodeDeltas.
+ */
+static void decodeDeltasScalar(uint32_t* values, size_t count, uint32_t start)
+{
+    uint32_t    value   = start;
+    size_t      idx     = 0U;
+
+    for(idx = 0U; idx < count; ++idx)
+    {
+        value      += (values[idx] >> 1U) ^ (0U - (values[idx] & 1U));
+        values[idx] = value;
+    }
+
+    return;
+}
+
+/**
+ * Scalar min., max. and sum, see Kernels::Table::summarize.
+ */
+static void summarizeScalar(const uint32_t* values, size_t count, Kernels::Summary& summary)
+{
+    uint32_t    minValue    = UINT32_MAX;
+    uint32_t    maxValue    = 0U;
+    uint64_t    sum         = 0U;
+    size_t      idx         = 0U;
+
+    for(idx = 0U; idx < count; ++idx)
+    {
+        minValue    = (values[idx] < minValue) ? values[idx] : minValue;
+        maxValue    = (values[idx] > maxValue) ? values[idx] : maxValue;
+        sum        += values[idx];
+    }
+
+    summary.min = minValue;
+    summary.max = maxValue;
+    summary.sum = sum;
+
+    return;
+}
+
+/**
+ * Scalar pulse counting, see Kernels::Table::countPulses.
+ */
+static uint64_t countPulsesScalar(const uint32_t* counters, size_t count, uint32_t previous)
+{
+    uint64_t    pulses  = 0U;
+    size_t      idx     = 0U;
+
+    for(idx = 0U; idx < count; ++idx)
+    {
+        pulses  += (counters[idx] >= previous) ? (counters[idx] - previous) : counters[idx];
+        previous = counters[idx];
+    }
+
+    return pulses;
+}
+
+#if (0 != KERNELS_X86)
+
+/**
+ * SSE2 delta decoding, see Kernels::Table::decodeDeltas.
+ * The prefix sum of 4 values needs 2 shifted additions, the carry is the
+ * last value of the previous vector.
+ */
+static void decodeDeltasSse2(uint32_t* values, size_t count, uint32_t start)
+{
+    __m128i carry   = _mm_set1_epi32(static_cast<int32_t>(start));
+    size_t  idx     = 0U;
+
+    for(idx = 0U; (idx + 4U) <= count; idx += 4U)
+    {
+        __m128i data = fromZigzagSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&values[idx])));
+
+        data    = _mm_add_epi32(data, _mm_slli_si128(data, 4));
+        data    = _mm_add_epi32(data, _mm_slli_si128(data, 8));
+        data    = _mm_add_epi32(data, carry);
+        carry   = _mm_shuffle_epi32(data, 0xFF);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&values[idx]), data);
+    }
+
+    decodeDeltasScalar(&values[idx], count - idx, static_cast<uint32_t>(_mm_cvtsi128_si32(carry)));
+
+    return;
+}
+
+/**
+ * SSE2 min., max. and sum, see Kernels::Table::summarize.
+ * SSE2 compares only signed, therefore the sign bit is flipped before.
+ */
+static void summarizeSse2(const uint32_t* values, size_t count, Kernels::Summary& summary)
+{
+    const __m128i   sign        = _mm_set1_epi32(INT32_MIN);
+    __m128i         minValues   = _mm_set1_epi32(INT32_MAX);    /* UINT32_MAX with flipped sign */
+    __m128i         maxValues   = sign;                         /* 0 with flipped sign */
+    __m128i         sum         = _mm_setzero_si128();
+    uint32_t        lanes[4];
+    size_t          idx         = 0U;
+    Kernels::Summary rest;
+
+    for(idx = 0U; (idx + 4U) <= count; idx += 4U)
+    {
+        __m128i data    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&values[idx]));
+        __m128i flipped = _mm_xor_si128(data, sign);
+
+        minValues   = selectSse2(_mm_cmplt_epi32(flipped, minValues), flipped, minValues);
+        maxValues   = selectSse2(_mm_cmpgt_epi32(flipped, maxValues), flipped, maxValues);
+        sum         = addWidenedSse2(sum, data);
+    }
+
+    summarizeScalar(&values[idx], count - idx, rest);
+
+    summary.min = rest.min;
+    summary.max = rest.max;
+    summary.sum = rest.sum + horizontalSumSse2(sum);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(minValues, sign));
+
+    for(idx = 0U; idx < 4U; ++idx)
+    {
+        summary.min = (lanes[idx] < summary.min) ? lanes[idx] : summary.min;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(maxValues, sign));
+
+    for(idx = 0U; idx < 4U; ++idx)
+    {
+        summary.max = (lanes[idx] > summary.max) ? lanes[idx] : summary.max;
+    }
+
+    return;
+}
+
+/**
+ * SSE2 pulse counting, see Kernels::Table::countPulses.
+ * The predecessors are a second, unaligned load shifted by one value.
+ */
+static uint64_t countPulsesSse2(const uint32_t* counters, size_t count, uint32_t previous)
+{
+    const __m128i   sign    = _mm_set1_epi32(INT32_MIN);
+    __m128i         sum     = _mm_setzero_si128();
+    uint64_t        pulses  = 0U;
+    size_t          idx     = 0U;
+
+    if (0U == count)
+    {
+        return 0U;
+    }
+
+    pulses = countPulsesScalar(counters, 1U, previous);
+
+    for(idx = 1U; (idx + 4U) <= count; idx += 4U)
+    {
+        __m128i current     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&counters[idx]));
+        __m128i predecessor = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&counters[idx - 1U]));
+        __m128i isRestart   = _mm_cmplt_epi32(_mm_xor_si128(current, sign), _mm_xor_si128(predecessor, sign));
+
+        sum = addWidenedSse2(sum, selectSse2(isRestart, current, _mm_sub_epi32(current, predecessor)));
+    }
+
+    return pulses + horizontalSumSse2(sum) + countPulsesScalar(&counters[idx], count - idx, counters[idx - 1U]);
+}
+
+/**
+ * Zigzag decoding of 4 values.
+ *
+ * @param[in] values    Zigzag encoded values
+ *
+ * @return Decoded values
+ */
+static __m128i fromZigzagSse2(__m128i values)
+{
+    __m128i negated = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(values, _mm_set1_epi32(1)));
+
+    return _mm_xor_si128(_mm_srli_epi32(values, 1), negated);
+}
+
+/**
+ * Select per lane.
+ *
+ * @param[in] mask      All bits set or clear per lane
+ * @param[in] ifSet     Lanes, where the mask is set
+ * @param[in] ifClear   Lanes, where the mask is clear
+ *
+ * @return Selected lanes
+ */
+static __m128i selectSse2(__m128i mask, __m128i ifSet, __m128i ifClear)
+{
+    return _mm_or_si128(_mm_and_si128(mask, ifSet), _mm_andnot_si128(mask, ifClear));
+}
+
+/**
+ * Add 4 unsigned 32 bit values to 2 64 bit sums.
+ *
+ * @param[in] sum       64 bit sums
+ * @param[in] values    32 bit values
+ *
+ * @return 64 bit sums
+ */
+static __m128i addWidenedSse2(__m128i sum, __m128i values)
+{
+    sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(values, _mm_setzero_si128()));
+
+    return _mm_add_epi64(sum, _mm_unpackhi_epi32(values, _mm_setzero_si128()));
+}
+
+/**
+ * Sum of 2 64 bit lanes.
+ *
+ * @param[in] sum   64 bit sums
+ *
+ * @return Sum
+ */
+static uint64_t horizontalSumSse2(__m128i sum)
+{
+    uint64_t lanes[2];
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum);
+
+    return lanes[0] + lanes[1];
+}
+
+/**
+ * AVX2 delta decoding, see Kernels::Table::decodeDeltas.
+ * The shifts work within the 128 bit lanes, therefore the last value of the
+ * low lane is added to the high lane afterwards.
+ */
+static void decodeDeltasAvx2(uint32_t* values, size_t count, uint32_t start)
+{
+    const __m256i   last    = _mm256_set1_epi32(7);
+    __m256i         carry   = _mm256_set1_epi32(static_cast<int32_t>(start));
+    size_t          idx     = 0U;
+
+    for(idx = 0U; (idx + 8U) <= count; idx += 8U)
+    {
+        __m256i data = fromZigzagAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&values[idx])));
+        __m256i lowLast;
+
+        data    = _mm256_add_epi32(data, _mm256_slli_si256(data, 4));
+        data    = _mm256_add_epi32(data, _mm256_slli_si256(data, 8));
+        lowLast = _mm256_shuffle_epi32(data, 0xFF);
+        data    = _mm256_add_epi32(data, _mm256_permute2x128_si256(lowLast, lowLast, 0x08));
+        data    = _mm256_add_epi32(data, carry);
+        carry   = _mm256_permutevar8x32_epi32(data, last);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&values[idx]), data);
+    }
+
+    decodeDeltasScalar(&values[idx], count - idx, static_cast<uint32_t>(_mm256_extract_epi32(carry, 0)));
+
+    return;
+}
+
+/**
+ * AVX2 min., max. and sum, see Kernels::Table::summarize.
+ */
+static void summarizeAvx2(const uint32_t* values, size_t count, Kernels::Summary& summary)
+{
+    __m256i             minValues   = _mm256_set1_epi32(-1);
+    __m256i             maxValues   = _mm256_setzero_si256();
+    __m256i             sum         = _mm256_setzero_si256();
+    uint32_t            lanes[8];
+    size_t              idx         = 0U;
+    Kernels::Summary    rest;
+
+    for(idx = 0U; (idx + 8U) <= count; idx += 8U)
+    {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&values[idx]));
+
+        minValues   = _mm256_min_epu32(minValues, data);
+        maxValues   = _mm256_max_epu32(maxValues, data);
+        sum         = addWidenedAvx2(sum, data);
+    }
+
+    summarizeScalar(&values[idx], count - idx, rest);
+
+    summary.min = rest.min;
+    summary.max = rest.max;
+    summary.sum = rest.sum + horizontalSumAvx2(sum);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), minValues);
+
+    for(idx = 0U; idx < 8U; ++idx)
+    {
+        summary.min = (lanes[idx] < summary.min) ? lanes[idx] : summary.min;
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), maxValues);
+
+    for(idx = 0U; idx < 8U; ++idx)
+    {
+        summary.max = (lanes[idx] > summary.max) ? lanes[idx] : summary.max;
+    }
+
+    return;
+}
+
+/**
+ * AVX2 pulse counting, see Kernels::Table::countPulses.
+ * A counter is smaller than its predecessor, if the unsigned max. of both
+ * isn't the counter itself.
+ */
+static uint64_t countPulsesAvx2(const uint32_t* counters, size_t count, uint32_t previous)
+{
+    __m256i     sum     = _mm256_setzero_si256();
+    uint64_t    pulses  = 0U;
+    size_t      idx     = 0U;
+
+    if (0U == count)
+    {
+        return 0U;
+    }
+
+    pulses = countPulsesScalar(counters, 1U, previous);
+
+    for(idx = 1U; (idx + 8U) <= count; idx += 8U)
+    {
+        __m256i current     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&counters[idx]));
+        __m256i predecessor = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&counters[idx - 1U]));
+        __m256i isCounting  = _mm256_cmpeq_epi32(_mm256_max_epu32(current, predecessor), current);
+
+        sum = addWidenedAvx2(sum, _mm256_blendv_epi8(current, _mm256_sub_epi32(current, predecessor), isCounting));
+    }
+
+    return pulses + horizontalSumAvx2(sum) + countPulsesScalar(&counters[idx], count - idx, counters[idx - 1U]);
+}
+
+/**
+ * Zigzag decoding of 8 values.
+ *
+ * @param[in] values    Zigzag encoded values
+ *
+ * @return Decoded values
+ */
+static __m256i fromZigzagAvx2(__m256i values)
+{
+    __m256i negated = _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_and_si256(values, _mm256_set1_epi32(1)));
+
+    return _mm256_xor_si256(_mm256_srli_epi32(values, 1), negated);
+}
+
+/**
+ * Add 8 unsigned 32 bit values to 4 64 bit sums.
+ *
+ * @param[in] sum       64 bit sums
+ * @param[in] values    32 bit values
+ *
+ * @return 64 bit sums
+ */
+static __m256i addWidenedAvx2(__m256i sum, __m256i values)
+{
+    sum = _mm256_add_epi64(sum, _mm256_unpacklo_epi32(values, _mm256_setzero_si256()));
+
+    return _mm256_add_epi64(sum, _mm256_unpackhi_epi32(values, _mm256_setzero_si256()));
+}
+
+/**
+ * Sum of 4 64 bit lanes.
+ *
+ * @param[in] sum   64 bit sums
+ *
+ * @return Sum
+ */
+static uint64_t horizontalSumAvx2(__m256i sum)
+{
+    uint64_t lanes[4];
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sum);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+#endif  /* (0 != KERNELS_X86) */
@@ -0,0 +1,164 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Aggregation kernels over the sample columns
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The hot loops of the time series store work on whole columns: delta
+ * decoding of the counter and power column, min., max. and sum of the power
+ * and the pulses of the counter column. Every kernel exists as scalar, SSE2
+ * and AVX2 variant. The variant is selected once at runtime by the features
+ * of the CPU, on other architectures only the scalar one exists.
+ *
+ * @{
+ */
+
+#ifndef __KERNELS_H__
+#define __KERNELS_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Aggregation kernels over the sample columns. */
+namespace Kernels
+{
+
+/**
+ * Min., max. and sum of a column.
+ */
+struct Summary
+{
+    uint32_t    min;    /**< Min. value, UINT32_MAX if empty */
+    uint32_t    max;    /**< Max. value, 0 if empty */
+    uint64_t    sum;    /**< Sum of the values */
+};
+
+/**
+ * The kernels of one instruction set.
+ */
+struct Table
+{
+    /** Instruction set name: "scalar", "sse2" or "avx2" */
+    const char* name;
+
+    /**
+     * Decode a delta encoded column in place. Every value is the zigzag
+     * encoded difference to its predecessor, modulo 2^32.
+     *
+     * @param[in,out]   values  Zigzag deltas, afterwards the values
+     * @param[in]       count   Number of values
+     * @param[in]       start   Predecessor of the first value
+     */
+    void (*decodeDeltas)(uint32_t* values, size_t count, uint32_t start);
+
+    /**
+     * Get min., max. and sum of a column.
+     *
+     * @param[in]   values  Values
+     * @param[in]   count   Number of values
+     * @param[out]  summary Min., max. and sum
+     */
+    void (*summarize)(const uint32_t* values, size_t count, Summary& summary);
+
+    /**
+     * Count the pulses of a counter column. A decreasing counter means, that
+     * the device restarted and counts from 0 again.
+     *
+     * @param[in] counters  Counter values
+     * @param[in] count     Number of values
+     * @param[in] previous  Counter of the sample before the first one
+     *
+     * @return Number of pulses
+     */
+    uint64_t (*countPulses)(const uint32_t* counters, size_t count, uint32_t previous);
+};
+
+/**
+ * Get the kernels of the best instruction set, which the CPU supports.
+ *
+ * @return Kernels
+ */
+const Table& get(void);
+
+/**
+ * Get the kernels of a instruction set.
+ *
+ * @param[in] name  Instruction set name
+ *
+ * @return If the CPU supports it, the kernels otherwise nullptr.
+ */
+const Table* find(const char* name);
+
+/**
+ * Get all kernels, which the CPU supports, the scalar ones first.
+ *
+ * @param[out] tables   Kernels, at least 3 entries
+ *
+ * @return Number of kernel tables
+ */
+size_t getAll(const Table* tables[]);
+
+/**
+ * Zigzag encoding of the difference between two values, modulo 2^32.
+ * The counterpart of the delta decoding.
+ *
+ * @param[in] previous  Previous value
+ * @param[in] current   Current value
+ *
+ * @return Zigzag delta
+ */
+inline uint32_t toZigzagDelta(uint32_t previous, uint32_t current)
+{
+    int32_t delta = static_cast<int32_t>(current - previous);
+
+    return (static_cast<uint32_t>(delta) << 1U) ^ static_cast<uint32_t>(delta >> 31);
+}
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __KERNELS_H__ */
+
+/** @} */
@@ -0,0 +1,804 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Command line tool of the time series store
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Imports the responses of GET /api/s0-interfaces into one store file per
+ * S0 interface and aggregates the samples in time ranges, see SampleStore.h.
+ *
+ * Commands:
+ * - import: Every input line is a unix timestamp in s, followed by a
+ *   response, e.g. recorded with
+ *   while true; do echo "$(date +%s) $(curl -s http://<device>/api/s0-interfaces)"; sleep 1; done
+ * - info: Summary of a store file.
+ * - query: Aggregation of a time range, optionally in steps, e.g. per day.
+ * - generate: Synthetic samples, e.g. years of 1 s data for benchmarks.
+ * - bench: Benchmark of the aggregation kernels, see KernelBench.h.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+#include <time.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "SampleStore.h"
+#include "KernelBench.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Data of a S0 interface in a response of GET /api/s0-interfaces.
+ */
+struct Interface
+{
+    uint64_t    id;             /**< S0 interface id */
+    std::string name;           /**< S0 interface name */
+    uint64_t    pulsesPerKWh;   /**< Pulses per kWh */
+    uint64_t    power;          /**< Power consumption in W */
+    uint64_t    pulses;         /**< Counted pulses */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint64_t getMicros(void);
+static int runImport(int argc, char* argv[]);
+static bool importFile(FILE* fd, const char* fileName, const std::string& dir, const std::string& device,
+                       std::map<uint64_t, std::unique_ptr<SampleStore>>& stores, uint64_t& numImported, uint64_t& numSkipped);
+static bool parseInterfaces(const char* json, std::vector<Interface>& interfaces);
+static bool findUInt(const char* obj, const char* objEnd, const char* key, uint64_t& value);
+static bool findString(const char* obj, const char* objEnd, const char* key, std::string& value);
+static std::string escapeJson(const std::string& str);
+static int runInfo(int argc, char* argv[]);
+static int runQuery(int argc, char* argv[]);
+static void printAggregate(const SampleStore& store, uint64_t from, uint64_t to, const SampleStore::Aggregate& aggregate);
+static int runGenerate(int argc, char* argv[]);
+static void printUsage(const char* prgName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** 1 day in s */
+static const uint64_t   DAY     = 86400U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Process entry point.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    if (2 > argc)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* The options of the command follow the command. */
+    if (0 == strcmp(argv[1], "import"))
+    {
+        return runImport(argc - 1, argv + 1);
+    }
+    else if (0 == strcmp(argv[1], "info"))
+    {
+        return runInfo(argc - 1, argv + 1);
+    }
+    else if (0 == strcmp(argv[1], "query"))
+    {
+        return runQuery(argc - 1, argv + 1);
+    }
+    else if (0 == strcmp(argv[1], "generate"))
+    {
+        return runGenerate(argc - 1, argv + 1);
+    }
+    else if (0 == strcmp(argv[1], "bench"))
+    {
+        return runKernelBench(argc - 1, argv + 1);
+    }
+    else
+    {
+        printUsage(argv[0]);
+    }
+
+    return (0 == strcmp(argv[1], "--help")) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the monotonic time.
+ *
+ * @return Time in us
+ */
+static uint64_t getMicros(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (static_cast<uint64_t>(ts.tv_sec) * 1000000ULL) + static_cast<uint64_t>(ts.tv_nsec / 1000);
+}
+
+/**
+ * Import recorded responses of GET /api/s0-interfaces from files or stdin.
+ * The store file of a S0 interface is <dir>/<device>-<id>.s0ts, it is created
+ * if it doesn't exist.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+static int runImport(int argc, char* argv[])
+{
+    static const struct option                          longOptions[] =
+    {
+        { "dir",        required_argument,  nullptr,    'd' },
+        { "device",     required_argument,  nullptr,    'n' },
+        { nullptr,      0,                  nullptr,    0   }
+    };
+    std::map<uint64_t, std::unique_ptr<SampleStore>>    stores;
+    std::string                                         dir             = ".";
+    std::string                                         device          = "device";
+    uint64_t                                            numImported     = 0U;
+    uint64_t                                            numSkipped      = 0U;
+    bool                                                isSuccessful    = true;
+    int                                                 opt             = 0;
+
+    while(-1 != (opt = getopt_long(argc, argv, "d:n:", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 'd':
+            dir = optarg;
+            break;
+
+        case 'n':
+            device = optarg;
+            break;
+
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind >= argc)
+    {
+        isSuccessful = importFile(stdin, "stdin", dir, device, stores, numImported, numSkipped);
+    }
+
+    for(; (true == isSuccessful) && (optind < argc); ++optind)
+    {
+        FILE* fd = fopen(argv[optind], "r");
+
+        if (nullptr == fd)
+        {
+            perror(argv[optind]);
+            isSuccessful = false;
+        }
+        else
+        {
+            isSuccessful = importFile(fd, argv[optind], dir, device, stores, numImported, numSkipped);
+            (void)fclose(fd);
+        }
+    }
+
+    for(auto& store : stores)
+    {
+        if (false == store.second->flush())
+        {
+            fprintf(stderr, "Failed to write the store of S0 interface %llu.\n", static_cast<unsigned long long>(store.first));
+            isSuccessful = false;
+        }
+    }
+
+    printf("{\"imported\":%llu,\"skipped\":%llu,\"stores\":%zu}\n",
+        static_cast<unsigned long long>(numImported),
+        static_cast<unsigned long long>(numSkipped),
+        stores.size());
+
+    return (true == isSuccessful) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * Import the recorded responses of a file. Samples, which are not newer than
+ * the last one in the store, are skipped, therefore a file can be imported
+ * again after it grew.
+ *
+ * @param[in]       fd          File
+ * @param[in]       fileName    File name, used for the error messages
+ * @param[in]       dir         Directory of the store files
+ * @param[in]       device      Device name
+ * @param[in,out]   stores      Opened stores by S0 interface id
+ * @param[in,out]   numImported Number of imported samples
+ * @param[in,out]   numSkipped  Number of skipped samples
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool importFile(FILE* fd, const char* fileName, const std::string& dir, const std::string& device,
+                       std::map<uint64_t, std::unique_ptr<SampleStore>>& stores, uint64_t& numImported, uint64_t& numSkipped)
+{
+    std::vector<char>   line(64U * 1024U);
+    uint32_t            lineNo  = 0U;
+
+    while(nullptr != fgets(line.data(), static_cast<int>(line.size()), fd))
+    {
+        char*                   json        = nullptr;
+        double                  timestamp   = strtod(line.data(), &json);
+        std::vector<Interface>  interfaces;
+
+        ++lineNo;
+
+        if (('\n' == line[0]) || ('#' == line[0]))
+        {
+            continue;
+        }
+
+        if ((json == line.data()) ||
+            (0.0 >= timestamp) ||
+            (false == parseInterfaces(json, interfaces)))
+        {
+            fprintf(stderr, "%s:%u: Invalid response, skipped.\n", fileName, lineNo);
+            continue;
+        }
+
+        for(const Interface& interface : interfaces)
+        {
+            std::unique_ptr<SampleStore>&   store   = stores[interface.id];
+            SampleStore::Record             record;
+
+            if (nullptr == store)
+            {
+                std::string storeFile = dir + "/" + device + "-" + std::to_string(interface.id) + ".s0ts";
+
+                store.reset(new SampleStore());
+
+                if ((false == store->open(storeFile.c_str(), true)) &&
+                    (false == store->create(storeFile.c_str(), interface.name.c_str(), static_cast<uint32_t>(interface.pulsesPerKWh))))
+                {
+                    perror(storeFile.c_str());
+                    return false;
+                }
+            }
+
+            record.time     = static_cast<uint64_t>(llround(timestamp * 1000.0));
+            record.counter  = static_cast<uint32_t>(interface.pulses);
+            record.power    = static_cast<uint32_t>(interface.power);
+
+            if (true == store->append(record))
+            {
+                ++numImported;
+            }
+            else
+            {
+                ++numSkipped;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Parse the S0 interfaces of a response of GET /api/s0-interfaces, which has
+ * the layout of S0Model::toJson().
+ *
+ * @param[in]   json        Response
+ * @param[out]  interfaces  S0 interfaces
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool parseInterfaces(const char* json, std::vector<Interface>& interfaces)
+{
+    const char* pos = strstr(json, "\"data\"");
+
+    if (nullptr == pos)
+    {
+        return false;
+    }
+
+    pos = strchr(pos, '[');
+
+    if (nullptr == pos)
+    {
+        return false;
+    }
+
+    /* Every object of the array is a S0 interface, a brace in a string doesn't count. */
+    while(nullptr != (pos = strpbrk(pos + 1, "{]")))
+    {
+        const char* objEnd      = pos + 1;
+        bool        isInString  = false;
+        Interface   interface;
+
+        if (']' == *pos)
+        {
+            return true;
+        }
+
+        while(('\0' != *objEnd) && ((true == isInString) || ('}' != *objEnd)))
+        {
+            if (('\\' == *objEnd) && (true == isInString) && ('\0' != objEnd[1]))
+            {
+                ++objEnd;
+            }
+            else if ('"' == *objEnd)
+            {
+                isInString = !isInString;
+            }
+            else
+            {
+                ;
+            }
+
+            ++objEnd;
+        }
+
+        if (('\0' == *objEnd) ||
+            (false == findUInt(pos, objEnd, "\"id\":", interface.id)) ||
+            (false == findUInt(pos, objEnd, "\"pulsesPer1KWh\":", interface.pulsesPerKWh)) ||
+            (false == findUInt(pos, objEnd, "\"powerConsumption\":", interface.power)) ||
+            (false == findUInt(pos, objEnd, "\"pulses\":", interface.pulses)))
+        {
+            return false;
+        }
+
+        (void)findString(pos, objEnd, "\"name\":\"", interface.name);
+
+        interfaces.push_back(interface);
+        pos = objEnd;
+    }
+
+    return false;
+}
+
+/**
+ * Find a unsigned integer value in a JSON object.
+ *
+ * @param[in]   obj     Begin of the object
+ * @param[in]   objEnd  End of the object
+ * @param[in]   key     Quoted key with colon
+ * @param[out]  value   Value
+ *
+ * @return If found, it will return true otherwise false.
+ */
+static bool findUInt(const char* obj, const char* objEnd, const char* key, uint64_t& value)
+{
+    std::string str(obj, objEnd);
+    size_t      pos = str.find(key);
+
+    if (std::string::npos == pos)
+    {
+        return false;
+    }
+
+    value = strtoull(str.c_str() + pos + strlen(key), nullptr, 10);
+
+    return true;
+}
+
+/**
+ * Find a string value in a JSON object. Escaped characters are kept escaped,
+ * except quotes and backslashes.
+ *
+ * @param[in]   obj     Begin of the object
+ * @param[in]   objEnd  End of the object
+ * @param[in]   key     Quoted key with colon and opening quote
+ * @param[out]  value   Value
+ *
+ * @return If found, it will return true otherwise false.
+ */
+static bool findString(const char* obj, const char* objEnd, const char* key, std::string& value)
+{
+    std::string str(obj, objEnd);
+    size_t      pos = str.find(key);
+
+    if (std::string::npos == pos)
+    {
+        return false;
+    }
+
+    for(pos += strlen(key); (str.size() > pos) && ('"' != str[pos]); ++pos)
+    {
+        if (('\\' == str[pos]) && ((str.size() - 1U) > pos) && (nullptr != strchr("\"\\", str[pos + 1U])))
+        {
+            ++pos;
+        }
+
+        value += str[pos];
+    }
+
+    return true;
+}
+
+/**
+ * Escape a string for a JSON string value.
+ *
+ * @param[in] str   String
+ *
+ * @return Escaped string
+ */
+static std::string escapeJson(const std::string& str)
+{
+    std::string escaped;
+
+    for(char c : str)
+    {
+        if (('"' == c) || ('\\' == c))
+        {
+            escaped += '\\';
+        }
+
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+/**
+ * Print a summary of a store file.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+static int runInfo(int argc, char* argv[])
+{
+    SampleStore         store;
+    SampleStore::Record first;
+    SampleStore::Record last;
+    uint64_t            count   = 0U;
+
+    if ((2 != argc) || (false == store.open(argv[1], false)))
+    {
+        fprintf(stderr, "Can't open the store %s.\n", (2 <= argc) ? argv[1] : "");
+        return EXIT_FAILURE;
+    }
+
+    count = store.getCount();
+
+    printf("{\"name\":\"%s\",\"pulsesPerKWh\":%u,\"samples\":%llu,\"blocks\":%zu,\"fileSize\":%llu,\"bytesPerSample\":%.2f",
+        escapeJson(store.getName()).c_str(),
+        store.getPulsesPerKWh(),
+        static_cast<unsigned long long>(count),
+        store.getNumBlocks(),
+        static_cast<unsigned long long>(store.getFileSize()),
+        (0U < count) ? (static_cast<double>(store.getFileSize()) / static_cast<double>(count)) : 0.0);
+
+    if ((true == store.getFirst(first)) && (true == store.getLast(last)))
+    {
+        printf(",\"first\":%.3f,\"last\":%.3f", first.time / 1000.0, last.time / 1000.0);
+    }
+
+    printf("}\n");
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Aggregate a time range of a store file, optionally in steps.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+static int runQuery(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "from",   required_argument,  nullptr,    'f' },
+        { "to",     required_argument,  nullptr,    't' },
+        { "step",   required_argument,  nullptr,    's' },
+        { nullptr,  0,                  nullptr,    0   }
+    };
+    SampleStore                 store;
+    SampleStore::Record         first;
+    SampleStore::Record         last;
+    uint64_t                    from        = 0U;
+    uint64_t                    to          = 0U;
+    uint64_t                    step        = 0U;
+    uint64_t                    start       = 0U;
+    uint64_t                    numSteps    = 0U;
+    bool                        isFromSet   = false;
+    bool                        isToSet     = false;
+    int                         opt         = 0;
+
+    while(-1 != (opt = getopt_long(argc, argv, "f:t:s:", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 'f':
+            from        = static_cast<uint64_t>(llround(strtod(optarg, nullptr) * 1000.0));
+            isFromSet   = true;
+            break;
+
+        case 't':
+            to          = static_cast<uint64_t>(llround(strtod(optarg, nullptr) * 1000.0));
+            isToSet     = true;
+            break;
+
+        case 's':
+            step = static_cast<uint64_t>(llround(strtod(optarg, nullptr) * 1000.0));
+            break;
+
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (((optind + 1) != argc) || (false == store.open(argv[optind], false)))
+    {
+        fprintf(stderr, "Can't open the store %s.\n", (optind < argc) ? argv[optind] : "");
+        return EXIT_FAILURE;
+    }
+
+    if ((false == store.getFirst(first)) || (false == store.getLast(last)))
+    {
+        fprintf(stderr, "The store is empty.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (false == isFromSet)
+    {
+        from = first.time;
+    }
+
+    if (false == isToSet)
+    {
+        to = last.time + 1U;
+    }
+
+    if (0U == step)
+    {
+        step = to - from;
+    }
+
+    start = getMicros();
+
+    for(uint64_t stepFrom = from; stepFrom < to; stepFrom += step)
+    {
+        uint64_t                stepTo = std::min(stepFrom + step, to);
+        SampleStore::Aggregate  aggregate;
+
+        if (false == store.aggregate(stepFrom, stepTo, aggregate))
+        {
+            fprintf(stderr, "The store is corrupt.\n");
+            return EXIT_FAILURE;
+        }
+
+        printAggregate(store, stepFrom, stepTo, aggregate);
+        ++numSteps;
+    }
+
+    fprintf(stderr, "{\"steps\":%llu,\"durationUs\":%llu}\n",
+        static_cast<unsigned long long>(numSteps),
+        static_cast<unsigned long long>(getMicros() - start));
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Print a aggregation as JSON line.
+ *
+ * @param[in] store     Store
+ * @param[in] from      Start of the range in ms
+ * @param[in] to        End of the range in ms
+ * @param[in] aggregate Aggregation
+ */
+static void printAggregate(const SampleStore& store, uint64_t from, uint64_t to, const SampleStore::Aggregate& aggregate)
+{
+    double samples = (0U == aggregate.count) ? 1.0 : static_cast<double>(aggregate.count);
+
+    printf("{\"from\":%.3f,\"to\":%.3f,\"samples\":%llu,\"meanPowerW\":%.1f,\"minPowerW\":%u,\"maxPowerW\":%u,\"pulses\":%llu,\"energyWh\":%.1f}\n",
+        from / 1000.0,
+        to / 1000.0,
+        static_cast<unsigned long long>(aggregate.count),
+        static_cast<double>(aggregate.sumPower) / samples,
+        aggregate.minPower,
+        aggregate.maxPower,
+        static_cast<unsigned long long>(aggregate.pulses),
+        (0U < store.getPulsesPerKWh()) ? (static_cast<double>(aggregate.pulses) * 1000.0 / store.getPulsesPerKWh()) : 0.0);
+
+    return;
+}
+
+/**
+ * Generate synthetic samples: a base load with a daily profile and a
+ * consumer, which is switched on and off pseudo randomly.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+static int runGenerate(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "days",           required_argument,  nullptr,    'd' },
+        { "interval",       required_argument,  nullptr,    'i' },
+        { "start",          required_argument,  nullptr,    's' },
+        { "pulses-per-kwh", required_argument,  nullptr,    'p' },
+        { nullptr,          0,                  nullptr,    0   }
+    };
+    SampleStore                 store;
+    uint64_t                    days            = 365U;
+    uint64_t                    interval        = 1000U;
+    uint64_t                    startTime       = 1704067200000ULL;
+    uint32_t                    pulsesPerKWh    = 1000U;
+    uint64_t                    end             = 0U;
+    uint64_t                    start           = 0U;
+    uint32_t                    random          = 0x12345678U;
+    uint32_t                    consumer        = 0U;
+    double                      energy          = 0.0;
+    uint64_t                    count           = 0U;
+    int                         opt             = 0;
+
+    while(-1 != (opt = getopt_long(argc, argv, "d:i:s:p:", longOptions, nullptr)))
+    {
+        switch(opt)
+        {
+        case 'd':
+            days = strtoull(optarg, nullptr, 0);
+            break;
+
+        case 'i':
+            interval = static_cast<uint64_t>(llround(strtod(optarg, nullptr) * 1000.0));
+            break;
+
+        case 's':
+            startTime = strtoull(optarg, nullptr, 0) * 1000U;
+            break;
+
+        case 'p':
+            pulsesPerKWh = static_cast<uint32_t>(strtoul(optarg, nullptr, 0));
+            break;
+
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (((optind + 1) != argc) ||
+        (0U == interval) ||
+        (0U == pulsesPerKWh) ||
+        (false == store.create(argv[optind], "generated", pulsesPerKWh)))
+    {
+        fprintf(stderr, "Can't create the store.\n");
+        return EXIT_FAILURE;
+    }
+
+    end     = startTime + days * DAY * 1000U;
+    start   = getMicros();
+
+    for(uint64_t time = startTime; time < end; time += interval)
+    {
+        double              dayPhase    = static_cast<double>((time / 1000U) % DAY) / static_cast<double>(DAY);
+        double              power       = 250.0 + 150.0 * sin(2.0 * M_PI * dayPhase);
+        SampleStore::Record record;
+
+        /* A consumer with 2 kW, switched with a probability of 1 / 1800 per sample. */
+        random ^= random << 13U;
+        random ^= random >> 17U;
+        random ^= random << 5U;
+
+        if (0U == (random % 1800U))
+        {
+            consumer = (0U == consumer) ? 2000U : 0U;
+        }
+
+        power  += consumer;
+        energy += power * static_cast<double>(interval) / 1000.0;
+
+        record.time     = time;
+        record.counter  = static_cast<uint32_t>(energy * pulsesPerKWh / 3600000.0);
+        record.power    = static_cast<uint32_t>(power);
+
+        if (false == store.append(record))
+        {
+            fprintf(stderr, "Failed to append a sample.\n");
+            return EXIT_FAILURE;
+        }
+
+        ++count;
+    }
+
+    store.close();
+
+    fprintf(stderr, "{\"samples\":%llu,\"durationUs\":%llu}\n",
+        static_cast<unsigned long long>(count),
+        static_cast<unsigned long long>(getMicros() - start));
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Print the command line usage.
+ *
+ * @param[in] prgName   Program name
+ */
+static void printUsage(const char* prgName)
+{
+    printf("Usage: %s COMMAND [options]\n", prgName);
+    printf("  import [--dir DIR] [--device NAME] [FILE...]\n");
+    printf("      Import recorded responses of GET /api/s0-interfaces, one per line after a unix\n");
+    printf("      timestamp in s. The store of a S0 interface is DIR/NAME-<id>.s0ts.\n");
+    printf("  info STORE\n");
+    printf("      Show a summary of a store.\n");
+    printf("  query [--from T] [--to T] [--step S] STORE\n");
+    printf("      Aggregate a time range (unix timestamps in s), optionally in steps of S seconds.\n");
+    printf("  generate [--days N] [--interval S] [--start T] [--pulses-per-kwh N] STORE\n");
+    printf("      Generate synthetic samples, e.g. for benchmarks.\n");
+    printf("  bench [--size MiB] [--rounds N] [--filter TEXT]\n");
+    printf("      Benchmark the scalar, SSE2 and AVX2 aggregation kernels.\n");
+}
@@ -0,0 +1,867 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Columnar time series store of the S0 interface samples
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SampleStore.h"
+#include "Kernels.h"
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Header at the begin of the file.
+ */
+struct FileHeader
+{
+    char        magic[4];       /**< Magic "S0TS" */
+    uint8_t     version;        /**< Format version */
+    uint8_t     reserved[3];    /**< Reserved, 0 */
+    uint32_t    pulsesPerKWh;   /**< Pulses per kWh */
+    uint32_t    blockCapacity;  /**< Number of samples per block */
+    uint64_t    numBlocks;      /**< Number of sealed blocks */
+    uint64_t    tailOffset;     /**< File offset of the tail */
+    char        name[32];       /**< Name of the S0 interface, zero terminated */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void putVarint(std::vector<uint8_t>& data, uint64_t value);
+static bool getVarint(const uint8_t*& data, const uint8_t* end, uint64_t& value);
+static bool getVarintColumn(const uint8_t* data, const uint8_t* end, uint32_t* values, size_t count);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Magic at the begin of the file. */
+static const char       MAGIC[4]    = { 'S', '0', 'T', 'S' };
+
+/** Format version */
+static const uint8_t    VERSION     = 1U;
+
+static_assert(64U == sizeof(FileHeader), "The file header layout changed.");
+static_assert(16U == sizeof(SampleStore::Record), "The record layout changed.");
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+SampleStore::SampleStore() :
+    m_fileName(),
+    m_fd(-1),
+    m_isWritable(false),
+    m_name(),
+    m_pulsesPerKWh(0U),
+    m_blockCapacity(DEFAULT_BLOCK_CAPACITY),
+    m_blocks(),
+    m_tailOffset(0U),
+    m_tail(),
+    m_numWritten(0U),
+    m_map(nullptr),
+    m_mapSize(0U),
+    m_times(),
+    m_counters(),
+    m_powers(),
+    m_decodedOffset(0U)
+{
+    static_assert(64U == sizeof(BlockHeader), "The block header layout changed.");
+}
+
+SampleStore::~SampleStore()
+{
+    close();
+}
+
+bool SampleStore::create(const char* fileName, const char* name, uint32_t pulsesPerKWh, uint32_t blockCapacity)
+{
+    close();
+
+    if ((nullptr == fileName) || (nullptr == name) || (0U == blockCapacity))
+    {
+        return false;
+    }
+
+    m_fd = ::open(fileName, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (0 > m_fd)
+    {
+        return false;
+    }
+
+    m_fileName      = fileName;
+    m_isWritable    = true;
+    m_name          = std::string(name).substr(0U, sizeof(FileHeader().name) - 1U);
+    m_pulsesPerKWh  = pulsesPerKWh;
+    m_blockCapacity = blockCapacity;
+    m_tailOffset    = sizeof(FileHeader);
+
+    if (false == writeFileHeader())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SampleStore::open(const char* fileName, bool isWritable)
+{
+    struct stat     info;
+    FileHeader      header;
+    uint64_t        offset  = sizeof(FileHeader);
+    uint64_t        idx     = 0U;
+    const uint8_t*  tail    = nullptr;
+    size_t          numTail = 0U;
+
+    close();
+
+    m_fd = ::open(fileName, ((true == isWritable) ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+
+    if (0 > m_fd)
+    {
+        return false;
+    }
+
+    m_fileName      = fileName;
+    m_isWritable    = isWritable;
+
+    if ((0 != fstat(m_fd, &info)) ||
+        (sizeof(FileHeader) > static_cast<uint64_t>(info.st_size)) ||
+        (false == map(static_cast<uint64_t>(info.st_size))))
+    {
+        close();
+        return false;
+    }
+
+    memcpy(&header, m_map, sizeof(header));
+
+    if ((0 != memcmp(header.magic, MAGIC, sizeof(MAGIC))) ||
+        (VERSION != header.version) ||
+        (0U == header.blockCapacity) ||
+        (header.tailOffset > m_mapSize))
+    {
+        close();
+        return false;
+    }
+
+    header.name[sizeof(header.name) - 1U] = '\0';
+
+    m_name          = header.name;
+    m_pulsesPerKWh  = header.pulsesPerKWh;
+    m_blockCapacity = header.blockCapacity;
+    m_tailOffset    = header.tailOffset;
+
+    /* Build the index of the sealed blocks. */
+    for(idx = 0U; idx < header.numBlocks; ++idx)
+    {
+        Block block;
+
+        if ((offset + sizeof(BlockHeader)) > m_tailOffset)
+        {
+            close();
+            return false;
+        }
+
+        memcpy(&block.header, m_map + offset, sizeof(BlockHeader));
+        block.offset = offset;
+
+        offset += sizeof(BlockHeader) + block.header.dataSize;
+
+        if ((offset > m_tailOffset) ||
+            (0U == block.header.count) ||
+            ((block.header.timeSize + block.header.counterSize) > block.header.dataSize))
+        {
+            close();
+            return false;
+        }
+
+        m_blocks.push_back(block);
+    }
+
+    /* The samples of the open block. A incomplete record, e.g. after a crash, is dropped. */
+    tail    = m_map + m_tailOffset;
+    numTail = (m_mapSize - m_tailOffset) / sizeof(Record);
+
+    m_tail.resize(numTail);
+
+    if (0U < numTail)
+    {
+        memcpy(m_tail.data(), tail, numTail * sizeof(Record));
+    }
+
+    m_numWritten = numTail;
+
+    return true;
+}
+
+void SampleStore::close(void)
+{
+    if (0 <= m_fd)
+    {
+        if (true == m_isWritable)
+        {
+            (void)flush();
+        }
+
+        unmap();
+        (void)::close(m_fd);
+        m_fd = -1;
+    }
+
+    m_blocks.clear();
+    m_tail.clear();
+    m_times.clear();
+    m_counters.clear();
+    m_powers.clear();
+    m_decodedOffset = 0U;
+    m_numWritten    = 0U;
+    m_tailOffset    = 0U;
+    m_isWritable    = false;
+
+    return;
+}
+
+bool SampleStore::append(const Record& record)
+{
+    Record last;
+
+    if ((0 > m_fd) || (false == m_isWritable))
+    {
+        return false;
+    }
+
+    if ((true == getLast(last)) && (last.time >= record.time))
+    {
+        return false;
+    }
+
+    m_tail.push_back(record);
+
+    if (m_blockCapacity <= m_tail.size())
+    {
+        return seal();
+    }
+
+    return true;
+}
+
+bool SampleStore::flush(void)
+{
+    size_t  size    = (m_tail.size() - m_numWritten) * sizeof(Record);
+    off_t   offset  = static_cast<off_t>(m_tailOffset + m_numWritten * sizeof(Record));
+
+    if ((0 > m_fd) || (false == m_isWritable))
+    {
+        return false;
+    }
+
+    if (0U < size)
+    {
+        if (static_cast<ssize_t>(size) != pwrite(m_fd, &m_tail[m_numWritten], size, offset))
+        {
+            return false;
+        }
+
+        m_numWritten = m_tail.size();
+    }
+
+    return true;
+}
+
+bool SampleStore::aggregate(uint64_t from, uint64_t to, Aggregate& aggregate)
+{
+    uint32_t    previous    = 0U;
+    bool        hasPrevious = false;
+    size_t      idx         = 0U;
+
+    memset(&aggregate, 0, sizeof(aggregate));
+    aggregate.minPower = UINT32_MAX;
+
+    /* First block, which ends in the range or after it. */
+    idx = std::lower_bound(m_blocks.begin(), m_blocks.end(), from,
+        [](const Block& block, uint64_t time) { return block.header.lastTime < time; }) - m_blocks.begin();
+
+    if (0U < idx)
+    {
+        previous    = m_blocks[idx - 1U].header.lastCounter;
+        hasPrevious = true;
+    }
+
+    for(; (m_blocks.size() > idx) && (to > m_blocks[idx].header.firstTime); ++idx)
+    {
+        const Block&        block   = m_blocks[idx];
+        const BlockHeader&  header  = block.header;
+
+        if ((from <= header.firstTime) && (to > header.lastTime))
+        {
+            /* The block is covered completely, its summary is enough. */
+            if (0U == aggregate.count)
+            {
+                aggregate.firstTime = header.firstTime;
+            }
+
+            aggregate.count     += header.count;
+            aggregate.lastTime   = header.lastTime;
+            aggregate.minPower   = std::min(aggregate.minPower, header.minPower);
+            aggregate.maxPower   = std::max(aggregate.maxPower, header.maxPower);
+            aggregate.sumPower  += header.sumPower;
+            aggregate.pulses    += header.pulses;
+
+            if (true == hasPrevious)
+            {
+                aggregate.pulses += countPulses(previous, header.firstCounter);
+            }
+
+            previous    = header.lastCounter;
+            hasPrevious = true;
+        }
+        else
+        {
+            const Kernels::Table&   kernels = Kernels::get();
+            size_t                  begin   = 0U;
+            size_t                  end     = 0U;
+
+            if (false == decode(block))
+            {
+                return false;
+            }
+
+            begin   = std::lower_bound(m_times.begin(), m_times.end(), from) - m_times.begin();
+            end     = std::lower_bound(m_times.begin() + begin, m_times.end(), to) - m_times.begin();
+
+            if (begin < end)
+            {
+                Kernels::Summary summary;
+
+                kernels.summarize(&m_powers[begin], end - begin, summary);
+
+                if (0U == aggregate.count)
+                {
+                    aggregate.firstTime = m_times[begin];
+                }
+
+                aggregate.count     += end - begin;
+                aggregate.lastTime   = m_times[end - 1U];
+                aggregate.minPower   = std::min(aggregate.minPower, summary.min);
+                aggregate.maxPower   = std::max(aggregate.maxPower, summary.max);
+                aggregate.sumPower  += summary.sum;
+
+                /* The first sample of the store has no predecessor, its pulses are 0. */
+                if (0U < begin)
+                {
+                    previous = m_counters[begin - 1U];
+                }
+                else if (false == hasPrevious)
+                {
+                    previous = m_counters[begin];
+                }
+                else
+                {
+                    ;
+                }
+
+                aggregate.pulses += kernels.countPulses(&m_counters[begin], end - begin, previous);
+            }
+
+            previous    = m_counters.back();
+            hasPrevious = true;
+        }
+    }
+
+    /* The samples of the open block. */
+    for(const Record& record : m_tail)
+    {
+        if (to <= record.time)
+        {
+            break;
+        }
+
+        if (from <= record.time)
+        {
+            addRecord(aggregate, record);
+
+            if (true == hasPrevious)
+            {
+                aggregate.pulses += countPulses(previous, record.counter);
+            }
+        }
+
+        previous    = record.counter;
+        hasPrevious = true;
+    }
+
+    if (0U == aggregate.count)
+    {
+        aggregate.minPower = 0U;
+    }
+
+    return true;
+}
+
+uint64_t SampleStore::getCount(void) const
+{
+    uint64_t count = m_tail.size();
+
+    for(const Block& block : m_blocks)
+    {
+        count += block.header.count;
+    }
+
+    return count;
+}
+
+bool SampleStore::getFirst(Record& record)
+{
+    if (false == m_blocks.empty())
+    {
+        record.time     = m_blocks.front().header.firstTime;
+        record.counter  = m_blocks.front().header.firstCounter;
+
+        /* The power of the first sample is only in the column. */
+        if (false == decode(m_blocks.front()))
+        {
+            return false;
+        }
+
+        record.power = m_powers.front();
+
+        return true;
+    }
+
+    if (false == m_tail.empty())
+    {
+        record = m_tail.front();
+        return true;
+    }
+
+    return false;
+}
+
+bool SampleStore::getLast(Record& record) const
+{
+    if (false == m_tail.empty())
+    {
+        record = m_tail.back();
+        return true;
+    }
+
+    if (false == m_blocks.empty())
+    {
+        /* The tail is empty right after sealing, the power isn't needed by the callers. */
+        record.time     = m_blocks.back().header.lastTime;
+        record.counter  = m_blocks.back().header.lastCounter;
+        record.power    = 0U;
+
+        return true;
+    }
+
+    return false;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * Write the file header with the current number of blocks and tail offset.
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool SampleStore::writeFileHeader(void)
+{
+    FileHeader header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version          = VERSION;
+    header.pulsesPerKWh     = m_pulsesPerKWh;
+    header.blockCapacity    = m_blockCapacity;
+    header.numBlocks        = m_blocks.size();
+    header.tailOffset       = m_tailOffset;
+    strncpy(header.name, m_name.c_str(), sizeof(header.name) - 1U);
+
+    return static_cast<ssize_t>(sizeof(header)) == pwrite(m_fd, &header, sizeof(header), 0);
+}
+
+/**
+ * Seal the open block: encode its columns, write it over the tail and
+ * afterwards commit it in the file header.
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool SampleStore::seal(void)
+{
+    Block                   block;
+    BlockHeader&            header      = block.header;
+    std::vector<uint8_t>    data;
+    std::vector<uint8_t>    counters;
+    std::vector<uint8_t>    powers;
+    Record                  previous    = { 0U, 0U, 0U };
+    size_t                  idx         = 0U;
+
+    memset(&header, 0, sizeof(header));
+    header.firstTime    = m_tail.front().time;
+    header.lastTime     = m_tail.back().time;
+    header.count        = static_cast<uint32_t>(m_tail.size());
+    header.firstCounter = m_tail.front().counter;
+    header.lastCounter  = m_tail.back().counter;
+    header.minPower     = UINT32_MAX;
+
+    data.reserve(sizeof(BlockHeader) + 3U * m_tail.size());
+    data.resize(sizeof(BlockHeader));
+
+    for(idx = 0U; idx < m_tail.size(); ++idx)
+    {
+        const Record& record = m_tail[idx];
+
+        putVarint(data, record.time - previous.time);
+        putVarint(counters, Kernels::toZigzagDelta(previous.counter, record.counter));
+        putVarint(powers, Kernels::toZigzagDelta(previous.power, record.power));
+
+        header.minPower  = std::min(header.minPower, record.power);
+        header.maxPower  = std::max(header.maxPower, record.power);
+        header.sumPower += record.power;
+
+        if (0U < idx)
+        {
+            header.pulses += countPulses(previous.counter, record.counter);
+        }
+
+        previous = record;
+    }
+
+    header.timeSize     = static_cast<uint32_t>(data.size() - sizeof(BlockHeader));
+    header.counterSize  = static_cast<uint32_t>(counters.size());
+
+    data.insert(data.end(), counters.begin(), counters.end());
+    data.insert(data.end(), powers.begin(), powers.end());
+
+    header.dataSize = static_cast<uint32_t>(data.size() - sizeof(BlockHeader));
+    memcpy(data.data(), &header, sizeof(header));
+
+    block.offset = m_tailOffset;
+
+    /* The block is written over the tail. It becomes valid with the file header. */
+    if (static_cast<ssize_t>(data.size()) != pwrite(m_fd, data.data(), data.size(), static_cast<off_t>(block.offset)))
+    {
+        return false;
+    }
+
+    m_blocks.push_back(block);
+    m_tailOffset += data.size();
+    m_tail.clear();
+    m_numWritten = 0U;
+
+    if ((false == writeFileHeader()) ||
+        (0 != ftruncate(m_fd, static_cast<off_t>(m_tailOffset))))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Map the file read-only.
+ *
+ * @param[in] size  Size in bytes, which to map
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool SampleStore::map(uint64_t size)
+{
+    void* addr = nullptr;
+
+    unmap();
+
+    addr = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, m_fd, 0);
+
+    if (MAP_FAILED == addr)
+    {
+        return false;
+    }
+
+    /* Range queries read the blocks mostly sequentially. */
+    (void)madvise(addr, static_cast<size_t>(size), MADV_SEQUENTIAL);
+
+    m_map       = static_cast<const uint8_t*>(addr);
+    m_mapSize   = static_cast<size_t>(size);
+
+    return true;
+}
+
+/**
+ * Unmap the file, if it is mapped.
+ */
+void SampleStore::unmap(void)
+{
+    if (nullptr != m_map)
+    {
+        (void)munmap(const_cast<uint8_t*>(m_map), m_mapSize);
+
+        m_map       = nullptr;
+        m_mapSize   = 0U;
+    }
+
+    return;
+}
+
+/**
+ * Decode the columns of a sealed block into m_times, m_counters and
+ * m_powers. The block is read from the mapped file, which is mapped again,
+ * if it grew since. Sealed blocks don't change, therefore the last decoded
+ * block is kept, because queries in steps decode the border block of two
+ * consecutive steps.
+ *
+ * @param[in]   block   Sealed block
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool SampleStore::decode(const Block& block)
+{
+    const Kernels::Table&   kernels     = Kernels::get();
+    const BlockHeader&      header      = block.header;
+    uint64_t                end         = block.offset + sizeof(BlockHeader) + header.dataSize;
+    const uint8_t*          times       = nullptr;
+    const uint8_t*          counters    = nullptr;
+    const uint8_t*          powers      = nullptr;
+    uint64_t                time        = 0U;
+    uint32_t                idx         = 0U;
+
+    if (block.offset == m_decodedOffset)
+    {
+        return true;
+    }
+
+    m_decodedOffset = 0U;
+
+    if ((0U == header.count) ||
+        ((header.timeSize + header.counterSize) > header.dataSize) ||
+        ((m_mapSize < end) && (false == map(m_tailOffset))) ||
+        (m_mapSize < end))
+    {
+        return false;
+    }
+
+    times       = m_map + block.offset + sizeof(BlockHeader);
+    counters    = times + header.timeSize;
+    powers      = counters + header.counterSize;
+
+    m_times.resize(header.count);
+    m_counters.resize(header.count);
+    m_powers.resize(header.count);
+
+    for(idx = 0U; idx < header.count; ++idx)
+    {
+        uint64_t delta = 0U;
+
+        if (false == getVarint(times, counters, delta))
+        {
+            return false;
+        }
+
+        time        += delta;
+        m_times[idx] = time;
+    }
+
+    if ((false == getVarintColumn(counters, powers, m_counters.data(), header.count)) ||
+        (false == getVarintColumn(powers, m_map + end, m_powers.data(), header.count)))
+    {
+        return false;
+    }
+
+    kernels.decodeDeltas(m_counters.data(), header.count, 0U);
+    kernels.decodeDeltas(m_powers.data(), header.count, 0U);
+
+    m_decodedOffset = block.offset;
+
+    return true;
+}
+
+/**
+ * Count the pulses between two samples. A decreasing counter means, that
+ * the device restarted and counts from 0 again.
+ *
+ * @param[in] previous  Counter of the previous sample
+ * @param[in] current   Counter of the current sample
+ *
+ * @return Number of pulses
+ */
+uint32_t SampleStore::countPulses(uint32_t previous, uint32_t current)
+{
+    return (current >= previous) ? (current - previous) : current;
+}
+
+/**
+ * Add a sample to a aggregation, except its pulses.
+ *
+ * @param[in,out]   aggregate   Aggregation
+ * @param[in]       record      Sample
+ */
+void SampleStore::addRecord(Aggregate& aggregate, const Record& record)
+{
+    if (0U == aggregate.count)
+    {
+        aggregate.firstTime = record.time;
+    }
+
+    ++aggregate.count;
+    aggregate.lastTime   = record.time;
+    aggregate.minPower   = std::min(aggregate.minPower, record.power);
+    aggregate.maxPower   = std::max(aggregate.maxPower, record.power);
+    aggregate.sumPower  += record.power;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Append a unsigned LEB128 varint.
+ *
+ * @param[in,out]   data    Buffer
+ * @param[in]       value   Value
+ */
+static void putVarint(std::vector<uint8_t>& data, uint64_t value)
+{
+    while(0x80U <= value)
+    {
+        data.push_back(static_cast<uint8_t>(value & 0x7FU) | 0x80U);
+        value >>= 7U;
+    }
+
+    data.push_back(static_cast<uint8_t>(value));
+
+    return;
+}
+
+/**
+ * Read a unsigned LEB128 varint.
+ *
+ * @param[in,out]   data    Read position, afterwards behind the varint.
+ * @param[in]       end     End of the data
+ * @param[out]      value   Value
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool getVarint(const uint8_t*& data, const uint8_t* end, uint64_t& value)
+{
+    uint8_t shift = 0U;
+
+    value = 0U;
+
+    while((end > data) && (64U > shift))
+    {
+        uint8_t byte = *data;
+
+        ++data;
+        value |= static_cast<uint64_t>(byte & 0x7FU) << shift;
+
+        if (0U == (byte & 0x80U))
+        {
+            return true;
+        }
+
+        shift += 7U;
+    }
+
+    return false;
+}
+
+/**
+ * Read a column of 32 bit varints.
+ *
+ * @param[in]   data    Begin of the column
+ * @param[in]   end     End of the column
+ * @param[out]  values  Values
+ * @param[in]   count   Number of values
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool getVarintColumn(const uint8_t* data, const uint8_t* end, uint32_t* values, size_t count)
+{
+    size_t idx = 0U;
+
+    for(idx = 0U; idx < count; ++idx)
+    {
+        uint64_t value = 0U;
+
+        /* Most deltas are small and take a single byte. */
+        if ((end > data) && (0U == (*data & 0x80U)))
+        {
+            values[idx] = *data;
+            ++data;
+        }
+        else if ((false == getVarint(data, end, value)) ||
+                 (UINT32_MAX < value))
+        {
+            return false;
+        }
+        else
+        {
+            values[idx] = static_cast<uint32_t>(value);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,305 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Columnar time series store of the S0 interface samples
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Stores the samples of one S0 interface (timestamp, pulse counter, power)
+ * in an append-only file. The samples are grouped into blocks. A sealed
+ * block keeps every column delta encoded as varints (zigzag modulo 2^32 for
+ * the counter and the power), together with a summary: first and last timestamp and
+ * counter, min., max. and sum of the power and the counted pulses. A range
+ * aggregation uses the summaries of the blocks, which are covered
+ * completely, and decodes only the blocks at the range borders. The file is
+ * read via mmap. The decoded columns are processed by the SIMD kernels, see
+ * Kernels.h.
+ *
+ * File layout, all values in host byte order (little endian):
+ * - FileHeader
+ * - Sealed blocks: BlockHeader, followed by the time, counter and power column.
+ * - Tail: the samples of the open block as Record, not encoded yet.
+ *
+ * A block is sealed, when it is full. The samples in the tail are written
+ * with flush() or close(). A counter, which decreases, is treated as
+ * restart of the device, which counts from 0 again.
+ *
+ * @{
+ */
+
+#ifndef __SAMPLE_STORE_H__
+#define __SAMPLE_STORE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Time series store of the samples of one S0 interface.
+ */
+class SampleStore
+{
+public:
+
+    /** Default number of samples per block. */
+    static const uint32_t   DEFAULT_BLOCK_CAPACITY  = 4096U;
+
+    /**
+     * A sample of a S0 interface.
+     */
+    struct Record
+    {
+        uint64_t    time;       /**< Timestamp in ms since the epoch */
+        uint32_t    counter;    /**< Pulse counter */
+        uint32_t    power;      /**< Power in W */
+    };
+
+    /**
+     * Aggregation of the samples in a time range.
+     */
+    struct Aggregate
+    {
+        uint64_t    count;      /**< Number of samples */
+        uint64_t    firstTime;  /**< Timestamp in ms of the first sample */
+        uint64_t    lastTime;   /**< Timestamp in ms of the last sample */
+        uint32_t    minPower;   /**< Min. power in W */
+        uint32_t    maxPower;   /**< Max. power in W */
+        uint64_t    sumPower;   /**< Sum of the power in W */
+        uint64_t    pulses;     /**< Pulses counted till the samples, since the sample before */
+    };
+
+    /**
+     * Constructs a closed store.
+     */
+    SampleStore();
+
+    /**
+     * Destroys the store, the pending samples are written.
+     */
+    ~SampleStore();
+
+    /**
+     * Create a new store file. A existing file is overwritten.
+     *
+     * @param[in] fileName      File name
+     * @param[in] name          Name of the S0 interface, max. 31 characters are kept.
+     * @param[in] pulsesPerKWh  Pulses per kWh of the S0 interface
+     * @param[in] blockCapacity Number of samples per block
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool create(const char* fileName, const char* name, uint32_t pulsesPerKWh, uint32_t blockCapacity = DEFAULT_BLOCK_CAPACITY);
+
+    /**
+     * Open a existing store file.
+     *
+     * @param[in] fileName      File name
+     * @param[in] isWritable    Shall samples be appended?
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool open(const char* fileName, bool isWritable);
+
+    /**
+     * Close the store, the pending samples are written.
+     */
+    void close(void);
+
+    /**
+     * Append a sample. The timestamps must increase strictly.
+     *
+     * @param[in] record    Sample
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool append(const Record& record);
+
+    /**
+     * Write the pending samples of the open block.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool flush(void);
+
+    /**
+     * Aggregate the samples in a time range.
+     *
+     * @param[in]   from        Start of the range in ms, inclusive
+     * @param[in]   to          End of the range in ms, exclusive
+     * @param[out]  aggregate   Aggregation
+     *
+     * @return If successful, it will return true otherwise false, e.g. a corrupt block.
+     */
+    bool aggregate(uint64_t from, uint64_t to, Aggregate& aggregate);
+
+    /**
+     * Get the name of the S0 interface.
+     *
+     * @return Name
+     */
+    const std::string& getName(void) const
+    {
+        return m_name;
+    }
+
+    /**
+     * Get the pulses per kWh of the S0 interface.
+     *
+     * @return Pulses per kWh
+     */
+    uint32_t getPulsesPerKWh(void) const
+    {
+        return m_pulsesPerKWh;
+    }
+
+    /**
+     * Get the number of samples.
+     *
+     * @return Number of samples
+     */
+    uint64_t getCount(void) const;
+
+    /**
+     * Get the number of sealed blocks.
+     *
+     * @return Number of sealed blocks
+     */
+    size_t getNumBlocks(void) const
+    {
+        return m_blocks.size();
+    }
+
+    /**
+     * Get the file size.
+     *
+     * @return File size in bytes
+     */
+    uint64_t getFileSize(void) const
+    {
+        return m_tailOffset + m_tail.size() * sizeof(Record);
+    }
+
+    /**
+     * Get the first sample.
+     *
+     * @param[out] record   Sample
+     *
+     * @return If the store isn't empty, it will return true otherwise false.
+     */
+    bool getFirst(Record& record);
+
+    /**
+     * Get the last sample.
+     *
+     * @param[out] record   Sample
+     *
+     * @return If the store isn't empty, it will return true otherwise false.
+     */
+    bool getLast(Record& record) const;
+
+private:
+
+    /**
+     * Summary of a sealed block, stored in front of its columns.
+     */
+    struct BlockHeader
+    {
+        uint64_t    firstTime;      /**< Timestamp in ms of the first sample */
+        uint64_t    lastTime;       /**< Timestamp in ms of the last sample */
+        uint32_t    count;          /**< Number of samples */
+        uint32_t    dataSize;       /**< Size in bytes of all columns */
+        uint32_t    firstCounter;   /**< Counter of the first sample */
+        uint32_t    lastCounter;    /**< Counter of the last sample */
+        uint32_t    minPower;       /**< Min. power in W */
+        uint32_t    maxPower;       /**< Max. power in W */
+        uint64_t    sumPower;       /**< Sum of the power in W */
+        uint64_t    pulses;         /**< Pulses between the first and the last sample */
+        uint32_t    timeSize;       /**< Size in bytes of the time column */
+        uint32_t    counterSize;    /**< Size in bytes of the counter column */
+    };
+
+    /**
+     * A sealed block in the file.
+     */
+    struct Block
+    {
+        BlockHeader header; /**< Summary */
+        uint64_t    offset; /**< File offset of the block header */
+    };
+
+    std::string         m_fileName;         /**< File name */
+    int                 m_fd;               /**< File descriptor or -1 */
+    bool                m_isWritable;       /**< Can samples be appended? */
+    std::string         m_name;             /**< Name of the S0 interface */
+    uint32_t            m_pulsesPerKWh;     /**< Pulses per kWh */
+    uint32_t            m_blockCapacity;    /**< Number of samples per block */
+    std::vector<Block>  m_blocks;           /**< Sealed blocks */
+    uint64_t            m_tailOffset;       /**< File offset of the tail */
+    std::vector<Record> m_tail;             /**< Samples of the open block */
+    size_t              m_numWritten;       /**< Number of samples of the tail, which are written */
+    const uint8_t*      m_map;              /**< Mapped file or nullptr */
+    size_t              m_mapSize;          /**< Size in bytes of the mapping */
+    std::vector<uint64_t>   m_times;            /**< Time column of the decoded block */
+    std::vector<uint32_t>   m_counters;         /**< Counter column of the decoded block */
+    std::vector<uint32_t>   m_powers;           /**< Power column of the decoded block */
+    uint64_t                m_decodedOffset;    /**< File offset of the decoded block or 0 */
+
+    SampleStore(const SampleStore& store);
+    SampleStore& operator=(const SampleStore& store);
+
+    bool writeFileHeader(void);
+    bool seal(void);
+    bool map(uint64_t size);
+    void unmap(void);
+    bool decode(const Block& block);
+    static uint32_t countPulses(uint32_t previous, uint32_t current);
+    static void addRecord(Aggregate& aggregate, const Record& record);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SAMPLE_STORE_H__ */
+
+/** @} */
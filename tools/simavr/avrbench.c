@@ -0,0 +1,2075 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2026 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Cycle accurate benchmarks of the firmware under simavr
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Runs the firmware ELF of the MightyCore environment on a simulated
+ * ATmega644P and measures in CPU cycles:
+ * - the duration of the S0 pin change ISR and its latency after an edge,
+ * - the duration of selected functions, e.g. S0Smartmeter::process() or the
+ *   web request handlers, without the interrupts in between,
+ * - the time from a HTTP request until the response is complete.
+ *
+ * The ENC28J60 is replaced by a register level stand-in on the SPI bus. A
+ * simulated peer behind it provides the DHCP server, answers ARP requests,
+ * sends HTTP requests in a loop and optionally floods broadcast frames, so
+ * the ISR latency is measured under network load.
+ *
+ * The EEPROM is prepared with the S0 interfaces enabled on the injected
+ * pins, otherwise no pin change interrupt would be enabled.
+ *
+ * Every result is written as JSON line to stdout, like the host benchmarks.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <gelf.h>
+
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_irq.h"
+#include "sim_io.h"
+#include "sim_cycle_timers.h"
+#include "sim_interrupts.h"
+#include "avr_ioport.h"
+#include "avr_spi.h"
+#include "avr_eeprom.h"
+#include "avr_uart.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Get the number of elements of an array. */
+#define ARRAY_NUM(_arr)         (sizeof(_arr) / sizeof((_arr)[0]))
+
+/** MCU of the AVR-NET-IO board. */
+#define MCU_NAME                "atmega644p"
+
+/** CPU frequency in Hz, see board_build.f_cpu in platformio.ini. */
+#define MCU_FREQUENCY           (16000000UL)
+
+/** Interrupt vector number of the pin change interrupt of port A. */
+#define PCINT0_VECTOR           (4U)
+
+/** Max. number of interrupt vectors. */
+#define MAX_VECTORS             (64U)
+
+/** Port and pin of the ENC28J60 chip select. */
+#define ENC_CS_PORT             ('B')
+#define ENC_CS_PIN              (4)
+
+/** Max. number of function probes. */
+#define MAX_PROBES              (16U)
+
+/** Max. number of frames, which wait for the delivery to the ENC28J60. */
+#define MAX_QUEUED_FRAMES       (16U)
+
+/** Max. ethernet frame size in bytes, without CRC. */
+#define MAX_FRAME_SIZE          (1514U)
+
+/** Period in us, in which the queued frames are delivered. */
+#define DELIVERY_PERIOD         (50U)
+
+/** Timeout in ms of a HTTP request. */
+#define HTTP_TIMEOUT            (3000U)
+
+/* ENC28J60 SPI opcodes */
+#define ENC_OP_RCR              (0x00U)     /**< Read control register */
+#define ENC_OP_RBM              (0x20U)     /**< Read buffer memory */
+#define ENC_OP_WCR              (0x40U)     /**< Write control register */
+#define ENC_OP_WBM              (0x60U)     /**< Write buffer memory */
+#define ENC_OP_BFS              (0x80U)     /**< Bit field set */
+#define ENC_OP_BFC              (0xA0U)     /**< Bit field clear */
+#define ENC_OP_SRC              (0xE0U)     /**< System reset command */
+
+/* ENC28J60 registers, bit 5 and 6 are the bank */
+#define ENC_ERDPTL              (0x00U)
+#define ENC_ERDPTH              (0x01U)
+#define ENC_EWRPTL              (0x02U)
+#define ENC_EWRPTH              (0x03U)
+#define ENC_ETXSTL              (0x04U)
+#define ENC_ETXSTH              (0x05U)
+#define ENC_ETXNDL              (0x06U)
+#define ENC_ETXNDH              (0x07U)
+#define ENC_ERXSTL              (0x08U)
+#define ENC_ERXSTH              (0x09U)
+#define ENC_ERXNDL              (0x0AU)
+#define ENC_ERXNDH              (0x0BU)
+#define ENC_ERXRDPTL            (0x0CU)
+#define ENC_ERXRDPTH            (0x0DU)
+#define ENC_ERXWRPTL            (0x0EU)
+#define ENC_ERXWRPTH            (0x0FU)
+#define ENC_EDMASTL             (0x10U)
+#define ENC_EDMASTH             (0x11U)
+#define ENC_EDMANDL             (0x12U)
+#define ENC_EDMANDH             (0x13U)
+#define ENC_EDMADSTL            (0x14U)
+#define ENC_EDMADSTH            (0x15U)
+#define ENC_EDMACSL             (0x16U)
+#define ENC_EDMACSH             (0x17U)
+#define ENC_EIR                 (0x1CU)
+#define ENC_ESTAT               (0x1DU)
+#define ENC_ECON2               (0x1EU)
+#define ENC_ECON1               (0x1FU)
+#define ENC_EPKTCNT             (0x39U)
+#define ENC_MICMD               (0x52U)
+#define ENC_MIREGADR            (0x54U)
+#define ENC_MIWRL               (0x56U)
+#define ENC_MIWRH               (0x57U)
+#define ENC_MIRDL               (0x58U)
+#define ENC_MIRDH               (0x59U)
+#define ENC_MISTAT              (0x6AU)
+#define ENC_EREVID              (0x72U)
+
+/* ENC28J60 register bits */
+#define ENC_EIR_DMAIF           (0x20U)
+#define ENC_EIR_PKTIF           (0x40U)
+#define ENC_EIR_TXIF            (0x08U)
+#define ENC_ESTAT_CLKRDY        (0x01U)
+#define ENC_ECON2_AUTOINC       (0x80U)
+#define ENC_ECON2_PKTDEC        (0x40U)
+#define ENC_ECON1_BSEL          (0x03U)
+#define ENC_ECON1_RXEN          (0x04U)
+#define ENC_ECON1_TXRTS         (0x08U)
+#define ENC_ECON1_CSUMEN        (0x10U)
+#define ENC_ECON1_DMAST         (0x20U)
+#define ENC_MICMD_MIIRD         (0x01U)
+
+/* ENC28J60 PHY registers */
+#define ENC_PHSTAT1             (0x01U)
+#define ENC_PHID1               (0x02U)
+#define ENC_PHID2               (0x03U)
+#define ENC_PHSTAT2             (0x11U)
+
+/** ENC28J60 buffer memory size in bytes. */
+#define ENC_BUFFER_SIZE         (0x2000U)
+
+/* Ethernet, IP, UDP and TCP */
+#define ETH_TYPE_IP             (0x0800U)
+#define ETH_TYPE_ARP            (0x0806U)
+#define ETH_HDR_SIZE            (14U)
+#define IP_HDR_SIZE             (20U)
+#define UDP_HDR_SIZE            (8U)
+#define TCP_HDR_SIZE            (20U)
+#define IP_PROTO_TCP            (6U)
+#define IP_PROTO_UDP            (17U)
+#define TCP_FIN                 (0x01U)
+#define TCP_SYN                 (0x02U)
+#define TCP_RST                 (0x04U)
+#define TCP_PSH                 (0x08U)
+#define TCP_ACK                 (0x10U)
+#define DHCP_SERVER_PORT        (67U)
+#define DHCP_CLIENT_PORT        (68U)
+#define DHCP_DISCOVER           (1U)
+#define DHCP_OFFER              (2U)
+#define DHCP_REQUEST            (3U)
+#define DHCP_ACK                (5U)
+#define HTTP_PORT               (80U)
+#define DISCARD_PORT            (9U)
+
+/* EEPROM layout, see PSMemory.hpp. The structures are packed on the AVR. */
+#define EE_STATUS_VALID         (0xA5U)
+#define EE_S0_MAX_NUM           (2U)
+#define EE_S0DATA_SIZE          (1U + 32U + 1U + 4U)
+#define EE_STATUS_ADDR          (0U)
+#define EE_S0NUM_ADDR           (1U)
+#define EE_S0DATA_ADDR          (2U)
+#define EE_S0DATA_DEBUG         (EE_S0DATA_ADDR + EE_S0_MAX_NUM * EE_S0DATA_SIZE)
+#define EE_NET_STATUS_ADDR      (EE_S0DATA_DEBUG + 1U)
+#define EE_NETDATA_ADDR         (EE_NET_STATUS_ADDR + 1U)
+#define EE_NETDATA_SIZE         (1U + 5U * 4U + 2U)
+#define EE_SIZE                 (2048U)
+
+/** Arduino pin number of port A bit 0. */
+#define PIN_PORT_A_BIT0         (24U)
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Statistics of a measurement in cycles. */
+typedef struct
+{
+    uint32_t    count;  /**< Number of measurements */
+    uint64_t    min;    /**< Min. cycles */
+    uint64_t    max;    /**< Max. cycles */
+    uint64_t    sum;    /**< Sum of all cycles */
+
+} Stats;
+
+/** Probe, which measures the cycles of a function. */
+typedef struct
+{
+    char        name[128];      /**< Symbol name */
+    uint32_t    addr;           /**< Byte address of the function */
+    bool        isActive;       /**< Is the function running? */
+    uint16_t    entrySp;        /**< Stack pointer at the entry, points below the return address */
+    uint64_t    entryCycle;     /**< Cycle at the entry */
+    uint64_t    entryIsrCycles; /**< ISR cycles at the entry */
+    Stats       stats;          /**< Cycles without the interrupts in between */
+
+} FuncProbe;
+
+/** ENC28J60 stand-in, on register level. */
+typedef struct
+{
+    uint8_t     regs[4][32];                /**< Control registers, the common ones are in bank 0 */
+    uint16_t    phy[32];                    /**< PHY registers */
+    uint8_t     buffer[ENC_BUFFER_SIZE];    /**< Buffer memory */
+    bool        isSelected;                 /**< Chip select active */
+    uint8_t     opcode;                     /**< Opcode of the current SPI command */
+    uint8_t     arg;                        /**< Argument of the current SPI command */
+    uint32_t    byteIdx;                    /**< Byte index in the current SPI command */
+    uint32_t    rxFrames;                   /**< Frames, received by the firmware */
+    uint32_t    rxDropped;                  /**< Frames, dropped because the receive buffer was full */
+    uint32_t    txFrames;                   /**< Frames, sent by the firmware */
+
+} Enc28j60;
+
+/** A frame, which waits for delivery. */
+typedef struct
+{
+    uint16_t    size;                       /**< Frame size in bytes */
+    uint8_t     data[MAX_FRAME_SIZE];       /**< Frame */
+
+} Frame;
+
+/** HTTP client states */
+typedef enum
+{
+    HTTP_STATE_IDLE = 0,    /**< No connection */
+    HTTP_STATE_SYN_SENT,    /**< Connection requested */
+    HTTP_STATE_RECEIVING,   /**< Request sent, receiving the response */
+    HTTP_STATE_FIN_SENT     /**< Response received, connection closed by both sides */
+
+} HttpState;
+
+/** Simulated peer in the network: DHCP server, ARP responder and HTTP client. */
+typedef struct
+{
+    uint8_t     mac[6];             /**< Peer MAC address */
+    uint8_t     ip[4];              /**< Peer IP address */
+    uint8_t     deviceMac[6];       /**< Device MAC address, learned from its frames */
+    uint8_t     deviceIp[4];        /**< Device IP address, assigned by DHCP */
+    bool        isBound;            /**< Device got its IP address */
+    uint16_t    ipId;               /**< IP identification */
+    HttpState   httpState;          /**< HTTP client state */
+    uint16_t    localPort;          /**< Local TCP port of the current connection */
+    uint32_t    sndNxt;             /**< Next sequence number to send */
+    uint32_t    rcvNxt;             /**< Next sequence number to receive */
+    uint64_t    reqCycle;           /**< Cycle, when the request was sent */
+    uint64_t    timeoutCycle;       /**< Cycle, when the request times out */
+    uint32_t    rspBytes;           /**< Received bytes of the response */
+    uint32_t    httpErrors;         /**< Failed or timed out requests */
+    Stats       httpStats;          /**< Cycles from request until the response is complete */
+    Frame       queue[MAX_QUEUED_FRAMES];   /**< Frames, waiting for delivery */
+    uint8_t     queueRd;            /**< Queue read index */
+    uint8_t     queueCnt;           /**< Number of queued frames */
+
+} Peer;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void statsAdd(Stats* stats, uint64_t cycles);
+static void statsPrint(const char* name, const Stats* stats);
+static uint64_t msToCycles(uint32_t ms);
+static int addProbes(const char* elfFile, const char* pattern);
+static void checkProbes(void);
+static void prepareEeprom(uint8_t pinMask);
+static bool loadEeprom(const char* file);
+static void onIsrRunning(struct avr_irq_t* irq, uint32_t value, void* param);
+static avr_cycle_count_t onPulse(avr_t* avr, avr_cycle_count_t when, void* param);
+static void encReset(void);
+static uint8_t* encReg(uint8_t addr);
+static bool encIsMacMiiReg(uint8_t addr);
+static uint16_t encGetPtr(uint8_t addrLow);
+static void encSetPtr(uint8_t addrLow, uint16_t value);
+static void encWriteReg(uint8_t addr, uint8_t value);
+static uint16_t encRxInc(uint16_t ptr);
+static void encTransmit(void);
+static void encDma(void);
+static bool encReceive(const uint8_t* frame, uint16_t size);
+static void onEncCs(struct avr_irq_t* irq, uint32_t value, void* param);
+static void onEncSpi(struct avr_irq_t* irq, uint32_t value, void* param);
+static uint8_t encSpiByte(uint8_t data);
+static avr_cycle_count_t onDelivery(avr_t* avr, avr_cycle_count_t when, void* param);
+static avr_cycle_count_t onNoise(avr_t* avr, avr_cycle_count_t when, void* param);
+static avr_cycle_count_t onHttp(avr_t* avr, avr_cycle_count_t when, void* param);
+static uint8_t* peerAllocFrame(void);
+static uint16_t put16(uint8_t* buf, uint16_t value);
+static uint16_t get16(const uint8_t* buf);
+static uint32_t get32(const uint8_t* buf);
+static uint16_t checksum(uint32_t sum, const uint8_t* data, uint16_t size);
+static void peerHandleFrame(const uint8_t* frame, uint16_t size);
+static void peerHandleArp(const uint8_t* frame, uint16_t size);
+static void peerHandleDhcp(const uint8_t* frame, uint16_t size);
+static void peerHandleTcp(const uint8_t* frame, uint16_t size);
+static uint8_t* peerIpFrame(uint8_t* frame, const uint8_t* dstMac, const uint8_t* dstIp, uint8_t proto, uint16_t payloadSize);
+static void peerSendTcp(uint8_t flags, const char* data, uint16_t size);
+static void peerHttpDone(bool isSuccessful);
+static void printUsage(const char* prgName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Simulated MCU */
+static avr_t*       gAvr                = NULL;
+
+/** ENC28J60 stand-in */
+static Enc28j60     gEnc;
+
+/** Simulated peer */
+static Peer         gPeer;
+
+/** SPI input of the MCU, the ENC28J60 replies with it. */
+static avr_irq_t*   gSpiIn              = NULL;
+
+/** Function probes */
+static FuncProbe    gProbes[MAX_PROBES];
+
+/** Number of function probes */
+static uint8_t      gNumProbes          = 0U;
+
+/** Statistics of every interrupt vector */
+static Stats        gIsrStats[MAX_VECTORS];
+
+/** Entry cycle of every running interrupt vector */
+static uint64_t     gIsrEntry[MAX_VECTORS];
+
+/** Nesting depth of the running interrupts */
+static uint8_t      gIsrDepth           = 0U;
+
+/** Entry cycle of the outermost running interrupt */
+static uint64_t     gIsrOuterEntry      = 0U;
+
+/** Total cycles spent in interrupts */
+static uint64_t     gIsrCycles          = 0U;
+
+/** Cycle of the first S0 edge, which is not served by the ISR yet. */
+static uint64_t     gEdgeCycle          = 0U;
+
+/** Is a S0 edge pending? */
+static bool         gIsEdgePending      = false;
+
+/** ISR latency statistics after a S0 edge */
+static Stats        gLatencyStats;
+
+/** Port A pins, where the S0 pulses are injected. */
+static avr_irq_t*   gPortA[8];
+
+/** Pulse period in ms */
+static uint32_t     gPulsePeriod        = 100U;
+
+/** Pulse width in ms */
+static uint32_t     gPulseWidth         = 30U;
+
+/** Number of injected pulses */
+static uint32_t     gPulseCnt           = 0U;
+
+/** Period in ms between two HTTP requests */
+static uint32_t     gHttpPeriod         = 200U;
+
+/** HTTP request, like a data logger which polls all S0 interfaces. */
+static const char   HTTP_REQUEST[]      = "GET /api/s0-interfaces HTTP/1.1\r\n"
+                                          "Host: avr-net-io\r\n"
+                                          "Connection: close\r\n"
+                                          "\r\n";
+
+/** Default function probes */
+static const char*  DEFAULT_PROBES[]    =
+{
+    "S0Smartmeter7process",
+    "handleS0InterfacesReq",
+    "handleS0InterfaceReq",
+    "S0Model6toJson"
+};
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program entry point.
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    static const struct option  longOptions[] =
+    {
+        { "seconds",        required_argument,  NULL,   's' },
+        { "pins",           required_argument,  NULL,   'p' },
+        { "pulse-period",   required_argument,  NULL,   'P' },
+        { "pulse-width",    required_argument,  NULL,   'w' },
+        { "http-period",    required_argument,  NULL,   'H' },
+        { "noise",          required_argument,  NULL,   'n' },
+        { "func",           required_argument,  NULL,   'f' },
+        { "eeprom",         required_argument,  NULL,   'e' },
+        { "help",           no_argument,        NULL,   'h' },
+        { NULL,             0,                  NULL,   0   }
+    };
+    elf_firmware_t              firmware;
+    const char*                 elfFile     = NULL;
+    const char*                 eepromFile  = NULL;
+    const char*                 funcs[MAX_PROBES];
+    uint8_t                     numFuncs    = 0U;
+    uint32_t                    seconds     = 10U;
+    uint32_t                    pinMask     = 0x03U;
+    uint32_t                    noiseRate   = 0U;
+    uint64_t                    endCycle    = 0U;
+    uint32_t                    flags       = 0U;
+    uint8_t                     idx         = 0U;
+    int                         opt         = 0;
+    int                         state       = cpu_Running;
+
+    while(-1 != (opt = getopt_long(argc, argv, "s:p:P:w:H:n:f:e:h", longOptions, NULL)))
+    {
+        switch(opt)
+        {
+        case 's':
+            seconds = strtoul(optarg, NULL, 0);
+            break;
+
+        case 'p':
+            pinMask = strtoul(optarg, NULL, 0) & 0xFFU;
+            break;
+
+        case 'P':
+            gPulsePeriod = strtoul(optarg, NULL, 0);
+            break;
+
+        case 'w':
+            gPulseWidth = strtoul(optarg, NULL, 0);
+            break;
+
+        case 'H':
+            gHttpPeriod = strtoul(optarg, NULL, 0);
+            break;
+
+        case 'n':
+            noiseRate = strtoul(optarg, NULL, 0);
+            break;
+
+        case 'f':
+            if (MAX_PROBES > numFuncs)
+            {
+                funcs[numFuncs] = optarg;
+                ++numFuncs;
+            }
+            break;
+
+        case 'e':
+            eepromFile = optarg;
+            break;
+
+        case 'h':
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+
+        default:
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind >= argc)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if ((0U == gPulsePeriod) || (gPulseWidth >= gPulsePeriod))
+    {
+        fprintf(stderr, "The pulse width must be shorter than the pulse period.\n");
+        return EXIT_FAILURE;
+    }
+
+    elfFile = argv[optind];
+
+    if (0U == numFuncs)
+    {
+        for(idx = 0U; idx < ARRAY_NUM(DEFAULT_PROBES); ++idx)
+        {
+            funcs[idx] = DEFAULT_PROBES[idx];
+        }
+
+        numFuncs = ARRAY_NUM(DEFAULT_PROBES);
+    }
+
+    memset(&firmware, 0, sizeof(firmware));
+
+    if (0 != elf_read_firmware(elfFile, &firmware))
+    {
+        fprintf(stderr, "Failed to read %s.\n", elfFile);
+        return EXIT_FAILURE;
+    }
+
+    for(idx = 0U; idx < numFuncs; ++idx)
+    {
+        if (0 == addProbes(elfFile, funcs[idx]))
+        {
+            fprintf(stderr, "No function matches %s, it may be inlined.\n", funcs[idx]);
+        }
+    }
+
+    gAvr = avr_make_mcu_by_name(MCU_NAME);
+
+    if (NULL == gAvr)
+    {
+        fprintf(stderr, "MCU %s is not supported by simavr.\n", MCU_NAME);
+        return EXIT_FAILURE;
+    }
+
+    avr_init(gAvr);
+    avr_load_firmware(gAvr, &firmware);
+    gAvr->frequency = MCU_FREQUENCY;
+
+    /* The log output on the serial interface shall not mix with the results. */
+    (void)avr_ioctl(gAvr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+    flags &= ~AVR_UART_FLAG_STDIO;
+    (void)avr_ioctl(gAvr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+
+    if (NULL != eepromFile)
+    {
+        if (false == loadEeprom(eepromFile))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        prepareEeprom(pinMask);
+    }
+
+    for(idx = 0U; idx < MAX_VECTORS; ++idx)
+    {
+        avr_irq_t* irq = avr_get_interrupt_irq(gAvr, idx);
+
+        gIsrStats[idx].min = UINT64_MAX;
+
+        if (NULL != irq)
+        {
+            avr_irq_register_notify(irq + AVR_INT_IRQ_RUNNING, onIsrRunning, (void*)(uintptr_t)idx);
+        }
+    }
+
+    gLatencyStats.min       = UINT64_MAX;
+    gPeer.httpStats.min     = UINT64_MAX;
+
+    /* S0 pulses: The pins idle high, because of the pull-up. */
+    for(idx = 0U; idx < ARRAY_NUM(gPortA); ++idx)
+    {
+        gPortA[idx] = avr_io_getirq(gAvr, AVR_IOCTL_IOPORT_GETIRQ('A'), idx);
+
+        if (0U != (pinMask & (1U << idx)))
+        {
+            avr_raise_irq(gPortA[idx], 1U);
+
+            /* Shift the pulses of the pins against each other. */
+            avr_cycle_timer_register(gAvr, msToCycles(gPulsePeriod + idx * 7U), onPulse, (void*)(uintptr_t)idx);
+        }
+    }
+
+    /* ENC28J60 stand-in */
+    encReset();
+    gSpiIn = avr_io_getirq(gAvr, AVR_IOCTL_SPI_GETIRQ(0), SPI_IRQ_INPUT);
+    avr_irq_register_notify(avr_io_getirq(gAvr, AVR_IOCTL_SPI_GETIRQ(0), SPI_IRQ_OUTPUT), onEncSpi, NULL);
+    avr_irq_register_notify(avr_io_getirq(gAvr, AVR_IOCTL_IOPORT_GETIRQ(ENC_CS_PORT), ENC_CS_PIN), onEncCs, NULL);
+
+    /* Peer */
+    memcpy(gPeer.mac, "\x02\x00\x00\x00\x00\x01", sizeof(gPeer.mac));
+    memcpy(gPeer.ip, "\xC0\xA8\x64\x01", sizeof(gPeer.ip));
+    memcpy(gPeer.deviceIp, "\xC0\xA8\x64\x02", sizeof(gPeer.deviceIp));
+    gPeer.localPort = 40000U;
+
+    avr_cycle_timer_register_usec(gAvr, DELIVERY_PERIOD, onDelivery, NULL);
+
+    if (0U < noiseRate)
+    {
+        avr_cycle_timer_register(gAvr, gAvr->frequency / noiseRate, onNoise, (void*)(uintptr_t)noiseRate);
+    }
+
+    endCycle = (uint64_t)seconds * gAvr->frequency;
+
+    while((gAvr->cycle < endCycle) &&
+          (cpu_Done != state) &&
+          (cpu_Crashed != state))
+    {
+        state = avr_run(gAvr);
+        checkProbes();
+    }
+
+    if (cpu_Crashed == state)
+    {
+        fprintf(stderr, "The firmware crashed at PC 0x%04x.\n", (unsigned int)gAvr->pc);
+    }
+
+    statsPrint("isr.pcint0", &gIsrStats[PCINT0_VECTOR]);
+    statsPrint("isr.pcint0.latency", &gLatencyStats);
+
+    for(idx = 0U; idx < MAX_VECTORS; ++idx)
+    {
+        if ((PCINT0_VECTOR != idx) && (0U < gIsrStats[idx].count))
+        {
+            char name[32];
+
+            snprintf(name, sizeof(name), "isr.vector%u", idx);
+            statsPrint(name, &gIsrStats[idx]);
+        }
+    }
+
+    for(idx = 0U; idx < gNumProbes; ++idx)
+    {
+        char name[sizeof(gProbes[idx].name) + 8U];
+
+        snprintf(name, sizeof(name), "func.%s", gProbes[idx].name);
+        statsPrint(name, &gProbes[idx].stats);
+    }
+
+    statsPrint("http.request", &gPeer.httpStats);
+
+    printf("{\"name\":\"sim\",\"frequency\":%lu,\"cycles\":%llu,\"pulses\":%u,\"rxFrames\":%u,\"rxDropped\":%u,\"txFrames\":%u,\"httpErrors\":%u,\"isCrashed\":%s}\n",
+        (unsigned long)gAvr->frequency,
+        (unsigned long long)gAvr->cycle,
+        gPulseCnt,
+        gEnc.rxFrames,
+        gEnc.rxDropped,
+        gEnc.txFrames,
+        gPeer.httpErrors,
+        (cpu_Crashed == state) ? "true" : "false");
+
+    return (cpu_Crashed == state) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Add a measurement to the statistics.
+ *
+ * @param[in] stats     Statistics
+ * @param[in] cycles    Measured cycles
+ */
+static void statsAdd(Stats* stats, uint64_t cycles)
+{
+    ++stats->count;
+    stats->sum += cycles;
+
+    if (stats->min > cycles)
+    {
+        stats->min = cycles;
+    }
+
+    if (stats->max < cycles)
+    {
+        stats->max = cycles;
+    }
+
+    return;
+}
+
+/**
+ * Print the statistics as JSON line.
+ *
+ * @param[in] name  Measurement name
+ * @param[in] stats Statistics
+ */
+static void statsPrint(const char* name, const Stats* stats)
+{
+    uint64_t min = (0U < stats->count) ? stats->min : 0U;
+    uint64_t avg = (0U < stats->count) ? (stats->sum / stats->count) : 0U;
+
+    printf("{\"name\":\"%s\",\"count\":%u,\"minCycles\":%llu,\"avgCycles\":%llu,\"maxCycles\":%llu}\n",
+        name,
+        stats->count,
+        (unsigned long long)min,
+        (unsigned long long)avg,
+        (unsigned long long)stats->max);
+
+    return;
+}
+
+/**
+ * Convert milliseconds to CPU cycles.
+ *
+ * @param[in] ms    Time in ms
+ *
+ * @return CPU cycles
+ */
+static uint64_t msToCycles(uint32_t ms)
+{
+    return ((uint64_t)ms * gAvr->frequency) / 1000U;
+}
+
+/**
+ * Add a probe for every function, whose symbol name contains the pattern.
+ * The symbols are read from the ELF file, because the names of static
+ * functions are needed too.
+ *
+ * @param[in] elfFile   ELF file
+ * @param[in] pattern   Part of the mangled symbol name
+ *
+ * @return Number of added probes
+ */
+static int addProbes(const char* elfFile, const char* pattern)
+{
+    int         added   = 0;
+    int         fd      = open(elfFile, O_RDONLY);
+    Elf*        elf     = NULL;
+    Elf_Scn*    scn     = NULL;
+
+    if (0 > fd)
+    {
+        return 0;
+    }
+
+    (void)elf_version(EV_CURRENT);
+    elf = elf_begin(fd, ELF_C_READ, NULL);
+
+    while((NULL != elf) && (NULL != (scn = elf_nextscn(elf, scn))))
+    {
+        GElf_Shdr   shdr;
+        Elf_Data*   data    = NULL;
+        size_t      idx     = 0U;
+
+        if ((NULL == gelf_getshdr(scn, &shdr)) ||
+            (SHT_SYMTAB != shdr.sh_type) ||
+            (0U == shdr.sh_entsize))
+        {
+            continue;
+        }
+
+        data = elf_getdata(scn, NULL);
+
+        for(idx = 0U; (NULL != data) && (idx < (shdr.sh_size / shdr.sh_entsize)); ++idx)
+        {
+            GElf_Sym    sym;
+            const char* name = NULL;
+
+            if ((NULL == gelf_getsym(data, (int)idx, &sym)) ||
+                (STT_FUNC != GELF_ST_TYPE(sym.st_info)))
+            {
+                continue;
+            }
+
+            name = elf_strptr(elf, shdr.sh_link, sym.st_name);
+
+            if ((NULL != name) &&
+                (NULL != strstr(name, pattern)) &&
+                (MAX_PROBES > gNumProbes))
+            {
+                FuncProbe* probe = &gProbes[gNumProbes];
+
+                memset(probe, 0, sizeof(*probe));
+                snprintf(probe->name, sizeof(probe->name), "%s", name);
+                probe->addr         = (uint32_t)sym.st_value;
+                probe->stats.min    = UINT64_MAX;
+
+                ++gNumProbes;
+                ++added;
+            }
+        }
+    }
+
+    if (NULL != elf)
+    {
+        (void)elf_end(elf);
+    }
+
+    (void)close(fd);
+
+    return added;
+}
+
+/**
+ * Check the function probes after every instruction. A function is entered,
+ * if the PC is its address. It is left, if the stack pointer is above the
+ * one at the entry, which happens after its return instruction popped the
+ * return address.
+ */
+static void checkProbes(void)
+{
+    uint16_t    sp  = (uint16_t)gAvr->data[R_SPL] | ((uint16_t)gAvr->data[R_SPH] << 8U);
+    uint8_t     idx = 0U;
+
+    for(idx = 0U; idx < gNumProbes; ++idx)
+    {
+        FuncProbe* probe = &gProbes[idx];
+
+        if (false == probe->isActive)
+        {
+            if (probe->addr == gAvr->pc)
+            {
+                probe->isActive         = true;
+                probe->entrySp          = sp;
+                probe->entryCycle       = gAvr->cycle;
+                probe->entryIsrCycles   = gIsrCycles;
+            }
+        }
+        else if (probe->entrySp < sp)
+        {
+            uint64_t cycles = gAvr->cycle - probe->entryCycle;
+
+            cycles -= gIsrCycles - probe->entryIsrCycles;
+            statsAdd(&probe->stats, cycles);
+
+            probe->isActive = false;
+        }
+    }
+
+    return;
+}
+
+/**
+ * Prepare the EEPROM with a valid configuration: DHCP and the S0 interfaces
+ * enabled on the first pins of the mask. The layout must match PSMemory.hpp.
+ *
+ * @param[in] pinMask   Port A pins with S0 pulses
+ */
+static void prepareEeprom(uint8_t pinMask)
+{
+    uint8_t             ee[EE_SIZE];
+    avr_eeprom_desc_t   desc;
+    uint8_t             bitNo   = 0U;
+    uint8_t             index   = 0U;
+
+    memset(ee, 0xFF, sizeof(ee));
+
+    ee[EE_STATUS_ADDR]  = EE_STATUS_VALID;
+    ee[EE_S0NUM_ADDR]   = EE_S0_MAX_NUM;
+
+    for(index = 0U; index < EE_S0_MAX_NUM; ++index)
+    {
+        uint8_t* s0Data = &ee[EE_S0DATA_ADDR + index * EE_S0DATA_SIZE];
+
+        memset(s0Data, 0, EE_S0DATA_SIZE);
+        snprintf((char*)&s0Data[1], 32U, "S0-%u", index);
+
+        /* Pulses per kWh, little endian */
+        s0Data[34] = 1000U & 0xFFU;
+        s0Data[35] = (1000U >> 8U) & 0xFFU;
+
+        while((8U > bitNo) && (0U == (pinMask & (1U << bitNo))))
+        {
+            ++bitNo;
+        }
+
+        if (8U > bitNo)
+        {
+            s0Data[0]   = 1U;
+            s0Data[33]  = PIN_PORT_A_BIT0 + bitNo;
+            ++bitNo;
+        }
+    }
+
+    ee[EE_S0DATA_DEBUG]     = 0U;
+    ee[EE_NET_STATUS_ADDR]  = EE_STATUS_VALID;
+
+    memset(&ee[EE_NETDATA_ADDR], 0, EE_NETDATA_SIZE);
+    ee[EE_NETDATA_ADDR] = 1U;
+    ee[EE_NETDATA_ADDR + EE_NETDATA_SIZE - 2U] = 514U & 0xFFU;
+    ee[EE_NETDATA_ADDR + EE_NETDATA_SIZE - 1U] = (514U >> 8U) & 0xFFU;
+
+    desc.ee     = ee;
+    desc.offset = 0U;
+    desc.size   = sizeof(ee);
+    (void)avr_ioctl(gAvr, AVR_IOCTL_EEPROM_SET, &desc);
+
+    return;
+}
+
+/**
+ * Load the EEPROM from a raw image, e.g. read from a device with avrdude.
+ *
+ * @param[in] file  Raw EEPROM image
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool loadEeprom(const char* file)
+{
+    uint8_t             ee[EE_SIZE];
+    avr_eeprom_desc_t   desc;
+    FILE*               fd      = fopen(file, "rb");
+    size_t              size    = 0U;
+
+    if (NULL == fd)
+    {
+        fprintf(stderr, "Failed to open %s.\n", file);
+        return false;
+    }
+
+    size = fread(ee, 1U, sizeof(ee), fd);
+    (void)fclose(fd);
+
+    desc.ee     = ee;
+    desc.offset = 0U;
+    desc.size   = (uint16_t)size;
+    (void)avr_ioctl(gAvr, AVR_IOCTL_EEPROM_SET, &desc);
+
+    return true;
+}
+
+/**
+ * Called, if an interrupt service routine is entered (1) or left (0).
+ *
+ * @param[in] irq       Running IRQ of the vector
+ * @param[in] value     1 on entry, 0 on exit
+ * @param[in] param     Vector number
+ */
+static void onIsrRunning(struct avr_irq_t* irq, uint32_t value, void* param)
+{
+    uint8_t vector = (uint8_t)(uintptr_t)param;
+
+    (void)irq;
+
+    if (0U != value)
+    {
+        gIsrEntry[vector] = gAvr->cycle;
+
+        if (0U == gIsrDepth)
+        {
+            gIsrOuterEntry = gAvr->cycle;
+        }
+
+        ++gIsrDepth;
+
+        if ((PCINT0_VECTOR == vector) && (true == gIsEdgePending))
+        {
+            statsAdd(&gLatencyStats, gAvr->cycle - gEdgeCycle);
+            gIsEdgePending = false;
+        }
+    }
+    else if (0U < gIsrDepth)
+    {
+        statsAdd(&gIsrStats[vector], gAvr->cycle - gIsrEntry[vector]);
+
+        --gIsrDepth;
+
+        if (0U == gIsrDepth)
+        {
+            gIsrCycles += gAvr->cycle - gIsrOuterEntry;
+        }
+    }
+
+    return;
+}
+
+/**
+ * Inject the edges of a S0 pulse: falling edge at the start, rising edge
+ * after the pulse width.
+ *
+ * @param[in] avr   Simulated MCU
+ * @param[in] when  Current cycle
+ * @param[in] param Port A bit number
+ *
+ * @return Cycle of the next edge
+ */
+static avr_cycle_count_t onPulse(avr_t* avr, avr_cycle_count_t when, void* param)
+{
+    uint8_t             bitNo   = (uint8_t)(uintptr_t)param;
+    uint32_t            level   = gPortA[bitNo]->value;
+    avr_cycle_count_t   next    = 0U;
+
+    if (0U != level)
+    {
+        ++gPulseCnt;
+        next = when + msToCycles(gPulseWidth);
+    }
+    else
+    {
+        next = when + msToCycles(gPulsePeriod - gPulseWidth);
+    }
+
+    if (false == gIsEdgePending)
+    {
+        gEdgeCycle      = avr->cycle;
+        gIsEdgePending  = true;
+    }
+
+    avr_raise_irq(gPortA[bitNo], (0U != level) ? 0U : 1U);
+
+    return next;
+}
+
+/**
+ * Reset the ENC28J60 stand-in to its power-on state, with the link up.
+ */
+static void encReset(void)
+{
+    memset(gEnc.regs, 0, sizeof(gEnc.regs));
+
+    *encReg(ENC_ESTAT)      = ENC_ESTAT_CLKRDY;
+    *encReg(ENC_ECON2)      = ENC_ECON2_AUTOINC;
+    *encReg(ENC_EREVID)     = 0x06U;
+    encSetPtr(ENC_ERDPTL, 0x05FAU);
+    encSetPtr(ENC_ERXNDL, ENC_BUFFER_SIZE - 1U);
+    encSetPtr(ENC_ERXRDPTL, 0x05FAU);
+
+    memset(gEnc.phy, 0, sizeof(gEnc.phy));
+    gEnc.phy[ENC_PHSTAT1]   = 0x0004U;  /* Link status latched */
+    gEnc.phy[ENC_PHID1]     = 0x0083U;
+    gEnc.phy[ENC_PHID2]     = 0x1400U;
+    gEnc.phy[ENC_PHSTAT2]   = 0x0400U;  /* Link up */
+
+    return;
+}
+
+/**
+ * Get a control register. The common registers are available in every bank.
+ *
+ * @param[in] addr  Register address with the bank in bit 5 and 6
+ *
+ * @return Register
+ */
+static uint8_t* encReg(uint8_t addr)
+{
+    uint8_t reg = addr & 0x1FU;
+
+    return (0x1BU <= reg) ? &gEnc.regs[0][reg] : &gEnc.regs[(addr >> 5U) & 0x03U][reg];
+}
+
+/**
+ * Is it a MAC or MII register? Reading them needs a dummy byte.
+ *
+ * @param[in] addr  Register address with the bank in bit 5 and 6
+ *
+ * @return If it is a MAC or MII register, it will return true otherwise false.
+ */
+static bool encIsMacMiiReg(uint8_t addr)
+{
+    uint8_t bank    = (addr >> 5U) & 0x03U;
+    uint8_t reg     = addr & 0x1FU;
+
+    return ((2U == bank) && (0x1BU > reg)) ||
+           ((3U == bank) && ((0x06U > reg) || (0x0AU == reg)));
+}
+
+/**
+ * Get a 16-bit pointer, which consists of two bank 0 registers.
+ *
+ * @param[in] addrLow   Address of the low byte
+ *
+ * @return Pointer
+ */
+static uint16_t encGetPtr(uint8_t addrLow)
+{
+    return (uint16_t)(*encReg(addrLow) | ((uint16_t)*encReg(addrLow + 1U) << 8U)) & (ENC_BUFFER_SIZE - 1U);
+}
+
+/**
+ * Set a 16-bit pointer, which consists of two bank 0 registers.
+ *
+ * @param[in] addrLow   Address of the low byte
+ * @param[in] value     Pointer
+ */
+static void encSetPtr(uint8_t addrLow, uint16_t value)
+{
+    value &= ENC_BUFFER_SIZE - 1U;
+
+    *encReg(addrLow)        = value & 0xFFU;
+    *encReg(addrLow + 1U)   = (value >> 8U) & 0xFFU;
+
+    return;
+}
+
+/**
+ * Write a control register with all side effects.
+ *
+ * @param[in] addr  Register address with the bank in bit 5 and 6
+ * @param[in] value Value
+ */
+static void encWriteReg(uint8_t addr, uint8_t value)
+{
+    *encReg(addr) = value;
+
+    switch(addr & ((0x1BU <= (addr & 0x1FU)) ? 0x1FU : 0x7FU))
+    {
+    case ENC_ERXSTL:
+    case ENC_ERXSTH:
+        /* The hardware write pointer follows the receive buffer start. */
+        encSetPtr(ENC_ERXWRPTL, encGetPtr(ENC_ERXSTL));
+        break;
+
+    case ENC_ECON1:
+        if (0U != (value & ENC_ECON1_DMAST))
+        {
+            encDma();
+        }
+
+        if (0U != (value & ENC_ECON1_TXRTS))
+        {
+            encTransmit();
+        }
+        break;
+
+    case ENC_ECON2:
+        if (0U != (value & ENC_ECON2_PKTDEC))
+        {
+            if (0U < *encReg(ENC_EPKTCNT))
+            {
+                --(*encReg(ENC_EPKTCNT));
+            }
+
+            *encReg(ENC_ECON2) &= ~ENC_ECON2_PKTDEC;
+        }
+        break;
+
+    case ENC_ESTAT:
+        *encReg(ENC_ESTAT) |= ENC_ESTAT_CLKRDY;
+        break;
+
+    case ENC_MICMD:
+        if (0U != (value & ENC_MICMD_MIIRD))
+        {
+            uint16_t phyValue = gEnc.phy[*encReg(ENC_MIREGADR) & 0x1FU];
+
+            *encReg(ENC_MIRDL) = phyValue & 0xFFU;
+            *encReg(ENC_MIRDH) = (phyValue >> 8U) & 0xFFU;
+        }
+        break;
+
+    case ENC_MIWRH:
+        /* The PHY register is written with the high byte. */
+        if ((ENC_PHSTAT1 != *encReg(ENC_MIREGADR)) &&
+            (ENC_PHSTAT2 != *encReg(ENC_MIREGADR)))
+        {
+            gEnc.phy[*encReg(ENC_MIREGADR) & 0x1FU] = *encReg(ENC_MIWRL) | ((uint16_t)value << 8U);
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return;
+}
+
+/**
+ * Increment a pointer in the receive buffer, with the wrap around at its end.
+ *
+ * @param[in] ptr   Pointer
+ *
+ * @return Incremented pointer
+ */
+static uint16_t encRxInc(uint16_t ptr)
+{
+    if (encGetPtr(ENC_ERXNDL) == ptr)
+    {
+        ptr = encGetPtr(ENC_ERXSTL);
+    }
+    else
+    {
+        ptr = (ptr + 1U) & (ENC_BUFFER_SIZE - 1U);
+    }
+
+    return ptr;
+}
+
+/**
+ * Transmit the frame between ETXST and ETXND. The first byte is the
+ * per packet control byte, which is skipped.
+ */
+static void encTransmit(void)
+{
+    uint16_t    start   = encGetPtr(ENC_ETXSTL);
+    uint16_t    end     = encGetPtr(ENC_ETXNDL);
+    uint16_t    size    = 0U;
+    uint16_t    tsv     = (end + 1U) & (ENC_BUFFER_SIZE - 1U);
+
+    if (end > start)
+    {
+        size = end - start;
+
+        ++gEnc.txFrames;
+        peerHandleFrame(&gEnc.buffer[start + 1U], size);
+    }
+
+    /* Transmit status vector: byte count and done */
+    memset(&gEnc.buffer[tsv], 0, 7U);
+    gEnc.buffer[tsv]                                            = size & 0xFFU;
+    gEnc.buffer[(tsv + 1U) & (ENC_BUFFER_SIZE - 1U)]            = (size >> 8U) & 0xFFU;
+    gEnc.buffer[(tsv + 2U) & (ENC_BUFFER_SIZE - 1U)]            = 0x80U;
+
+    *encReg(ENC_ECON1)  &= ~ENC_ECON1_TXRTS;
+    *encReg(ENC_EIR)    |= ENC_EIR_TXIF;
+
+    return;
+}
+
+/**
+ * Run the DMA: copy or checksum calculation between EDMAST and EDMAND.
+ */
+static void encDma(void)
+{
+    uint16_t    src     = encGetPtr(ENC_EDMASTL);
+    uint16_t    end     = encGetPtr(ENC_EDMANDL);
+    uint16_t    dst     = encGetPtr(ENC_EDMADSTL);
+    bool        isCsum  = (0U != (*encReg(ENC_ECON1) & ENC_ECON1_CSUMEN));
+    uint32_t    sum     = 0U;
+    bool        isHigh  = true;
+    bool        isLast  = false;
+
+    while(false == isLast)
+    {
+        uint8_t data = gEnc.buffer[src];
+
+        isLast = (src == end);
+
+        if (true == isCsum)
+        {
+            sum += (true == isHigh) ? ((uint32_t)data << 8U) : data;
+            isHigh = !isHigh;
+        }
+        else
+        {
+            gEnc.buffer[dst] = data;
+            dst = (dst + 1U) & (ENC_BUFFER_SIZE - 1U);
+        }
+
+        src = encRxInc(src);
+    }
+
+    if (true == isCsum)
+    {
+        while(0U != (sum >> 16U))
+        {
+            sum = (sum & 0xFFFFU) + (sum >> 16U);
+        }
+
+        sum = ~sum & 0xFFFFU;
+
+        *encReg(ENC_EDMACSL) = sum & 0xFFU;
+        *encReg(ENC_EDMACSH) = (sum >> 8U) & 0xFFU;
+    }
+
+    *encReg(ENC_ECON1)  &= ~ENC_ECON1_DMAST;
+    *encReg(ENC_EIR)    |= ENC_EIR_DMAIF;
+
+    return;
+}
+
+/**
+ * Receive a frame: write it with the next packet pointer and the receive
+ * status vector into the receive buffer.
+ *
+ * @param[in] frame Frame without CRC
+ * @param[in] size  Frame size in bytes
+ *
+ * @return If the frame was received, it will return true. If the receive buffer is full, it will return false.
+ */
+static bool encReceive(const uint8_t* frame, uint16_t size)
+{
+    uint16_t    rxStart     = encGetPtr(ENC_ERXSTL);
+    uint16_t    rxEnd       = encGetPtr(ENC_ERXNDL);
+    uint16_t    rxSize      = rxEnd - rxStart + 1U;
+    uint16_t    wr          = encGetPtr(ENC_ERXWRPTL);
+    uint16_t    rd          = encGetPtr(ENC_ERXRDPTL);
+    uint16_t    byteCnt     = size + 4U;
+    uint16_t    total       = (6U + byteCnt + 1U) & ~1U;
+    uint16_t    space       = (rd > wr) ? (rd - wr) : (rxSize - (wr - rd));
+    uint16_t    next        = 0U;
+    uint8_t     header[6];
+    uint16_t    idx         = 0U;
+    uint16_t    ptr         = wr;
+
+    if ((0U == (*encReg(ENC_ECON1) & ENC_ECON1_RXEN)) ||
+        (rxEnd <= rxStart))
+    {
+        return false;
+    }
+
+    if ((total >= space) ||
+        (UINT8_MAX == *encReg(ENC_EPKTCNT)))
+    {
+        ++gEnc.rxDropped;
+        return false;
+    }
+
+    next = wr;
+    for(idx = 0U; idx < total; ++idx)
+    {
+        next = encRxInc(next);
+    }
+
+    header[0] = next & 0xFFU;
+    header[1] = (next >> 8U) & 0xFFU;
+    header[2] = byteCnt & 0xFFU;
+    header[3] = (byteCnt >> 8U) & 0xFFU;
+    header[4] = 0x80U;  /* Received ok */
+    header[5] = 0x00U;
+
+    for(idx = 0U; idx < total; ++idx)
+    {
+        uint8_t data = 0U;
+
+        if (sizeof(header) > idx)
+        {
+            data = header[idx];
+        }
+        else if ((sizeof(header) + size) > idx)
+        {
+            data = frame[idx - sizeof(header)];
+        }
+
+        gEnc.buffer[ptr] = data;
+        ptr = encRxInc(ptr);
+    }
+
+    encSetPtr(ENC_ERXWRPTL, next);
+    ++(*encReg(ENC_EPKTCNT));
+    *encReg(ENC_EIR) |= ENC_EIR_PKTIF;
+    ++gEnc.rxFrames;
+
+    return true;
+}
+
+/**
+ * Called, if the ENC28J60 chip select changes. Every command ends with it.
+ *
+ * @param[in] irq       Chip select pin IRQ
+ * @param[in] value     Pin level
+ * @param[in] param     Not used
+ */
+static void onEncCs(struct avr_irq_t* irq, uint32_t value, void* param)
+{
+    (void)irq;
+    (void)param;
+
+    gEnc.isSelected = (0U == value);
+    gEnc.byteIdx    = 0U;
+
+    return;
+}
+
+/**
+ * Called, if the MCU sent a byte via SPI. The ENC28J60 reply is the byte,
+ * which the MCU receives in the same transfer.
+ *
+ * @param[in] irq       SPI output IRQ
+ * @param[in] value     Sent byte
+ * @param[in] param     Not used
+ */
+static void onEncSpi(struct avr_irq_t* irq, uint32_t value, void* param)
+{
+    (void)irq;
+    (void)param;
+
+    if (true == gEnc.isSelected)
+    {
+        avr_raise_irq(gSpiIn, encSpiByte((uint8_t)value));
+    }
+
+    return;
+}
+
+/**
+ * Handle a single SPI byte of a ENC28J60 command.
+ *
+ * @param[in] data  Byte from the MCU
+ *
+ * @return Byte to the MCU
+ */
+static uint8_t encSpiByte(uint8_t data)
+{
+    uint8_t reply = 0xFFU;
+
+    if (0U == gEnc.byteIdx)
+    {
+        gEnc.opcode = data & 0xE0U;
+        gEnc.arg    = data & 0x1FU;
+
+        if (ENC_OP_SRC == gEnc.opcode)
+        {
+            encReset();
+        }
+    }
+    else
+    {
+        /* The register address gets the bank of ECON1, which is valid for the whole command. */
+        uint8_t addr = gEnc.arg | ((*encReg(ENC_ECON1) & ENC_ECON1_BSEL) << 5U);
+
+        switch(gEnc.opcode)
+        {
+        case ENC_OP_RCR:
+            if ((1U == gEnc.byteIdx) && (true == encIsMacMiiReg(addr)))
+            {
+                /* Dummy byte */
+            }
+            else
+            {
+                reply = *encReg(addr);
+            }
+            break;
+
+        case ENC_OP_WCR:
+            if (1U == gEnc.byteIdx)
+            {
+                encWriteReg(addr, data);
+            }
+            break;
+
+        case ENC_OP_BFS:
+            if (1U == gEnc.byteIdx)
+            {
+                encWriteReg(addr, *encReg(addr) | data);
+            }
+            break;
+
+        case ENC_OP_BFC:
+            if (1U == gEnc.byteIdx)
+            {
+                encWriteReg(addr, *encReg(addr) & ~data);
+            }
+            break;
+
+        case ENC_OP_RBM:
+            {
+                uint16_t ptr = encGetPtr(ENC_ERDPTL);
+
+                reply = gEnc.buffer[ptr];
+
+                if (0U != (*encReg(ENC_ECON2) & ENC_ECON2_AUTOINC))
+                {
+                    encSetPtr(ENC_ERDPTL, encRxInc(ptr));
+                }
+            }
+            break;
+
+        case ENC_OP_WBM:
+            {
+                uint16_t ptr = encGetPtr(ENC_EWRPTL);
+
+                gEnc.buffer[ptr] = data;
+
+                if (0U != (*encReg(ENC_ECON2) & ENC_ECON2_AUTOINC))
+                {
+                    encSetPtr(ENC_EWRPTL, ptr + 1U);
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    ++gEnc.byteIdx;
+
+    return reply;
+}
+
+/**
+ * Deliver the queued frames to the ENC28J60 and check the HTTP timeout.
+ *
+ * @param[in] avr   Simulated MCU
+ * @param[in] when  Current cycle
+ * @param[in] param Not used
+ *
+ * @return Cycle of the next delivery
+ */
+static avr_cycle_count_t onDelivery(avr_t* avr, avr_cycle_count_t when, void* param)
+{
+    (void)param;
+
+    while((0U < gPeer.queueCnt) &&
+          (true == encReceive(gPeer.queue[gPeer.queueRd].data, gPeer.queue[gPeer.queueRd].size)))
+    {
+        gPeer.queueRd = (gPeer.queueRd + 1U) % MAX_QUEUED_FRAMES;
+        --gPeer.queueCnt;
+    }
+
+    if ((HTTP_STATE_IDLE != gPeer.httpState) &&
+        (gPeer.timeoutCycle <= avr->cycle))
+    {
+        peerSendTcp(TCP_RST | TCP_ACK, NULL, 0U);
+        peerHttpDone(false);
+    }
+
+    return when + (avr->frequency / 1000000UL) * DELIVERY_PERIOD;
+}
+
+/**
+ * Send a UDP broadcast frame to the discard port, which the firmware must
+ * receive and drop.
+ *
+ * @param[in] avr   Simulated MCU
+ * @param[in] when  Current cycle
+ * @param[in] param Frames per second
+ *
+ * @return Cycle of the next frame
+ */
+static avr_cycle_count_t onNoise(avr_t* avr, avr_cycle_count_t when, void* param)
+{
+    static const uint8_t    BROADCAST[6]    = { 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+    static const uint8_t    BROADCAST_IP[4] = { 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+    uint32_t                rate            = (uint32_t)(uintptr_t)param;
+    uint8_t*                frame           = peerAllocFrame();
+
+    if (NULL != frame)
+    {
+        uint8_t* udp = peerIpFrame(frame, BROADCAST, BROADCAST_IP, IP_PROTO_UDP, UDP_HDR_SIZE + 64U);
+
+        put16(&udp[0], DISCARD_PORT);
+        put16(&udp[2], DISCARD_PORT);
+        put16(&udp[4], UDP_HDR_SIZE + 64U);
+        put16(&udp[6], 0U);
+        memset(&udp[UDP_HDR_SIZE], 0x55, 64U);
+    }
+
+    return when + avr->frequency / rate;
+}
+
+/**
+ * Start the next HTTP request.
+ *
+ * @param[in] avr   Simulated MCU
+ * @param[in] when  Current cycle
+ * @param[in] param Not used
+ *
+ * @return 0, because the timer is restarted after the request
+ */
+static avr_cycle_count_t onHttp(avr_t* avr, avr_cycle_count_t when, void* param)
+{
+    (void)when;
+    (void)param;
+
+    if (HTTP_STATE_IDLE == gPeer.httpState)
+    {
+        ++gPeer.localPort;
+
+        if (0U == gPeer.localPort)
+        {
+            gPeer.localPort = 40000U;
+        }
+
+        gPeer.sndNxt        = 1000U;
+        gPeer.rcvNxt        = 0U;
+        gPeer.rspBytes      = 0U;
+        gPeer.reqCycle      = avr->cycle;
+        gPeer.timeoutCycle  = avr->cycle + msToCycles(HTTP_TIMEOUT);
+        gPeer.httpState     = HTTP_STATE_SYN_SENT;
+
+        peerSendTcp(TCP_SYN, NULL, 0U);
+        ++gPeer.sndNxt;
+    }
+
+    return 0U;
+}
+
+/**
+ * Allocate a frame in the delivery queue.
+ *
+ * @return Frame buffer of MAX_FRAME_SIZE bytes or NULL, if the queue is full.
+ */
+static uint8_t* peerAllocFrame(void)
+{
+    Frame* frame = NULL;
+
+    if (MAX_QUEUED_FRAMES > gPeer.queueCnt)
+    {
+        frame = &gPeer.queue[(gPeer.queueRd + gPeer.queueCnt) % MAX_QUEUED_FRAMES];
+        ++gPeer.queueCnt;
+
+        memset(frame->data, 0, sizeof(frame->data));
+        frame->size = 0U;
+    }
+
+    return (NULL != frame) ? frame->data : NULL;
+}
+
+/**
+ * Write a 16-bit value in network byte order.
+ *
+ * @param[in] buf   Buffer
+ * @param[in] value Value
+ *
+ * @return Value
+ */
+static uint16_t put16(uint8_t* buf, uint16_t value)
+{
+    buf[0] = (value >> 8U) & 0xFFU;
+    buf[1] = value & 0xFFU;
+
+    return value;
+}
+
+/**
+ * Read a 16-bit value in network byte order.
+ *
+ * @param[in] buf   Buffer
+ *
+ * @return Value
+ */
+static uint16_t get16(const uint8_t* buf)
+{
+    return (uint16_t)(((uint16_t)buf[0] << 8U) | buf[1]);
+}
+
+/**
+ * Read a 32-bit value in network byte order.
+ *
+ * @param[in] buf   Buffer
+ *
+ * @return Value
+ */
+static uint32_t get32(const uint8_t* buf)
+{
+    return ((uint32_t)get16(&buf[0]) << 16U) | get16(&buf[2]);
+}
+
+/**
+ * Calculate the internet checksum.
+ *
+ * @param[in] sum   Initial sum, e.g. of a pseudo header
+ * @param[in] data  Data
+ * @param[in] size  Data size in bytes
+ *
+ * @return Checksum
+ */
+static uint16_t checksum(uint32_t sum, const uint8_t* data, uint16_t size)
+{
+    uint16_t idx = 0U;
+
+    for(idx = 0U; (idx + 1U) < size; idx += 2U)
+    {
+        sum += get16(&data[idx]);
+    }
+
+    if (0U != (size & 1U))
+    {
+        sum += (uint32_t)data[size - 1U] << 8U;
+    }
+
+    while(0U != (sum >> 16U))
+    {
+        sum = (sum & 0xFFFFU) + (sum >> 16U);
+    }
+
+    return (uint16_t)(~sum & 0xFFFFU);
+}
+
+/**
+ * Handle a frame, sent by the firmware.
+ *
+ * @param[in] frame Frame
+ * @param[in] size  Frame size in bytes
+ */
+static void peerHandleFrame(const uint8_t* frame, uint16_t size)
+{
+    if (ETH_HDR_SIZE > size)
+    {
+        return;
+    }
+
+    memcpy(gPeer.deviceMac, &frame[6], sizeof(gPeer.deviceMac));
+
+    if (ETH_TYPE_ARP == get16(&frame[12]))
+    {
+        peerHandleArp(frame, size);
+    }
+    else if ((ETH_TYPE_IP == get16(&frame[12])) &&
+             ((ETH_HDR_SIZE + IP_HDR_SIZE) <= size))
+    {
+        const uint8_t*  ip      = &frame[ETH_HDR_SIZE];
+        uint16_t        ipHdr   = (ip[0] & 0x0FU) * 4U;
+
+        if ((ETH_HDR_SIZE + ipHdr + UDP_HDR_SIZE) > size)
+        {
+            return;
+        }
+
+        if ((IP_PROTO_UDP == ip[9]) &&
+            (DHCP_SERVER_PORT == get16(&ip[ipHdr + 2U])))
+        {
+            peerHandleDhcp(frame, size);
+        }
+        else if ((IP_PROTO_TCP == ip[9]) &&
+                 (HTTP_PORT == get16(&ip[ipHdr])))
+        {
+            peerHandleTcp(frame, size);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Answer ARP requests for any address except the one of the device, so
+ * the peer is the gateway too.
+ *
+ * @param[in] frame Frame
+ * @param[in] size  Frame size in bytes
+ */
+static void peerHandleArp(const uint8_t* frame, uint16_t size)
+{
+    const uint8_t*  arp     = &frame[ETH_HDR_SIZE];
+    uint8_t*        reply   = NULL;
+
+    if (((ETH_HDR_SIZE + 28U) > size) ||
+        (1U != get16(&arp[6])) ||
+        (0 == memcmp(&arp[24], gPeer.deviceIp, 4U)))
+    {
+        return;
+    }
+
+    reply = peerAllocFrame();
+
+    if (NULL != reply)
+    {
+        uint8_t* rArp = &reply[ETH_HDR_SIZE];
+
+        memcpy(&reply[0], &arp[8], 6U);
+        memcpy(&reply[6], gPeer.mac, 6U);
+        put16(&reply[12], ETH_TYPE_ARP);
+
+        put16(&rArp[0], 1U);            /* Ethernet */
+        put16(&rArp[2], ETH_TYPE_IP);
+        rArp[4] = 6U;
+        rArp[5] = 4U;
+        put16(&rArp[6], 2U);            /* Reply */
+        memcpy(&rArp[8], gPeer.mac, 6U);
+        memcpy(&rArp[14], &arp[24], 4U);
+        memcpy(&rArp[18], &arp[8], 6U);
+        memcpy(&rArp[24], &arp[14], 4U);
+
+        gPeer.queue[(gPeer.queueRd + gPeer.queueCnt - 1U) % MAX_QUEUED_FRAMES].size = 60U;
+    }
+
+    return;
+}
+
+/**
+ * Answer DHCP discover with an offer and DHCP request with an ack, which
+ * assigns the device address.
+ *
+ * @param[in] frame Frame
+ * @param[in] size  Frame size in bytes
+ */
+static void peerHandleDhcp(const uint8_t* frame, uint16_t size)
+{
+    static const uint8_t    BROADCAST[6]    = { 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+    static const uint8_t    BROADCAST_IP[4] = { 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+    const uint8_t*          ip              = &frame[ETH_HDR_SIZE];
+    const uint8_t*          bootp           = &ip[(ip[0] & 0x0FU) * 4U + UDP_HDR_SIZE];
+    uint16_t                bootpSize       = size - (uint16_t)(bootp - frame);
+    uint16_t                idx             = 240U;
+    uint8_t                 type            = 0U;
+    uint8_t*                reply           = NULL;
+
+    if (240U > bootpSize)
+    {
+        return;
+    }
+
+    /* Find the DHCP message type option. */
+    while((idx + 2U) <= bootpSize)
+    {
+        uint8_t option = bootp[idx];
+
+        if (255U == option)
+        {
+            break;
+        }
+        else if (0U == option)
+        {
+            ++idx;
+        }
+        else
+        {
+            if (53U == option)
+            {
+                type = bootp[idx + 2U];
+            }
+
+            idx += 2U + bootp[idx + 1U];
+        }
+    }
+
+    if ((DHCP_DISCOVER != type) && (DHCP_REQUEST != type))
+    {
+        return;
+    }
+
+    reply = peerAllocFrame();
+
+    if (NULL != reply)
+    {
+        uint8_t* udp    = peerIpFrame(reply, BROADCAST, BROADCAST_IP, IP_PROTO_UDP, UDP_HDR_SIZE + 300U);
+        uint8_t* rBootp = &udp[UDP_HDR_SIZE];
+        uint8_t* opt    = &rBootp[240];
+
+        put16(&udp[0], DHCP_SERVER_PORT);
+        put16(&udp[2], DHCP_CLIENT_PORT);
+        put16(&udp[4], UDP_HDR_SIZE + 300U);
+        put16(&udp[6], 0U);
+
+        rBootp[0] = 2U;                             /* Boot reply */
+        rBootp[1] = 1U;                             /* Ethernet */
+        rBootp[2] = 6U;
+        memcpy(&rBootp[4], &bootp[4], 4U);          /* Transaction id */
+        memcpy(&rBootp[10], &bootp[10], 2U);        /* Flags */
+        memcpy(&rBootp[16], gPeer.deviceIp, 4U);    /* Your address */
+        memcpy(&rBootp[20], gPeer.ip, 4U);          /* Server address */
+        memcpy(&rBootp[28], &bootp[28], 16U);       /* Client hardware address */
+        memcpy(&rBootp[236], "\x63\x82\x53\x63", 4U);
+
+        *opt++ = 53U; *opt++ = 1U; *opt++ = (DHCP_DISCOVER == type) ? DHCP_OFFER : DHCP_ACK;
+        *opt++ = 54U; *opt++ = 4U; memcpy(opt, gPeer.ip, 4U); opt += 4;
+        *opt++ = 51U; *opt++ = 4U; memcpy(opt, "\x00\x01\x51\x80", 4U); opt += 4;
+        *opt++ = 1U;  *opt++ = 4U; memcpy(opt, "\xFF\xFF\xFF\x00", 4U); opt += 4;
+        *opt++ = 3U;  *opt++ = 4U; memcpy(opt, gPeer.ip, 4U); opt += 4;
+        *opt++ = 6U;  *opt++ = 4U; memcpy(opt, gPeer.ip, 4U); opt += 4;
+        *opt++ = 255U;
+
+        if ((DHCP_REQUEST == type) &&
+            (false == gPeer.isBound))
+        {
+            gPeer.isBound = true;
+
+            /* Give the firmware some time to complete its setup. */
+            avr_cycle_timer_register(gAvr, msToCycles(gHttpPeriod + 1000U), onHttp, NULL);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Handle a TCP segment of the HTTP connection.
+ *
+ * @param[in] frame Frame
+ * @param[in] size  Frame size in bytes
+ */
+static void peerHandleTcp(const uint8_t* frame, uint16_t size)
+{
+    const uint8_t*  ip          = &frame[ETH_HDR_SIZE];
+    uint16_t        ipHdr       = (ip[0] & 0x0FU) * 4U;
+    uint16_t        ipTotal     = get16(&ip[2]);
+    const uint8_t*  tcp         = &ip[ipHdr];
+    uint16_t        tcpHdr      = 0U;
+    uint16_t        dataSize    = 0U;
+    uint8_t         flags       = 0U;
+    uint32_t        seq         = 0U;
+
+    if (((ETH_HDR_SIZE + ipHdr + TCP_HDR_SIZE) > size) ||
+        (gPeer.localPort != get16(&tcp[2])) ||
+        (HTTP_STATE_IDLE == gPeer.httpState))
+    {
+        return;
+    }
+
+    tcpHdr      = (tcp[12] >> 4U) * 4U;
+    flags       = tcp[13];
+    seq         = get32(&tcp[4]);
+    dataSize    = (ipTotal > (ipHdr + tcpHdr)) ? (uint16_t)(ipTotal - ipHdr - tcpHdr) : 0U;
+
+    if (0U != (flags & TCP_RST))
+    {
+        peerHttpDone(false);
+        return;
+    }
+
+    if ((HTTP_STATE_SYN_SENT == gPeer.httpState) &&
+        (0U != (flags & TCP_SYN)) &&
+        (0U != (flags & TCP_ACK)))
+    {
+        gPeer.rcvNxt    = seq + 1U;
+        gPeer.httpState = HTTP_STATE_RECEIVING;
+
+        peerSendTcp(TCP_ACK | TCP_PSH, HTTP_REQUEST, sizeof(HTTP_REQUEST) - 1U);
+        gPeer.sndNxt += sizeof(HTTP_REQUEST) - 1U;
+        return;
+    }
+
+    /* Only segments in order are accepted, the others are retransmitted by the device. */
+    if (seq != gPeer.rcvNxt)
+    {
+        peerSendTcp(TCP_ACK, NULL, 0U);
+        return;
+    }
+
+    gPeer.rcvNxt    += dataSize;
+    gPeer.rspBytes  += dataSize;
+
+    if (0U != (flags & TCP_FIN))
+    {
+        ++gPeer.rcvNxt;
+
+        if (HTTP_STATE_RECEIVING == gPeer.httpState)
+        {
+            peerSendTcp(TCP_FIN | TCP_ACK, NULL, 0U);
+            ++gPeer.sndNxt;
+
+            peerHttpDone(0U < gPeer.rspBytes);
+        }
+    }
+    else if (0U < dataSize)
+    {
+        peerSendTcp(TCP_ACK, NULL, 0U);
+    }
+
+    return;
+}
+
+/**
+ * Fill the ethernet and IP header of a frame from the peer to the device.
+ * The frame size is set in the delivery queue.
+ *
+ * @param[in] frame         Frame buffer
+ * @param[in] dstMac        Destination MAC address
+ * @param[in] dstIp         Destination IP address
+ * @param[in] proto         IP protocol
+ * @param[in] payloadSize   IP payload size in bytes
+ *
+ * @return IP payload
+ */
+static uint8_t* peerIpFrame(uint8_t* frame, const uint8_t* dstMac, const uint8_t* dstIp, uint8_t proto, uint16_t payloadSize)
+{
+    uint8_t*    ip      = &frame[ETH_HDR_SIZE];
+    uint16_t    size    = ETH_HDR_SIZE + IP_HDR_SIZE + payloadSize;
+
+    memcpy(&frame[0], dstMac, 6U);
+    memcpy(&frame[6], gPeer.mac, 6U);
+    put16(&frame[12], ETH_TYPE_IP);
+
+    ip[0] = 0x45U;
+    put16(&ip[2], IP_HDR_SIZE + payloadSize);
+    put16(&ip[4], gPeer.ipId++);
+    ip[8] = 64U;
+    ip[9] = proto;
+    memcpy(&ip[12], gPeer.ip, 4U);
+    memcpy(&ip[16], dstIp, 4U);
+    put16(&ip[10], checksum(0U, ip, IP_HDR_SIZE));
+
+    gPeer.queue[(gPeer.queueRd + gPeer.queueCnt - 1U) % MAX_QUEUED_FRAMES].size = (60U > size) ? 60U : size;
+
+    return &ip[IP_HDR_SIZE];
+}
+
+/**
+ * Send a TCP segment of the HTTP connection to the device.
+ *
+ * @param[in] flags TCP flags
+ * @param[in] data  Payload or NULL
+ * @param[in] size  Payload size in bytes
+ */
+static void peerSendTcp(uint8_t flags, const char* data, uint16_t size)
+{
+    uint8_t* frame = peerAllocFrame();
+
+    if (NULL != frame)
+    {
+        uint8_t*    tcp = peerIpFrame(frame, gPeer.deviceMac, gPeer.deviceIp, IP_PROTO_TCP, TCP_HDR_SIZE + size);
+        uint32_t    sum = 0U;
+
+        put16(&tcp[0], gPeer.localPort);
+        put16(&tcp[2], HTTP_PORT);
+        put16(&tcp[4], (gPeer.sndNxt >> 16U) & 0xFFFFU);
+        put16(&tcp[6], gPeer.sndNxt & 0xFFFFU);
+        put16(&tcp[8], (gPeer.rcvNxt >> 16U) & 0xFFFFU);
+        put16(&tcp[10], gPeer.rcvNxt & 0xFFFFU);
+        tcp[12] = (TCP_HDR_SIZE / 4U) << 4U;
+        tcp[13] = flags;
+        put16(&tcp[14], 2048U);
+
+        if (0U < size)
+        {
+            memcpy(&tcp[TCP_HDR_SIZE], data, size);
+        }
+
+        /* Pseudo header */
+        sum += get16(&gPeer.ip[0]) + get16(&gPeer.ip[2]);
+        sum += get16(&gPeer.deviceIp[0]) + get16(&gPeer.deviceIp[2]);
+        sum += IP_PROTO_TCP + TCP_HDR_SIZE + size;
+        put16(&tcp[16], checksum(sum, tcp, TCP_HDR_SIZE + size));
+    }
+
+    return;
+}
+
+/**
+ * Complete the current HTTP request and schedule the next one.
+ *
+ * @param[in] isSuccessful  Whether the response was received completely
+ */
+static void peerHttpDone(bool isSuccessful)
+{
+    if (true == isSuccessful)
+    {
+        statsAdd(&gPeer.httpStats, gAvr->cycle - gPeer.reqCycle);
+    }
+    else
+    {
+        ++gPeer.httpErrors;
+    }
+
+    gPeer.httpState = HTTP_STATE_IDLE;
+    avr_cycle_timer_register(gAvr, msToCycles(gHttpPeriod), onHttp, NULL);
+
+    return;
+}
+
+/**
+ * Print the command line usage.
+ *
+ * @param[in] prgName   Program name
+ */
+static void printUsage(const char* prgName)
+{
+    printf("Usage: %s [options] <firmware.elf>\n", prgName);
+    printf("  -s, --seconds N       Simulated time in s (default: 10).\n");
+    printf("  -p, --pins MASK       Port A pins with S0 pulses (default: 0x03).\n");
+    printf("  -P, --pulse-period MS S0 pulse period in ms (default: 100).\n");
+    printf("  -w, --pulse-width MS  S0 pulse width in ms (default: 30).\n");
+    printf("  -H, --http-period MS  Pause between two HTTP requests in ms (default: 200).\n");
+    printf("  -n, --noise N         Broadcast frames per second (default: 0).\n");
+    printf("  -f, --func PATTERN    Measure functions, whose symbol contains it. Can be repeated.\n");
+    printf("  -e, --eeprom FILE     Raw EEPROM image instead of the generated one.\n");
+    printf("  -h, --help            Show this help.\n");
+}